@@ -17,6 +17,32 @@ glslc $p/include/shaders/scene.vert -o $p/build/sceneVertex.spv
 glslc $p/include/shaders/scene.frag -o $p/build/sceneFragment.spv
 echo "$p/include/shaders/scene.vert --> $p/build/sceneVertex.spv"
 echo "$p/include/shaders/scene.frag --> $p/build/sceneFragment.spv"
+glslc -DALPHA_MASKED $p/include/shaders/scene.frag -o $p/build/sceneMaskedFragment.spv
+echo "$p/include/shaders/scene.frag --> $p/build/sceneMaskedFragment.spv"
+glslc $p/include/shaders/sceneGBuffer.frag -o $p/build/sceneGBufferFragment.spv
+echo "$p/include/shaders/sceneGBuffer.frag --> $p/build/sceneGBufferFragment.spv"
+glslc -DALPHA_MASKED $p/include/shaders/sceneGBuffer.frag -o $p/build/sceneGBufferMaskedFragment.spv
+echo "$p/include/shaders/sceneGBuffer.frag --> $p/build/sceneGBufferMaskedFragment.spv"
+glslc $p/include/shaders/deferredLighting.vert -o $p/build/deferredLightingVertex.spv
+glslc $p/include/shaders/deferredLighting.frag -o $p/build/deferredLightingFragment.spv
+glslc -DMULTISAMPLED_GBUFFER $p/include/shaders/deferredLighting.frag -o $p/build/deferredLightingMultisampledFragment.spv
+echo "$p/include/shaders/deferredLighting.vert --> $p/build/deferredLightingVertex.spv"
+echo "$p/include/shaders/deferredLighting.frag --> $p/build/deferredLightingFragment.spv"
+echo "$p/include/shaders/deferredLighting.frag --> $p/build/deferredLightingMultisampledFragment.spv"
+glslc $p/include/shaders/sceneVisibility.vert -o $p/build/sceneVisibilityVertex.spv
+glslc -DALPHA_MASKED $p/include/shaders/sceneVisibility.vert -o $p/build/sceneVisibilityMaskedVertex.spv
+glslc $p/include/shaders/sceneVisibility.frag -o $p/build/sceneVisibilityFragment.spv
+glslc -DALPHA_MASKED $p/include/shaders/sceneVisibility.frag -o $p/build/sceneVisibilityMaskedFragment.spv
+echo "$p/include/shaders/sceneVisibility.vert --> $p/build/sceneVisibilityVertex.spv"
+echo "$p/include/shaders/sceneVisibility.vert --> $p/build/sceneVisibilityMaskedVertex.spv"
+echo "$p/include/shaders/sceneVisibility.frag --> $p/build/sceneVisibilityFragment.spv"
+echo "$p/include/shaders/sceneVisibility.frag --> $p/build/sceneVisibilityMaskedFragment.spv"
+glslc $p/include/shaders/visibilityShading.frag -o $p/build/visibilityShadingFragment.spv
+glslc -DMULTISAMPLED_VISIBILITY $p/include/shaders/visibilityShading.frag -o $p/build/visibilityShadingMultisampledFragment.spv
+echo "$p/include/shaders/visibilityShading.frag --> $p/build/visibilityShadingFragment.spv"
+echo "$p/include/shaders/visibilityShading.frag --> $p/build/visibilityShadingMultisampledFragment.spv"
+glslc $p/include/shaders/depthPrepass.vert -o $p/build/depthPrepassVertex.spv
+echo "$p/include/shaders/depthPrepass.vert --> $p/build/depthPrepassVertex.spv"
 glslc $p/include/shaders/sceneNormals.vert -o $p/build/sceneNormalsVertex.spv
 glslc $p/include/shaders/sceneNormals.geom -o $p/build/sceneNormalsGeometry.spv
 glslc $p/include/shaders/sceneNormals.frag -o $p/build/sceneNormalsFragment.spv
@@ -27,10 +53,61 @@ glslc $p/include/shaders/directionalShadow.vert -o $p/build/directionalShadowVer
 glslc $p/include/shaders/directionalShadow.frag -o $p/build/directionalShadowFragment.spv
 echo "$p/include/shaders/directionalShadow.vert --> $p/build/directionalShadowVertex.spv"
 echo "$p/include/shaders/directionalShadow.frag --> $p/build/directionalShadowFragment.spv"
+glslc -DALPHA_MASKED $p/include/shaders/directionalShadow.vert -o $p/build/directionalShadowMaskedVertex.spv
+glslc -DALPHA_MASKED $p/include/shaders/directionalShadow.frag -o $p/build/directionalShadowMaskedFragment.spv
+echo "$p/include/shaders/directionalShadow.vert --> $p/build/directionalShadowMaskedVertex.spv"
+echo "$p/include/shaders/directionalShadow.frag --> $p/build/directionalShadowMaskedFragment.spv"
 glslc $p/include/shaders/pointShadow.vert -o $p/build/pointShadowVertex.spv
 glslc $p/include/shaders/pointShadow.frag -o $p/build/pointShadowFragment.spv
 echo "$p/include/shaders/pointShadow.vert --> $p/build/pointShadowVertex.spv"
 echo "$p/include/shaders/pointShadow.frag --> $p/build/pointShadowFragment.spv"
+glslc -DALPHA_MASKED $p/include/shaders/pointShadow.vert -o $p/build/pointShadowMaskedVertex.spv
+glslc -DALPHA_MASKED $p/include/shaders/pointShadow.frag -o $p/build/pointShadowMaskedFragment.spv
+echo "$p/include/shaders/pointShadow.vert --> $p/build/pointShadowMaskedVertex.spv"
+echo "$p/include/shaders/pointShadow.frag --> $p/build/pointShadowMaskedFragment.spv"
+glslc $p/include/shaders/shadowAtlas.vert -o $p/build/shadowAtlasVertex.spv
+glslc $p/include/shaders/shadowAtlas.frag -o $p/build/shadowAtlasFragment.spv
+echo "$p/include/shaders/shadowAtlas.vert --> $p/build/shadowAtlasVertex.spv"
+echo "$p/include/shaders/shadowAtlas.frag --> $p/build/shadowAtlasFragment.spv"
+glslc -DALPHA_MASKED $p/include/shaders/shadowAtlas.vert -o $p/build/shadowAtlasMaskedVertex.spv
+glslc -DALPHA_MASKED $p/include/shaders/shadowAtlas.frag -o $p/build/shadowAtlasMaskedFragment.spv
+echo "$p/include/shaders/shadowAtlas.vert --> $p/build/shadowAtlasMaskedVertex.spv"
+echo "$p/include/shaders/shadowAtlas.frag --> $p/build/shadowAtlasMaskedFragment.spv"
+glslc $p/include/shaders/cull.comp -o $p/build/cullCompute.spv
+echo "$p/include/shaders/cull.comp --> $p/build/cullCompute.spv"
+glslc $p/include/shaders/lightCluster.comp -o $p/build/lightClusterCompute.spv
+echo "$p/include/shaders/lightCluster.comp --> $p/build/lightClusterCompute.spv"
+glslc $p/include/shaders/depthPyramid.comp -o $p/build/depthPyramidCompute.spv
+glslc -DMULTISAMPLED_DEPTH $p/include/shaders/depthPyramid.comp -o $p/build/depthPyramidMultisampledCompute.spv
+echo "$p/include/shaders/depthPyramid.comp --> $p/build/depthPyramidCompute.spv"
+echo "$p/include/shaders/depthPyramid.comp --> $p/build/depthPyramidMultisampledCompute.spv"
+glslc $p/include/shaders/antiAliasing.frag -o $p/build/antiAliasingCopyFragment.spv
+glslc -DFXAA $p/include/shaders/antiAliasing.frag -o $p/build/antiAliasingFxaaFragment.spv
+glslc -DSMAA $p/include/shaders/antiAliasing.frag -o $p/build/antiAliasingSmaaFragment.spv
+echo "$p/include/shaders/antiAliasing.frag --> $p/build/antiAliasingCopyFragment.spv"
+echo "$p/include/shaders/antiAliasing.frag --> $p/build/antiAliasingFxaaFragment.spv"
+echo "$p/include/shaders/antiAliasing.frag --> $p/build/antiAliasingSmaaFragment.spv"
+glslc $p/include/shaders/smaaEdges.frag -o $p/build/smaaEdgesFragment.spv
+echo "$p/include/shaders/smaaEdges.frag --> $p/build/smaaEdgesFragment.spv"
+glslc $p/include/shaders/smaaWeights.frag -o $p/build/smaaWeightsFragment.spv
+echo "$p/include/shaders/smaaWeights.frag --> $p/build/smaaWeightsFragment.spv"
+glslc $p/include/shaders/motionVectors.frag -o $p/build/motionVectorsFragment.spv
+echo "$p/include/shaders/motionVectors.frag --> $p/build/motionVectorsFragment.spv"
+glslc $p/include/shaders/motionVectorsGeometry.vert -o $p/build/motionVectorsGeometryVertex.spv
+echo "$p/include/shaders/motionVectorsGeometry.vert --> $p/build/motionVectorsGeometryVertex.spv"
+glslc $p/include/shaders/motionVectorsGeometry.frag -o $p/build/motionVectorsGeometryFragment.spv
+echo "$p/include/shaders/motionVectorsGeometry.frag --> $p/build/motionVectorsGeometryFragment.spv"
+glslc $p/include/shaders/temporalResolve.frag -o $p/build/temporalResolveFragment.spv
+echo "$p/include/shaders/temporalResolve.frag --> $p/build/temporalResolveFragment.spv"
+
+glslc -DPREFILTER $p/include/shaders/bloomDownsample.comp -o $p/build/bloomPrefilterCompute.spv
+glslc $p/include/shaders/bloomDownsample.comp -o $p/build/bloomDownsampleCompute.spv
+echo "$p/include/shaders/bloomDownsample.comp --> $p/build/bloomPrefilterCompute.spv"
+echo "$p/include/shaders/bloomDownsample.comp --> $p/build/bloomDownsampleCompute.spv"
+glslc $p/include/shaders/bloomUpsample.comp -o $p/build/bloomUpsampleCompute.spv
+echo "$p/include/shaders/bloomUpsample.comp --> $p/build/bloomUpsampleCompute.spv"
+glslc $p/include/shaders/exposure.comp -o $p/build/exposureCompute.spv
+echo "$p/include/shaders/exposure.comp --> $p/build/exposureCompute.spv"
 echo
 echo
 cmake -DCMAKE_BUILD_TYPE=Debug $p/build &&
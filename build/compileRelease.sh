@@ -17,6 +17,32 @@ glslc $p/include/shaders/scene.vert -o sceneVertex.spv
 glslc $p/include/shaders/scene.frag -o sceneFragment.spv
 echo "$p/include/shaders/scene.vert --> sceneVertex.spv"
 echo "$p/include/shaders/scene.frag --> sceneFragment.spv"
+glslc -DALPHA_MASKED $p/include/shaders/scene.frag -o sceneMaskedFragment.spv
+echo "$p/include/shaders/scene.frag --> sceneMaskedFragment.spv"
+glslc $p/include/shaders/sceneGBuffer.frag -o sceneGBufferFragment.spv
+echo "$p/include/shaders/sceneGBuffer.frag --> sceneGBufferFragment.spv"
+glslc -DALPHA_MASKED $p/include/shaders/sceneGBuffer.frag -o sceneGBufferMaskedFragment.spv
+echo "$p/include/shaders/sceneGBuffer.frag --> sceneGBufferMaskedFragment.spv"
+glslc $p/include/shaders/deferredLighting.vert -o deferredLightingVertex.spv
+glslc $p/include/shaders/deferredLighting.frag -o deferredLightingFragment.spv
+glslc -DMULTISAMPLED_GBUFFER $p/include/shaders/deferredLighting.frag -o deferredLightingMultisampledFragment.spv
+echo "$p/include/shaders/deferredLighting.vert --> deferredLightingVertex.spv"
+echo "$p/include/shaders/deferredLighting.frag --> deferredLightingFragment.spv"
+echo "$p/include/shaders/deferredLighting.frag --> deferredLightingMultisampledFragment.spv"
+glslc $p/include/shaders/sceneVisibility.vert -o sceneVisibilityVertex.spv
+glslc -DALPHA_MASKED $p/include/shaders/sceneVisibility.vert -o sceneVisibilityMaskedVertex.spv
+glslc $p/include/shaders/sceneVisibility.frag -o sceneVisibilityFragment.spv
+glslc -DALPHA_MASKED $p/include/shaders/sceneVisibility.frag -o sceneVisibilityMaskedFragment.spv
+echo "$p/include/shaders/sceneVisibility.vert --> sceneVisibilityVertex.spv"
+echo "$p/include/shaders/sceneVisibility.vert --> sceneVisibilityMaskedVertex.spv"
+echo "$p/include/shaders/sceneVisibility.frag --> sceneVisibilityFragment.spv"
+echo "$p/include/shaders/sceneVisibility.frag --> sceneVisibilityMaskedFragment.spv"
+glslc $p/include/shaders/visibilityShading.frag -o visibilityShadingFragment.spv
+glslc -DMULTISAMPLED_VISIBILITY $p/include/shaders/visibilityShading.frag -o visibilityShadingMultisampledFragment.spv
+echo "$p/include/shaders/visibilityShading.frag --> visibilityShadingFragment.spv"
+echo "$p/include/shaders/visibilityShading.frag --> visibilityShadingMultisampledFragment.spv"
+glslc $p/include/shaders/depthPrepass.vert -o depthPrepassVertex.spv
+echo "$p/include/shaders/depthPrepass.vert --> depthPrepassVertex.spv"
 glslc $p/include/shaders/sceneNormals.vert -o sceneNormalsVertex.spv
 glslc $p/include/shaders/sceneNormals.geom -o sceneNormalsGeometry.spv
 glslc $p/include/shaders/sceneNormals.frag -o sceneNormalsFragment.spv
@@ -27,10 +53,61 @@ glslc $p/include/shaders/directionalShadow.vert -o directionalShadowVertex.spv
 glslc $p/include/shaders/directionalShadow.frag -o directionalShadowFragment.spv
 echo "$p/include/shaders/directionalShadow.vert --> directionalShadowVertex.spv"
 echo "$p/include/shaders/directionalShadow.frag --> directionalShadowFragment.spv"
+glslc -DALPHA_MASKED $p/include/shaders/directionalShadow.vert -o directionalShadowMaskedVertex.spv
+glslc -DALPHA_MASKED $p/include/shaders/directionalShadow.frag -o directionalShadowMaskedFragment.spv
+echo "$p/include/shaders/directionalShadow.vert --> directionalShadowMaskedVertex.spv"
+echo "$p/include/shaders/directionalShadow.frag --> directionalShadowMaskedFragment.spv"
 glslc $p/include/shaders/pointShadow.vert -o pointShadowVertex.spv
 glslc $p/include/shaders/pointShadow.frag -o pointShadowFragment.spv
 echo "$p/include/shaders/pointShadow.vert --> pointShadowVertex.spv"
 echo "$p/include/shaders/pointShadow.frag --> pointShadowFragment.spv"
+glslc -DALPHA_MASKED $p/include/shaders/pointShadow.vert -o pointShadowMaskedVertex.spv
+glslc -DALPHA_MASKED $p/include/shaders/pointShadow.frag -o pointShadowMaskedFragment.spv
+echo "$p/include/shaders/pointShadow.vert --> pointShadowMaskedVertex.spv"
+echo "$p/include/shaders/pointShadow.frag --> pointShadowMaskedFragment.spv"
+glslc $p/include/shaders/shadowAtlas.vert -o shadowAtlasVertex.spv
+glslc $p/include/shaders/shadowAtlas.frag -o shadowAtlasFragment.spv
+echo "$p/include/shaders/shadowAtlas.vert --> shadowAtlasVertex.spv"
+echo "$p/include/shaders/shadowAtlas.frag --> shadowAtlasFragment.spv"
+glslc -DALPHA_MASKED $p/include/shaders/shadowAtlas.vert -o shadowAtlasMaskedVertex.spv
+glslc -DALPHA_MASKED $p/include/shaders/shadowAtlas.frag -o shadowAtlasMaskedFragment.spv
+echo "$p/include/shaders/shadowAtlas.vert --> shadowAtlasMaskedVertex.spv"
+echo "$p/include/shaders/shadowAtlas.frag --> shadowAtlasMaskedFragment.spv"
+glslc $p/include/shaders/cull.comp -o cullCompute.spv
+echo "$p/include/shaders/cull.comp --> cullCompute.spv"
+glslc $p/include/shaders/lightCluster.comp -o lightClusterCompute.spv
+echo "$p/include/shaders/lightCluster.comp --> lightClusterCompute.spv"
+glslc $p/include/shaders/depthPyramid.comp -o depthPyramidCompute.spv
+glslc -DMULTISAMPLED_DEPTH $p/include/shaders/depthPyramid.comp -o depthPyramidMultisampledCompute.spv
+echo "$p/include/shaders/depthPyramid.comp --> depthPyramidCompute.spv"
+echo "$p/include/shaders/depthPyramid.comp --> depthPyramidMultisampledCompute.spv"
+glslc $p/include/shaders/antiAliasing.frag -o antiAliasingCopyFragment.spv
+glslc -DFXAA $p/include/shaders/antiAliasing.frag -o antiAliasingFxaaFragment.spv
+glslc -DSMAA $p/include/shaders/antiAliasing.frag -o antiAliasingSmaaFragment.spv
+echo "$p/include/shaders/antiAliasing.frag --> antiAliasingCopyFragment.spv"
+echo "$p/include/shaders/antiAliasing.frag --> antiAliasingFxaaFragment.spv"
+echo "$p/include/shaders/antiAliasing.frag --> antiAliasingSmaaFragment.spv"
+glslc $p/include/shaders/smaaEdges.frag -o smaaEdgesFragment.spv
+echo "$p/include/shaders/smaaEdges.frag --> smaaEdgesFragment.spv"
+glslc $p/include/shaders/smaaWeights.frag -o smaaWeightsFragment.spv
+echo "$p/include/shaders/smaaWeights.frag --> smaaWeightsFragment.spv"
+glslc $p/include/shaders/motionVectors.frag -o motionVectorsFragment.spv
+echo "$p/include/shaders/motionVectors.frag --> motionVectorsFragment.spv"
+glslc $p/include/shaders/motionVectorsGeometry.vert -o motionVectorsGeometryVertex.spv
+echo "$p/include/shaders/motionVectorsGeometry.vert --> motionVectorsGeometryVertex.spv"
+glslc $p/include/shaders/motionVectorsGeometry.frag -o motionVectorsGeometryFragment.spv
+echo "$p/include/shaders/motionVectorsGeometry.frag --> motionVectorsGeometryFragment.spv"
+glslc $p/include/shaders/temporalResolve.frag -o temporalResolveFragment.spv
+echo "$p/include/shaders/temporalResolve.frag --> temporalResolveFragment.spv"
+
+glslc -DPREFILTER $p/include/shaders/bloomDownsample.comp -o bloomPrefilterCompute.spv
+glslc $p/include/shaders/bloomDownsample.comp -o bloomDownsampleCompute.spv
+echo "$p/include/shaders/bloomDownsample.comp --> bloomPrefilterCompute.spv"
+echo "$p/include/shaders/bloomDownsample.comp --> bloomDownsampleCompute.spv"
+glslc $p/include/shaders/bloomUpsample.comp -o bloomUpsampleCompute.spv
+echo "$p/include/shaders/bloomUpsample.comp --> bloomUpsampleCompute.spv"
+glslc $p/include/shaders/exposure.comp -o exposureCompute.spv
+echo "$p/include/shaders/exposure.comp --> exposureCompute.spv"
 echo
 echo
 cmake -DCMAKE_BUILD_TYPE=Release $p &&
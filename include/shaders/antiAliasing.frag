@@ -0,0 +1,102 @@
+#version 450
+#extension GL_GOOGLE_include_directive : require
+
+#include "tonemapping.glsl"
+
+layout(binding = 0) uniform sampler2D sceneColor;  // single-sampled HDR, resolved by the main render pass with msaa.
+layout(binding = 2) uniform sampler2D blendingWeights;  // written by the SMAA blending weight pass, see AntiAliasing::blendingWeightsImageFormat.
+layout(binding = 3) uniform sampler2D bloomColor;  // the first bloom level, at half of the scene extent.
+layout(std430, binding = 4) readonly buffer ExposureBuffer {  // identical to PostProcessing::ExposureState.
+    float adaptedLuminance;
+    float exposure;
+} exposureBuffer;
+
+layout(push_constant) uniform PostPushConstant {  // identical to AntiAliasing::PostPushConstant.
+    vec2 texelSize;
+} pushConstant;
+
+layout(location = 0) out vec4 outputColor;
+
+vec3 pixelBloomColor;  // the bloom at the output pixel, smooth enough to be shared by every tap of the filters.
+
+// tonemap a scene color into the displayed range, the filters blend the displayed colors(bright HDR texels would outweigh their neighbors otherwise).
+vec3 fetchDisplayColor(vec3 color)
+{
+    return tonemapColor(color, pixelBloomColor, exposureBuffer.exposure);
+}
+
+#ifdef FXAA
+const float fxaaSpanMaximum = 8.0;  // the farthest(in texels) a pixel is blurred along its edge.
+const float fxaaReduceMultiplier = (1.0 / 8.0);
+const float fxaaReduceMinimum = (1.0 / 128.0);
+
+float fetchLuma(vec3 color)
+{
+    return sqrt(dot(color, vec3(0.299, 0.587, 0.114)));  // the displayed color is linear, edges are found in (approximately) perceptual luma.
+}
+#endif
+
+#ifdef SMAA
+vec3 fetchNeighborColor(ivec2 pixel)
+{
+    return fetchDisplayColor(texelFetch(sceneColor, clamp(pixel, ivec2(0), (textureSize(sceneColor, 0) - 1)), 0).rgb);
+}
+#endif
+
+void main()
+{
+    ivec2 pixel = ivec2(gl_FragCoord.xy);
+    vec2 textureCoordinates = (gl_FragCoord.xy * pushConstant.texelSize);
+    pixelBloomColor = texture(bloomColor, textureCoordinates).rgb;
+
+#if defined(FXAA)
+    vec3 colorNorthWest = fetchDisplayColor(texture(sceneColor, (textureCoordinates + (vec2(-1.0, -1.0) * pushConstant.texelSize))).rgb);
+    vec3 colorNorthEast = fetchDisplayColor(texture(sceneColor, (textureCoordinates + (vec2(1.0, -1.0) * pushConstant.texelSize))).rgb);
+    vec3 colorSouthWest = fetchDisplayColor(texture(sceneColor, (textureCoordinates + (vec2(-1.0, 1.0) * pushConstant.texelSize))).rgb);
+    vec3 colorSouthEast = fetchDisplayColor(texture(sceneColor, (textureCoordinates + (vec2(1.0, 1.0) * pushConstant.texelSize))).rgb);
+    vec3 colorMiddle = fetchDisplayColor(texelFetch(sceneColor, pixel, 0).rgb);
+
+    float lumaNorthWest = fetchLuma(colorNorthWest);
+    float lumaNorthEast = fetchLuma(colorNorthEast);
+    float lumaSouthWest = fetchLuma(colorSouthWest);
+    float lumaSouthEast = fetchLuma(colorSouthEast);
+    float lumaMiddle = fetchLuma(colorMiddle);
+    float lumaMinimum = min(lumaMiddle, min(min(lumaNorthWest, lumaNorthEast), min(lumaSouthWest, lumaSouthEast)));
+    float lumaMaximum = max(lumaMiddle, max(max(lumaNorthWest, lumaNorthEast), max(lumaSouthWest, lumaSouthEast)));
+
+    // the blur direction, along the edge(perpendicular to the luma gradient).
+    vec2 blurDirection = vec2(-((lumaNorthWest + lumaNorthEast) - (lumaSouthWest + lumaSouthEast)), ((lumaNorthWest + lumaSouthWest) - (lumaNorthEast + lumaSouthEast)));
+    float directionReduce = max(((lumaNorthWest + lumaNorthEast + lumaSouthWest + lumaSouthEast) * (0.25 * fxaaReduceMultiplier)), fxaaReduceMinimum);
+    float inverseDirectionMinimum = (1.0 / (min(abs(blurDirection.x), abs(blurDirection.y)) + directionReduce));
+    blurDirection = (clamp((blurDirection * inverseDirectionMinimum), vec2(-fxaaSpanMaximum), vec2(fxaaSpanMaximum)) * pushConstant.texelSize);
+
+    // a narrow and a wide blur, the wide blur is dropped if it crosses another edge(leaving the local luma range).
+    vec3 narrowBlur = (0.5 * (fetchDisplayColor(texture(sceneColor, (textureCoordinates + (blurDirection * ((1.0 / 3.0) - 0.5)))).rgb) + fetchDisplayColor(texture(sceneColor, (textureCoordinates + (blurDirection * ((2.0 / 3.0) - 0.5)))).rgb)));
+    vec3 wideBlur = ((narrowBlur * 0.5) + (0.25 * (fetchDisplayColor(texture(sceneColor, (textureCoordinates + (blurDirection * -0.5))).rgb) + fetchDisplayColor(texture(sceneColor, (textureCoordinates + (blurDirection * 0.5))).rgb))));
+    float wideBlurLuma = fetchLuma(wideBlur);
+
+    outputColor = vec4((((wideBlurLuma < lumaMinimum) || (wideBlurLuma > lumaMaximum)) ? narrowBlur : wideBlur), 1.0);
+#elif defined(SMAA)
+    // neighborhood blending, the weights of each of the pixel's edges are stored in the pixel that owns the edge(its top and left edges).
+    vec4 neighborWeights = vec4(
+        texelFetch(blendingWeights, pixel, 0).x,  // towards the top neighbor.
+        texelFetch(blendingWeights, min((pixel + ivec2(0, 1)), (textureSize(blendingWeights, 0) - 1)), 0).y,  // towards the bottom neighbor, the bottom neighbor's top edge.
+        texelFetch(blendingWeights, pixel, 0).z,  // towards the left neighbor.
+        texelFetch(blendingWeights, min((pixel + ivec2(1, 0)), (textureSize(blendingWeights, 0) - 1)), 0).w);  // towards the right neighbor, the right neighbor's left edge.
+    float weightSum = dot(neighborWeights, vec4(1.0));
+
+    vec3 blendedColor = fetchDisplayColor(texelFetch(sceneColor, pixel, 0).rgb);
+    if (weightSum > 0.0) {
+        neighborWeights /= max(weightSum, 1.0);  // the pixel can't be covered more than once.
+        blendedColor = ((blendedColor * (1.0 - dot(neighborWeights, vec4(1.0))))
+            + (neighborWeights.x * fetchNeighborColor(pixel + ivec2(0, -1)))
+            + (neighborWeights.y * fetchNeighborColor(pixel + ivec2(0, 1)))
+            + (neighborWeights.z * fetchNeighborColor(pixel + ivec2(-1, 0)))
+            + (neighborWeights.w * fetchNeighborColor(pixel + ivec2(1, 0))));
+    }
+
+    outputColor = vec4(blendedColor, 1.0);
+#else
+    outputColor = vec4(fetchDisplayColor(texelFetch(sceneColor, pixel, 0).rgb), 1.0);  // no post-process anti-aliasing, only tonemap the scene color.
+#endif
+}
\ No newline at end of file
@@ -0,0 +1,58 @@
+#version 450
+#extension GL_GOOGLE_include_directive : require
+
+#include "sceneLighting.glsl"
+
+// the G-buffer, read from the G-buffer subpass' attachments in the same render pass.
+#ifdef MULTISAMPLED_GBUFFER
+layout(input_attachment_index = 0, binding = 12) uniform subpassInputMS albedoInput;
+layout(input_attachment_index = 1, binding = 13) uniform subpassInputMS normalInput;
+layout(input_attachment_index = 2, binding = 14) uniform subpassInputMS materialInput;
+layout(input_attachment_index = 3, binding = 15) uniform subpassInputMS depthInput;
+
+#define loadGBuffer(gBufferInput) subpassLoad(gBufferInput, gl_SampleID)  // every sample is lit, the lighting pipeline shades at sample rate.
+#else
+layout(input_attachment_index = 0, binding = 12) uniform subpassInput albedoInput;
+layout(input_attachment_index = 1, binding = 13) uniform subpassInput normalInput;
+layout(input_attachment_index = 2, binding = 14) uniform subpassInput materialInput;
+layout(input_attachment_index = 3, binding = 15) uniform subpassInput depthInput;
+
+#define loadGBuffer(gBufferInput) subpassLoad(gBufferInput)
+#endif
+
+layout(location = 0) out vec4 outputColor;
+
+vec3 decodeOctahedralNormal(vec2 octahedralNormal);
+
+void main()
+{
+    float fragmentDepth = loadGBuffer(depthInput).r;
+    if (fragmentDepth == 1.0) {  // no geometry, the cubemap is drawn here afterwards.
+        discard;
+    }
+
+    vec4 albedo = loadGBuffer(albedoInput);
+    vec3 fragmentNormal = decodeOctahedralNormal(loadGBuffer(normalInput).rg);
+    vec2 material = loadGBuffer(materialInput).rg;
+
+    vec2 fragmentCoordinates = (((gl_FragCoord.xy / uniformBufferObject.framebufferExtent) * 2.0) - 1.0);
+    vec4 fragmentPositionWorldSpace = (uniformBufferObject.inverseViewProjectionMatrix * vec4(fragmentCoordinates, fragmentDepth, 1.0));
+    fragmentPositionWorldSpace /= fragmentPositionWorldSpace.w;
+    fragmentPositionWorldSpace.w = -(uniformBufferObject.viewMatrix * vec4(fragmentPositionWorldSpace.xyz, 1.0)).z;  // the view space depth, like the scene vertex shader's.
+
+    float roughness = max(material.r, 0.01);
+    float shininessValue = ((2.0 / (roughness * roughness)) - 2.0);  // the Blinn-Phong exponent matching the roughness.
+
+    outputColor = vec4((calculateClusteredLighting(fragmentPositionWorldSpace, fragmentNormal, shininessValue, material.g) * albedo.rgb), albedo.a);
+}
+
+// the inverse of the G-buffer shader's octahedral encoding.
+vec3 decodeOctahedralNormal(vec2 octahedralNormal)
+{
+    vec3 fragmentNormal = vec3(octahedralNormal, (1.0 - abs(octahedralNormal.x) - abs(octahedralNormal.y)));
+    float foldedAmount = max(-fragmentNormal.z, 0.0);  // the lower hemisphere was folded over the diagonals.
+    fragmentNormal.x += (fragmentNormal.x >= 0.0 ? -foldedAmount : foldedAmount);
+    fragmentNormal.y += (fragmentNormal.y >= 0.0 ? -foldedAmount : foldedAmount);
+
+    return normalize(fragmentNormal);
+}
\ No newline at end of file
@@ -0,0 +1,8 @@
+#version 450
+
+// a single triangle covering the screen, without vertex buffers.
+void main()
+{
+    vec2 screenCoordinates = vec2(((gl_VertexIndex << 1) & 2), (gl_VertexIndex & 2));
+    gl_Position = vec4(((screenCoordinates * 2.0) - 1.0), 0.0, 1.0);
+}
\ No newline at end of file
@@ -0,0 +1,30 @@
+#version 450
+
+struct CullingInstance {
+    mat4 modelMatrix;
+    mat4 normalMatrix;
+    vec4 boundingSphere;
+    uvec4 drawParameters;
+    mat4 previousModelMatrix;
+};
+
+layout(binding = 0) uniform UniformBufferObject {  // the leading members of the scene uniform buffer object, the scene descriptor sets are bound.
+    mat4 projectionMatrix;
+    mat4 viewMatrix;
+} uniformBufferObject;
+
+layout(std430, binding = 9) readonly buffer CullingInstanceBuffer {
+    CullingInstance instances[];  // indexed by the instance index, the culled draws set the first instance.
+};
+
+layout(location = 0) in vec3 positionAttribute;
+
+invariant gl_Position;  // the scene pass tests its depth for equality against this depth.
+
+void main()
+{
+    mat4 modelMatrix = instances[gl_InstanceIndex].modelMatrix;
+
+    vec4 positionAttributeVec4 = vec4(positionAttribute, 1.0);
+    gl_Position = (uniformBufferObject.projectionMatrix * uniformBufferObject.viewMatrix * modelMatrix * positionAttributeVec4);  // identical to the scene vertex shader.
+}
\ No newline at end of file
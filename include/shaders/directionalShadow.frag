@@ -1,6 +1,17 @@
 #version 450
 
+#ifdef ALPHA_MASKED
+layout(binding = 2) uniform sampler2D textureSampler;
+
+layout(location = 0) in vec2 fragmentUVCoordinates;
+layout(location = 1) flat in float fragmentAlphaCutoff;  // the primitive's alpha cutoff.
+#endif
+
 void main()
 {
-
+#ifdef ALPHA_MASKED
+    if (texture(textureSampler, fragmentUVCoordinates).a < fragmentAlphaCutoff) {  // masked casters only shadow their opaque texels.
+        discard;
+    }
+#endif
 }
\ No newline at end of file
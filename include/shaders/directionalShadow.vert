@@ -1,13 +1,37 @@
 #version 450
+#extension GL_EXT_multiview : require
+
+struct CullingInstance {
+    mat4 modelMatrix;
+    mat4 normalMatrix;
+    vec4 boundingSphere;
+    uvec4 drawParameters;
+    mat4 previousModelMatrix;
+};
 
 layout(binding = 0) uniform DirectionalShadowUniformBufferObject {
-    mat4 lightSpaceMatrix;
+    mat4 cascadeLightSpaceMatrices[4];  // indexed by the cascade being rendered(the view index).
     mat4 modelMatrix;
 } uniformBufferObject;
 
+layout(std430, binding = 1) readonly buffer CullingInstanceBuffer {
+    CullingInstance instances[];  // indexed by the instance index, the culled draws set the first instance.
+};
+
 layout(location = 0) in vec3 positionAttribute;
+#ifdef ALPHA_MASKED
+layout(location = 1) in vec2 UVCoordinatesAttribute;  // the masked pipeline reads the scene vertex data.
+layout(location = 2) in float alphaCutoffAttribute;
+
+layout(location = 0) out vec2 fragmentUVCoordinates;
+layout(location = 1) flat out float fragmentAlphaCutoff;
+#endif
 
 void main()
 {
-    gl_Position = (uniformBufferObject.lightSpaceMatrix * uniformBufferObject.modelMatrix * vec4(positionAttribute, 1.0));
+    gl_Position = (uniformBufferObject.cascadeLightSpaceMatrices[gl_ViewIndex] * instances[gl_InstanceIndex].modelMatrix * vec4(positionAttribute, 1.0));
+#ifdef ALPHA_MASKED
+    fragmentUVCoordinates = UVCoordinatesAttribute;
+    fragmentAlphaCutoff = alphaCutoffAttribute;
+#endif
 }
\ No newline at end of file
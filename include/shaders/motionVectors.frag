@@ -0,0 +1,32 @@
+#version 450
+
+layout(binding = 0) uniform TemporalUniformBufferObject {  // identical to Uniform::TemporalUniformBufferObject.
+    mat4 projectionMatrix;  // the scene's jittered projection and view.
+    mat4 viewMatrix;
+    mat4 cameraMatrix;  // the current and previous unjittered camera matrices.
+    mat4 previousCameraMatrix;
+    mat4 cameraReprojectionMatrix;  // the camera's current to previous clip space.
+    vec2 projectionJitter;  // in NDC.
+    vec2 renderExtent;  // in pixels.
+} uniformBufferObject;
+
+layout(binding = 1) uniform sampler2D depthImage;  // single-sampled, temporal anti-aliasing renders without msaa.
+
+layout(location = 0) out vec2 outputMotion;  // see TemporalAntiAliasing::motionVectorsImageFormat.
+
+void main()
+{
+    float fragmentDepth = texelFetch(depthImage, ivec2(gl_FragCoord.xy), 0).r;
+
+    // the pixel's NDC position without the projection's jitter, the reprojection matrices are unjittered.
+    vec2 fragmentCoordinates = ((((gl_FragCoord.xy / uniformBufferObject.renderExtent) * 2.0) - 1.0) - uniformBufferObject.projectionJitter);
+
+    // every pixel only moves with the camera here, the instances are drawn over their pixels with their own motion(see motionVectorsGeometry.vert).
+    vec4 previousPosition = (uniformBufferObject.cameraReprojectionMatrix * vec4(fragmentCoordinates, fragmentDepth, 1.0));
+    if (previousPosition.w <= 0.0) {  // behind the previous camera, the resolve's history clamp rejects whatever history is read.
+        outputMotion = vec2(0.0);
+        return;
+    }
+
+    outputMotion = ((fragmentCoordinates - (previousPosition.xy / previousPosition.w)) * 0.5);  // in texture coordinates, the history is read at the current coordinates minus the motion.
+}
\ No newline at end of file
@@ -0,0 +1,26 @@
+#version 450
+
+const float depthTolerance = 0.000001;  // a fragment this close to the scene depth is the drawn surface, the depth format can be less precise than the rasterized depth.
+
+layout(binding = 1) uniform sampler2D depthImage;  // single-sampled, temporal anti-aliasing renders without msaa.
+
+layout(location = 0) in vec4 currentPosition;
+layout(location = 1) in vec4 previousPosition;
+
+layout(location = 0) out vec2 outputMotion;  // see TemporalAntiAliasing::motionVectorsImageFormat.
+
+void main()
+{
+    // the instances are drawn without a depth attachment, fragments hidden in the scene keep the camera motion written before them.
+    float sceneDepth = texelFetch(depthImage, ivec2(gl_FragCoord.xy), 0).r;
+    if (abs(gl_FragCoord.z - sceneDepth) > depthTolerance) {
+        discard;
+    }
+
+    if (previousPosition.w <= 0.0) {  // behind the previous camera, the resolve's history clamp rejects whatever history is read.
+        outputMotion = vec2(0.0);
+        return;
+    }
+
+    outputMotion = (((currentPosition.xy / currentPosition.w) - (previousPosition.xy / previousPosition.w)) * 0.5);  // in texture coordinates, the history is read at the current coordinates minus the motion.
+}
\ No newline at end of file
@@ -0,0 +1,41 @@
+#version 450
+
+struct CullingInstance {
+    mat4 modelMatrix;
+    mat4 normalMatrix;
+    vec4 boundingSphere;
+    uvec4 drawParameters;
+    mat4 previousModelMatrix;
+};
+
+layout(binding = 0) uniform TemporalUniformBufferObject {  // identical to Uniform::TemporalUniformBufferObject.
+    mat4 projectionMatrix;  // the scene's jittered projection and view.
+    mat4 viewMatrix;
+    mat4 cameraMatrix;  // the current and previous unjittered camera matrices.
+    mat4 previousCameraMatrix;
+    mat4 cameraReprojectionMatrix;  // the camera's current to previous clip space.
+    vec2 projectionJitter;  // in NDC.
+    vec2 renderExtent;  // in pixels.
+} uniformBufferObject;
+
+layout(std430, binding = 2) readonly buffer CullingInstanceBuffer {
+    CullingInstance instances[];  // indexed by the instance index, the culled draws set the first instance.
+};
+
+layout(location = 0) in vec3 positionAttribute;
+
+invariant gl_Position;  // identical to the depth prepass and the scene, tested against the scene depth.
+
+layout(location = 0) out vec4 currentPosition;  // the unjittered clip space positions of the vertex in the current and the previous frame.
+layout(location = 1) out vec4 previousPosition;
+
+void main()
+{
+    mat4 modelMatrix = instances[gl_InstanceIndex].modelMatrix;
+
+    vec4 positionAttributeVec4 = vec4(positionAttribute, 1.0);
+    gl_Position = (uniformBufferObject.projectionMatrix * uniformBufferObject.viewMatrix * modelMatrix * positionAttributeVec4);  // identical to the scene vertex shader.
+
+    currentPosition = (uniformBufferObject.cameraMatrix * modelMatrix * positionAttributeVec4);
+    previousPosition = (uniformBufferObject.previousCameraMatrix * instances[gl_InstanceIndex].previousModelMatrix * positionAttributeVec4);
+}
\ No newline at end of file
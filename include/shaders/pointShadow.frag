@@ -3,17 +3,32 @@
 layout(binding = 0) uniform PointShadowUniformBufferObject {
     mat4 projectionMatrix;
     mat4 modelMatrix;
+    mat4 viewMatrices[6];
     
     vec3 pointLightPosition;
     uint farPlane;
 } uniformBufferObject;
 
+#ifdef ALPHA_MASKED
+layout(binding = 2) uniform sampler2D textureSampler;
+#endif
+
 layout(location = 0) in VS_OUT {
    vec3 fragmentPositionWorldSpace;
+#ifdef ALPHA_MASKED
+   vec2 fragmentUVCoordinates;
+   flat float fragmentAlphaCutoff;  // the primitive's alpha cutoff.
+#endif
 } vsOut;
 
 void main()
 {
+#ifdef ALPHA_MASKED
+    if (texture(textureSampler, vsOut.fragmentUVCoordinates).a < vsOut.fragmentAlphaCutoff) {  // masked casters only shadow their opaque texels.
+        discard;
+    }
+#endif
+
     float distanceToLight = length(vsOut.fragmentPositionWorldSpace - uniformBufferObject.pointLightPosition);
     distanceToLight /= uniformBufferObject.farPlane;
 
@@ -1,26 +1,52 @@
 #version 450
+#extension GL_EXT_multiview : require
+
+struct CullingInstance {
+    mat4 modelMatrix;
+    mat4 normalMatrix;
+    vec4 boundingSphere;
+    uvec4 drawParameters;
+    mat4 previousModelMatrix;
+};
 
 layout(binding = 0) uniform PointShadowUniformBufferObject {
     mat4 projectionMatrix;
     mat4 modelMatrix;
+    mat4 viewMatrices[6];  // indexed by the cubemap face being rendered(the view index and face index offset).
     
     vec3 pointLightPosition;
     uint farPlane;
 } uniformBufferObject;
 
+layout(std430, binding = 1) readonly buffer CullingInstanceBuffer {
+    CullingInstance instances[];  // indexed by the instance index, the culled draws set the first instance.
+};
+
 layout(push_constant) uniform PointShadowPushConstants {
-    mat4 viewMatrix;
+    uint faceIndexOffset;  // the face rendered by a single face(time-sliced) render pass, 0 when multiview renders every face.
 } pushConstants;
 
 layout(location = 0) in vec3 positionAttribute;
+#ifdef ALPHA_MASKED
+layout(location = 1) in vec2 UVCoordinatesAttribute;  // the masked pipelines read the scene vertex data.
+layout(location = 2) in float alphaCutoffAttribute;
+#endif
 
 layout(location = 0) out VS_OUT {
    vec3 fragmentPositionWorldSpace;
+#ifdef ALPHA_MASKED
+   vec2 fragmentUVCoordinates;
+   flat float fragmentAlphaCutoff;  // the primitive's alpha cutoff.
+#endif
 } vsOut;
 
 void main()
 {
-    gl_Position = (uniformBufferObject.projectionMatrix * pushConstants.viewMatrix  * uniformBufferObject.modelMatrix * vec4(positionAttribute, 1.0));
+    gl_Position = (uniformBufferObject.projectionMatrix * uniformBufferObject.viewMatrices[gl_ViewIndex + pushConstants.faceIndexOffset] * instances[gl_InstanceIndex].modelMatrix * vec4(positionAttribute, 1.0));
 
     vsOut.fragmentPositionWorldSpace = gl_Position.xyz;
+#ifdef ALPHA_MASKED
+    vsOut.fragmentUVCoordinates = UVCoordinatesAttribute;
+    vsOut.fragmentAlphaCutoff = alphaCutoffAttribute;
+#endif
 }
\ No newline at end of file
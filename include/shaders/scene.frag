@@ -1,125 +1,56 @@
 #version 450
+#extension GL_GOOGLE_include_directive : require
 
-struct SceneLight {
-    uint lightID;
-    vec4 lightProperties;
-    vec4 lightColor;
-};
+#include "sceneLighting.glsl"
 
-layout(binding = 0) uniform UniformBufferObject {
-    mat4 projectionMatrix;
-    mat4 viewMatrix;
-    mat4 modelMatrix;
-    mat4 normalMatrix;
-    mat4 lightSpaceMatrix;
-
-    vec3 viewingPosition;
-    
-    vec4 ambientLightColor;
-
-    SceneLight sceneLights[10];
-    uint sceneLightCount;
-
-    uint farPlane;
-} uniformBufferObject;
+const float sceneShininess = 16.0;
 
 layout(binding = 1) uniform sampler2D textureSampler;
 layout(binding = 2) uniform sampler2D normalImageSampler;
-layout(binding = 3) uniform sampler2D directionalShadowSampler;
-layout(binding = 4) uniform samplerCube pointShadowSampler;
 
 layout(location = 0) in VS_OUT {
-   vec3 fragmentPositionTangentSpace;
-   vec3 viewingPositionTangentSpace;   
-   vec3 sceneLightPositionsTangentSpace[10];
+   mat3 TBNMatrix;  // transforms the normal map's tangent space normals into world space, the fragment is shaded in world space.
 
-   vec4 fragmentPositionLightSpace;
-   vec3 fragmentNormalWorldSpace;
+   vec4 fragmentPositionWorldSpace;  // w: the fragment's view space depth, used in cascade and cluster selection.
    vec2 fragmentUVCoordinates;
 } vsOut;
+#ifdef ALPHA_MASKED
+layout(location = 5) flat in float fragmentAlphaCutoff;  // the albedo alpha below which the primitive's fragments are discarded.
+#endif
 
 layout(location = 0) out vec4 outputColor;
 
-vec3 calculateSceneLightImpact(SceneLight sceneLight, vec3 fragmentPosition, vec3 fragmentNormal, vec3 viewingDirection);
-float calculateDirectionalShadowObscurity(vec4 fragmentPositionLightSpace, float shadowBias);
-float calculatePointShadowObscurity(vec3 fragmentPosition, SceneLight sceneLight, float shadowBias);
-
-vec3 normalMappedFragmentNormal;
+#ifdef ALPHA_MASKED
+float maskAlpha(float albedoAlpha);
+#endif
 
 void main()
 {
-    // this normal is in tangent space.
-    vec3 normalMappedFragmentNormal = texture(normalImageSampler, vsOut.fragmentUVCoordinates).rgb;
-    normalMappedFragmentNormal = normalize((normalMappedFragmentNormal * 2.0) - 1.0);
+    // the normal map is in tangent space, transformed into world space.
+    vec3 normalMappedFragmentNormal = texture(normalImageSampler, vsOut.fragmentUVCoordinates, uniformBufferObject.textureLodBias).rgb;
+    normalMappedFragmentNormal = normalize(vsOut.TBNMatrix * ((normalMappedFragmentNormal * 2.0) - 1.0));
 
-    outputColor = vec4(0.0, 0.0, 0.0, 1.0);
-
-    vec3 ambientLighting = (uniformBufferObject.ambientLightColor.xyz * uniformBufferObject.ambientLightColor.w);
-    outputColor += vec4(ambientLighting, 1.0);
-
-    vec3 viewingDirection = normalize(vsOut.viewingPositionTangentSpace - vsOut.fragmentPositionTangentSpace);
-    for (int i = 0; i < uniformBufferObject.sceneLightCount; i++) {
-        SceneLight updatedSceneLight = uniformBufferObject.sceneLights[i];
-        updatedSceneLight.lightProperties.xyz = vsOut.sceneLightPositionsTangentSpace[i];
-        
-        outputColor += vec4(calculateSceneLightImpact(updatedSceneLight, vsOut.fragmentPositionTangentSpace, normalMappedFragmentNormal, viewingDirection), 0.0);
-    }
+    outputColor = vec4(calculateClusteredLighting(vsOut.fragmentPositionWorldSpace, normalMappedFragmentNormal, sceneShininess, 0.0), 1.0);
 
-    outputColor *= texture(textureSampler, vsOut.fragmentUVCoordinates);
+    outputColor *= texture(textureSampler, vsOut.fragmentUVCoordinates, uniformBufferObject.textureLodBias);
+#ifdef ALPHA_MASKED
+    outputColor.a = maskAlpha(outputColor.a);
+#endif
 }
 
-vec3 calculateSceneLightImpact(SceneLight sceneLight, vec3 fragmentPosition, vec3 fragmentNormal, vec3 viewingDirection)
+#ifdef ALPHA_MASKED
+// sharpen the albedo alpha around the cutoff over a pixel's footprint, alpha-to-coverage turns it into an antialiased edge under msaa.
+// single-sampled, the fragment is discarded below the cutoff instead.
+//
+// @param albedoAlpha the albedo texture's alpha.
+// @return the sharpened alpha written to the first output.
+float maskAlpha(float albedoAlpha)
 {
-    vec3 lightRayDirection = (sceneLight.lightProperties.xyz - (fragmentPosition * sceneLight.lightProperties.w));  // selectively change the direction if the light is point or directional.
-
-    float distance = length(lightRayDirection);
-    float attenuation = (1.0 / (1.0 + (0.09 * distance) + (0.032 * (distance * distance))));  // dot(lightRayDirection, lightRayDirection));
-    attenuation = (sceneLight.lightID == 1 ? attenuation : 1);  // selectively disable attenuation depending on the light type.
-
-    lightRayDirection = normalize(lightRayDirection);
-
-    vec3 unpackedLightColor = (sceneLight.lightColor.xyz * sceneLight.lightColor.w * attenuation);  // packed as RGB color, and the intensity as the A-channel.
-
-
-    float diffuseLightValue = max(dot(normalize(fragmentNormal), lightRayDirection), 0.0);  // we want to avoid negative values.
-    vec3 diffuseLighting = (unpackedLightColor * diffuseLightValue);
-
-
-    float shininessValue = 16;
-    float specularExponent = (sceneLight.lightID == 1 ? 4 : 0);  // selectively disable specular lighting depending on the light type.
-
-    vec3 reflectionDirection = reflect(lightRayDirection, fragmentNormal);
-    vec3 halfwayDirection = normalize(lightRayDirection + viewingDirection);
-    float specularComponent = pow(max(dot(fragmentNormal, halfwayDirection), 0.0), shininessValue);
-    
-    vec3 specularLighting = specularExponent * specularComponent * unpackedLightColor;
-
-    float shadowBias = max((0.05 * (1.0 - dot(fragmentNormal, lightRayDirection))), 0.005);
-    float isObscured = (sceneLight.lightID == 1 ? calculatePointShadowObscurity(fragmentPosition, sceneLight, shadowBias) : calculateDirectionalShadowObscurity(vsOut.fragmentPositionLightSpace, shadowBias));
-
-    return vec3(((diffuseLighting + specularLighting) * (1.0 - isObscured)));
-}
-
-float calculateDirectionalShadowObscurity(vec4 fragmentPositionLightSpace, float shadowBias)
-{
-    vec3 projectedCoordinates = (fragmentPositionLightSpace.xyz / fragmentPositionLightSpace.w);
-    projectedCoordinates = ((projectedCoordinates * 0.5) + 0.5);  // transform coordinates from -1..1 to 0..1.
-
-    float sampledDepthAtCoordinates = texture(directionalShadowSampler, projectedCoordinates.xy).r;
-    float actualDepthAtCoordinates = projectedCoordinates.z;
+    float maskedAlpha = clamp((((albedoAlpha - fragmentAlphaCutoff) / max(fwidth(albedoAlpha), 0.0001)) + 0.5), 0.0, 1.0);
+    if (((gl_NumSamples == 1) && (maskedAlpha < 0.5)) || (maskedAlpha <= 0.0)) {
+        discard;
+    }
 
-    return ((sampledDepthAtCoordinates < actualDepthAtCoordinates - shadowBias) ? 1.0 : 0.0);
+    return ((gl_NumSamples == 1) ? 1.0 : maskedAlpha);
 }
-
-float calculatePointShadowObscurity(vec3 fragmentPosition, SceneLight sceneLight, float shadowBias)
-{
-    vec3 shadowSampleDirection = (fragmentPosition - sceneLight.lightProperties.xyz);
-
-    float sampledDepthAtCoordinates = texture(pointShadowSampler, shadowSampleDirection).r;
-    sampledDepthAtCoordinates *= uniformBufferObject.farPlane;
-
-    float actualDepthAtCoordinates = length(shadowSampleDirection);
-    actualDepthAtCoordinates -= (gl_FrontFacing ? shadowBias : 0.0);
-
-    return ((sampledDepthAtCoordinates < actualDepthAtCoordinates) ? 1.0 : 0.0);
-}
\ No newline at end of file
+#endif
\ No newline at end of file
@@ -1,9 +1,11 @@
 #version 450
 
-struct SceneLight {
-    uint lightID;
-    vec4 lightProperties;
-    vec4 lightColor;
+struct CullingInstance {
+    mat4 modelMatrix;
+    mat4 normalMatrix;
+    vec4 boundingSphere;
+    uvec4 drawParameters;
+    mat4 previousModelMatrix;
 };
 
 layout(binding = 0) uniform UniformBufferObject {
@@ -11,54 +13,64 @@ layout(binding = 0) uniform UniformBufferObject {
     mat4 viewMatrix;
     mat4 modelMatrix;
     mat4 normalMatrix;
-    mat4 lightSpaceMatrix;
+    mat4 cascadeLightSpaceMatrices[4];
+    vec4 cascadeSplitDepths;
 
     vec3 viewingPosition;
     
     vec4 ambientLightColor;
 
-    SceneLight sceneLights[10];
+    vec2 clusterTileSize;  // in pixels.
+    float clusterDepthScale;  // the depth slice is log(view depth) * scale + bias.
+    float clusterDepthBias;
     uint sceneLightCount;
 
     uint farPlane;
+    uint cascadeCount;
+    uint shadowFilterMode;
+
+    mat4 shadowAtlasTileMatrices[48];
+    vec4 shadowAtlasTileRects[48];  // [offset, size] in atlas texture coordinates.
 } uniformBufferObject;
 
+layout(std430, binding = 9) readonly buffer CullingInstanceBuffer {
+    CullingInstance instances[];  // indexed by the instance index, the culled draws set the first instance.
+};
+
 // TODO: can we make this a struct(VS_IN)?
 layout(location = 0) in vec3 positionAttribute;
 layout(location = 1) in vec3 normalAttribute;
 layout(location = 2) in vec3 tangentAttribute;
 layout(location = 3) in vec2 UVCoordinatesAttribute;
+layout(location = 4) in float alphaCutoffAttribute;
+
+invariant gl_Position;  // identical to the depth prepass, tested for equality against its depth.
 
 layout(location = 0) out VS_OUT {
-   vec3 fragmentPositionTangentSpace;
-   vec3 viewingPositionTangentSpace;   
-   vec3 sceneLightPositionsTangentSpace[10];
+   mat3 TBNMatrix;  // transforms the normal map's tangent space normals into world space, the fragment is shaded in world space.
 
-   vec4 fragmentPositionLightSpace;
-   vec3 fragmentNormalWorldSpace;
+   vec4 fragmentPositionWorldSpace;  // w: the fragment's view space depth, used in cascade and cluster selection.
    vec2 fragmentUVCoordinates;
 } vsOut;
+layout(location = 5) flat out float fragmentAlphaCutoff;  // the primitive's alpha cutoff, only read by the masked pipelines.
 
 void main()
 {
-    vec3 calculatedNormal = normalize(vec3(uniformBufferObject.modelMatrix * vec4(normalAttribute, 0.0)));
-    vec3 calculatedTangent = normalize(vec3(uniformBufferObject.modelMatrix * vec4(tangentAttribute, 0.0)));
+    mat4 modelMatrix = instances[gl_InstanceIndex].modelMatrix;
+
+    vec3 calculatedNormal = normalize(mat3(instances[gl_InstanceIndex].normalMatrix) * normalAttribute);
+    vec3 calculatedTangent = normalize(vec3(modelMatrix * vec4(tangentAttribute, 0.0)));
+    calculatedTangent = normalize(calculatedTangent - (dot(calculatedTangent, calculatedNormal) * calculatedNormal));  // re-orthogonalized against the normal, non-uniform scales skew the tangent.
     vec3 calculatedBitangent = cross(calculatedNormal, calculatedTangent);
-    mat3 inversedTBNMatrix = transpose(mat3(calculatedTangent, calculatedBitangent, calculatedNormal));
 
     vec4 positionAttributeVec4 = vec4(positionAttribute, 1.0);
-    gl_Position = (uniformBufferObject.projectionMatrix * uniformBufferObject.viewMatrix * uniformBufferObject.modelMatrix * positionAttributeVec4);
+    gl_Position = (uniformBufferObject.projectionMatrix * uniformBufferObject.viewMatrix * modelMatrix * positionAttributeVec4);
 
-    vec4 vertexWorldSpacePosition = (uniformBufferObject.modelMatrix * positionAttributeVec4);
-    vsOut.fragmentPositionTangentSpace = (inversedTBNMatrix * vertexWorldSpacePosition.xyz);
-    vsOut.viewingPositionTangentSpace = (inversedTBNMatrix * uniformBufferObject.viewingPosition);
-    
-    for (int i = 0; i < uniformBufferObject.sceneLightCount; ++i) {
-        vsOut.sceneLightPositionsTangentSpace[i] = (inversedTBNMatrix * uniformBufferObject.sceneLights[i].lightProperties.xyz);
-    }
+    vec4 vertexWorldSpacePosition = (modelMatrix * positionAttributeVec4);
+    vsOut.TBNMatrix = mat3(calculatedTangent, calculatedBitangent, calculatedNormal);
     
-    vsOut.fragmentPositionLightSpace = (uniformBufferObject.lightSpaceMatrix * positionAttributeVec4);
-    vsOut.fragmentNormalWorldSpace = normalize(vec3(vec4((mat3(uniformBufferObject.normalMatrix) * normalAttribute), 0.0)));
+    vsOut.fragmentPositionWorldSpace = vec4(vertexWorldSpacePosition.xyz, -(uniformBufferObject.viewMatrix * vertexWorldSpacePosition).z);
     
     vsOut.fragmentUVCoordinates = UVCoordinatesAttribute;
+    fragmentAlphaCutoff = alphaCutoffAttribute;
 }
\ No newline at end of file
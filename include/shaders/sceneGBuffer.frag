@@ -0,0 +1,71 @@
+#version 450
+#extension GL_GOOGLE_include_directive : require
+
+#include "sceneLighting.glsl"
+
+// the scene model has no material maps, every surface is a dielectric as rough as the forward scene shader's shininess(2 / roughness² - 2 = 16).
+const float sceneRoughness = 0.333;
+const float sceneMetalness = 0.0;
+
+layout(binding = 1) uniform sampler2D textureSampler;
+layout(binding = 2) uniform sampler2D normalImageSampler;
+
+layout(location = 0) in VS_OUT {
+   mat3 TBNMatrix;  // transforms the normal map's tangent space normals into world space.
+
+   vec4 fragmentPositionWorldSpace;  // unused, the lighting subpass reconstructs the position from depth.
+   vec2 fragmentUVCoordinates;
+} vsOut;
+#ifdef ALPHA_MASKED
+layout(location = 5) flat in float fragmentAlphaCutoff;  // the albedo alpha below which the primitive's fragments are discarded.
+#endif
+
+layout(location = 0) out vec4 outputAlbedo;
+layout(location = 1) out vec2 outputNormal;  // octahedral encoded world space normal.
+layout(location = 2) out vec2 outputMaterial;  // [roughness, metalness].
+
+vec2 encodeOctahedralNormal(vec3 fragmentNormal);
+#ifdef ALPHA_MASKED
+float maskAlpha(float albedoAlpha);
+#endif
+
+void main()
+{
+    vec3 normalMappedFragmentNormal = texture(normalImageSampler, vsOut.fragmentUVCoordinates, uniformBufferObject.textureLodBias).rgb;
+    normalMappedFragmentNormal = normalize(vsOut.TBNMatrix * ((normalMappedFragmentNormal * 2.0) - 1.0));
+
+    outputAlbedo = texture(textureSampler, vsOut.fragmentUVCoordinates, uniformBufferObject.textureLodBias);
+#ifdef ALPHA_MASKED
+    outputAlbedo.a = maskAlpha(outputAlbedo.a);
+#endif
+    outputNormal = encodeOctahedralNormal(normalMappedFragmentNormal);
+    outputMaterial = vec2(sceneRoughness, sceneMetalness);
+}
+
+// project the normal onto an octahedron and unfold it into a square, two components keep its precision over the whole sphere.
+vec2 encodeOctahedralNormal(vec3 fragmentNormal)
+{
+    vec2 octahedralNormal = (fragmentNormal.xy / (abs(fragmentNormal.x) + abs(fragmentNormal.y) + abs(fragmentNormal.z)));
+    if (fragmentNormal.z < 0.0) {  // the lower hemisphere is folded over the diagonals.
+        octahedralNormal = ((1.0 - abs(octahedralNormal.yx)) * vec2((octahedralNormal.x >= 0.0 ? 1.0 : -1.0), (octahedralNormal.y >= 0.0 ? 1.0 : -1.0)));
+    }
+
+    return octahedralNormal;
+}
+
+#ifdef ALPHA_MASKED
+// sharpen the albedo alpha around the cutoff over a pixel's footprint, alpha-to-coverage turns it into an antialiased edge under msaa.
+// single-sampled, the fragment is discarded below the cutoff instead.
+//
+// @param albedoAlpha the albedo texture's alpha.
+// @return the sharpened alpha written to the first output.
+float maskAlpha(float albedoAlpha)
+{
+    float maskedAlpha = clamp((((albedoAlpha - fragmentAlphaCutoff) / max(fwidth(albedoAlpha), 0.0001)) + 0.5), 0.0, 1.0);
+    if (((gl_NumSamples == 1) && (maskedAlpha < 0.5)) || (maskedAlpha <= 0.0)) {
+        discard;
+    }
+
+    return ((gl_NumSamples == 1) ? 1.0 : maskedAlpha);
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,353 @@
+// the scene lighting shared by the forward scene shader and the deferred lighting shader.
+//
+// included after the shader's version, the including shader declares its own inputs and outputs.
+
+struct SceneLight {
+    uint lightID;
+    uint shadowIndex;  // the first shadow atlas tile(point lights use six, or two with dual paraboloids), or a shadow index constant.
+    float lightRange;
+    uint shadowProjection;  // point lights only, a shadow projection constant.
+    vec4 lightProperties;
+    vec4 lightColor;
+    vec4 lightDirection;  // spotlights only, [direction, cosine of the cutoff angle].
+};
+
+const uint noShadowIndex = 0xFFFFFFFFu;
+const uint pointShadowCubemapIndex = 0xFFFFFFFEu;
+const uint shadowlessIndex = 0xFFFFFFFDu;
+
+const uint cubeShadowProjection = 0u;
+const uint dualParaboloidShadowProjection = 1u;
+
+const uint pcfShadowFilter = 0u;
+const uint poissonShadowFilter = 1u;
+const uint pcssShadowFilter = 2u;
+
+// identical to the Uniform cluster constants.
+const uvec3 clusterCounts = uvec3(16, 9, 24);
+const uint maxClusterLightCount = 128u;
+
+// every tap is a hardware PCF(bilinear comparison) tap, blending four texels.
+const vec2 poissonDisk[16] = vec2[](
+    vec2(-0.94201624, -0.39906216), vec2(0.94558609, -0.76890725), vec2(-0.09418410, -0.92938870), vec2(0.34495938, 0.29387760),
+    vec2(-0.91588581, 0.45771432), vec2(-0.81544232, -0.87912464), vec2(-0.38277543, 0.27676845), vec2(0.97484398, 0.75648379),
+    vec2(0.44323325, -0.97511554), vec2(0.53742981, -0.47373420), vec2(-0.26496911, -0.41893023), vec2(0.79197514, 0.19090188),
+    vec2(-0.24188840, 0.99706507), vec2(-0.81409955, 0.91437590), vec2(0.19984126, 0.78641367), vec2(0.14383161, -0.14100790)
+);
+const uint poissonTapCount = 8u;  // the first taps of the disk, spread over all of it.
+const uint pcssBlockerSearchTapCount = 8u;
+const uint pcssTapCount = 16u;
+const float poissonFilterRadius = 1.5;  // in shadow map texels.
+const float pcssBlockerSearchRadius = 8.0;
+const float pcssMaximumFilterRadius = 12.0;
+
+layout(binding = 0) uniform UniformBufferObject {
+    mat4 projectionMatrix;
+    mat4 viewMatrix;
+    mat4 modelMatrix;
+    mat4 normalMatrix;
+    mat4 cascadeLightSpaceMatrices[4];
+    vec4 cascadeSplitDepths;
+
+    vec3 viewingPosition;
+    
+    vec4 ambientLightColor;
+
+    vec2 clusterTileSize;  // in pixels.
+    float clusterDepthScale;  // the depth slice is log(view depth) * scale + bias.
+    float clusterDepthBias;
+    uint sceneLightCount;
+
+    uint farPlane;
+    uint cascadeCount;
+    uint shadowFilterMode;
+
+    mat4 shadowAtlasTileMatrices[48];  // paraboloid tiles only store the hemisphere's view matrix.
+    vec4 shadowAtlasTileRects[48];  // [offset, size] in atlas texture coordinates.
+
+    mat4 inverseViewProjectionMatrix;  // the deferred lighting shader reconstructs world space positions from depth.
+    vec2 framebufferExtent;  // in pixels.
+    float textureLodBias;  // the mip levels the material textures are biased by, lowered quality from the quality governor.
+} uniformBufferObject;
+
+layout(binding = 3) uniform sampler2DArrayShadow directionalShadowSampler;  // a layer for each cascade.
+layout(binding = 4) uniform samplerCubeShadow pointShadowSampler;
+layout(binding = 5) uniform sampler2DArrayShadow shadowAtlasSampler;  // a single layer, divided into tiles.
+
+// the shadow maps without comparison, used in PCSS blocker searches.
+layout(binding = 6) uniform sampler2DArray directionalShadowDepthSampler;
+layout(binding = 7) uniform samplerCube pointShadowDepthSampler;
+layout(binding = 8) uniform sampler2DArray shadowAtlasDepthSampler;
+
+layout(std430, binding = 10) readonly buffer SceneLightBuffer {
+    SceneLight sceneLights[];
+};
+
+layout(std430, binding = 11) readonly buffer ClusterLightBuffer {
+    uint clusterLightCounts[3456];  // identical to Uniform::clusterCount.
+    uint clusterLightIndices[];  // each cluster's light indices, maxClusterLightCount long.
+};
+
+uint calculateClusterIndex(float viewDepth);
+vec3 calculateClusteredLighting(vec4 fragmentPositionWorldSpace, vec3 fragmentNormal, float shininessValue, float metalness);
+vec3 calculateSceneLightImpact(SceneLight sceneLight, vec4 fragmentPositionWorldSpace, vec3 fragmentNormal, vec3 viewingDirection, float shininessValue, float metalness);
+float calculateDirectionalShadowObscurity(vec4 fragmentPositionWorldSpace, float shadowBias);
+float calculatePointShadowObscurity(vec3 fragmentPosition, SceneLight sceneLight, float shadowBias);
+float calculateAtlasShadowObscurity(vec3 fragmentPosition, SceneLight sceneLight, float shadowBias);
+float filterShadowMap(sampler2DArrayShadow shadowSampler, sampler2DArray shadowDepthSampler, vec2 shadowCoordinates, float shadowLayer, float referenceDepth, vec4 coordinateBounds, float lightSize, bool orthographicDepth);
+float filterCubeShadowMap(vec3 shadowSampleDirection, float referenceDepth, float lightSize);
+float estimateFilterRadius(float referenceDepth, float blockerDepthSum, float blockerCount, float lightSize, bool orthographicDepth);
+mat2 calculateFilterRotation();
+
+// find the cluster the fragment is in, its screen space tile and exponential depth slice.
+uint calculateClusterIndex(float viewDepth)
+{
+    uvec2 tileCoordinates = min(uvec2(gl_FragCoord.xy / uniformBufferObject.clusterTileSize), (clusterCounts.xy - 1));
+    float depthSlice = ((log(viewDepth) * uniformBufferObject.clusterDepthScale) + uniformBufferObject.clusterDepthBias);
+    uint sliceIndex = min(uint(max(depthSlice, 0.0)), (clusterCounts.z - 1));
+
+    return (tileCoordinates.x + (tileCoordinates.y * clusterCounts.x) + (sliceIndex * clusterCounts.x * clusterCounts.y));
+}
+
+// the ambient lighting and the impact of every light reaching the fragment's cluster.
+//
+// the fragment position(w: view depth) and normal are in world space.
+vec3 calculateClusteredLighting(vec4 fragmentPositionWorldSpace, vec3 fragmentNormal, float shininessValue, float metalness)
+{
+    vec3 clusteredLighting = (uniformBufferObject.ambientLightColor.xyz * uniformBufferObject.ambientLightColor.w);
+
+    vec3 viewingDirection = normalize(uniformBufferObject.viewingPosition - fragmentPositionWorldSpace.xyz);
+    uint clusterIndex = calculateClusterIndex(fragmentPositionWorldSpace.w);
+    uint clusterLightCount = clusterLightCounts[clusterIndex];
+    for (uint i = 0; i < clusterLightCount; i++) {  // only the lights reaching the fragment's cluster.
+        SceneLight sceneLight = sceneLights[clusterLightIndices[(clusterIndex * maxClusterLightCount) + i]];
+        
+        clusteredLighting += calculateSceneLightImpact(sceneLight, fragmentPositionWorldSpace, fragmentNormal, viewingDirection, shininessValue, metalness);
+    }
+
+    return clusteredLighting;
+}
+
+// the scene light, fragment position, normal, and viewing direction are all in world space.
+//
+// metals have no diffuse lighting, their albedo only tints the specular lighting.
+vec3 calculateSceneLightImpact(SceneLight sceneLight, vec4 fragmentPositionWorldSpace, vec3 fragmentNormal, vec3 viewingDirection, float shininessValue, float metalness)
+{
+    vec3 fragmentPosition = fragmentPositionWorldSpace.xyz;
+    vec3 lightRayDirection = (sceneLight.lightProperties.xyz - (fragmentPosition * sceneLight.lightProperties.w));  // selectively change the direction if the light is point or directional.
+
+    float distance = length(lightRayDirection);
+    float attenuation = (1.0 / (1.0 + (0.09 * distance) + (0.032 * (distance * distance))));  // dot(lightRayDirection, lightRayDirection));
+    attenuation = (sceneLight.lightID != 0 ? attenuation : 1);  // selectively disable attenuation depending on the light type.
+
+    if (sceneLight.lightID == 2) {  // spotlights fade out towards the edge of their cone.
+        vec3 spotlightRayDirection = normalize(fragmentPosition - sceneLight.lightProperties.xyz);
+        float outerCutoff = sceneLight.lightDirection.w;
+        float innerCutoff = mix(outerCutoff, 1.0, 0.1);
+        attenuation *= smoothstep(outerCutoff, innerCutoff, dot(spotlightRayDirection, normalize(sceneLight.lightDirection.xyz)));
+    }
+
+    lightRayDirection = normalize(lightRayDirection);
+
+    vec3 unpackedLightColor = (sceneLight.lightColor.xyz * sceneLight.lightColor.w * attenuation);  // packed as RGB color, and the intensity as the A-channel.
+
+
+    float diffuseLightValue = max(dot(normalize(fragmentNormal), lightRayDirection), 0.0);  // we want to avoid negative values.
+    vec3 diffuseLighting = (unpackedLightColor * diffuseLightValue * (1.0 - metalness));
+
+
+    float specularExponent = (sceneLight.lightID != 0 ? 4 : 0);  // selectively disable specular lighting depending on the light type.
+
+    vec3 reflectionDirection = reflect(lightRayDirection, fragmentNormal);
+    vec3 halfwayDirection = normalize(lightRayDirection + viewingDirection);
+    float specularComponent = pow(max(dot(fragmentNormal, halfwayDirection), 0.0), shininessValue);
+    
+    vec3 specularLighting = specularExponent * specularComponent * unpackedLightColor;
+
+    float shadowBias = max((0.05 * (1.0 - dot(fragmentNormal, lightRayDirection))), 0.005);
+    float isObscured = 0.0;
+    if (sceneLight.lightID == 0) {
+        isObscured = calculateDirectionalShadowObscurity(fragmentPositionWorldSpace, shadowBias);
+    } else if (sceneLight.shadowIndex == pointShadowCubemapIndex) {
+        isObscured = calculatePointShadowObscurity(fragmentPosition, sceneLight, shadowBias);
+    } else if ((sceneLight.shadowIndex != noShadowIndex) && (sceneLight.shadowIndex != shadowlessIndex)) {
+        isObscured = calculateAtlasShadowObscurity(fragmentPosition, sceneLight, shadowBias);
+    }
+
+    return vec3(((diffuseLighting + specularLighting) * (1.0 - isObscured)));
+}
+
+float calculateDirectionalShadowObscurity(vec4 fragmentPositionWorldSpace, float shadowBias)
+{
+    // select the first cascade containing the fragment's view depth.
+    uint cascadeIndex = 0;
+    while ((cascadeIndex < uniformBufferObject.cascadeCount) && (fragmentPositionWorldSpace.w > uniformBufferObject.cascadeSplitDepths[cascadeIndex])) {
+        cascadeIndex += 1;
+    }
+    if (cascadeIndex == uniformBufferObject.cascadeCount) {  // beyond the shadow distance.
+        return 0.0;
+    }
+    
+    vec4 fragmentPositionLightSpace = (uniformBufferObject.cascadeLightSpaceMatrices[cascadeIndex] * vec4(fragmentPositionWorldSpace.xyz, 1.0));
+    vec3 projectedCoordinates = (fragmentPositionLightSpace.xyz / fragmentPositionLightSpace.w);
+    projectedCoordinates.xy = ((projectedCoordinates.xy * 0.5) + 0.5);  // transform coordinates from -1..1 to 0..1, the depth is already 0..1.
+
+    float actualDepthAtCoordinates = (projectedCoordinates.z - shadowBias);
+
+    return (1.0 - filterShadowMap(directionalShadowSampler, directionalShadowDepthSampler, projectedCoordinates.xy, float(cascadeIndex), actualDepthAtCoordinates, vec4(0.0, 0.0, 1.0, 1.0), 256.0, true));
+}
+
+float calculatePointShadowObscurity(vec3 fragmentPosition, SceneLight sceneLight, float shadowBias)
+{
+    vec3 shadowSampleDirection = (fragmentPosition - sceneLight.lightProperties.xyz);
+
+    float actualDepthAtCoordinates = length(shadowSampleDirection);
+    actualDepthAtCoordinates -= (gl_FrontFacing ? shadowBias : 0.0);
+    actualDepthAtCoordinates /= uniformBufferObject.farPlane;  // the cubemap stores the distance normalized by the far plane.
+
+    return (1.0 - filterCubeShadowMap(shadowSampleDirection, actualDepthAtCoordinates, 8.0));
+}
+
+float calculateAtlasShadowObscurity(vec3 fragmentPosition, SceneLight sceneLight, float shadowBias)
+{
+    vec3 shadowSampleDirection = (fragmentPosition - sceneLight.lightProperties.xyz);
+
+    float actualDepthAtCoordinates = length(shadowSampleDirection);
+    if (actualDepthAtCoordinates >= sceneLight.lightRange) {  // beyond the tile's far plane.
+        return 0.0;
+    }
+    actualDepthAtCoordinates -= (gl_FrontFacing ? shadowBias : 0.0);
+
+    uint tileIndex = sceneLight.shadowIndex;
+    vec2 tileCoordinates;
+    if ((sceneLight.lightID == 1) && (sceneLight.shadowProjection == dualParaboloidShadowProjection)) {  // a tile for each hemisphere(-Z, +Z), selected by the side of the first hemisphere's base plane.
+        vec3 fragmentPositionHemisphereSpace = (uniformBufferObject.shadowAtlasTileMatrices[tileIndex] * vec4(fragmentPosition, 1.0)).xyz;
+        if (fragmentPositionHemisphereSpace.z > 0.0) {
+            tileIndex += 1;
+            fragmentPositionHemisphereSpace = (uniformBufferObject.shadowAtlasTileMatrices[tileIndex] * vec4(fragmentPosition, 1.0)).xyz;
+        }
+
+        vec3 hemisphereDirection = normalize(fragmentPositionHemisphereSpace);
+        tileCoordinates = clamp((((hemisphereDirection.xy / (1.0 - hemisphereDirection.z)) * 0.5) + 0.5), 0.0, 1.0);  // identical to the shadow atlas vertex shader's projection.
+    } else {
+        if (sceneLight.lightID == 1) {  // point lights have a tile for each cubemap face(+X, -X, +Y, -Y, +Z, -Z), selected by the major axis.
+            vec3 absoluteDirection = abs(shadowSampleDirection);
+            uint majorAxis = (((absoluteDirection.x >= absoluteDirection.y) && (absoluteDirection.x >= absoluteDirection.z)) ? 0u : ((absoluteDirection.y >= absoluteDirection.z) ? 1u : 2u));
+            tileIndex += ((majorAxis * 2) + (shadowSampleDirection[majorAxis] < 0.0 ? 1u : 0u));
+        }
+
+        vec4 fragmentPositionTileSpace = (uniformBufferObject.shadowAtlasTileMatrices[tileIndex] * vec4(fragmentPosition, 1.0));
+        tileCoordinates = clamp((((fragmentPositionTileSpace.xy / fragmentPositionTileSpace.w) * 0.5) + 0.5), 0.0, 1.0);  // transform coordinates from -1..1 to 0..1, kept within the tile.
+    }
+
+    vec4 tileRect = uniformBufferObject.shadowAtlasTileRects[tileIndex];
+    vec4 tileBounds = vec4(tileRect.xy, (tileRect.xy + tileRect.zw));  // filter taps are kept within the tile.
+    actualDepthAtCoordinates /= sceneLight.lightRange;  // the tiles store the distance normalized by the light's range.
+
+    return (1.0 - filterShadowMap(shadowAtlasSampler, shadowAtlasDepthSampler, (tileRect.xy + (tileCoordinates * tileRect.zw)), 0.0, actualDepthAtCoordinates, tileBounds, 8.0, false));
+}
+
+// filter a 2D shadow map around the shadow coordinates with the shadow filter mode, returning the fraction of the fragment that is lit.
+//
+// the light size is in texels, at a receiver twice as far from the light as its blocker(or a unit depth difference with orthographic depth).
+float filterShadowMap(sampler2DArrayShadow shadowSampler, sampler2DArray shadowDepthSampler, vec2 shadowCoordinates, float shadowLayer, float referenceDepth, vec4 coordinateBounds, float lightSize, bool orthographicDepth)
+{
+    if (uniformBufferObject.shadowFilterMode == pcfShadowFilter) {
+        return texture(shadowSampler, vec4(clamp(shadowCoordinates, coordinateBounds.xy, coordinateBounds.zw), shadowLayer, referenceDepth));
+    }
+
+    vec2 texelSize = (1.0 / vec2(textureSize(shadowSampler, 0).xy));
+    mat2 filterRotation = calculateFilterRotation();
+
+    float filterRadius = poissonFilterRadius;
+    uint tapCount = poissonTapCount;
+    if (uniformBufferObject.shadowFilterMode == pcssShadowFilter) {
+        // average the depth of the blockers around the fragment, the penumbra widens as the receiver moves away from them.
+        float blockerDepthSum = 0.0;
+        float blockerCount = 0.0;
+        for (uint i = 0; i < pcssBlockerSearchTapCount; i++) {
+            vec2 blockerSearchCoordinates = (shadowCoordinates + ((filterRotation * poissonDisk[i * 2]) * pcssBlockerSearchRadius * texelSize));
+            float blockerDepth = texture(shadowDepthSampler, vec3(clamp(blockerSearchCoordinates, coordinateBounds.xy, coordinateBounds.zw), shadowLayer)).r;
+            if (blockerDepth < referenceDepth) {
+                blockerDepthSum += blockerDepth;
+                blockerCount += 1.0;
+            }
+        }
+        if (blockerCount == 0.0) {
+            return 1.0;
+        }
+
+        filterRadius = estimateFilterRadius(referenceDepth, blockerDepthSum, blockerCount, lightSize, orthographicDepth);
+        tapCount = pcssTapCount;
+    }
+
+    float litFraction = 0.0;
+    for (uint i = 0; i < tapCount; i++) {
+        vec2 tapCoordinates = (shadowCoordinates + ((filterRotation * poissonDisk[i * (16u / tapCount)]) * filterRadius * texelSize));
+        litFraction += texture(shadowSampler, vec4(clamp(tapCoordinates, coordinateBounds.xy, coordinateBounds.zw), shadowLayer, referenceDepth));
+    }
+
+    return (litFraction / float(tapCount));
+}
+
+// filter the point shadow cubemap around the shadow sample direction, identical to filterShadowMap with taps offset on the plane facing the direction.
+float filterCubeShadowMap(vec3 shadowSampleDirection, float referenceDepth, float lightSize)
+{
+    if (uniformBufferObject.shadowFilterMode == pcfShadowFilter) {
+        return texture(pointShadowSampler, vec4(shadowSampleDirection, referenceDepth));
+    }
+
+    // a cubemap face spans two units at a unit distance along its axis.
+    float texelSize = ((2.0 / float(textureSize(pointShadowSampler, 0).x)) * length(shadowSampleDirection));
+    vec3 tangentUp = ((abs(normalize(shadowSampleDirection).y) < 0.99) ? vec3(0.0, 1.0, 0.0) : vec3(1.0, 0.0, 0.0));
+    vec3 sampleTangent = normalize(cross(tangentUp, shadowSampleDirection));
+    vec3 sampleBitangent = normalize(cross(shadowSampleDirection, sampleTangent));
+    mat2 filterRotation = calculateFilterRotation();
+
+    float filterRadius = poissonFilterRadius;
+    uint tapCount = poissonTapCount;
+    if (uniformBufferObject.shadowFilterMode == pcssShadowFilter) {
+        float blockerDepthSum = 0.0;
+        float blockerCount = 0.0;
+        for (uint i = 0; i < pcssBlockerSearchTapCount; i++) {
+            vec2 blockerSearchOffset = ((filterRotation * poissonDisk[i * 2]) * pcssBlockerSearchRadius * texelSize);
+            float blockerDepth = texture(pointShadowDepthSampler, (shadowSampleDirection + (sampleTangent * blockerSearchOffset.x) + (sampleBitangent * blockerSearchOffset.y))).r;
+            if (blockerDepth < referenceDepth) {
+                blockerDepthSum += blockerDepth;
+                blockerCount += 1.0;
+            }
+        }
+        if (blockerCount == 0.0) {
+            return 1.0;
+        }
+
+        filterRadius = estimateFilterRadius(referenceDepth, blockerDepthSum, blockerCount, lightSize, false);
+        tapCount = pcssTapCount;
+    }
+
+    float litFraction = 0.0;
+    for (uint i = 0; i < tapCount; i++) {
+        vec2 tapOffset = ((filterRotation * poissonDisk[i * (16u / tapCount)]) * filterRadius * texelSize);
+        litFraction += texture(pointShadowSampler, vec4((shadowSampleDirection + (sampleTangent * tapOffset.x) + (sampleBitangent * tapOffset.y)), referenceDepth));
+    }
+
+    return (litFraction / float(tapCount));
+}
+
+// estimate the PCSS filter radius(in texels) from the average blocker depth, with similar triangles between the light, blockers, and receiver.
+float estimateFilterRadius(float referenceDepth, float blockerDepthSum, float blockerCount, float lightSize, bool orthographicDepth)
+{
+    float averageBlockerDepth = (blockerDepthSum / blockerCount);
+    float penumbraRatio = ((referenceDepth - averageBlockerDepth) / (orthographicDepth ? 1.0 : max(averageBlockerDepth, 0.0001)));  // orthographic depths have parallel light rays.
+
+    return clamp((penumbraRatio * lightSize), poissonFilterRadius, pcssMaximumFilterRadius);
+}
+
+// a per-pixel rotation of the Poisson disk, trading banding for noise.
+mat2 calculateFilterRotation()
+{
+    float rotationNoise = fract(52.9829189 * fract(dot(gl_FragCoord.xy, vec2(0.06711056, 0.00583715))));  // interleaved gradient noise.
+    float rotationAngle = (rotationNoise * 6.28318530);
+
+    return mat2(cos(rotationAngle), sin(rotationAngle), -sin(rotationAngle), cos(rotationAngle));
+}
\ No newline at end of file
@@ -0,0 +1,25 @@
+#version 450
+
+const uint visibilityTriangleIndexBits = 23;  // identical to RendererDetails::visibilityTriangleIndexBits.
+
+layout(location = 0) flat in uint instanceIndex;
+layout(location = 1) flat in uint triangleIndexOffset;
+#ifdef ALPHA_MASKED
+layout(location = 2) in vec2 fragmentUVCoordinates;
+layout(location = 3) flat in float fragmentAlphaCutoff;  // the primitive's alpha cutoff.
+
+layout(binding = 1) uniform sampler2D textureSampler;
+#endif
+
+layout(location = 0) out uint outputVisibility;  // [instance index, triangle index], the triangle index(from the instance's first index) in the low bits.
+
+void main()
+{
+#ifdef ALPHA_MASKED
+    if (texture(textureSampler, fragmentUVCoordinates).a < fragmentAlphaCutoff) {  // the visibility buffer has no coverage to write, masked texels are only discarded.
+        discard;
+    }
+#endif
+
+    outputVisibility = ((instanceIndex << visibilityTriangleIndexBits) | (triangleIndexOffset + uint(gl_PrimitiveID)));
+}
\ No newline at end of file
@@ -0,0 +1,50 @@
+#version 450
+
+struct CullingInstance {
+    mat4 modelMatrix;
+    mat4 normalMatrix;
+    vec4 boundingSphere;
+    uvec4 drawParameters;
+    mat4 previousModelMatrix;
+};
+
+layout(binding = 0) uniform UniformBufferObject {  // the leading members of the scene uniform buffer object, the scene descriptor sets are bound.
+    mat4 projectionMatrix;
+    mat4 viewMatrix;
+} uniformBufferObject;
+
+layout(std430, binding = 9) readonly buffer CullingInstanceBuffer {
+    CullingInstance instances[];  // indexed by the instance index, the culled draws set the first instance.
+};
+
+layout(location = 0) in vec3 positionAttribute;  // the other scene attributes are fetched by the visibility buffer shading instead.
+#ifdef ALPHA_MASKED
+layout(location = 3) in vec2 UVCoordinatesAttribute;  // the masked triangles are alpha tested.
+layout(location = 4) in float alphaCutoffAttribute;
+#endif
+
+invariant gl_Position;  // identical to the depth prepass, tested for equality against its depth.
+
+layout(location = 0) flat out uint instanceIndex;
+layout(location = 1) flat out uint triangleIndexOffset;  // the masked draws start after the instance's opaque triangles, gl_PrimitiveID is relative to each draw.
+#ifdef ALPHA_MASKED
+layout(location = 2) out vec2 fragmentUVCoordinates;
+layout(location = 3) flat out float fragmentAlphaCutoff;
+#endif
+
+void main()
+{
+    mat4 modelMatrix = instances[gl_InstanceIndex].modelMatrix;
+
+    vec4 positionAttributeVec4 = vec4(positionAttribute, 1.0);
+    gl_Position = (uniformBufferObject.projectionMatrix * uniformBufferObject.viewMatrix * modelMatrix * positionAttributeVec4);  // identical to the scene vertex shader.
+
+    instanceIndex = uint(gl_InstanceIndex);
+#ifdef ALPHA_MASKED
+    triangleIndexOffset = (instances[gl_InstanceIndex].drawParameters.x / 3);
+    fragmentUVCoordinates = UVCoordinatesAttribute;
+    fragmentAlphaCutoff = alphaCutoffAttribute;
+#else
+    triangleIndexOffset = 0;
+#endif
+}
\ No newline at end of file
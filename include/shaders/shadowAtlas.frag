@@ -0,0 +1,43 @@
+#version 450
+
+layout(binding = 0) uniform ShadowAtlasUniformBufferObject {
+    mat4 modelMatrix;
+    mat4 tileMatrices[48];
+    vec4 tileLightPositions[48];  // [light position, light range].
+    uvec4 tileProjections[48];
+} uniformBufferObject;
+
+#ifdef ALPHA_MASKED
+layout(binding = 1) uniform sampler2D textureSampler;
+#endif
+
+layout(push_constant) uniform ShadowAtlasPushConstants {
+    uint tileIndex;
+} pushConstants;
+
+layout(location = 0) in VS_OUT {
+   vec3 fragmentPositionWorldSpace;
+   float hemisphereFacing;
+#ifdef ALPHA_MASKED
+   vec2 fragmentUVCoordinates;
+   flat float fragmentAlphaCutoff;  // the primitive's alpha cutoff.
+#endif
+} vsOut;
+
+void main()
+{
+    if (vsOut.hemisphereFacing < 0.0) {  // covered by the other paraboloid hemisphere.
+        discard;
+    }
+#ifdef ALPHA_MASKED
+    if (texture(textureSampler, vsOut.fragmentUVCoordinates).a < vsOut.fragmentAlphaCutoff) {  // masked casters only shadow their opaque texels.
+        discard;
+    }
+#endif
+    
+    // spotlight and point light tiles both store the distance to the light, normalized by the light's range.
+    vec4 tileLightPosition = uniformBufferObject.tileLightPositions[pushConstants.tileIndex];
+    float distanceToLight = length(vsOut.fragmentPositionWorldSpace - tileLightPosition.xyz);
+
+    gl_FragDepth = min((distanceToLight / tileLightPosition.w), 1.0);
+}
\ No newline at end of file
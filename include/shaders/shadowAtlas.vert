@@ -0,0 +1,55 @@
+#version 450
+
+const uint cubeShadowProjection = 0u;
+const uint dualParaboloidShadowProjection = 1u;
+
+layout(binding = 0) uniform ShadowAtlasUniformBufferObject {
+    mat4 modelMatrix;
+    mat4 tileMatrices[48];  // indexed by the tile being rendered, paraboloid tiles only store the hemisphere's view matrix.
+    vec4 tileLightPositions[48];  // [light position, light range].
+    uvec4 tileProjections[48];  // [shadow projection, unused, unused, unused].
+} uniformBufferObject;
+
+layout(push_constant) uniform ShadowAtlasPushConstants {
+    uint tileIndex;  // the tile being rendered, its atlas region is selected by the viewport and scissor.
+} pushConstants;
+
+layout(location = 0) in vec3 positionAttribute;
+#ifdef ALPHA_MASKED
+layout(location = 1) in vec2 UVCoordinatesAttribute;  // the masked pipeline reads the scene vertex data.
+layout(location = 2) in float alphaCutoffAttribute;
+#endif
+
+layout(location = 0) out VS_OUT {
+   vec3 fragmentPositionWorldSpace;
+   float hemisphereFacing;  // paraboloid tiles only, negative behind the hemisphere's base plane.
+#ifdef ALPHA_MASKED
+   vec2 fragmentUVCoordinates;
+   flat float fragmentAlphaCutoff;  // the primitive's alpha cutoff.
+#endif
+} vsOut;
+
+void main()
+{
+    vec4 vertexWorldSpacePosition = (uniformBufferObject.modelMatrix * vec4(positionAttribute, 1.0));
+    vsOut.hemisphereFacing = 1.0;
+    
+    if (uniformBufferObject.tileProjections[pushConstants.tileIndex].x == dualParaboloidShadowProjection) {
+        // project the direction to the vertex onto the hemisphere's paraboloid, the depth is linear in the distance to the light.
+        // the projection is non-linear, edges are only correct for finely tessellated casters.
+        vec3 vertexHemisphereSpacePosition = (uniformBufferObject.tileMatrices[pushConstants.tileIndex] * vertexWorldSpacePosition).xyz;
+        float distanceToLight = length(vertexHemisphereSpacePosition);
+        vec3 hemisphereDirection = (vertexHemisphereSpacePosition / distanceToLight);
+
+        gl_Position = vec4((hemisphereDirection.xy / (1.0 - hemisphereDirection.z)), (distanceToLight / uniformBufferObject.tileLightPositions[pushConstants.tileIndex].w), 1.0);
+        vsOut.hemisphereFacing = -hemisphereDirection.z;  // the view looks down -Z.
+    } else {
+        gl_Position = (uniformBufferObject.tileMatrices[pushConstants.tileIndex] * vertexWorldSpacePosition);
+    }
+
+    vsOut.fragmentPositionWorldSpace = vertexWorldSpacePosition.xyz;
+#ifdef ALPHA_MASKED
+    vsOut.fragmentUVCoordinates = UVCoordinatesAttribute;
+    vsOut.fragmentAlphaCutoff = alphaCutoffAttribute;
+#endif
+}
\ No newline at end of file
@@ -0,0 +1,47 @@
+#version 450
+#extension GL_GOOGLE_include_directive : require
+
+#include "tonemapping.glsl"
+
+layout(binding = 0) uniform sampler2D sceneColor;  // single-sampled HDR.
+layout(std430, binding = 4) readonly buffer ExposureBuffer {  // identical to PostProcessing::ExposureState.
+    float adaptedLuminance;
+    float exposure;
+} exposureBuffer;
+
+layout(location = 0) out vec2 outputEdges;  // [top, left], see AntiAliasing::edgesImageFormat.
+
+const float edgeThreshold = 0.1;  // the smallest luma difference detected as an edge.
+const float localContrastAdaptationFactor = 2.0;  // an edge is dropped if a neighboring edge's luma difference is this much larger.
+
+float fetchLuma(ivec2 pixel)
+{
+    // edges are found in the displayed colors, the bloom is too smooth to add any.
+    vec3 color = tonemapColor(texelFetch(sceneColor, clamp(pixel, ivec2(0), (textureSize(sceneColor, 0) - 1)), 0).rgb, vec3(0.0), exposureBuffer.exposure);
+    return sqrt(dot(color, vec3(0.299, 0.587, 0.114)));  // the displayed color is linear, edges are found in (approximately) perceptual luma.
+}
+
+void main()
+{
+    ivec2 pixel = ivec2(gl_FragCoord.xy);
+
+    float luma = fetchLuma(pixel);
+    float lumaTop = fetchLuma(pixel + ivec2(0, -1));
+    float lumaLeft = fetchLuma(pixel + ivec2(-1, 0));
+
+    vec2 lumaDelta = abs(luma - vec2(lumaTop, lumaLeft));
+    vec2 edges = step(edgeThreshold, lumaDelta);
+    if (dot(edges, vec2(1.0)) == 0.0) {
+        discard;  // the edges image is cleared to no edges.
+    }
+
+    // local contrast adaptation, a weak edge next to a much stronger parallel edge is a gradient, not an edge.
+    float lumaDeltaBottom = abs(luma - fetchLuma(pixel + ivec2(0, 1)));
+    float lumaDeltaRight = abs(luma - fetchLuma(pixel + ivec2(1, 0)));
+    float lumaDeltaTopTop = abs(lumaTop - fetchLuma(pixel + ivec2(0, -2)));
+    float lumaDeltaLeftLeft = abs(lumaLeft - fetchLuma(pixel + ivec2(-2, 0)));
+    float maximumLumaDelta = max(max(max(lumaDelta.x, lumaDelta.y), max(lumaDeltaBottom, lumaDeltaRight)), max(lumaDeltaTopTop, lumaDeltaLeftLeft));
+    edges *= step(maximumLumaDelta, (localContrastAdaptationFactor * lumaDelta));
+
+    outputEdges = edges;
+}
\ No newline at end of file
@@ -0,0 +1,86 @@
+#version 450
+
+layout(binding = 1) uniform sampler2D edgesImage;  // [top, left] edges, written by the SMAA edge detection pass.
+
+layout(location = 0) out vec4 outputWeights;  // see AntiAliasing::blendingWeightsImageFormat.
+
+const int maximumSearchDistance = 16;  // the farthest(in pixels) an edge's ends are searched for.
+
+vec2 fetchEdges(ivec2 pixel)
+{
+    if (any(lessThan(pixel, ivec2(0))) || any(greaterThanEqual(pixel, textureSize(edgesImage, 0)))) {
+        return vec2(0.0);
+    }
+
+    return texelFetch(edgesImage, pixel, 0).rg;
+}
+
+// the signed coverage of a pixel on an edge line, the area between the edge and the line reconstructed from the edge's ends(MLAA).
+// a positive coverage crosses into the neighbor's side of the edge, a negative coverage into the pixel's own side.
+//
+// @param ends the distance to each end of the edge line(excluding the pixel itself).
+// @param crossings the side each end's crossing edge is on, 1 on the neighbor's side, -1 on the pixel's own side, 0 if it has none(or both).
+float calculateCoverage(vec2 ends, vec2 crossings)
+{
+    float edgeLength = (ends.x + ends.y + 1.0);
+    float pixelPosition = ((ends.x + 0.5) / edgeLength);  // the pixel's center along the edge line, from 0 to 1.
+
+    // the line falls from half a pixel at each crossing end to the edge at the edge line's middle.
+    return (0.5 * ((crossings.x * max((1.0 - (2.0 * pixelPosition)), 0.0)) + (crossings.y * max(((2.0 * pixelPosition) - 1.0), 0.0))));
+}
+
+void main()
+{
+    ivec2 pixel = ivec2(gl_FragCoord.xy);
+
+    vec2 edges = fetchEdges(pixel);
+    if (dot(edges, vec2(1.0)) == 0.0) {
+        discard;  // the blending weights image is cleared to no blending.
+    }
+
+    vec4 weights = vec4(0.0);
+
+    if (edges.x > 0.0) {  // top edge, the line runs horizontally.
+        vec2 ends = vec2(0.0);
+        while ((ends.x < maximumSearchDistance) && (fetchEdges(pixel - ivec2((int(ends.x) + 1), 0)).x > 0.0)) {
+            ends.x += 1.0;
+        }
+        while ((ends.y < maximumSearchDistance) && (fetchEdges(pixel + ivec2((int(ends.y) + 1), 0)).x > 0.0)) {
+            ends.y += 1.0;
+        }
+
+        // each end's crossing edge is the left edge of the pixel past it, in the pixel's row or the top neighbor's row.
+        ivec2 leftEnd = (pixel - ivec2(int(ends.x), 0));
+        ivec2 rightEnd = (pixel + ivec2((int(ends.y) + 1), 0));
+        vec2 crossings = vec2(
+            (fetchEdges(leftEnd + ivec2(0, -1)).y - fetchEdges(leftEnd).y),
+            (fetchEdges(rightEnd + ivec2(0, -1)).y - fetchEdges(rightEnd).y));
+
+        float coverage = calculateCoverage(ends, crossings);
+        weights.x = max(-coverage, 0.0);  // the pixel blends towards its top neighbor.
+        weights.y = max(coverage, 0.0);  // the top neighbor blends towards the pixel.
+    }
+
+    if (edges.y > 0.0) {  // left edge, the line runs vertically.
+        vec2 ends = vec2(0.0);
+        while ((ends.x < maximumSearchDistance) && (fetchEdges(pixel - ivec2(0, (int(ends.x) + 1))).y > 0.0)) {
+            ends.x += 1.0;
+        }
+        while ((ends.y < maximumSearchDistance) && (fetchEdges(pixel + ivec2(0, (int(ends.y) + 1))).y > 0.0)) {
+            ends.y += 1.0;
+        }
+
+        // each end's crossing edge is the top edge of the pixel past it, in the pixel's column or the left neighbor's column.
+        ivec2 topEnd = (pixel - ivec2(0, int(ends.x)));
+        ivec2 bottomEnd = (pixel + ivec2(0, (int(ends.y) + 1)));
+        vec2 crossings = vec2(
+            (fetchEdges(topEnd + ivec2(-1, 0)).x - fetchEdges(topEnd).x),
+            (fetchEdges(bottomEnd + ivec2(-1, 0)).x - fetchEdges(bottomEnd).x));
+
+        float coverage = calculateCoverage(ends, crossings);
+        weights.z = max(-coverage, 0.0);  // the pixel blends towards its left neighbor.
+        weights.w = max(coverage, 0.0);  // the left neighbor blends towards the pixel.
+    }
+
+    outputWeights = weights;
+}
\ No newline at end of file
@@ -0,0 +1,115 @@
+#version 450
+#extension GL_GOOGLE_include_directive : require
+
+#include "tonemapping.glsl"
+
+layout(binding = 0) uniform sampler2D sceneColor;  // single-sampled HDR, rendered into the render scale's region with the jittered projection.
+layout(binding = 1) uniform sampler2D motionVectors;  // written by the motion vectors pass, see TemporalAntiAliasing::motionVectorsImageFormat.
+layout(binding = 2) uniform sampler2D depthImage;
+layout(binding = 3) uniform sampler2D historyColor;  // the previous frame's resolved HDR color, at the swapchain's extent.
+layout(binding = 4) uniform sampler2D bloomColor;  // the first bloom level, at half of the swapchain's extent.
+layout(std430, binding = 5) readonly buffer ExposureBuffer {  // identical to PostProcessing::ExposureState.
+    float adaptedLuminance;
+    float exposure;
+} exposureBuffer;
+
+layout(push_constant) uniform ResolvePushConstant {  // identical to TemporalAntiAliasing::ResolvePushConstant.
+    vec2 outputTexelSize;
+    vec2 renderScale;
+    vec2 sceneJitter;
+    uint historyValid;
+} pushConstant;
+
+layout(location = 0) out vec4 outputColor;  // tonemapped.
+layout(location = 1) out vec4 outputHistory;  // resolved in HDR, tonemapping is left to the output.
+
+const float currentFrameWeight = 0.1;  // the weight of a scene color sample centered on the output pixel, the rest is history.
+
+vec3 convertRGBToYCoCg(vec3 color)
+{
+    return vec3(dot(color, vec3(0.25, 0.5, 0.25)), dot(color, vec3(0.5, 0.0, -0.5)), dot(color, vec3(-0.25, 0.5, -0.25)));
+}
+
+vec3 convertYCoCgToRGB(vec3 color)
+{
+    return vec3((color.x + color.y - color.z), (color.x + color.z), (color.x - color.y - color.z));
+}
+
+// clip a history color towards the center of the current neighborhood's box, keeping its hue unlike a per-channel clamp.
+//
+// @param historyColor the history color in YCoCg.
+// @param boxMinimum the minimum of the neighborhood's box in YCoCg.
+// @param boxMaximum the maximum of the neighborhood's box in YCoCg.
+vec3 clipHistoryColor(vec3 historyColor, vec3 boxMinimum, vec3 boxMaximum)
+{
+    vec3 boxCenter = (0.5 * (boxMaximum + boxMinimum));
+    vec3 boxExtent = max((0.5 * (boxMaximum - boxMinimum)), vec3(0.0001));
+
+    vec3 centerOffset = (historyColor - boxCenter);
+    vec3 boxUnits = abs(centerOffset / boxExtent);
+    float maximumBoxUnit = max(boxUnits.x, max(boxUnits.y, boxUnits.z));
+
+    return ((maximumBoxUnit > 1.0) ? (boxCenter + (centerOffset / maximumBoxUnit)) : historyColor);
+}
+
+void main()
+{
+    vec2 outputCoordinates = (gl_FragCoord.xy * pushConstant.outputTexelSize);
+
+    // the unjittered scene position of the output pixel is shifted by the jitter in the rendered scene color.
+    vec2 sceneTexelSize = (1.0 / vec2(textureSize(sceneColor, 0)));
+    vec2 sceneCoordinates = ((outputCoordinates * pushConstant.renderScale) + pushConstant.sceneJitter);
+    ivec2 renderMaximumPixel = (ivec2(pushConstant.renderScale * vec2(textureSize(sceneColor, 0)) + 0.5) - 1);
+    vec2 scenePixelPosition = (sceneCoordinates / sceneTexelSize);
+    ivec2 scenePixel = clamp(ivec2(scenePixelPosition), ivec2(0), renderMaximumPixel);
+
+    // the neighborhood's color variance bounds the history, its nearest depth selects the motion(dilating the edges of moving geometry).
+    vec3 firstMoment = vec3(0.0);
+    vec3 secondMoment = vec3(0.0);
+    float nearestDepth = 1.0;
+    ivec2 nearestPixel = scenePixel;
+    for (int y = -1; y <= 1; y += 1) {
+        for (int x = -1; x <= 1; x += 1) {
+            ivec2 neighborPixel = clamp((scenePixel + ivec2(x, y)), ivec2(0), renderMaximumPixel);
+
+            vec3 neighborColor = convertRGBToYCoCg(texelFetch(sceneColor, neighborPixel, 0).rgb);
+            firstMoment += neighborColor;
+            secondMoment += (neighborColor * neighborColor);
+
+            float neighborDepth = texelFetch(depthImage, neighborPixel, 0).r;
+            if (neighborDepth < nearestDepth) {
+                nearestDepth = neighborDepth;
+                nearestPixel = neighborPixel;
+            }
+        }
+    }
+    vec3 colorMean = (firstMoment / 9.0);
+    vec3 colorDeviation = sqrt(max(((secondMoment / 9.0) - (colorMean * colorMean)), vec3(0.0)));
+
+    vec2 renderCoordinatesMaximum = (pushConstant.renderScale - (0.5 * sceneTexelSize));
+    vec3 currentColor = texture(sceneColor, clamp(sceneCoordinates, (0.5 * sceneTexelSize), renderCoordinatesMaximum)).rgb;
+
+    vec2 historyCoordinates = (outputCoordinates - texelFetch(motionVectors, nearestPixel, 0).rg);
+    bool historyInside = (all(greaterThanEqual(historyCoordinates, vec2(0.0))) && all(lessThanEqual(historyCoordinates, vec2(1.0))));
+    vec3 pixelBloomColor = texture(bloomColor, outputCoordinates).rgb;
+    if ((pushConstant.historyValid == 0) || (historyInside == false)) {  // disoccluded from outside of the screen, or no history yet.
+        outputColor = vec4(tonemapColor(currentColor, pixelBloomColor, exposureBuffer.exposure), 1.0);
+        outputHistory = vec4(currentColor, 1.0);
+        return;
+    }
+
+    vec3 reprojectedColor = convertRGBToYCoCg(texture(historyColor, historyCoordinates).rgb);
+    reprojectedColor = convertYCoCgToRGB(clipHistoryColor(reprojectedColor, (colorMean - colorDeviation), (colorMean + colorDeviation)));
+
+    // samples far from the output pixel's center are trusted less, with upsampling most output pixels fall between the scene's pixels.
+    vec2 sampleOffset = ((scenePixelPosition - (vec2(ivec2(scenePixelPosition)) + 0.5)) / pushConstant.renderScale);  // in output pixels.
+    float blendFactor = (currentFrameWeight * exp(-2.0 * dot(sampleOffset, sampleOffset)));
+
+    // weighting by inverse luma keeps bright sub-pixel details from flickering.
+    float currentWeight = (blendFactor / (1.0 + convertRGBToYCoCg(currentColor).x));
+    float historyWeight = ((1.0 - blendFactor) / (1.0 + convertRGBToYCoCg(reprojectedColor).x));
+    vec3 resolvedColor = (((currentColor * currentWeight) + (reprojectedColor * historyWeight)) / (currentWeight + historyWeight));
+
+    outputColor = vec4(tonemapColor(resolvedColor, pixelBloomColor, exposureBuffer.exposure), 1.0);
+    outputHistory = vec4(resolvedColor, 1.0);
+}
\ No newline at end of file
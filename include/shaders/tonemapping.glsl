@@ -0,0 +1,16 @@
+// the tonemapping shared by the presentation shaders, mapping the HDR scene color into the swapchain's range.
+//
+// included after the shader's version, the including shader declares the bloom image and the exposure buffer(see PostProcessing::ExposureState).
+
+// compose the exposed scene color with the bloom, and tonemap it with a fit of the ACES filmic curve.
+//
+// the result is linear, the swapchain's sRGB format applies the gamma on store.
+//
+// @param sceneColor the HDR scene color.
+// @param bloomColor the bloom at the pixel, already weighted by the bloom intensity.
+// @param exposure the adapted exposure.
+vec3 tonemapColor(vec3 sceneColor, vec3 bloomColor, float exposure)
+{
+    vec3 exposedColor = ((sceneColor + bloomColor) * exposure);
+    return clamp(((exposedColor * ((2.51 * exposedColor) + 0.03)) / ((exposedColor * ((2.43 * exposedColor) + 0.59)) + 0.14)), 0.0, 1.0);
+}
\ No newline at end of file
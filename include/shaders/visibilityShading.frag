@@ -0,0 +1,164 @@
+#version 450
+#extension GL_GOOGLE_include_directive : require
+
+#include "sceneLighting.glsl"
+
+const uint visibilityTriangleIndexBits = 23;  // identical to RendererDetails::visibilityTriangleIndexBits.
+const uint sceneVertexStride = 12;  // identical to ModelHandler::SceneVertexData in floats, [position, normal, tangent, UV coordinates, alpha cutoff].
+const float sceneShininess = 16.0;  // identical to the forward scene shader.
+
+struct CullingInstance {
+    mat4 modelMatrix;
+    mat4 normalMatrix;
+    vec4 boundingSphere;
+    uvec4 drawParameters;  // [opaque index count, first index, vertex offset, masked index count].
+    mat4 previousModelMatrix;
+};
+
+struct BarycentricDerivatives {
+    vec3 barycentrics;  // perspective correct.
+    vec3 barycentricsDdx;  // the change of the barycentrics one pixel to the right.
+    vec3 barycentricsDdy;  // the change of the barycentrics one pixel down.
+};
+
+layout(binding = 1) uniform sampler2D textureSampler;
+layout(binding = 2) uniform sampler2D normalImageSampler;
+
+layout(std430, binding = 9) readonly buffer CullingInstanceBuffer {
+    CullingInstance instances[];
+};
+
+// the main mesh's vertex and index buffers, the vertices are tightly packed and fetched by floats.
+layout(std430, binding = 16) readonly buffer SceneVertexBuffer {
+    float sceneVertices[];
+};
+
+layout(std430, binding = 17) readonly buffer SceneIndexBuffer {
+    uint sceneIndices[];
+};
+
+// the visibility buffer, read from the visibility subpass' attachment in the same render pass.
+#ifdef MULTISAMPLED_VISIBILITY
+layout(input_attachment_index = 0, binding = 12) uniform usubpassInputMS visibilityInput;
+layout(input_attachment_index = 1, binding = 13) uniform subpassInputMS depthInput;
+
+#define loadVisibilityBuffer(visibilityBufferInput) subpassLoad(visibilityBufferInput, gl_SampleID)  // every sample is shaded, the lighting pipeline shades at sample rate.
+#else
+layout(input_attachment_index = 0, binding = 12) uniform usubpassInput visibilityInput;
+layout(input_attachment_index = 1, binding = 13) uniform subpassInput depthInput;
+
+#define loadVisibilityBuffer(visibilityBufferInput) subpassLoad(visibilityBufferInput)
+#endif
+
+layout(location = 0) out vec4 outputColor;
+
+vec3 fetchVertexVector(uint vertexIndex, uint attributeOffset);
+vec2 fetchVertexUVCoordinates(uint vertexIndex);
+BarycentricDerivatives calculateBarycentricDerivatives(vec4 clipSpacePositions[3], vec2 pixelCoordinates);
+
+void main()
+{
+    float fragmentDepth = loadVisibilityBuffer(depthInput).r;
+    if (fragmentDepth == 1.0) {  // no geometry, the cubemap is drawn here afterwards.
+        discard;
+    }
+
+    uint visibility = loadVisibilityBuffer(visibilityInput).r;
+    CullingInstance instance = instances[visibility >> visibilityTriangleIndexBits];
+    uint triangleIndex = (visibility & ((1u << visibilityTriangleIndexBits) - 1u));  // relative to the instance's first index, masked triangles follow the opaque ones.
+
+    // the triangle is fetched and projected again, shading each pixel once no matter how many triangles were drawn over it.
+    uvec3 vertexIndices;
+    vec3 modelSpacePositions[3];
+    vec4 clipSpacePositions[3];
+    mat4 cameraMatrix = (uniformBufferObject.projectionMatrix * uniformBufferObject.viewMatrix * instance.modelMatrix);
+    for (uint i = 0; i < 3; ++i) {
+        vertexIndices[i] = (sceneIndices[instance.drawParameters.y + (triangleIndex * 3) + i] + instance.drawParameters.z);
+        modelSpacePositions[i] = fetchVertexVector(vertexIndices[i], 0);
+        clipSpacePositions[i] = (cameraMatrix * vec4(modelSpacePositions[i], 1.0));
+    }
+
+    BarycentricDerivatives barycentricDerivatives = calculateBarycentricDerivatives(clipSpacePositions, gl_FragCoord.xy);
+    vec3 barycentrics = barycentricDerivatives.barycentrics;
+
+    // the UV coordinates' screen space gradients select the mip level a rasterized triangle would have.
+    mat3x2 triangleUVCoordinates = mat3x2(fetchVertexUVCoordinates(vertexIndices.x), fetchVertexUVCoordinates(vertexIndices.y), fetchVertexUVCoordinates(vertexIndices.z));
+    vec2 fragmentUVCoordinates = (triangleUVCoordinates * barycentrics);
+    vec2 fragmentUVCoordinatesDdx = (triangleUVCoordinates * barycentricDerivatives.barycentricsDdx);
+    vec2 fragmentUVCoordinatesDdy = (triangleUVCoordinates * barycentricDerivatives.barycentricsDdy);
+
+    vec4 vertexWorldSpacePosition = (instance.modelMatrix * vec4((mat3(modelSpacePositions[0], modelSpacePositions[1], modelSpacePositions[2]) * barycentrics), 1.0));
+    vec4 fragmentPositionWorldSpace = vec4(vertexWorldSpacePosition.xyz, -(uniformBufferObject.viewMatrix * vertexWorldSpacePosition).z);  // w: the view space depth, like the scene vertex shader's.
+
+    // identical to the scene vertex shader's TBN basis, interpolated from the triangle's vertices.
+    vec3 normalAttribute = (mat3(fetchVertexVector(vertexIndices.x, 3), fetchVertexVector(vertexIndices.y, 3), fetchVertexVector(vertexIndices.z, 3)) * barycentrics);
+    vec3 tangentAttribute = (mat3(fetchVertexVector(vertexIndices.x, 6), fetchVertexVector(vertexIndices.y, 6), fetchVertexVector(vertexIndices.z, 6)) * barycentrics);
+
+    vec3 calculatedNormal = normalize(mat3(instance.normalMatrix) * normalAttribute);
+    vec3 calculatedTangent = normalize(vec3(instance.modelMatrix * vec4(tangentAttribute, 0.0)));
+    calculatedTangent = normalize(calculatedTangent - (dot(calculatedTangent, calculatedNormal) * calculatedNormal));
+    vec3 calculatedBitangent = cross(calculatedNormal, calculatedTangent);
+
+    // the governed lod bias scales the gradients, textureGrad has no bias parameter.
+    fragmentUVCoordinatesDdx *= exp2(uniformBufferObject.textureLodBias);
+    fragmentUVCoordinatesDdy *= exp2(uniformBufferObject.textureLodBias);
+
+    vec3 normalMappedFragmentNormal = textureGrad(normalImageSampler, fragmentUVCoordinates, fragmentUVCoordinatesDdx, fragmentUVCoordinatesDdy).rgb;
+    normalMappedFragmentNormal = normalize(mat3(calculatedTangent, calculatedBitangent, calculatedNormal) * ((normalMappedFragmentNormal * 2.0) - 1.0));
+
+    outputColor = vec4(calculateClusteredLighting(fragmentPositionWorldSpace, normalMappedFragmentNormal, sceneShininess, 0.0), 1.0);
+
+    outputColor *= textureGrad(textureSampler, fragmentUVCoordinates, fragmentUVCoordinatesDdx, fragmentUVCoordinatesDdy);
+}
+
+// fetch a vec3 vertex attribute(position: 0, normal: 3, tangent: 6) from the scene vertex buffer.
+vec3 fetchVertexVector(uint vertexIndex, uint attributeOffset)
+{
+    uint firstFloat = ((vertexIndex * sceneVertexStride) + attributeOffset);
+    return vec3(sceneVertices[firstFloat], sceneVertices[firstFloat + 1], sceneVertices[firstFloat + 2]);
+}
+
+vec2 fetchVertexUVCoordinates(uint vertexIndex)
+{
+    uint firstFloat = ((vertexIndex * sceneVertexStride) + 9);
+    return vec2(sceneVertices[firstFloat], sceneVertices[firstFloat + 1]);
+}
+
+// the perspective correct barycentrics of the pixel in the projected triangle, and their change to the neighbouring pixels.
+//
+// the barycentrics divided by w are linear in screen space, their gradients are found from the triangle's normalized device coordinates.
+BarycentricDerivatives calculateBarycentricDerivatives(vec4 clipSpacePositions[3], vec2 pixelCoordinates)
+{
+    BarycentricDerivatives barycentricDerivatives;
+
+    vec3 inverseW = (1.0 / vec3(clipSpacePositions[0].w, clipSpacePositions[1].w, clipSpacePositions[2].w));
+    vec2 ndcPosition0 = (clipSpacePositions[0].xy * inverseW.x);
+    vec2 ndcPosition1 = (clipSpacePositions[1].xy * inverseW.y);
+    vec2 ndcPosition2 = (clipSpacePositions[2].xy * inverseW.z);
+
+    float inverseDeterminant = (1.0 / determinant(mat2((ndcPosition2 - ndcPosition1), (ndcPosition0 - ndcPosition1))));
+    vec3 ndcDdx = (vec3((ndcPosition1.y - ndcPosition2.y), (ndcPosition2.y - ndcPosition0.y), (ndcPosition0.y - ndcPosition1.y)) * inverseDeterminant * inverseW);
+    vec3 ndcDdy = (vec3((ndcPosition2.x - ndcPosition1.x), (ndcPosition0.x - ndcPosition2.x), (ndcPosition1.x - ndcPosition0.x)) * inverseDeterminant * inverseW);
+    float inverseWDdx = dot(ndcDdx, vec3(1.0));
+    float inverseWDdy = dot(ndcDdy, vec3(1.0));
+
+    vec2 pixelNdcPosition = (((pixelCoordinates / uniformBufferObject.framebufferExtent) * 2.0) - 1.0);
+    vec2 ndcDelta = (pixelNdcPosition - ndcPosition0);
+    float interpolatedInverseW = (inverseW.x + (ndcDelta.x * inverseWDdx) + (ndcDelta.y * inverseWDdy));
+
+    vec3 interpolatedBarycentricsOverW = ((ndcDelta.x * ndcDdx) + (ndcDelta.y * ndcDdy));
+    interpolatedBarycentricsOverW.x += inverseW.x;
+    barycentricDerivatives.barycentrics = (interpolatedBarycentricsOverW / interpolatedInverseW);
+
+    // a pixel is 2 / extent wide in normalized device coordinates.
+    vec2 pixelNdcSize = (2.0 / uniformBufferObject.framebufferExtent);
+    ndcDdx *= pixelNdcSize.x;
+    ndcDdy *= pixelNdcSize.y;
+    inverseWDdx *= pixelNdcSize.x;
+    inverseWDdy *= pixelNdcSize.y;
+
+    barycentricDerivatives.barycentricsDdx = (((interpolatedBarycentricsOverW + ndcDdx) / (interpolatedInverseW + inverseWDdx)) - barycentricDerivatives.barycentrics);
+    barycentricDerivatives.barycentricsDdy = (((interpolatedBarycentricsOverW + ndcDdy) / (interpolatedInverseW + inverseWDdy)) - barycentricDerivatives.barycentrics);
+
+    return barycentricDerivatives;
+}
\ No newline at end of file
@@ -14,6 +14,7 @@ Application::Application() : m_instance(Defaults::windowDefaults.MAIN_WINDOW_NAM
     glfwSetFramebufferSizeCallback(m_displayDetails.glfwWindow, Callbacks::glfwFramebufferResizeCallback);
     glfwSetMouseButtonCallback(m_displayDetails.glfwWindow, Callbacks::glfwMouseButtonCallback);
     glfwSetScrollCallback(m_displayDetails.glfwWindow, Callbacks::glfwMouseScrollCallback);
+    glfwSetKeyCallback(m_displayDetails.glfwWindow, Callbacks::glfwKeyCallback);
 
     m_renderer.setVulkanLogicalDevice(&m_instance.m_devices.logicalDevice);
 }
@@ -84,3 +84,16 @@ void Callbacks::glfwMouseScrollCallback(GLFWwindow *window, double xoffset, doub
 {
     Defaults::callbacksVariables.MAIN_CAMERA->zoomAmount += (Defaults::rendererDefaults.MAIN_CAMERA_ZOOM_AMOUNT * yoffset);
 }
+
+void Callbacks::glfwKeyCallback(GLFWwindow *window, int key, int scancode, int action, int mods)
+{
+    if (action != GLFW_PRESS) {
+        return;
+    }
+
+    if (key == GLFW_KEY_M) {  // applied by the renderer between frames.
+        Defaults::callbacksVariables.ANTI_ALIASING_CYCLED = true;
+    } else if (key == GLFW_KEY_N) {
+        Defaults::callbacksVariables.SAMPLE_SHADING_TOGGLED = true;
+    }
+}
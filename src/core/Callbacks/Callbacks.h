@@ -42,6 +42,15 @@ namespace Callbacks
     // @param xoffset ?
     // @param yoffset 1: scrolling upwards -1: scrolling downwards.
     void glfwMouseScrollCallback(GLFWwindow *window, double xoffset, double yoffset);
+
+    // GLFW key callback, handles the single press toggles(held keys are polled by DisplayManager::processWindowInput).
+    //
+    // @param window GLFW window that the key action occurred in.
+    // @param key the GLFW key code of the key.
+    // @param scancode the platform-specific scancode of the key.
+    // @param action the action of the key(press, release, repeat).
+    // @param mods the held modifier keys.
+    void glfwKeyCallback(GLFWwindow *window, int key, int scancode, int action, int mods);
 };
 
 
@@ -8,10 +8,29 @@
 #include <core/Logging/ErrorLogger.h>
 #include <core/Model/ModelHandler.h>
 #include <core/Defaults/Defaults.h>
+#include <core/Worker/WorkerThread.h>
 
 #include <vector>
+#include <array>
+#include <thread>
+#include <exception>
+#include <algorithm>
+#include <optional>
+#include <string>
 
 
+void CommandManager::RecordingWorker::cleanupRecordingWorker(VkDevice vulkanLogicalDevice)
+{
+    if (this->persistentWorker != nullptr) {
+        this->persistentWorker->stopWorker();
+
+        delete this->persistentWorker;
+        this->persistentWorker = nullptr;
+    }
+
+    vkDestroyCommandPool(vulkanLogicalDevice, this->commandPool, nullptr);  // child secondary command buffers automatically freed.
+}
+
 void CommandManager::createGraphicsCommandPool(size_t graphicsFamilyIndex, VkDevice vulkanLogicalDevice, VkCommandPool& createdGraphicsCommandPool)
 {
     VkCommandPoolCreateInfo commandPoolCreateInfo{};
@@ -26,7 +45,7 @@ void CommandManager::createGraphicsCommandPool(size_t graphicsFamilyIndex, VkDev
     }
 }
 
-void CommandManager::allocateChildCommandBuffers(VkCommandPool parentCommandPool, size_t commandBufferCount, VkDevice vulkanLogicalDevice, std::vector<VkCommandBuffer>& allocatedChildCommandBuffers)
+void CommandManager::allocateChildCommandBuffers(VkCommandPool parentCommandPool, size_t commandBufferCount, VkCommandBufferLevel commandBufferLevel, VkDevice vulkanLogicalDevice, std::vector<VkCommandBuffer>& allocatedChildCommandBuffers)
 {
     allocatedChildCommandBuffers.resize(commandBufferCount);
     
@@ -34,7 +53,7 @@ void CommandManager::allocateChildCommandBuffers(VkCommandPool parentCommandPool
     commandBufferAllocationInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
 
     commandBufferAllocationInfo.commandPool = parentCommandPool;
-    commandBufferAllocationInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;  // buffers can be submitted directly to queue.
+    commandBufferAllocationInfo.level = commandBufferLevel;  // primary buffers can be submitted directly to queue, secondary buffers are executed from primary buffers.
     commandBufferAllocationInfo.commandBufferCount = commandBufferCount;
 
     uint32_t commandBufferCreationResult = vkAllocateCommandBuffers(vulkanLogicalDevice, &commandBufferAllocationInfo, allocatedChildCommandBuffers.data());
@@ -43,6 +62,29 @@ void CommandManager::allocateChildCommandBuffers(VkCommandPool parentCommandPool
     }
 }
 
+void CommandManager::createRecordingWorkers(size_t graphicsFamilyIndex, uint32_t requestedWorkerCount, VkDevice vulkanLogicalDevice, std::vector<CommandManager::RecordingWorker>& createdRecordingWorkers)
+{
+    uint32_t recordingWorkerCount = requestedWorkerCount;
+    if (recordingWorkerCount == 0) {  // use the amount of hardware threads.
+        recordingWorkerCount = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+    recordingWorkerCount = std::min(recordingWorkerCount, CommandManager::graphicsSecondaryRecordingCount);  // any more workers would sit idle.
+
+    createdRecordingWorkers.resize(recordingWorkerCount);
+
+    uint32_t workerRecordingCount = ((CommandManager::graphicsSecondaryRecordingCount + (recordingWorkerCount - 1)) / recordingWorkerCount);  // the max amount of secondary recordings a single worker is responsible for.
+    for (uint32_t i = 0; i < recordingWorkerCount; i += 1) {
+        CommandManager::RecordingWorker& recordingWorker = createdRecordingWorkers[i];
+        CommandManager::createGraphicsCommandPool(graphicsFamilyIndex, vulkanLogicalDevice, recordingWorker.commandPool);  // command pools are externally synchronized, so every worker needs its own.
+        CommandManager::allocateChildCommandBuffers(recordingWorker.commandPool, (workerRecordingCount * Defaults::rendererDefaults.MAX_FRAMES_IN_FLIGHT), VK_COMMAND_BUFFER_LEVEL_SECONDARY, vulkanLogicalDevice, recordingWorker.secondaryCommandBuffers);
+
+        if (i > 0) {  // the first worker records on the calling thread.
+            recordingWorker.persistentWorker = new WorkerThread::PersistentWorker();
+            recordingWorker.persistentWorker->startWorker();
+        }
+    }
+}
+
 void CommandManager::beginRecordingSingleSubmitCommands(VkCommandPool parentCommandPool, VkDevice vulkanLogicalDevice, VkCommandBuffer& begunCommandBuffer)
 {
     VkCommandBufferAllocateInfo commandBufferAllocateInfo{};
@@ -112,161 +154,484 @@ void CommandManager::populateRect2DInfo(VkExtent2D extent, VkRect2D& rect2DInfo)
     rect2DInfo.extent = extent;
 }
 
-void CommandManager::recordGraphicsCommandBufferCommands(CommandManager::GraphicsRecordingPackage graphicsRecordingPackage)
+void CommandManager::recordSecondaryGraphicsCommands(const CommandManager::GraphicsRecordingPackage& graphicsRecordingPackage, uint32_t recordingIndex, VkCommandBuffer secondaryCommandBuffer)
 {
-    VkCommandBufferBeginInfo commandBufferBeginInfo{};
-    commandBufferBeginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-
-    commandBufferBeginInfo.flags = 0;
-    commandBufferBeginInfo.pInheritanceInfo = nullptr;
+    VkRenderPass inheritedRenderPass;
+    VkFramebuffer inheritedFramebuffer;
+    VkExtent2D renderExtent;
+    const Pipeline::PipelineComponents *pipelineComponents;
+    VkPipeline pipeline = VK_NULL_HANDLE;  // the pipeline components' pipeline if not set.
+    VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;  // the layout the descriptor sets are bound and the push constants pushed with, the pipeline components' pipeline layout if not set.
+    uint32_t inheritedSubpass = 0;
+    const ModelHandler::ShaderBufferComponents *shaderBufferComponents;  // a fullscreen triangle is drawn without vertex data if null.
+    std::optional<uint32_t> pointShadowFaceIndexOffset;  // pushed for point shadow recordings, shadow atlas recordings push each tile's index instead.
+    std::optional<uint32_t> cullingStream;  // the culled draw stream drawn by the recording, the mesh is drawn directly if not set.
+    VkPipeline maskedPipeline = VK_NULL_HANDLE;  // draws the alpha-masked indices after the opaque indices, every index is drawn with the pipeline if null.
+    const ModelHandler::ShaderBufferComponents *maskedShaderBufferComponents = nullptr;  // the masked draws' vertex data, the recording's own if null.
+
+    if (recordingIndex == CommandManager::directionalShadowRecordingIndex) {
+        inheritedRenderPass = graphicsRecordingPackage.directionalShadowOperation.renderPass;
+        inheritedFramebuffer = graphicsRecordingPackage.directionalShadowOperation.framebuffers[graphicsRecordingPackage.currentFrame];
+        renderExtent = graphicsRecordingPackage.directionalShadowOperation.offscreenExtent;
+        pipelineComponents = &graphicsRecordingPackage.directionalShadowOperation.pipelineComponents;
+        shaderBufferComponents = &graphicsRecordingPackage.directionalShadowShaderBufferComponents;
+        cullingStream = Uniform::directionalShadowCullingStream;  // culled against every cascade, the cascades are rendered in one multiview draw.
+        maskedPipeline = graphicsRecordingPackage.directionalShadowOperation.maskedPipelineComponents.pipeline;
+        maskedShaderBufferComponents = &graphicsRecordingPackage.sceneShaderBufferComponents;  // the masked casters' alpha test reads the texture coordinates.
+    } else if (recordingIndex == CommandManager::pointShadowRecordingIndex) {  // multiview renders every cubemap face with one draw.
+        inheritedRenderPass = graphicsRecordingPackage.pointShadowOperation.renderPass;
+        inheritedFramebuffer = graphicsRecordingPackage.pointShadowOperation.framebuffers[graphicsRecordingPackage.currentFrame];
+        renderExtent = graphicsRecordingPackage.pointShadowOperation.renderExtent;
+        pipelineComponents = &graphicsRecordingPackage.pointShadowOperation.pipelineComponents;
+        shaderBufferComponents = &graphicsRecordingPackage.pointShadowShaderBufferComponents;
+        pointShadowFaceIndexOffset = 0;
+        cullingStream = Uniform::pointShadowCullingStream;  // culled against every face, one draw renders every face.
+        maskedPipeline = graphicsRecordingPackage.pointShadowOperation.maskedPipelineComponents.pipeline;
+        maskedShaderBufferComponents = &graphicsRecordingPackage.sceneShaderBufferComponents;
+    } else if (recordingIndex == CommandManager::shadowAtlasRecordingIndex) {  // each tile is drawn with its own viewport and scissor.
+        inheritedRenderPass = graphicsRecordingPackage.shadowAtlasOperation.renderPass;
+        inheritedFramebuffer = graphicsRecordingPackage.shadowAtlasOperation.framebuffers[graphicsRecordingPackage.currentFrame];
+        renderExtent = graphicsRecordingPackage.shadowAtlasOperation.offscreenExtent;
+        pipelineComponents = &graphicsRecordingPackage.shadowAtlasOperation.pipelineComponents;
+        shaderBufferComponents = &graphicsRecordingPackage.shadowAtlasShaderBufferComponents;
+        maskedPipeline = graphicsRecordingPackage.shadowAtlasOperation.maskedPipelineComponents.pipeline;
+        maskedShaderBufferComponents = &graphicsRecordingPackage.sceneShaderBufferComponents;
+    } else if ((recordingIndex >= CommandManager::pointShadowFaceRecordingIndex) && (recordingIndex < CommandManager::shadowAtlasRecordingIndex)) {  // single point shadow face, the face index offset selects the face's view matrix.
+        uint32_t faceIndex = (recordingIndex - CommandManager::pointShadowFaceRecordingIndex);
+        
+        inheritedRenderPass = graphicsRecordingPackage.pointShadowOperation.layerRenderPass;
+        inheritedFramebuffer = graphicsRecordingPackage.pointShadowOperation.layerFramebuffers[faceIndex];
+        renderExtent = graphicsRecordingPackage.pointShadowOperation.renderExtent;
+        pipelineComponents = &graphicsRecordingPackage.pointShadowOperation.pipelineComponents;  // descriptors are shared with the layer pipeline.
+        pipeline = graphicsRecordingPackage.pointShadowOperation.layerPipelineComponents.pipeline;
+        pipelineLayout = graphicsRecordingPackage.pointShadowOperation.layerPipelineComponents.pipelineLayout;  // created from the shared descriptor set layout, the descriptor sets are compatible with it.
+        shaderBufferComponents = &graphicsRecordingPackage.pointShadowShaderBufferComponents;
+        pointShadowFaceIndexOffset = faceIndex;
+        cullingStream = Uniform::pointShadowCullingStream;  // the stream is shared by every face, the rasterizer clips casters outside of the face.
+        maskedPipeline = graphicsRecordingPackage.pointShadowOperation.maskedLayerPipelineComponents.pipeline;
+        maskedShaderBufferComponents = &graphicsRecordingPackage.sceneShaderBufferComponents;
+    } else {  // main render pass.
+        inheritedRenderPass = graphicsRecordingPackage.renderPass;
+        inheritedFramebuffer = graphicsRecordingPackage.sceneFramebuffer;
+        renderExtent = graphicsRecordingPackage.renderExtent;
+
+        // the deferred G-buffer is shaded in the lighting subpass, followed by the forward drawn scene normals and cubemap.
+        bool lightingSubpassRecording = ((recordingIndex == CommandManager::cubemapRecordingIndex) || (recordingIndex == CommandManager::sceneNormalsRecordingIndex) || (recordingIndex == CommandManager::deferredLightingRecordingIndex));
+        inheritedSubpass = (((graphicsRecordingPackage.deferredRenderingEnabled == true) && (lightingSubpassRecording == true)) ? 1 : 0);
+
+        if (recordingIndex == CommandManager::cubemapRecordingIndex) {  // drawn last, only where no geometry was drawn.
+            pipelineComponents = &graphicsRecordingPackage.cubemapPipelineComponents;
+            shaderBufferComponents = &graphicsRecordingPackage.cubemapShaderBufferComponents;
+        } else if (recordingIndex == CommandManager::sceneRecordingIndex) {
+            pipelineComponents = &graphicsRecordingPackage.scenePipelineComponents;
+            shaderBufferComponents = &graphicsRecordingPackage.sceneShaderBufferComponents;
+            cullingStream = Uniform::sceneCullingStream;
+            maskedPipeline = graphicsRecordingPackage.sceneMaskedPipeline;
+        } else if (recordingIndex == CommandManager::sceneLateRecordingIndex) {  // recorded in the late render pass, which is compatible with the render pass.
+            pipelineComponents = &graphicsRecordingPackage.scenePipelineComponents;
+            shaderBufferComponents = &graphicsRecordingPackage.sceneShaderBufferComponents;
+            cullingStream = Uniform::sceneLateCullingStream;
+            maskedPipeline = graphicsRecordingPackage.sceneMaskedPipeline;
+        } else if ((recordingIndex == CommandManager::depthPrepassRecordingIndex) || (recordingIndex == CommandManager::depthPrepassLateRecordingIndex)) {  // the same opaque draws as the scene recordings, only their depth(the masked draws write their own depth).
+            pipelineComponents = &graphicsRecordingPackage.scenePipelineComponents;  // descriptors are shared with the depth prepass pipeline.
+            pipeline = graphicsRecordingPackage.depthPrepassPipeline;
+            shaderBufferComponents = &graphicsRecordingPackage.depthPrepassShaderBufferComponents;
+            cullingStream = ((recordingIndex == CommandManager::depthPrepassRecordingIndex) ? Uniform::sceneCullingStream : Uniform::sceneLateCullingStream);
+        } else if (recordingIndex == CommandManager::deferredLightingRecordingIndex) {  // every lit pixel is shaded once, reading the G-buffer as input attachments.
+            pipelineComponents = &graphicsRecordingPackage.scenePipelineComponents;  // descriptors are shared with the deferred lighting pipeline.
+            pipeline = graphicsRecordingPackage.deferredLightingPipeline;
+            shaderBufferComponents = nullptr;
+        } else {  // the scene normals.
+            pipelineComponents = &graphicsRecordingPackage.sceneNormalsPipelineComponents;
+            shaderBufferComponents = &graphicsRecordingPackage.sceneNormalsShaderBufferComponents;
+        }
+    }
+    
 
-    uint32_t commandBufferBeginResult = vkBeginCommandBuffer(graphicsRecordingPackage.graphicsCommandBuffer, &commandBufferBeginInfo);  // will reset command buffer if already recorded.
-    if (commandBufferBeginResult != VK_SUCCESS) {
-        throwDebugException("Failed to begin recording graphics command buffer commands.");
+    if (pipeline == VK_NULL_HANDLE) {
+        pipeline = pipelineComponents->pipeline;
+    }
+    if (pipelineLayout == VK_NULL_HANDLE) {
+        pipelineLayout = pipelineComponents->pipelineLayout;
     }
     
 
-    // attachment clear values are used in load operation clearing.
-    VkClearValue colorAttachmentClearValue = {{{1.0f, 1.0f, 1.0f, 1.0f}}};  // clear to white.
-    VkClearValue depthAttachmentClearValue = {1.0f, 0.0f};
-    std::array<VkClearValue, 1> directionalShadowAttachmentClearValues = {depthAttachmentClearValue};
-    std::array<VkClearValue, 1> pointShadowAttachmentClearValues = {depthAttachmentClearValue};
-    std::array<VkClearValue, 2> mainAttachmentClearValues = {colorAttachmentClearValue, depthAttachmentClearValue};
+    VkCommandBufferInheritanceInfo commandBufferInheritanceInfo{};
+    commandBufferInheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
 
+    commandBufferInheritanceInfo.renderPass = inheritedRenderPass;
+    commandBufferInheritanceInfo.subpass = inheritedSubpass;
+    commandBufferInheritanceInfo.framebuffer = inheritedFramebuffer;
     
-    VkRenderPassBeginInfo directionalShadowRenderPassBeginInfo{};
-    CommandManager::populateRenderPassBeginInfo(graphicsRecordingPackage.directionalShadowOperation.renderPass, graphicsRecordingPackage.directionalShadowOperation.framebuffers[graphicsRecordingPackage.currentFrame], graphicsRecordingPackage.directionalShadowOperation.offscreenExtent, static_cast<uint32_t>(directionalShadowAttachmentClearValues.size()), directionalShadowAttachmentClearValues.data(), directionalShadowRenderPassBeginInfo);
-
-    vkCmdBeginRenderPass(graphicsRecordingPackage.graphicsCommandBuffer, &directionalShadowRenderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
+    VkCommandBufferBeginInfo commandBufferBeginInfo{};
+    commandBufferBeginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
 
-    // set our dynamic pipeline states.
-    VkViewport directionalShadowDynamicViewport{};
-    CommandManager::populateViewportInfo(0.0f, 0.0f, static_cast<float>(graphicsRecordingPackage.directionalShadowOperation.offscreenExtent.width), static_cast<float>(graphicsRecordingPackage.directionalShadowOperation.offscreenExtent.height), 0.0f, 1.0f, directionalShadowDynamicViewport);
-    vkCmdSetViewport(graphicsRecordingPackage.graphicsCommandBuffer, 0, 1, &directionalShadowDynamicViewport);
+    commandBufferBeginInfo.flags = (VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT | VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);  // executed entirely inside of a render pass, rerecorded every frame.
+    commandBufferBeginInfo.pInheritanceInfo = &commandBufferInheritanceInfo;
 
-    VkRect2D directionalShadowDynamicScissor{};
-    CommandManager::populateRect2DInfo(graphicsRecordingPackage.directionalShadowOperation.offscreenExtent, directionalShadowDynamicScissor);
-    vkCmdSetScissor(graphicsRecordingPackage.graphicsCommandBuffer, 0, 1, &directionalShadowDynamicScissor);
+    uint32_t commandBufferBeginResult = vkBeginCommandBuffer(secondaryCommandBuffer, &commandBufferBeginInfo);  // will reset command buffer if already recorded.
+    if (commandBufferBeginResult != VK_SUCCESS) {
+        throwDebugException("Failed to begin recording secondary graphics command buffer commands.");
+    }
 
-    VkDeviceSize directionalShadowOffsets[] = {0};
+    
+    // set our dynamic pipeline states(not inherited from the primary command buffer).
+    VkViewport dynamicViewport{};
+    CommandManager::populateViewportInfo(0.0f, 0.0f, static_cast<float>(renderExtent.width), static_cast<float>(renderExtent.height), 0.0f, 1.0f, dynamicViewport);
+    vkCmdSetViewport(secondaryCommandBuffer, 0, 1, &dynamicViewport);
 
-    // draw/populate the depth map.
-    vkCmdBindVertexBuffers(graphicsRecordingPackage.graphicsCommandBuffer, 0, 1, &graphicsRecordingPackage.directionalShadowShaderBufferComponents.vertexBuffer, directionalShadowOffsets);
+    VkRect2D dynamicScissor{};
+    CommandManager::populateRect2DInfo(renderExtent, dynamicScissor);
+    vkCmdSetScissor(secondaryCommandBuffer, 0, 1, &dynamicScissor);
 
-    vkCmdBindDescriptorSets(graphicsRecordingPackage.graphicsCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, graphicsRecordingPackage.directionalShadowOperation.pipelineComponents.pipelineLayout, 0, 1, &graphicsRecordingPackage.directionalShadowOperation.pipelineComponents.descriptorSets[graphicsRecordingPackage.currentFrame], 0, nullptr);
-    vkCmdBindPipeline(graphicsRecordingPackage.graphicsCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, graphicsRecordingPackage.directionalShadowOperation.pipelineComponents.pipeline);
+    bool meshIndexed = false;
+    if (shaderBufferComponents != nullptr) {
+        VkDeviceSize offsets[] = {0};
 
-    if ((graphicsRecordingPackage.directionalShadowShaderBufferComponents.indiceCount != -1) && (graphicsRecordingPackage.directionalShadowShaderBufferComponents.verticeCount == -1)) {
-        vkCmdBindIndexBuffer(graphicsRecordingPackage.graphicsCommandBuffer, graphicsRecordingPackage.directionalShadowShaderBufferComponents.indexBuffer, 0, VK_INDEX_TYPE_UINT32);
+        vkCmdBindVertexBuffers(secondaryCommandBuffer, 0, 1, &shaderBufferComponents->vertexBuffer, offsets);
 
-        vkCmdDrawIndexed(graphicsRecordingPackage.graphicsCommandBuffer, graphicsRecordingPackage.directionalShadowShaderBufferComponents.indiceCount, 1, 0, 0, 0);
-    } else if ((graphicsRecordingPackage.directionalShadowShaderBufferComponents.indiceCount == -1) && (graphicsRecordingPackage.directionalShadowShaderBufferComponents.verticeCount != -1)) {
-        vkCmdDraw(graphicsRecordingPackage.graphicsCommandBuffer, graphicsRecordingPackage.directionalShadowShaderBufferComponents.verticeCount, 1, 0, 0);
+        meshIndexed = ((shaderBufferComponents->indiceCount != -1) && (shaderBufferComponents->verticeCount == -1));
+        if (meshIndexed == true) {
+            vkCmdBindIndexBuffer(secondaryCommandBuffer, shaderBufferComponents->indexBuffer, 0, VK_INDEX_TYPE_UINT32);
+        }
     }
 
-    vkCmdEndRenderPass(graphicsRecordingPackage.graphicsCommandBuffer);
+    vkCmdBindDescriptorSets(secondaryCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, 1, &pipelineComponents->descriptorSets[graphicsRecordingPackage.currentFrame], 0, nullptr);
+    vkCmdBindPipeline(secondaryCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
 
+    if (pointShadowFaceIndexOffset.has_value() == true) {
+        vkCmdPushConstants(secondaryCommandBuffer, pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(uint32_t), &pointShadowFaceIndexOffset.value());
+    }
 
-    VkRenderPassBeginInfo pointShadowRenderPassBeginInfo{};
-    CommandManager::populateRenderPassBeginInfo(graphicsRecordingPackage.pointShadowOperation.renderPass, {}, graphicsRecordingPackage.pointShadowOperation.offscreenExtent, static_cast<uint32_t>(pointShadowAttachmentClearValues.size()), pointShadowAttachmentClearValues.data(), pointShadowRenderPassBeginInfo);
-
-    // set our dynamic pipeline states.
-    VkViewport pointShadowDynamicViewport{};
-    CommandManager::populateViewportInfo(0.0f, 0.0f, static_cast<float>(graphicsRecordingPackage.pointShadowOperation.renderExtent.width), static_cast<float>(graphicsRecordingPackage.pointShadowOperation.renderExtent.height), 0.0f, 1.0f, pointShadowDynamicViewport);
-    vkCmdSetViewport(graphicsRecordingPackage.graphicsCommandBuffer, 0, 1, &pointShadowDynamicViewport);
-
-    VkRect2D pointShadowDynamicScissor{};
-    CommandManager::populateRect2DInfo(graphicsRecordingPackage.pointShadowOperation.renderExtent, pointShadowDynamicScissor);
-    vkCmdSetScissor(graphicsRecordingPackage.graphicsCommandBuffer, 0, 1, &pointShadowDynamicScissor);
+    // the masked indices are only split from the opaque indices if the recording has a masked pipeline to draw them with.
+    bool maskedDrawn = ((maskedPipeline != VK_NULL_HANDLE) && (meshIndexed == true) && (graphicsRecordingPackage.maskedIndiceCount > 0));
+    uint32_t opaqueIndiceCount = ((meshIndexed == true) ? (static_cast<uint32_t>(shaderBufferComponents->indiceCount) - ((maskedDrawn == true) ? graphicsRecordingPackage.maskedIndiceCount : 0)) : 0);
+
+    auto recordMeshDraw = [&](bool maskedDraw) {
+        if (maskedDraw == true) {
+            vkCmdDrawIndexed(secondaryCommandBuffer, graphicsRecordingPackage.maskedIndiceCount, 1, opaqueIndiceCount, 0, 0);
+        } else if (meshIndexed == true) {
+            vkCmdDrawIndexed(secondaryCommandBuffer, opaqueIndiceCount, 1, 0, 0, 0);  // command buffer, indice count, instance count, indice index offset, indice add offset, instance index offset.
+        } else if ((shaderBufferComponents->indiceCount == -1) && (shaderBufferComponents->verticeCount != -1)) {
+            vkCmdDraw(secondaryCommandBuffer, shaderBufferComponents->verticeCount, 1, 0, 0);
+        }
+    };
+
+    auto recordDraws = [&](bool maskedDraws) {
+        if (recordingIndex == CommandManager::shadowAtlasRecordingIndex) {
+            for (uint32_t i = 0; i < graphicsRecordingPackage.shadowAtlasTileCount; i += 1) {
+                if ((graphicsRecordingPackage.shadowAtlasTileCasterMasks[i] & 1) == 0) {  // the tile is left cleared.
+                    continue;
+                }
+                
+                const ShadowAtlas::AtlasTile& tile = graphicsRecordingPackage.shadowAtlasTiles[i];
+                
+                VkViewport tileViewport{};
+                CommandManager::populateViewportInfo(static_cast<float>(tile.offsetX), static_cast<float>(tile.offsetY), static_cast<float>(tile.tileSize), static_cast<float>(tile.tileSize), 0.0f, 1.0f, tileViewport);
+                vkCmdSetViewport(secondaryCommandBuffer, 0, 1, &tileViewport);
+
+                VkRect2D tileScissor{};
+                CommandManager::populateRect2DInfo({tile.tileSize, tile.tileSize}, tileScissor);
+                tileScissor.offset = {static_cast<int32_t>(tile.offsetX), static_cast<int32_t>(tile.offsetY)};
+                vkCmdSetScissor(secondaryCommandBuffer, 0, 1, &tileScissor);
+
+                vkCmdPushConstants(secondaryCommandBuffer, pipelineLayout, (VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT), 0, sizeof(uint32_t), &i);
+                recordMeshDraw(maskedDraws);
+            }
+        } else if (cullingStream.has_value() == true) {  // culled instances leave the pass empty(ex: a face only cleared).
+            uint32_t drawnCullingStream = (cullingStream.value() + ((maskedDraws == true) ? Uniform::maskedCullingStreamOffset : 0));
+            if (graphicsRecordingPackage.gpuCullingEnabled == true) {
+                graphicsRecordingPackage.cullingOperation.recordStreamDraw(drawnCullingStream, secondaryCommandBuffer);
+            } else {
+                for (const VkDrawIndexedIndirectCommand& culledDrawCommand : graphicsRecordingPackage.cpuCulledDrawCommands[drawnCullingStream]) {
+                    vkCmdDrawIndexed(secondaryCommandBuffer, culledDrawCommand.indexCount, culledDrawCommand.instanceCount, culledDrawCommand.firstIndex, culledDrawCommand.vertexOffset, culledDrawCommand.firstInstance);
+                }
+            }
+        } else if (shaderBufferComponents == nullptr) {
+            vkCmdDraw(secondaryCommandBuffer, 3, 1, 0, 0);  // the fullscreen triangle's vertices are generated from the vertex index.
+        } else {
+            recordMeshDraw(maskedDraws);
+        }
+    };
 
-    VkDeviceSize pointShadowOffsets[] = {0};
+    recordDraws(false);
 
-    for (size_t i = 0; i < 6; i++) {
-        uint32_t framebufferIndex = (graphicsRecordingPackage.currentFrame + (Defaults::rendererDefaults.MAX_FRAMES_IN_FLIGHT * i));
-        pointShadowRenderPassBeginInfo.framebuffer = graphicsRecordingPackage.pointShadowOperation.framebuffers[framebufferIndex];
-        
-        vkCmdBeginRenderPass(graphicsRecordingPackage.graphicsCommandBuffer, &pointShadowRenderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
-        
+    // the alpha-masked geometry follows in its own pipeline, the opaque draws keep their early depth testing.
+    if (maskedDrawn == true) {
+        if (maskedShaderBufferComponents != nullptr) {
+            VkDeviceSize offsets[] = {0};
 
-        vkCmdPushConstants(graphicsRecordingPackage.graphicsCommandBuffer, graphicsRecordingPackage.pointShadowOperation.pipelineComponents.pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(Uniform::PointShadowPushConstants), &Shader::shadowTransforms[i]);
+            vkCmdBindVertexBuffers(secondaryCommandBuffer, 0, 1, &maskedShaderBufferComponents->vertexBuffer, offsets);
+            vkCmdBindIndexBuffer(secondaryCommandBuffer, maskedShaderBufferComponents->indexBuffer, 0, VK_INDEX_TYPE_UINT32);
+        }
+        vkCmdBindPipeline(secondaryCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, maskedPipeline);  // compatible pipeline layouts, the bound descriptor sets and push constants are kept.
 
-        // draw/populate the depth map.
-        vkCmdBindVertexBuffers(graphicsRecordingPackage.graphicsCommandBuffer, 0, 1, &graphicsRecordingPackage.pointShadowShaderBufferComponents.vertexBuffer, pointShadowOffsets);
+        recordDraws(true);
+    }
 
-        vkCmdBindDescriptorSets(graphicsRecordingPackage.graphicsCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, graphicsRecordingPackage.pointShadowOperation.pipelineComponents.pipelineLayout, 0, 1, &graphicsRecordingPackage.pointShadowOperation.pipelineComponents.descriptorSets[graphicsRecordingPackage.currentFrame], 0, nullptr);
-        vkCmdBindPipeline(graphicsRecordingPackage.graphicsCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, graphicsRecordingPackage.pointShadowOperation.pipelineComponents.pipeline);
 
-        if ((graphicsRecordingPackage.pointShadowShaderBufferComponents.indiceCount != -1) && (graphicsRecordingPackage.pointShadowShaderBufferComponents.verticeCount == -1)) {
-            vkCmdBindIndexBuffer(graphicsRecordingPackage.graphicsCommandBuffer, graphicsRecordingPackage.pointShadowShaderBufferComponents.indexBuffer, 0, VK_INDEX_TYPE_UINT32);
+    uint32_t recordBufferCommandsResult = vkEndCommandBuffer(secondaryCommandBuffer);
+    if (recordBufferCommandsResult != VK_SUCCESS) {
+        throwDebugException("Failed to end recording secondary graphics command buffer commands.");
+    }
+}
 
-            vkCmdDrawIndexed(graphicsRecordingPackage.graphicsCommandBuffer, graphicsRecordingPackage.pointShadowShaderBufferComponents.indiceCount, 1, 0, 0, 0);
-        } else if ((graphicsRecordingPackage.pointShadowShaderBufferComponents.indiceCount == -1) && (graphicsRecordingPackage.pointShadowShaderBufferComponents.verticeCount != -1)) {
-            vkCmdDraw(graphicsRecordingPackage.graphicsCommandBuffer, graphicsRecordingPackage.pointShadowShaderBufferComponents.verticeCount, 1, 0, 0);
+void CommandManager::recordGraphicsCommandBufferCommands(CommandManager::GraphicsRecordingPackage graphicsRecordingPackage)
+{
+    std::vector<CommandManager::RecordingWorker>& recordingWorkers = *graphicsRecordingPackage.recordingWorkers;
+    uint32_t recordingWorkerCount = static_cast<uint32_t>(recordingWorkers.size());
+    uint32_t workerRecordingCount = ((CommandManager::graphicsSecondaryRecordingCount + (recordingWorkerCount - 1)) / recordingWorkerCount);
+
+    // worker n records every n-th secondary recording into its own command pool's command buffers.
+    std::array<VkCommandBuffer, CommandManager::graphicsSecondaryRecordingCount> secondaryCommandBuffers;
+    std::vector<std::exception_ptr> workerExceptions(recordingWorkerCount, nullptr);  // rethrown once every worker is done, the other workers still use the package until then.
+
+    const uint32_t allPointShadowFacesMask = 0b111111;
+    auto recordingSkipped = [&](uint32_t recordingIndex) {  // skipped passes and unrendered point shadow faces aren't recorded.
+        if (recordingIndex == CommandManager::directionalShadowRecordingIndex) {
+            return graphicsRecordingPackage.directionalShadowCached;
+        } else if (recordingIndex == CommandManager::shadowAtlasRecordingIndex) {
+            return graphicsRecordingPackage.shadowAtlasCached;
+        } else if (recordingIndex == CommandManager::pointShadowRecordingIndex) {
+            return (graphicsRecordingPackage.pointShadowFaceMask != allPointShadowFacesMask);
+        } else if (recordingIndex == CommandManager::sceneLateRecordingIndex) {
+            return (graphicsRecordingPackage.occlusionCullingEnabled == false);
+        } else if (recordingIndex == CommandManager::depthPrepassRecordingIndex) {
+            return (graphicsRecordingPackage.depthPrepassEnabled == false);
+        } else if (recordingIndex == CommandManager::depthPrepassLateRecordingIndex) {
+            return ((graphicsRecordingPackage.depthPrepassEnabled == false) || (graphicsRecordingPackage.occlusionCullingEnabled == false));
+        } else if (recordingIndex == CommandManager::deferredLightingRecordingIndex) {
+            return (graphicsRecordingPackage.deferredRenderingEnabled == false);
+        } else if (recordingIndex >= CommandManager::pointShadowFaceRecordingIndex) {
+            uint32_t faceIndex = (recordingIndex - CommandManager::pointShadowFaceRecordingIndex);
+            return ((graphicsRecordingPackage.pointShadowFaceMask == allPointShadowFacesMask) || ((graphicsRecordingPackage.pointShadowFaceMask & (1u << faceIndex)) == 0));
         }
+        return false;
+    };
+    
+    auto recordWorkerSecondaryCommands = [&](uint32_t workerIndex) {
+        try {
+            for (uint32_t i = workerIndex; i < CommandManager::graphicsSecondaryRecordingCount; i += recordingWorkerCount) {
+                if (recordingSkipped(i) == true) {
+                    continue;
+                }
+                
+                uint32_t commandBufferIndex = ((graphicsRecordingPackage.currentFrame * workerRecordingCount) + (i / recordingWorkerCount));
+                secondaryCommandBuffers[i] = recordingWorkers[workerIndex].secondaryCommandBuffers[commandBufferIndex];
+
+                CommandManager::recordSecondaryGraphicsCommands(graphicsRecordingPackage, i, secondaryCommandBuffers[i]);
+            }
+        } catch (...) {
+            workerExceptions[workerIndex] = std::current_exception();
+        }
+    };
 
-        
-        vkCmdEndRenderPass(graphicsRecordingPackage.graphicsCommandBuffer);   
+    // the workers' threads are long-lived, a frame only signals them and waits for them.
+    for (uint32_t i = 1; i < recordingWorkerCount; i += 1) {
+        recordingWorkers[i].persistentWorker->submitJob([&recordWorkerSecondaryCommands, i]() { recordWorkerSecondaryCommands(i); });
     }
+    recordWorkerSecondaryCommands(0);  // the calling thread acts as the first worker.
     
+    for (uint32_t i = 1; i < recordingWorkerCount; i += 1) {
+        recordingWorkers[i].persistentWorker->waitForJob();
+    }
+    for (std::exception_ptr workerException : workerExceptions) {
+        if (workerException != nullptr) {
+            std::rethrow_exception(workerException);
+        }
+    }
     
-    VkRenderPassBeginInfo mainRenderPassBeginInfo{};
-    CommandManager::populateRenderPassBeginInfo(graphicsRecordingPackage.renderPass, graphicsRecordingPackage.swapchainIndexFramebuffer, graphicsRecordingPackage.swapchainImageExtent, static_cast<uint32_t>(mainAttachmentClearValues.size()), mainAttachmentClearValues.data(), mainRenderPassBeginInfo);
-
-    vkCmdBeginRenderPass(graphicsRecordingPackage.graphicsCommandBuffer, &mainRenderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);  // embed render pass commands directly into the primary command buffer.
-
-    // set our dynamic pipeline states.
-    VkViewport mainDynamicViewport{};
-    CommandManager::populateViewportInfo(0.0f, 0.0f, static_cast<float>(graphicsRecordingPackage.swapchainImageExtent.width), static_cast<float>(graphicsRecordingPackage.swapchainImageExtent.height), 0.0f, 1.0f, mainDynamicViewport);
-    vkCmdSetViewport(graphicsRecordingPackage.graphicsCommandBuffer, 0, 1, &mainDynamicViewport);
+    
+    VkCommandBufferBeginInfo commandBufferBeginInfo{};
+    commandBufferBeginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
 
-    VkRect2D mainDynamicScissor{};
-    CommandManager::populateRect2DInfo(graphicsRecordingPackage.swapchainImageExtent, mainDynamicScissor);
-    vkCmdSetScissor(graphicsRecordingPackage.graphicsCommandBuffer, 0, 1, &mainDynamicScissor);
+    commandBufferBeginInfo.flags = 0;
+    commandBufferBeginInfo.pInheritanceInfo = nullptr;
 
-    VkDeviceSize mainOffsets[] = {0};
+    uint32_t commandBufferBeginResult = vkBeginCommandBuffer(graphicsRecordingPackage.graphicsCommandBuffer, &commandBufferBeginInfo);  // will reset command buffer if already recorded.
+    if (commandBufferBeginResult != VK_SUCCESS) {
+        throwDebugException("Failed to begin recording graphics command buffer commands.");
+    }
 
+    graphicsRecordingPackage.resolutionController->recordFrameBeginCommands(graphicsRecordingPackage.currentFrame, graphicsRecordingPackage.graphicsCommandBuffer);
+    
 
-    // TODO: draw after to prevent overdraw.
-    // draw the cubemap.
-    vkCmdBindVertexBuffers(graphicsRecordingPackage.graphicsCommandBuffer, 0, 1, &graphicsRecordingPackage.cubemapShaderBufferComponents.vertexBuffer, mainOffsets);
-    vkCmdBindIndexBuffer(graphicsRecordingPackage.graphicsCommandBuffer, graphicsRecordingPackage.cubemapShaderBufferComponents.indexBuffer, 0, VK_INDEX_TYPE_UINT32);
+    // attachment clear values are used in load operation clearing.
+    VkClearValue colorAttachmentClearValue = {{{1.0f, 1.0f, 1.0f, 1.0f}}};  // clear to white.
+    VkClearValue depthAttachmentClearValue = {1.0f, 0.0f};
+    std::array<VkClearValue, 1> directionalShadowAttachmentClearValues = {depthAttachmentClearValue};
+    std::array<VkClearValue, 1> pointShadowAttachmentClearValues = {depthAttachmentClearValue};
+    std::array<VkClearValue, 1> shadowAtlasAttachmentClearValues = {depthAttachmentClearValue};  // unallocated and empty tiles are left at the light's range.
+    std::vector<VkClearValue> mainAttachmentClearValues = {colorAttachmentClearValue, depthAttachmentClearValue};
+    if (graphicsRecordingPackage.sceneColorResolved == true) {  // the resolve attachment is never cleared.
+        mainAttachmentClearValues.push_back(colorAttachmentClearValue);
+    }
+    if (graphicsRecordingPackage.deferredRenderingEnabled == true) {  // the G-buffer attachments follow the resolve attachment(the visibility buffer only uses the first G-buffer clear value).
+        VkClearValue gBufferAttachmentClearValue = {{{0.0f, 0.0f, 0.0f, 0.0f}}};
+        mainAttachmentClearValues.insert(mainAttachmentClearValues.end(), {gBufferAttachmentClearValue, gBufferAttachmentClearValue, gBufferAttachmentClearValue});
+    }
 
-    vkCmdBindDescriptorSets(graphicsRecordingPackage.graphicsCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, graphicsRecordingPackage.cubemapPipelineComponents.pipelineLayout, 0, 1, &graphicsRecordingPackage.cubemapPipelineComponents.descriptorSets[graphicsRecordingPackage.currentFrame], 0, nullptr);
-    vkCmdBindPipeline(graphicsRecordingPackage.graphicsCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, graphicsRecordingPackage.cubemapPipelineComponents.pipeline);
+    
+    // the render graph records the barriers between the passes.
+    RenderGraph::Graph& renderGraph = *graphicsRecordingPackage.renderGraph;
+
+    renderGraph.setPassRecording("culling", [&](VkCommandBuffer commandBuffer) {
+        graphicsRecordingPackage.cullingOperation.recordCullingCommands(graphicsRecordingPackage.currentFrame, graphicsRecordingPackage.cullingInstanceCount, commandBuffer);
+    });
+
+    renderGraph.setPassRecording("lightClustering", [&](VkCommandBuffer commandBuffer) {
+        graphicsRecordingPackage.lightClusteringOperation.recordClusteringCommands(graphicsRecordingPackage.currentFrame, commandBuffer);
+    });
+
+    renderGraph.setPassRecording("directionalShadow", [&](VkCommandBuffer commandBuffer) {
+        VkRenderPassBeginInfo directionalShadowRenderPassBeginInfo{};
+        CommandManager::populateRenderPassBeginInfo(graphicsRecordingPackage.directionalShadowOperation.renderPass, graphicsRecordingPackage.directionalShadowOperation.framebuffers[graphicsRecordingPackage.currentFrame], graphicsRecordingPackage.directionalShadowOperation.offscreenExtent, static_cast<uint32_t>(directionalShadowAttachmentClearValues.size()), directionalShadowAttachmentClearValues.data(), directionalShadowRenderPassBeginInfo);
+
+        vkCmdBeginRenderPass(commandBuffer, &directionalShadowRenderPassBeginInfo, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);  // render pass commands are recorded in secondary command buffers.
+        vkCmdExecuteCommands(commandBuffer, 1, &secondaryCommandBuffers[CommandManager::directionalShadowRecordingIndex]);
+        vkCmdEndRenderPass(commandBuffer);
+    });
+
+    renderGraph.setPassRecording("pointShadow", [&](VkCommandBuffer commandBuffer) {
+        if (graphicsRecordingPackage.pointShadowFaceMask == allPointShadowFacesMask) {
+            VkRenderPassBeginInfo pointShadowRenderPassBeginInfo{};
+            CommandManager::populateRenderPassBeginInfo(graphicsRecordingPackage.pointShadowOperation.renderPass, graphicsRecordingPackage.pointShadowOperation.framebuffers[graphicsRecordingPackage.currentFrame], graphicsRecordingPackage.pointShadowOperation.offscreenExtent, static_cast<uint32_t>(pointShadowAttachmentClearValues.size()), pointShadowAttachmentClearValues.data(), pointShadowRenderPassBeginInfo);
+
+            vkCmdBeginRenderPass(commandBuffer, &pointShadowRenderPassBeginInfo, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+            vkCmdExecuteCommands(commandBuffer, 1, &secondaryCommandBuffers[CommandManager::pointShadowRecordingIndex]);
+            vkCmdEndRenderPass(commandBuffer);
+            return;
+        }
 
-    vkCmdDrawIndexed(graphicsRecordingPackage.graphicsCommandBuffer, graphicsRecordingPackage.cubemapShaderBufferComponents.indiceCount, 1, 0, 0, 0);  // command buffer, indice count, instance count, indice index offset, indice add offset, instance index offset.
+        for (uint32_t i = 0; i < 6; i += 1) {  // time-sliced, each face's render pass only clears and renders its own layer.
+            if ((graphicsRecordingPackage.pointShadowFaceMask & (1u << i)) == 0) {
+                continue;
+            }
+            
+            VkRenderPassBeginInfo pointShadowFaceRenderPassBeginInfo{};
+            CommandManager::populateRenderPassBeginInfo(graphicsRecordingPackage.pointShadowOperation.layerRenderPass, graphicsRecordingPackage.pointShadowOperation.layerFramebuffers[i], graphicsRecordingPackage.pointShadowOperation.offscreenExtent, static_cast<uint32_t>(pointShadowAttachmentClearValues.size()), pointShadowAttachmentClearValues.data(), pointShadowFaceRenderPassBeginInfo);
+
+            vkCmdBeginRenderPass(commandBuffer, &pointShadowFaceRenderPassBeginInfo, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+            vkCmdExecuteCommands(commandBuffer, 1, &secondaryCommandBuffers[CommandManager::pointShadowFaceRecordingIndex + i]);
+            vkCmdEndRenderPass(commandBuffer);
+        }
+    });
 
-    // draw the scene.
-    vkCmdBindVertexBuffers(graphicsRecordingPackage.graphicsCommandBuffer, 0, 1, &graphicsRecordingPackage.sceneShaderBufferComponents.vertexBuffer, mainOffsets);
-    // index buffer optionally binded later.
+    renderGraph.setPassRecording("shadowAtlas", [&](VkCommandBuffer commandBuffer) {
+        VkRenderPassBeginInfo shadowAtlasRenderPassBeginInfo{};
+        CommandManager::populateRenderPassBeginInfo(graphicsRecordingPackage.shadowAtlasOperation.renderPass, graphicsRecordingPackage.shadowAtlasOperation.framebuffers[graphicsRecordingPackage.currentFrame], graphicsRecordingPackage.shadowAtlasOperation.offscreenExtent, static_cast<uint32_t>(shadowAtlasAttachmentClearValues.size()), shadowAtlasAttachmentClearValues.data(), shadowAtlasRenderPassBeginInfo);
 
-    vkCmdBindDescriptorSets(graphicsRecordingPackage.graphicsCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, graphicsRecordingPackage.scenePipelineComponents.pipelineLayout, 0, 1, &graphicsRecordingPackage.scenePipelineComponents.descriptorSets[graphicsRecordingPackage.currentFrame], 0, nullptr);
-    vkCmdBindPipeline(graphicsRecordingPackage.graphicsCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, graphicsRecordingPackage.scenePipelineComponents.pipeline);
+        vkCmdBeginRenderPass(commandBuffer, &shadowAtlasRenderPassBeginInfo, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);  // every tile in one render pass, the whole atlas is cleared once.
+        vkCmdExecuteCommands(commandBuffer, 1, &secondaryCommandBuffers[CommandManager::shadowAtlasRecordingIndex]);
+        vkCmdEndRenderPass(commandBuffer);
+    });
 
-    if ((graphicsRecordingPackage.sceneShaderBufferComponents.indiceCount != -1) && (graphicsRecordingPackage.sceneShaderBufferComponents.verticeCount == -1)) {
-        vkCmdBindIndexBuffer(graphicsRecordingPackage.graphicsCommandBuffer, graphicsRecordingPackage.sceneShaderBufferComponents.indexBuffer, 0, VK_INDEX_TYPE_UINT32);
+    renderGraph.setPassRecording("mainEarly", [&](VkCommandBuffer commandBuffer) {
+        VkRenderPassBeginInfo mainRenderPassBeginInfo{};
+        CommandManager::populateRenderPassBeginInfo(graphicsRecordingPackage.renderPass, graphicsRecordingPackage.sceneFramebuffer, graphicsRecordingPackage.renderExtent, static_cast<uint32_t>(mainAttachmentClearValues.size()), mainAttachmentClearValues.data(), mainRenderPassBeginInfo);
 
-        vkCmdDrawIndexed(graphicsRecordingPackage.graphicsCommandBuffer, graphicsRecordingPackage.sceneShaderBufferComponents.indiceCount, 1, 0, 0, 0);
-    } else if ((graphicsRecordingPackage.sceneShaderBufferComponents.indiceCount == -1) && (graphicsRecordingPackage.sceneShaderBufferComponents.verticeCount != -1)) {
-        vkCmdDraw(graphicsRecordingPackage.graphicsCommandBuffer, graphicsRecordingPackage.sceneShaderBufferComponents.verticeCount, 1, 0, 0);
+        vkCmdBeginRenderPass(commandBuffer, &mainRenderPassBeginInfo, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+        if (graphicsRecordingPackage.depthPrepassEnabled == true) {
+            vkCmdExecuteCommands(commandBuffer, 1, &secondaryCommandBuffers[CommandManager::depthPrepassRecordingIndex]);
+        }
+        vkCmdExecuteCommands(commandBuffer, 1, &secondaryCommandBuffers[CommandManager::sceneRecordingIndex]);
+        if (graphicsRecordingPackage.deferredRenderingEnabled == true) {
+            vkCmdNextSubpass(commandBuffer, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);  // the lighting subpass.
+            if (graphicsRecordingPackage.occlusionCullingEnabled == false) {
+                vkCmdExecuteCommands(commandBuffer, 1, &secondaryCommandBuffers[CommandManager::deferredLightingRecordingIndex]);
+            }
+        }
+        if (graphicsRecordingPackage.occlusionCullingEnabled == false) {  // the whole frame, the late main pass is skipped.
+            vkCmdExecuteCommands(commandBuffer, 1, &secondaryCommandBuffers[CommandManager::sceneNormalsRecordingIndex]);
+            vkCmdExecuteCommands(commandBuffer, 1, &secondaryCommandBuffers[CommandManager::cubemapRecordingIndex]);  // after every other draw.
+        }
+        vkCmdEndRenderPass(commandBuffer);
+    });
+
+    renderGraph.setPassRecording("depthPyramid", [&](VkCommandBuffer commandBuffer) {
+        graphicsRecordingPackage.depthPyramidOperation.recordReductionCommands(commandBuffer);
+    });
+
+    renderGraph.setPassRecording("lateCulling", [&](VkCommandBuffer commandBuffer) {
+        graphicsRecordingPackage.cullingOperation.recordLateCullingCommands(graphicsRecordingPackage.currentFrame, graphicsRecordingPackage.cullingInstanceCount, commandBuffer);
+    });
+
+    renderGraph.setPassRecording("mainLate", [&](VkCommandBuffer commandBuffer) {
+        VkRenderPassBeginInfo lateRenderPassBeginInfo{};
+        CommandManager::populateRenderPassBeginInfo(graphicsRecordingPackage.lateRenderPass, graphicsRecordingPackage.sceneFramebuffer, graphicsRecordingPackage.renderExtent, 0, nullptr, lateRenderPassBeginInfo);  // the attachments are loaded.
+
+        vkCmdBeginRenderPass(commandBuffer, &lateRenderPassBeginInfo, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+        if (graphicsRecordingPackage.occlusionCullingEnabled == true) {
+            if (graphicsRecordingPackage.depthPrepassEnabled == true) {
+                vkCmdExecuteCommands(commandBuffer, 1, &secondaryCommandBuffers[CommandManager::depthPrepassLateRecordingIndex]);
+            }
+            vkCmdExecuteCommands(commandBuffer, 1, &secondaryCommandBuffers[CommandManager::sceneLateRecordingIndex]);  // the disoccluded instances.
+        }
+        if (graphicsRecordingPackage.deferredRenderingEnabled == true) {  // the whole G-buffer is lit once, after the late G-buffer draws.
+            vkCmdNextSubpass(commandBuffer, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+            vkCmdExecuteCommands(commandBuffer, 1, &secondaryCommandBuffers[CommandManager::deferredLightingRecordingIndex]);
+        }
+        vkCmdExecuteCommands(commandBuffer, 1, &secondaryCommandBuffers[CommandManager::sceneNormalsRecordingIndex]);
+        vkCmdExecuteCommands(commandBuffer, 1, &secondaryCommandBuffers[CommandManager::cubemapRecordingIndex]);  // after every other draw.
+        vkCmdEndRenderPass(commandBuffer);
+    });
+
+    renderGraph.setPassRecording("postBloom", [&](VkCommandBuffer commandBuffer) {
+        graphicsRecordingPackage.postProcessingOperation.recordBloomCommands(graphicsRecordingPackage.renderExtent, commandBuffer);
+    });
+
+    renderGraph.setPassRecording("postExposure", [&](VkCommandBuffer commandBuffer) {
+        graphicsRecordingPackage.postProcessingOperation.recordExposureCommands(graphicsRecordingPackage.frameTime, commandBuffer);
+    });
+
+    if (graphicsRecordingPackage.smaaEnabled == true) {  // the SMAA passes only exist in the graph with SMAA.
+        renderGraph.setPassRecording("antiAliasingEdges", [&](VkCommandBuffer commandBuffer) {
+            graphicsRecordingPackage.antiAliasingOperation.recordEdgeDetectionCommands(commandBuffer);
+        });
+
+        renderGraph.setPassRecording("antiAliasingWeights", [&](VkCommandBuffer commandBuffer) {
+            graphicsRecordingPackage.antiAliasingOperation.recordBlendingWeightCommands(commandBuffer);
+        });
     }
 
-    // draw the scene normals.
-    vkCmdBindVertexBuffers(graphicsRecordingPackage.graphicsCommandBuffer, 0, 1, &graphicsRecordingPackage.sceneNormalsShaderBufferComponents.vertexBuffer, mainOffsets);
-    // index buffer optionally binded later.
-    
-    vkCmdBindDescriptorSets(graphicsRecordingPackage.graphicsCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, graphicsRecordingPackage.sceneNormalsPipelineComponents.pipelineLayout, 0, 1, &graphicsRecordingPackage.sceneNormalsPipelineComponents.descriptorSets[graphicsRecordingPackage.currentFrame], 0, nullptr);
-    vkCmdBindPipeline(graphicsRecordingPackage.graphicsCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, graphicsRecordingPackage.sceneNormalsPipelineComponents.pipeline);
+    if (graphicsRecordingPackage.temporalAntiAliasingEnabled == true) {  // the temporal passes replace the anti-aliasing presentation in the graph.
+        renderGraph.setPassRecording("motionVectors", [&](VkCommandBuffer commandBuffer) {
+            // the instances drawn by the scene passes, with the masked geometry tested against the sampled depth like the opaque geometry.
+            auto recordSceneDraws = [&](VkCommandBuffer geometryCommandBuffer) {
+                std::vector<uint32_t> drawnCullingStreams = {Uniform::sceneCullingStream, (Uniform::sceneCullingStream + Uniform::maskedCullingStreamOffset)};
+                if (graphicsRecordingPackage.occlusionCullingEnabled == true) {
+                    drawnCullingStreams.push_back(Uniform::sceneLateCullingStream);
+                    drawnCullingStreams.push_back(Uniform::sceneLateCullingStream + Uniform::maskedCullingStreamOffset);
+                }
+
+                for (uint32_t drawnCullingStream : drawnCullingStreams) {
+                    if (graphicsRecordingPackage.gpuCullingEnabled == true) {
+                        graphicsRecordingPackage.cullingOperation.recordStreamDraw(drawnCullingStream, geometryCommandBuffer);
+                    } else {
+                        for (const VkDrawIndexedIndirectCommand& culledDrawCommand : graphicsRecordingPackage.cpuCulledDrawCommands[drawnCullingStream]) {
+                            vkCmdDrawIndexed(geometryCommandBuffer, culledDrawCommand.indexCount, culledDrawCommand.instanceCount, culledDrawCommand.firstIndex, culledDrawCommand.vertexOffset, culledDrawCommand.firstInstance);
+                        }
+                    }
+                }
+            };
+
+            graphicsRecordingPackage.temporalOperation.recordMotionVectorsCommands(graphicsRecordingPackage.currentFrame, graphicsRecordingPackage.renderExtent, graphicsRecordingPackage.depthPrepassShaderBufferComponents, recordSceneDraws, commandBuffer);
+        });
+
+        renderGraph.setPassRecording("temporalResolve", [&](VkCommandBuffer commandBuffer) {
+            graphicsRecordingPackage.temporalOperation.recordResolveCommands(graphicsRecordingPackage.swapchainImageIndex, graphicsRecordingPackage.renderExtent, graphicsRecordingPackage.projectionJitter, commandBuffer);
+        });
+    } else {
+        renderGraph.setPassRecording("antiAliasing", [&](VkCommandBuffer commandBuffer) {
+            graphicsRecordingPackage.antiAliasingOperation.recordPresentationCommands(graphicsRecordingPackage.swapchainIndexFramebuffer, commandBuffer);
+        });
+    }
 
-    if ((graphicsRecordingPackage.sceneNormalsShaderBufferComponents.indiceCount != -1) && (graphicsRecordingPackage.sceneNormalsShaderBufferComponents.verticeCount == -1)) {
-        vkCmdBindIndexBuffer(graphicsRecordingPackage.graphicsCommandBuffer, graphicsRecordingPackage.sceneNormalsShaderBufferComponents.indexBuffer, 0, VK_INDEX_TYPE_UINT32);
+    renderGraph.executeGraph(graphicsRecordingPackage.graphicsCommandBuffer, [&](const std::string& passName, VkCommandBuffer commandBuffer) {
+        graphicsRecordingPackage.resolutionController->recordPassEndCommands(graphicsRecordingPackage.currentFrame, passName, commandBuffer);
+    });
 
-        vkCmdDrawIndexed(graphicsRecordingPackage.graphicsCommandBuffer, graphicsRecordingPackage.sceneNormalsShaderBufferComponents.indiceCount, 1, 0, 0, 0);
-    } else if ((graphicsRecordingPackage.sceneNormalsShaderBufferComponents.indiceCount == -1) && (graphicsRecordingPackage.sceneNormalsShaderBufferComponents.verticeCount != -1)) {
-        vkCmdDraw(graphicsRecordingPackage.graphicsCommandBuffer, graphicsRecordingPackage.sceneNormalsShaderBufferComponents.verticeCount, 1, 0, 0);
-    }
-    
-    vkCmdEndRenderPass(graphicsRecordingPackage.graphicsCommandBuffer);
+    graphicsRecordingPackage.resolutionController->recordFrameEndCommands(graphicsRecordingPackage.currentFrame, graphicsRecordingPackage.graphicsCommandBuffer);
     
 
     uint32_t recordBufferCommandsResult = vkEndCommandBuffer(graphicsRecordingPackage.graphicsCommandBuffer);
@@ -7,31 +7,106 @@
 
 #include <core/Renderer/Renderer.h>
 #include <core/Renderer/Offscreen.h>
+#include <core/Renderer/RenderGraph.h>
+#include <core/Renderer/ShadowAtlas.h>
+#include <core/Renderer/Culling.h>
+#include <core/Renderer/DepthPyramid.h>
+#include <core/Renderer/LightClustering.h>
+#include <core/Renderer/PostProcessing.h>
+#include <core/Renderer/AntiAliasing.h>
+#include <core/Renderer/TemporalAntiAliasing.h>
+#include <core/Renderer/DynamicResolution.h>
+#include <core/Shader/Uniform.h>
+#include <core/Worker/WorkerThread.h>
 
 #include <vector>
 
 
 namespace CommandManager
 {
+    // the secondary recording slots, each recorded into its own secondary command buffer by one of the recording workers.
+    const uint32_t directionalShadowRecordingIndex = 0;  // every directional shadow cascade, in one multiview draw.
+    const uint32_t pointShadowRecordingIndex = 1;  // every point shadow cubemap face, in one multiview draw.
+    const uint32_t cubemapRecordingIndex = 2;  // the cubemap, drawn after every other draw of the main render pass.
+    const uint32_t sceneRecordingIndex = 3;  // the scene, the instances visible last frame with occlusion culling.
+    const uint32_t sceneNormalsRecordingIndex = 4;  // the scene normals.
+    const uint32_t pointShadowFaceRecordingIndex = 5;  // the first of six single point shadow face recordings, used when only some faces are rendered.
+    const uint32_t shadowAtlasRecordingIndex = 11;  // the shadow atlas, every tile is recorded in it.
+    const uint32_t sceneLateRecordingIndex = 12;  // the late scene, drawing the instances disoccluded by occlusion culling.
+    const uint32_t depthPrepassRecordingIndex = 13;  // the depth prepass, drawing the scene's depth before the scene recording.
+    const uint32_t depthPrepassLateRecordingIndex = 14;  // the late depth prepass, drawing the late scene's depth before the late scene recording.
+    const uint32_t deferredLightingRecordingIndex = 15;  // the deferred lighting, a fullscreen triangle shading the G-buffer in the lighting subpass.
+    const uint32_t graphicsSecondaryRecordingCount = (CommandManager::deferredLightingRecordingIndex + 1);
+
+    struct RecordingWorker {  // a command recording worker(thread) with its own command pool.
+        VkCommandPool commandPool;
+        std::vector<VkCommandBuffer> secondaryCommandBuffers;  // the worker's secondary command buffers for every frame in flight.
+        WorkerThread::PersistentWorker *persistentWorker = nullptr;  // the worker's long-lived thread, null for the first worker(which records on the calling thread).
+
+
+        // cleanup the recording worker, stopping its thread.
+        //
+        // @param vulkanLogicalDevice Vulkan logical device to use in recording worker cleanup.
+        void cleanupRecordingWorker(VkDevice vulkanLogicalDevice);
+    };
+    
     struct GraphicsRecordingPackage {  // contains all necessary data for the "recordGraphicsCommandBufferCommands" function.
         VkCommandBuffer graphicsCommandBuffer;
         VkRenderPass renderPass;
+        VkRenderPass lateRenderPass;  // continues the main render pass after occlusion culling, compatible with the render pass.
         
         VkExtent2D swapchainImageExtent;
-        VkFramebuffer swapchainIndexFramebuffer;
+        VkExtent2D renderExtent;  // the rendered region of the scene images, the swapchain image extent without dynamic resolution.
+        VkFramebuffer swapchainIndexFramebuffer;  // written by the anti-aliasing presentation pass.
+        uint32_t swapchainImageIndex;  // selects the temporal resolve framebuffer.
+        VkFramebuffer sceneFramebuffer;  // the main render pass's framebuffer.
         
         uint32_t currentFrame;
+
+        std::vector<RecordingWorker> *recordingWorkers;  // the workers to record secondary command buffers on.
+        RenderGraph::Graph *renderGraph;  // the compiled render graph to record the passes through.
+        bool directionalShadowCached;  // if the directional shadow map is up to date, its pass is skipped.
+        uint32_t pointShadowFaceMask;  // the point shadow faces to render, all faces in one multiview pass or single faces(time-sliced), the pass is skipped if 0.
+        bool shadowAtlasCached;  // if the shadow atlas is up to date, its pass is skipped.
+        uint32_t shadowAtlasTileCount;
+        ShadowAtlas::AtlasTile shadowAtlasTiles[Uniform::maxShadowAtlasTileCount];  // the atlas region of each tile, selected by the viewport and scissor.
+        uint32_t shadowAtlasTileCasterMasks[Uniform::maxShadowAtlasTileCount];  // the shadow casters drawn in each tile.
         
         Pipeline::PipelineComponents cubemapPipelineComponents;
         ModelHandler::ShaderBufferComponents cubemapShaderBufferComponents;
         Pipeline::PipelineComponents scenePipelineComponents;
         ModelHandler::ShaderBufferComponents sceneShaderBufferComponents;
+        VkPipeline sceneMaskedPipeline;  // draws the scene's alpha-masked indices after its opaque indices, bound with the scene pipeline components' descriptor sets.
+        uint32_t maskedIndiceCount;  // the main mesh's alpha-masked indices, the last of its indices(the masked draws are skipped if 0).
         Pipeline::PipelineComponents sceneNormalsPipelineComponents;
         ModelHandler::ShaderBufferComponents sceneNormalsShaderBufferComponents;
+        VkPipeline depthPrepassPipeline;  // bound with the scene pipeline components' descriptor sets.
+        ModelHandler::ShaderBufferComponents depthPrepassShaderBufferComponents;
+        bool depthPrepassEnabled;  // if the depth prepass recordings are drawn before the scene recordings.
+        VkPipeline deferredLightingPipeline;  // bound with the scene pipeline components' descriptor sets.
+        bool deferredRenderingEnabled;  // if the scene recordings write the G-buffer, the lighting, scene normals, and cubemap recordings are drawn in the lighting subpass.
         Offscreen::OffscreenOperation directionalShadowOperation;
         ModelHandler::ShaderBufferComponents directionalShadowShaderBufferComponents;
         Offscreen::OffscreenOperation pointShadowOperation;
         ModelHandler::ShaderBufferComponents pointShadowShaderBufferComponents;
+        Offscreen::OffscreenOperation shadowAtlasOperation;
+        ModelHandler::ShaderBufferComponents shadowAtlasShaderBufferComponents;
+        Culling::CullingOperation cullingOperation;  // the scene and shadow recordings draw its culled draw streams.
+        DepthPyramid::DepthPyramidOperation depthPyramidOperation;  // reduced from the early main pass's depth, used in occlusion culling.
+        LightClustering::ClusteringOperation lightClusteringOperation;  // bins the lights the scene recordings shade.
+        uint32_t cullingInstanceCount;
+        bool gpuCullingEnabled;  // if the culled draw streams are drawn indirectly, the CPU culled draws are recorded directly otherwise.
+        bool occlusionCullingEnabled;  // if the late scene recording is drawn, the late scene stream is empty otherwise.
+        std::vector<VkDrawIndexedIndirectCommand> cpuCulledDrawCommands[Uniform::cullingStreamCount * 2];  // see Uniform::UniformBuffersUpdatePackage::cpuCulledDrawCommands.
+        PostProcessing::PostProcessingOperation postProcessingOperation;  // builds the bloom and adapts the exposure before the presentation.
+        float frameTime;  // the time since the previous frame in seconds, the exposure adapts over it.
+        AntiAliasing::AntiAliasingOperation antiAliasingOperation;  // filters the scene color into the swapchain image.
+        bool smaaEnabled;  // if SMAA's edge detection and blending weight recordings are drawn before the presentation.
+        bool sceneColorResolved;  // if the main render pass has a resolve attachment(with msaa).
+        TemporalAntiAliasing::TemporalOperation temporalOperation;  // resolves the jittered scene color with the history into the swapchain image.
+        bool temporalAntiAliasingEnabled;  // if the motion vectors and temporal resolve recordings replace the anti-aliasing presentation.
+        glm::vec2 projectionJitter;  // the frame's projection jitter in pixels.
+        DynamicResolution::ResolutionController *resolutionController;  // writes the frame's and each pass's GPU timestamps.
     };
     
     
@@ -46,9 +121,18 @@ namespace CommandManager
     //
     // @param parentCommandPool parent command pool to allocate the child command buffers under(also determines command buffer use).
     // @param commandBufferCount the amount of command buffers to create.
+    // @param commandBufferLevel the level(primary or secondary) of the command buffers to create.
     // @param vulkanLogicalDevice the Vulkan instance's logical device.
     // @param allocatedChildCommandBuffers stored allocated child command buffers.
-    void allocateChildCommandBuffers(VkCommandPool parentCommandPool, size_t commandBufferCount, VkDevice vulkanLogicalDevice, std::vector<VkCommandBuffer>& allocatedChildCommandBuffers);
+    void allocateChildCommandBuffers(VkCommandPool parentCommandPool, size_t commandBufferCount, VkCommandBufferLevel commandBufferLevel, VkDevice vulkanLogicalDevice, std::vector<VkCommandBuffer>& allocatedChildCommandBuffers);
+
+    // create command recording workers, each with its own command pool and secondary command buffers.
+    //
+    // @param graphicsFamilyIndex index of the graphics queue family.
+    // @param requestedWorkerCount the requested amount of workers, 0 to use the amount of hardware threads.
+    // @param vulkanLogicalDevice the Vulkan instance's logical device.
+    // @param createdRecordingWorkers stored created recording workers.
+    void createRecordingWorkers(size_t graphicsFamilyIndex, uint32_t requestedWorkerCount, VkDevice vulkanLogicalDevice, std::vector<RecordingWorker>& createdRecordingWorkers);
 
     // record single-submit commands(allocates a disposable command buffer).
     //
@@ -92,7 +176,14 @@ namespace CommandManager
     // @param rect2DInfo populated Rect2D info.
     void populateRect2DInfo(VkExtent2D extent, VkRect2D& rect2DInfo);
 
-    // record necessary drawing commands in a graphics command buffer.
+    // record a single pass's drawing commands in a secondary command buffer.
+    //
+    // @param graphicsRecordingPackage a package of all necessary data for recording.
+    // @param recordingIndex the index of the secondary recording, one of the recording index constants.
+    // @param secondaryCommandBuffer the secondary command buffer to record in.
+    void recordSecondaryGraphicsCommands(const CommandManager::GraphicsRecordingPackage& graphicsRecordingPackage, uint32_t recordingIndex, VkCommandBuffer secondaryCommandBuffer);
+
+    // record necessary drawing commands in a graphics command buffer, recording secondary command buffers on the recording workers.
     //
     // @param graphicsRecordingPackage a package of all necessary data for this function.
     void recordGraphicsCommandBufferCommands(CommandManager::GraphicsRecordingPackage graphicsRecordingPackage);
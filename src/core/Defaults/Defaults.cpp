@@ -1,9 +1,11 @@
 #include <core/Defaults/Defaults.h>
 #include <core/Config/Config.h>
+#include <utils/MathUtils.h>
 
 #include <string>
 #include <iostream>
 #include <cstdlib>
+#include <algorithm>
 
 
 // extern variables from header file.
@@ -38,6 +40,41 @@ void Defaults::initializeDefaults()
 
     rendererDefaults.MAX_FRAMES_IN_FLIGHT = std::stoul(m_rendererDatabase.lookupKey("MAX_FRAMES_IN_FLIGHT"));
     rendererDefaults.MAIN_CAMERA_ZOOM_AMOUNT = std::stof(m_rendererDatabase.lookupKey("MAIN_CAMERA_ZOOM_AMOUNT"));
+    rendererDefaults.COMMAND_RECORDING_THREAD_COUNT = std::stoul(m_rendererDatabase.lookupKey("COMMAND_RECORDING_THREAD_COUNT"));
+    rendererDefaults.DIRECTIONAL_SHADOW_RESOLUTION = std::stoul(m_rendererDatabase.lookupKey("DIRECTIONAL_SHADOW_RESOLUTION"));
+    rendererDefaults.POINT_SHADOW_RESOLUTION = std::stoul(m_rendererDatabase.lookupKey("POINT_SHADOW_RESOLUTION"));
+    rendererDefaults.POINT_SHADOW_FACE_BUDGET = std::clamp(static_cast<uint32_t>(std::stoul(m_rendererDatabase.lookupKey("POINT_SHADOW_FACE_BUDGET"))), 1u, 6u);
+    rendererDefaults.SHADOW_DEPTH_FORMAT = m_rendererDatabase.lookupKey("SHADOW_DEPTH_FORMAT");
+    rendererDefaults.SHADOW_FILTER = m_rendererDatabase.lookupKey("SHADOW_FILTER");
+    rendererDefaults.SHADOW_FILTER_MODE = m_rendererDatabase.lookupKey("SHADOW_FILTER_MODE");
+    rendererDefaults.SHADOW_CASCADE_COUNT = std::clamp(static_cast<uint32_t>(std::stoul(m_rendererDatabase.lookupKey("SHADOW_CASCADE_COUNT"))), 1u, 4u);  // see Uniform::maxShadowCascadeCount.
+    rendererDefaults.SHADOW_CASCADE_SPLIT_LAMBDA = std::stof(m_rendererDatabase.lookupKey("SHADOW_CASCADE_SPLIT_LAMBDA"));
+    rendererDefaults.SHADOW_DISTANCE = std::stof(m_rendererDatabase.lookupKey("SHADOW_DISTANCE"));
+    rendererDefaults.SHADOW_ATLAS_RESOLUTION = MathUtils::floorPowerOfTwo(std::stoul(m_rendererDatabase.lookupKey("SHADOW_ATLAS_RESOLUTION")));  // the atlas is subdivided by a quadtree.
+    rendererDefaults.SHADOW_ATLAS_MAXIMUM_TILE_SIZE = std::min(static_cast<uint32_t>(std::stoul(m_rendererDatabase.lookupKey("SHADOW_ATLAS_MAXIMUM_TILE_SIZE"))), rendererDefaults.SHADOW_ATLAS_RESOLUTION);
+    rendererDefaults.SHADOW_ATLAS_MINIMUM_TILE_SIZE = std::min(static_cast<uint32_t>(std::stoul(m_rendererDatabase.lookupKey("SHADOW_ATLAS_MINIMUM_TILE_SIZE"))), rendererDefaults.SHADOW_ATLAS_MAXIMUM_TILE_SIZE);
+    rendererDefaults.SHADOW_ATLAS_TEST_LIGHTS = m_rendererDatabase.lookupKey("SHADOW_ATLAS_TEST_LIGHTS");
+    rendererDefaults.MAX_CULLING_INSTANCE_COUNT = std::max(static_cast<uint32_t>(std::stoul(m_rendererDatabase.lookupKey("MAX_CULLING_INSTANCE_COUNT"))), 1u);
+    rendererDefaults.CULLING_MODE = m_rendererDatabase.lookupKey("CULLING_MODE");
+    rendererDefaults.CULLING_BENCHMARK_INSTANCE_COUNT = std::stoul(m_rendererDatabase.lookupKey("CULLING_BENCHMARK_INSTANCE_COUNT"));
+    rendererDefaults.OCCLUSION_CULLING = m_rendererDatabase.lookupKey("OCCLUSION_CULLING");
+    rendererDefaults.MASKED_OCCLUSION_THREAD_COUNT = std::stoul(m_rendererDatabase.lookupKey("MASKED_OCCLUSION_THREAD_COUNT"));
+    rendererDefaults.MASKED_OCCLUSION_TRIANGLE_BUDGET = std::stoul(m_rendererDatabase.lookupKey("MASKED_OCCLUSION_TRIANGLE_BUDGET"));
+    rendererDefaults.RENDERING_PATH = m_rendererDatabase.lookupKey("RENDERING_PATH");
+    rendererDefaults.DEPTH_PREPASS = m_rendererDatabase.lookupKey("DEPTH_PREPASS");
+    rendererDefaults.MAX_SCENE_LIGHT_COUNT = std::max(static_cast<uint32_t>(std::stoul(m_rendererDatabase.lookupKey("MAX_SCENE_LIGHT_COUNT"))), 1u);
+    rendererDefaults.CLUSTER_TEST_LIGHT_COUNT = std::stoul(m_rendererDatabase.lookupKey("CLUSTER_TEST_LIGHT_COUNT"));
+    rendererDefaults.MAIN_MODEL = m_rendererDatabase.lookupKey("MAIN_MODEL");
+    rendererDefaults.MAIN_MODEL_SUBDIVISION_COUNT = std::stoul(m_rendererDatabase.lookupKey("MAIN_MODEL_SUBDIVISION_COUNT"));
+    rendererDefaults.MAIN_MESH_CHUNK_TRIANGLE_COUNT = std::stoul(m_rendererDatabase.lookupKey("MAIN_MESH_CHUNK_TRIANGLE_COUNT"));
+    rendererDefaults.FRAME_TIME_REPORT_INTERVAL = std::stoul(m_rendererDatabase.lookupKey("FRAME_TIME_REPORT_INTERVAL"));
+    rendererDefaults.ANTI_ALIASING = m_rendererDatabase.lookupKey("ANTI_ALIASING");
+    rendererDefaults.MSAA_SAMPLE_SHADING = m_rendererDatabase.lookupKey("MSAA_SAMPLE_SHADING");
+    rendererDefaults.TARGET_FRAME_TIME = std::max(std::stof(m_rendererDatabase.lookupKey("TARGET_FRAME_TIME")), 0.0f);
+    rendererDefaults.MIN_RENDER_SCALE = std::clamp(std::stof(m_rendererDatabase.lookupKey("MIN_RENDER_SCALE")), 0.25f, 1.0f);
+    rendererDefaults.QUALITY_GOVERNOR = m_rendererDatabase.lookupKey("QUALITY_GOVERNOR");
+    rendererDefaults.BLOOM_INTENSITY = std::max(std::stof(m_rendererDatabase.lookupKey("BLOOM_INTENSITY")), 0.0f);
+    rendererDefaults.EXPOSURE_ADAPTATION_SPEED = std::max(std::stof(m_rendererDatabase.lookupKey("EXPOSURE_ADAPTATION_SPEED")), 0.0f);
     
     
     // initialize logging defaults.
@@ -48,4 +85,6 @@ void Defaults::initializeDefaults()
 
     // initialize callbacks variables.
     callbacksVariables.FRAMEBUFFER_RESIZED = false;
+    callbacksVariables.ANTI_ALIASING_CYCLED = false;
+    callbacksVariables.SAMPLE_SHADING_TOGGLED = false;
 }
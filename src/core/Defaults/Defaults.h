@@ -26,6 +26,41 @@ namespace Defaults  // NOTE: a "default" in this sense is treated and used as a
     struct RendererConfig {
         uint32_t MAX_FRAMES_IN_FLIGHT;  // the max amount of frames that can be "in flight" or concurrently worked on by the CPU.
         float MAIN_CAMERA_ZOOM_AMOUNT;  // the amount that the main camera zooms in during one scroll callback.
+        uint32_t COMMAND_RECORDING_THREAD_COUNT;  // the amount of threads recording secondary command buffers, 0 to use the amount of hardware threads.
+        uint32_t DIRECTIONAL_SHADOW_RESOLUTION;  // the width and height of the directional shadow map.
+        uint32_t POINT_SHADOW_RESOLUTION;  // the width and height of each point shadow cubemap face.
+        uint32_t POINT_SHADOW_FACE_BUDGET;  // the maximum amount of point shadow cubemap faces re-rendered per frame, clamped to 1..6(time-sliced below 6).
+        std::string SHADOW_DEPTH_FORMAT;  // the preferred shadow map depth format, "D16" or "D32".
+        std::string SHADOW_FILTER;  // the shadow map sampler filter, "NEAREST" or "LINEAR".
+        std::string SHADOW_FILTER_MODE;  // the shadow filtering quality preset, "PCF", "POISSON", or "PCSS".
+        uint32_t SHADOW_CASCADE_COUNT;  // the amount of directional shadow cascades, clamped to 1..Uniform::maxShadowCascadeCount.
+        float SHADOW_CASCADE_SPLIT_LAMBDA;  // the blend between linear(0.0) and logarithmic(1.0) cascade splits.
+        float SHADOW_DISTANCE;  // the view distance covered by the directional shadow cascades.
+        uint32_t SHADOW_ATLAS_RESOLUTION;  // the width and height of the shadow atlas, rounded down to a power of two.
+        uint32_t SHADOW_ATLAS_MAXIMUM_TILE_SIZE;  // the largest shadow atlas tile a light gets, clamped to the atlas resolution.
+        uint32_t SHADOW_ATLAS_MINIMUM_TILE_SIZE;  // the smallest shadow atlas tile a light gets, clamped to the maximum tile size.
+        std::string SHADOW_ATLAS_TEST_LIGHTS;  // if a spotlight and a dual-paraboloid point light shadowed through the shadow atlas are added, "ON" or "OFF".
+        uint32_t MAX_CULLING_INSTANCE_COUNT;  // the maximum amount of instances culled by the culling compute pass, at least 1.
+        std::string CULLING_MODE;  // where instances are culled, "GPU" or "CPU".
+        uint32_t CULLING_BENCHMARK_INSTANCE_COUNT;  // the amount of synthetic instances in the startup CPU culling and occlusion benchmarks, 0 to skip them.
+        std::string OCCLUSION_CULLING;  // how scene instances are occlusion culled, "HIZ"(GPU culling), "MASKED"(CPU culling), or "NONE".
+        uint32_t MASKED_OCCLUSION_THREAD_COUNT;  // the amount of threads rasterizing the CPU occlusion buffer, 0 to use the amount of hardware threads.
+        uint32_t MASKED_OCCLUSION_TRIANGLE_BUDGET;  // the maximum amount of triangles in the main mesh's occluder.
+        std::string RENDERING_PATH;  // how the scene is shaded, "FORWARD", "DEFERRED", or "VISIBILITY".
+        std::string DEPTH_PREPASS;  // if the scene's depth is drawn before it is shaded, "ON" or "OFF".
+        uint32_t MAX_SCENE_LIGHT_COUNT;  // the capacity of the scene light buffer, at least 1.
+        uint32_t CLUSTER_TEST_LIGHT_COUNT;  // the amount of additional shadowless point lights scattered around the main mesh.
+        std::string MAIN_MODEL;  // the main model's glTF file, relative to the models directory.
+        uint32_t MAIN_MODEL_SUBDIVISION_COUNT;  // the amount of times each main mesh triangle is split into four.
+        uint32_t MAIN_MESH_CHUNK_TRIANGLE_COUNT;  // the amount of triangles in each separately culled main mesh chunk, 0 to cull the opaque and the masked triangles as a chunk each.
+        uint32_t FRAME_TIME_REPORT_INTERVAL;  // the amount of frames averaged in each reported frame time, 0 to skip the reports.
+        std::string ANTI_ALIASING;  // the initial anti-aliasing mode, "OFF", "FXAA", "SMAA", "TAA", "MSAA2", "MSAA4", or "MSAA8".
+        std::string MSAA_SAMPLE_SHADING;  // if the multisampled pipelines initially shade per sample, "ON" or "OFF".
+        float TARGET_FRAME_TIME;  // the frame time in milliseconds held by dynamic resolution(with TAA) and the quality governor, 0 to always render at the swapchain resolution and full quality.
+        float MIN_RENDER_SCALE;  // the smallest scale of the rendered region on each axis, from 0.25 to 1.
+        std::string QUALITY_GOVERNOR;  // if the quality knobs are stepped to hold the target frame time, "ON" or "OFF".
+        float BLOOM_INTENSITY;  // the weight of the bloom added to the HDR scene color, 0 to disable the bloom.
+        float EXPOSURE_ADAPTATION_SPEED;  // the auto-exposure's adaptation rate per second, 0 to keep the initial exposure.
     };
     extern RendererConfig rendererDefaults;  // default/read renderer configuration.
 
@@ -33,6 +68,8 @@ namespace Defaults  // NOTE: a "default" in this sense is treated and used as a
     struct CallbacksVariables {
         bool FRAMEBUFFER_RESIZED;  // dynamically set from callback: if the framebuffer has been resized(some platforms or drivers may not trigger swapchain recreation properly).
         Camera::ArcballCamera *MAIN_CAMERA;
+        bool ANTI_ALIASING_CYCLED;  // dynamically set from callback: if the next anti-aliasing mode was requested, reset by the renderer.
+        bool SAMPLE_SHADING_TOGGLED;  // dynamically set from callback: if msaa sample shading was toggled, reset by the renderer.
     };
     extern CallbacksVariables callbacksVariables;  // dynamically set variables to input and output from callbacks.
 
@@ -18,9 +18,17 @@ void DisplayManager::DisplayDetails::cleanupDisplayDetails(VkDevice vulkanLogica
     
     this->depthImageDetails.cleanupImageDetails(vulkanLogicalDevice);
     this->colorImageDetails.cleanupImageDetails(vulkanLogicalDevice);
+    this->sceneColorImageDetails.cleanupImageDetails(vulkanLogicalDevice);
+    for (Image::ImageDetails& gBufferImageDetails : this->gBufferImageDetails) {
+        gBufferImageDetails.cleanupImageDetails(vulkanLogicalDevice);
+    }
 
     if (preserveCommandPool == false) {
         vkDestroyCommandPool(vulkanLogicalDevice, this->graphicsCommandPool, nullptr);  // child command buffers automatically freed.    
+
+        for (CommandManager::RecordingWorker& recordingWorker : this->graphicsRecordingWorkers) {
+            recordingWorker.cleanupRecordingWorker(vulkanLogicalDevice);
+        }
     }
 
 }
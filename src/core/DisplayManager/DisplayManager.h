@@ -6,6 +6,7 @@
 #include <GLFW/glfw3.h>
 
 #include <core/Renderer/Renderer.h>
+#include <core/Command/CommandManager.h>
 
 #include <string>
 #include <vector>
@@ -22,6 +23,7 @@ namespace DisplayManager
 
         VkCommandPool graphicsCommandPool;
         std::vector<VkCommandBuffer> graphicsCommandBuffers;
+        std::vector<CommandManager::RecordingWorker> graphicsRecordingWorkers;  // workers recording secondary graphics command buffers in parallel.
         
         VkSurfaceKHR windowSurface;
 
@@ -30,18 +32,25 @@ namespace DisplayManager
         VkFormat swapchainImageFormat;
         VkExtent2D swapchainImageExtent;
         std::vector<VkImageView> swapchainImageViews;
-        std::vector<VkFramebuffer> swapchainFramebuffers;
+        std::vector<VkFramebuffer> swapchainFramebuffers;  // the anti-aliasing presentation framebuffers, one for each swapchain image.
+        VkFramebuffer sceneFramebuffer;  // the main render pass's framebuffer, independent of the swapchain images.
 
         VkSampleCountFlagBits msaaSampleCount = VK_SAMPLE_COUNT_1_BIT;  // overwritten by functions.
 
-        Image::ImageDetails colorImageDetails;  // the color image details of the swapchain framebuffers.
-        Image::ImageDetails depthImageDetails;  // the depth image details of the swapchain framebuffers.
+        Image::ImageDetails colorImageDetails;  // the color image details of the scene framebuffer, also the single-sampled scene color without msaa.
+        bool colorImageTransient = false;  // if the msaa color image never leaves the main render pass, it is then transient and lazily allocated.
+        Image::ImageDetails depthImageDetails;  // the depth image details of the scene framebuffer.
+        Image::ImageDetails sceneColorImageDetails;  // the single-sampled scene color the color image is resolved into, only with msaa.
+
+        std::vector<VkFormat> gBufferImageFormats;  // the format of each deferred G-buffer attachment, empty with forward rendering.
+        bool gBufferTransient = false;  // if the G-buffer never leaves the main render pass, it is then transient and lazily allocated.
+        std::vector<Image::ImageDetails> gBufferImageDetails;  // the G-buffer image details of the scene framebuffer, following the resolve attachment(if any).
 
 
         // clean up the display details.
         //
         // @param vulkanLogicalDevice Vulkan logical device to use in display details cleanup.
-        // @param preserveCommandPool if the command pool should be preserved or not(destroyed).
+        // @param preserveCommandPool if the command pools should be preserved or not(destroyed).
         void cleanupDisplayDetails(VkDevice vulkanLogicalDevice, bool preserveCommandPool);
     };
     
@@ -176,14 +176,31 @@ void SwapchainHandler::populateFramebufferCreateInfo(VkRenderPass renderPass, Vk
         framebufferCreateInfo.layers = 1;
 }
 
-void SwapchainHandler::createSwapchainFramebuffers(std::vector<VkImageView> swapchainImageViews, VkExtent2D swapchainImageExtent, VkImageView colorImageView, VkImageView depthImageView, VkRenderPass renderPass, VkDevice vulkanLogicalDevice, std::vector<VkFramebuffer>& swapchainFramebuffers)
+void SwapchainHandler::createSceneFramebuffer(const DisplayManager::DisplayDetails& displayDetails, VkRenderPass renderPass, VkDevice vulkanLogicalDevice, VkFramebuffer& sceneFramebuffer)
+{
+    std::vector<VkImageView> framebufferAttachments = {displayDetails.colorImageDetails.imageView, displayDetails.depthImageDetails.imageView};
+    if (displayDetails.msaaSampleCount != VK_SAMPLE_COUNT_1_BIT) {  // the resolve attachment.
+        framebufferAttachments.push_back(displayDetails.sceneColorImageDetails.imageView);
+    }
+    for (const Image::ImageDetails& gBufferImage : displayDetails.gBufferImageDetails) {
+        framebufferAttachments.push_back(gBufferImage.imageView);
+    }
+
+    VkFramebufferCreateInfo framebufferCreateInfo{};
+    SwapchainHandler::populateFramebufferCreateInfo(renderPass, framebufferAttachments.data(), static_cast<uint32_t>(framebufferAttachments.size()), displayDetails.swapchainImageExtent.width, displayDetails.swapchainImageExtent.height, framebufferCreateInfo);
+
+    VkResult framebufferCreationResult = vkCreateFramebuffer(vulkanLogicalDevice, &framebufferCreateInfo, nullptr, &sceneFramebuffer);
+    if (framebufferCreationResult != VK_SUCCESS) {
+        throwDebugException("Failed to create the scene framebuffer.");
+    }
+}
+
+void SwapchainHandler::createSwapchainFramebuffers(std::vector<VkImageView> swapchainImageViews, VkExtent2D swapchainImageExtent, VkRenderPass renderPass, VkDevice vulkanLogicalDevice, std::vector<VkFramebuffer>& swapchainFramebuffers)
 {
     swapchainFramebuffers.resize(swapchainImageViews.size());
     for (size_t i = 0; i < swapchainImageViews.size(); i += 1) {
-        std::array<VkImageView, 3> framebufferAttachments = {colorImageView, depthImageView, swapchainImageViews[i]};
-
         VkFramebufferCreateInfo framebufferCreateInfo{};
-        SwapchainHandler::populateFramebufferCreateInfo(renderPass, framebufferAttachments.data(), static_cast<uint32_t>(framebufferAttachments.size()), swapchainImageExtent.width, swapchainImageExtent.height, framebufferCreateInfo);
+        SwapchainHandler::populateFramebufferCreateInfo(renderPass, &swapchainImageViews[i], 1, swapchainImageExtent.width, swapchainImageExtent.height, framebufferCreateInfo);
 
         VkResult framebufferCreationResult = vkCreateFramebuffer(vulkanLogicalDevice, &framebufferCreateInfo, nullptr, &swapchainFramebuffers[i]);
         if (framebufferCreationResult != VK_SUCCESS) {
@@ -192,7 +209,7 @@ void SwapchainHandler::createSwapchainFramebuffers(std::vector<VkImageView> swap
     }
 }
 
-void SwapchainHandler::recreateSwapchain(DeviceHandler::VulkanDevices vulkanDevices, VkRenderPass renderPass, Offscreen::OffscreenOperation& directionalShadowOperation, Offscreen::OffscreenOperation& pointShadowOperation, DisplayManager::DisplayDetails& displayDetails)
+void SwapchainHandler::recreateSwapchain(DeviceHandler::VulkanDevices vulkanDevices, VkRenderPass sceneRenderPass, VkRenderPass presentationRenderPass, DisplayManager::DisplayDetails& displayDetails)
 {
     // stall window if minimized.
     // prefer to use size_t, but complying with GLFW is better.
@@ -215,12 +232,9 @@ void SwapchainHandler::recreateSwapchain(DeviceHandler::VulkanDevices vulkanDevi
 
     Image::generateSwapchainImageDetails(displayDetails, vulkanDevices);
 
-    createSwapchainFramebuffers(displayDetails.swapchainImageViews, displayDetails.swapchainImageExtent, displayDetails.colorImageDetails.imageView, displayDetails.depthImageDetails.imageView, renderPass, vulkanDevices.logicalDevice, displayDetails.swapchainFramebuffers);
-    
-
-    directionalShadowOperation.generateMemberComponents((displayDetails.swapchainImageExtent.width / 1), (displayDetails.swapchainImageExtent.height / 1), 1, nullptr, nullptr, displayDetails.graphicsCommandPool, displayDetails.graphicsQueue, vulkanDevices);
-
-    pointShadowOperation.generateMemberComponents((displayDetails.swapchainImageExtent.width / 1), (displayDetails.swapchainImageExtent.height / 1), 6, nullptr, nullptr, displayDetails.graphicsCommandPool, displayDetails.graphicsQueue, vulkanDevices);
+    createSceneFramebuffer(displayDetails, sceneRenderPass, vulkanDevices.logicalDevice, displayDetails.sceneFramebuffer);
+    createSwapchainFramebuffers(displayDetails.swapchainImageViews, displayDetails.swapchainImageExtent, presentationRenderPass, vulkanDevices.logicalDevice, displayDetails.swapchainFramebuffers);
+    // shadow maps don't depend on the swapchain extent, and are left untouched.
 }
 
 void SwapchainHandler::cleanupSwapchain(DisplayManager::DisplayDetails displayDetails, VkDevice vulkanLogicalDevice)
@@ -232,6 +246,7 @@ void SwapchainHandler::cleanupSwapchain(DisplayManager::DisplayDetails displayDe
     for (VkFramebuffer swapchainFramebuffer : displayDetails.swapchainFramebuffers) {
         vkDestroyFramebuffer(vulkanLogicalDevice, swapchainFramebuffer, nullptr);
     }
+    vkDestroyFramebuffer(vulkanLogicalDevice, displayDetails.sceneFramebuffer, nullptr);
     
     vkDestroySwapchainKHR(vulkanLogicalDevice, displayDetails.swapchain, nullptr);
 }
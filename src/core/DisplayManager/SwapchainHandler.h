@@ -85,27 +85,32 @@ namespace SwapchainHandler
     // @param framebufferCreateInfo populated framebuffer create info.
     void populateFramebufferCreateInfo(VkRenderPass renderPass, VkImageView framebufferAttachments[], uint32_t framebufferAttachmentsCount, uint32_t framebufferWidth, uint32_t framebufferHeight, VkFramebufferCreateInfo& framebufferCreateInfo);
     
-    // create the framebuffers necessary for all swapchain image views.
+    // create the main render pass's framebuffer from the display details' scene images.
+    //
+    // @param displayDetails the display details containing the color, depth, scene color, and G-buffer images.
+    // @param renderPass render pass to use in framebuffer creation.
+    // @param vulkanLogicalDevice this Vulkan instance's logical device.
+    // @param createdSceneFramebuffer stored created scene framebuffer.
+    void createSceneFramebuffer(const DisplayManager::DisplayDetails& displayDetails, VkRenderPass renderPass, VkDevice vulkanLogicalDevice, VkFramebuffer& createdSceneFramebuffer);
+    
+    // create the framebuffers necessary for all swapchain image views, written by the anti-aliasing presentation pass.
     //
     // @param swapchainImageViews swapchain image views to use in framebuffer creation.
     // @param swapchainExtent swapchain image extent to use in framebuffer creation.
-    // @param colorImageView the color image view to use in framebuffer creation.
-    // @param depthImageView the depth image view to use in framebuffer creation.
     // @param renderPass render pass to use in framebuffer creation.
     // @param vulkanLogicalDevice this Vulkan instance's logical device.
     // @param createdSwapchainFramebuffers stored created swapchain framebuffers.
-    void createSwapchainFramebuffers(std::vector<VkImageView> swapchainImageViews, VkExtent2D swapchainImageExtent, VkImageView colorImageView, VkImageView depthImageView, VkRenderPass renderPass, VkDevice vulkanLogicalDevice, std::vector<VkFramebuffer>& createdSwapchainFramebuffers);
+    void createSwapchainFramebuffers(std::vector<VkImageView> swapchainImageViews, VkExtent2D swapchainImageExtent, VkRenderPass renderPass, VkDevice vulkanLogicalDevice, std::vector<VkFramebuffer>& createdSwapchainFramebuffers);
 
     // recreate the swapchain after some form of incompatibility.
     //
     // uses swapchain creation wrapper.
     //
     // @param vulkanDevices Vulkan logical and physical devices.
-    // @param renderPass render pass to use in swapchain recreation.
-    // @param directionalShadowOperation the directional shadow offscreen operation.
-    // @param pointShadowOperation the point shadow offscreen operation.
+    // @param sceneRenderPass render pass to use in scene framebuffer recreation.
+    // @param presentationRenderPass render pass to use in swapchain framebuffers recreation.
     // @param displayDetails display details to use and store recreated components in.
-    void recreateSwapchain(DeviceHandler::VulkanDevices vulkanDevices, VkRenderPass renderPass, Offscreen::OffscreenOperation& directionalShadowOperation, Offscreen::OffscreenOperation& pointShadowOperation, DisplayManager::DisplayDetails& displayDetails);
+    void recreateSwapchain(DeviceHandler::VulkanDevices vulkanDevices, VkRenderPass sceneRenderPass, VkRenderPass presentationRenderPass, DisplayManager::DisplayDetails& displayDetails);
 
     // clean up a swapchain.
     //
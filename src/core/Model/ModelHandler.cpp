@@ -21,6 +21,8 @@
 #include <string>
 #include <iostream>
 #include <string.h>
+#include <limits>
+#include <algorithm>
 
 
 void ModelHandler::Model::loadModelFromAbsolutePath(std::string absoluteModelPath)
@@ -38,6 +40,19 @@ void ModelHandler::Model::loadModelFromAbsolutePath(std::string absoluteModelPat
         std::cout << loaderErrors << std::endl;
         throwDebugException("Failed to load model/parse glTF.");
     }
+
+    // uses the X position minimum and maximum coordinates of every primitive to get a general scaling factor, so the primitives keep their placement relative to each other.
+    float generalMinimumPositionCoordinate = std::numeric_limits<float>::max();
+    float generalMaximumPositionCoordinate = std::numeric_limits<float>::lowest();
+    for (tinygltf::Mesh selectedMesh : loadedModel.meshes) {
+        for (tinygltf::Primitive meshPrimitive : selectedMesh.primitives) {
+            const tinygltf::Accessor& positionAttributeAccessor = loadedModel.accessors[meshPrimitive.attributes["POSITION"]];
+            generalMinimumPositionCoordinate = std::min(generalMinimumPositionCoordinate, static_cast<float>(positionAttributeAccessor.minValues[0]));
+            generalMaximumPositionCoordinate = std::max(generalMaximumPositionCoordinate, static_cast<float>(positionAttributeAccessor.maxValues[0]));
+        }
+    }
+
+    std::vector<uint32_t> maskedMeshIndices;  // appended after the opaque indices, the masked primitives are drawn in their own pipelines.
     for (tinygltf::Mesh selectedMesh : loadedModel.meshes) {
         for (tinygltf::Primitive meshPrimitive : selectedMesh.primitives) {
             const tinygltf::Accessor& positionAttributeAccessor = loadedModel.accessors[meshPrimitive.attributes["POSITION"]];
@@ -81,6 +96,21 @@ void ModelHandler::Model::loadModelFromAbsolutePath(std::string absoluteModelPat
             const float *UVCoordinateAttributes = reinterpret_cast<const float *>(&UVCoordinateAttributeBuffer.data[UVCoordinateAttributeBufferView.byteOffset + UVCoordinateAttributeAccessor.byteOffset]);
             const uint32_t UV_COORDINATES_STRIDE = 2;  // UV coordinates are vec2 components.
 
+            // each masked primitive keeps its own material's cutoff in its vertices.
+            // blended primitives are alpha tested at half coverage in the masked pipelines, there is no transparency pass.
+            bool primitiveMasked = false;
+            float primitiveAlphaCutoff = 0.0f;
+            if (meshPrimitive.material != -1) {  // -1 indicates the default(opaque) material.
+                const tinygltf::Material& primitiveMaterial = loadedModel.materials[meshPrimitive.material];
+                if (primitiveMaterial.alphaMode == "MASK") {
+                    primitiveMasked = true;
+                    primitiveAlphaCutoff = static_cast<float>(primitiveMaterial.alphaCutoff);
+                } else if (primitiveMaterial.alphaMode == "BLEND") {
+                    primitiveMasked = true;
+                    primitiveAlphaCutoff = ModelHandler::blendedAlphaCutoff;
+                }
+            }
+
             std::vector<ModelHandler::SceneVertexData> primitiveVertices(positionAttributeAccessor.count);  // the amount of vertices is equivalent to the amount of positions in a primitive.
             for (size_t vertexIndex = 0; vertexIndex < positionAttributeAccessor.count; vertexIndex += 1) {
                 const uint32_t VERTEX_INDEX_POSITION_OFFSET = (vertexIndex * POSITION_STRIDE);
@@ -91,9 +121,7 @@ void ModelHandler::Model::loadModelFromAbsolutePath(std::string absoluteModelPat
                     rawZPosition = -1;
                 }
 
-                // uses the X position minimum and maximum coordinates to get a general scaling factor, as individual factors would cause models to be squished into a cube.
-                const float generalMinimumPositionCoordinate = positionAttributeAccessor.minValues[0];
-                const float generalMaximumPositionCoordinate = positionAttributeAccessor.maxValues[0];
+                // uses the general scaling factor, as individual factors would cause models to be squished into a cube.
                 primitiveVertices[vertexIndex].position.x = MathUtils::normalizeValueToRanges(rawXPosition, generalMinimumPositionCoordinate, generalMaximumPositionCoordinate, 0, 1);
                 primitiveVertices[vertexIndex].position.y = MathUtils::normalizeValueToRanges(rawYPosition, generalMinimumPositionCoordinate, generalMaximumPositionCoordinate, 0, 1);
                 primitiveVertices[vertexIndex].position.z = MathUtils::normalizeValueToRanges(rawZPosition, generalMinimumPositionCoordinate, generalMaximumPositionCoordinate, 0, 1);
@@ -126,8 +154,11 @@ void ModelHandler::Model::loadModelFromAbsolutePath(std::string absoluteModelPat
                 const uint32_t VERTEX_INDEX_UV_COORDINATES_OFFSET = (vertexIndex * UV_COORDINATES_STRIDE);
                 primitiveVertices[vertexIndex].UVCoordinates.x = UVCoordinateAttributes[VERTEX_INDEX_UV_COORDINATES_OFFSET + 0];
                 primitiveVertices[vertexIndex].UVCoordinates.y = UVCoordinateAttributes[VERTEX_INDEX_UV_COORDINATES_OFFSET + 1];
+
+                primitiveVertices[vertexIndex].alphaCutoff = primitiveAlphaCutoff;
             }
 
+            const uint32_t primitiveVertexOffset = static_cast<uint32_t>(this->meshVertices.size());  // the primitive's indices start at its own first vertex.
             this->meshVertices.insert(this->meshVertices.end(), primitiveVertices.begin(), primitiveVertices.end());
         
 
@@ -139,10 +170,15 @@ void ModelHandler::Model::loadModelFromAbsolutePath(std::string absoluteModelPat
                 if (((indicesAccessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT || indicesAccessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT) && indicesAccessor.type == TINYGLTF_TYPE_SCALAR) == false) {
                     throwDebugException("Model indices data is in an incorrect component type or type.");
                 }
-                const uint16_t *indices = reinterpret_cast<const uint16_t *>(&indicesBuffer.data[indicesBufferView.byteOffset + indicesAccessor.byteOffset]);
-                std::vector<uint32_t> primitiveIndices(indices, (indices + indicesAccessor.count));
+                const unsigned char *rawIndices = &indicesBuffer.data[indicesBufferView.byteOffset + indicesAccessor.byteOffset];
+                std::vector<uint32_t> primitiveIndices(indicesAccessor.count);
+                for (size_t i = 0; i < indicesAccessor.count; i += 1) {
+                    uint32_t primitiveIndex = ((indicesAccessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT) ? reinterpret_cast<const uint32_t *>(rawIndices)[i] : reinterpret_cast<const uint16_t *>(rawIndices)[i]);
+                    primitiveIndices[i] = (primitiveVertexOffset + primitiveIndex);
+                }
 
-                this->meshIndices.insert(this->meshIndices.end(), primitiveIndices.begin(), primitiveIndices.end());
+                std::vector<uint32_t>& partitionIndices = ((primitiveMasked == true) ? maskedMeshIndices : this->meshIndices);
+                partitionIndices.insert(partitionIndices.end(), primitiveIndices.begin(), primitiveIndices.end());
             }
 
 
@@ -167,6 +203,92 @@ void ModelHandler::Model::loadModelFromAbsolutePath(std::string absoluteModelPat
             }
         }
     }
+
+    this->maskedIndiceCount = static_cast<uint32_t>(maskedMeshIndices.size());
+    this->meshIndices.insert(this->meshIndices.end(), maskedMeshIndices.begin(), maskedMeshIndices.end());
+
+    this->calculateMeshBounds();
+}
+
+void ModelHandler::Model::subdivideMesh(uint32_t subdivisionCount)
+{
+    if (this->meshIndices.empty() == true) {
+        return;
+    }
+
+    for (uint32_t subdivision = 0; subdivision < subdivisionCount; subdivision += 1) {
+        std::vector<uint32_t> subdividedIndices;
+        subdividedIndices.reserve(this->meshIndices.size() * 4);
+        for (size_t i = 0; (i + 2) < this->meshIndices.size(); i += 3) {
+            const std::array<uint32_t, 3> cornerIndices = {this->meshIndices[i], this->meshIndices[i + 1], this->meshIndices[i + 2]};
+
+            // each edge's midpoint, computed identically by both triangles sharing the edge so the split mesh stays watertight.
+            std::array<uint32_t, 3> midpointIndices;
+            for (size_t j = 0; j < 3; j += 1) {
+                const ModelHandler::SceneVertexData edgeStart = this->meshVertices[cornerIndices[j]];
+                const ModelHandler::SceneVertexData edgeEnd = this->meshVertices[cornerIndices[(j + 1) % 3]];
+
+                ModelHandler::SceneVertexData edgeMidpoint;
+                edgeMidpoint.position = ((edgeStart.position + edgeEnd.position) * 0.5f);
+                edgeMidpoint.normal = ((edgeStart.normal + edgeEnd.normal) * 0.5f);
+                edgeMidpoint.tangent = ((edgeStart.tangent + edgeEnd.tangent) * 0.5f);
+                edgeMidpoint.UVCoordinates = ((edgeStart.UVCoordinates + edgeEnd.UVCoordinates) * 0.5f);
+                edgeMidpoint.alphaCutoff = edgeStart.alphaCutoff;  // both edge ends belong to the same primitive.
+
+                midpointIndices[j] = static_cast<uint32_t>(this->meshVertices.size());
+                this->meshVertices.push_back(edgeMidpoint);
+            }
+
+            // the corner triangles and the center triangle, keeping the original winding.
+            subdividedIndices.insert(subdividedIndices.end(), {cornerIndices[0], midpointIndices[0], midpointIndices[2]});
+            subdividedIndices.insert(subdividedIndices.end(), {midpointIndices[0], cornerIndices[1], midpointIndices[1]});
+            subdividedIndices.insert(subdividedIndices.end(), {midpointIndices[2], midpointIndices[1], cornerIndices[2]});
+            subdividedIndices.insert(subdividedIndices.end(), {midpointIndices[0], midpointIndices[1], midpointIndices[2]});
+        }
+
+        this->meshIndices = subdividedIndices;
+        this->maskedIndiceCount *= 4;
+    }
+}
+
+void ModelHandler::Model::splitMeshChunks(uint32_t chunkTriangleCount, uint32_t maxChunkCount)
+{
+    this->meshChunks.clear();
+    if (this->meshIndices.empty() == true) {
+        return;
+    }
+
+    uint32_t opaqueIndiceCount = (static_cast<uint32_t>(this->meshIndices.size()) - this->maskedIndiceCount);
+    uint32_t largestTriangleCount = std::max({(opaqueIndiceCount / 3), (this->maskedIndiceCount / 3), 1u});
+    if ((chunkTriangleCount == 0) || (chunkTriangleCount > largestTriangleCount)) {
+        chunkTriangleCount = largestTriangleCount;
+    }
+
+    // the chunks grow until they fit, the opaque and the masked triangles are always at least a chunk each.
+    auto calculateChunkCount = [&](uint32_t indiceCount) { return (((indiceCount / 3) + (chunkTriangleCount - 1)) / chunkTriangleCount); };
+    while (((calculateChunkCount(opaqueIndiceCount) + calculateChunkCount(this->maskedIndiceCount)) > maxChunkCount) && (chunkTriangleCount < largestTriangleCount)) {
+        chunkTriangleCount = std::min((chunkTriangleCount * 2), largestTriangleCount);
+    }
+
+    uint32_t chunkIndiceCount = (chunkTriangleCount * 3);
+    auto appendChunks = [&](uint32_t firstIndex, uint32_t indiceCount, bool masked) {
+        for (uint32_t i = 0; i < indiceCount; i += chunkIndiceCount) {
+            ModelHandler::MeshChunk meshChunk;
+            meshChunk.firstIndex = (firstIndex + i);
+            meshChunk.indiceCount = std::min(chunkIndiceCount, (indiceCount - i));
+            meshChunk.masked = masked;
+            meshChunk.boundsMinimum = glm::vec3(std::numeric_limits<float>::max());
+            meshChunk.boundsMaximum = glm::vec3(std::numeric_limits<float>::lowest());
+            for (uint32_t j = meshChunk.firstIndex; j < (meshChunk.firstIndex + meshChunk.indiceCount); j += 1) {
+                meshChunk.boundsMinimum = glm::min(meshChunk.boundsMinimum, this->meshVertices[this->meshIndices[j]].position);
+                meshChunk.boundsMaximum = glm::max(meshChunk.boundsMaximum, this->meshVertices[this->meshIndices[j]].position);
+            }
+
+            this->meshChunks.push_back(meshChunk);
+        }
+    };
+    appendChunks(0, opaqueIndiceCount, false);
+    appendChunks(opaqueIndiceCount, this->maskedIndiceCount, true);
 }
 
 void ModelHandler::Model::normalizeNormalValues()
@@ -190,12 +312,29 @@ void ModelHandler::Model::normalizeNormalValues()
     }
 }
 
+void ModelHandler::Model::calculateMeshBounds()
+{
+    if (this->meshVertices.empty() == true) {
+        this->meshBoundsMinimum = glm::vec3(0.0f);
+        this->meshBoundsMaximum = glm::vec3(0.0f);
+        return;
+    }
+    
+    this->meshBoundsMinimum = this->meshVertices[0].position;
+    this->meshBoundsMaximum = this->meshVertices[0].position;
+    for (const ModelHandler::SceneVertexData& meshVertex : this->meshVertices) {
+        this->meshBoundsMinimum = glm::min(this->meshBoundsMinimum, meshVertex.position);
+        this->meshBoundsMaximum = glm::max(this->meshBoundsMaximum, meshVertex.position);
+    }
+}
+
 void ModelHandler::Model::populateShaderBufferComponents(std::vector<ModelHandler::SceneVertexData> vertexData, VkCommandPool commandPool, VkQueue commandQueue, DeviceHandler::VulkanDevices vulkanDevices)
 {
-    Buffer::createDataBufferComponents(vertexData.data(), (sizeof(vertexData[0]) * vertexData.size()), VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, commandPool, commandQueue, vulkanDevices, this->shaderBufferComponents.vertexBuffer, this->shaderBufferComponents.vertexBufferMemory);
+    // the scene vertices and indices are also fetched as storage buffers by the visibility buffer shading.
+    Buffer::createDataBufferComponents(vertexData.data(), (sizeof(vertexData[0]) * vertexData.size()), (VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT), commandPool, commandQueue, vulkanDevices, this->shaderBufferComponents.vertexBuffer, this->shaderBufferComponents.vertexBufferMemory);
 
     if (this->meshIndices.empty() == false) {
-        Buffer::createDataBufferComponents(this->meshIndices.data(), (sizeof(this->meshIndices[0]) * this->meshIndices.size()), VK_BUFFER_USAGE_INDEX_BUFFER_BIT, commandPool, commandQueue, vulkanDevices, this->shaderBufferComponents.indexBuffer, this->shaderBufferComponents.indexBufferMemory);
+        Buffer::createDataBufferComponents(this->meshIndices.data(), (sizeof(this->meshIndices[0]) * this->meshIndices.size()), (VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT), commandPool, commandQueue, vulkanDevices, this->shaderBufferComponents.indexBuffer, this->shaderBufferComponents.indexBufferMemory);
 
         shaderBufferComponents.verticeCount = -1;
         shaderBufferComponents.indiceCount = static_cast<int32_t>(this->meshIndices.size());
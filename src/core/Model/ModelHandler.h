@@ -19,6 +19,8 @@
 
 namespace ModelHandler
 {
+    const float blendedAlphaCutoff = 0.5f;  // blended materials have no cutoff of their own, they are alpha tested without a transparency pass.
+
     // different vertex data structs to populate the vertex buffer with, dependent on what pipeline is in use. each pipeline gets only what data is needed.
     struct CubemapVertexData {
         glm::vec3 position;
@@ -29,6 +31,7 @@ namespace ModelHandler
         glm::vec3 normal;
         glm::vec3 tangent;
         glm::vec2 UVCoordinates;
+        float alphaCutoff;  // the primitive's alpha cutoff, 0 for opaque primitives(read by the masked pipelines).
     };
 
     struct SceneNormalsVertexData {
@@ -50,6 +53,16 @@ namespace ModelHandler
         int32_t indiceCount;  // -1 if there are no indices present.
     };
 
+    struct MeshChunk {  // a run of consecutive mesh triangles culled as its own instance, opaque and masked triangles never share a chunk.
+        uint32_t firstIndex;
+        uint32_t indiceCount;
+        bool masked;  // if the chunk's triangles are alpha-masked(drawn by the masked pipelines).
+
+        // the model space axis-aligned bounds of the chunk's vertices.
+        glm::vec3 boundsMinimum;
+        glm::vec3 boundsMaximum;
+    };
+
     struct Model
     {
         std::string absoluteModelDirectory;  // the absolute directory of the model.
@@ -57,6 +70,12 @@ namespace ModelHandler
         // vertice compenets are normalized to a 0..1 range, expected to "reinterpet" this into the desired vertex data(see above structs).
         std::vector<ModelHandler::SceneVertexData> meshVertices; 
         std::vector<uint32_t> meshIndices;  // can be empty.
+        uint32_t maskedIndiceCount = 0;  // the indices of alpha-masked primitives, stored after every opaque index(drawn by the masked pipelines).
+
+        // the model space axis-aligned bounds of the mesh vertices(used in culling).
+        glm::vec3 meshBoundsMinimum = glm::vec3(0.0f);
+        glm::vec3 meshBoundsMaximum = glm::vec3(0.0f);
+        std::vector<ModelHandler::MeshChunk> meshChunks;  // the mesh's indices split into separately culled chunks, empty until the mesh is split.
 
 		// the stored quaternion to rotate the mesh using.
         glm::quat meshQuaternion = glm::identity<glm::quat>(); 
@@ -76,9 +95,27 @@ namespace ModelHandler
         // @param absoluteModelPath the absolute path of the model.
         void loadModelFromAbsolutePath(std::string absoluteModelPath);
 
+        // split each mesh triangle into four at its edge midpoints, repeatedly(used to make dense synthetic meshes).
+        //
+        // the split triangles keep the order and alpha cutoff of their triangle, the masked indices stay after the opaque indices.
+        //
+        // @param subdivisionCount the amount of times the triangles are split.
+        void subdivideMesh(uint32_t subdivisionCount);
+
+        // split the mesh's indices into chunks of consecutive triangles, each culled as its own instance.
+        //
+        // consecutive triangles mostly neighbour each other within a primitive, the chunks stay compact without reordering the indices.
+        //
+        // @param chunkTriangleCount the amount of triangles in each chunk, 0 to keep the opaque and the masked triangles in a chunk each.
+        // @param maxChunkCount the maximum amount of chunks, the chunks are enlarged to stay within it.
+        void splitMeshChunks(uint32_t chunkTriangleCount, uint32_t maxChunkCount);
+
         // normalize the mesh vertice normal values.
         void normalizeNormalValues();
 
+        // calculate the mesh bounds from the mesh vertices.
+        void calculateMeshBounds();
+
         // populate the shader buffer components for this model.
         //
         // @param vertexData the vertex data to pass into the vertex buffer.
@@ -27,7 +27,7 @@ bool Queue::deviceQueueFamiliesSuitable(VkPhysicalDevice physicalDevice, VkSurfa
             break;
         }
         
-        if (queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT) {  // if this queue family supports graphics operations.
+        if ((queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT) && (queueFamily.queueFlags & VK_QUEUE_COMPUTE_BIT)) {  // if this queue family supports graphics operations, the culling compute pass is recorded with the graphics commands.
             supportedFamilyIndices.graphicsFamily = i;
         }
 
@@ -0,0 +1,402 @@
+#define GLFW_INCLUDE_VULKAN
+#include <GLFW/glfw3.h>
+
+#include <core/Renderer/AntiAliasing.h>
+#include <core/Renderer/Renderer.h>
+#include <core/Shader/Uniform.h>
+#include <core/Shader/Image.h>
+#include <core/Shader/ResourceDescriptor.h>
+#include <core/DisplayManager/SwapchainHandler.h>
+#include <core/Logging/ErrorLogger.h>
+#include <core/Defaults/Defaults.h>
+
+#include <string>
+#include <vector>
+
+
+// create a single color attachment render pass for a fullscreen post-process pass.
+//
+// @param attachmentFormat the format of the color attachment.
+// @param loadOp the load operation of the color attachment.
+// @param vulkanLogicalDevice Vulkan logical device to use in post-process render pass creation.
+// @param renderPass created post-process render pass.
+static void createPostRenderPass(VkFormat attachmentFormat, VkAttachmentLoadOp loadOp, VkDevice vulkanLogicalDevice, VkRenderPass& renderPass)
+{
+    VkAttachmentDescription colorAttachmentDescription{};
+    colorAttachmentDescription.format = attachmentFormat;
+    colorAttachmentDescription.samples = VK_SAMPLE_COUNT_1_BIT;
+
+    colorAttachmentDescription.loadOp = loadOp;
+    colorAttachmentDescription.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+    colorAttachmentDescription.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+    colorAttachmentDescription.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+
+    // layout transitions(ex: to presentation) are recorded by the render graph.
+    colorAttachmentDescription.initialLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+    colorAttachmentDescription.finalLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+    VkAttachmentReference colorAttachmentReference{};
+    colorAttachmentReference.attachment = 0;
+    colorAttachmentReference.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+
+    VkSubpassDescription subpassDescription{};
+    subpassDescription.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+
+    subpassDescription.colorAttachmentCount = 1;
+    subpassDescription.pColorAttachments = &colorAttachmentReference;
+
+
+    VkRenderPassCreateInfo renderPassCreateInfo{};
+    renderPassCreateInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+
+    renderPassCreateInfo.attachmentCount = 1;
+    renderPassCreateInfo.pAttachments = &colorAttachmentDescription;
+
+    renderPassCreateInfo.subpassCount = 1;
+    renderPassCreateInfo.pSubpasses = &subpassDescription;
+
+    renderPassCreateInfo.dependencyCount = 0;  // the dependencies on the previous passes are recorded as barriers by the render graph.
+
+    VkResult renderPassCreationResult = vkCreateRenderPass(vulkanLogicalDevice, &renderPassCreateInfo, nullptr, &renderPass);
+    if (renderPassCreationResult != VK_SUCCESS) {
+        throwDebugException("Failed to create an anti-aliasing render pass.");
+    }
+}
+
+// create a fullscreen post-process pipeline, reading the post-process images through the pipeline components' descriptor set layout.
+//
+// @param fragmentShaderName the name of the fragment shader's bytecode in the build directory.
+// @param renderPass render pass to use in post-process pipeline creation.
+// @param vulkanLogicalDevice Vulkan logical device to use in post-process pipeline creation.
+// @param pipelineComponents reference to the pipeline components to use and create the pipeline in.
+static void createPostPipeline(std::string fragmentShaderName, VkRenderPass renderPass, VkDevice vulkanLogicalDevice, Pipeline::PipelineComponents& pipelineComponents)
+{
+    Pipeline::PipelineData postPipelineData;
+
+    postPipelineData.vulkanLogicalDevice = vulkanLogicalDevice;
+
+    // the deferred lighting's fullscreen triangle, the fragment shaders derive their texture coordinates from the fragment coordinates.
+    postPipelineData.vertexShaderBytecodeAbsolutePath = (Defaults::applicationDefaults.SALAMANDER_ROOT_DIRECTORY + "/build/deferredLightingVertex.spv");
+    postPipelineData.geometryShaderBytecodeAbsolutePath = "*NA*";
+    postPipelineData.fragmentShaderBytecodeAbsolutePath = (Defaults::applicationDefaults.SALAMANDER_ROOT_DIRECTORY + "/build/" + fragmentShaderName);
+
+    postPipelineData.vertexDataStride = 0;
+    postPipelineData.fetchAttributeDescriptions = [](std::vector<VkVertexInputAttributeDescription>& attributeDescriptions) { attributeDescriptions.clear(); };
+
+    postPipelineData.inputAssemblyTopology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+    postPipelineData.inputAssemblyPrimitiveRestartEnable = VK_FALSE;
+
+    postPipelineData.viewportViewportCount = 1;
+    postPipelineData.viewportScissorCount = 1;
+
+    postPipelineData.rasterizationCullMode = VK_CULL_MODE_NONE;
+    postPipelineData.rasterizationFrontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+
+    postPipelineData.multisamplingRasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+    postPipelineData.multisamplingMinSampleShading = 0.0f;
+
+    postPipelineData.depthStencilDepthTestEnable = VK_FALSE;
+    postPipelineData.depthStencilDepthWriteEnable = VK_FALSE;
+    postPipelineData.depthStencilDepthCompareOp = VK_COMPARE_OP_ALWAYS;
+
+    postPipelineData.colorBlendColorWriteMask = (VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT);
+    postPipelineData.colorBlendBlendEnable = VK_FALSE;
+
+    postPipelineData.dynamicStatesDynamicStates = {VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR};
+
+    postPipelineData.pipelineRenderPass = renderPass;
+
+    VkPushConstantRange postPushConstant{};
+    Uniform::populatePushConstant(0, sizeof(AntiAliasing::PostPushConstant), VK_SHADER_STAGE_FRAGMENT_BIT, postPushConstant);
+    postPipelineData.pushConstant = &postPushConstant;
+
+
+    pipelineComponents.createMemberPipeline(postPipelineData);
+}
+
+// fetch the presentation fragment shader of an anti-aliasing mode, modes without a post-process filter copy the scene color.
+//
+// @param antiAliasingMode the anti-aliasing mode(see AntiAliasing::antiAliasingModes).
+// @param fragmentShaderName the fetched name of the fragment shader's bytecode.
+static void fetchPresentationShaderName(std::string antiAliasingMode, std::string& fragmentShaderName)
+{
+    if (antiAliasingMode == "FXAA") {
+        fragmentShaderName = "antiAliasingFxaaFragment.spv";
+    } else if (antiAliasingMode == "SMAA") {
+        fragmentShaderName = "antiAliasingSmaaFragment.spv";  // SMAA's neighborhood blending.
+    } else {
+        fragmentShaderName = "antiAliasingCopyFragment.spv";
+    }
+}
+
+void AntiAliasing::fetchModeSampleCount(std::string antiAliasingMode, VkSampleCountFlagBits& msaaSampleCount)
+{
+    if (antiAliasingMode == "MSAA8") {
+        msaaSampleCount = VK_SAMPLE_COUNT_8_BIT;
+    } else if (antiAliasingMode == "MSAA4") {
+        msaaSampleCount = VK_SAMPLE_COUNT_4_BIT;
+    } else if (antiAliasingMode == "MSAA2") {
+        msaaSampleCount = VK_SAMPLE_COUNT_2_BIT;
+    } else {
+        msaaSampleCount = VK_SAMPLE_COUNT_1_BIT;
+    }
+}
+
+void AntiAliasing::AntiAliasingOperation::generateMemberComponents(VkFormat swapchainImageFormat, std::string antiAliasingMode, DeviceHandler::VulkanDevices vulkanDevices)
+{
+    this->antiAliasingMode = antiAliasingMode;
+
+
+    // every swapchain pixel is written, while the SMAA images are cleared as only the detected edges are written.
+    createPostRenderPass(swapchainImageFormat, VK_ATTACHMENT_LOAD_OP_DONT_CARE, vulkanDevices.logicalDevice, this->presentationRenderPass);
+    createPostRenderPass(AntiAliasing::edgesImageFormat, VK_ATTACHMENT_LOAD_OP_CLEAR, vulkanDevices.logicalDevice, this->edgeDetectionRenderPass);
+    createPostRenderPass(AntiAliasing::blendingWeightsImageFormat, VK_ATTACHMENT_LOAD_OP_CLEAR, vulkanDevices.logicalDevice, this->blendingWeightRenderPass);
+
+
+    VkDescriptorSetLayoutBinding sceneColorLayoutBinding{};
+    ResourceDescriptor::populateDescriptorSetLayoutBinding(0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_FRAGMENT_BIT, sceneColorLayoutBinding);
+
+    VkDescriptorSetLayoutBinding edgesLayoutBinding{};
+    ResourceDescriptor::populateDescriptorSetLayoutBinding(1, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_FRAGMENT_BIT, edgesLayoutBinding);
+
+    VkDescriptorSetLayoutBinding blendingWeightsLayoutBinding{};
+    ResourceDescriptor::populateDescriptorSetLayoutBinding(2, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_FRAGMENT_BIT, blendingWeightsLayoutBinding);
+
+    VkDescriptorSetLayoutBinding bloomLayoutBinding{};
+    ResourceDescriptor::populateDescriptorSetLayoutBinding(3, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_FRAGMENT_BIT, bloomLayoutBinding);
+
+    VkDescriptorSetLayoutBinding exposureLayoutBinding{};
+    ResourceDescriptor::populateDescriptorSetLayoutBinding(4, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_FRAGMENT_BIT, exposureLayoutBinding);
+
+    std::vector<VkDescriptorSetLayoutBinding> postDescriptorSetLayoutBindings = {sceneColorLayoutBinding, edgesLayoutBinding, blendingWeightsLayoutBinding, bloomLayoutBinding, exposureLayoutBinding};
+    ResourceDescriptor::createDescriptorSetLayout(postDescriptorSetLayoutBindings, vulkanDevices.logicalDevice, this->pipelineComponents.descriptorSetLayout);
+
+
+    std::string presentationShaderName;
+    fetchPresentationShaderName(this->antiAliasingMode, presentationShaderName);
+    createPostPipeline(presentationShaderName, this->presentationRenderPass, vulkanDevices.logicalDevice, this->pipelineComponents);
+
+    // compatible pipeline layouts, the presentation pipeline components' descriptor set is bound.
+    this->edgeDetectionPipelineComponents.descriptorSetLayout = this->pipelineComponents.descriptorSetLayout;
+    createPostPipeline("smaaEdgesFragment.spv", this->edgeDetectionRenderPass, vulkanDevices.logicalDevice, this->edgeDetectionPipelineComponents);
+    this->blendingWeightPipelineComponents.descriptorSetLayout = this->pipelineComponents.descriptorSetLayout;
+    createPostPipeline("smaaWeightsFragment.spv", this->blendingWeightRenderPass, vulkanDevices.logicalDevice, this->blendingWeightPipelineComponents);
+
+
+    VkSamplerCreateInfo samplerCreateInfo{};
+    samplerCreateInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+
+    samplerCreateInfo.minFilter = VK_FILTER_LINEAR;  // FXAA and SMAA sample between texels, blending neighbors in a single fetch.
+    samplerCreateInfo.magFilter = VK_FILTER_LINEAR;
+
+    samplerCreateInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;  // the screen's border pixels are their own neighbors.
+    samplerCreateInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerCreateInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+
+    samplerCreateInfo.anisotropyEnable = VK_FALSE;
+    samplerCreateInfo.maxAnisotropy = 1.0f;
+
+    samplerCreateInfo.borderColor = VK_BORDER_COLOR_FLOAT_OPAQUE_BLACK;
+    samplerCreateInfo.unnormalizedCoordinates = VK_FALSE;
+
+    samplerCreateInfo.compareEnable = VK_FALSE;
+    samplerCreateInfo.compareOp = VK_COMPARE_OP_ALWAYS;
+
+    samplerCreateInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+    samplerCreateInfo.mipLodBias = 0.0f;
+    samplerCreateInfo.minLod = 0.0f;
+    samplerCreateInfo.maxLod = 0.0f;
+
+    VkResult postSamplerCreationResult = vkCreateSampler(vulkanDevices.logicalDevice, &samplerCreateInfo, nullptr, &this->postSampler);
+    if (postSamplerCreationResult != VK_SUCCESS) {
+        throwDebugException("Failed to create the anti-aliasing sampler.");
+    }
+
+
+    // a single descriptor set, the post-process images are only rewritten while the device is idle.
+    VkDescriptorPoolSize combinedSamplerPoolSize{};
+    ResourceDescriptor::populateDescriptorPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, static_cast<uint32_t>(postDescriptorSetLayoutBindings.size() - 1), combinedSamplerPoolSize);
+    VkDescriptorPoolSize storageBufferPoolSize{};
+    ResourceDescriptor::populateDescriptorPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, storageBufferPoolSize);  // the exposure buffer.
+    VkDescriptorPoolSize descriptorPoolSizes[] = {combinedSamplerPoolSize, storageBufferPoolSize};
+
+    VkDescriptorPoolCreateInfo descriptorPoolCreateInfo{};
+    descriptorPoolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+
+    descriptorPoolCreateInfo.poolSizeCount = 2;
+    descriptorPoolCreateInfo.pPoolSizes = descriptorPoolSizes;
+
+    descriptorPoolCreateInfo.maxSets = 1;
+
+    VkResult descriptorPoolCreationResult = vkCreateDescriptorPool(vulkanDevices.logicalDevice, &descriptorPoolCreateInfo, nullptr, &this->pipelineComponents.descriptorPool);
+    if (descriptorPoolCreationResult != VK_SUCCESS) {
+        throwDebugException("Failed to create the anti-aliasing descriptor pool.");
+    }
+
+    VkDescriptorSetAllocateInfo descriptorSetAllocateInfo{};
+    descriptorSetAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+
+    descriptorSetAllocateInfo.descriptorPool = this->pipelineComponents.descriptorPool;
+
+    descriptorSetAllocateInfo.descriptorSetCount = 1;
+    descriptorSetAllocateInfo.pSetLayouts = &this->pipelineComponents.descriptorSetLayout;
+
+    this->pipelineComponents.descriptorSets.resize(1);
+    VkResult descriptorSetAllocationResult = vkAllocateDescriptorSets(vulkanDevices.logicalDevice, &descriptorSetAllocateInfo, this->pipelineComponents.descriptorSets.data());
+    if (descriptorSetAllocationResult != VK_SUCCESS) {
+        throwDebugException("Failed to allocate the anti-aliasing descriptor set.");
+    }
+}
+
+void AntiAliasing::AntiAliasingOperation::switchAntiAliasingMode(std::string antiAliasingMode, VkDevice vulkanLogicalDevice)
+{
+    std::string previousShaderName;
+    fetchPresentationShaderName(this->antiAliasingMode, previousShaderName);
+    std::string shaderName;
+    fetchPresentationShaderName(antiAliasingMode, shaderName);
+
+    this->antiAliasingMode = antiAliasingMode;
+    if (shaderName == previousShaderName) {  // ex: between the msaa modes, which all copy the resolved scene color.
+        return;
+    }
+
+    // the descriptor set layout and descriptor set are kept.
+    vkDestroyPipeline(vulkanLogicalDevice, this->pipelineComponents.pipeline, nullptr);
+    vkDestroyPipelineLayout(vulkanLogicalDevice, this->pipelineComponents.pipelineLayout, nullptr);
+    createPostPipeline(shaderName, this->presentationRenderPass, vulkanLogicalDevice, this->pipelineComponents);
+}
+
+void AntiAliasing::AntiAliasingOperation::generatePostImages(VkImageView sceneColorImageView, VkImageView bloomImageView, VkBuffer exposureBuffer, VkExtent2D postExtent, DeviceHandler::VulkanDevices vulkanDevices)
+{
+    this->postExtent = postExtent;
+
+    Image::populateImageDetails(postExtent.width, postExtent.height, 1, 1, VK_SAMPLE_COUNT_1_BIT, AntiAliasing::edgesImageFormat, VK_IMAGE_TILING_OPTIMAL, (VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT), VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, vulkanDevices, this->edgesImageDetails);
+    Image::createImageView(this->edgesImageDetails.image, AntiAliasing::edgesImageFormat, 1, 1, VK_IMAGE_ASPECT_COLOR_BIT, vulkanDevices.logicalDevice, this->edgesImageDetails.imageView);
+
+    Image::populateImageDetails(postExtent.width, postExtent.height, 1, 1, VK_SAMPLE_COUNT_1_BIT, AntiAliasing::blendingWeightsImageFormat, VK_IMAGE_TILING_OPTIMAL, (VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT), VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, vulkanDevices, this->blendingWeightsImageDetails);
+    Image::createImageView(this->blendingWeightsImageDetails.image, AntiAliasing::blendingWeightsImageFormat, 1, 1, VK_IMAGE_ASPECT_COLOR_BIT, vulkanDevices.logicalDevice, this->blendingWeightsImageDetails.imageView);
+
+    VkFramebufferCreateInfo edgesFramebufferCreateInfo{};
+    SwapchainHandler::populateFramebufferCreateInfo(this->edgeDetectionRenderPass, &this->edgesImageDetails.imageView, 1, postExtent.width, postExtent.height, edgesFramebufferCreateInfo);
+    VkResult edgesFramebufferCreationResult = vkCreateFramebuffer(vulkanDevices.logicalDevice, &edgesFramebufferCreateInfo, nullptr, &this->edgesFramebuffer);
+
+    VkFramebufferCreateInfo blendingWeightsFramebufferCreateInfo{};
+    SwapchainHandler::populateFramebufferCreateInfo(this->blendingWeightRenderPass, &this->blendingWeightsImageDetails.imageView, 1, postExtent.width, postExtent.height, blendingWeightsFramebufferCreateInfo);
+    VkResult blendingWeightsFramebufferCreationResult = vkCreateFramebuffer(vulkanDevices.logicalDevice, &blendingWeightsFramebufferCreateInfo, nullptr, &this->blendingWeightsFramebuffer);
+
+    if (edgesFramebufferCreationResult != VK_SUCCESS || blendingWeightsFramebufferCreationResult != VK_SUCCESS) {
+        throwDebugException("Failed to create the anti-aliasing framebuffers.");
+    }
+
+
+    // every image binding is read in a shader read-only layout transitioned by the render graph, except the bloom image kept in the general layout.
+    std::vector<VkImageView> postImageViews = {sceneColorImageView, this->edgesImageDetails.imageView, this->blendingWeightsImageDetails.imageView, bloomImageView};
+    std::vector<VkDescriptorImageInfo> postDescriptorImageInfos(postImageViews.size());
+    std::vector<VkWriteDescriptorSet> postWriteDescriptorSets(postImageViews.size() + 1);
+    for (size_t i = 0; i < postImageViews.size(); i += 1) {
+        VkImageLayout postImageLayout = ((postImageViews[i] == bloomImageView) ? VK_IMAGE_LAYOUT_GENERAL : VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+        ResourceDescriptor::populateDescriptorImageInfo(this->postSampler, postImageViews[i], postImageLayout, postDescriptorImageInfos[i]);
+        ResourceDescriptor::populateWriteDescriptorSet(this->pipelineComponents.descriptorSets[0], static_cast<uint32_t>(i), VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, &postDescriptorImageInfos[i], nullptr, postWriteDescriptorSets[i]);
+    }
+
+    VkDescriptorBufferInfo exposureDescriptorBufferInfo{};
+    ResourceDescriptor::populateDescriptorBufferInfo(exposureBuffer, 0, VK_WHOLE_SIZE, exposureDescriptorBufferInfo);
+    ResourceDescriptor::populateWriteDescriptorSet(this->pipelineComponents.descriptorSets[0], static_cast<uint32_t>(postImageViews.size()), VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, nullptr, &exposureDescriptorBufferInfo, postWriteDescriptorSets.back());
+
+    vkUpdateDescriptorSets(vulkanDevices.logicalDevice, static_cast<uint32_t>(postWriteDescriptorSets.size()), postWriteDescriptorSets.data(), 0, nullptr);
+}
+
+// record a fullscreen triangle in a post-process render pass.
+//
+// @param renderPass the post-process render pass.
+// @param framebuffer the framebuffer of the written image.
+// @param pipelineComponents the pipeline components of the post-process pipeline.
+// @param descriptorSet the anti-aliasing descriptor set.
+// @param postExtent the extent of the written image.
+// @param commandBuffer the command buffer to record in.
+static void recordPostCommands(VkRenderPass renderPass, VkFramebuffer framebuffer, const Pipeline::PipelineComponents& pipelineComponents, VkDescriptorSet descriptorSet, VkExtent2D postExtent, VkCommandBuffer commandBuffer)
+{
+    VkClearValue postAttachmentClearValue = {{{0.0f, 0.0f, 0.0f, 0.0f}}};  // no edges and no blending.
+
+    VkRenderPassBeginInfo postRenderPassBeginInfo{};
+    postRenderPassBeginInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+
+    postRenderPassBeginInfo.renderPass = renderPass;
+    postRenderPassBeginInfo.framebuffer = framebuffer;
+
+    postRenderPassBeginInfo.renderArea.offset = {0, 0};
+    postRenderPassBeginInfo.renderArea.extent = postExtent;
+
+    postRenderPassBeginInfo.clearValueCount = 1;
+    postRenderPassBeginInfo.pClearValues = &postAttachmentClearValue;
+
+    vkCmdBeginRenderPass(commandBuffer, &postRenderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);  // a single draw, recorded directly in the primary command buffer.
+
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineComponents.pipeline);
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineComponents.pipelineLayout, 0, 1, &descriptorSet, 0, nullptr);
+
+    AntiAliasing::PostPushConstant postPushConstant{};
+    postPushConstant.texelSize = glm::vec2((1.0f / postExtent.width), (1.0f / postExtent.height));
+    vkCmdPushConstants(commandBuffer, pipelineComponents.pipelineLayout, VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(AntiAliasing::PostPushConstant), &postPushConstant);
+
+    VkViewport viewport{};
+    viewport.x = 0.0f;
+    viewport.y = 0.0f;
+    viewport.width = static_cast<float>(postExtent.width);
+    viewport.height = static_cast<float>(postExtent.height);
+    viewport.minDepth = 0.0f;
+    viewport.maxDepth = 1.0f;
+    vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+
+    VkRect2D scissor{};
+    scissor.offset = {0, 0};
+    scissor.extent = postExtent;
+    vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+
+    vkCmdDraw(commandBuffer, 3, 1, 0, 0);  // the fullscreen triangle.
+
+    vkCmdEndRenderPass(commandBuffer);
+}
+
+void AntiAliasing::AntiAliasingOperation::recordEdgeDetectionCommands(VkCommandBuffer commandBuffer) const
+{
+    recordPostCommands(this->edgeDetectionRenderPass, this->edgesFramebuffer, this->edgeDetectionPipelineComponents, this->pipelineComponents.descriptorSets[0], this->postExtent, commandBuffer);
+}
+
+void AntiAliasing::AntiAliasingOperation::recordBlendingWeightCommands(VkCommandBuffer commandBuffer) const
+{
+    recordPostCommands(this->blendingWeightRenderPass, this->blendingWeightsFramebuffer, this->blendingWeightPipelineComponents, this->pipelineComponents.descriptorSets[0], this->postExtent, commandBuffer);
+}
+
+void AntiAliasing::AntiAliasingOperation::recordPresentationCommands(VkFramebuffer swapchainFramebuffer, VkCommandBuffer commandBuffer) const
+{
+    recordPostCommands(this->presentationRenderPass, swapchainFramebuffer, this->pipelineComponents, this->pipelineComponents.descriptorSets[0], this->postExtent, commandBuffer);
+}
+
+void AntiAliasing::AntiAliasingOperation::cleanupPostImages(VkDevice vulkanLogicalDevice)
+{
+    vkDestroyFramebuffer(vulkanLogicalDevice, this->edgesFramebuffer, nullptr);
+    vkDestroyFramebuffer(vulkanLogicalDevice, this->blendingWeightsFramebuffer, nullptr);
+
+    this->edgesImageDetails.cleanupImageDetails(vulkanLogicalDevice);
+    this->blendingWeightsImageDetails.cleanupImageDetails(vulkanLogicalDevice);
+}
+
+void AntiAliasing::AntiAliasingOperation::cleanupAntiAliasingOperation(VkDevice vulkanLogicalDevice)
+{
+    this->cleanupPostImages(vulkanLogicalDevice);
+
+    vkDestroySampler(vulkanLogicalDevice, this->postSampler, nullptr);
+
+    // the SMAA pipeline components share the presentation pipeline components' descriptors.
+    vkDestroyPipeline(vulkanLogicalDevice, this->edgeDetectionPipelineComponents.pipeline, nullptr);
+    vkDestroyPipelineLayout(vulkanLogicalDevice, this->edgeDetectionPipelineComponents.pipelineLayout, nullptr);
+    vkDestroyPipeline(vulkanLogicalDevice, this->blendingWeightPipelineComponents.pipeline, nullptr);
+    vkDestroyPipelineLayout(vulkanLogicalDevice, this->blendingWeightPipelineComponents.pipelineLayout, nullptr);
+    this->pipelineComponents.cleanupPipelineComponents(vulkanLogicalDevice);  // frees the descriptor set with its pool.
+
+    vkDestroyRenderPass(vulkanLogicalDevice, this->presentationRenderPass, nullptr);
+    vkDestroyRenderPass(vulkanLogicalDevice, this->edgeDetectionRenderPass, nullptr);
+    vkDestroyRenderPass(vulkanLogicalDevice, this->blendingWeightRenderPass, nullptr);
+}
@@ -0,0 +1,110 @@
+#ifndef ANTIALIASING_H
+#define ANTIALIASING_H
+
+
+#define GLFW_INCLUDE_VULKAN
+#include <GLFW/glfw3.h>
+
+#include <core/Renderer/Pipeline.h>
+#include <core/Shader/Image.h>
+#include <core/VulkanInstance/DeviceHandler.h>
+
+#include <glm/glm.hpp>
+
+#include <string>
+#include <array>
+
+
+namespace AntiAliasing
+{
+    const std::array<std::string, 7> antiAliasingModes = {"OFF", "FXAA", "SMAA", "TAA", "MSAA2", "MSAA4", "MSAA8"};  // every anti-aliasing mode, cycled through in this order at runtime(TAA is resolved by TemporalAntiAliasing::TemporalOperation).
+    const VkFormat edgesImageFormat = VK_FORMAT_R8G8_UNORM;  // each pixel's [top, left] edge.
+    const VkFormat blendingWeightsImageFormat = VK_FORMAT_R8G8B8A8_UNORM;  // each pixel's top edge coverage of itself and of its top neighbor, followed by its left edge's.
+
+    struct PostPushConstant {  // identical to the anti-aliasing shaders' push constant.
+        glm::vec2 texelSize;  // the size of a scene color texel in texture coordinates.
+    };
+
+    // fetch the amount of msaa samples requested by an anti-aliasing mode, post-process modes use a single sample.
+    //
+    // @param antiAliasingMode the anti-aliasing mode(see antiAliasingModes).
+    // @param msaaSampleCount the fetched amount of msaa samples.
+    void fetchModeSampleCount(std::string antiAliasingMode, VkSampleCountFlagBits& msaaSampleCount);
+
+    struct AntiAliasingOperation {  // tonemaps the single-sampled HDR scene color with the bloom into the swapchain image, filtered with FXAA or SMAA(multisampled scene colors are already resolved by the main render pass).
+        Pipeline::PipelineComponents pipelineComponents;  // the presentation pipeline of the current mode, its single descriptor set(without uniform buffers) is shared with the SMAA pipelines.
+        Pipeline::PipelineComponents edgeDetectionPipelineComponents;  // SMAA's luma edge detection, bound with the presentation pipeline components' descriptor set.
+        Pipeline::PipelineComponents blendingWeightPipelineComponents;  // SMAA's blending weight calculation, bound with the presentation pipeline components' descriptor set.
+
+        VkRenderPass presentationRenderPass;  // writes the swapchain image, the swapchain framebuffers are created with it.
+        VkRenderPass edgeDetectionRenderPass;
+        VkRenderPass blendingWeightRenderPass;
+
+        Image::ImageDetails edgesImageDetails;  // generated with the scene color(see generatePostImages), only written with SMAA.
+        Image::ImageDetails blendingWeightsImageDetails;
+        VkFramebuffer edgesFramebuffer;
+        VkFramebuffer blendingWeightsFramebuffer;
+        VkSampler postSampler;  // a linear sampler clamped to the edge, used for every post-process image.
+
+        std::string antiAliasingMode;  // selects the presentation pipeline's shader.
+        VkExtent2D postExtent;  // the extent of the scene color and the post-process images.
+
+
+        // generate the member anti-aliasing components, the post-process images are generated seperately with the scene color(see generatePostImages).
+        //
+        // @param swapchainImageFormat the format of the swapchain images written by the presentation pipeline.
+        // @param antiAliasingMode the initial anti-aliasing mode(see antiAliasingModes).
+        // @param vulkanDevices Vulkan physical and logical device to use in member components generation.
+        void generateMemberComponents(VkFormat swapchainImageFormat, std::string antiAliasingMode, DeviceHandler::VulkanDevices vulkanDevices);
+
+        // switch the anti-aliasing mode, recreating the presentation pipeline if its shader changes(the device must be idle).
+        //
+        // @param antiAliasingMode the anti-aliasing mode to switch to.
+        // @param vulkanLogicalDevice Vulkan logical device to use in presentation pipeline recreation.
+        void switchAntiAliasingMode(std::string antiAliasingMode, VkDevice vulkanLogicalDevice);
+
+        // generate the post-process images and framebuffers, and point the descriptor set at them, the scene color, the bloom, and the exposure.
+        //
+        // @param sceneColorImageView the view of the single-sampled scene color(the main render pass's resolve attachment, or its color attachment without msaa).
+        // @param bloomImageView the view of the first bloom level(see PostProcessing::PostProcessingOperation).
+        // @param exposureBuffer the adapted exposure buffer(see PostProcessing::ExposureState).
+        // @param postExtent the extent of the scene color.
+        // @param vulkanDevices Vulkan physical and logical device to use in post-process images generation.
+        void generatePostImages(VkImageView sceneColorImageView, VkImageView bloomImageView, VkBuffer exposureBuffer, VkExtent2D postExtent, DeviceHandler::VulkanDevices vulkanDevices);
+
+        // record SMAA's edge detection commands, a fullscreen triangle writing the edges image.
+        //
+        // expects the scene color in a shader read-only layout, the exposure written, and the edges image in the color attachment layout.
+        //
+        // @param commandBuffer the command buffer to record in.
+        void recordEdgeDetectionCommands(VkCommandBuffer commandBuffer) const;
+
+        // record SMAA's blending weight calculation commands, a fullscreen triangle writing the blending weights image.
+        //
+        // expects the edges image in a shader read-only layout and the blending weights image in the color attachment layout.
+        //
+        // @param commandBuffer the command buffer to record in.
+        void recordBlendingWeightCommands(VkCommandBuffer commandBuffer) const;
+
+        // record the presentation commands, a fullscreen triangle writing the tonemapped swapchain image with the current mode's filter.
+        //
+        // expects the scene color(and the blending weights image with SMAA) in a shader read-only layout, and the bloom and exposure written.
+        //
+        // @param swapchainFramebuffer the framebuffer of the written swapchain image.
+        // @param commandBuffer the command buffer to record in.
+        void recordPresentationCommands(VkFramebuffer swapchainFramebuffer, VkCommandBuffer commandBuffer) const;
+
+        // cleanup the post-process images and framebuffers(ex: before the scene color is recreated).
+        //
+        // @param vulkanLogicalDevice Vulkan logical device to use in post-process images cleanup.
+        void cleanupPostImages(VkDevice vulkanLogicalDevice);
+
+        // cleanup the anti-aliasing operation.
+        //
+        // @param vulkanLogicalDevice Vulkan logical device to use in anti-aliasing operation cleanup.
+        void cleanupAntiAliasingOperation(VkDevice vulkanLogicalDevice);
+    };
+}
+
+
+#endif  // ANTIALIASING_H
@@ -0,0 +1,375 @@
+#define GLFW_INCLUDE_VULKAN
+#include <GLFW/glfw3.h>
+
+#define GLM_FORCE_RADIANS
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <core/Renderer/BoundingVolumeHierarchy.h>
+#include <core/Shader/Uniform.h>
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <numeric>
+#include <functional>
+#include <random>
+#include <chrono>
+#include <cfloat>
+#include <iostream>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE__)
+#include <xmmintrin.h>
+#endif
+
+
+void BoundingVolumeHierarchy::Hierarchy::buildHierarchy(const std::vector<BoundingVolumeHierarchy::AxisAlignedBox>& instanceBoxes, uint32_t firstInstance, uint32_t instanceCount)
+{
+    this->firstInstance = firstInstance;
+    this->instanceCount = instanceCount;
+
+    this->nodes.clear();
+    if (instanceCount == 0) {
+        return;
+    }
+
+    std::vector<uint32_t> instanceIndices(instanceCount);
+    std::iota(instanceIndices.begin(), instanceIndices.end(), firstInstance);
+
+    this->nodes.reserve((instanceCount / (BoundingVolumeHierarchy::nodeWidth - 1)) + 1);
+    this->buildNode(instanceBoxes, instanceIndices, 0, instanceCount);
+
+    this->refitHierarchy(instanceBoxes);  // the build only creates the topology, the bounds are written by the refit.
+}
+
+uint32_t BoundingVolumeHierarchy::Hierarchy::buildNode(const std::vector<BoundingVolumeHierarchy::AxisAlignedBox>& instanceBoxes, std::vector<uint32_t>& instanceIndices, uint32_t rangeBegin, uint32_t rangeEnd)
+{
+    uint32_t nodeIndex = static_cast<uint32_t>(this->nodes.size());
+    this->nodes.push_back({});
+
+    // split the largest child range in half until the node is full or every child is a single instance.
+    std::vector<std::pair<uint32_t, uint32_t>> childRanges = {{rangeBegin, rangeEnd}};
+    while (childRanges.size() < BoundingVolumeHierarchy::nodeWidth) {
+        auto largestChildRange = std::max_element(childRanges.begin(), childRanges.end(), [](const std::pair<uint32_t, uint32_t>& firstRange, const std::pair<uint32_t, uint32_t>& secondRange) { return (firstRange.second - firstRange.first) < (secondRange.second - secondRange.first); });
+        uint32_t splitBegin = largestChildRange->first;
+        uint32_t splitEnd = largestChildRange->second;
+        if ((splitEnd - splitBegin) <= 1) {
+            break;
+        }
+
+        glm::vec3 centroidMinimum = glm::vec3(FLT_MAX);
+        glm::vec3 centroidMaximum = glm::vec3(-FLT_MAX);
+        for (uint32_t i = splitBegin; i < splitEnd; i += 1) {
+            const BoundingVolumeHierarchy::AxisAlignedBox& instanceBox = instanceBoxes[instanceIndices[i]];
+            glm::vec3 instanceCentroid = ((instanceBox.minimum + instanceBox.maximum) * 0.5f);
+            centroidMinimum = glm::min(centroidMinimum, instanceCentroid);
+            centroidMaximum = glm::max(centroidMaximum, instanceCentroid);
+        }
+
+        glm::vec3 centroidExtent = (centroidMaximum - centroidMinimum);
+        uint32_t splitAxis = ((centroidExtent.x > centroidExtent.y) && (centroidExtent.x > centroidExtent.z)) ? 0 : ((centroidExtent.y > centroidExtent.z) ? 1 : 2);
+
+        uint32_t splitMiddle = (splitBegin + ((splitEnd - splitBegin) / 2));
+        std::nth_element((instanceIndices.begin() + splitBegin), (instanceIndices.begin() + splitMiddle), (instanceIndices.begin() + splitEnd), [&](uint32_t firstInstance, uint32_t secondInstance) {
+            return (instanceBoxes[firstInstance].minimum[splitAxis] + instanceBoxes[firstInstance].maximum[splitAxis]) < (instanceBoxes[secondInstance].minimum[splitAxis] + instanceBoxes[secondInstance].maximum[splitAxis]);
+        });
+
+        *largestChildRange = {splitBegin, splitMiddle};
+        childRanges.push_back({splitMiddle, splitEnd});
+    }
+
+    this->nodes[nodeIndex].childCount = static_cast<uint32_t>(childRanges.size());
+    this->nodes[nodeIndex].leafMask = 0;
+    for (uint32_t i = 0; i < childRanges.size(); i += 1) {
+        if ((childRanges[i].second - childRanges[i].first) == 1) {
+            this->nodes[nodeIndex].childIndices[i] = instanceIndices[childRanges[i].first];
+            this->nodes[nodeIndex].leafMask |= (1u << i);
+        } else {
+            uint32_t childNodeIndex = this->buildNode(instanceBoxes, instanceIndices, childRanges[i].first, childRanges[i].second);  // may reallocate the nodes.
+            this->nodes[nodeIndex].childIndices[i] = childNodeIndex;
+        }
+    }
+
+    return nodeIndex;
+}
+
+void BoundingVolumeHierarchy::Hierarchy::refitHierarchy(const std::vector<BoundingVolumeHierarchy::AxisAlignedBox>& instanceBoxes)
+{
+    // children always follow their parent, refitting in reverse refits every child before its parent.
+    for (size_t i = this->nodes.size(); i > 0; i -= 1) {
+        BoundingVolumeHierarchy::WideNode& node = this->nodes[i - 1];
+
+        for (uint32_t j = 0; j < node.childCount; j += 1) {
+            BoundingVolumeHierarchy::AxisAlignedBox childBox;
+            if ((node.leafMask & (1u << j)) != 0) {
+                childBox = instanceBoxes[node.childIndices[j]];
+            } else {
+                const BoundingVolumeHierarchy::WideNode& childNode = this->nodes[node.childIndices[j]];
+
+                childBox = {glm::vec3(FLT_MAX), glm::vec3(-FLT_MAX)};
+                for (uint32_t k = 0; k < childNode.childCount; k += 1) {
+                    childBox.minimum = glm::min(childBox.minimum, glm::vec3(childNode.minimumX[k], childNode.minimumY[k], childNode.minimumZ[k]));
+                    childBox.maximum = glm::max(childBox.maximum, glm::vec3(childNode.maximumX[k], childNode.maximumY[k], childNode.maximumZ[k]));
+                }
+            }
+
+            node.minimumX[j] = childBox.minimum.x;
+            node.minimumY[j] = childBox.minimum.y;
+            node.minimumZ[j] = childBox.minimum.z;
+            node.maximumX[j] = childBox.maximum.x;
+            node.maximumY[j] = childBox.maximum.y;
+            node.maximumZ[j] = childBox.maximum.z;
+        }
+    }
+}
+
+void BoundingVolumeHierarchy::Hierarchy::cullHierarchy(const glm::vec4 frustumPlanes[], uint32_t frustumCount, std::vector<uint32_t>& visibleInstances) const
+{
+    if (this->nodes.empty() == true) {
+        return;
+    }
+
+    const uint32_t insideNodeFlag = 0x80000000;  // the node is entirely inside of a frustum, its subtree is visible without testing.
+
+    std::vector<uint32_t> nodeStack = {0};
+    nodeStack.reserve(64);
+    while (nodeStack.empty() == false) {
+        uint32_t stackEntry = nodeStack.back();
+        nodeStack.pop_back();
+
+        const BoundingVolumeHierarchy::WideNode& node = this->nodes[stackEntry & ~insideNodeFlag];
+        uint32_t childMask = ((1u << node.childCount) - 1);
+
+        uint32_t visibleMask = 0;
+        uint32_t insideMask = 0;
+        if ((stackEntry & insideNodeFlag) != 0) {
+            visibleMask = childMask;
+            insideMask = childMask;
+        } else {
+            for (uint32_t i = 0; i < frustumCount; i += 1) {
+                uint32_t frustumVisibleMask;
+                uint32_t frustumInsideMask;
+                BoundingVolumeHierarchy::testChildBounds(node, &frustumPlanes[i * 6], frustumVisibleMask, frustumInsideMask);
+
+                visibleMask |= frustumVisibleMask;
+                insideMask |= frustumInsideMask;
+            }
+            visibleMask &= childMask;
+            insideMask &= childMask;
+        }
+
+        for (uint32_t i = 0; i < node.childCount; i += 1) {
+            uint32_t childBit = (1u << i);
+            if ((visibleMask & childBit) == 0) {
+                continue;
+            }
+
+            if ((node.leafMask & childBit) != 0) {
+                visibleInstances.push_back(node.childIndices[i]);
+            } else {
+                nodeStack.push_back(node.childIndices[i] | (((insideMask & childBit) != 0) ? insideNodeFlag : 0));
+            }
+        }
+    }
+}
+
+void BoundingVolumeHierarchy::CullingScene::resetCullingScene()
+{
+    this->staticHierarchy.buildHierarchy(this->instanceBoxes, 0, 0);
+    this->dynamicHierarchy.buildHierarchy(this->instanceBoxes, 0, 0);
+
+    this->instanceBoxes.clear();
+}
+
+void BoundingVolumeHierarchy::CullingScene::updateCullingScene(const Uniform::CullingInstance instances[], uint32_t instanceCount, uint32_t staticInstanceCount)
+{
+    uint32_t dynamicInstanceCount = (instanceCount - staticInstanceCount);
+    bool staticInstancesChanged = (this->staticHierarchy.instanceCount != staticInstanceCount) || (this->instanceBoxes.size() < staticInstanceCount);
+    bool dynamicInstancesChanged = (this->dynamicHierarchy.firstInstance != staticInstanceCount) || (this->dynamicHierarchy.instanceCount != dynamicInstanceCount);
+
+    this->instanceBoxes.resize(instanceCount);
+
+    if (staticInstancesChanged == true) {
+        for (uint32_t i = 0; i < staticInstanceCount; i += 1) {
+            BoundingVolumeHierarchy::calculateInstanceBox(instances[i], this->instanceBoxes[i]);
+        }
+        this->staticHierarchy.buildHierarchy(this->instanceBoxes, 0, staticInstanceCount);
+    }
+
+    for (uint32_t i = staticInstanceCount; i < instanceCount; i += 1) {  // dynamic instances move every frame.
+        BoundingVolumeHierarchy::calculateInstanceBox(instances[i], this->instanceBoxes[i]);
+    }
+    if (dynamicInstancesChanged == true) {
+        this->dynamicHierarchy.buildHierarchy(this->instanceBoxes, staticInstanceCount, dynamicInstanceCount);
+    } else {
+        this->dynamicHierarchy.refitHierarchy(this->instanceBoxes);
+    }
+}
+
+void BoundingVolumeHierarchy::CullingScene::cullCullingScene(const glm::vec4 frustumPlanes[], uint32_t frustumCount, std::vector<uint32_t>& visibleInstances) const
+{
+    visibleInstances.clear();
+
+    this->staticHierarchy.cullHierarchy(frustumPlanes, frustumCount, visibleInstances);
+    this->dynamicHierarchy.cullHierarchy(frustumPlanes, frustumCount, visibleInstances);
+}
+
+void BoundingVolumeHierarchy::calculateInstanceBox(const Uniform::CullingInstance& instance, BoundingVolumeHierarchy::AxisAlignedBox& instanceBox)
+{
+    // the world space sphere, scaled by the largest axis scale to stay conservative under non-uniform scaling(identical to the culling shader).
+    glm::vec3 worldSpaceCenter = glm::vec3(instance.modelMatrix * glm::vec4(glm::vec3(instance.boundingSphere), 1.0f));
+    float largestScale = std::max({glm::length(glm::vec3(instance.modelMatrix[0])), glm::length(glm::vec3(instance.modelMatrix[1])), glm::length(glm::vec3(instance.modelMatrix[2]))});
+    float worldSpaceRadius = (instance.boundingSphere.w * largestScale);
+
+    instanceBox.minimum = (worldSpaceCenter - glm::vec3(worldSpaceRadius));
+    instanceBox.maximum = (worldSpaceCenter + glm::vec3(worldSpaceRadius));
+}
+
+void BoundingVolumeHierarchy::testChildBounds(const BoundingVolumeHierarchy::WideNode& node, const glm::vec4 frustumPlanes[6], uint32_t& visibleMask, uint32_t& insideMask)
+{
+    // a box is outside of a plane if its corner furthest along the plane's normal is behind it, and inside if its nearest corner is in front of it.
+#if defined(__AVX__)
+    __m256 minimumX = _mm256_load_ps(node.minimumX);
+    __m256 minimumY = _mm256_load_ps(node.minimumY);
+    __m256 minimumZ = _mm256_load_ps(node.minimumZ);
+    __m256 maximumX = _mm256_load_ps(node.maximumX);
+    __m256 maximumY = _mm256_load_ps(node.maximumY);
+    __m256 maximumZ = _mm256_load_ps(node.maximumZ);
+    __m256 zero = _mm256_setzero_ps();
+
+    int outsideBits = 0;
+    int insideBits = 0xFF;
+    for (uint32_t i = 0; i < 6; i += 1) {
+        const glm::vec4& frustumPlane = frustumPlanes[i];
+        __m256 planeX = _mm256_set1_ps(frustumPlane.x);
+        __m256 planeY = _mm256_set1_ps(frustumPlane.y);
+        __m256 planeZ = _mm256_set1_ps(frustumPlane.z);
+        __m256 planeW = _mm256_set1_ps(frustumPlane.w);
+
+        __m256 furthestDistance = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(planeX, ((frustumPlane.x >= 0.0f) ? maximumX : minimumX)), _mm256_mul_ps(planeY, ((frustumPlane.y >= 0.0f) ? maximumY : minimumY))), _mm256_add_ps(_mm256_mul_ps(planeZ, ((frustumPlane.z >= 0.0f) ? maximumZ : minimumZ)), planeW));
+        __m256 nearestDistance = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(planeX, ((frustumPlane.x >= 0.0f) ? minimumX : maximumX)), _mm256_mul_ps(planeY, ((frustumPlane.y >= 0.0f) ? minimumY : maximumY))), _mm256_add_ps(_mm256_mul_ps(planeZ, ((frustumPlane.z >= 0.0f) ? minimumZ : maximumZ)), planeW));
+
+        outsideBits |= _mm256_movemask_ps(_mm256_cmp_ps(furthestDistance, zero, _CMP_LT_OQ));
+        insideBits &= _mm256_movemask_ps(_mm256_cmp_ps(nearestDistance, zero, _CMP_GE_OQ));
+    }
+
+    visibleMask = static_cast<uint32_t>(~outsideBits & 0xFF);
+    insideMask = static_cast<uint32_t>(insideBits);
+#elif defined(__SSE__)
+    __m128 minimumX = _mm_load_ps(node.minimumX);
+    __m128 minimumY = _mm_load_ps(node.minimumY);
+    __m128 minimumZ = _mm_load_ps(node.minimumZ);
+    __m128 maximumX = _mm_load_ps(node.maximumX);
+    __m128 maximumY = _mm_load_ps(node.maximumY);
+    __m128 maximumZ = _mm_load_ps(node.maximumZ);
+    __m128 zero = _mm_setzero_ps();
+
+    int outsideBits = 0;
+    int insideBits = 0xF;
+    for (uint32_t i = 0; i < 6; i += 1) {
+        const glm::vec4& frustumPlane = frustumPlanes[i];
+        __m128 planeX = _mm_set1_ps(frustumPlane.x);
+        __m128 planeY = _mm_set1_ps(frustumPlane.y);
+        __m128 planeZ = _mm_set1_ps(frustumPlane.z);
+        __m128 planeW = _mm_set1_ps(frustumPlane.w);
+
+        __m128 furthestDistance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(planeX, ((frustumPlane.x >= 0.0f) ? maximumX : minimumX)), _mm_mul_ps(planeY, ((frustumPlane.y >= 0.0f) ? maximumY : minimumY))), _mm_add_ps(_mm_mul_ps(planeZ, ((frustumPlane.z >= 0.0f) ? maximumZ : minimumZ)), planeW));
+        __m128 nearestDistance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(planeX, ((frustumPlane.x >= 0.0f) ? minimumX : maximumX)), _mm_mul_ps(planeY, ((frustumPlane.y >= 0.0f) ? minimumY : maximumY))), _mm_add_ps(_mm_mul_ps(planeZ, ((frustumPlane.z >= 0.0f) ? minimumZ : maximumZ)), planeW));
+
+        outsideBits |= _mm_movemask_ps(_mm_cmplt_ps(furthestDistance, zero));
+        insideBits &= _mm_movemask_ps(_mm_cmpge_ps(nearestDistance, zero));
+    }
+
+    visibleMask = static_cast<uint32_t>(~outsideBits & 0xF);
+    insideMask = static_cast<uint32_t>(insideBits);
+#else
+    visibleMask = 0;
+    insideMask = 0;
+    for (uint32_t i = 0; i < BoundingVolumeHierarchy::nodeWidth; i += 1) {
+        glm::vec3 boxMinimum = glm::vec3(node.minimumX[i], node.minimumY[i], node.minimumZ[i]);
+        glm::vec3 boxMaximum = glm::vec3(node.maximumX[i], node.maximumY[i], node.maximumZ[i]);
+
+        bool boxOutside = false;
+        bool boxInside = true;
+        for (uint32_t j = 0; j < 6; j += 1) {
+            glm::vec3 planeNormal = glm::vec3(frustumPlanes[j]);
+            glm::vec3 furthestCorner = glm::mix(boxMinimum, boxMaximum, glm::greaterThanEqual(planeNormal, glm::vec3(0.0f)));
+            glm::vec3 nearestCorner = glm::mix(boxMaximum, boxMinimum, glm::greaterThanEqual(planeNormal, glm::vec3(0.0f)));
+
+            boxOutside = boxOutside || ((glm::dot(planeNormal, furthestCorner) + frustumPlanes[j].w) < 0.0f);
+            boxInside = boxInside && ((glm::dot(planeNormal, nearestCorner) + frustumPlanes[j].w) >= 0.0f);
+        }
+
+        visibleMask |= ((boxOutside == false) ? (1u << i) : 0);
+        insideMask |= ((boxInside == true) ? (1u << i) : 0);
+    }
+#endif
+}
+
+void BoundingVolumeHierarchy::benchmarkCullingScene(uint32_t instanceCount)
+{
+    std::mt19937 randomGenerator(1);  // a fixed seed keeps the benchmark comparable between runs.
+    std::uniform_real_distribution<float> positionDistribution(-500.0f, 500.0f);
+    std::uniform_real_distribution<float> radiusDistribution(0.5f, 2.0f);
+
+    std::vector<Uniform::CullingInstance> instances(instanceCount);
+    for (Uniform::CullingInstance& instance : instances) {
+        instance.modelMatrix = glm::translate(glm::mat4(1.0f), glm::vec3(positionDistribution(randomGenerator), positionDistribution(randomGenerator), positionDistribution(randomGenerator)));
+        instance.boundingSphere = glm::vec4(glm::vec3(0.0f), radiusDistribution(randomGenerator));
+    }
+    uint32_t staticInstanceCount = (instanceCount / 2);
+
+    glm::mat4 projectionMatrix = glm::perspective(glm::radians(45.0f), (16.0f / 9.0f), 0.1f, 1000.0f);
+    glm::mat4 viewMatrix = glm::lookAt(glm::vec3(0.0f, 0.0f, -600.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    glm::vec4 frustumPlanes[6];
+    Uniform::extractFrustumPlanes((projectionMatrix * viewMatrix), frustumPlanes);
+
+    auto measureMilliseconds = [](std::function<void()> measuredFunction) {
+        std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+        measuredFunction();
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    };
+    const uint32_t iterationCount = 100;
+
+
+    BoundingVolumeHierarchy::CullingScene cullingScene;
+    cullingScene.resetCullingScene();
+    double buildMilliseconds = measureMilliseconds([&]() { cullingScene.updateCullingScene(instances.data(), instanceCount, staticInstanceCount); });
+
+    double refitMilliseconds = 0.0;
+    for (uint32_t i = 0; i < iterationCount; i += 1) {
+        for (uint32_t j = staticInstanceCount; j < instanceCount; j += 1) {  // every dynamic instance moves a little each frame.
+            instances[j].modelMatrix[3].x += ((j % 2 == 0) ? 0.1f : -0.1f);
+        }
+        refitMilliseconds += measureMilliseconds([&]() { cullingScene.updateCullingScene(instances.data(), instanceCount, staticInstanceCount); });
+    }
+
+    std::vector<uint32_t> visibleInstances;
+    double cullMilliseconds = 0.0;
+    for (uint32_t i = 0; i < iterationCount; i += 1) {
+        cullMilliseconds += measureMilliseconds([&]() { cullingScene.cullCullingScene(frustumPlanes, 1, visibleInstances); });
+    }
+
+    // every instance's bounds tested one by one, the baseline the hierarchy is compared against.
+    uint32_t bruteForceVisibleCount = 0;
+    double bruteForceMilliseconds = 0.0;
+    for (uint32_t i = 0; i < iterationCount; i += 1) {
+        bruteForceMilliseconds += measureMilliseconds([&]() {
+            bruteForceVisibleCount = 0;
+            for (const BoundingVolumeHierarchy::AxisAlignedBox& instanceBox : cullingScene.instanceBoxes) {
+                bool instanceVisible = std::none_of(std::begin(frustumPlanes), std::end(frustumPlanes), [&](const glm::vec4& frustumPlane) {
+                    glm::vec3 furthestCorner = glm::mix(instanceBox.minimum, instanceBox.maximum, glm::greaterThanEqual(glm::vec3(frustumPlane), glm::vec3(0.0f)));
+                    return (glm::dot(glm::vec3(frustumPlane), furthestCorner) + frustumPlane.w) < 0.0f;
+                });
+                bruteForceVisibleCount += ((instanceVisible == true) ? 1 : 0);
+            }
+        });
+    }
+
+    std::cout << "culling benchmark, " << instanceCount << " instances(" << BoundingVolumeHierarchy::nodeWidth << " wide nodes): ";
+    std::cout << "build " << buildMilliseconds << " ms, refit " << (refitMilliseconds / iterationCount) << " ms, ";
+    std::cout << "cull " << (cullMilliseconds / iterationCount) << " ms(" << visibleInstances.size() << " visible), ";
+    std::cout << "brute force cull " << (bruteForceMilliseconds / iterationCount) << " ms(" << bruteForceVisibleCount << " visible)" << std::endl;
+}
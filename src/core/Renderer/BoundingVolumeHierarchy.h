@@ -0,0 +1,121 @@
+#ifndef BOUNDINGVOLUMEHIERARCHY_H
+#define BOUNDINGVOLUMEHIERARCHY_H
+
+
+#include <glm/glm.hpp>
+
+#include <core/Shader/Uniform.h>
+
+#include <vector>
+#include <cstdint>
+
+
+namespace BoundingVolumeHierarchy
+{
+#if defined(__AVX__)
+    const uint32_t nodeWidth = 8;  // the children of a node, their bounds are tested together in one AVX test.
+#else
+    const uint32_t nodeWidth = 4;  // the children of a node, their bounds are tested together in one SSE test(a scalar loop without SSE).
+#endif
+
+    struct AxisAlignedBox {
+        glm::vec3 minimum;
+        glm::vec3 maximum;
+    };
+
+    struct WideNode {  // the children's bounds are stored per axis, each axis is loaded as one SIMD register.
+        alignas(32) float minimumX[BoundingVolumeHierarchy::nodeWidth];
+        alignas(32) float minimumY[BoundingVolumeHierarchy::nodeWidth];
+        alignas(32) float minimumZ[BoundingVolumeHierarchy::nodeWidth];
+        alignas(32) float maximumX[BoundingVolumeHierarchy::nodeWidth];
+        alignas(32) float maximumY[BoundingVolumeHierarchy::nodeWidth];
+        alignas(32) float maximumZ[BoundingVolumeHierarchy::nodeWidth];
+
+        uint32_t childIndices[BoundingVolumeHierarchy::nodeWidth];  // the child node, or the instance of a leaf child.
+        uint32_t leafMask;  // the children that are leaves(single instances).
+        uint32_t childCount;
+    };
+
+    struct Hierarchy {  // a wide bounding volume hierarchy over a range of instances, every leaf is a single instance.
+        std::vector<BoundingVolumeHierarchy::WideNode> nodes;  // the root node is at index 0, children always follow their parent.
+        uint32_t firstInstance;
+        uint32_t instanceCount;
+
+
+        // build the hierarchy over a range of instances, splitting each node's instances at the median of their longest axis.
+        //
+        // @param instanceBoxes the world space bounds of every instance.
+        // @param firstInstance the first instance of the range.
+        // @param instanceCount the amount of instances in the range.
+        void buildHierarchy(const std::vector<BoundingVolumeHierarchy::AxisAlignedBox>& instanceBoxes, uint32_t firstInstance, uint32_t instanceCount);
+
+        // build the subtree of a range of instances.
+        //
+        // @param instanceBoxes the world space bounds of every instance.
+        // @param instanceIndices the instances being built, reordered by the median splits.
+        // @param rangeBegin the first instance index of the subtree.
+        // @param rangeEnd the instance index after the subtree's last instance.
+        // @return the index of the subtree's root node.
+        uint32_t buildNode(const std::vector<BoundingVolumeHierarchy::AxisAlignedBox>& instanceBoxes, std::vector<uint32_t>& instanceIndices, uint32_t rangeBegin, uint32_t rangeEnd);
+
+        // refit the bounds of every node to moved instances, keeping the hierarchy's topology.
+        //
+        // @param instanceBoxes the world space bounds of every instance.
+        void refitHierarchy(const std::vector<BoundingVolumeHierarchy::AxisAlignedBox>& instanceBoxes);
+
+        // cull the hierarchy's instances against a set of frustums, an instance is visible if it intersects any frustum.
+        //
+        // @param frustumPlanes the six planes of each frustum(see Uniform::extractFrustumPlanes).
+        // @param frustumCount the amount of frustums.
+        // @param visibleInstances the visible instances, appended to.
+        void cullHierarchy(const glm::vec4 frustumPlanes[], uint32_t frustumCount, std::vector<uint32_t>& visibleInstances) const;
+    };
+
+    struct CullingScene {  // static instances are built into their own hierarchy once, dynamic instances are refit every frame.
+        BoundingVolumeHierarchy::Hierarchy staticHierarchy;  // the instances before the first dynamic instance.
+        BoundingVolumeHierarchy::Hierarchy dynamicHierarchy;
+
+        std::vector<BoundingVolumeHierarchy::AxisAlignedBox> instanceBoxes;
+
+
+        // reset the culling scene, rebuilding both hierarchies on the next update.
+        void resetCullingScene();
+
+        // update the culling scene's hierarchies to the frame's instances.
+        //
+        // @param instances the frame's instances, static instances first.
+        // @param instanceCount the amount of instances.
+        // @param staticInstanceCount the amount of static instances, the static hierarchy is only rebuilt when it changes.
+        void updateCullingScene(const Uniform::CullingInstance instances[], uint32_t instanceCount, uint32_t staticInstanceCount);
+
+        // cull the culling scene's instances against a set of frustums.
+        //
+        // @param frustumPlanes the six planes of each frustum(see Uniform::extractFrustumPlanes).
+        // @param frustumCount the amount of frustums.
+        // @param visibleInstances the visible instances.
+        void cullCullingScene(const glm::vec4 frustumPlanes[], uint32_t frustumCount, std::vector<uint32_t>& visibleInstances) const;
+    };
+
+
+    // calculate the world space bounds of an instance's bounding sphere.
+    //
+    // @param instance the instance.
+    // @param instanceBox the instance's world space bounds.
+    void calculateInstanceBox(const Uniform::CullingInstance& instance, BoundingVolumeHierarchy::AxisAlignedBox& instanceBox);
+
+    // test a node's children against a frustum.
+    //
+    // @param node the node whose children are tested.
+    // @param frustumPlanes the six planes of the frustum.
+    // @param visibleMask the children intersecting the frustum.
+    // @param insideMask the children entirely inside of the frustum.
+    void testChildBounds(const BoundingVolumeHierarchy::WideNode& node, const glm::vec4 frustumPlanes[6], uint32_t& visibleMask, uint32_t& insideMask);
+
+    // benchmark building, refitting, and culling a synthetic scene, reporting the timings to the standard output.
+    //
+    // @param instanceCount the amount of synthetic instances, half of them dynamic.
+    void benchmarkCullingScene(uint32_t instanceCount);
+}
+
+
+#endif  // BOUNDINGVOLUMEHIERARCHY_H
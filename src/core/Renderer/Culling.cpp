@@ -0,0 +1,261 @@
+#define GLFW_INCLUDE_VULKAN
+#include <GLFW/glfw3.h>
+
+#include <core/Renderer/Culling.h>
+#include <core/Renderer/Renderer.h>
+#include <core/Shader/Shader.h>
+#include <core/Shader/Uniform.h>
+#include <core/Shader/ResourceDescriptor.h>
+#include <core/Command/CommandManager.h>
+#include <core/Buffer/Buffer.h>
+#include <core/Logging/ErrorLogger.h>
+#include <core/Defaults/Defaults.h>
+
+#include <vector>
+#include <optional>
+#include <cstring>
+
+
+void Culling::CullingOperation::generateMemberComponents(uint32_t maxInstanceCount, VkCommandPool commandPool, VkQueue commandQueue, DeviceHandler::VulkanDevices vulkanDevices)
+{
+    this->maxInstanceCount = maxInstanceCount;
+
+
+    VkDescriptorSetLayoutBinding cullingUniformBufferLayoutBinding{};
+    ResourceDescriptor::populateDescriptorSetLayoutBinding(0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT, cullingUniformBufferLayoutBinding);
+
+    VkDescriptorSetLayoutBinding cullingInstanceLayoutBinding{};
+    ResourceDescriptor::populateDescriptorSetLayoutBinding(1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT, cullingInstanceLayoutBinding);
+
+    VkDescriptorSetLayoutBinding cullingDrawCommandLayoutBinding{};
+    ResourceDescriptor::populateDescriptorSetLayoutBinding(2, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT, cullingDrawCommandLayoutBinding);
+
+    VkDescriptorSetLayoutBinding cullingDrawCountLayoutBinding{};
+    ResourceDescriptor::populateDescriptorSetLayoutBinding(3, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT, cullingDrawCountLayoutBinding);
+
+    VkDescriptorSetLayoutBinding cullingVisibilityLayoutBinding{};
+    ResourceDescriptor::populateDescriptorSetLayoutBinding(4, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT, cullingVisibilityLayoutBinding);
+
+    VkDescriptorSetLayoutBinding cullingDepthPyramidLayoutBinding{};
+    ResourceDescriptor::populateDescriptorSetLayoutBinding(5, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_COMPUTE_BIT, cullingDepthPyramidLayoutBinding);
+
+    std::vector<VkDescriptorSetLayoutBinding> cullingDescriptorSetLayoutBindings = {cullingUniformBufferLayoutBinding, cullingInstanceLayoutBinding, cullingDrawCommandLayoutBinding, cullingDrawCountLayoutBinding, cullingVisibilityLayoutBinding, cullingDepthPyramidLayoutBinding};
+    ResourceDescriptor::createDescriptorSetLayout(cullingDescriptorSetLayoutBindings, vulkanDevices.logicalDevice, this->pipelineComponents.descriptorSetLayout);
+
+    VkPushConstantRange cullingPhasePushConstant{};
+    Uniform::populatePushConstant(0, sizeof(uint32_t), VK_SHADER_STAGE_COMPUTE_BIT, cullingPhasePushConstant);
+    RendererDetails::createPipelineLayout(vulkanDevices.logicalDevice, this->pipelineComponents.descriptorSetLayout, &cullingPhasePushConstant, this->pipelineComponents.pipelineLayout);
+
+
+    Shader::Shader cullingComputeShader;
+    Shader::createShader((Defaults::applicationDefaults.SALAMANDER_ROOT_DIRECTORY + "/build/cullCompute.spv"), VK_SHADER_STAGE_COMPUTE_BIT, vulkanDevices.logicalDevice, cullingComputeShader);
+
+    VkComputePipelineCreateInfo computePipelineCreateInfo{};
+    computePipelineCreateInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+
+    computePipelineCreateInfo.stage = cullingComputeShader.shaderStageCreateInfo;
+    computePipelineCreateInfo.layout = this->pipelineComponents.pipelineLayout;
+
+    computePipelineCreateInfo.basePipelineHandle = VK_NULL_HANDLE;
+    computePipelineCreateInfo.basePipelineIndex = -1;
+
+    VkResult computePipelineCreationResult = vkCreateComputePipelines(vulkanDevices.logicalDevice, VK_NULL_HANDLE, 1, &computePipelineCreateInfo, nullptr, &this->pipelineComponents.pipeline);
+    if (computePipelineCreationResult != VK_SUCCESS) {
+        throwDebugException("Failed to create the culling compute pipeline.");
+    }
+
+    vkDestroyShaderModule(vulkanDevices.logicalDevice, cullingComputeShader.shaderModule, nullptr);
+
+
+    // instances are written by the CPU every frame, the draw streams are only written by the culling compute pass.
+    VkDeviceSize instanceBufferSize = (sizeof(Uniform::CullingInstance) * maxInstanceCount);
+    this->instanceBuffers.resize(Defaults::rendererDefaults.MAX_FRAMES_IN_FLIGHT);
+    this->instanceBuffersMemory.resize(Defaults::rendererDefaults.MAX_FRAMES_IN_FLIGHT);
+    this->mappedInstanceBuffersMemory.resize(Defaults::rendererDefaults.MAX_FRAMES_IN_FLIGHT);
+    for (size_t i = 0; i < Defaults::rendererDefaults.MAX_FRAMES_IN_FLIGHT; i += 1) {
+        Buffer::createBufferComponents(instanceBufferSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, (VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT), vulkanDevices, this->instanceBuffers[i], this->instanceBuffersMemory[i]);
+
+        vkMapMemory(vulkanDevices.logicalDevice, this->instanceBuffersMemory[i], 0, instanceBufferSize, 0, &this->mappedInstanceBuffersMemory[i]);
+    }
+
+    // the draw streams are shared by the frames in flight, the render graph orders each frame's culling after the previous frame's draws.
+    Buffer::createBufferComponents((sizeof(VkDrawIndexedIndirectCommand) * maxInstanceCount * Uniform::cullingStreamCount * 2), (VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT), VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, vulkanDevices, this->drawCommandBuffer, this->drawCommandBufferMemory);
+    Buffer::createBufferComponents((sizeof(uint32_t) * (Uniform::cullingStreamCount + 1)), (VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT), VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, vulkanDevices, this->drawCountBuffer, this->drawCountBufferMemory);
+
+    // every instance starts invisible, the late main pass draws the instances the early main pass missed.
+    Buffer::createBufferComponents((sizeof(uint32_t) * maxInstanceCount), (VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT), VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, vulkanDevices, this->visibilityBuffer, this->visibilityBufferMemory);
+
+    VkCommandBuffer disposableCommandBuffer;
+    CommandManager::beginRecordingSingleSubmitCommands(commandPool, vulkanDevices.logicalDevice, disposableCommandBuffer);
+    vkCmdFillBuffer(disposableCommandBuffer, this->visibilityBuffer, 0, VK_WHOLE_SIZE, 0);
+    CommandManager::submitSingleSubmitCommands(disposableCommandBuffer, commandPool, commandQueue, vulkanDevices.logicalDevice);
+
+    // read by the CPU after the frame's fence, a frame in flight late.
+    this->occlusionStatisticsBuffers.resize(Defaults::rendererDefaults.MAX_FRAMES_IN_FLIGHT);
+    this->occlusionStatisticsBuffersMemory.resize(Defaults::rendererDefaults.MAX_FRAMES_IN_FLIGHT);
+    this->mappedOcclusionStatisticsBuffersMemory.resize(Defaults::rendererDefaults.MAX_FRAMES_IN_FLIGHT);
+    for (size_t i = 0; i < Defaults::rendererDefaults.MAX_FRAMES_IN_FLIGHT; i += 1) {
+        Buffer::createBufferComponents(sizeof(uint32_t), VK_BUFFER_USAGE_TRANSFER_DST_BIT, (VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT), vulkanDevices, this->occlusionStatisticsBuffers[i], this->occlusionStatisticsBuffersMemory[i]);
+
+        vkMapMemory(vulkanDevices.logicalDevice, this->occlusionStatisticsBuffersMemory[i], 0, sizeof(uint32_t), 0, &this->mappedOcclusionStatisticsBuffersMemory[i]);
+        memset(this->mappedOcclusionStatisticsBuffersMemory[i], 0, sizeof(uint32_t));
+    }
+
+
+    Uniform::createUniformBuffers(sizeof(Uniform::CullingUniformBufferObject), vulkanDevices, this->pipelineComponents.uniformBuffers, this->pipelineComponents.uniformBuffersMemory, this->pipelineComponents.mappedUniformBuffersMemory);
+    ResourceDescriptor::createDescriptorPool(1, 4, 0, vulkanDevices.logicalDevice, this->pipelineComponents.descriptorPool);
+    ResourceDescriptor::createDescriptorSets(this->pipelineComponents.descriptorSetLayout, this->pipelineComponents.descriptorPool, vulkanDevices.logicalDevice, this->pipelineComponents.descriptorSets);
+
+    VkDescriptorBufferInfo drawCommandDescriptorBufferInfo{};
+    ResourceDescriptor::populateDescriptorBufferInfo(this->drawCommandBuffer, 0, VK_WHOLE_SIZE, drawCommandDescriptorBufferInfo);
+    VkWriteDescriptorSet drawCommandWriteDescriptorSet{};
+    ResourceDescriptor::populateWriteDescriptorSet(nullptr, 2, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, nullptr, &drawCommandDescriptorBufferInfo, drawCommandWriteDescriptorSet);
+
+    VkDescriptorBufferInfo drawCountDescriptorBufferInfo{};
+    ResourceDescriptor::populateDescriptorBufferInfo(this->drawCountBuffer, 0, VK_WHOLE_SIZE, drawCountDescriptorBufferInfo);
+    VkWriteDescriptorSet drawCountWriteDescriptorSet{};
+    ResourceDescriptor::populateWriteDescriptorSet(nullptr, 3, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, nullptr, &drawCountDescriptorBufferInfo, drawCountWriteDescriptorSet);
+
+    VkDescriptorBufferInfo visibilityDescriptorBufferInfo{};
+    ResourceDescriptor::populateDescriptorBufferInfo(this->visibilityBuffer, 0, VK_WHOLE_SIZE, visibilityDescriptorBufferInfo);
+    VkWriteDescriptorSet visibilityWriteDescriptorSet{};
+    ResourceDescriptor::populateWriteDescriptorSet(nullptr, 4, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, nullptr, &visibilityDescriptorBufferInfo, visibilityWriteDescriptorSet);
+
+    std::vector<VkWriteDescriptorSet> cullingWriteDescriptorSets = {drawCommandWriteDescriptorSet, drawCountWriteDescriptorSet, visibilityWriteDescriptorSet};
+    ResourceDescriptor::populateDescriptorSets(this->pipelineComponents.uniformBuffers, cullingWriteDescriptorSets, vulkanDevices.logicalDevice, this->pipelineComponents.descriptorSets);
+    ResourceDescriptor::populateFrameStorageBufferDescriptors(1, this->instanceBuffers, vulkanDevices.logicalDevice, this->pipelineComponents.descriptorSets);
+}
+
+void Culling::CullingOperation::populateDepthPyramidDescriptors(VkSampler depthPyramidSampler, VkImageView depthPyramidImageView, VkDevice vulkanLogicalDevice)
+{
+    VkDescriptorImageInfo depthPyramidDescriptorImageInfo{};
+    ResourceDescriptor::populateDescriptorImageInfo(depthPyramidSampler, depthPyramidImageView, VK_IMAGE_LAYOUT_GENERAL, depthPyramidDescriptorImageInfo);
+
+    for (size_t i = 0; i < this->pipelineComponents.descriptorSets.size(); i += 1) {
+        VkWriteDescriptorSet depthPyramidWriteDescriptorSet{};
+        ResourceDescriptor::populateWriteDescriptorSet(this->pipelineComponents.descriptorSets[i], 5, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, &depthPyramidDescriptorImageInfo, nullptr, depthPyramidWriteDescriptorSet);
+
+        vkUpdateDescriptorSets(vulkanLogicalDevice, 1, &depthPyramidWriteDescriptorSet, 0, nullptr);
+    }
+}
+
+void Culling::CullingOperation::recordCullingCommands(uint32_t currentFrame, uint32_t instanceCount, VkCommandBuffer commandBuffer) const
+{
+    vkCmdFillBuffer(commandBuffer, this->drawCountBuffer, 0, VK_WHOLE_SIZE, 0);  // every stream starts empty, culled instances are appended atomically.
+
+    VkBufferMemoryBarrier drawCountBufferMemoryBarrier{};
+    drawCountBufferMemoryBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+
+    drawCountBufferMemoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    drawCountBufferMemoryBarrier.dstAccessMask = (VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT);
+
+    drawCountBufferMemoryBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    drawCountBufferMemoryBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+
+    drawCountBufferMemoryBarrier.buffer = this->drawCountBuffer;
+    drawCountBufferMemoryBarrier.offset = 0;
+    drawCountBufferMemoryBarrier.size = VK_WHOLE_SIZE;
+
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 0, nullptr, 1, &drawCountBufferMemoryBarrier, 0, nullptr);
+
+    if (instanceCount == 0) {
+        return;
+    }
+
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, this->pipelineComponents.pipeline);
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, this->pipelineComponents.pipelineLayout, 0, 1, &this->pipelineComponents.descriptorSets[currentFrame], 0, nullptr);
+
+    uint32_t cullingPhase = Culling::frustumCullingPhase;
+    vkCmdPushConstants(commandBuffer, this->pipelineComponents.pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(uint32_t), &cullingPhase);
+
+    vkCmdDispatch(commandBuffer, ((instanceCount + (Culling::cullingWorkgroupSize - 1)) / Culling::cullingWorkgroupSize), 1, 1);  // an invocation for each instance, culled against every stream.
+}
+
+void Culling::CullingOperation::recordLateCullingCommands(uint32_t currentFrame, uint32_t instanceCount, VkCommandBuffer commandBuffer) const
+{
+    if (instanceCount > 0) {
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, this->pipelineComponents.pipeline);
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, this->pipelineComponents.pipelineLayout, 0, 1, &this->pipelineComponents.descriptorSets[currentFrame], 0, nullptr);
+
+        uint32_t cullingPhase = Culling::occlusionCullingPhase;
+        vkCmdPushConstants(commandBuffer, this->pipelineComponents.pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(uint32_t), &cullingPhase);
+
+        vkCmdDispatch(commandBuffer, ((instanceCount + (Culling::cullingWorkgroupSize - 1)) / Culling::cullingWorkgroupSize), 1, 1);
+    }
+
+
+    // the occluded instance count is copied out before the next frame's culling resets it.
+    VkBufferMemoryBarrier occludedCountMemoryBarrier{};
+    occludedCountMemoryBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+
+    occludedCountMemoryBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    occludedCountMemoryBarrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+
+    occludedCountMemoryBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    occludedCountMemoryBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+
+    occludedCountMemoryBarrier.buffer = this->drawCountBuffer;
+    occludedCountMemoryBarrier.offset = (sizeof(uint32_t) * Culling::occludedInstanceCountIndex);
+    occludedCountMemoryBarrier.size = sizeof(uint32_t);
+
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 1, &occludedCountMemoryBarrier, 0, nullptr);
+
+    VkBufferCopy occludedCountCopy{};
+    occludedCountCopy.srcOffset = (sizeof(uint32_t) * Culling::occludedInstanceCountIndex);
+    occludedCountCopy.dstOffset = 0;
+    occludedCountCopy.size = sizeof(uint32_t);
+    vkCmdCopyBuffer(commandBuffer, this->drawCountBuffer, this->occlusionStatisticsBuffers[currentFrame], 1, &occludedCountCopy);
+
+    VkBufferMemoryBarrier occlusionStatisticsMemoryBarrier{};
+    occlusionStatisticsMemoryBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+
+    occlusionStatisticsMemoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    occlusionStatisticsMemoryBarrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+
+    occlusionStatisticsMemoryBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    occlusionStatisticsMemoryBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+
+    occlusionStatisticsMemoryBarrier.buffer = this->occlusionStatisticsBuffers[currentFrame];
+    occlusionStatisticsMemoryBarrier.offset = 0;
+    occlusionStatisticsMemoryBarrier.size = VK_WHOLE_SIZE;
+
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0, 0, nullptr, 1, &occlusionStatisticsMemoryBarrier, 0, nullptr);
+}
+
+uint32_t Culling::CullingOperation::fetchOccludedInstanceCount(uint32_t currentFrame) const
+{
+    uint32_t occludedInstanceCount;
+    memcpy(&occludedInstanceCount, this->mappedOcclusionStatisticsBuffersMemory[currentFrame], sizeof(uint32_t));
+
+    return occludedInstanceCount;
+}
+
+void Culling::CullingOperation::recordStreamDraw(uint32_t cullingStream, VkCommandBuffer commandBuffer) const
+{
+    VkDeviceSize drawCommandOffset = (sizeof(VkDrawIndexedIndirectCommand) * this->maxInstanceCount * cullingStream);
+    VkDeviceSize drawCountOffset = (sizeof(uint32_t) * (cullingStream % Uniform::maskedCullingStreamOffset));  // a masked stream is drawn with its opaque stream's draw count.
+
+    vkCmdDrawIndexedIndirectCount(commandBuffer, this->drawCommandBuffer, drawCommandOffset, this->drawCountBuffer, drawCountOffset, this->maxInstanceCount, sizeof(VkDrawIndexedIndirectCommand));
+}
+
+void Culling::CullingOperation::cleanupCullingOperation(VkDevice vulkanLogicalDevice)
+{
+    for (size_t i = 0; i < this->instanceBuffers.size(); i += 1) {
+        vkDestroyBuffer(vulkanLogicalDevice, this->instanceBuffers[i], nullptr);
+        vkFreeMemory(vulkanLogicalDevice, this->instanceBuffersMemory[i], nullptr);
+    }
+
+    vkDestroyBuffer(vulkanLogicalDevice, this->drawCommandBuffer, nullptr);
+    vkFreeMemory(vulkanLogicalDevice, this->drawCommandBufferMemory, nullptr);
+    vkDestroyBuffer(vulkanLogicalDevice, this->drawCountBuffer, nullptr);
+    vkFreeMemory(vulkanLogicalDevice, this->drawCountBufferMemory, nullptr);
+    vkDestroyBuffer(vulkanLogicalDevice, this->visibilityBuffer, nullptr);
+    vkFreeMemory(vulkanLogicalDevice, this->visibilityBufferMemory, nullptr);
+
+    for (size_t i = 0; i < this->occlusionStatisticsBuffers.size(); i += 1) {
+        vkDestroyBuffer(vulkanLogicalDevice, this->occlusionStatisticsBuffers[i], nullptr);
+        vkFreeMemory(vulkanLogicalDevice, this->occlusionStatisticsBuffersMemory[i], nullptr);
+    }
+
+    this->pipelineComponents.cleanupPipelineComponents(vulkanLogicalDevice);  // the compute pipeline is destroyed like a graphics pipeline.
+}
@@ -0,0 +1,96 @@
+#ifndef CULLING_H
+#define CULLING_H
+
+
+#define GLFW_INCLUDE_VULKAN
+#include <GLFW/glfw3.h>
+
+#include <core/Renderer/Pipeline.h>
+#include <core/Shader/Uniform.h>
+#include <core/VulkanInstance/DeviceHandler.h>
+
+#include <vector>
+#include <cstdint>
+
+
+namespace Culling
+{
+    const uint32_t cullingWorkgroupSize = 64;  // identical to the culling shader's local size.
+
+    // identical to the culling phase constants in the culling shader.
+    const uint32_t frustumCullingPhase = 0;  // culls every stream against its frustums, before the early main pass.
+    const uint32_t occlusionCullingPhase = 1;  // culls the scene instances against the depth pyramid, before the late main pass.
+
+    const uint32_t occludedInstanceCountIndex = Uniform::cullingStreamCount;  // the occluded instance count follows the draw counts in the draw count buffer.
+
+    struct CullingOperation {  // culls every instance on the GPU, writing a compacted indirect draw stream(and its draw count) for each culling stream.
+        Pipeline::PipelineComponents pipelineComponents;  // the compute pipeline, its uniform buffers hold the culling frustums.
+
+        std::vector<VkBuffer> instanceBuffers;  // the instance storage buffer of each frame in flight(see Uniform::CullingInstance).
+        std::vector<VkDeviceMemory> instanceBuffersMemory;
+        std::vector<void *> mappedInstanceBuffersMemory;
+
+        VkBuffer drawCommandBuffer;  // every culling stream's draw commands followed by every stream's masked draw commands, each stream is maxInstanceCount commands long.
+        VkDeviceMemory drawCommandBufferMemory;
+        VkBuffer drawCountBuffer;  // the draw count of each culling stream, followed by the amount of occluded instances.
+        VkDeviceMemory drawCountBufferMemory;
+        VkBuffer visibilityBuffer;  // if each instance passed last frame's occlusion test, the early main pass only draws these instances.
+        VkDeviceMemory visibilityBufferMemory;
+
+        std::vector<VkBuffer> occlusionStatisticsBuffers;  // the occluded instance count of each frame in flight, copied from the draw count buffer.
+        std::vector<VkDeviceMemory> occlusionStatisticsBuffersMemory;
+        std::vector<void *> mappedOcclusionStatisticsBuffersMemory;
+
+        uint32_t maxInstanceCount;
+
+
+        // generate the member culling operation components.
+        //
+        // @param maxInstanceCount the maximum amount of culled instances.
+        // @param commandPool the command pool to use in the visibility buffer's initial fill.
+        // @param commandQueue the queue to use in the visibility buffer's initial fill.
+        // @param vulkanDevices Vulkan physical and logical device to use in member components generation.
+        void generateMemberComponents(uint32_t maxInstanceCount, VkCommandPool commandPool, VkQueue commandQueue, DeviceHandler::VulkanDevices vulkanDevices);
+
+        // populate the depth pyramid descriptor of each frame's descriptor set, after every depth pyramid generation.
+        //
+        // @param depthPyramidSampler the sampler of the depth pyramid.
+        // @param depthPyramidImageView the view of every depth pyramid level.
+        // @param vulkanLogicalDevice Vulkan logical device to use in descriptor updating.
+        void populateDepthPyramidDescriptors(VkSampler depthPyramidSampler, VkImageView depthPyramidImageView, VkDevice vulkanLogicalDevice);
+
+        // record the culling commands, resetting the draw counts and dispatching the frustum culling phase.
+        //
+        // @param currentFrame the current frame in flight, selecting the instance and uniform buffers.
+        // @param instanceCount the amount of instances to cull.
+        // @param commandBuffer the command buffer to record in.
+        void recordCullingCommands(uint32_t currentFrame, uint32_t instanceCount, VkCommandBuffer commandBuffer) const;
+
+        // record the late culling commands, dispatching the occlusion culling phase and copying the occluded instance count to the frame's statistics buffer.
+        //
+        // @param currentFrame the current frame in flight, selecting the instance, uniform, and statistics buffers.
+        // @param instanceCount the amount of instances to cull.
+        // @param commandBuffer the command buffer to record in.
+        void recordLateCullingCommands(uint32_t currentFrame, uint32_t instanceCount, VkCommandBuffer commandBuffer) const;
+
+        // fetch the amount of occluded instances culled the last time a frame in flight was rendered.
+        //
+        // @param currentFrame the frame in flight, its previous submission must be complete.
+        // @return the amount of occluded instances.
+        uint32_t fetchOccludedInstanceCount(uint32_t currentFrame) const;
+
+        // record an indirect draw of a culling stream's draw commands.
+        //
+        // @param cullingStream the culling stream to draw(see the Uniform culling stream constants), offset by Uniform::maskedCullingStreamOffset to draw its masked draws.
+        // @param commandBuffer the command buffer to record in.
+        void recordStreamDraw(uint32_t cullingStream, VkCommandBuffer commandBuffer) const;
+
+        // cleanup the culling operation.
+        //
+        // @param vulkanLogicalDevice Vulkan logical device to use in culling operation cleanup.
+        void cleanupCullingOperation(VkDevice vulkanLogicalDevice);
+    };
+}
+
+
+#endif  // CULLING_H
@@ -0,0 +1,226 @@
+#define GLFW_INCLUDE_VULKAN
+#include <GLFW/glfw3.h>
+
+#include <core/Renderer/DepthPyramid.h>
+#include <core/Renderer/Renderer.h>
+#include <core/Shader/Shader.h>
+#include <core/Shader/Uniform.h>
+#include <core/Shader/Image.h>
+#include <core/Shader/ResourceDescriptor.h>
+#include <core/Logging/ErrorLogger.h>
+#include <core/Defaults/Defaults.h>
+
+#include <utils/MathUtils.h>
+
+#include <string>
+#include <vector>
+#include <algorithm>
+
+
+void DepthPyramid::DepthPyramidOperation::generateMemberComponents(VkSampleCountFlagBits msaaSampleCount, DeviceHandler::VulkanDevices vulkanDevices)
+{
+    VkDescriptorSetLayoutBinding depthImageLayoutBinding{};
+    ResourceDescriptor::populateDescriptorSetLayoutBinding(0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_COMPUTE_BIT, depthImageLayoutBinding);
+
+    VkDescriptorSetLayoutBinding depthPyramidLayoutBinding{};
+    ResourceDescriptor::populateDescriptorSetLayoutBinding(1, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_COMPUTE_BIT, depthPyramidLayoutBinding);
+
+    VkDescriptorSetLayoutBinding reducedLevelLayoutBinding{};
+    ResourceDescriptor::populateDescriptorSetLayoutBinding(2, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, VK_SHADER_STAGE_COMPUTE_BIT, reducedLevelLayoutBinding);
+
+    std::vector<VkDescriptorSetLayoutBinding> reductionDescriptorSetLayoutBindings = {depthImageLayoutBinding, depthPyramidLayoutBinding, reducedLevelLayoutBinding};
+    ResourceDescriptor::createDescriptorSetLayout(reductionDescriptorSetLayoutBindings, vulkanDevices.logicalDevice, this->pipelineComponents.descriptorSetLayout);
+
+    VkPushConstantRange reductionPushConstant{};
+    Uniform::populatePushConstant(0, sizeof(DepthPyramid::ReductionPushConstant), VK_SHADER_STAGE_COMPUTE_BIT, reductionPushConstant);
+    RendererDetails::createPipelineLayout(vulkanDevices.logicalDevice, this->pipelineComponents.descriptorSetLayout, &reductionPushConstant, this->pipelineComponents.pipelineLayout);
+
+
+    // multisampled depth is fetched per sample, keeping the farthest sample.
+    std::string reductionShaderName = (msaaSampleCount == VK_SAMPLE_COUNT_1_BIT ? "depthPyramidCompute.spv" : "depthPyramidMultisampledCompute.spv");
+    Shader::Shader reductionComputeShader;
+    Shader::createShader((Defaults::applicationDefaults.SALAMANDER_ROOT_DIRECTORY + "/build/" + reductionShaderName), VK_SHADER_STAGE_COMPUTE_BIT, vulkanDevices.logicalDevice, reductionComputeShader);
+
+    VkComputePipelineCreateInfo computePipelineCreateInfo{};
+    computePipelineCreateInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+
+    computePipelineCreateInfo.stage = reductionComputeShader.shaderStageCreateInfo;
+    computePipelineCreateInfo.layout = this->pipelineComponents.pipelineLayout;
+
+    computePipelineCreateInfo.basePipelineHandle = VK_NULL_HANDLE;
+    computePipelineCreateInfo.basePipelineIndex = -1;
+
+    VkResult computePipelineCreationResult = vkCreateComputePipelines(vulkanDevices.logicalDevice, VK_NULL_HANDLE, 1, &computePipelineCreateInfo, nullptr, &this->pipelineComponents.pipeline);
+    if (computePipelineCreationResult != VK_SUCCESS) {
+        throwDebugException("Failed to create the depth pyramid compute pipeline.");
+    }
+
+    vkDestroyShaderModule(vulkanDevices.logicalDevice, reductionComputeShader.shaderModule, nullptr);
+
+
+    Image::createShadowSampler(VK_FILTER_NEAREST, VK_FALSE, vulkanDevices.logicalDevice, this->pyramidSampler);  // texel fetches ignore the sampler's filtering.
+    this->pipelineComponents.descriptorPool = VK_NULL_HANDLE;  // created with the pyramid image, the level count depends on the depth extent.
+}
+
+void DepthPyramid::DepthPyramidOperation::generatePyramidImage(VkImageView depthImageView, VkExtent2D depthExtent, DeviceHandler::VulkanDevices vulkanDevices)
+{
+    this->depthExtent = depthExtent;
+
+    // each level is exactly half of the previous one, only the first level covers an uneven amount of depth texels.
+    uint32_t pyramidWidth = MathUtils::floorPowerOfTwo(depthExtent.width);
+    uint32_t pyramidHeight = MathUtils::floorPowerOfTwo(depthExtent.height);
+    this->levelCount = 1;
+    while ((std::max(pyramidWidth, pyramidHeight) >> this->levelCount) > 0) {
+        this->levelCount += 1;
+    }
+
+    Image::populateImageDetails(pyramidWidth, pyramidHeight, this->levelCount, 1, VK_SAMPLE_COUNT_1_BIT, VK_FORMAT_R32_SFLOAT, VK_IMAGE_TILING_OPTIMAL, (VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT), VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, vulkanDevices, this->pyramidImageDetails);
+    this->pyramidImageDetails.mipmapLevels = this->levelCount;
+    this->pyramidImageDetails.imageLayerCount = 1;
+    this->pyramidImageDetails.imageLayout = VK_IMAGE_LAYOUT_GENERAL;  // transitioned by the render graph before the first reduction.
+
+    Image::createImageView(this->pyramidImageDetails.image, VK_FORMAT_R32_SFLOAT, this->levelCount, 1, VK_IMAGE_ASPECT_COLOR_BIT, vulkanDevices.logicalDevice, this->pyramidImageDetails.imageView);
+
+    this->levelImageViews.resize(this->levelCount);
+    for (uint32_t i = 0; i < this->levelCount; i += 1) {
+        VkImageViewCreateInfo levelImageViewCreateInfo{};
+        Image::populateImageViewCreateInfo(this->pyramidImageDetails.image, VK_IMAGE_VIEW_TYPE_2D, VK_FORMAT_R32_SFLOAT, VK_IMAGE_ASPECT_COLOR_BIT, i, 1, 0, 1, levelImageViewCreateInfo);
+
+        VkResult levelImageViewCreationResult = vkCreateImageView(vulkanDevices.logicalDevice, &levelImageViewCreateInfo, nullptr, &this->levelImageViews[i]);
+        if (levelImageViewCreationResult != VK_SUCCESS) {
+            throwDebugException("Failed to create a depth pyramid level image view.");
+        }
+    }
+
+
+    // a descriptor set for each level, only the reduced level differs.
+    VkDescriptorPoolSize combinedSamplerPoolSize{};
+    ResourceDescriptor::populateDescriptorPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, (this->levelCount * 2), combinedSamplerPoolSize);
+    VkDescriptorPoolSize storageImagePoolSize{};
+    ResourceDescriptor::populateDescriptorPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, this->levelCount, storageImagePoolSize);
+    VkDescriptorPoolSize descriptorPoolSizes[] = {combinedSamplerPoolSize, storageImagePoolSize};
+
+    VkDescriptorPoolCreateInfo descriptorPoolCreateInfo{};
+    descriptorPoolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+
+    descriptorPoolCreateInfo.poolSizeCount = 2;
+    descriptorPoolCreateInfo.pPoolSizes = descriptorPoolSizes;
+
+    descriptorPoolCreateInfo.maxSets = this->levelCount;
+
+    VkResult descriptorPoolCreationResult = vkCreateDescriptorPool(vulkanDevices.logicalDevice, &descriptorPoolCreateInfo, nullptr, &this->pipelineComponents.descriptorPool);
+    if (descriptorPoolCreationResult != VK_SUCCESS) {
+        throwDebugException("Failed to create the depth pyramid descriptor pool.");
+    }
+
+    std::vector<VkDescriptorSetLayout> descriptorSetLayouts(this->levelCount, this->pipelineComponents.descriptorSetLayout);
+
+    VkDescriptorSetAllocateInfo descriptorSetsAllocateInfo{};
+    descriptorSetsAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+
+    descriptorSetsAllocateInfo.descriptorPool = this->pipelineComponents.descriptorPool;
+
+    descriptorSetsAllocateInfo.descriptorSetCount = this->levelCount;
+    descriptorSetsAllocateInfo.pSetLayouts = descriptorSetLayouts.data();
+
+    this->pipelineComponents.descriptorSets.resize(this->levelCount);
+    VkResult descriptorSetsAllocationResult = vkAllocateDescriptorSets(vulkanDevices.logicalDevice, &descriptorSetsAllocateInfo, this->pipelineComponents.descriptorSets.data());
+    if (descriptorSetsAllocationResult != VK_SUCCESS) {
+        throwDebugException("Failed to allocate the depth pyramid descriptor sets.");
+    }
+
+    VkDescriptorImageInfo depthImageDescriptorImageInfo{};
+    ResourceDescriptor::populateDescriptorImageInfo(this->pyramidSampler, depthImageView, VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL, depthImageDescriptorImageInfo);
+    VkDescriptorImageInfo depthPyramidDescriptorImageInfo{};
+    ResourceDescriptor::populateDescriptorImageInfo(this->pyramidSampler, this->pyramidImageDetails.imageView, VK_IMAGE_LAYOUT_GENERAL, depthPyramidDescriptorImageInfo);
+
+    for (uint32_t i = 0; i < this->levelCount; i += 1) {
+        VkDescriptorImageInfo reducedLevelDescriptorImageInfo{};
+        ResourceDescriptor::populateDescriptorImageInfo(VK_NULL_HANDLE, this->levelImageViews[i], VK_IMAGE_LAYOUT_GENERAL, reducedLevelDescriptorImageInfo);
+
+        std::vector<VkWriteDescriptorSet> levelWriteDescriptorSets(3);
+        ResourceDescriptor::populateWriteDescriptorSet(this->pipelineComponents.descriptorSets[i], 0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, &depthImageDescriptorImageInfo, nullptr, levelWriteDescriptorSets[0]);
+        ResourceDescriptor::populateWriteDescriptorSet(this->pipelineComponents.descriptorSets[i], 1, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, &depthPyramidDescriptorImageInfo, nullptr, levelWriteDescriptorSets[1]);
+        ResourceDescriptor::populateWriteDescriptorSet(this->pipelineComponents.descriptorSets[i], 2, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, &reducedLevelDescriptorImageInfo, nullptr, levelWriteDescriptorSets[2]);
+
+        vkUpdateDescriptorSets(vulkanDevices.logicalDevice, static_cast<uint32_t>(levelWriteDescriptorSets.size()), levelWriteDescriptorSets.data(), 0, nullptr);
+    }
+}
+
+void DepthPyramid::DepthPyramidOperation::fetchLevelExtent(uint32_t levelIndex, VkExtent2D& levelExtent) const
+{
+    levelExtent.width = std::max((static_cast<uint32_t>(this->pyramidImageDetails.imageWidth) >> levelIndex), 1u);
+    levelExtent.height = std::max((static_cast<uint32_t>(this->pyramidImageDetails.imageHeight) >> levelIndex), 1u);
+}
+
+void DepthPyramid::DepthPyramidOperation::recordReductionCommands(VkCommandBuffer commandBuffer) const
+{
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, this->pipelineComponents.pipeline);
+
+    for (uint32_t i = 0; i < this->levelCount; i += 1) {
+        DepthPyramid::ReductionPushConstant reductionPushConstant{};
+        if (i == 0) {
+            reductionPushConstant.sourceExtent = this->depthExtent;
+        } else {
+            this->fetchLevelExtent((i - 1), reductionPushConstant.sourceExtent);
+        }
+        this->fetchLevelExtent(i, reductionPushConstant.reducedExtent);
+        reductionPushConstant.reducedLevelIndex = i;
+
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, this->pipelineComponents.pipelineLayout, 0, 1, &this->pipelineComponents.descriptorSets[i], 0, nullptr);
+        vkCmdPushConstants(commandBuffer, this->pipelineComponents.pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(DepthPyramid::ReductionPushConstant), &reductionPushConstant);
+
+        uint32_t workgroupCountX = ((reductionPushConstant.reducedExtent.width + (DepthPyramid::reductionWorkgroupSize - 1)) / DepthPyramid::reductionWorkgroupSize);
+        uint32_t workgroupCountY = ((reductionPushConstant.reducedExtent.height + (DepthPyramid::reductionWorkgroupSize - 1)) / DepthPyramid::reductionWorkgroupSize);
+        vkCmdDispatch(commandBuffer, workgroupCountX, workgroupCountY, 1);
+
+        if ((i + 1) == this->levelCount) {  // the last level is synchronized with the culling compute pass by the render graph.
+            break;
+        }
+
+        // the next level's reduction reads this level.
+        VkImageMemoryBarrier levelMemoryBarrier{};
+        levelMemoryBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+
+        levelMemoryBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+        levelMemoryBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+        levelMemoryBarrier.oldLayout = VK_IMAGE_LAYOUT_GENERAL;
+        levelMemoryBarrier.newLayout = VK_IMAGE_LAYOUT_GENERAL;
+
+        levelMemoryBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        levelMemoryBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+
+        levelMemoryBarrier.image = this->pyramidImageDetails.image;
+        levelMemoryBarrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        levelMemoryBarrier.subresourceRange.baseMipLevel = i;
+        levelMemoryBarrier.subresourceRange.levelCount = 1;
+        levelMemoryBarrier.subresourceRange.baseArrayLayer = 0;
+        levelMemoryBarrier.subresourceRange.layerCount = 1;
+
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &levelMemoryBarrier);
+    }
+}
+
+void DepthPyramid::DepthPyramidOperation::cleanupPyramidImage(VkDevice vulkanLogicalDevice)
+{
+    for (VkImageView levelImageView : this->levelImageViews) {
+        vkDestroyImageView(vulkanLogicalDevice, levelImageView, nullptr);
+    }
+    this->levelImageViews.clear();
+
+    this->pyramidImageDetails.cleanupImageDetails(vulkanLogicalDevice);
+
+    vkDestroyDescriptorPool(vulkanLogicalDevice, this->pipelineComponents.descriptorPool, nullptr);  // frees the level descriptor sets.
+    this->pipelineComponents.descriptorPool = VK_NULL_HANDLE;
+    this->pipelineComponents.descriptorSets.clear();
+}
+
+void DepthPyramid::DepthPyramidOperation::cleanupDepthPyramidOperation(VkDevice vulkanLogicalDevice)
+{
+    this->cleanupPyramidImage(vulkanLogicalDevice);
+
+    vkDestroySampler(vulkanLogicalDevice, this->pyramidSampler, nullptr);
+
+    this->pipelineComponents.cleanupPipelineComponents(vulkanLogicalDevice);  // the compute pipeline is destroyed like a graphics pipeline.
+}
@@ -0,0 +1,76 @@
+#ifndef DEPTHPYRAMID_H
+#define DEPTHPYRAMID_H
+
+
+#define GLFW_INCLUDE_VULKAN
+#include <GLFW/glfw3.h>
+
+#include <core/Renderer/Pipeline.h>
+#include <core/Shader/Image.h>
+#include <core/VulkanInstance/DeviceHandler.h>
+
+#include <vector>
+#include <cstdint>
+
+
+namespace DepthPyramid
+{
+    const uint32_t reductionWorkgroupSize = 8;  // identical to the depth pyramid shader's local size on each axis.
+
+    struct ReductionPushConstant {  // identical to the depth pyramid shader's push constant.
+        VkExtent2D sourceExtent;
+        VkExtent2D reducedExtent;
+        uint32_t reducedLevelIndex;  // the first level is reduced from the depth image, every other level from the previous level.
+    };
+
+    struct DepthPyramidOperation {  // reduces the scene depth into a pyramid of the farthest depths, each level half of the previous, used in occlusion culling.
+        Pipeline::PipelineComponents pipelineComponents;  // the reduction compute pipeline, a descriptor set for each pyramid level(without uniform buffers).
+
+        Image::ImageDetails pyramidImageDetails;  // kept in the general layout, levels are written as storage images and read with texel fetches.
+        std::vector<VkImageView> levelImageViews;  // a single level view of each level, written by the level's reduction.
+        VkSampler pyramidSampler;  // a nearest sampler, used for both the pyramid and the depth image.
+
+        VkExtent2D depthExtent;  // the extent of the reduced depth image.
+        uint32_t levelCount;
+
+
+        // generate the member depth pyramid components, the pyramid image is generated seperately with the depth image(see generatePyramidImage).
+        //
+        // @param msaaSampleCount the amount of msaa samples in the reduced depth image.
+        // @param vulkanDevices Vulkan physical and logical device to use in member components generation.
+        void generateMemberComponents(VkSampleCountFlagBits msaaSampleCount, DeviceHandler::VulkanDevices vulkanDevices);
+
+        // generate the pyramid image of a depth image, the first level is the depth image's extent rounded down to a power of two.
+        //
+        // @param depthImageView the view of the reduced depth image, only its depth aspect.
+        // @param depthExtent the extent of the reduced depth image.
+        // @param vulkanDevices Vulkan physical and logical device to use in pyramid image generation.
+        void generatePyramidImage(VkImageView depthImageView, VkExtent2D depthExtent, DeviceHandler::VulkanDevices vulkanDevices);
+
+        // fetch the extent of a pyramid level.
+        //
+        // @param levelIndex the index of the level.
+        // @param levelExtent the fetched level extent.
+        void fetchLevelExtent(uint32_t levelIndex, VkExtent2D& levelExtent) const;
+
+        // record the reduction commands, reducing each level from the previous one.
+        //
+        // expects the depth image in a read-only layout and the pyramid image in the general layout.
+        //
+        // @param commandBuffer the command buffer to record in.
+        void recordReductionCommands(VkCommandBuffer commandBuffer) const;
+
+        // cleanup the pyramid image, its level views, and its descriptor sets(ex: before the depth image is recreated).
+        //
+        // @param vulkanLogicalDevice Vulkan logical device to use in pyramid image cleanup.
+        void cleanupPyramidImage(VkDevice vulkanLogicalDevice);
+
+        // cleanup the depth pyramid operation.
+        //
+        // @param vulkanLogicalDevice Vulkan logical device to use in depth pyramid operation cleanup.
+        void cleanupDepthPyramidOperation(VkDevice vulkanLogicalDevice);
+    };
+}
+
+
+#endif  // DEPTHPYRAMID_H
@@ -0,0 +1,136 @@
+#define GLFW_INCLUDE_VULKAN
+#include <GLFW/glfw3.h>
+
+#include <core/Renderer/DynamicResolution.h>
+#include <core/Queue/Queue.h>
+#include <core/Logging/ErrorLogger.h>
+#include <core/Defaults/Defaults.h>
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include <algorithm>
+#include <cmath>
+
+
+void DynamicResolution::ResolutionController::generateMemberComponents(uint32_t graphicsFamilyIndex, float targetFrameTime, float minimumRenderScale, DeviceHandler::VulkanDevices vulkanDevices)
+{
+    this->targetFrameTime = targetFrameTime;
+    this->minimumRenderScale = minimumRenderScale;
+    this->resetRenderScale();
+
+    std::vector<VkQueueFamilyProperties> queueFamilies;
+    Queue::querySupportedQueueFamilies(vulkanDevices.physicalDevice, queueFamilies);
+    this->timestampsSupported = (queueFamilies[graphicsFamilyIndex].timestampValidBits > 0);
+
+    VkPhysicalDeviceProperties physicalDeviceProperties;
+    vkGetPhysicalDeviceProperties(vulkanDevices.physicalDevice, &physicalDeviceProperties);
+    this->timestampPeriod = physicalDeviceProperties.limits.timestampPeriod;
+
+    this->timestampsWritten.assign(Defaults::rendererDefaults.MAX_FRAMES_IN_FLIGHT, false);
+    this->timedPassNames.assign(Defaults::rendererDefaults.MAX_FRAMES_IN_FLIGHT, {});
+    this->writtenQueryCounts.assign(Defaults::rendererDefaults.MAX_FRAMES_IN_FLIGHT, 0);
+    this->passTimes.clear();
+
+
+    VkQueryPoolCreateInfo queryPoolCreateInfo{};
+    queryPoolCreateInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+
+    queryPoolCreateInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+    queryPoolCreateInfo.queryCount = (DynamicResolution::frameQueryCount * Defaults::rendererDefaults.MAX_FRAMES_IN_FLIGHT);
+
+    VkResult queryPoolCreationResult = vkCreateQueryPool(vulkanDevices.logicalDevice, &queryPoolCreateInfo, nullptr, &this->timestampQueryPool);
+    if (queryPoolCreationResult != VK_SUCCESS) {
+        throwDebugException("Failed to create the dynamic resolution timestamp query pool.");
+    }
+}
+
+void DynamicResolution::ResolutionController::recordFrameBeginCommands(uint32_t currentFrame, VkCommandBuffer commandBuffer)
+{
+    if (this->timestampsSupported == false) {
+        return;
+    }
+
+    uint32_t firstQuery = (DynamicResolution::frameQueryCount * currentFrame);
+    vkCmdResetQueryPool(commandBuffer, this->timestampQueryPool, firstQuery, DynamicResolution::frameQueryCount);
+    vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, this->timestampQueryPool, firstQuery);
+
+    this->timedPassNames[currentFrame].clear();
+    this->writtenQueryCounts[currentFrame] = 1;
+}
+
+void DynamicResolution::ResolutionController::recordPassEndCommands(uint32_t currentFrame, const std::string& passName, VkCommandBuffer commandBuffer)
+{
+    if ((this->timestampsSupported == false) || (this->timedPassNames[currentFrame].size() == DynamicResolution::maxTimedPassCount)) {
+        return;
+    }
+
+    vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, this->timestampQueryPool, ((DynamicResolution::frameQueryCount * currentFrame) + this->writtenQueryCounts[currentFrame]));  // after the pass's commands have finished.
+
+    this->timedPassNames[currentFrame].push_back(passName);
+    this->writtenQueryCounts[currentFrame] += 1;
+}
+
+void DynamicResolution::ResolutionController::recordFrameEndCommands(uint32_t currentFrame, VkCommandBuffer commandBuffer)
+{
+    if (this->timestampsSupported == false) {
+        return;
+    }
+
+    vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, this->timestampQueryPool, ((DynamicResolution::frameQueryCount * currentFrame) + this->writtenQueryCounts[currentFrame]));  // after every pass of the frame has finished.
+    this->writtenQueryCounts[currentFrame] += 1;
+}
+
+void DynamicResolution::ResolutionController::updateRenderScale(uint32_t currentFrame, VkDevice vulkanLogicalDevice)
+{
+    if ((this->timestampsSupported == false) || (this->timestampsWritten[currentFrame] == false)) {
+        return;
+    }
+
+    // only the recorded timestamps are read, every one of them was written by the submission.
+    uint32_t writtenQueryCount = this->writtenQueryCounts[currentFrame];
+    std::vector<uint64_t> frameTimestamps(writtenQueryCount);
+    VkResult queryResultsResult = vkGetQueryPoolResults(vulkanLogicalDevice, this->timestampQueryPool, (DynamicResolution::frameQueryCount * currentFrame), writtenQueryCount, (frameTimestamps.size() * sizeof(uint64_t)), frameTimestamps.data(), sizeof(uint64_t), VK_QUERY_RESULT_64_BIT);
+    if (queryResultsResult != VK_SUCCESS) {  // the frame's fence was waited on, the timestamps are only missing if the frame was never submitted.
+        return;
+    }
+
+    auto calculateElapsedTime = [&](uint64_t beginTimestamp, uint64_t endTimestamp) {  // in milliseconds.
+        return static_cast<float>(((endTimestamp - beginTimestamp) * static_cast<double>(this->timestampPeriod)) / 1000000.0);
+    };
+
+    this->passTimes.clear();
+    for (size_t i = 0; i < this->timedPassNames[currentFrame].size(); i += 1) {
+        this->passTimes.push_back({this->timedPassNames[currentFrame][i], calculateElapsedTime(frameTimestamps[i], frameTimestamps[i + 1])});
+    }
+
+    float frameTime = calculateElapsedTime(frameTimestamps.front(), frameTimestamps.back());
+    this->smoothedFrameTime = ((this->smoothedFrameTime == 0.0f) ? frameTime : (this->smoothedFrameTime + (DynamicResolution::frameTimeSmoothingFactor * (frameTime - this->smoothedFrameTime))));
+
+    if ((this->targetFrameTime <= 0.0f) || (this->smoothedFrameTime <= 0.0f)) {
+        return;
+    }
+
+    // the frame time roughly follows the amount of rendered pixels, the square root of the time ratio scales each axis.
+    float targetRenderScale = (this->renderScale * std::sqrt(this->targetFrameTime / this->smoothedFrameTime));
+    targetRenderScale = std::clamp(targetRenderScale, (this->renderScale - DynamicResolution::maximumRenderScaleStep), (this->renderScale + DynamicResolution::maximumRenderScaleStep));
+    this->renderScale = std::clamp(targetRenderScale, this->minimumRenderScale, 1.0f);
+}
+
+void DynamicResolution::ResolutionController::fetchRenderExtent(VkExtent2D sceneExtent, VkExtent2D& renderExtent) const
+{
+    renderExtent.width = std::max(static_cast<uint32_t>(std::lround(sceneExtent.width * this->renderScale)), 1u);
+    renderExtent.height = std::max(static_cast<uint32_t>(std::lround(sceneExtent.height * this->renderScale)), 1u);
+}
+
+void DynamicResolution::ResolutionController::resetRenderScale()
+{
+    this->renderScale = 1.0f;
+    this->smoothedFrameTime = 0.0f;
+}
+
+void DynamicResolution::ResolutionController::cleanupResolutionController(VkDevice vulkanLogicalDevice)
+{
+    vkDestroyQueryPool(vulkanLogicalDevice, this->timestampQueryPool, nullptr);
+}
@@ -0,0 +1,94 @@
+#ifndef DYNAMICRESOLUTION_H
+#define DYNAMICRESOLUTION_H
+
+
+#define GLFW_INCLUDE_VULKAN
+#include <GLFW/glfw3.h>
+
+#include <core/VulkanInstance/DeviceHandler.h>
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <cstdint>
+
+
+namespace DynamicResolution
+{
+    const float frameTimeSmoothingFactor = 0.1f;  // the weight of each measured GPU frame time in the smoothed frame time.
+    const float maximumRenderScaleStep = 0.05f;  // the largest change of the render scale in a single frame, avoids oscillating around the target.
+    const uint32_t maxTimedPassCount = 32;  // the most render graph passes timed in a frame, later passes are only included in the frame time.
+    const uint32_t frameQueryCount = (DynamicResolution::maxTimedPassCount + 2);  // each frame in flight's queries, a begin timestamp, a timestamp after each timed pass, and an end timestamp.
+
+    struct ResolutionController {  // measures each frame's and each render graph pass's GPU time with timestamp queries, and scales the rendered region of the scene images to hold a target frame time.
+        VkQueryPool timestampQueryPool;  // frameQueryCount timestamps for each frame in flight.
+        std::vector<bool> timestampsWritten;  // if each frame in flight's timestamps were submitted, unsubmitted queries are never read.
+        std::vector<std::vector<std::string>> timedPassNames;  // the passes timed by each frame in flight, in recording order.
+        std::vector<uint32_t> writtenQueryCounts;  // the amount of timestamps recorded by each frame in flight.
+        bool timestampsSupported;  // if the graphics queue family has valid timestamp bits, the render scale is kept at 1 otherwise.
+        float timestampPeriod;  // the nanoseconds per timestamp tick.
+
+        float targetFrameTime;  // the held GPU frame time in milliseconds, 0 to keep the render scale at 1.
+        float minimumRenderScale;
+        float renderScale;  // the scale of the rendered region on each axis, from the minimum render scale to 1.
+        float smoothedFrameTime;  // the exponentially smoothed GPU frame time in milliseconds, 0 before the first measurement.
+        std::vector<std::pair<std::string, float>> passTimes;  // the last measured GPU time of each timed pass in milliseconds, including the barriers recorded before it.
+
+
+        // generate the member resolution controller components.
+        //
+        // @param graphicsFamilyIndex index of the graphics queue family, the timestamps are written on its queue.
+        // @param targetFrameTime the held GPU frame time in milliseconds, 0 to keep the render scale at 1.
+        // @param minimumRenderScale the smallest render scale on each axis.
+        // @param vulkanDevices Vulkan physical and logical device to use in member components generation.
+        void generateMemberComponents(uint32_t graphicsFamilyIndex, float targetFrameTime, float minimumRenderScale, DeviceHandler::VulkanDevices vulkanDevices);
+
+        // record the frame's begin timestamp, resetting the frame in flight's queries first.
+        //
+        // expects to be recorded first in the frame's command buffer, outside of a render pass.
+        //
+        // @param currentFrame the current frame in flight, selecting its queries.
+        // @param commandBuffer the command buffer to record in.
+        void recordFrameBeginCommands(uint32_t currentFrame, VkCommandBuffer commandBuffer);
+
+        // record a timestamp after a render graph pass, the pass's time is measured from the previous timestamp.
+        //
+        // @param currentFrame the current frame in flight, selecting its queries.
+        // @param passName the name of the recorded pass.
+        // @param commandBuffer the command buffer to record in.
+        void recordPassEndCommands(uint32_t currentFrame, const std::string& passName, VkCommandBuffer commandBuffer);
+
+        // record the frame's end timestamp.
+        //
+        // expects to be recorded last in the frame's command buffer.
+        //
+        // @param currentFrame the current frame in flight, selecting its queries.
+        // @param commandBuffer the command buffer to record in.
+        void recordFrameEndCommands(uint32_t currentFrame, VkCommandBuffer commandBuffer);
+
+        // read the frame in flight's previous GPU frame and pass times, and update the render scale towards the target frame time.
+        //
+        // expects the frame in flight's fence to be waited on.
+        //
+        // @param currentFrame the current frame in flight, selecting its queries.
+        // @param vulkanLogicalDevice Vulkan logical device to use in query result reading.
+        void updateRenderScale(uint32_t currentFrame, VkDevice vulkanLogicalDevice);
+
+        // fetch the rendered region of the scene images at the current render scale.
+        //
+        // @param sceneExtent the extent of the scene images.
+        // @param renderExtent the fetched extent of the rendered region, at least a pixel on each axis.
+        void fetchRenderExtent(VkExtent2D sceneExtent, VkExtent2D& renderExtent) const;
+
+        // reset the render scale to 1 and forget the smoothed frame time(ex: after the swapchain is recreated).
+        void resetRenderScale();
+
+        // cleanup the resolution controller.
+        //
+        // @param vulkanLogicalDevice Vulkan logical device to use in resolution controller cleanup.
+        void cleanupResolutionController(VkDevice vulkanLogicalDevice);
+    };
+}
+
+
+#endif  // DYNAMICRESOLUTION_H
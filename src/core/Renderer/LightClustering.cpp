@@ -0,0 +1,106 @@
+#define GLFW_INCLUDE_VULKAN
+#include <GLFW/glfw3.h>
+
+#include <core/Renderer/LightClustering.h>
+#include <core/Renderer/Renderer.h>
+#include <core/Shader/Shader.h>
+#include <core/Shader/Uniform.h>
+#include <core/Shader/ResourceDescriptor.h>
+#include <core/Buffer/Buffer.h>
+#include <core/Logging/ErrorLogger.h>
+#include <core/Defaults/Defaults.h>
+
+#include <vector>
+#include <optional>
+
+
+void LightClustering::ClusteringOperation::generateMemberComponents(uint32_t maxLightCount, DeviceHandler::VulkanDevices vulkanDevices)
+{
+    this->maxLightCount = maxLightCount;
+
+
+    VkDescriptorSetLayoutBinding clusteringUniformBufferLayoutBinding{};
+    ResourceDescriptor::populateDescriptorSetLayoutBinding(0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT, clusteringUniformBufferLayoutBinding);
+
+    VkDescriptorSetLayoutBinding clusteringLightLayoutBinding{};
+    ResourceDescriptor::populateDescriptorSetLayoutBinding(1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT, clusteringLightLayoutBinding);
+
+    VkDescriptorSetLayoutBinding clusteringClusterLightLayoutBinding{};
+    ResourceDescriptor::populateDescriptorSetLayoutBinding(2, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT, clusteringClusterLightLayoutBinding);
+
+    std::vector<VkDescriptorSetLayoutBinding> clusteringDescriptorSetLayoutBindings = {clusteringUniformBufferLayoutBinding, clusteringLightLayoutBinding, clusteringClusterLightLayoutBinding};
+    ResourceDescriptor::createDescriptorSetLayout(clusteringDescriptorSetLayoutBindings, vulkanDevices.logicalDevice, this->pipelineComponents.descriptorSetLayout);
+
+    RendererDetails::createPipelineLayout(vulkanDevices.logicalDevice, this->pipelineComponents.descriptorSetLayout, std::nullopt, this->pipelineComponents.pipelineLayout);
+
+
+    Shader::Shader clusteringComputeShader;
+    Shader::createShader((Defaults::applicationDefaults.SALAMANDER_ROOT_DIRECTORY + "/build/lightClusterCompute.spv"), VK_SHADER_STAGE_COMPUTE_BIT, vulkanDevices.logicalDevice, clusteringComputeShader);
+
+    VkComputePipelineCreateInfo computePipelineCreateInfo{};
+    computePipelineCreateInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+
+    computePipelineCreateInfo.stage = clusteringComputeShader.shaderStageCreateInfo;
+    computePipelineCreateInfo.layout = this->pipelineComponents.pipelineLayout;
+
+    computePipelineCreateInfo.basePipelineHandle = VK_NULL_HANDLE;
+    computePipelineCreateInfo.basePipelineIndex = -1;
+
+    VkResult computePipelineCreationResult = vkCreateComputePipelines(vulkanDevices.logicalDevice, VK_NULL_HANDLE, 1, &computePipelineCreateInfo, nullptr, &this->pipelineComponents.pipeline);
+    if (computePipelineCreationResult != VK_SUCCESS) {
+        throwDebugException("Failed to create the light clustering compute pipeline.");
+    }
+
+    vkDestroyShaderModule(vulkanDevices.logicalDevice, clusteringComputeShader.shaderModule, nullptr);
+
+
+    // lights are written by the CPU every frame, the cluster light lists are only written by the clustering compute pass.
+    VkDeviceSize lightBufferSize = (sizeof(Uniform::SceneLight) * maxLightCount);
+    this->lightBuffers.resize(Defaults::rendererDefaults.MAX_FRAMES_IN_FLIGHT);
+    this->lightBuffersMemory.resize(Defaults::rendererDefaults.MAX_FRAMES_IN_FLIGHT);
+    this->mappedLightBuffersMemory.resize(Defaults::rendererDefaults.MAX_FRAMES_IN_FLIGHT);
+    for (size_t i = 0; i < Defaults::rendererDefaults.MAX_FRAMES_IN_FLIGHT; i += 1) {
+        Buffer::createBufferComponents(lightBufferSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, (VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT), vulkanDevices, this->lightBuffers[i], this->lightBuffersMemory[i]);
+
+        vkMapMemory(vulkanDevices.logicalDevice, this->lightBuffersMemory[i], 0, lightBufferSize, 0, &this->mappedLightBuffersMemory[i]);
+    }
+
+    // shared by the frames in flight like the culled draw streams, every cluster's light count is rewritten each frame.
+    VkDeviceSize clusterLightBufferSize = (sizeof(uint32_t) * Uniform::clusterCount * (1 + Uniform::maxClusterLightCount));
+    Buffer::createBufferComponents(clusterLightBufferSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, vulkanDevices, this->clusterLightBuffer, this->clusterLightBufferMemory);
+
+
+    Uniform::createUniformBuffers(sizeof(Uniform::ClusteringUniformBufferObject), vulkanDevices, this->pipelineComponents.uniformBuffers, this->pipelineComponents.uniformBuffersMemory, this->pipelineComponents.mappedUniformBuffersMemory);
+    ResourceDescriptor::createDescriptorPool(0, 2, 0, vulkanDevices.logicalDevice, this->pipelineComponents.descriptorPool);
+    ResourceDescriptor::createDescriptorSets(this->pipelineComponents.descriptorSetLayout, this->pipelineComponents.descriptorPool, vulkanDevices.logicalDevice, this->pipelineComponents.descriptorSets);
+
+    VkDescriptorBufferInfo clusterLightDescriptorBufferInfo{};
+    ResourceDescriptor::populateDescriptorBufferInfo(this->clusterLightBuffer, 0, VK_WHOLE_SIZE, clusterLightDescriptorBufferInfo);
+    VkWriteDescriptorSet clusterLightWriteDescriptorSet{};
+    ResourceDescriptor::populateWriteDescriptorSet(nullptr, 2, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, nullptr, &clusterLightDescriptorBufferInfo, clusterLightWriteDescriptorSet);
+
+    std::vector<VkWriteDescriptorSet> clusteringWriteDescriptorSets = {clusterLightWriteDescriptorSet};
+    ResourceDescriptor::populateDescriptorSets(this->pipelineComponents.uniformBuffers, clusteringWriteDescriptorSets, vulkanDevices.logicalDevice, this->pipelineComponents.descriptorSets);
+    ResourceDescriptor::populateFrameStorageBufferDescriptors(1, this->lightBuffers, vulkanDevices.logicalDevice, this->pipelineComponents.descriptorSets);
+}
+
+void LightClustering::ClusteringOperation::recordClusteringCommands(uint32_t currentFrame, VkCommandBuffer commandBuffer) const
+{
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, this->pipelineComponents.pipeline);
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, this->pipelineComponents.pipelineLayout, 0, 1, &this->pipelineComponents.descriptorSets[currentFrame], 0, nullptr);
+
+    vkCmdDispatch(commandBuffer, ((Uniform::clusterCount + (LightClustering::clusteringWorkgroupSize - 1)) / LightClustering::clusteringWorkgroupSize), 1, 1);  // an invocation for each cluster, tested against every light.
+}
+
+void LightClustering::ClusteringOperation::cleanupClusteringOperation(VkDevice vulkanLogicalDevice)
+{
+    for (size_t i = 0; i < this->lightBuffers.size(); i += 1) {
+        vkDestroyBuffer(vulkanLogicalDevice, this->lightBuffers[i], nullptr);
+        vkFreeMemory(vulkanLogicalDevice, this->lightBuffersMemory[i], nullptr);
+    }
+
+    vkDestroyBuffer(vulkanLogicalDevice, this->clusterLightBuffer, nullptr);
+    vkFreeMemory(vulkanLogicalDevice, this->clusterLightBufferMemory, nullptr);
+
+    this->pipelineComponents.cleanupPipelineComponents(vulkanLogicalDevice);  // the compute pipeline is destroyed like a graphics pipeline.
+}
@@ -0,0 +1,53 @@
+#ifndef LIGHTCLUSTERING_H
+#define LIGHTCLUSTERING_H
+
+
+#define GLFW_INCLUDE_VULKAN
+#include <GLFW/glfw3.h>
+
+#include <core/Renderer/Pipeline.h>
+#include <core/Shader/Uniform.h>
+#include <core/VulkanInstance/DeviceHandler.h>
+
+#include <vector>
+#include <cstdint>
+
+
+namespace LightClustering
+{
+    const uint32_t clusteringWorkgroupSize = 64;  // identical to the light clustering shader's local size, each workgroup loads this many lights at a time.
+
+    struct ClusteringOperation {  // bins the scene lights into the clusters of the camera frustum on the GPU, the scene shader only shades its fragment's cluster's lights.
+        Pipeline::PipelineComponents pipelineComponents;  // the compute pipeline, its uniform buffers hold the camera's projection.
+
+        std::vector<VkBuffer> lightBuffers;  // the scene light storage buffer of each frame in flight(see Uniform::SceneLight).
+        std::vector<VkDeviceMemory> lightBuffersMemory;
+        std::vector<void *> mappedLightBuffersMemory;
+
+        VkBuffer clusterLightBuffer;  // the light count of every cluster, followed by every cluster's light indices(each cluster is Uniform::maxClusterLightCount indices long).
+        VkDeviceMemory clusterLightBufferMemory;
+
+        uint32_t maxLightCount;
+
+
+        // generate the member clustering operation components.
+        //
+        // @param maxLightCount the maximum amount of scene lights.
+        // @param vulkanDevices Vulkan physical and logical device to use in member components generation.
+        void generateMemberComponents(uint32_t maxLightCount, DeviceHandler::VulkanDevices vulkanDevices);
+
+        // record the clustering commands, dispatching an invocation for each cluster.
+        //
+        // @param currentFrame the current frame in flight, selecting the light and uniform buffers.
+        // @param commandBuffer the command buffer to record in.
+        void recordClusteringCommands(uint32_t currentFrame, VkCommandBuffer commandBuffer) const;
+
+        // cleanup the clustering operation.
+        //
+        // @param vulkanLogicalDevice Vulkan logical device to use in clustering operation cleanup.
+        void cleanupClusteringOperation(VkDevice vulkanLogicalDevice);
+    };
+}
+
+
+#endif  // LIGHTCLUSTERING_H
@@ -0,0 +1,450 @@
+#define GLFW_INCLUDE_VULKAN
+#include <GLFW/glfw3.h>
+
+#define GLM_FORCE_RADIANS
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <core/Renderer/MaskedOcclusion.h>
+#include <core/Logging/ErrorLogger.h>
+
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <functional>
+#include <thread>
+#include <random>
+#include <chrono>
+#include <cmath>
+#include <cfloat>
+#include <iostream>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE__)
+#include <xmmintrin.h>
+#endif
+
+
+void MaskedOcclusion::OcclusionBuffer::generateOcclusionBuffer(uint32_t requestedThreadCount)
+{
+    this->threadCount = requestedThreadCount;
+    if (this->threadCount == 0) {  // use the amount of hardware threads.
+        this->threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+    this->threadCount = std::min(this->threadCount, MaskedOcclusion::bufferTileRowCount);  // any more threads would sit idle.
+
+    for (uint32_t i = 1; i < this->threadCount; i += 1) {  // the calling thread rasterizes the first band.
+        WorkerThread::PersistentWorker *rasterizationWorker = new WorkerThread::PersistentWorker();
+        rasterizationWorker->startWorker();
+        this->rasterizationWorkers.push_back(rasterizationWorker);
+    }
+
+    MaskedOcclusion::DepthTile clearedTile;
+    std::fill(std::begin(clearedTile.pixelDepths), std::end(clearedTile.pixelDepths), 1.0f);
+    clearedTile.farthestDepth = 1.0f;
+    this->tiles.assign((MaskedOcclusion::bufferTileColumnCount * MaskedOcclusion::bufferTileRowCount), clearedTile);
+}
+
+void MaskedOcclusion::OcclusionBuffer::cleanupOcclusionBuffer()
+{
+    for (WorkerThread::PersistentWorker *rasterizationWorker : this->rasterizationWorkers) {
+        rasterizationWorker->stopWorker();
+        delete rasterizationWorker;
+    }
+    this->rasterizationWorkers.clear();
+}
+
+void MaskedOcclusion::OcclusionBuffer::rasterizeOccluders(const MaskedOcclusion::Occluder occluders[], uint32_t occluderCount, const glm::mat4& cameraMatrix)
+{
+    this->setupScreenTriangles(occluders, occluderCount, cameraMatrix);
+
+    // every thread owns a band of tile rows, no tile is written by two threads.
+    uint32_t bandTileRowCount = ((MaskedOcclusion::bufferTileRowCount + (this->threadCount - 1)) / this->threadCount);
+    for (uint32_t i = 1; i < this->threadCount; i += 1) {  // the calling thread rasterizes the first band.
+        uint32_t firstTileRow = std::min((i * bandTileRowCount), MaskedOcclusion::bufferTileRowCount);
+        uint32_t tileRowEnd = std::min((firstTileRow + bandTileRowCount), MaskedOcclusion::bufferTileRowCount);
+        this->rasterizationWorkers[i - 1]->submitJob([this, firstTileRow, tileRowEnd]() { this->rasterizeTileRows(firstTileRow, tileRowEnd); });
+    }
+    this->rasterizeTileRows(0, std::min(bandTileRowCount, MaskedOcclusion::bufferTileRowCount));
+
+    for (WorkerThread::PersistentWorker *rasterizationWorker : this->rasterizationWorkers) {
+        rasterizationWorker->waitForJob();
+    }
+}
+
+void MaskedOcclusion::OcclusionBuffer::setupScreenTriangles(const MaskedOcclusion::Occluder occluders[], uint32_t occluderCount, const glm::mat4& cameraMatrix)
+{
+    this->screenTriangles.clear();
+
+    const glm::vec2 bufferExtent = glm::vec2(MaskedOcclusion::bufferWidth, MaskedOcclusion::bufferHeight);
+    std::vector<glm::vec4> clipSpacePositions;
+    for (uint32_t i = 0; i < occluderCount; i += 1) {
+        const MaskedOcclusion::OccluderMesh& occluderMesh = *occluders[i].occluderMesh;
+        glm::mat4 occluderMatrix = (cameraMatrix * occluders[i].modelMatrix);
+
+        clipSpacePositions.resize(occluderMesh.positions.size());
+        for (size_t j = 0; j < occluderMesh.positions.size(); j += 1) {
+            clipSpacePositions[j] = (occluderMatrix * glm::vec4(occluderMesh.positions[j], 1.0f));
+        }
+
+        for (size_t j = 0; (j + 2) < occluderMesh.indices.size(); j += 3) {
+            // triangles crossing the near plane are skipped instead of clipped, an occluder missing triangles only culls less.
+            glm::vec3 screenSpaceVertices[3];
+            bool triangleClipped = false;
+            for (uint32_t k = 0; k < 3; k += 1) {
+                const glm::vec4& clipSpacePosition = clipSpacePositions[occluderMesh.indices[j + k]];
+                if ((clipSpacePosition.w <= FLT_EPSILON) || (clipSpacePosition.z < -clipSpacePosition.w)) {  // the camera projection has a -1..1 depth range.
+                    triangleClipped = true;
+                    break;
+                }
+
+                glm::vec3 NDCPosition = (glm::vec3(clipSpacePosition) / clipSpacePosition.w);
+                screenSpaceVertices[k] = glm::vec3((((glm::vec2(NDCPosition) * 0.5f) + 0.5f) * bufferExtent), NDCPosition.z);
+            }
+            if (triangleClipped == true) {
+                continue;
+            }
+
+            // both windings are rasterized, the vertices are reordered so the inside of every edge is positive.
+            float triangleArea = (((screenSpaceVertices[1].x - screenSpaceVertices[0].x) * (screenSpaceVertices[2].y - screenSpaceVertices[0].y)) - ((screenSpaceVertices[2].x - screenSpaceVertices[0].x) * (screenSpaceVertices[1].y - screenSpaceVertices[0].y)));
+            if (std::abs(triangleArea) <= FLT_EPSILON) {
+                continue;
+            }
+            if (triangleArea < 0.0f) {
+                std::swap(screenSpaceVertices[1], screenSpaceVertices[2]);
+                triangleArea = -triangleArea;
+            }
+
+            glm::vec3 minimumVertex = glm::min(glm::min(screenSpaceVertices[0], screenSpaceVertices[1]), screenSpaceVertices[2]);
+            glm::vec3 maximumVertex = glm::max(glm::max(screenSpaceVertices[0], screenSpaceVertices[1]), screenSpaceVertices[2]);
+            if ((maximumVertex.x < 0.0f) || (maximumVertex.y < 0.0f) || (minimumVertex.x >= bufferExtent.x) || (minimumVertex.y >= bufferExtent.y)) {
+                continue;
+            }
+
+            MaskedOcclusion::ScreenTriangle screenTriangle;
+            for (uint32_t k = 0; k < 3; k += 1) {
+                const glm::vec3& edgeBegin = screenSpaceVertices[k];
+                const glm::vec3& edgeEnd = screenSpaceVertices[(k + 1) % 3];
+                screenTriangle.edgeCoefficients[k] = glm::vec3((edgeBegin.y - edgeEnd.y), (edgeEnd.x - edgeBegin.x), ((edgeBegin.x * edgeEnd.y) - (edgeBegin.y * edgeEnd.x)));
+            }
+
+            // depth is linear in screen space, each pixel keeps the farthest depth of the plane over its area so the occluder is never nearer than itself.
+            // coverage is only sampled at pixel centers, the occludee test grows its bounds to make up for pixels an occluder's silhouette partially covers.
+            glm::vec3 firstEdge = (screenSpaceVertices[1] - screenSpaceVertices[0]);
+            glm::vec3 secondEdge = (screenSpaceVertices[2] - screenSpaceVertices[0]);
+            float depthSlopeX = (((firstEdge.z * secondEdge.y) - (secondEdge.z * firstEdge.y)) / triangleArea);
+            float depthSlopeY = (((secondEdge.z * firstEdge.x) - (firstEdge.z * secondEdge.x)) / triangleArea);
+            float depthOffset = (0.5f * (std::abs(depthSlopeX) + std::abs(depthSlopeY)));
+            screenTriangle.depthCoefficients = glm::vec3(depthSlopeX, depthSlopeY, ((screenSpaceVertices[0].z - (depthSlopeX * screenSpaceVertices[0].x) - (depthSlopeY * screenSpaceVertices[0].y)) + depthOffset));
+            screenTriangle.nearestDepth = minimumVertex.z;
+            screenTriangle.farthestDepth = maximumVertex.z;
+
+            screenTriangle.minimumTileX = (static_cast<uint32_t>(std::max(minimumVertex.x, 0.0f)) / MaskedOcclusion::tileWidth);
+            screenTriangle.minimumTileY = (static_cast<uint32_t>(std::max(minimumVertex.y, 0.0f)) / MaskedOcclusion::tileHeight);
+            screenTriangle.maximumTileX = (static_cast<uint32_t>(std::min(maximumVertex.x, (bufferExtent.x - 1.0f))) / MaskedOcclusion::tileWidth);
+            screenTriangle.maximumTileY = (static_cast<uint32_t>(std::min(maximumVertex.y, (bufferExtent.y - 1.0f))) / MaskedOcclusion::tileHeight);
+
+            this->screenTriangles.push_back(screenTriangle);
+        }
+    }
+}
+
+void MaskedOcclusion::OcclusionBuffer::rasterizeTileRows(uint32_t firstTileRow, uint32_t tileRowEnd)
+{
+    for (uint32_t i = (firstTileRow * MaskedOcclusion::bufferTileColumnCount); i < (tileRowEnd * MaskedOcclusion::bufferTileColumnCount); i += 1) {
+        std::fill(std::begin(this->tiles[i].pixelDepths), std::end(this->tiles[i].pixelDepths), 1.0f);
+        this->tiles[i].farthestDepth = 1.0f;
+    }
+
+    for (const MaskedOcclusion::ScreenTriangle& screenTriangle : this->screenTriangles) {
+        if ((screenTriangle.maximumTileY < firstTileRow) || (screenTriangle.minimumTileY >= tileRowEnd)) {
+            continue;
+        }
+
+        uint32_t triangleTileRowEnd = std::min((screenTriangle.maximumTileY + 1), tileRowEnd);
+        for (uint32_t tileY = std::max(screenTriangle.minimumTileY, firstTileRow); tileY < triangleTileRowEnd; tileY += 1) {
+            for (uint32_t tileX = screenTriangle.minimumTileX; tileX <= screenTriangle.maximumTileX; tileX += 1) {
+                MaskedOcclusion::DepthTile& depthTile = this->tiles[(tileY * MaskedOcclusion::bufferTileColumnCount) + tileX];
+                if (screenTriangle.nearestDepth >= depthTile.farthestDepth) {  // the triangle is behind every pixel of the tile.
+                    continue;
+                }
+
+                MaskedOcclusion::rasterizeTriangleTile(screenTriangle, tileX, tileY, depthTile);
+            }
+        }
+    }
+}
+
+bool MaskedOcclusion::OcclusionBuffer::testOccludeeBox(const glm::vec3& boxMinimum, const glm::vec3& boxMaximum, const glm::mat4& cameraMatrix) const
+{
+    // the screen space bounds and nearest depth of the box.
+    const glm::vec2 bufferExtent = glm::vec2(MaskedOcclusion::bufferWidth, MaskedOcclusion::bufferHeight);
+    glm::vec2 minimumCoordinates = glm::vec2(FLT_MAX);
+    glm::vec2 maximumCoordinates = glm::vec2(-FLT_MAX);
+    float nearestDepth = FLT_MAX;
+    for (uint32_t i = 0; i < 8; i += 1) {
+        glm::vec3 boxCorner = glm::mix(boxMinimum, boxMaximum, glm::bvec3(((i & 1) != 0), ((i & 2) != 0), ((i & 4) != 0)));
+        glm::vec4 clipSpaceCorner = (cameraMatrix * glm::vec4(boxCorner, 1.0f));
+        if (clipSpaceCorner.w <= FLT_EPSILON) {  // the box crosses the camera plane, and could cover the whole screen.
+            return false;
+        }
+
+        glm::vec3 NDCCorner = (glm::vec3(clipSpaceCorner) / clipSpaceCorner.w);
+        glm::vec2 screenSpaceCorner = (((glm::vec2(NDCCorner) * 0.5f) + 0.5f) * bufferExtent);
+        minimumCoordinates = glm::min(minimumCoordinates, screenSpaceCorner);
+        maximumCoordinates = glm::max(maximumCoordinates, screenSpaceCorner);
+        nearestDepth = std::min(nearestDepth, NDCCorner.z);
+    }
+    if ((maximumCoordinates.x < 0.0f) || (maximumCoordinates.y < 0.0f) || (minimumCoordinates.x >= bufferExtent.x) || (minimumCoordinates.y >= bufferExtent.y)) {
+        return false;  // left to frustum culling.
+    }
+
+    // every pixel within half a pixel of the bounds, the tile's farthest depth is tested before its pixels.
+    // a point of the box seen past an occluder's edge can lie in a pixel whose center the occluder covers, but the edge leaves a neighbouring pixel center within half a pixel of the point uncovered.
+    uint32_t minimumPixelX = static_cast<uint32_t>(std::max((minimumCoordinates.x - 0.5f), 0.0f));
+    uint32_t minimumPixelY = static_cast<uint32_t>(std::max((minimumCoordinates.y - 0.5f), 0.0f));
+    uint32_t maximumPixelX = static_cast<uint32_t>(std::min((maximumCoordinates.x + 0.5f), (bufferExtent.x - 1.0f)));
+    uint32_t maximumPixelY = static_cast<uint32_t>(std::min((maximumCoordinates.y + 0.5f), (bufferExtent.y - 1.0f)));
+    for (uint32_t tileY = (minimumPixelY / MaskedOcclusion::tileHeight); tileY <= (maximumPixelY / MaskedOcclusion::tileHeight); tileY += 1) {
+        for (uint32_t tileX = (minimumPixelX / MaskedOcclusion::tileWidth); tileX <= (maximumPixelX / MaskedOcclusion::tileWidth); tileX += 1) {
+            const MaskedOcclusion::DepthTile& depthTile = this->tiles[(tileY * MaskedOcclusion::bufferTileColumnCount) + tileX];
+            if (depthTile.farthestDepth < nearestDepth) {  // every pixel of the tile is in front of the box.
+                continue;
+            }
+
+            uint32_t tilePixelX = (tileX * MaskedOcclusion::tileWidth);
+            uint32_t tilePixelY = (tileY * MaskedOcclusion::tileHeight);
+            for (uint32_t pixelY = std::max(minimumPixelY, tilePixelY); pixelY <= std::min(maximumPixelY, (tilePixelY + MaskedOcclusion::tileHeight - 1)); pixelY += 1) {
+                for (uint32_t pixelX = std::max(minimumPixelX, tilePixelX); pixelX <= std::min(maximumPixelX, (tilePixelX + MaskedOcclusion::tileWidth - 1)); pixelX += 1) {
+                    if (depthTile.pixelDepths[((pixelY - tilePixelY) * MaskedOcclusion::tileWidth) + (pixelX - tilePixelX)] >= nearestDepth) {
+                        return false;
+                    }
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+void MaskedOcclusion::OcclusionBuffer::verifyOcclusionBuffer()
+{
+    // an identity camera matrix maps positions straight to normalized device coordinates, the expected coverage is known to the pixel.
+    const glm::mat4 cameraMatrix = glm::mat4(1.0f);
+    auto screenToNDC = [](glm::vec2 screenCoordinates) { return (((screenCoordinates / glm::vec2(MaskedOcclusion::bufferWidth, MaskedOcclusion::bufferHeight)) * 2.0f) - 1.0f); };
+
+    // a wall at depth 0 over pixels 80..240 and 48..143, its right edge only a tenth of a pixel past the center of pixel column 240.
+    const glm::vec2 wallMinimum = glm::vec2(80.0f, 48.0f);
+    const glm::vec2 wallMaximum = glm::vec2(240.6f, 144.0f);
+    MaskedOcclusion::OccluderMesh wallMesh;
+    wallMesh.positions = {glm::vec3(screenToNDC(wallMinimum), 0.0f), glm::vec3(screenToNDC(glm::vec2(wallMaximum.x, wallMinimum.y)), 0.0f), glm::vec3(screenToNDC(wallMaximum), 0.0f), glm::vec3(screenToNDC(glm::vec2(wallMinimum.x, wallMaximum.y)), 0.0f)};
+    wallMesh.indices = {0, 1, 2, 0, 2, 3};
+    MaskedOcclusion::Occluder wallOccluder = {&wallMesh, glm::mat4(1.0f)};
+    this->rasterizeOccluders(&wallOccluder, 1, cameraMatrix);
+
+    struct OccludeeCheck {
+        glm::vec2 screenMinimum;
+        glm::vec2 screenMaximum;
+        float nearestDepth;
+        bool occluded;  // the expected test result.
+        std::string description;
+    };
+    const OccludeeCheck occludeeChecks[] = {
+        {glm::vec2(120.0f, 80.0f), glm::vec2(200.0f, 112.0f), 0.5f, true, "behind the wall"},
+        {glm::vec2(120.0f, 80.0f), glm::vec2(200.0f, 112.0f), -0.5f, false, "in front of the wall"},
+        {glm::vec2(260.0f, 80.0f), glm::vec2(280.0f, 112.0f), 0.5f, false, "beside the wall"},
+        {glm::vec2(240.7f, 80.0f), glm::vec2(240.9f, 112.0f), 0.5f, false, "seen past the wall's edge, inside a pixel whose center the wall covers"},
+    };
+    for (const OccludeeCheck& occludeeCheck : occludeeChecks) {
+        glm::vec3 boxMinimum = glm::vec3(screenToNDC(occludeeCheck.screenMinimum), occludeeCheck.nearestDepth);
+        glm::vec3 boxMaximum = glm::vec3(screenToNDC(occludeeCheck.screenMaximum), (occludeeCheck.nearestDepth + 0.1f));
+        if (this->testOccludeeBox(boxMinimum, boxMaximum, cameraMatrix) != occludeeCheck.occluded) {
+            throwDebugException("The occlusion buffer failed its self-check, a box " + occludeeCheck.description + " was " + ((occludeeCheck.occluded == true) ? "left visible." : "culled."));
+        }
+    }
+}
+
+void MaskedOcclusion::buildOccluderMesh(const std::vector<glm::vec3>& meshPositions, const std::vector<uint32_t>& meshIndices, uint32_t maxTriangleCount, MaskedOcclusion::OccluderMesh& occluderMesh)
+{
+    occluderMesh.positions.clear();
+    occluderMesh.indices.clear();
+
+    size_t meshIndexCount = ((meshIndices.empty() == true) ? meshPositions.size() : meshIndices.size());
+    size_t meshTriangleCount = (meshIndexCount / 3);
+    if ((meshTriangleCount == 0) || (maxTriangleCount == 0)) {
+        return;
+    }
+
+    // dropping triangles only leaves holes in the occluder, it never spans more than the mesh.
+    size_t triangleStride = ((meshTriangleCount + (maxTriangleCount - 1)) / maxTriangleCount);
+    std::vector<uint32_t> occluderVertexIndices(meshPositions.size(), UINT32_MAX);
+    for (size_t i = 0; i < meshTriangleCount; i += triangleStride) {
+        for (size_t j = 0; j < 3; j += 1) {
+            uint32_t meshVertexIndex = ((meshIndices.empty() == true) ? static_cast<uint32_t>((i * 3) + j) : meshIndices[(i * 3) + j]);
+            if (occluderVertexIndices[meshVertexIndex] == UINT32_MAX) {
+                occluderVertexIndices[meshVertexIndex] = static_cast<uint32_t>(occluderMesh.positions.size());
+                occluderMesh.positions.push_back(meshPositions[meshVertexIndex]);
+            }
+            occluderMesh.indices.push_back(occluderVertexIndices[meshVertexIndex]);
+        }
+    }
+}
+
+void MaskedOcclusion::rasterizeTriangleTile(const MaskedOcclusion::ScreenTriangle& screenTriangle, uint32_t tileX, uint32_t tileY, MaskedOcclusion::DepthTile& depthTile)
+{
+    // a pixel is covered if its center is inside of every edge, covered pixels keep the nearest of their depth and the triangle's.
+    const glm::vec3 *edgeCoefficients = screenTriangle.edgeCoefficients;
+    const glm::vec3& depthCoefficients = screenTriangle.depthCoefficients;
+    float firstPixelX = (static_cast<float>(tileX * MaskedOcclusion::tileWidth) + 0.5f);
+
+    uint32_t coverageMask = 0;
+#if defined(__AVX__)
+    __m256 pixelX = _mm256_add_ps(_mm256_set1_ps(firstPixelX), _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f));
+    __m256 zero = _mm256_setzero_ps();
+    __m256 triangleFarthestDepth = _mm256_set1_ps(screenTriangle.farthestDepth);
+    __m256 tileFarthestDepth = _mm256_set1_ps(-FLT_MAX);
+
+    for (uint32_t i = 0; i < MaskedOcclusion::tileHeight; i += 1) {
+        float pixelY = (static_cast<float>((tileY * MaskedOcclusion::tileHeight) + i) + 0.5f);
+
+        __m256 insideMask = _mm256_cmp_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(edgeCoefficients[0].x), pixelX), _mm256_set1_ps((edgeCoefficients[0].y * pixelY) + edgeCoefficients[0].z)), zero, _CMP_GE_OQ);
+        insideMask = _mm256_and_ps(insideMask, _mm256_cmp_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(edgeCoefficients[1].x), pixelX), _mm256_set1_ps((edgeCoefficients[1].y * pixelY) + edgeCoefficients[1].z)), zero, _CMP_GE_OQ));
+        insideMask = _mm256_and_ps(insideMask, _mm256_cmp_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(edgeCoefficients[2].x), pixelX), _mm256_set1_ps((edgeCoefficients[2].y * pixelY) + edgeCoefficients[2].z)), zero, _CMP_GE_OQ));
+
+        __m256 triangleDepth = _mm256_min_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(depthCoefficients.x), pixelX), _mm256_set1_ps((depthCoefficients.y * pixelY) + depthCoefficients.z)), triangleFarthestDepth);
+        __m256 pixelDepth = _mm256_load_ps(&depthTile.pixelDepths[i * MaskedOcclusion::tileWidth]);
+        pixelDepth = _mm256_blendv_ps(pixelDepth, _mm256_min_ps(pixelDepth, triangleDepth), insideMask);
+        _mm256_store_ps(&depthTile.pixelDepths[i * MaskedOcclusion::tileWidth], pixelDepth);
+
+        tileFarthestDepth = _mm256_max_ps(tileFarthestDepth, pixelDepth);
+        coverageMask |= (static_cast<uint32_t>(_mm256_movemask_ps(insideMask)) << (i * MaskedOcclusion::tileWidth));
+    }
+
+    alignas(32) float rowFarthestDepths[8];
+    _mm256_store_ps(rowFarthestDepths, tileFarthestDepth);
+#elif defined(__SSE__)
+    __m128 zero = _mm_setzero_ps();
+    __m128 triangleFarthestDepth = _mm_set1_ps(screenTriangle.farthestDepth);
+    __m128 tileFarthestDepth = _mm_set1_ps(-FLT_MAX);
+
+    for (uint32_t i = 0; i < (MaskedOcclusion::tileHeight * 2); i += 1) {  // each row is tested in two halves.
+        uint32_t rowIndex = (i / 2);
+        uint32_t halfIndex = (i % 2);
+        __m128 pixelX = _mm_add_ps(_mm_set1_ps(firstPixelX + static_cast<float>(halfIndex * 4)), _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f));
+        float pixelY = (static_cast<float>((tileY * MaskedOcclusion::tileHeight) + rowIndex) + 0.5f);
+
+        __m128 insideMask = _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(edgeCoefficients[0].x), pixelX), _mm_set1_ps((edgeCoefficients[0].y * pixelY) + edgeCoefficients[0].z)), zero);
+        insideMask = _mm_and_ps(insideMask, _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(edgeCoefficients[1].x), pixelX), _mm_set1_ps((edgeCoefficients[1].y * pixelY) + edgeCoefficients[1].z)), zero));
+        insideMask = _mm_and_ps(insideMask, _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(edgeCoefficients[2].x), pixelX), _mm_set1_ps((edgeCoefficients[2].y * pixelY) + edgeCoefficients[2].z)), zero));
+
+        __m128 triangleDepth = _mm_min_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(depthCoefficients.x), pixelX), _mm_set1_ps((depthCoefficients.y * pixelY) + depthCoefficients.z)), triangleFarthestDepth);
+        float *pixelDepths = &depthTile.pixelDepths[(rowIndex * MaskedOcclusion::tileWidth) + (halfIndex * 4)];
+        __m128 pixelDepth = _mm_load_ps(pixelDepths);
+        pixelDepth = _mm_or_ps(_mm_and_ps(insideMask, _mm_min_ps(pixelDepth, triangleDepth)), _mm_andnot_ps(insideMask, pixelDepth));  // a blend without SSE4.1.
+        _mm_store_ps(pixelDepths, pixelDepth);
+
+        tileFarthestDepth = _mm_max_ps(tileFarthestDepth, pixelDepth);
+        coverageMask |= (static_cast<uint32_t>(_mm_movemask_ps(insideMask)) << (i * 4));
+    }
+
+    alignas(16) float rowFarthestDepths[4];
+    _mm_store_ps(rowFarthestDepths, tileFarthestDepth);
+#else
+    float rowFarthestDepths[1] = {-FLT_MAX};
+    for (uint32_t i = 0; i < (MaskedOcclusion::tileWidth * MaskedOcclusion::tileHeight); i += 1) {
+        float pixelX = (firstPixelX + static_cast<float>(i % MaskedOcclusion::tileWidth));
+        float pixelY = (static_cast<float>((tileY * MaskedOcclusion::tileHeight) + (i / MaskedOcclusion::tileWidth)) + 0.5f);
+
+        bool pixelInside = true;
+        for (uint32_t j = 0; j < 3; j += 1) {
+            pixelInside = pixelInside && (((edgeCoefficients[j].x * pixelX) + (edgeCoefficients[j].y * pixelY) + edgeCoefficients[j].z) >= 0.0f);
+        }
+        if (pixelInside == true) {
+            float triangleDepth = std::min(((depthCoefficients.x * pixelX) + (depthCoefficients.y * pixelY) + depthCoefficients.z), screenTriangle.farthestDepth);
+            depthTile.pixelDepths[i] = std::min(depthTile.pixelDepths[i], triangleDepth);
+            coverageMask |= (1u << i);
+        }
+        rowFarthestDepths[0] = std::max(rowFarthestDepths[0], depthTile.pixelDepths[i]);
+    }
+#endif
+
+    if (coverageMask != 0) {  // the tile's farthest depth can only move nearer when a pixel was covered.
+        depthTile.farthestDepth = *std::max_element(std::begin(rowFarthestDepths), std::end(rowFarthestDepths));
+    }
+}
+
+void MaskedOcclusion::benchmarkOcclusionBuffer(uint32_t occludeeCount, uint32_t requestedThreadCount)
+{
+    // a wall of triangles facing the camera, the occludees are scattered in front of and behind it.
+    const uint32_t wallQuadCount = 16;  // on each axis.
+    const float wallExtent = 50.0f;
+
+    std::vector<glm::vec3> wallPositions;
+    std::vector<uint32_t> wallIndices;
+    for (uint32_t y = 0; y <= wallQuadCount; y += 1) {
+        for (uint32_t x = 0; x <= wallQuadCount; x += 1) {
+            wallPositions.push_back(glm::vec3((((static_cast<float>(x) / wallQuadCount) * 2.0f) - 1.0f) * wallExtent, (((static_cast<float>(y) / wallQuadCount) * 2.0f) - 1.0f) * wallExtent, 0.0f));
+        }
+    }
+    for (uint32_t y = 0; y < wallQuadCount; y += 1) {
+        for (uint32_t x = 0; x < wallQuadCount; x += 1) {
+            uint32_t firstVertex = ((y * (wallQuadCount + 1)) + x);
+            wallIndices.insert(wallIndices.end(), {firstVertex, (firstVertex + 1), (firstVertex + wallQuadCount + 1), (firstVertex + 1), (firstVertex + wallQuadCount + 2), (firstVertex + wallQuadCount + 1)});
+        }
+    }
+    MaskedOcclusion::OccluderMesh wallMesh;
+    MaskedOcclusion::buildOccluderMesh(wallPositions, wallIndices, UINT32_MAX, wallMesh);
+    MaskedOcclusion::Occluder wallOccluder = {&wallMesh, glm::mat4(1.0f)};
+
+    std::mt19937 randomGenerator(1);  // a fixed seed keeps the benchmark comparable between runs.
+    std::uniform_real_distribution<float> positionDistribution(-(wallExtent * 1.2f), (wallExtent * 1.2f));
+    std::uniform_real_distribution<float> depthDistribution(-wallExtent, wallExtent);
+    std::uniform_real_distribution<float> extentDistribution(0.5f, 2.0f);
+
+    std::vector<glm::vec3> occludeeMinimums(occludeeCount);
+    std::vector<glm::vec3> occludeeMaximums(occludeeCount);
+    for (uint32_t i = 0; i < occludeeCount; i += 1) {
+        glm::vec3 occludeeCenter = glm::vec3(positionDistribution(randomGenerator), positionDistribution(randomGenerator), depthDistribution(randomGenerator));
+        float occludeeExtent = extentDistribution(randomGenerator);
+        occludeeMinimums[i] = (occludeeCenter - occludeeExtent);
+        occludeeMaximums[i] = (occludeeCenter + occludeeExtent);
+    }
+
+    glm::mat4 projectionMatrix = glm::perspective(glm::radians(45.0f), (static_cast<float>(MaskedOcclusion::bufferWidth) / MaskedOcclusion::bufferHeight), 0.1f, 1000.0f);
+    glm::mat4 viewMatrix = glm::lookAt(glm::vec3(0.0f, 0.0f, -150.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    glm::mat4 cameraMatrix = (projectionMatrix * viewMatrix);
+
+    auto measureMilliseconds = [](std::function<void()> measuredFunction) {
+        std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+        measuredFunction();
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    };
+    const uint32_t iterationCount = 100;
+
+
+    MaskedOcclusion::OcclusionBuffer occlusionBuffer;
+    occlusionBuffer.generateOcclusionBuffer(requestedThreadCount);
+
+    double rasterizeMilliseconds = 0.0;
+    for (uint32_t i = 0; i < iterationCount; i += 1) {
+        rasterizeMilliseconds += measureMilliseconds([&]() { occlusionBuffer.rasterizeOccluders(&wallOccluder, 1, cameraMatrix); });
+    }
+
+    uint32_t occludedCount = 0;
+    double testMilliseconds = 0.0;
+    for (uint32_t i = 0; i < iterationCount; i += 1) {
+        testMilliseconds += measureMilliseconds([&]() {
+            occludedCount = 0;
+            for (uint32_t j = 0; j < occludeeCount; j += 1) {
+                occludedCount += ((occlusionBuffer.testOccludeeBox(occludeeMinimums[j], occludeeMaximums[j], cameraMatrix) == true) ? 1 : 0);
+            }
+        });
+    }
+
+    std::cout << "occlusion benchmark, " << (wallIndices.size() / 3) << " occluder triangles(" << occlusionBuffer.threadCount << " threads): ";
+    std::cout << "rasterize " << (rasterizeMilliseconds / iterationCount) << " ms, ";
+    std::cout << "test " << occludeeCount << " occludees " << (testMilliseconds / iterationCount) << " ms(" << occludedCount << " occluded)" << std::endl;
+
+    occlusionBuffer.cleanupOcclusionBuffer();
+}
\ No newline at end of file
@@ -0,0 +1,123 @@
+#ifndef MASKEDOCCLUSION_H
+#define MASKEDOCCLUSION_H
+
+
+#include <glm/glm.hpp>
+
+#include <core/Worker/WorkerThread.h>
+
+#include <vector>
+#include <cstdint>
+
+
+namespace MaskedOcclusion
+{
+    const uint32_t tileWidth = 8;  // a tile row is one AVX test(two SSE tests).
+    const uint32_t tileHeight = 4;  // a tile's coverage fits in a 32 bit mask.
+    const uint32_t bufferWidth = 320;  // the occlusion buffer is a low resolution stand-in for the camera's depth buffer, a multiple of the tile width.
+    const uint32_t bufferHeight = 192;  // a multiple of the tile height.
+    const uint32_t bufferTileColumnCount = (MaskedOcclusion::bufferWidth / MaskedOcclusion::tileWidth);
+    const uint32_t bufferTileRowCount = (MaskedOcclusion::bufferHeight / MaskedOcclusion::tileHeight);
+
+    struct DepthTile {  // the depths of a tile's pixels, in the camera projection's -1..1 depth range.
+        alignas(32) float pixelDepths[MaskedOcclusion::tileWidth * MaskedOcclusion::tileHeight];  // row major, each row is loaded as one SIMD register.
+        float farthestDepth;  // the farthest of the tile's pixel depths, tested before the pixels themselves.
+    };
+
+    struct OccluderMesh {  // the triangles an occluder rasterizes, a low-poly proxy that never spans more than the occluder itself.
+        std::vector<glm::vec3> positions;  // model space.
+        std::vector<uint32_t> indices;
+    };
+
+    struct Occluder {
+        const MaskedOcclusion::OccluderMesh *occluderMesh;
+        glm::mat4 modelMatrix;
+    };
+
+    struct ScreenTriangle {  // a projected occluder triangle, set up once and rasterized by every thread its tiles overlap.
+        glm::vec3 edgeCoefficients[3];  // each edge function as [a, b, c] of (a * x) + (b * y) + c, positive inside of the triangle.
+        glm::vec3 depthCoefficients;  // the depth plane as [a, b, c], pushed back to the farthest depth over each pixel.
+        float nearestDepth;
+        float farthestDepth;
+
+        uint32_t minimumTileX;  // the tiles overlapped by the triangle's bounds, inclusive.
+        uint32_t minimumTileY;
+        uint32_t maximumTileX;
+        uint32_t maximumTileY;
+    };
+
+    struct OcclusionBuffer {  // a hierarchical depth buffer of occluders rasterized on the CPU, occludee bounds are tested against it before draws are recorded.
+        std::vector<MaskedOcclusion::DepthTile> tiles;  // row major.
+        std::vector<MaskedOcclusion::ScreenTriangle> screenTriangles;  // the triangles of the last rasterization.
+        uint32_t threadCount = 1;  // each thread rasterizes its own band of tile rows.
+        std::vector<WorkerThread::PersistentWorker *> rasterizationWorkers;  // the threads after the calling thread, kept alive between rasterizations.
+
+
+        // generate the occlusion buffer's tiles and start its rasterization threads.
+        //
+        // @param requestedThreadCount the amount of rasterization threads, 0 to use the amount of hardware threads.
+        void generateOcclusionBuffer(uint32_t requestedThreadCount);
+
+        // stop the occlusion buffer's rasterization threads.
+        void cleanupOcclusionBuffer();
+
+        // clear the occlusion buffer and rasterize a set of occluders into it.
+        //
+        // @param occluders the occluders.
+        // @param occluderCount the amount of occluders.
+        // @param cameraMatrix the camera's projection and view matrix.
+        void rasterizeOccluders(const MaskedOcclusion::Occluder occluders[], uint32_t occluderCount, const glm::mat4& cameraMatrix);
+
+        // project and set up the triangles of a set of occluders, triangles crossing the near plane or without area are skipped.
+        //
+        // @param occluders the occluders.
+        // @param occluderCount the amount of occluders.
+        // @param cameraMatrix the camera's projection and view matrix.
+        void setupScreenTriangles(const MaskedOcclusion::Occluder occluders[], uint32_t occluderCount, const glm::mat4& cameraMatrix);
+
+        // clear a band of tile rows and rasterize the set up triangles overlapping it.
+        //
+        // @param firstTileRow the first tile row of the band.
+        // @param tileRowEnd the tile row after the band's last tile row.
+        void rasterizeTileRows(uint32_t firstTileRow, uint32_t tileRowEnd);
+
+        // test if a world space box is hidden behind the rasterized occluders.
+        //
+        // @param boxMinimum the box's minimum corner.
+        // @param boxMaximum the box's maximum corner.
+        // @param cameraMatrix the camera's projection and view matrix, identical to the rasterized one.
+        // @return if every pixel within half a pixel of the box's bounds is nearer than the box's nearest depth.
+        bool testOccludeeBox(const glm::vec3& boxMinimum, const glm::vec3& boxMaximum, const glm::mat4& cameraMatrix) const;
+
+        // rasterize a known occluder and test boxes with known results against it, throwing if any result differs(needs no GPU).
+        //
+        // the boxes include one seen past the occluder's edge within a pixel whose center the occluder covers.
+        void verifyOcclusionBuffer();
+    };
+
+
+    // build an occluder mesh from a mesh, dropping triangles evenly to stay within a triangle budget.
+    //
+    // @param meshPositions the model space positions of the mesh's vertices.
+    // @param meshIndices the mesh's indices, the vertices are drawn in order if empty.
+    // @param maxTriangleCount the maximum amount of occluder triangles.
+    // @param occluderMesh the built occluder mesh, only the kept triangles' vertices are copied.
+    void buildOccluderMesh(const std::vector<glm::vec3>& meshPositions, const std::vector<uint32_t>& meshIndices, uint32_t maxTriangleCount, MaskedOcclusion::OccluderMesh& occluderMesh);
+
+    // rasterize a triangle into a tile, keeping the nearest depth of each pixel whose center the triangle covers.
+    //
+    // @param screenTriangle the triangle.
+    // @param tileX the tile's column.
+    // @param tileY the tile's row.
+    // @param depthTile the tile.
+    void rasterizeTriangleTile(const MaskedOcclusion::ScreenTriangle& screenTriangle, uint32_t tileX, uint32_t tileY, MaskedOcclusion::DepthTile& depthTile);
+
+    // benchmark rasterizing a synthetic occluder and testing synthetic occludees against it, reporting the timings to the standard output.
+    //
+    // @param occludeeCount the amount of synthetic occludees, about half of them behind the occluder.
+    // @param requestedThreadCount the amount of rasterization threads, 0 to use the amount of hardware threads.
+    void benchmarkOcclusionBuffer(uint32_t occludeeCount, uint32_t requestedThreadCount);
+}
+
+
+#endif  // MASKEDOCCLUSION_H
@@ -9,9 +9,10 @@
 #include <core/Defaults/Defaults.h>
 
 #include <array>
+#include <cstring>
 
 
-void Offscreen::OffscreenOperation::generateMemberComponents(int32_t offscreenWidth, int32_t offscreenHeight, uint32_t layerCount, void (*createSpecializedRenderPass)(DeviceHandler::VulkanDevices, VkRenderPass&), void (*createSpecializedPipeline)(VkRenderPass, VkDevice, Pipeline::PipelineComponents&), VkCommandPool graphicsCommandPool, VkQueue graphicsQueue, DeviceHandler::VulkanDevices vulkanDevices)
+void Offscreen::OffscreenOperation::generateMemberComponents(int32_t offscreenWidth, int32_t offscreenHeight, uint32_t layerCount, void (*createSpecializedRenderPass)(DeviceHandler::VulkanDevices, VkRenderPass&), void (*createSpecializedPipeline)(VkRenderPass, VkDevice, bool, Pipeline::PipelineComponents&), void (*createLayerRenderPass)(DeviceHandler::VulkanDevices, VkRenderPass&), VkCommandPool graphicsCommandPool, VkQueue graphicsQueue, DeviceHandler::VulkanDevices vulkanDevices)
 {
     if (layerCount == 6) {
         uint32_t offscreenArea = std::max(offscreenWidth, offscreenHeight);
@@ -23,15 +24,28 @@ void Offscreen::OffscreenOperation::generateMemberComponents(int32_t offscreenWi
     }
     this->renderExtent.width = offscreenWidth;
     this->renderExtent.height = offscreenHeight;
-
-    this->imageViews.resize(layerCount);
+    this->layerCount = layerCount;
 
     
     if (this->beenGenerated == false) {  // if this is the first time this operation is being generated.        
-        Image::createTextureSampler(vulkanDevices, 1, this->depthTextureDetails.textureSampler);
+        Image::createShadowSampler((Defaults::rendererDefaults.SHADOW_FILTER == "NEAREST" ? VK_FILTER_NEAREST : VK_FILTER_LINEAR), VK_TRUE, vulkanDevices.logicalDevice, this->depthTextureDetails.textureSampler);
+        Image::createShadowSampler(VK_FILTER_NEAREST, VK_FALSE, vulkanDevices.logicalDevice, this->depthSampler);  // filtered depths aren't meaningful.
 
         createSpecializedRenderPass(vulkanDevices, this->renderPass);
-        createSpecializedPipeline(this->renderPass, vulkanDevices.logicalDevice, this->pipelineComponents);
+        createSpecializedPipeline(this->renderPass, vulkanDevices.logicalDevice, false, this->pipelineComponents);
+
+        this->maskedPipelineComponents.descriptorSetLayout = this->pipelineComponents.descriptorSetLayout;  // compatible pipeline layouts, the descriptor sets are bound through the pipeline components.
+        createSpecializedPipeline(this->renderPass, vulkanDevices.logicalDevice, true, this->maskedPipelineComponents);
+
+        if (createLayerRenderPass != nullptr) {
+            createLayerRenderPass(vulkanDevices, this->layerRenderPass);
+
+            this->layerPipelineComponents.descriptorSetLayout = this->pipelineComponents.descriptorSetLayout;  // compatible pipeline layouts, the descriptor sets are bound through the pipeline components.
+            createSpecializedPipeline(this->layerRenderPass, vulkanDevices.logicalDevice, false, this->layerPipelineComponents);
+
+            this->maskedLayerPipelineComponents.descriptorSetLayout = this->pipelineComponents.descriptorSetLayout;
+            createSpecializedPipeline(this->layerRenderPass, vulkanDevices.logicalDevice, true, this->maskedLayerPipelineComponents);
+        }
 
         this->beenGenerated = true;
     } else {
@@ -39,47 +53,167 @@ void Offscreen::OffscreenOperation::generateMemberComponents(int32_t offscreenWi
             vkDestroyFramebuffer(vulkanDevices.logicalDevice, framebuffer, nullptr);
         }
         
-        if (this->imageViews.size() == 6) {
-            for (VkImageView imageView : this->imageViews) {
-                vkDestroyImageView(vulkanDevices.logicalDevice, imageView, nullptr);
-            }
+        for (VkImageView imageView : this->imageViews) {
+            vkDestroyImageView(vulkanDevices.logicalDevice, imageView, nullptr);
+        }
+        this->imageViews.clear();
+
+        for (VkFramebuffer layerFramebuffer : this->layerFramebuffers) {
+            vkDestroyFramebuffer(vulkanDevices.logicalDevice, layerFramebuffer, nullptr);
         }
+        for (VkImageView layerImageView : this->layerImageViews) {
+            vkDestroyImageView(vulkanDevices.logicalDevice, layerImageView, nullptr);
+        }
+
+        this->depthTextureDetails.textureImageDetails.cleanupImageDetails(vulkanDevices.logicalDevice);  // the sampler is kept.
     }
 
     
-    Depth::populateDepthImageDetails(this->offscreenExtent, VK_SAMPLE_COUNT_1_BIT, layerCount, VK_IMAGE_USAGE_SAMPLED_BIT, graphicsCommandPool, graphicsQueue, vulkanDevices, this->depthTextureDetails.textureImageDetails);
-    Image::createImageView(this->depthTextureDetails.textureImageDetails.image, this->depthTextureDetails.textureImageDetails.imageFormat, 1, layerCount, VK_IMAGE_ASPECT_DEPTH_BIT, vulkanDevices.logicalDevice, this->depthTextureDetails.textureImageDetails.imageView);
-        
+    VkFormat shadowImageFormat;
+    Depth::selectShadowImageFormat(vulkanDevices.physicalDevice, shadowImageFormat);  // must match the format selected in the operation's render pass.
+    Depth::populateDepthImageDetails(this->offscreenExtent, VK_SAMPLE_COUNT_1_BIT, shadowImageFormat, layerCount, VK_IMAGE_USAGE_SAMPLED_BIT, graphicsCommandPool, graphicsQueue, vulkanDevices, this->depthTextureDetails.textureImageDetails);
     if (layerCount == 6) {
-        VkImageViewCreateInfo imageViewCreateInfo{};
-        Image::populateImageViewCreateInfo(this->depthTextureDetails.textureImageDetails.image, VK_IMAGE_VIEW_TYPE_2D, this->depthTextureDetails.textureImageDetails.imageFormat, VK_IMAGE_ASPECT_DEPTH_BIT, 0, 1, -1, 1, imageViewCreateInfo);
-            
         Image::createImageView(this->depthTextureDetails.textureImageDetails.image, this->depthTextureDetails.textureImageDetails.imageFormat, 1, layerCount, VK_IMAGE_ASPECT_DEPTH_BIT, vulkanDevices.logicalDevice, this->depthTextureDetails.textureImageDetails.imageView);
-        for (size_t i = 0; i < layerCount; i += 1) {
-            imageViewCreateInfo.subresourceRange.baseArrayLayer = i;
+    } else {  // layered(ex: cascaded) shadow maps are always sampled as an array.
+        VkImageViewCreateInfo imageViewCreateInfo{};
+        Image::populateImageViewCreateInfo(this->depthTextureDetails.textureImageDetails.image, VK_IMAGE_VIEW_TYPE_2D_ARRAY, this->depthTextureDetails.textureImageDetails.imageFormat, VK_IMAGE_ASPECT_DEPTH_BIT, 0, 1, 0, layerCount, imageViewCreateInfo);
 
-            VkResult imageViewCreationResult = vkCreateImageView(vulkanDevices.logicalDevice, &imageViewCreateInfo, nullptr, &this->imageViews[i]);
-            if (imageViewCreationResult != VK_SUCCESS) {
-                throwDebugException("Failed to create a offscreen image view.");
-            }
+        VkResult imageViewCreationResult = vkCreateImageView(vulkanDevices.logicalDevice, &imageViewCreateInfo, nullptr, &this->depthTextureDetails.textureImageDetails.imageView);
+        if (imageViewCreationResult != VK_SUCCESS) {
+            throwDebugException("Failed to create a offscreen image view.");
         }
     }
+        
+    VkImageView framebufferImageView = this->depthTextureDetails.textureImageDetails.imageView;
+    if (layerCount == 6) {  // all cubemap faces are rendered in one multiview render pass, which needs a 2D array(not cube) attachment view.
+        VkImageViewCreateInfo imageViewCreateInfo{};
+        Image::populateImageViewCreateInfo(this->depthTextureDetails.textureImageDetails.image, VK_IMAGE_VIEW_TYPE_2D_ARRAY, this->depthTextureDetails.textureImageDetails.imageFormat, VK_IMAGE_ASPECT_DEPTH_BIT, 0, 1, 0, layerCount, imageViewCreateInfo);
+            
+        this->imageViews.resize(1);
+        VkResult imageViewCreationResult = vkCreateImageView(vulkanDevices.logicalDevice, &imageViewCreateInfo, nullptr, &this->imageViews[0]);
+        if (imageViewCreationResult != VK_SUCCESS) {
+            throwDebugException("Failed to create a offscreen image view.");
+        }
+
+        framebufferImageView = this->imageViews[0];
+    }
     
     // similar to SwapchainHandler::createSwapchainFramebuffers.
-    this->framebuffers.resize(Defaults::rendererDefaults.MAX_FRAMES_IN_FLIGHT * layerCount);
+    this->framebuffers.resize(Defaults::rendererDefaults.MAX_FRAMES_IN_FLIGHT);
+
+    std::array<VkImageView, 1> framebufferAttachments = {framebufferImageView};
+
+    VkFramebufferCreateInfo framebufferCreateInfo{};
+    SwapchainHandler::populateFramebufferCreateInfo(this->renderPass, framebufferAttachments.data(), static_cast<uint32_t>(framebufferAttachments.size()), this->offscreenExtent.width, this->offscreenExtent.height, framebufferCreateInfo);  // one framebuffer layer, multiview selects the attachment layers.
+    for (size_t i = 0; i < Defaults::rendererDefaults.MAX_FRAMES_IN_FLIGHT; i += 1) {
+        VkResult framebufferCreationResult = vkCreateFramebuffer(vulkanDevices.logicalDevice, &framebufferCreateInfo, nullptr, &this->framebuffers[i]);
+        if (framebufferCreationResult != VK_SUCCESS) {
+            throwDebugException("Failed to create a offscreen operation framebuffer.");
+        }
+    }
+
+    if (this->layerRenderPass != VK_NULL_HANDLE) {  // a single layer view and framebuffer for each layer, shared between frames in flight.
+        this->layerImageViews.resize(layerCount);
+        this->layerFramebuffers.resize(layerCount);
+        for (uint32_t i = 0; i < layerCount; i += 1) {
+            VkImageViewCreateInfo layerImageViewCreateInfo{};
+            Image::populateImageViewCreateInfo(this->depthTextureDetails.textureImageDetails.image, VK_IMAGE_VIEW_TYPE_2D, this->depthTextureDetails.textureImageDetails.imageFormat, VK_IMAGE_ASPECT_DEPTH_BIT, 0, 1, i, 1, layerImageViewCreateInfo);
+
+            VkResult layerImageViewCreationResult = vkCreateImageView(vulkanDevices.logicalDevice, &layerImageViewCreateInfo, nullptr, &this->layerImageViews[i]);
+            if (layerImageViewCreationResult != VK_SUCCESS) {
+                throwDebugException("Failed to create a offscreen layer image view.");
+            }
 
-    for (size_t i = 0; i < layerCount; i += 1) {
-        std::array<VkImageView, 1> framebufferAttachments = {(layerCount == 6 ? this->imageViews[i] : this->depthTextureDetails.textureImageDetails.imageView)};
+            std::array<VkImageView, 1> layerFramebufferAttachments = {this->layerImageViews[i]};
 
-        VkFramebufferCreateInfo framebufferCreateInfo{};
-        SwapchainHandler::populateFramebufferCreateInfo(this->renderPass, framebufferAttachments.data(), static_cast<uint32_t>(framebufferAttachments.size()), this->offscreenExtent.width, this->offscreenExtent.height, framebufferCreateInfo);
-        for (size_t j = 0; j < Defaults::rendererDefaults.MAX_FRAMES_IN_FLIGHT; j += 1) {
-            VkResult framebufferCreationResult = vkCreateFramebuffer(vulkanDevices.logicalDevice, &framebufferCreateInfo, nullptr, &this->framebuffers[j + (i * Defaults::rendererDefaults.MAX_FRAMES_IN_FLIGHT)]);
-            if (framebufferCreationResult != VK_SUCCESS) {
-                throwDebugException("Failed to create a offscreen operation framebuffer.");
+            VkFramebufferCreateInfo layerFramebufferCreateInfo{};
+            SwapchainHandler::populateFramebufferCreateInfo(this->layerRenderPass, layerFramebufferAttachments.data(), static_cast<uint32_t>(layerFramebufferAttachments.size()), this->offscreenExtent.width, this->offscreenExtent.height, layerFramebufferCreateInfo);
+
+            VkResult layerFramebufferCreationResult = vkCreateFramebuffer(vulkanDevices.logicalDevice, &layerFramebufferCreateInfo, nullptr, &this->layerFramebuffers[i]);
+            if (layerFramebufferCreationResult != VK_SUCCESS) {
+                throwDebugException("Failed to create a offscreen operation layer framebuffer.");
             }
         }
     }
+
+    this->layerAges.assign(layerCount, 0);
+    this->layerCasterMasks.assign(layerCount, 0);
+    this->layersUndefined = true;
+    this->invalidateShadowCache();  // the depth image was (re)created.
+}
+
+bool Offscreen::OffscreenOperation::shadowCacheValid(const void *shadowState, size_t shadowStateSize)
+{
+    const char *shadowStateBytes = static_cast<const char *>(shadowState);
+    if ((this->cachedShadowState.size() == shadowStateSize) && (std::memcmp(this->cachedShadowState.data(), shadowStateBytes, shadowStateSize) == 0)) {
+        return true;
+    }
+
+    this->cachedShadowState.assign(shadowStateBytes, (shadowStateBytes + shadowStateSize));
+    this->staleLayerMask = ((1u << this->layerCount) - 1);
+    return false;
+}
+
+void Offscreen::OffscreenOperation::invalidateShadowCache()
+{
+    this->cachedShadowState.clear();
+}
+
+uint32_t Offscreen::OffscreenOperation::selectLayerUpdates(uint32_t layerBudget, uint32_t priorityLayerMask, const std::vector<uint32_t>& layerCasterMasks)
+{
+    for (uint32_t& layerAge : this->layerAges) {
+        layerAge += 1;
+    }
+
+    for (uint32_t i = 0; i < this->layerCount; i += 1) {
+        if (layerCasterMasks[i] != this->layerCasterMasks[i]) {  // the casters drawn in the layer changed.
+            this->staleLayerMask |= (1u << i);
+        } else if ((layerCasterMasks[i] == 0) && (this->layersUndefined == false)) {  // still cleared from the last render, its render pass is skipped.
+            this->staleLayerMask &= ~(1u << i);
+        }
+    }
+    
+    if (this->staleLayerMask == 0) {
+        return 0;
+    }
+
+    uint32_t selectedLayerMask = 0;
+    if ((this->layerRenderPass == VK_NULL_HANDLE) || (this->layersUndefined == true)) {
+        selectedLayerMask = ((1u << this->layerCount) - 1);  // all layers are rendered together.
+        this->layersUndefined = false;
+    } else {
+        for (uint32_t i = 0; i < layerBudget; i += 1) {
+            int32_t selectedLayer = -1;
+            uint32_t selectedLayerPriority = 0;
+            for (uint32_t j = 0; j < this->layerCount; j += 1) {
+                if ((this->staleLayerMask & ~selectedLayerMask & (1u << j)) == 0) {
+                    continue;
+                }
+
+                // priority layers age four times as fast, but every stale layer is eventually rendered.
+                uint32_t layerPriority = (this->layerAges[j] * (((priorityLayerMask & (1u << j)) != 0) ? 4 : 1));
+                if ((selectedLayer == -1) || (layerPriority > selectedLayerPriority)) {
+                    selectedLayer = static_cast<int32_t>(j);
+                    selectedLayerPriority = layerPriority;
+                }
+            }
+            if (selectedLayer == -1) {  // every stale layer is selected.
+                break;
+            }
+
+            selectedLayerMask |= (1u << selectedLayer);
+        }
+    }
+
+    this->staleLayerMask &= ~selectedLayerMask;
+    for (uint32_t i = 0; i < this->layerCount; i += 1) {
+        if ((selectedLayerMask & (1u << i)) != 0) {
+            this->layerAges[i] = 0;
+            this->layerCasterMasks[i] = layerCasterMasks[i];
+        }
+    }
+
+    return selectedLayerMask;
 }
 
 void Offscreen::OffscreenOperation::cleanupOffscreenOperation(VkDevice vulkanLogicalDevice)
@@ -92,9 +226,28 @@ void Offscreen::OffscreenOperation::cleanupOffscreenOperation(VkDevice vulkanLog
         vkDestroyImageView(vulkanLogicalDevice, imageView, nullptr);
     }
 
+    for (VkFramebuffer layerFramebuffer : this->layerFramebuffers) {
+        vkDestroyFramebuffer(vulkanLogicalDevice, layerFramebuffer, nullptr);
+    }
+    for (VkImageView layerImageView : this->layerImageViews) {
+        vkDestroyImageView(vulkanLogicalDevice, layerImageView, nullptr);
+    }
+
     this->depthTextureDetails.cleanupTextureDetails(vulkanLogicalDevice);
+    vkDestroySampler(vulkanLogicalDevice, this->depthSampler, nullptr);
     
     this->pipelineComponents.cleanupPipelineComponents(vulkanLogicalDevice);
+    vkDestroyPipeline(vulkanLogicalDevice, this->maskedPipelineComponents.pipeline, nullptr);  // the masked pipeline components share the pipeline components' descriptors.
+    vkDestroyPipelineLayout(vulkanLogicalDevice, this->maskedPipelineComponents.pipelineLayout, nullptr);
 
     vkDestroyRenderPass(vulkanLogicalDevice, this->renderPass, nullptr);
+
+    if (this->layerRenderPass != VK_NULL_HANDLE) {  // the layer pipeline components share the pipeline components' descriptors.
+        vkDestroyPipeline(vulkanLogicalDevice, this->layerPipelineComponents.pipeline, nullptr);
+        vkDestroyPipelineLayout(vulkanLogicalDevice, this->layerPipelineComponents.pipelineLayout, nullptr);
+        vkDestroyPipeline(vulkanLogicalDevice, this->maskedLayerPipelineComponents.pipeline, nullptr);
+        vkDestroyPipelineLayout(vulkanLogicalDevice, this->maskedLayerPipelineComponents.pipelineLayout, nullptr);
+
+        vkDestroyRenderPass(vulkanLogicalDevice, this->layerRenderPass, nullptr);
+    }
 }
@@ -19,27 +19,70 @@ namespace Offscreen
         VkExtent2D renderExtent;  // the extent of the area to render in.
         std::vector<VkFramebuffer> framebuffers;  // multiple frames-in-flight.
 
-        Image::TextureDetails depthTextureDetails;  // framebuffer depth attachment.
+        Image::TextureDetails depthTextureDetails;  // framebuffer depth attachment, its sampler is a comparison sampler.
+        VkSampler depthSampler = VK_NULL_HANDLE;  // samples the stored depth without comparison(ex: PCSS blocker searches).
 
-        std::vector<VkImageView> imageViews;
+        std::vector<VkImageView> imageViews;  // the 2D array framebuffer attachment view of a cubemap operation.
 
         Pipeline::PipelineComponents pipelineComponents;
+        Pipeline::PipelineComponents maskedPipelineComponents;  // draws the alpha-masked casters, only the pipeline and pipeline layout(descriptors are shared with the pipeline components).
         VkRenderPass renderPass;
 
+        uint32_t layerCount;  // the amount of layers in the depth image.
+
+        // per-layer(time-sliced) rendering, only generated if a layer render pass creation function is passed.
+        VkRenderPass layerRenderPass = VK_NULL_HANDLE;  // renders a single layer without multiview.
+        Pipeline::PipelineComponents layerPipelineComponents;  // only the pipeline and pipeline layout, descriptors are shared with the pipeline components.
+        Pipeline::PipelineComponents maskedLayerPipelineComponents;  // see maskedPipelineComponents.
+        std::vector<VkImageView> layerImageViews;  // a single layer framebuffer attachment view of each layer.
+        std::vector<VkFramebuffer> layerFramebuffers;  // a framebuffer for each layer.
+
         bool beenGenerated = false;  // if the components have been generated before.
 
+        // the whole shadow map is cached as one state, a change re-renders every layer with casters in it.
+        // there is no static depth copy to composite moving casters over, the main mesh is the only caster.
+        std::vector<char> cachedShadowState;  // the shadow state the shadow map was last rendered with, empty if invalidated.
+        uint32_t staleLayerMask = 0;  // the layers not rendered since the shadow state last changed.
+        std::vector<uint32_t> layerAges;  // the amount of frames since each layer was last rendered.
+        std::vector<uint32_t> layerCasterMasks;  // the shadow casters drawn in each layer when it was last rendered.
+        bool layersUndefined = true;  // if the depth image's contents are undefined, all layers must be rendered at once.
+
 
         // generate the member offscreen operation components.
         //
         // @param offscreenWidth the width of the offscreen "image".
         // @param offscreenHeight the height of the offscreen "image".
-        // @param layerCount the amount of layers in the depth image.
+        // @param layerCount the amount of layers in the depth image(6 for a cubemap), each rendered to by a multiview view.
         // @param createSpecializedRenderPass a passed in reference to a function used for creating the operation's render pass.
-        // @param createSpecializedPipeline a passed in reference to a function used for creating the operation's pipeline.
+        // @param createSpecializedPipeline a passed in reference to a function used for creating the operation's pipeline, and its alpha-masked pipeline.
+        // @param createLayerRenderPass optional(nullptr to disable) function used for creating a single layer render pass, enabling per-layer rendering.
         // @param graphicsCommandPool the command pool used for graphics operations.
         // @param graphicsQueue the queue used for graphics commands.
         // @param vulkanDevices Vulkan physical and logical device to use in member components generation.
-        void generateMemberComponents(int32_t offscreenWidth, int32_t offscreenHeight, uint32_t layerCount, void (*createSpecializedRenderPass)(DeviceHandler::VulkanDevices, VkRenderPass&), void (*createSpecializedPipeline)(VkRenderPass, VkDevice, Pipeline::PipelineComponents&), VkCommandPool graphicsCommandPool, VkQueue graphicsQueue, DeviceHandler::VulkanDevices vulkanDevices);
+        void generateMemberComponents(int32_t offscreenWidth, int32_t offscreenHeight, uint32_t layerCount, void (*createSpecializedRenderPass)(DeviceHandler::VulkanDevices, VkRenderPass&), void (*createSpecializedPipeline)(VkRenderPass, VkDevice, bool, Pipeline::PipelineComponents&), void (*createLayerRenderPass)(DeviceHandler::VulkanDevices, VkRenderPass&), VkCommandPool graphicsCommandPool, VkQueue graphicsQueue, DeviceHandler::VulkanDevices vulkanDevices);
+
+        // test if the shadow map rendered last is still valid for the current shadow state, caching the state and marking every layer stale if not.
+        //
+        // the shadow state must hold everything the shadow map depends on(ex: light matrices and caster transforms), without padding.
+        //
+        // @param shadowState the current shadow state.
+        // @param shadowStateSize the size of the shadow state in bytes.
+        // @return if the shadow map can be reused without re-rendering.
+        bool shadowCacheValid(const void *shadowState, size_t shadowStateSize);
+
+        // invalidate the cached shadow map(ex: after the set of shadow casters changed).
+        void invalidateShadowCache();
+
+        // select the stale layers to render this frame, oldest first with priority layers aging faster.
+        //
+        // layers whose casters changed become stale, and stale layers without casters that were already empty are left cleared.
+        // every stale layer is selected without per-layer rendering or while the depth image's contents are undefined.
+        //
+        // @param layerBudget the maximum amount of layers to render with per-layer rendering.
+        // @param priorityLayerMask the layers to prioritize(ex: cubemap faces visible to the camera).
+        // @param layerCasterMasks the shadow casters left after culling in each layer.
+        // @return the mask of the layers to render, 0 if the shadow map is up to date.
+        uint32_t selectLayerUpdates(uint32_t layerBudget, uint32_t priorityLayerMask, const std::vector<uint32_t>& layerCasterMasks);
 
         // cleanup the offscreen operation.
         //
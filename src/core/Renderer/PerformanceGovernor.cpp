@@ -0,0 +1,165 @@
+#define GLFW_INCLUDE_VULKAN
+#include <GLFW/glfw3.h>
+
+#include <core/Renderer/PerformanceGovernor.h>
+#include <core/Renderer/DynamicResolution.h>
+#include <core/Defaults/Defaults.h>
+
+#include <string>
+#include <array>
+#include <algorithm>
+#include <iostream>
+#include <cstdint>
+
+
+// count the times a value can be halved before it falls below a floor.
+//
+// @param value the halved value.
+// @param floor the smallest value kept.
+// @return the amount of halvings.
+static uint32_t countHalvings(uint32_t value, uint32_t floor)
+{
+    uint32_t halvingCount = 0;
+    while ((floor > 0) && ((value >> (halvingCount + 1)) >= floor)) {
+        halvingCount += 1;
+    }
+
+    return halvingCount;
+}
+
+void PerformanceGovernor::QualityGovernor::generateGovernor(bool governorEnabled, float targetFrameTime, VkSampleCountFlagBits msaaSampleCount)
+{
+    this->governorEnabled = governorEnabled;
+    this->targetFrameTime = targetFrameTime;
+
+    this->resetGovernor(msaaSampleCount);
+}
+
+void PerformanceGovernor::QualityGovernor::resetGovernor(VkSampleCountFlagBits msaaSampleCount)
+{
+    this->knobLimits[PerformanceGovernor::shadowAtlasTileKnob] = countHalvings(Defaults::rendererDefaults.SHADOW_ATLAS_MAXIMUM_TILE_SIZE, Defaults::rendererDefaults.SHADOW_ATLAS_MINIMUM_TILE_SIZE);
+    this->knobLimits[PerformanceGovernor::pointShadowFaceKnob] = countHalvings(Defaults::rendererDefaults.POINT_SHADOW_FACE_BUDGET, 1);
+    this->knobLimits[PerformanceGovernor::msaaSampleCountKnob] = countHalvings(static_cast<uint32_t>(msaaSampleCount), 2);  // 0 for a single-sampled mode.
+    this->knobLimits[PerformanceGovernor::sceneLightCapKnob] = 3;
+    this->knobLimits[PerformanceGovernor::textureLodBiasKnob] = 2;
+
+    this->maximumQualityStep = 0;
+    for (uint32_t knobLimit : this->knobLimits) {
+        this->maximumQualityStep += knobLimit;
+    }
+    this->applyQualityStep(0);
+
+    this->smoothedCpuFrameTime = 0.0f;
+    this->overBudgetFrameCount = 0;
+    this->headroomFrameCount = 0;
+    this->settleFramesLeft = PerformanceGovernor::settleFrameCount;
+}
+
+void PerformanceGovernor::QualityGovernor::updateGovernor(const DynamicResolution::ResolutionController& resolutionController, bool resolutionScaled, float cpuFrameTime, bool& msaaSampleCountChanged)
+{
+    msaaSampleCountChanged = false;
+    if ((this->governorEnabled == false) || (this->targetFrameTime <= 0.0f)) {
+        return;
+    }
+
+    if (cpuFrameTime > 0.0f) {
+        this->smoothedCpuFrameTime = ((this->smoothedCpuFrameTime == 0.0f) ? cpuFrameTime : (this->smoothedCpuFrameTime + (DynamicResolution::frameTimeSmoothingFactor * (cpuFrameTime - this->smoothedCpuFrameTime))));
+    }
+    float frameTime = std::max(resolutionController.smoothedFrameTime, this->smoothedCpuFrameTime);  // the slower of the GPU and the CPU bounds the frame rate.
+    if ((frameTime <= 0.0f) || (this->settleFramesLeft > 0)) {
+        this->settleFramesLeft -= ((this->settleFramesLeft > 0) ? 1 : 0);
+        return;
+    }
+
+    if (frameTime > (this->targetFrameTime * PerformanceGovernor::overBudgetRatio)) {
+        this->overBudgetFrameCount += 1;
+        this->headroomFrameCount = 0;
+    }
+    else if (frameTime < (this->targetFrameTime * PerformanceGovernor::headroomRatio)) {
+        this->headroomFrameCount += 1;
+        this->overBudgetFrameCount = 0;
+    }
+    else {
+        this->overBudgetFrameCount = 0;
+        this->headroomFrameCount = 0;
+    }
+
+    // dynamic resolution reacts first, the knobs are only stepped once the render scale can't absorb the difference.
+    bool lowerQuality = ((this->overBudgetFrameCount >= PerformanceGovernor::lowerFrameCount) && (this->qualityStep < this->maximumQualityStep));
+    lowerQuality = (lowerQuality && ((resolutionScaled == false) || (resolutionController.renderScale <= resolutionController.minimumRenderScale)));
+    bool raiseQuality = ((this->headroomFrameCount >= PerformanceGovernor::raiseFrameCount) && (this->qualityStep > 0));
+    raiseQuality = (raiseQuality && ((resolutionScaled == false) || (resolutionController.renderScale >= 1.0f)));
+    if ((lowerQuality == false) && (raiseQuality == false)) {
+        return;
+    }
+
+    std::array<uint32_t, PerformanceGovernor::knobCount> previousKnobLevels = this->knobLevels;
+    this->applyQualityStep((lowerQuality == true) ? (this->qualityStep + 1) : (this->qualityStep - 1));
+
+    this->overBudgetFrameCount = 0;
+    this->headroomFrameCount = 0;
+    this->settleFramesLeft = PerformanceGovernor::settleFrameCount;
+
+    for (uint32_t i = 0; i < PerformanceGovernor::knobCount; i += 1) {
+        if (this->knobLevels[i] == previousKnobLevels[i]) {
+            continue;
+        }
+
+        std::string decisionReport = ("quality governor: " + std::string((lowerQuality == true) ? "lowered " : "raised ") + PerformanceGovernor::knobNames[i] + " to level " + std::to_string(this->knobLevels[i]) + " of " + std::to_string(this->knobLimits[i]));
+        decisionReport += ("(gpu " + std::to_string(resolutionController.smoothedFrameTime) + "ms, cpu " + std::to_string(this->smoothedCpuFrameTime) + "ms, target " + std::to_string(this->targetFrameTime) + "ms");
+
+        auto heaviestPass = std::max_element(resolutionController.passTimes.begin(), resolutionController.passTimes.end(), [](const auto& firstPassTime, const auto& secondPassTime) { return firstPassTime.second < secondPassTime.second; });
+        if (heaviestPass != resolutionController.passTimes.end()) {
+            decisionReport += (", heaviest pass " + heaviestPass->first + " " + std::to_string(heaviestPass->second) + "ms");
+        }
+        std::cout << decisionReport << ")" << std::endl;
+
+        msaaSampleCountChanged = (msaaSampleCountChanged || (i == PerformanceGovernor::msaaSampleCountKnob));
+    }
+}
+
+void PerformanceGovernor::QualityGovernor::fetchShadowAtlasTileSize(uint32_t maximumTileSize, uint32_t minimumTileSize, uint32_t& governedTileSize) const
+{
+    governedTileSize = std::max((maximumTileSize >> this->knobLevels[PerformanceGovernor::shadowAtlasTileKnob]), minimumTileSize);
+}
+
+void PerformanceGovernor::QualityGovernor::fetchPointShadowFaceBudget(uint32_t faceBudget, uint32_t& governedFaceBudget) const
+{
+    governedFaceBudget = std::max((faceBudget >> this->knobLevels[PerformanceGovernor::pointShadowFaceKnob]), 1u);
+}
+
+void PerformanceGovernor::QualityGovernor::fetchMsaaSampleCount(VkSampleCountFlagBits& msaaSampleCount) const
+{
+    if (msaaSampleCount == VK_SAMPLE_COUNT_1_BIT) {
+        return;
+    }
+
+    msaaSampleCount = static_cast<VkSampleCountFlagBits>(std::max((static_cast<uint32_t>(msaaSampleCount) >> this->knobLevels[PerformanceGovernor::msaaSampleCountKnob]), 2u));
+}
+
+void PerformanceGovernor::QualityGovernor::fetchSceneLightFraction(float& sceneLightFraction) const
+{
+    sceneLightFraction = (1.0f / static_cast<float>(1u << this->knobLevels[PerformanceGovernor::sceneLightCapKnob]));
+}
+
+void PerformanceGovernor::QualityGovernor::fetchTextureLodBias(float& textureLodBias) const
+{
+    textureLodBias = static_cast<float>(this->knobLevels[PerformanceGovernor::textureLodBiasKnob]);
+}
+
+void PerformanceGovernor::QualityGovernor::applyQualityStep(uint32_t qualityStep)
+{
+    this->qualityStep = std::min(qualityStep, this->maximumQualityStep);
+    this->knobLevels.fill(0);
+
+    // every step lowers the next knob in order, skipping the knobs at their limit.
+    uint32_t knobIndex = 0;
+    for (uint32_t i = 0; i < this->qualityStep; i += 1) {
+        while (this->knobLevels[knobIndex] == this->knobLimits[knobIndex]) {
+            knobIndex = ((knobIndex + 1) % PerformanceGovernor::knobCount);
+        }
+
+        this->knobLevels[knobIndex] += 1;
+        knobIndex = ((knobIndex + 1) % PerformanceGovernor::knobCount);
+    }
+}
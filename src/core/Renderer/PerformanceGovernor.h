@@ -0,0 +1,104 @@
+#ifndef PERFORMANCEGOVERNOR_H
+#define PERFORMANCEGOVERNOR_H
+
+
+#define GLFW_INCLUDE_VULKAN
+#include <GLFW/glfw3.h>
+
+#include <core/Renderer/DynamicResolution.h>
+
+#include <string>
+#include <array>
+#include <cstdint>
+
+
+namespace PerformanceGovernor
+{
+    const uint32_t knobCount = 5;
+    const std::array<std::string, PerformanceGovernor::knobCount> knobNames = {"shadow atlas tile size", "point shadow face budget", "msaa sample count", "scene light cap", "texture lod bias"};  // every quality knob, lowered in this order(one level each in turn) and raised in reverse.
+    const uint32_t shadowAtlasTileKnob = 0;  // halves the largest shadow atlas tile for each level, down to the smallest tile(the directional cascades and point cubemap keep their resolution, resizing them would stall the frame).
+    const uint32_t pointShadowFaceKnob = 1;  // halves the point shadow faces re-rendered per frame for each level, down to a single face.
+    const uint32_t msaaSampleCountKnob = 2;  // halves the msaa samples for each level, down to 2 samples(only with a multisampled mode).
+    const uint32_t sceneLightCapKnob = 3;  // halves the shaded scene lights for each level, down to an eighth of them.
+    const uint32_t textureLodBiasKnob = 4;  // biases the scene's material textures a mip level further for each level, up to 2 mip levels.
+
+    const float overBudgetRatio = 1.05f;  // the frame time above the target(as a ratio) counted as over budget.
+    const float headroomRatio = 0.8f;  // the frame time below the target(as a ratio) counted as headroom, the band between the ratios holds the quality.
+    const uint32_t lowerFrameCount = 30;  // the consecutive over budget frames before the quality is lowered.
+    const uint32_t raiseFrameCount = 180;  // the consecutive headroom frames before the quality is raised, slower than lowering to avoid oscillating.
+    const uint32_t settleFrameCount = 60;  // the frames ignored after a change, the smoothed frame times settle at the new quality.
+
+    struct QualityGovernor {  // steps quality knobs down while the GPU or CPU frame time is over a budget, and back up once there is headroom again.
+        bool governorEnabled;  // the knobs are kept at full quality otherwise.
+        float targetFrameTime;  // the frame time budget in milliseconds.
+
+        std::array<uint32_t, PerformanceGovernor::knobCount> knobLimits;  // the lowest quality level of each knob, 0 if the knob has no effect.
+        std::array<uint32_t, PerformanceGovernor::knobCount> knobLevels;  // the current quality level of each knob, 0 at full quality.
+        uint32_t qualityStep;  // the amount of knob levels lowered, the knob levels follow from it.
+        uint32_t maximumQualityStep;  // every knob at its limit.
+
+        float smoothedCpuFrameTime;  // exponentially smoothed like the GPU frame time, 0 before the first measurement.
+        uint32_t overBudgetFrameCount;
+        uint32_t headroomFrameCount;
+        uint32_t settleFramesLeft;
+
+
+        // generate the governor at full quality.
+        //
+        // @param governorEnabled if the quality is governed.
+        // @param targetFrameTime the frame time budget in milliseconds, 0 keeps the full quality.
+        // @param msaaSampleCount the ungoverned amount of msaa samples, limiting the msaa knob.
+        void generateGovernor(bool governorEnabled, float targetFrameTime, VkSampleCountFlagBits msaaSampleCount);
+
+        // return every knob to full quality(ex: after the anti-aliasing mode is changed by hand).
+        //
+        // @param msaaSampleCount the new ungoverned amount of msaa samples, limiting the msaa knob.
+        void resetGovernor(VkSampleCountFlagBits msaaSampleCount);
+
+        // measure the frame and step the quality if it stayed over budget or under the headroom, logging every step.
+        //
+        // while the resolution controller scales the resolution, the quality is only lowered at its minimum render scale and raised at full resolution.
+        //
+        // @param resolutionController the resolution controller measuring the GPU frame and pass times.
+        // @param resolutionScaled if the resolution controller's render scale is applied.
+        // @param cpuFrameTime the CPU time of the previous frame in milliseconds.
+        // @param msaaSampleCountChanged if the msaa knob changed, the renderer applies the new sample count.
+        void updateGovernor(const DynamicResolution::ResolutionController& resolutionController, bool resolutionScaled, float cpuFrameTime, bool& msaaSampleCountChanged);
+
+        // fetch the largest shadow atlas tile at the shadow atlas tile knob's level.
+        //
+        // @param maximumTileSize the configured largest tile.
+        // @param minimumTileSize the configured smallest tile.
+        // @param governedTileSize the fetched largest tile.
+        void fetchShadowAtlasTileSize(uint32_t maximumTileSize, uint32_t minimumTileSize, uint32_t& governedTileSize) const;
+
+        // fetch the point shadow face budget at the point shadow face knob's level.
+        //
+        // @param faceBudget the configured face budget.
+        // @param governedFaceBudget the fetched face budget.
+        void fetchPointShadowFaceBudget(uint32_t faceBudget, uint32_t& governedFaceBudget) const;
+
+        // fetch the amount of msaa samples at the msaa knob's level.
+        //
+        // @param msaaSampleCount the ungoverned amount of msaa samples, replaced with the governed amount.
+        void fetchMsaaSampleCount(VkSampleCountFlagBits& msaaSampleCount) const;
+
+        // fetch the fraction of the scene lights shaded at the scene light cap knob's level.
+        //
+        // @param sceneLightFraction the fetched fraction, the lights beyond it are dropped.
+        void fetchSceneLightFraction(float& sceneLightFraction) const;
+
+        // fetch the material texture lod bias at the texture lod bias knob's level.
+        //
+        // @param textureLodBias the fetched lod bias in mip levels.
+        void fetchTextureLodBias(float& textureLodBias) const;
+
+        // apply a quality step, updating the knob levels(a step lowers the next knob in order that isn't at its limit).
+        //
+        // @param qualityStep the quality step to apply, clamped to the maximum quality step.
+        void applyQualityStep(uint32_t qualityStep);
+    };
+}
+
+
+#endif  // PERFORMANCEGOVERNOR_H
@@ -54,7 +54,7 @@ void Pipeline::PipelineComponents::createMemberPipeline(Pipeline::PipelineData&
 
 
     VkPipelineMultisampleStateCreateInfo multisamplingCreateInfo{};
-    RendererDetails::populateMultisamplingCreateInfo(pipelineData.multisamplingRasterizationSamples, pipelineData.multisamplingMinSampleShading, multisamplingCreateInfo);
+    RendererDetails::populateMultisamplingCreateInfo(pipelineData.multisamplingRasterizationSamples, pipelineData.multisamplingMinSampleShading, pipelineData.multisamplingAlphaToCoverageEnable, multisamplingCreateInfo);
 
 
     VkPipelineDepthStencilStateCreateInfo depthStencilCreateInfo{};
@@ -64,6 +64,10 @@ void Pipeline::PipelineComponents::createMemberPipeline(Pipeline::PipelineData&
     VkPipelineColorBlendStateCreateInfo colorBlendCreateInfo{};
     RendererDetails::populateColorBlendComponents(pipelineData.colorBlendColorWriteMask, pipelineData.colorBlendBlendEnable, colorBlendAttachment, colorBlendCreateInfo);
 
+    std::vector<VkPipelineColorBlendAttachmentState> colorBlendAttachments(pipelineData.colorBlendAttachmentCount, colorBlendAttachment);  // every color attachment of the subpass is blended alike.
+    colorBlendCreateInfo.attachmentCount = pipelineData.colorBlendAttachmentCount;
+    colorBlendCreateInfo.pAttachments = colorBlendAttachments.data();
+
 
     VkPipelineDynamicStateCreateInfo dynamicStatesCreateInfo{};
     RendererDetails::populateDynamicStatesCreateInfo(pipelineData.dynamicStatesDynamicStates, dynamicStatesCreateInfo);
@@ -89,7 +93,7 @@ void Pipeline::PipelineComponents::createMemberPipeline(Pipeline::PipelineData&
 
     pipelineCreateInfo.layout = this->pipelineLayout;
     pipelineCreateInfo.renderPass = pipelineData.pipelineRenderPass;
-    pipelineCreateInfo.subpass = 0;
+    pipelineCreateInfo.subpass = pipelineData.pipelineSubpass;
 
     pipelineCreateInfo.basePipelineHandle = VK_NULL_HANDLE;
     pipelineCreateInfo.basePipelineIndex = -1;
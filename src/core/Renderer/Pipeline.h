@@ -42,6 +42,7 @@ namespace Pipeline
         // multisampling data.
         VkSampleCountFlagBits multisamplingRasterizationSamples;
         float multisamplingMinSampleShading;
+        VkBool32 multisamplingAlphaToCoverageEnable = VK_FALSE;  // the first color output's alpha masks the covered samples(ex: alpha-masked geometry under msaa).
 
         // depth stencil data.
         VkBool32 depthStencilDepthTestEnable;
@@ -51,12 +52,14 @@ namespace Pipeline
         // color blend data.
         VkColorComponentFlags colorBlendColorWriteMask;
         VkBool32 colorBlendBlendEnable;
+        uint32_t colorBlendAttachmentCount = 1;  // the amount of color attachments in the pipeline's subpass.
 
         // dynamic states data.
         std::vector<VkDynamicState> dynamicStatesDynamicStates;
 
         // misc. pipeline data.
         VkRenderPass pipelineRenderPass;
+        uint32_t pipelineSubpass = 0;  // the subpass of the render pass the pipeline is used in.
         std::optional<VkPushConstantRange *> pushConstant;  // does not have to be assigned.
     };
     
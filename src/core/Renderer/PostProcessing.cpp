@@ -0,0 +1,392 @@
+#define GLFW_INCLUDE_VULKAN
+#include <GLFW/glfw3.h>
+
+#include <core/Renderer/PostProcessing.h>
+#include <core/Renderer/Renderer.h>
+#include <core/Shader/Shader.h>
+#include <core/Shader/Uniform.h>
+#include <core/Shader/Image.h>
+#include <core/Shader/ResourceDescriptor.h>
+#include <core/Command/CommandManager.h>
+#include <core/Buffer/Buffer.h>
+#include <core/Logging/ErrorLogger.h>
+#include <core/Defaults/Defaults.h>
+
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+
+// create a post-processing compute pipeline with the post-processing pipeline layout.
+//
+// @param computeShaderName the name of the compute shader's bytecode in the build directory.
+// @param pipelineLayout the post-processing pipeline layout.
+// @param vulkanLogicalDevice Vulkan logical device to use in compute pipeline creation.
+// @param pipeline created compute pipeline.
+static void createPostPipeline(std::string computeShaderName, VkPipelineLayout pipelineLayout, VkDevice vulkanLogicalDevice, VkPipeline& pipeline)
+{
+    Shader::Shader postComputeShader;
+    Shader::createShader((Defaults::applicationDefaults.SALAMANDER_ROOT_DIRECTORY + "/build/" + computeShaderName), VK_SHADER_STAGE_COMPUTE_BIT, vulkanLogicalDevice, postComputeShader);
+
+    VkComputePipelineCreateInfo computePipelineCreateInfo{};
+    computePipelineCreateInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+
+    computePipelineCreateInfo.stage = postComputeShader.shaderStageCreateInfo;
+    computePipelineCreateInfo.layout = pipelineLayout;
+
+    computePipelineCreateInfo.basePipelineHandle = VK_NULL_HANDLE;
+    computePipelineCreateInfo.basePipelineIndex = -1;
+
+    VkResult computePipelineCreationResult = vkCreateComputePipelines(vulkanLogicalDevice, VK_NULL_HANDLE, 1, &computePipelineCreateInfo, nullptr, &pipeline);
+    if (computePipelineCreationResult != VK_SUCCESS) {
+        throwDebugException("Failed to create a post-processing compute pipeline.");
+    }
+
+    vkDestroyShaderModule(vulkanLogicalDevice, postComputeShader.shaderModule, nullptr);
+}
+
+void PostProcessing::PostProcessingOperation::generateMemberComponents(float bloomIntensity, float exposureAdaptationSpeed, VkCommandPool commandPool, VkQueue commandQueue, DeviceHandler::VulkanDevices vulkanDevices)
+{
+    this->bloomIntensity = bloomIntensity;
+    this->exposureAdaptationSpeed = exposureAdaptationSpeed;
+
+
+    // a source, two written levels, and the histogram and exposure buffers, every dispatch uses a subset of the bindings.
+    VkDescriptorSetLayoutBinding sourceImageLayoutBinding{};
+    ResourceDescriptor::populateDescriptorSetLayoutBinding(0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_COMPUTE_BIT, sourceImageLayoutBinding);
+
+    VkDescriptorSetLayoutBinding firstTargetLayoutBinding{};
+    ResourceDescriptor::populateDescriptorSetLayoutBinding(1, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, VK_SHADER_STAGE_COMPUTE_BIT, firstTargetLayoutBinding);
+
+    VkDescriptorSetLayoutBinding secondTargetLayoutBinding{};
+    ResourceDescriptor::populateDescriptorSetLayoutBinding(2, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, VK_SHADER_STAGE_COMPUTE_BIT, secondTargetLayoutBinding);
+
+    VkDescriptorSetLayoutBinding histogramLayoutBinding{};
+    ResourceDescriptor::populateDescriptorSetLayoutBinding(3, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT, histogramLayoutBinding);
+
+    VkDescriptorSetLayoutBinding exposureLayoutBinding{};
+    ResourceDescriptor::populateDescriptorSetLayoutBinding(4, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT, exposureLayoutBinding);
+
+    std::vector<VkDescriptorSetLayoutBinding> postDescriptorSetLayoutBindings = {sourceImageLayoutBinding, firstTargetLayoutBinding, secondTargetLayoutBinding, histogramLayoutBinding, exposureLayoutBinding};
+    ResourceDescriptor::createDescriptorSetLayout(postDescriptorSetLayoutBindings, vulkanDevices.logicalDevice, this->pipelineComponents.descriptorSetLayout);
+
+    VkPushConstantRange postPushConstant{};
+    Uniform::populatePushConstant(0, sizeof(PostProcessing::PostPushConstant), VK_SHADER_STAGE_COMPUTE_BIT, postPushConstant);
+    RendererDetails::createPipelineLayout(vulkanDevices.logicalDevice, this->pipelineComponents.descriptorSetLayout, &postPushConstant, this->pipelineComponents.pipelineLayout);
+
+
+    // the prefilter is the downsample shader with the Karis average and the luminance histogram.
+    createPostPipeline("bloomDownsampleCompute.spv", this->pipelineComponents.pipelineLayout, vulkanDevices.logicalDevice, this->pipelineComponents.pipeline);
+    createPostPipeline("bloomPrefilterCompute.spv", this->pipelineComponents.pipelineLayout, vulkanDevices.logicalDevice, this->prefilterPipeline);
+    createPostPipeline("bloomUpsampleCompute.spv", this->pipelineComponents.pipelineLayout, vulkanDevices.logicalDevice, this->upsamplePipeline);
+    createPostPipeline("exposureCompute.spv", this->pipelineComponents.pipelineLayout, vulkanDevices.logicalDevice, this->exposurePipeline);
+
+
+    VkSamplerCreateInfo samplerCreateInfo{};
+    samplerCreateInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+
+    samplerCreateInfo.minFilter = VK_FILTER_LINEAR;  // each bilinear tap averages 2x2 source texels.
+    samplerCreateInfo.magFilter = VK_FILTER_LINEAR;
+
+    samplerCreateInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerCreateInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerCreateInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+
+    samplerCreateInfo.anisotropyEnable = VK_FALSE;
+    samplerCreateInfo.maxAnisotropy = 1.0f;
+
+    samplerCreateInfo.borderColor = VK_BORDER_COLOR_FLOAT_OPAQUE_BLACK;
+    samplerCreateInfo.unnormalizedCoordinates = VK_FALSE;
+
+    samplerCreateInfo.compareEnable = VK_FALSE;
+    samplerCreateInfo.compareOp = VK_COMPARE_OP_ALWAYS;
+
+    samplerCreateInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;  // every level is read through its own single level view.
+    samplerCreateInfo.mipLodBias = 0.0f;
+    samplerCreateInfo.minLod = 0.0f;
+    samplerCreateInfo.maxLod = 0.0f;
+
+    VkResult linearSamplerCreationResult = vkCreateSampler(vulkanDevices.logicalDevice, &samplerCreateInfo, nullptr, &this->linearSampler);
+    if (linearSamplerCreationResult != VK_SUCCESS) {
+        throwDebugException("Failed to create the post-processing sampler.");
+    }
+
+
+    // both buffers are only written on the GPU, the histogram starts empty and the exposure starts adapted to middle gray.
+    Buffer::createBufferComponents((sizeof(uint32_t) * PostProcessing::histogramBinCount), (VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT), VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, vulkanDevices, this->histogramBuffer, this->histogramBufferMemory);
+    Buffer::createBufferComponents(sizeof(PostProcessing::ExposureState), (VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT), VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, vulkanDevices, this->exposureBuffer, this->exposureBufferMemory);
+
+    PostProcessing::ExposureState initialExposureState{};
+    initialExposureState.adaptedLuminance = 0.18f;  // the exposure shader's key, an exposure of 1.
+    initialExposureState.exposure = 1.0f;
+
+    VkCommandBuffer disposableCommandBuffer;
+    CommandManager::beginRecordingSingleSubmitCommands(commandPool, vulkanDevices.logicalDevice, disposableCommandBuffer);
+    vkCmdFillBuffer(disposableCommandBuffer, this->histogramBuffer, 0, VK_WHOLE_SIZE, 0);
+    vkCmdUpdateBuffer(disposableCommandBuffer, this->exposureBuffer, 0, sizeof(PostProcessing::ExposureState), &initialExposureState);
+    CommandManager::submitSingleSubmitCommands(disposableCommandBuffer, commandPool, commandQueue, vulkanDevices.logicalDevice);
+
+    this->pipelineComponents.descriptorPool = VK_NULL_HANDLE;  // created with the bloom image, the descriptor sets point at its levels.
+}
+
+// point a post-processing descriptor set at a dispatch's images and at the histogram and exposure buffers.
+//
+// @param descriptorSet the written descriptor set.
+// @param sourceImageInfo the sampled source image.
+// @param firstTargetImageView the view of the first written level.
+// @param secondTargetImageView the view of the second written level, the first level's view if the dispatch writes a single level.
+// @param histogramBuffer the luminance histogram buffer.
+// @param exposureBuffer the exposure buffer.
+// @param vulkanLogicalDevice Vulkan logical device to use in descriptor set writing.
+static void writePostDescriptorSet(VkDescriptorSet descriptorSet, const VkDescriptorImageInfo& sourceImageInfo, VkImageView firstTargetImageView, VkImageView secondTargetImageView, VkBuffer histogramBuffer, VkBuffer exposureBuffer, VkDevice vulkanLogicalDevice)
+{
+    VkDescriptorImageInfo firstTargetDescriptorImageInfo{};
+    ResourceDescriptor::populateDescriptorImageInfo(VK_NULL_HANDLE, firstTargetImageView, VK_IMAGE_LAYOUT_GENERAL, firstTargetDescriptorImageInfo);
+    VkDescriptorImageInfo secondTargetDescriptorImageInfo{};
+    ResourceDescriptor::populateDescriptorImageInfo(VK_NULL_HANDLE, secondTargetImageView, VK_IMAGE_LAYOUT_GENERAL, secondTargetDescriptorImageInfo);
+
+    VkDescriptorBufferInfo histogramDescriptorBufferInfo{};
+    ResourceDescriptor::populateDescriptorBufferInfo(histogramBuffer, 0, VK_WHOLE_SIZE, histogramDescriptorBufferInfo);
+    VkDescriptorBufferInfo exposureDescriptorBufferInfo{};
+    ResourceDescriptor::populateDescriptorBufferInfo(exposureBuffer, 0, VK_WHOLE_SIZE, exposureDescriptorBufferInfo);
+
+    std::vector<VkWriteDescriptorSet> postWriteDescriptorSets(5);
+    ResourceDescriptor::populateWriteDescriptorSet(descriptorSet, 0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, &sourceImageInfo, nullptr, postWriteDescriptorSets[0]);
+    ResourceDescriptor::populateWriteDescriptorSet(descriptorSet, 1, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, &firstTargetDescriptorImageInfo, nullptr, postWriteDescriptorSets[1]);
+    ResourceDescriptor::populateWriteDescriptorSet(descriptorSet, 2, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, &secondTargetDescriptorImageInfo, nullptr, postWriteDescriptorSets[2]);
+    ResourceDescriptor::populateWriteDescriptorSet(descriptorSet, 3, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, nullptr, &histogramDescriptorBufferInfo, postWriteDescriptorSets[3]);
+    ResourceDescriptor::populateWriteDescriptorSet(descriptorSet, 4, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, nullptr, &exposureDescriptorBufferInfo, postWriteDescriptorSets[4]);
+
+    vkUpdateDescriptorSets(vulkanLogicalDevice, static_cast<uint32_t>(postWriteDescriptorSets.size()), postWriteDescriptorSets.data(), 0, nullptr);
+}
+
+void PostProcessing::PostProcessingOperation::generatePostImages(VkImageView sceneColorImageView, VkExtent2D sceneExtent, DeviceHandler::VulkanDevices vulkanDevices)
+{
+    this->sceneExtent = sceneExtent;
+
+    // the first level is at half of the scene extent, bloom is too blurry to need the full extent.
+    uint32_t bloomWidth = std::max((sceneExtent.width >> 1), 1u);
+    uint32_t bloomHeight = std::max((sceneExtent.height >> 1), 1u);
+    Image::populateImageDetails(bloomWidth, bloomHeight, PostProcessing::bloomLevelCount, 1, VK_SAMPLE_COUNT_1_BIT, PostProcessing::bloomImageFormat, VK_IMAGE_TILING_OPTIMAL, (VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT), VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, vulkanDevices, this->bloomImageDetails);
+    this->bloomImageDetails.mipmapLevels = PostProcessing::bloomLevelCount;
+    this->bloomImageDetails.imageLayerCount = 1;
+    this->bloomImageDetails.imageLayout = VK_IMAGE_LAYOUT_GENERAL;  // transitioned by the render graph before the first prefilter.
+
+    Image::createImageView(this->bloomImageDetails.image, PostProcessing::bloomImageFormat, 1, 1, VK_IMAGE_ASPECT_COLOR_BIT, vulkanDevices.logicalDevice, this->bloomImageDetails.imageView);  // the first level, read by the presentation passes.
+
+    this->levelImageViews.resize(PostProcessing::bloomLevelCount);
+    for (uint32_t i = 0; i < PostProcessing::bloomLevelCount; i += 1) {
+        VkImageViewCreateInfo levelImageViewCreateInfo{};
+        Image::populateImageViewCreateInfo(this->bloomImageDetails.image, VK_IMAGE_VIEW_TYPE_2D, PostProcessing::bloomImageFormat, VK_IMAGE_ASPECT_COLOR_BIT, i, 1, 0, 1, levelImageViewCreateInfo);
+
+        VkResult levelImageViewCreationResult = vkCreateImageView(vulkanDevices.logicalDevice, &levelImageViewCreateInfo, nullptr, &this->levelImageViews[i]);
+        if (levelImageViewCreationResult != VK_SUCCESS) {
+            throwDebugException("Failed to create a bloom level image view.");
+        }
+    }
+
+
+    // a descriptor set for each dispatch, the prefilter(also bound by the exposure pass), the downsamples after it, and every upsample.
+    uint32_t downsampleSetCount = (PostProcessing::bloomLevelCount / 2);
+    uint32_t postDescriptorSetCount = (downsampleSetCount + (PostProcessing::bloomLevelCount - 1));
+
+    VkDescriptorPoolSize combinedSamplerPoolSize{};
+    ResourceDescriptor::populateDescriptorPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, postDescriptorSetCount, combinedSamplerPoolSize);
+    VkDescriptorPoolSize storageImagePoolSize{};
+    ResourceDescriptor::populateDescriptorPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, (postDescriptorSetCount * 2), storageImagePoolSize);
+    VkDescriptorPoolSize storageBufferPoolSize{};
+    ResourceDescriptor::populateDescriptorPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, (postDescriptorSetCount * 2), storageBufferPoolSize);
+    VkDescriptorPoolSize descriptorPoolSizes[] = {combinedSamplerPoolSize, storageImagePoolSize, storageBufferPoolSize};
+
+    VkDescriptorPoolCreateInfo descriptorPoolCreateInfo{};
+    descriptorPoolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+
+    descriptorPoolCreateInfo.poolSizeCount = 3;
+    descriptorPoolCreateInfo.pPoolSizes = descriptorPoolSizes;
+
+    descriptorPoolCreateInfo.maxSets = postDescriptorSetCount;
+
+    VkResult descriptorPoolCreationResult = vkCreateDescriptorPool(vulkanDevices.logicalDevice, &descriptorPoolCreateInfo, nullptr, &this->pipelineComponents.descriptorPool);
+    if (descriptorPoolCreationResult != VK_SUCCESS) {
+        throwDebugException("Failed to create the post-processing descriptor pool.");
+    }
+
+    std::vector<VkDescriptorSetLayout> descriptorSetLayouts(postDescriptorSetCount, this->pipelineComponents.descriptorSetLayout);
+
+    VkDescriptorSetAllocateInfo descriptorSetsAllocateInfo{};
+    descriptorSetsAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+
+    descriptorSetsAllocateInfo.descriptorPool = this->pipelineComponents.descriptorPool;
+
+    descriptorSetsAllocateInfo.descriptorSetCount = postDescriptorSetCount;
+    descriptorSetsAllocateInfo.pSetLayouts = descriptorSetLayouts.data();
+
+    this->pipelineComponents.descriptorSets.resize(postDescriptorSetCount);
+    VkResult descriptorSetsAllocationResult = vkAllocateDescriptorSets(vulkanDevices.logicalDevice, &descriptorSetsAllocateInfo, this->pipelineComponents.descriptorSets.data());
+    if (descriptorSetsAllocationResult != VK_SUCCESS) {
+        throwDebugException("Failed to allocate the post-processing descriptor sets.");
+    }
+
+    // the prefilter reads the scene color into the first two levels, every other downsample reads the level before its first target.
+    VkDescriptorImageInfo sceneColorDescriptorImageInfo{};
+    ResourceDescriptor::populateDescriptorImageInfo(this->linearSampler, sceneColorImageView, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, sceneColorDescriptorImageInfo);
+    writePostDescriptorSet(this->pipelineComponents.descriptorSets[0], sceneColorDescriptorImageInfo, this->levelImageViews[0], this->levelImageViews[1], this->histogramBuffer, this->exposureBuffer, vulkanDevices.logicalDevice);
+
+    for (uint32_t i = 1; i < downsampleSetCount; i += 1) {
+        uint32_t firstTargetLevel = (i * 2);
+
+        VkDescriptorImageInfo sourceLevelDescriptorImageInfo{};
+        ResourceDescriptor::populateDescriptorImageInfo(this->linearSampler, this->levelImageViews[firstTargetLevel - 1], VK_IMAGE_LAYOUT_GENERAL, sourceLevelDescriptorImageInfo);
+        writePostDescriptorSet(this->pipelineComponents.descriptorSets[i], sourceLevelDescriptorImageInfo, this->levelImageViews[firstTargetLevel], this->levelImageViews[firstTargetLevel + 1], this->histogramBuffer, this->exposureBuffer, vulkanDevices.logicalDevice);
+    }
+
+    // the upsamples, from the last level into the first, each reads the level after its target.
+    for (uint32_t i = 0; i < (PostProcessing::bloomLevelCount - 1); i += 1) {
+        uint32_t targetLevel = (PostProcessing::bloomLevelCount - 2 - i);
+
+        VkDescriptorImageInfo sourceLevelDescriptorImageInfo{};
+        ResourceDescriptor::populateDescriptorImageInfo(this->linearSampler, this->levelImageViews[targetLevel + 1], VK_IMAGE_LAYOUT_GENERAL, sourceLevelDescriptorImageInfo);
+        writePostDescriptorSet(this->pipelineComponents.descriptorSets[downsampleSetCount + i], sourceLevelDescriptorImageInfo, this->levelImageViews[targetLevel], this->levelImageViews[targetLevel], this->histogramBuffer, this->exposureBuffer, vulkanDevices.logicalDevice);
+    }
+}
+
+void PostProcessing::PostProcessingOperation::fetchLevelExtent(uint32_t levelIndex, VkExtent2D& levelExtent) const
+{
+    levelExtent.width = std::max((static_cast<uint32_t>(this->bloomImageDetails.imageWidth) >> levelIndex), 1u);
+    levelExtent.height = std::max((static_cast<uint32_t>(this->bloomImageDetails.imageHeight) >> levelIndex), 1u);
+}
+
+// record a barrier between two bloom dispatches, the next dispatch reads(or adds to) the levels written by the previous one.
+//
+// @param bloomImage the bloom image.
+// @param commandBuffer the command buffer to record in.
+static void recordLevelBarrier(VkImage bloomImage, VkCommandBuffer commandBuffer)
+{
+    VkImageMemoryBarrier levelMemoryBarrier{};
+    levelMemoryBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+
+    levelMemoryBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    levelMemoryBarrier.dstAccessMask = (VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT);
+
+    levelMemoryBarrier.oldLayout = VK_IMAGE_LAYOUT_GENERAL;
+    levelMemoryBarrier.newLayout = VK_IMAGE_LAYOUT_GENERAL;
+
+    levelMemoryBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    levelMemoryBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+
+    levelMemoryBarrier.image = bloomImage;
+    levelMemoryBarrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    levelMemoryBarrier.subresourceRange.baseMipLevel = 0;
+    levelMemoryBarrier.subresourceRange.levelCount = VK_REMAINING_MIP_LEVELS;
+    levelMemoryBarrier.subresourceRange.baseArrayLayer = 0;
+    levelMemoryBarrier.subresourceRange.layerCount = 1;
+
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &levelMemoryBarrier);
+}
+
+void PostProcessing::PostProcessingOperation::recordBloomCommands(VkExtent2D renderExtent, VkCommandBuffer commandBuffer) const
+{
+    uint32_t downsampleSetCount = (PostProcessing::bloomLevelCount / 2);
+
+    // the downsamples, each writes two levels(the prefilter reads the rendered region of the scene color).
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, this->prefilterPipeline);
+    for (uint32_t i = 0; i < downsampleSetCount; i += 1) {
+        uint32_t firstTargetLevel = (i * 2);
+
+        PostProcessing::PostPushConstant downsamplePushConstant{};
+        if (i == 0) {
+            downsamplePushConstant.sourceTexelSize = glm::vec2((1.0f / this->sceneExtent.width), (1.0f / this->sceneExtent.height));
+            downsamplePushConstant.sourceScale = glm::vec2((static_cast<float>(renderExtent.width) / this->sceneExtent.width), (static_cast<float>(renderExtent.height) / this->sceneExtent.height));
+        } else {
+            VkExtent2D sourceExtent;
+            this->fetchLevelExtent((firstTargetLevel - 1), sourceExtent);
+            downsamplePushConstant.sourceTexelSize = glm::vec2((1.0f / sourceExtent.width), (1.0f / sourceExtent.height));
+            downsamplePushConstant.sourceScale = glm::vec2(1.0f);
+        }
+        this->fetchLevelExtent(firstTargetLevel, downsamplePushConstant.targetExtent);
+        downsamplePushConstant.targetWeight = 1.0f;
+
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, this->pipelineComponents.pipelineLayout, 0, 1, &this->pipelineComponents.descriptorSets[i], 0, nullptr);
+        vkCmdPushConstants(commandBuffer, this->pipelineComponents.pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(PostProcessing::PostPushConstant), &downsamplePushConstant);
+
+        uint32_t workgroupCountX = ((downsamplePushConstant.targetExtent.width + (PostProcessing::downsampleWorkgroupSize - 1)) / PostProcessing::downsampleWorkgroupSize);
+        uint32_t workgroupCountY = ((downsamplePushConstant.targetExtent.height + (PostProcessing::downsampleWorkgroupSize - 1)) / PostProcessing::downsampleWorkgroupSize);
+        vkCmdDispatch(commandBuffer, workgroupCountX, workgroupCountY, 1);
+
+        recordLevelBarrier(this->bloomImageDetails.image, commandBuffer);
+        if (i == 0) {
+            vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, this->pipelineComponents.pipeline);
+        }
+    }
+
+    // the upsamples, each level adds the levels below it, the first level is weighted by the bloom intensity(averaged over the levels).
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, this->upsamplePipeline);
+    for (uint32_t i = 0; i < (PostProcessing::bloomLevelCount - 1); i += 1) {
+        uint32_t targetLevel = (PostProcessing::bloomLevelCount - 2 - i);
+
+        PostProcessing::PostPushConstant upsamplePushConstant{};
+        VkExtent2D sourceExtent;
+        this->fetchLevelExtent((targetLevel + 1), sourceExtent);
+        upsamplePushConstant.sourceTexelSize = glm::vec2((1.0f / sourceExtent.width), (1.0f / sourceExtent.height));
+        upsamplePushConstant.sourceScale = glm::vec2(1.0f);
+        this->fetchLevelExtent(targetLevel, upsamplePushConstant.targetExtent);
+        upsamplePushConstant.targetWeight = ((targetLevel == 0) ? (this->bloomIntensity / PostProcessing::bloomLevelCount) : 1.0f);
+
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, this->pipelineComponents.pipelineLayout, 0, 1, &this->pipelineComponents.descriptorSets[downsampleSetCount + i], 0, nullptr);
+        vkCmdPushConstants(commandBuffer, this->pipelineComponents.pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(PostProcessing::PostPushConstant), &upsamplePushConstant);
+
+        uint32_t workgroupCountX = ((upsamplePushConstant.targetExtent.width + (PostProcessing::upsampleWorkgroupSize - 1)) / PostProcessing::upsampleWorkgroupSize);
+        uint32_t workgroupCountY = ((upsamplePushConstant.targetExtent.height + (PostProcessing::upsampleWorkgroupSize - 1)) / PostProcessing::upsampleWorkgroupSize);
+        vkCmdDispatch(commandBuffer, workgroupCountX, workgroupCountY, 1);
+
+        if (targetLevel == 0) {  // the first level is synchronized with the presentation passes by the render graph.
+            break;
+        }
+        recordLevelBarrier(this->bloomImageDetails.image, commandBuffer);
+    }
+}
+
+void PostProcessing::PostProcessingOperation::recordExposureCommands(float frameTime, VkCommandBuffer commandBuffer) const
+{
+    PostProcessing::PostPushConstant exposurePushConstant{};
+    exposurePushConstant.adaptationFactor = (1.0f - std::exp(-(frameTime * this->exposureAdaptationSpeed)));  // frame rate independent.
+
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, this->exposurePipeline);
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, this->pipelineComponents.pipelineLayout, 0, 1, &this->pipelineComponents.descriptorSets[0], 0, nullptr);
+    vkCmdPushConstants(commandBuffer, this->pipelineComponents.pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(PostProcessing::PostPushConstant), &exposurePushConstant);
+
+    vkCmdDispatch(commandBuffer, 1, 1, 1);  // a thread for each histogram bin.
+}
+
+void PostProcessing::PostProcessingOperation::cleanupPostImages(VkDevice vulkanLogicalDevice)
+{
+    for (VkImageView levelImageView : this->levelImageViews) {
+        vkDestroyImageView(vulkanLogicalDevice, levelImageView, nullptr);
+    }
+    this->levelImageViews.clear();
+
+    this->bloomImageDetails.cleanupImageDetails(vulkanLogicalDevice);
+
+    vkDestroyDescriptorPool(vulkanLogicalDevice, this->pipelineComponents.descriptorPool, nullptr);  // frees the dispatch descriptor sets.
+    this->pipelineComponents.descriptorPool = VK_NULL_HANDLE;
+    this->pipelineComponents.descriptorSets.clear();
+}
+
+void PostProcessing::PostProcessingOperation::cleanupPostProcessingOperation(VkDevice vulkanLogicalDevice)
+{
+    this->cleanupPostImages(vulkanLogicalDevice);
+
+    vkDestroySampler(vulkanLogicalDevice, this->linearSampler, nullptr);
+
+    vkDestroyBuffer(vulkanLogicalDevice, this->histogramBuffer, nullptr);
+    vkFreeMemory(vulkanLogicalDevice, this->histogramBufferMemory, nullptr);
+    vkDestroyBuffer(vulkanLogicalDevice, this->exposureBuffer, nullptr);
+    vkFreeMemory(vulkanLogicalDevice, this->exposureBufferMemory, nullptr);
+
+    // the other pipelines share the downsample pipeline components' layout and descriptors.
+    vkDestroyPipeline(vulkanLogicalDevice, this->prefilterPipeline, nullptr);
+    vkDestroyPipeline(vulkanLogicalDevice, this->upsamplePipeline, nullptr);
+    vkDestroyPipeline(vulkanLogicalDevice, this->exposurePipeline, nullptr);
+    this->pipelineComponents.cleanupPipelineComponents(vulkanLogicalDevice);  // the compute pipeline is destroyed like a graphics pipeline.
+}
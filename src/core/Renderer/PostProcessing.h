@@ -0,0 +1,108 @@
+#ifndef POSTPROCESSING_H
+#define POSTPROCESSING_H
+
+
+#define GLFW_INCLUDE_VULKAN
+#include <GLFW/glfw3.h>
+
+#include <core/Renderer/Pipeline.h>
+#include <core/Shader/Image.h>
+#include <core/VulkanInstance/DeviceHandler.h>
+
+#include <glm/glm.hpp>
+
+#include <vector>
+#include <cstdint>
+
+
+namespace PostProcessing
+{
+    const VkFormat bloomImageFormat = VK_FORMAT_R16G16B16A16_SFLOAT;  // written as a storage image, the packed scene color format isn't a required storage format.
+    const uint32_t bloomLevelCount = 6;  // the bloom image's levels, the first at half of the scene extent(even, each downsample dispatch writes two levels).
+    const uint32_t downsampleWorkgroupSize = 16;  // identical to the bloom downsample shader's local size on each axis, a quarter of the workgroup also writes the next level.
+    const uint32_t upsampleWorkgroupSize = 8;  // identical to the bloom upsample shader's local size on each axis.
+    const uint32_t histogramBinCount = 256;  // identical to the bloom prefilter's and the exposure shader's bin count, the exposure shader's local size.
+
+    struct PostPushConstant {  // identical to the post-processing compute shaders' push constant.
+        glm::vec2 sourceTexelSize;  // the size of a source texel in texture coordinates.
+        glm::vec2 sourceScale;  // the read region of the source in texture coordinates, the scene color's rendered region in the prefilter and 1 otherwise.
+        VkExtent2D targetExtent;  // the extent of the(first) written level.
+        float targetWeight;  // the weight of an upsampled level, the bloom intensity when writing the first level and 1 otherwise.
+        float adaptationFactor;  // the adaptation of the exposure towards the frame's average luminance, from 0 to 1.
+    };
+
+    struct ExposureState {  // identical to the exposure buffer's layout, read by the presentation passes.
+        float adaptedLuminance;  // the average scene luminance adapted to over the previous frames.
+        float exposure;  // the scene color's scale before tonemapping.
+    };
+
+    struct PostProcessingOperation {  // builds a bloom pyramid from the HDR scene color in a few compute dispatches, and adapts the exposure to a luminance histogram gathered in the same read of the scene color.
+        Pipeline::PipelineComponents pipelineComponents;  // the bloom downsample pipeline, a descriptor set for each dispatch(without uniform buffers) shared with every post-processing pipeline.
+        VkPipeline prefilterPipeline;  // the first downsample, reading the scene color and gathering the luminance histogram.
+        VkPipeline upsamplePipeline;
+        VkPipeline exposurePipeline;
+
+        Image::ImageDetails bloomImageDetails;  // kept in the general layout, levels are written as storage images and sampled by the next dispatch.
+        std::vector<VkImageView> levelImageViews;  // a single level view of each level.
+        VkSampler linearSampler;  // a linear sampler clamped to the edge, used for the scene color and the bloom levels.
+
+        VkBuffer histogramBuffer;  // the luminance histogram of the scene color, cleared by the exposure pass after reading it.
+        VkDeviceMemory histogramBufferMemory;
+        VkBuffer exposureBuffer;  // a single ExposureState, kept between frames.
+        VkDeviceMemory exposureBufferMemory;
+
+        float bloomIntensity;
+        float exposureAdaptationSpeed;  // the exposure's adaptation rate per second.
+        VkExtent2D sceneExtent;  // the extent of the scene color.
+
+
+        // generate the member post-processing components, the bloom image is generated seperately with the scene color(see generatePostImages).
+        //
+        // @param bloomIntensity the weight of the bloom added to the scene color.
+        // @param exposureAdaptationSpeed the exposure's adaptation rate per second, 0 keeps the initial exposure.
+        // @param commandPool command pool to use in the exposure and histogram buffers' initial fills.
+        // @param commandQueue queue to submit the exposure and histogram buffers' initial fills in.
+        // @param vulkanDevices Vulkan physical and logical device to use in member components generation.
+        void generateMemberComponents(float bloomIntensity, float exposureAdaptationSpeed, VkCommandPool commandPool, VkQueue commandQueue, DeviceHandler::VulkanDevices vulkanDevices);
+
+        // generate the bloom image and its level views, and point the descriptor sets at them and the scene color.
+        //
+        // @param sceneColorImageView the view of the single-sampled scene color.
+        // @param sceneExtent the extent of the scene color.
+        // @param vulkanDevices Vulkan physical and logical device to use in bloom image generation.
+        void generatePostImages(VkImageView sceneColorImageView, VkExtent2D sceneExtent, DeviceHandler::VulkanDevices vulkanDevices);
+
+        // fetch the extent of a bloom level.
+        //
+        // @param levelIndex the index of the level.
+        // @param levelExtent the fetched level extent.
+        void fetchLevelExtent(uint32_t levelIndex, VkExtent2D& levelExtent) const;
+
+        // record the bloom commands, downsampling the scene color into every level two levels at a time, and upsampling back into the first level.
+        //
+        // expects the scene color in a shader read-only layout and the bloom image in the general layout.
+        //
+        // @param renderExtent the rendered region of the scene color.
+        // @param commandBuffer the command buffer to record in.
+        void recordBloomCommands(VkExtent2D renderExtent, VkCommandBuffer commandBuffer) const;
+
+        // record the exposure commands, a single workgroup averaging the luminance histogram and adapting the exposure towards it.
+        //
+        // @param frameTime the time since the previous frame in seconds.
+        // @param commandBuffer the command buffer to record in.
+        void recordExposureCommands(float frameTime, VkCommandBuffer commandBuffer) const;
+
+        // cleanup the bloom image, its level views, and its descriptor sets(ex: before the scene color is recreated).
+        //
+        // @param vulkanLogicalDevice Vulkan logical device to use in bloom image cleanup.
+        void cleanupPostImages(VkDevice vulkanLogicalDevice);
+
+        // cleanup the post-processing operation.
+        //
+        // @param vulkanLogicalDevice Vulkan logical device to use in post-processing operation cleanup.
+        void cleanupPostProcessingOperation(VkDevice vulkanLogicalDevice);
+    };
+}
+
+
+#endif  // POSTPROCESSING_H
@@ -0,0 +1,324 @@
+#define GLFW_INCLUDE_VULKAN
+#include <GLFW/glfw3.h>
+
+#include <core/Renderer/RenderGraph.h>
+#include <core/Logging/ErrorLogger.h>
+
+#include <vector>
+#include <string>
+#include <algorithm>
+
+
+void RenderGraph::Graph::importImageResource(std::string resourceName, VkImage image, VkImageAspectFlags imageAspectMask, std::optional<RenderGraph::ResourceState> initialState, std::optional<RenderGraph::ResourceState> finalState, uint32_t& resourceIndex)
+{
+    RenderGraph::GraphResource graphResource{};
+    graphResource.resourceName = resourceName;
+
+    graphResource.isImage = true;
+
+    graphResource.image = image;
+    graphResource.imageAspectMask = imageAspectMask;
+
+    graphResource.initialState = initialState;
+    graphResource.finalState = finalState;
+
+    resourceIndex = static_cast<uint32_t>(this->resources.size());
+    this->resources.push_back(graphResource);
+}
+
+void RenderGraph::Graph::importBufferResource(std::string resourceName, VkBuffer buffer, std::optional<RenderGraph::ResourceState> initialState, std::optional<RenderGraph::ResourceState> finalState, uint32_t& resourceIndex)
+{
+    RenderGraph::GraphResource graphResource{};
+    graphResource.resourceName = resourceName;
+
+    graphResource.isImage = false;
+
+    graphResource.buffer = buffer;
+
+    graphResource.initialState = initialState;
+    graphResource.finalState = finalState;
+
+    resourceIndex = static_cast<uint32_t>(this->resources.size());
+    this->resources.push_back(graphResource);
+}
+
+void RenderGraph::Graph::addPass(std::string passName, std::vector<RenderGraph::ResourceAccess> resourceReads, std::vector<RenderGraph::ResourceAccess> resourceWrites, std::function<void(VkCommandBuffer)> recordPassCommands)
+{
+    RenderGraph::GraphPass graphPass{};
+    graphPass.passName = passName;
+
+    graphPass.resourceReads = resourceReads;
+    graphPass.resourceWrites = resourceWrites;
+
+    graphPass.recordPassCommands = recordPassCommands;
+
+    this->passes.push_back(graphPass);
+}
+
+void RenderGraph::Graph::fetchResourceIndex(std::string resourceName, uint32_t& resourceIndex)
+{
+    for (size_t i = 0; i < this->resources.size(); i += 1) {
+        if (this->resources[i].resourceName == resourceName) {
+            resourceIndex = static_cast<uint32_t>(i);
+            return;
+        }
+    }
+
+    throwDebugException("Render graph resource \"" + resourceName + "\" does not exist.");
+}
+
+void RenderGraph::Graph::setPassRecording(std::string passName, std::function<void(VkCommandBuffer)> recordPassCommands)
+{
+    for (RenderGraph::GraphPass& graphPass : this->passes) {
+        if (graphPass.passName == passName) {
+            graphPass.recordPassCommands = recordPassCommands;
+            return;
+        }
+    }
+
+    throwDebugException("Render graph pass \"" + passName + "\" does not exist.");
+}
+
+void RenderGraph::Graph::setPassSkipped(std::string passName, bool passSkipped)
+{
+    for (RenderGraph::GraphPass& graphPass : this->passes) {
+        if (graphPass.passName == passName) {
+            if (graphPass.passSkipped != passSkipped) {
+                graphPass.passSkipped = passSkipped;
+                
+                if (this->beenCompiled == true) {
+                    this->compileBarriers();
+                }
+            }
+            return;
+        }
+    }
+
+    throwDebugException("Render graph pass \"" + passName + "\" does not exist.");
+}
+
+void RenderGraph::Graph::updateImportedImage(std::string resourceName, VkImage image)
+{
+    uint32_t resourceIndex;
+    this->fetchResourceIndex(resourceName, resourceIndex);
+
+    this->resources[resourceIndex].image = image;
+}
+
+void RenderGraph::Graph::compileGraph()
+{
+    // cull passes that no graph output depends on, walking backwards from the last pass.
+    std::vector<bool> requiredResources(this->resources.size(), false);
+    for (size_t i = 0; i < this->resources.size(); i += 1) {
+        requiredResources[i] = this->resources[i].finalState.has_value();
+    }
+
+    for (size_t i = this->passes.size(); i > 0; i -= 1) {
+        RenderGraph::GraphPass& graphPass = this->passes[i - 1];
+
+        graphPass.passCulled = std::none_of(graphPass.resourceWrites.begin(), graphPass.resourceWrites.end(), [&](const RenderGraph::ResourceAccess& resourceWrite) { return requiredResources[resourceWrite.resourceIndex]; });
+        if (graphPass.passCulled == false) {
+            for (const RenderGraph::ResourceAccess& resourceRead : graphPass.resourceReads) {
+                requiredResources[resourceRead.resourceIndex] = true;
+            }
+        }
+    }
+
+
+    this->compileBarriers();
+
+
+    this->beenCompiled = true;
+}
+
+void RenderGraph::Graph::compileBarriers()
+{
+    // find the resource states at the end of the graph, then wrap them around as the initial states for the barriers.
+    std::vector<RenderGraph::ResourceTracking> initialResourceTrackings(this->resources.size());
+    for (size_t i = 0; i < this->resources.size(); i += 1) {
+        const std::optional<RenderGraph::ResourceState>& initialState = this->resources[i].initialState;
+        if (initialState.has_value() == true) {  // treated as a write, every first access waits on it.
+            initialResourceTrackings[i] = {initialState->imageLayout, initialState->stageMask, initialState->accessMask, 0, 0, 0};
+        } else {
+            initialResourceTrackings[i] = {VK_IMAGE_LAYOUT_UNDEFINED, 0, 0, 0, 0, 0};
+        }
+    }
+
+    std::vector<RenderGraph::ResourceTracking> finalResourceTrackings = initialResourceTrackings;
+    this->simulateResourceAccesses(false, finalResourceTrackings);
+
+    for (size_t i = 0; i < this->resources.size(); i += 1) {
+        if (this->resources[i].initialState.has_value() == false) {
+            initialResourceTrackings[i] = finalResourceTrackings[i];
+        }
+    }
+
+    this->simulateResourceAccesses(true, initialResourceTrackings);
+}
+
+void RenderGraph::Graph::simulateResourceAccesses(bool storeBarriers, std::vector<RenderGraph::ResourceTracking>& resourceTrackings)
+{
+    auto appendBarrier = [&](RenderGraph::GraphBarrierBatch& barrierBatch, uint32_t resourceIndex, VkPipelineStageFlags srcStageMask, VkAccessFlags srcAccessMask, VkImageLayout oldImageLayout, const RenderGraph::ResourceState& dstState) {
+        if (storeBarriers == false) {
+            return;
+        }
+
+        barrierBatch.srcStageMask |= srcStageMask;
+        barrierBatch.dstStageMask |= dstState.stageMask;
+        barrierBatch.barriers.push_back({resourceIndex, srcAccessMask, dstState.accessMask, oldImageLayout, dstState.imageLayout});
+    };
+
+
+    for (RenderGraph::GraphPass& graphPass : this->passes) {
+        if ((graphPass.passCulled == true) || (graphPass.passSkipped == true)) {
+            continue;
+        }
+        if (storeBarriers == true) {
+            graphPass.passBarrierBatch = {};
+        }
+
+        for (const RenderGraph::ResourceAccess& resourceWrite : graphPass.resourceWrites) {
+            RenderGraph::ResourceTracking& resourceTracking = resourceTrackings[resourceWrite.resourceIndex];
+            const RenderGraph::ResourceState& writeState = resourceWrite.resourceState;
+
+            bool discardsContents = std::none_of(graphPass.resourceReads.begin(), graphPass.resourceReads.end(), [&](const RenderGraph::ResourceAccess& resourceRead) { return resourceRead.resourceIndex == resourceWrite.resourceIndex; });
+            VkImageLayout oldImageLayout = (discardsContents == true ? VK_IMAGE_LAYOUT_UNDEFINED : resourceTracking.imageLayout);  // undefined layouts skip preserving the contents, and are valid whatever layout the image is actually in.
+
+            // writes wait on previous writes(write-after-write) and reads(write-after-read).
+            VkPipelineStageFlags srcStageMask = (resourceTracking.writeStageMask | resourceTracking.readStageMask);
+            if (srcStageMask != 0 || oldImageLayout != writeState.imageLayout) {
+                appendBarrier(graphPass.passBarrierBatch, resourceWrite.resourceIndex, srcStageMask, resourceTracking.writeAccessMask, oldImageLayout, writeState);
+            }
+
+            resourceTracking = {writeState.imageLayout, writeState.stageMask, writeState.accessMask, 0, writeState.stageMask, writeState.accessMask};
+        }
+
+        for (const RenderGraph::ResourceAccess& resourceRead : graphPass.resourceReads) {
+            bool alsoWritten = std::any_of(graphPass.resourceWrites.begin(), graphPass.resourceWrites.end(), [&](const RenderGraph::ResourceAccess& resourceWrite) { return resourceWrite.resourceIndex == resourceRead.resourceIndex; });
+            if (alsoWritten == true) {  // already synchronized by the write's barrier.
+                continue;
+            }
+
+            RenderGraph::ResourceTracking& resourceTracking = resourceTrackings[resourceRead.resourceIndex];
+            const RenderGraph::ResourceState& readState = resourceRead.resourceState;
+
+            bool layoutChanges = (resourceTracking.imageLayout != readState.imageLayout);
+            bool writeNotVisible = (resourceTracking.writeStageMask != 0 && ((readState.stageMask & ~resourceTracking.visibleStageMask) != 0 || (readState.accessMask & ~resourceTracking.visibleAccessMask) != 0));
+
+            if (layoutChanges == true) {  // the transition also has to wait on previous reads in the old layout.
+                appendBarrier(graphPass.passBarrierBatch, resourceRead.resourceIndex, (resourceTracking.writeStageMask | resourceTracking.readStageMask), resourceTracking.writeAccessMask, resourceTracking.imageLayout, readState);
+
+                resourceTracking.imageLayout = readState.imageLayout;
+                resourceTracking.readStageMask = readState.stageMask;
+                resourceTracking.visibleStageMask = readState.stageMask;
+                resourceTracking.visibleAccessMask = readState.accessMask;
+            } else if (writeNotVisible == true) {  // read-after-write.
+                appendBarrier(graphPass.passBarrierBatch, resourceRead.resourceIndex, resourceTracking.writeStageMask, resourceTracking.writeAccessMask, resourceTracking.imageLayout, readState);
+
+                resourceTracking.readStageMask |= readState.stageMask;
+                resourceTracking.visibleStageMask |= readState.stageMask;
+                resourceTracking.visibleAccessMask |= readState.accessMask;
+            } else {  // read-after-read needs no barrier.
+                resourceTracking.readStageMask |= readState.stageMask;
+            }
+        }
+    }
+
+
+    // transition the graph outputs into their final states.
+    if (storeBarriers == true) {
+        this->outputBarrierBatch = {};
+    }
+
+    for (size_t i = 0; i < this->resources.size(); i += 1) {
+        if (this->resources[i].finalState.has_value() == false) {
+            continue;
+        }
+
+        RenderGraph::ResourceTracking& resourceTracking = resourceTrackings[i];
+        const RenderGraph::ResourceState& finalState = this->resources[i].finalState.value();
+
+        appendBarrier(this->outputBarrierBatch, static_cast<uint32_t>(i), (resourceTracking.writeStageMask | resourceTracking.readStageMask), resourceTracking.writeAccessMask, resourceTracking.imageLayout, finalState);
+
+        resourceTracking = {finalState.imageLayout, finalState.stageMask, finalState.accessMask, 0, 0, 0};
+    }
+}
+
+void RenderGraph::Graph::recordBarrierBatch(const RenderGraph::GraphBarrierBatch& barrierBatch, VkCommandBuffer commandBuffer)
+{
+    if (barrierBatch.barriers.empty() == true) {
+        return;
+    }
+
+
+    std::vector<VkImageMemoryBarrier> imageMemoryBarriers;
+    std::vector<VkBufferMemoryBarrier> bufferMemoryBarriers;
+
+    for (const RenderGraph::GraphBarrier& graphBarrier : barrierBatch.barriers) {
+        const RenderGraph::GraphResource& graphResource = this->resources[graphBarrier.resourceIndex];
+
+        if (graphResource.isImage == true) {
+            VkImageMemoryBarrier imageMemoryBarrier{};
+            imageMemoryBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+
+            imageMemoryBarrier.srcAccessMask = graphBarrier.srcAccessMask;
+            imageMemoryBarrier.dstAccessMask = graphBarrier.dstAccessMask;
+            imageMemoryBarrier.oldLayout = graphBarrier.oldImageLayout;
+            imageMemoryBarrier.newLayout = graphBarrier.newImageLayout;
+
+            imageMemoryBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            imageMemoryBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+
+            imageMemoryBarrier.image = graphResource.image;
+            imageMemoryBarrier.subresourceRange.aspectMask = graphResource.imageAspectMask;
+            imageMemoryBarrier.subresourceRange.baseMipLevel = 0;
+            imageMemoryBarrier.subresourceRange.levelCount = VK_REMAINING_MIP_LEVELS;
+            imageMemoryBarrier.subresourceRange.baseArrayLayer = 0;
+            imageMemoryBarrier.subresourceRange.layerCount = VK_REMAINING_ARRAY_LAYERS;
+
+            imageMemoryBarriers.push_back(imageMemoryBarrier);
+        } else {
+            VkBufferMemoryBarrier bufferMemoryBarrier{};
+            bufferMemoryBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+
+            bufferMemoryBarrier.srcAccessMask = graphBarrier.srcAccessMask;
+            bufferMemoryBarrier.dstAccessMask = graphBarrier.dstAccessMask;
+
+            bufferMemoryBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            bufferMemoryBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+
+            bufferMemoryBarrier.buffer = graphResource.buffer;
+            bufferMemoryBarrier.offset = 0;
+            bufferMemoryBarrier.size = VK_WHOLE_SIZE;
+
+            bufferMemoryBarriers.push_back(bufferMemoryBarrier);
+        }
+    }
+
+    // empty stage masks are invalid, nothing to wait on/nothing waiting.
+    VkPipelineStageFlags srcStageMask = (barrierBatch.srcStageMask != 0 ? barrierBatch.srcStageMask : VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT);
+    VkPipelineStageFlags dstStageMask = (barrierBatch.dstStageMask != 0 ? barrierBatch.dstStageMask : VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT);
+
+    vkCmdPipelineBarrier(commandBuffer, srcStageMask, dstStageMask, 0, 0, nullptr, static_cast<uint32_t>(bufferMemoryBarriers.size()), bufferMemoryBarriers.data(), static_cast<uint32_t>(imageMemoryBarriers.size()), imageMemoryBarriers.data());
+}
+
+void RenderGraph::Graph::executeGraph(VkCommandBuffer commandBuffer, std::function<void(const std::string&, VkCommandBuffer)> recordPassEnd)
+{
+    if (this->beenCompiled == false) {
+        throwDebugException("Render graph executed before being compiled.");
+    }
+
+    for (RenderGraph::GraphPass& graphPass : this->passes) {
+        if ((graphPass.passCulled == true) || (graphPass.passSkipped == true)) {
+            continue;
+        }
+
+        this->recordBarrierBatch(graphPass.passBarrierBatch, commandBuffer);
+        graphPass.recordPassCommands(commandBuffer);
+        if (recordPassEnd != nullptr) {
+            recordPassEnd(graphPass.passName, commandBuffer);
+        }
+    }
+
+    this->recordBarrierBatch(this->outputBarrierBatch, commandBuffer);
+}
@@ -0,0 +1,166 @@
+#ifndef RENDERGRAPH_H
+#define RENDERGRAPH_H
+
+
+#define GLFW_INCLUDE_VULKAN
+#include <GLFW/glfw3.h>
+
+#include <vector>
+#include <string>
+#include <functional>
+#include <optional>
+
+
+namespace RenderGraph
+{
+    struct ResourceState {  // how a resource is accessed at a point in the graph.
+        VkPipelineStageFlags stageMask;
+        VkAccessFlags accessMask;
+        VkImageLayout imageLayout;  // ignored for buffer resources.
+    };
+
+    struct ResourceAccess {  // a pass's read or write of a resource.
+        uint32_t resourceIndex;
+        RenderGraph::ResourceState resourceState;
+    };
+
+    struct ResourceTracking {  // the tracked synchronization state of a resource while compiling the graph.
+        VkImageLayout imageLayout;
+        VkPipelineStageFlags writeStageMask;  // stages of the last write.
+        VkAccessFlags writeAccessMask;  // accesses of the last write.
+        VkPipelineStageFlags readStageMask;  // stages that have read since the last write.
+        VkPipelineStageFlags visibleStageMask;  // stages the last write has been made visible to.
+        VkAccessFlags visibleAccessMask;  // accesses the last write has been made visible to.
+    };
+
+    struct GraphResource {
+        std::string resourceName;
+
+        bool isImage;
+
+        VkImage image;
+        VkImageAspectFlags imageAspectMask;
+        VkBuffer buffer;
+
+        std::optional<RenderGraph::ResourceState> initialState;  // the state before the graph, the graph's own final state is used(wrapped around) if not set.
+        std::optional<RenderGraph::ResourceState> finalState;  // the state after the graph, a resource with a final state is a graph output and is never culled.
+    };
+
+    struct GraphBarrier {  // a compiled resource barrier.
+        uint32_t resourceIndex;
+
+        VkAccessFlags srcAccessMask;
+        VkAccessFlags dstAccessMask;
+        VkImageLayout oldImageLayout;
+        VkImageLayout newImageLayout;
+    };
+
+    struct GraphBarrierBatch {  // barriers recorded together in one pipeline barrier.
+        VkPipelineStageFlags srcStageMask;
+        VkPipelineStageFlags dstStageMask;
+        std::vector<RenderGraph::GraphBarrier> barriers;
+    };
+
+    struct GraphPass {
+        std::string passName;
+
+        std::vector<RenderGraph::ResourceAccess> resourceReads;
+        std::vector<RenderGraph::ResourceAccess> resourceWrites;  // a write without a read of the same resource discards the resource's previous contents.
+
+        std::function<void(VkCommandBuffer)> recordPassCommands;
+
+        bool passCulled = false;  // if no graph output depends on the pass.
+        bool passSkipped = false;  // if the pass is skipped at runtime(ex: an up-to-date cached shadow map).
+        RenderGraph::GraphBarrierBatch passBarrierBatch;  // recorded before the pass.
+    };
+
+    struct Graph {
+        std::vector<RenderGraph::GraphResource> resources;
+        std::vector<RenderGraph::GraphPass> passes;  // in execution order.
+
+        RenderGraph::GraphBarrierBatch outputBarrierBatch;  // transitions graph outputs into their final states.
+
+        bool beenCompiled = false;  // if the graph has been compiled before.
+
+
+        // import an image created outside of the graph.
+        //
+        // @param resourceName the name of the resource.
+        // @param image the imported image.
+        // @param imageAspectMask the aspects of the image to synchronize.
+        // @param initialState optional state of the image before the graph.
+        // @param finalState optional state to leave the image in after the graph.
+        // @param resourceIndex the index of the imported resource.
+        void importImageResource(std::string resourceName, VkImage image, VkImageAspectFlags imageAspectMask, std::optional<RenderGraph::ResourceState> initialState, std::optional<RenderGraph::ResourceState> finalState, uint32_t& resourceIndex);
+
+        // import a buffer created outside of the graph.
+        //
+        // @param resourceName the name of the resource.
+        // @param buffer the imported buffer.
+        // @param initialState optional state of the buffer before the graph.
+        // @param finalState optional state to leave the buffer in after the graph.
+        // @param resourceIndex the index of the imported resource.
+        void importBufferResource(std::string resourceName, VkBuffer buffer, std::optional<RenderGraph::ResourceState> initialState, std::optional<RenderGraph::ResourceState> finalState, uint32_t& resourceIndex);
+
+        // add a pass to the end of the graph.
+        //
+        // @param passName the name of the pass.
+        // @param resourceReads the resources read by the pass.
+        // @param resourceWrites the resources written by the pass.
+        // @param recordPassCommands function recording the pass's commands.
+        void addPass(std::string passName, std::vector<RenderGraph::ResourceAccess> resourceReads, std::vector<RenderGraph::ResourceAccess> resourceWrites, std::function<void(VkCommandBuffer)> recordPassCommands);
+
+        // fetch the index of a resource by name.
+        //
+        // @param resourceName the name of the resource.
+        // @param resourceIndex the fetched resource index.
+        void fetchResourceIndex(std::string resourceName, uint32_t& resourceIndex);
+
+        // replace the function recording a pass's commands.
+        //
+        // @param passName the name of the pass.
+        // @param recordPassCommands function recording the pass's commands.
+        void setPassRecording(std::string passName, std::function<void(VkCommandBuffer)> recordPassCommands);
+
+        // skip or unskip a pass at runtime, recomputing the barriers if changed.
+        //
+        // the skipped pass's writes are expected to be left intact from when it last ran.
+        //
+        // @param passName the name of the pass.
+        // @param passSkipped if the pass should be skipped.
+        void setPassSkipped(std::string passName, bool passSkipped);
+
+        // update the handle of an imported image(ex: the acquired swapchain image).
+        //
+        // @param resourceName the name of the imported image resource.
+        // @param image the new image handle.
+        void updateImportedImage(std::string resourceName, VkImage image);
+
+        // compile the graph: cull unused passes and compute the barriers between passes.
+        void compileGraph();
+
+        // compute the barriers between the unculled and unskipped passes, wrapping the resource states around from the end of the graph.
+        void compileBarriers();
+
+        // simulate the graph's resource accesses, optionally storing the computed barriers.
+        //
+        // @param storeBarriers if the computed barriers should be stored in the passes.
+        // @param resourceTrackings the tracked resource states, initial states in and final states out.
+        void simulateResourceAccesses(bool storeBarriers, std::vector<RenderGraph::ResourceTracking>& resourceTrackings);
+
+        // record a batch of compiled barriers as a single pipeline barrier.
+        //
+        // @param barrierBatch the barrier batch to record.
+        // @param commandBuffer the command buffer to record in.
+        void recordBarrierBatch(const RenderGraph::GraphBarrierBatch& barrierBatch, VkCommandBuffer commandBuffer);
+
+        // record the compiled graph's barriers and passes.
+        //
+        // @param commandBuffer the command buffer to record in.
+        // @param recordPassEnd optional function recorded after each pass(ex: a timestamp), given the pass's name.
+        void executeGraph(VkCommandBuffer commandBuffer, std::function<void(const std::string&, VkCommandBuffer)> recordPassEnd);
+    };
+}
+
+
+#endif  // RENDERGRAPH_H
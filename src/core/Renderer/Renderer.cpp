@@ -20,23 +20,90 @@
 #include <cstdint>
 #include <string>
 #include <vector>
+#include <utility>
+#include <bitset>
+#include <numeric>
+#include <functional>
+#include <algorithm>
+#include <iterator>
+#include <iostream>
 
 
 void RendererDetails::Renderer::run(DisplayManager::DisplayDetails& displayDetails, VkPhysicalDevice vulkanPhysicalDevice)
 {
+    // frame times are averaged over the report interval, comparing the rendering paths on the same scene.
+    // the GPU time of each render graph pass is measured by the resolution controller's timestamps, and summed by name.
+    // each pass is averaged over the frames it ran in, a pass skipped in some frames(ex: cached shadows) reports its cost when it runs.
+    struct PassTimeReportTotal {
+        std::string passName;
+        double passTime;  // summed in milliseconds.
+        uint32_t passFrameCount;
+    };
+
+    double frameTimeReportStartTime = glfwGetTime();
+    uint32_t frameTimeReportFrameCount = 0;
+    std::vector<PassTimeReportTotal> passTimeReportTotals;
+
     while (!glfwWindowShouldClose(displayDetails.glfwWindow)) {  // "main loop"
         DisplayManager::processWindowInput(displayDetails.glfwWindow);
         glfwPollEvents();
 
+        if ((Defaults::callbacksVariables.ANTI_ALIASING_CYCLED == true) || (Defaults::callbacksVariables.SAMPLE_SHADING_TOGGLED == true)) {
+            applyMemberAntiAliasing(displayDetails, vulkanPhysicalDevice);
+
+            // the frame times are only averaged within a single anti-aliasing mode.
+            frameTimeReportStartTime = glfwGetTime();
+            frameTimeReportFrameCount = 0;
+            passTimeReportTotals.clear();
+        }
+
+        // the governor follows the resolution controller, the render scale is only applied with TAA.
+        bool msaaSampleCountChanged;
+        bool resolutionScaled = ((m_antiAliasingMode == "TAA") && (Defaults::rendererDefaults.TARGET_FRAME_TIME > 0.0f));
+        m_qualityGovernor.updateGovernor(m_resolutionController, resolutionScaled, m_cpuFrameTime, msaaSampleCountChanged);
+        if (msaaSampleCountChanged == true) {
+            applyMemberAntiAliasing(displayDetails, vulkanPhysicalDevice);
+        }
+
         drawFrame(displayDetails, vulkanPhysicalDevice, displayDetails.graphicsQueue, displayDetails.presentationQueue);
+
+        if (Defaults::rendererDefaults.FRAME_TIME_REPORT_INTERVAL > 0) {
+            frameTimeReportFrameCount += 1;
+            for (const std::pair<std::string, float>& passTime : m_resolutionController.passTimes) {  // the pass times measured by this frame in flight's previous submission.
+                auto passTimeReportTotal = std::find_if(passTimeReportTotals.begin(), passTimeReportTotals.end(), [&](const PassTimeReportTotal& reportTotal) { return (reportTotal.passName == passTime.first); });
+                if (passTimeReportTotal == passTimeReportTotals.end()) {
+                    passTimeReportTotals.push_back({passTime.first, passTime.second, 1});
+                } else {
+                    passTimeReportTotal->passTime += passTime.second;
+                    passTimeReportTotal->passFrameCount += 1;
+                }
+            }
+
+            if (frameTimeReportFrameCount == Defaults::rendererDefaults.FRAME_TIME_REPORT_INTERVAL) {
+                double frameTimeReportEndTime = glfwGetTime();
+                std::cout << "average frame time(" << Defaults::rendererDefaults.RENDERING_PATH << ", " << m_antiAliasingMode << "): " << (((frameTimeReportEndTime - frameTimeReportStartTime) * 1000.0) / frameTimeReportFrameCount) << "ms";
+                if (m_resolutionController.timestampsSupported == true) {
+                    std::cout << ", GPU " << m_resolutionController.smoothedFrameTime << "ms(smoothed)" << std::endl;
+                    for (const PassTimeReportTotal& passTimeReportTotal : passTimeReportTotals) {
+                        std::cout << "    " << passTimeReportTotal.passName << ": " << (passTimeReportTotal.passTime / passTimeReportTotal.passFrameCount) << "ms(" << passTimeReportTotal.passFrameCount << "/" << frameTimeReportFrameCount << " frames)" << std::endl;
+                    }
+                } else {
+                    std::cout << std::endl;
+                }
+
+                frameTimeReportStartTime = frameTimeReportEndTime;
+                frameTimeReportFrameCount = 0;
+                passTimeReportTotals.clear();
+            }
+        }
     }
 
     vkDeviceWaitIdle(*m_vulkanLogicalDevice);  // wait for the logical device to finish all operations before termination.
 }
 
-void RendererDetails::populateColorAttachmentComponents(VkFormat swapchainImageFormat, VkSampleCountFlagBits msaaSampleCount, VkAttachmentDescription& colorAttachmentDescription, VkAttachmentReference& colorAttachmentReference, VkAttachmentDescription& colorAttachmentResolveDescription, VkAttachmentReference& colorAttachmentResolveReference)
+void RendererDetails::populateColorAttachmentComponents(VkFormat colorImageFormat, VkSampleCountFlagBits msaaSampleCount, VkAttachmentDescription& colorAttachmentDescription, VkAttachmentReference& colorAttachmentReference, VkAttachmentDescription& colorAttachmentResolveDescription, VkAttachmentReference& colorAttachmentResolveReference)
 {
-    colorAttachmentDescription.format = swapchainImageFormat;
+    colorAttachmentDescription.format = colorImageFormat;
     colorAttachmentDescription.samples = msaaSampleCount;
     
     colorAttachmentDescription.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
@@ -44,7 +111,8 @@ void RendererDetails::populateColorAttachmentComponents(VkFormat swapchainImageF
     colorAttachmentDescription.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
     colorAttachmentDescription.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
     
-    colorAttachmentDescription.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    // layout transitions are recorded by the render graph.
+    colorAttachmentDescription.initialLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
     colorAttachmentDescription.finalLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
 
     
@@ -52,7 +120,7 @@ void RendererDetails::populateColorAttachmentComponents(VkFormat swapchainImageF
     colorAttachmentReference.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
 
 
-    colorAttachmentResolveDescription.format = swapchainImageFormat;
+    colorAttachmentResolveDescription.format = colorImageFormat;
     colorAttachmentResolveDescription.samples = VK_SAMPLE_COUNT_1_BIT;
 
     colorAttachmentResolveDescription.loadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
@@ -60,19 +128,17 @@ void RendererDetails::populateColorAttachmentComponents(VkFormat swapchainImageF
     colorAttachmentResolveDescription.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
     colorAttachmentResolveDescription.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
 
-    colorAttachmentResolveDescription.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-    colorAttachmentResolveDescription.finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+    colorAttachmentResolveDescription.initialLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+    colorAttachmentResolveDescription.finalLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;  // transitioned for the anti-aliasing passes by the render graph.
 
 
     colorAttachmentResolveReference.attachment = 2;
     colorAttachmentResolveReference.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
 }
 
-void RendererDetails::populateDepthAttachmentComponents(VkSampleCountFlagBits msaaSampleCount, VkAttachmentStoreOp storeOp, uint32_t attachment, VkPhysicalDevice vulkanPhysicalDevice, VkAttachmentDescription& depthAttachmentDescription, VkAttachmentReference& depthAttachmentReference)
+void RendererDetails::populateDepthAttachmentComponents(VkSampleCountFlagBits msaaSampleCount, VkAttachmentStoreOp storeOp, uint32_t attachment, VkFormat depthAttachmentFormat, VkAttachmentDescription& depthAttachmentDescription, VkAttachmentReference& depthAttachmentReference)
 {
-    VkFormat depthAttachmentDescriptionFormat;
-    Depth::selectDepthImageFormat(vulkanPhysicalDevice, depthAttachmentDescriptionFormat);
-    depthAttachmentDescription.format = depthAttachmentDescriptionFormat;
+    depthAttachmentDescription.format = depthAttachmentFormat;
     depthAttachmentDescription.samples = msaaSampleCount;
 
     depthAttachmentDescription.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
@@ -80,30 +146,62 @@ void RendererDetails::populateDepthAttachmentComponents(VkSampleCountFlagBits ms
     depthAttachmentDescription.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
     depthAttachmentDescription.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
 
-    depthAttachmentDescription.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;  // we have no need for the previous depth buffer's contents.
-    if (storeOp == VK_ATTACHMENT_STORE_OP_STORE) {  // the attachment will be read later.
-        depthAttachmentDescription.finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;  // allows use as a depth attachment(writing) and shader-accessible image(reading, through a combined sampler).
-    } else {
-        depthAttachmentDescription.finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
-    }
+    // layout transitions(ex: to a shader-accessible layout for shadow maps) are recorded by the render graph.
+    depthAttachmentDescription.initialLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+    depthAttachmentDescription.finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
 
     depthAttachmentReference.attachment = attachment;
     depthAttachmentReference.layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
 }
 
-void RendererDetails::Renderer::createMemberRenderPass(VkFormat swapchainImageFormat, VkSampleCountFlagBits msaaSampleCount, VkPhysicalDevice vulkanPhysicalDevice)
+void RendererDetails::Renderer::selectMemberSampleCount(VkPhysicalDevice vulkanPhysicalDevice, VkSampleCountFlagBits& msaaSampleCount)
+{
+    VkSampleCountFlagBits maximumUsableSampleCount;
+    fetchMaximumUsableSampleCount(vulkanPhysicalDevice, maximumUsableSampleCount);
+
+    AntiAliasing::fetchModeSampleCount(m_antiAliasingMode, msaaSampleCount);
+    while (msaaSampleCount > maximumUsableSampleCount) {
+        msaaSampleCount = static_cast<VkSampleCountFlagBits>(msaaSampleCount >> 1);
+    }
+
+    VkImageFormatProperties sceneColorImageFormatProperties;  // the packed HDR format can support fewer samples than an 8-bit color.
+    vkGetPhysicalDeviceImageFormatProperties(vulkanPhysicalDevice, RendererDetails::sceneColorImageFormat, VK_IMAGE_TYPE_2D, VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT, 0, &sceneColorImageFormatProperties);
+    while ((sceneColorImageFormatProperties.sampleCounts & msaaSampleCount) == 0) {
+        msaaSampleCount = static_cast<VkSampleCountFlagBits>(msaaSampleCount >> 1);
+    }
+
+    if (m_visibilityBufferEnabled == true) {  // integer color attachments can support fewer samples than the other attachments.
+        VkImageFormatProperties visibilityImageFormatProperties;
+        vkGetPhysicalDeviceImageFormatProperties(vulkanPhysicalDevice, RendererDetails::visibilityBufferImageFormat, VK_IMAGE_TYPE_2D, VK_IMAGE_TILING_OPTIMAL, (VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT), 0, &visibilityImageFormatProperties);
+        while ((visibilityImageFormatProperties.sampleCounts & msaaSampleCount) == 0) {
+            msaaSampleCount = static_cast<VkSampleCountFlagBits>(msaaSampleCount >> 1);
+        }
+    }
+}
+
+void RendererDetails::Renderer::createMemberRenderPass(VkFormat colorImageFormat, VkSampleCountFlagBits msaaSampleCount, VkPhysicalDevice vulkanPhysicalDevice)
 {
     VkAttachmentDescription colorAttachmentDescription{};
     VkAttachmentReference colorAttachmentReference{};
-    // color attachment resolve "resolves" the general color attachment for presentation.
+    // color attachment resolve "resolves" the general color attachment into the single-sampled scene color, only with msaa.
     VkAttachmentDescription colorAttachmentResolveDescription{};
     VkAttachmentReference colorAttachmentResolveReference{};
-    populateColorAttachmentComponents(swapchainImageFormat, msaaSampleCount, colorAttachmentDescription, colorAttachmentReference, colorAttachmentResolveDescription, colorAttachmentResolveReference);
+    populateColorAttachmentComponents(colorImageFormat, msaaSampleCount, colorAttachmentDescription, colorAttachmentReference, colorAttachmentResolveDescription, colorAttachmentResolveReference);
 
 
     VkAttachmentDescription depthAttachmentDescription{};
     VkAttachmentReference depthAttachmentReference{};
-    populateDepthAttachmentComponents(msaaSampleCount, VK_ATTACHMENT_STORE_OP_DONT_CARE, 1, vulkanPhysicalDevice, depthAttachmentDescription, depthAttachmentReference);
+    VkFormat depthAttachmentFormat;
+    Depth::selectDepthImageFormat(vulkanPhysicalDevice, depthAttachmentFormat);
+    populateDepthAttachmentComponents(msaaSampleCount, VK_ATTACHMENT_STORE_OP_STORE, 1, depthAttachmentFormat, depthAttachmentDescription, depthAttachmentReference);  // reduced into the depth pyramid, loaded by the late render pass, and read by the temporal passes.
+
+    // the early render pass keeps its attachments for the late render pass, which resolves the final color.
+    // without occlusion culling the frame is drawn entirely in the early render pass, which resolves the final color instead(the msaa color attachment is then transient).
+    // without msaa the color attachment is the single-sampled scene color itself, and is stored by the pass that finishes it.
+    bool singleMainRenderPass = (m_occlusionCullingEnabled == false);
+    bool sceneColorResolved = (msaaSampleCount != VK_SAMPLE_COUNT_1_BIT);
+    colorAttachmentDescription.storeOp = (((singleMainRenderPass == true) && (sceneColorResolved == true)) ? VK_ATTACHMENT_STORE_OP_DONT_CARE : VK_ATTACHMENT_STORE_OP_STORE);
+    colorAttachmentResolveDescription.storeOp = ((singleMainRenderPass == true) ? VK_ATTACHMENT_STORE_OP_STORE : VK_ATTACHMENT_STORE_OP_DONT_CARE);
     
     
     VkSubpassDescription subpassDescription{};
@@ -111,25 +209,66 @@ void RendererDetails::Renderer::createMemberRenderPass(VkFormat swapchainImageFo
     
     subpassDescription.colorAttachmentCount = 1;
     subpassDescription.pColorAttachments = &colorAttachmentReference;
-    subpassDescription.pResolveAttachments = &colorAttachmentResolveReference;
+    subpassDescription.pResolveAttachments = ((sceneColorResolved == true) ? &colorAttachmentResolveReference : nullptr);
     subpassDescription.pDepthStencilAttachment = &depthAttachmentReference;
 
-    
-    VkSubpassDependency subpassDependency{};
-    
-    subpassDependency.srcSubpass = VK_SUBPASS_EXTERNAL;
-    subpassDependency.dstSubpass = 0;
 
-    // operations to wait on/operations that should wait.
-    subpassDependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
-    subpassDependency.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
-    
-    subpassDependency.srcAccessMask = 0;
-    subpassDependency.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
 
+    std::vector<VkAttachmentDescription> attachmentDescriptions = {colorAttachmentDescription, depthAttachmentDescription};
+    if (sceneColorResolved == true) {
+        attachmentDescriptions.push_back(colorAttachmentResolveDescription);
+    }
+    std::vector<VkSubpassDescription> subpassDescriptions = {subpassDescription};
+    std::vector<VkSubpassDependency> subpassDependencies;
+
+    // the deferred G-buffer subpass writes the G-buffer attachments(following the resolve attachment, if any) and depth,
+    // the lighting subpass reads them as input attachments and shades the color attachment, they never leave tile memory without occlusion culling.
+    // the visibility buffer is a G-buffer of a single attachment, shaded the same way.
+    std::vector<VkAttachmentReference> gBufferAttachmentReferences;
+    std::vector<VkAttachmentReference> gBufferInputAttachmentReferences;
+    VkAttachmentReference readOnlyDepthAttachmentReference{};
+    if (m_deferredRenderingEnabled == true) {
+        for (size_t i = 0; i < m_gBufferImageFormats.size(); i += 1) {
+            VkAttachmentDescription gBufferAttachmentDescription = colorAttachmentDescription;  // cleared like the color attachment, with the same sample count.
+            gBufferAttachmentDescription.format = m_gBufferImageFormats[i];
+            gBufferAttachmentDescription.storeOp = ((singleMainRenderPass == true) ? VK_ATTACHMENT_STORE_OP_DONT_CARE : VK_ATTACHMENT_STORE_OP_STORE);  // loaded by the late render pass's G-buffer draws.
+            attachmentDescriptions.push_back(gBufferAttachmentDescription);
+
+            uint32_t gBufferAttachment = static_cast<uint32_t>(attachmentDescriptions.size() - 1);
+            gBufferAttachmentReferences.push_back({gBufferAttachment, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL});
+            gBufferInputAttachmentReferences.push_back({gBufferAttachment, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL});
+        }
+        readOnlyDepthAttachmentReference = {depthAttachmentReference.attachment, VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL};  // depth tested by the cubemap, and read as an input attachment.
+        gBufferInputAttachmentReferences.push_back(readOnlyDepthAttachmentReference);
+
+        VkSubpassDescription gBufferSubpassDescription{};
+        gBufferSubpassDescription.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+
+        gBufferSubpassDescription.colorAttachmentCount = static_cast<uint32_t>(gBufferAttachmentReferences.size());
+        gBufferSubpassDescription.pColorAttachments = gBufferAttachmentReferences.data();
+        gBufferSubpassDescription.pDepthStencilAttachment = &depthAttachmentReference;
 
+        VkSubpassDescription lightingSubpassDescription = subpassDescription;
+        lightingSubpassDescription.inputAttachmentCount = static_cast<uint32_t>(gBufferInputAttachmentReferences.size());
+        lightingSubpassDescription.pInputAttachments = gBufferInputAttachmentReferences.data();
+        lightingSubpassDescription.pDepthStencilAttachment = &readOnlyDepthAttachmentReference;
 
-    std::array<VkAttachmentDescription, 3> attachmentDescriptions = {colorAttachmentDescription, depthAttachmentDescription, colorAttachmentResolveDescription};
+        subpassDescriptions = {gBufferSubpassDescription, lightingSubpassDescription};
+
+        // each pixel's lighting only reads its own G-buffer samples, tile-based GPUs keep the dependency within the tile.
+        VkSubpassDependency gBufferSubpassDependency{};
+        gBufferSubpassDependency.srcSubpass = 0;
+        gBufferSubpassDependency.dstSubpass = 1;
+
+        gBufferSubpassDependency.srcStageMask = (VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT);
+        gBufferSubpassDependency.srcAccessMask = (VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT);
+        gBufferSubpassDependency.dstStageMask = (VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT);
+        gBufferSubpassDependency.dstAccessMask = (VK_ACCESS_INPUT_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT);
+
+        gBufferSubpassDependency.dependencyFlags = VK_DEPENDENCY_BY_REGION_BIT;
+
+        subpassDependencies.push_back(gBufferSubpassDependency);
+    }
     
     VkRenderPassCreateInfo renderPassCreateInfo{};
     renderPassCreateInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
@@ -137,24 +276,53 @@ void RendererDetails::Renderer::createMemberRenderPass(VkFormat swapchainImageFo
     renderPassCreateInfo.attachmentCount = static_cast<uint32_t>(attachmentDescriptions.size());
     renderPassCreateInfo.pAttachments = attachmentDescriptions.data();
     
-    renderPassCreateInfo.subpassCount = 1;
-    renderPassCreateInfo.pSubpasses = &subpassDescription;
+    renderPassCreateInfo.subpassCount = static_cast<uint32_t>(subpassDescriptions.size());
+    renderPassCreateInfo.pSubpasses = subpassDescriptions.data();
 
-    renderPassCreateInfo.dependencyCount = 1;
-    renderPassCreateInfo.pDependencies = &subpassDependency;
+    // external dependencies are recorded as barriers by the render graph, only the G-buffer to lighting subpass dependency is internal.
+    renderPassCreateInfo.dependencyCount = static_cast<uint32_t>(subpassDependencies.size());
+    renderPassCreateInfo.pDependencies = subpassDependencies.data();
 
     
     size_t renderPassCreationResult = vkCreateRenderPass(*m_vulkanLogicalDevice, &renderPassCreateInfo, nullptr, &m_renderPass);
     if (renderPassCreationResult != VK_SUCCESS) {
         throwDebugException("Failed to create member render pass.");
     }
+
+    m_lateRenderPass = VK_NULL_HANDLE;  // destroyed all the same.
+    if (singleMainRenderPass == true) {
+        return;
+    }
+
+
+    // only the load and store operations differ, the late render pass is compatible with the framebuffers and secondary command buffers of the render pass.
+    attachmentDescriptions[0].loadOp = VK_ATTACHMENT_LOAD_OP_LOAD;
+    attachmentDescriptions[0].storeOp = ((sceneColorResolved == true) ? VK_ATTACHMENT_STORE_OP_DONT_CARE : VK_ATTACHMENT_STORE_OP_STORE);
+    attachmentDescriptions[1].loadOp = VK_ATTACHMENT_LOAD_OP_LOAD;
+    attachmentDescriptions[1].storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+    size_t gBufferAttachmentsStart = 2;
+    if (sceneColorResolved == true) {
+        attachmentDescriptions[2].storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+        gBufferAttachmentsStart = 3;
+    }
+    for (size_t i = gBufferAttachmentsStart; i < attachmentDescriptions.size(); i += 1) {  // the G-buffer is not needed after the late lighting subpass.
+        attachmentDescriptions[i].loadOp = VK_ATTACHMENT_LOAD_OP_LOAD;
+        attachmentDescriptions[i].storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+    }
+
+    size_t lateRenderPassCreationResult = vkCreateRenderPass(*m_vulkanLogicalDevice, &renderPassCreateInfo, nullptr, &m_lateRenderPass);
+    if (lateRenderPassCreationResult != VK_SUCCESS) {
+        throwDebugException("Failed to create member late render pass.");
+    }
 }
 
-void RendererDetails::createShadowRenderPass(DeviceHandler::VulkanDevices vulkanDevices, VkRenderPass& renderPass)
+void RendererDetails::createMultiviewShadowRenderPass(uint32_t viewMask, DeviceHandler::VulkanDevices vulkanDevices, VkRenderPass& renderPass)
 {
     VkAttachmentDescription depthAttachmentDescription{};
     VkAttachmentReference depthAttachmentReference{};
-    RendererDetails::populateDepthAttachmentComponents(VK_SAMPLE_COUNT_1_BIT, VK_ATTACHMENT_STORE_OP_STORE, 0, vulkanDevices.physicalDevice, depthAttachmentDescription, depthAttachmentReference);
+    VkFormat shadowAttachmentFormat;
+    Depth::selectShadowImageFormat(vulkanDevices.physicalDevice, shadowAttachmentFormat);
+    RendererDetails::populateDepthAttachmentComponents(VK_SAMPLE_COUNT_1_BIT, VK_ATTACHMENT_STORE_OP_STORE, 0, shadowAttachmentFormat, depthAttachmentDescription, depthAttachmentReference);
     
     
     VkSubpassDescription subpassDescription{};
@@ -162,34 +330,9 @@ void RendererDetails::createShadowRenderPass(DeviceHandler::VulkanDevices vulkan
     
     subpassDescription.pDepthStencilAttachment = &depthAttachmentReference;
 
-    
-    VkSubpassDependency depthAttachmentSubpassDependency{};
-    
-    depthAttachmentSubpassDependency.srcSubpass = VK_SUBPASS_EXTERNAL;
-    depthAttachmentSubpassDependency.dstSubpass = 0;
-
-    // operations to wait on/operations that should wait.
-    depthAttachmentSubpassDependency.srcStageMask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-    depthAttachmentSubpassDependency.dstStageMask = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
-    
-    depthAttachmentSubpassDependency.srcAccessMask = VK_ACCESS_SHADER_READ_BIT;
-    depthAttachmentSubpassDependency.dstAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
-
-    // ensure depth stencil attachment is wrote before it is read.
-    VkSubpassDependency shaderReadSubpassDependency{};
-
-    shaderReadSubpassDependency.srcSubpass = 0;
-    shaderReadSubpassDependency.dstSubpass = VK_SUBPASS_EXTERNAL;
-
-    shaderReadSubpassDependency.srcStageMask = VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
-    shaderReadSubpassDependency.dstStageMask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-    
-    shaderReadSubpassDependency.srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
-    shaderReadSubpassDependency.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
 
 
     std::array<VkAttachmentDescription, 1> attachmentDescriptions = {depthAttachmentDescription};
-    std::array<VkSubpassDependency, 2> subpassDependencies = {depthAttachmentSubpassDependency, shaderReadSubpassDependency};
     
     VkRenderPassCreateInfo renderPassCreateInfo{};
     renderPassCreateInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
@@ -200,8 +343,20 @@ void RendererDetails::createShadowRenderPass(DeviceHandler::VulkanDevices vulkan
     renderPassCreateInfo.subpassCount = 1;
     renderPassCreateInfo.pSubpasses = &subpassDescription;
 
-    renderPassCreateInfo.dependencyCount = static_cast<uint32_t>(subpassDependencies.size());
-    renderPassCreateInfo.pDependencies = subpassDependencies.data();
+    renderPassCreateInfo.dependencyCount = 0;  // the depth write to shader read dependency is recorded as a barrier by the render graph.
+
+    // each view renders to the attachment layer of its index, gl_ViewIndex selects the view's matrices in the shaders.
+    VkRenderPassMultiviewCreateInfo renderPassMultiviewCreateInfo{};
+    renderPassMultiviewCreateInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_MULTIVIEW_CREATE_INFO;
+
+    renderPassMultiviewCreateInfo.subpassCount = 1;
+    renderPassMultiviewCreateInfo.pViewMasks = &viewMask;
+    renderPassMultiviewCreateInfo.correlationMaskCount = 1;
+    renderPassMultiviewCreateInfo.pCorrelationMasks = &viewMask;  // the views are rendered from the same position, hinting concurrent rendering.
+
+    if (viewMask != 0) {
+        renderPassCreateInfo.pNext = &renderPassMultiviewCreateInfo;
+    }
 
     
     size_t renderPassCreationResult = vkCreateRenderPass(vulkanDevices.logicalDevice, &renderPassCreateInfo, nullptr, &renderPass);
@@ -210,6 +365,21 @@ void RendererDetails::createShadowRenderPass(DeviceHandler::VulkanDevices vulkan
     }
 }
 
+void RendererDetails::createDirectionalShadowRenderPass(DeviceHandler::VulkanDevices vulkanDevices, VkRenderPass& renderPass)
+{
+    RendererDetails::createMultiviewShadowRenderPass(((1u << Defaults::rendererDefaults.SHADOW_CASCADE_COUNT) - 1), vulkanDevices, renderPass);  // one view for each cascade.
+}
+
+void RendererDetails::createPointShadowRenderPass(DeviceHandler::VulkanDevices vulkanDevices, VkRenderPass& renderPass)
+{
+    RendererDetails::createMultiviewShadowRenderPass(0b111111, vulkanDevices, renderPass);  // one view for each cubemap face.
+}
+
+void RendererDetails::createShadowLayerRenderPass(DeviceHandler::VulkanDevices vulkanDevices, VkRenderPass& renderPass)
+{
+    RendererDetails::createMultiviewShadowRenderPass(0, vulkanDevices, renderPass);  // without multiview, the framebuffer selects the layer.
+}
+
 void RendererDetails::populateViewportCreateInfo(uint32_t viewportCount, uint32_t scissorCount, VkPipelineViewportStateCreateInfo& viewportCreateInfo)
 {
     viewportCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
@@ -276,16 +446,16 @@ void RendererDetails::fetchMaximumUsableSampleCount(VkPhysicalDevice vulkanPhysi
     maximumUsableSampleCount = VK_SAMPLE_COUNT_1_BIT;
 }
 
-void RendererDetails::populateMultisamplingCreateInfo(VkSampleCountFlagBits rasterizationSamples, float minSampleShading, VkPipelineMultisampleStateCreateInfo& multisamplingCreateInfo)
+void RendererDetails::populateMultisamplingCreateInfo(VkSampleCountFlagBits rasterizationSamples, float minSampleShading, VkBool32 alphaToCoverageEnable, VkPipelineMultisampleStateCreateInfo& multisamplingCreateInfo)
 {
     multisamplingCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
     
-    multisamplingCreateInfo.sampleShadingEnable = VK_TRUE;
+    multisamplingCreateInfo.sampleShadingEnable = ((minSampleShading > 0.0f) ? VK_TRUE : VK_FALSE);  // shaded once per pixel without a minimum sample shading.
     multisamplingCreateInfo.rasterizationSamples = rasterizationSamples;
     multisamplingCreateInfo.minSampleShading = minSampleShading;
     multisamplingCreateInfo.pSampleMask = nullptr;
     
-    multisamplingCreateInfo.alphaToCoverageEnable = VK_FALSE;
+    multisamplingCreateInfo.alphaToCoverageEnable = alphaToCoverageEnable;
     multisamplingCreateInfo.alphaToOneEnable = VK_FALSE;
 }
 
@@ -389,10 +559,11 @@ void RendererDetails::Renderer::createMemberCubemapPipeline(VkSampleCountFlagBit
     cubemapPipelineData.rasterizationFrontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
 
     cubemapPipelineData.multisamplingRasterizationSamples = msaaSampleCount;
-    cubemapPipelineData.multisamplingMinSampleShading = 0.2f;
+    cubemapPipelineData.multisamplingMinSampleShading = ((m_sampleShadingEnabled == true) ? 0.2f : 0.0f);
 
+    // the cubemap is drawn last at the far plane, only where no geometry was drawn.
     cubemapPipelineData.depthStencilDepthTestEnable = VK_TRUE;
-    cubemapPipelineData.depthStencilDepthWriteEnable = VK_TRUE;
+    cubemapPipelineData.depthStencilDepthWriteEnable = VK_FALSE;
     cubemapPipelineData.depthStencilDepthCompareOp = VK_COMPARE_OP_LESS_OR_EQUAL;
 
     cubemapPipelineData.colorBlendColorWriteMask = (VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT);
@@ -401,20 +572,31 @@ void RendererDetails::Renderer::createMemberCubemapPipeline(VkSampleCountFlagBit
     cubemapPipelineData.dynamicStatesDynamicStates = {VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR};
 
     cubemapPipelineData.pipelineRenderPass = m_renderPass;
+    cubemapPipelineData.pipelineSubpass = ((m_deferredRenderingEnabled == true) ? 1 : 0);  // drawn after the deferred lighting.
 
 
     m_cubemapPipelineComponents.createMemberPipeline(cubemapPipelineData);
 }
 
-void RendererDetails::Renderer::createMemberScenePipeline(VkSampleCountFlagBits msaaSampleCount)
+void RendererDetails::Renderer::createMemberScenePipeline(VkSampleCountFlagBits msaaSampleCount, bool alphaMasked)
 {
     Pipeline::PipelineData scenePipelineData;
 
     scenePipelineData.vulkanLogicalDevice = *m_vulkanLogicalDevice;
     
-    scenePipelineData.vertexShaderBytecodeAbsolutePath = (Defaults::applicationDefaults.SALAMANDER_ROOT_DIRECTORY + "/build/sceneVertex.spv");
+    // the deferred scene pipeline only writes the G-buffer, the lighting subpass shades it.
+    // the visibility buffer scene pipeline only writes each pixel's instance and triangle, the opaque pipeline without interpolated attributes.
+    // the masked visibility shaders offset the triangle index past the instance's opaque triangles(the masked draws start there), and alpha test with the texture coordinates.
+    // the masked pipelines discard below each primitive's alpha cutoff, kept out of the opaque pipeline so its early depth testing stays intact.
+    if (m_visibilityBufferEnabled == true) {
+        scenePipelineData.vertexShaderBytecodeAbsolutePath = (Defaults::applicationDefaults.SALAMANDER_ROOT_DIRECTORY + "/build/" + ((alphaMasked == true) ? "sceneVisibilityMaskedVertex.spv" : "sceneVisibilityVertex.spv"));
+        scenePipelineData.fragmentShaderBytecodeAbsolutePath = (Defaults::applicationDefaults.SALAMANDER_ROOT_DIRECTORY + "/build/" + ((alphaMasked == true) ? "sceneVisibilityMaskedFragment.spv" : "sceneVisibilityFragment.spv"));
+    } else {
+        std::string fragmentShaderName = ((m_deferredRenderingEnabled == true) ? "sceneGBuffer" : "scene");
+        scenePipelineData.vertexShaderBytecodeAbsolutePath = (Defaults::applicationDefaults.SALAMANDER_ROOT_DIRECTORY + "/build/sceneVertex.spv");
+        scenePipelineData.fragmentShaderBytecodeAbsolutePath = (Defaults::applicationDefaults.SALAMANDER_ROOT_DIRECTORY + "/build/" + fragmentShaderName + ((alphaMasked == true) ? "MaskedFragment.spv" : "Fragment.spv"));
+    }
     scenePipelineData.geometryShaderBytecodeAbsolutePath = "*NA*";
-    scenePipelineData.fragmentShaderBytecodeAbsolutePath = (Defaults::applicationDefaults.SALAMANDER_ROOT_DIRECTORY + "/build/sceneFragment.spv");
 
     scenePipelineData.vertexDataStride = sizeof(ModelHandler::SceneVertexData);
     scenePipelineData.fetchAttributeDescriptions = ResourceDescriptor::fetchSceneAttributeDescriptions;
@@ -429,21 +611,31 @@ void RendererDetails::Renderer::createMemberScenePipeline(VkSampleCountFlagBits
     scenePipelineData.rasterizationFrontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
 
     scenePipelineData.multisamplingRasterizationSamples = msaaSampleCount;
-    scenePipelineData.multisamplingMinSampleShading = 0.2f;
+    scenePipelineData.multisamplingMinSampleShading = ((m_sampleShadingEnabled == true) ? 0.2f : 0.0f);
+    scenePipelineData.multisamplingAlphaToCoverageEnable = (((alphaMasked == true) && (m_visibilityBufferEnabled == false) && (msaaSampleCount != VK_SAMPLE_COUNT_1_BIT)) ? VK_TRUE : VK_FALSE);  // single-sampled masked fragments are only discarded.
 
+    // with a depth prepass only the nearest fragment of each pixel is shaded, the depth is already written.
+    // the masked geometry isn't in the depth prepass(its depth depends on the alpha test), and writes its own depth.
+    bool depthPrepassed = ((m_depthPrepassEnabled == true) && (alphaMasked == false));
     scenePipelineData.depthStencilDepthTestEnable = VK_TRUE;
-    scenePipelineData.depthStencilDepthWriteEnable = VK_TRUE;
-    scenePipelineData.depthStencilDepthCompareOp = VK_COMPARE_OP_LESS_OR_EQUAL;
+    scenePipelineData.depthStencilDepthWriteEnable = ((depthPrepassed == true) ? VK_FALSE : VK_TRUE);
+    scenePipelineData.depthStencilDepthCompareOp = ((depthPrepassed == true) ? VK_COMPARE_OP_EQUAL : VK_COMPARE_OP_LESS_OR_EQUAL);
 
     scenePipelineData.colorBlendColorWriteMask = (VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT);
-    scenePipelineData.colorBlendBlendEnable = VK_TRUE;
+    scenePipelineData.colorBlendBlendEnable = (((m_deferredRenderingEnabled == true) || (alphaMasked == true)) ? VK_FALSE : VK_TRUE);  // G-buffer values are written as they are, the masked alpha is only coverage.
+    scenePipelineData.colorBlendAttachmentCount = ((m_deferredRenderingEnabled == true) ? static_cast<uint32_t>(m_gBufferImageFormats.size()) : 1);
 
     scenePipelineData.dynamicStatesDynamicStates = {VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR};
 
     scenePipelineData.pipelineRenderPass = m_renderPass;
 
 
-    m_scenePipelineComponents.createMemberPipeline(scenePipelineData);
+    if (alphaMasked == true) {
+        m_sceneMaskedPipelineComponents.descriptorSetLayout = m_scenePipelineComponents.descriptorSetLayout;  // compatible pipeline layouts, the scene descriptor sets are bound.
+        m_sceneMaskedPipelineComponents.createMemberPipeline(scenePipelineData);
+    } else {
+        m_scenePipelineComponents.createMemberPipeline(scenePipelineData);
+    }
 }
 
 void RendererDetails::Renderer::createMemberSceneNormalsPipeline(VkSampleCountFlagBits msaaSampleCount)
@@ -469,10 +661,11 @@ void RendererDetails::Renderer::createMemberSceneNormalsPipeline(VkSampleCountFl
     sceneNormalsPipelineData.rasterizationFrontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
 
     sceneNormalsPipelineData.multisamplingRasterizationSamples = msaaSampleCount;
-    sceneNormalsPipelineData.multisamplingMinSampleShading = 0.2f;
+    sceneNormalsPipelineData.multisamplingMinSampleShading = ((m_sampleShadingEnabled == true) ? 0.2f : 0.0f);
 
+    // the deferred lighting subpass only reads depth.
     sceneNormalsPipelineData.depthStencilDepthTestEnable = VK_TRUE;
-    sceneNormalsPipelineData.depthStencilDepthWriteEnable = VK_TRUE;
+    sceneNormalsPipelineData.depthStencilDepthWriteEnable = ((m_deferredRenderingEnabled == true) ? VK_FALSE : VK_TRUE);
     sceneNormalsPipelineData.depthStencilDepthCompareOp = VK_COMPARE_OP_LESS_OR_EQUAL;
 
     sceneNormalsPipelineData.colorBlendColorWriteMask = (VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT);
@@ -481,24 +674,133 @@ void RendererDetails::Renderer::createMemberSceneNormalsPipeline(VkSampleCountFl
     sceneNormalsPipelineData.dynamicStatesDynamicStates = {VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR};
 
     sceneNormalsPipelineData.pipelineRenderPass = m_renderPass;
+    sceneNormalsPipelineData.pipelineSubpass = ((m_deferredRenderingEnabled == true) ? 1 : 0);
 
 
     m_sceneNormalsPipelineComponents.createMemberPipeline(sceneNormalsPipelineData);
 }
 
-void RendererDetails::createDirectionalShadowPipeline(VkRenderPass renderPass, VkDevice vulkanLogicalDevice, Pipeline::PipelineComponents& pipelineComponents)
+void RendererDetails::Renderer::createMemberDepthPrepassPipeline(VkSampleCountFlagBits msaaSampleCount)
+{
+    Pipeline::PipelineData depthPrepassPipelineData;
+
+    depthPrepassPipelineData.vulkanLogicalDevice = *m_vulkanLogicalDevice;
+    
+    depthPrepassPipelineData.vertexShaderBytecodeAbsolutePath = (Defaults::applicationDefaults.SALAMANDER_ROOT_DIRECTORY + "/build/depthPrepassVertex.spv");
+    depthPrepassPipelineData.geometryShaderBytecodeAbsolutePath = "*NA*";
+    depthPrepassPipelineData.fragmentShaderBytecodeAbsolutePath = "*NA*";  // only depth is written.
+
+    // uses the same position-only vertex data as the shadow pipelines.
+    depthPrepassPipelineData.vertexDataStride = sizeof(ModelHandler::ShadowVertexData);
+    depthPrepassPipelineData.fetchAttributeDescriptions = ResourceDescriptor::fetchShadowAttributeDescriptions;
+
+    depthPrepassPipelineData.inputAssemblyTopology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+    depthPrepassPipelineData.inputAssemblyPrimitiveRestartEnable = VK_FALSE;
+
+    depthPrepassPipelineData.viewportViewportCount = 1;
+    depthPrepassPipelineData.viewportScissorCount = 1;
+    
+    depthPrepassPipelineData.rasterizationCullMode = VK_CULL_MODE_BACK_BIT;  // identical to the scene pipeline, every shaded fragment needs a prepass depth.
+    depthPrepassPipelineData.rasterizationFrontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+
+    depthPrepassPipelineData.multisamplingRasterizationSamples = msaaSampleCount;
+    depthPrepassPipelineData.multisamplingMinSampleShading = ((m_sampleShadingEnabled == true) ? 0.2f : 0.0f);
+
+    depthPrepassPipelineData.depthStencilDepthTestEnable = VK_TRUE;
+    depthPrepassPipelineData.depthStencilDepthWriteEnable = VK_TRUE;
+    depthPrepassPipelineData.depthStencilDepthCompareOp = VK_COMPARE_OP_LESS_OR_EQUAL;
+
+    depthPrepassPipelineData.colorBlendColorWriteMask = 0;  // no fragment shader, the color attachment is left untouched.
+    depthPrepassPipelineData.colorBlendBlendEnable = VK_FALSE;
+    depthPrepassPipelineData.colorBlendAttachmentCount = ((m_deferredRenderingEnabled == true) ? static_cast<uint32_t>(m_gBufferImageFormats.size()) : 1);  // drawn in the G-buffer subpass.
+
+    depthPrepassPipelineData.dynamicStatesDynamicStates = {VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR};
+
+    depthPrepassPipelineData.pipelineRenderPass = m_renderPass;
+
+
+    m_depthPrepassPipelineComponents.descriptorSetLayout = m_scenePipelineComponents.descriptorSetLayout;  // compatible pipeline layouts, the scene descriptor sets are bound.
+    m_depthPrepassPipelineComponents.createMemberPipeline(depthPrepassPipelineData);
+}
+
+void RendererDetails::Renderer::createMemberDeferredLightingPipeline(VkSampleCountFlagBits msaaSampleCount)
+{
+    Pipeline::PipelineData deferredLightingPipelineData;
+
+    deferredLightingPipelineData.vulkanLogicalDevice = *m_vulkanLogicalDevice;
+    
+    deferredLightingPipelineData.vertexShaderBytecodeAbsolutePath = (Defaults::applicationDefaults.SALAMANDER_ROOT_DIRECTORY + "/build/deferredLightingVertex.spv");
+    deferredLightingPipelineData.geometryShaderBytecodeAbsolutePath = "*NA*";
+    // multisampled G-buffers are read per sample, the visibility buffer is shaded from the triangles it references.
+    std::string lightingFragmentShaderName = ((m_visibilityBufferEnabled == true) ? "visibilityShading" : "deferredLighting");
+    deferredLightingPipelineData.fragmentShaderBytecodeAbsolutePath = (Defaults::applicationDefaults.SALAMANDER_ROOT_DIRECTORY + "/build/" + lightingFragmentShaderName + ((msaaSampleCount != VK_SAMPLE_COUNT_1_BIT) ? "MultisampledFragment.spv" : "Fragment.spv"));
+
+    // a fullscreen triangle generated from the vertex index, without vertex data.
+    deferredLightingPipelineData.vertexDataStride = 0;
+    deferredLightingPipelineData.fetchAttributeDescriptions = [](std::vector<VkVertexInputAttributeDescription>& attributeDescriptions) { attributeDescriptions.clear(); };
+
+    deferredLightingPipelineData.inputAssemblyTopology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+    deferredLightingPipelineData.inputAssemblyPrimitiveRestartEnable = VK_FALSE;
+
+    deferredLightingPipelineData.viewportViewportCount = 1;
+    deferredLightingPipelineData.viewportScissorCount = 1;
+    
+    deferredLightingPipelineData.rasterizationCullMode = VK_CULL_MODE_NONE;
+    deferredLightingPipelineData.rasterizationFrontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+
+    deferredLightingPipelineData.multisamplingRasterizationSamples = msaaSampleCount;
+    deferredLightingPipelineData.multisamplingMinSampleShading = 1.0f;  // every sample is lit from its own G-buffer samples.
+
+    // sky pixels are discarded by the lighting shader from the depth input attachment instead.
+    deferredLightingPipelineData.depthStencilDepthTestEnable = VK_FALSE;
+    deferredLightingPipelineData.depthStencilDepthWriteEnable = VK_FALSE;
+    deferredLightingPipelineData.depthStencilDepthCompareOp = VK_COMPARE_OP_ALWAYS;
+
+    deferredLightingPipelineData.colorBlendColorWriteMask = (VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT);
+    deferredLightingPipelineData.colorBlendBlendEnable = VK_FALSE;
+
+    deferredLightingPipelineData.dynamicStatesDynamicStates = {VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR};
+
+    deferredLightingPipelineData.pipelineRenderPass = m_renderPass;
+    deferredLightingPipelineData.pipelineSubpass = 1;
+
+
+    m_deferredLightingPipelineComponents.descriptorSetLayout = m_scenePipelineComponents.descriptorSetLayout;  // compatible pipeline layouts, the scene descriptor sets are bound.
+    m_deferredLightingPipelineComponents.createMemberPipeline(deferredLightingPipelineData);
+}
+
+void RendererDetails::Renderer::populateMemberGBufferDescriptors(DisplayManager::DisplayDetails& displayDetails)
+{
+    // input attachments are read at the fragment's own pixel, without a sampler.
+    std::vector<VkDescriptorImageInfo> inputAttachmentDescriptorImageInfos(displayDetails.gBufferImageDetails.size() + 1);
+    for (size_t i = 0; i < displayDetails.gBufferImageDetails.size(); i += 1) {
+        ResourceDescriptor::populateDescriptorImageInfo(VK_NULL_HANDLE, displayDetails.gBufferImageDetails[i].imageView, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, inputAttachmentDescriptorImageInfos[i]);
+    }
+    ResourceDescriptor::populateDescriptorImageInfo(VK_NULL_HANDLE, displayDetails.depthImageDetails.imageView, VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL, inputAttachmentDescriptorImageInfos.back());
+
+    for (size_t i = 0; i < m_scenePipelineComponents.descriptorSets.size(); i += 1) {
+        std::vector<VkWriteDescriptorSet> inputAttachmentWriteDescriptorSets(inputAttachmentDescriptorImageInfos.size());
+        for (size_t j = 0; j < inputAttachmentDescriptorImageInfos.size(); j += 1) {
+            ResourceDescriptor::populateWriteDescriptorSet(m_scenePipelineComponents.descriptorSets[i], (RendererDetails::gBufferInputAttachmentBinding + static_cast<uint32_t>(j)), VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT, &inputAttachmentDescriptorImageInfos[j], nullptr, inputAttachmentWriteDescriptorSets[j]);
+        }
+
+        vkUpdateDescriptorSets(*m_vulkanLogicalDevice, static_cast<uint32_t>(inputAttachmentWriteDescriptorSets.size()), inputAttachmentWriteDescriptorSets.data(), 0, nullptr);
+    }
+}
+
+void RendererDetails::createDirectionalShadowPipeline(VkRenderPass renderPass, VkDevice vulkanLogicalDevice, bool alphaMasked, Pipeline::PipelineComponents& pipelineComponents)
 {
     Pipeline::PipelineData directionalShadowPipelineData;
 
     directionalShadowPipelineData.vulkanLogicalDevice = vulkanLogicalDevice;
     
-    directionalShadowPipelineData.vertexShaderBytecodeAbsolutePath = (Defaults::applicationDefaults.SALAMANDER_ROOT_DIRECTORY + "/build/directionalShadowVertex.spv");
+    directionalShadowPipelineData.vertexShaderBytecodeAbsolutePath = (Defaults::applicationDefaults.SALAMANDER_ROOT_DIRECTORY + "/build/directionalShadow" + ((alphaMasked == true) ? "MaskedVertex.spv" : "Vertex.spv"));
     directionalShadowPipelineData.geometryShaderBytecodeAbsolutePath = "*NA*";
-    directionalShadowPipelineData.fragmentShaderBytecodeAbsolutePath = (Defaults::applicationDefaults.SALAMANDER_ROOT_DIRECTORY + "/build/directionalShadowFragment.spv");
+    directionalShadowPipelineData.fragmentShaderBytecodeAbsolutePath = (Defaults::applicationDefaults.SALAMANDER_ROOT_DIRECTORY + "/build/directionalShadow" + ((alphaMasked == true) ? "MaskedFragment.spv" : "Fragment.spv"));
 
     // uses the same vertex data stride and similar as the cubemap pipeline.
-    directionalShadowPipelineData.vertexDataStride = sizeof(ModelHandler::ShadowVertexData);
-    directionalShadowPipelineData.fetchAttributeDescriptions = ResourceDescriptor::fetchShadowAttributeDescriptions;
+    directionalShadowPipelineData.vertexDataStride = ((alphaMasked == true) ? sizeof(ModelHandler::SceneVertexData) : sizeof(ModelHandler::ShadowVertexData));  // the masked casters are drawn from the scene vertex data, their alpha test needs the texture coordinates.
+    directionalShadowPipelineData.fetchAttributeDescriptions = ((alphaMasked == true) ? ResourceDescriptor::fetchMaskedShadowAttributeDescriptions : ResourceDescriptor::fetchShadowAttributeDescriptions);
 
     directionalShadowPipelineData.inputAssemblyTopology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
     directionalShadowPipelineData.inputAssemblyPrimitiveRestartEnable = VK_FALSE;
@@ -527,19 +829,19 @@ void RendererDetails::createDirectionalShadowPipeline(VkRenderPass renderPass, V
     pipelineComponents.createMemberPipeline(directionalShadowPipelineData);
 }
 
-void RendererDetails::createPointShadowPipeline(VkRenderPass renderPass, VkDevice vulkanLogicalDevice, Pipeline::PipelineComponents& pipelineComponents)
+void RendererDetails::createPointShadowPipeline(VkRenderPass renderPass, VkDevice vulkanLogicalDevice, bool alphaMasked, Pipeline::PipelineComponents& pipelineComponents)
 {
     Pipeline::PipelineData pointShadowPipelineData;
 
     pointShadowPipelineData.vulkanLogicalDevice = vulkanLogicalDevice;
     
-    pointShadowPipelineData.vertexShaderBytecodeAbsolutePath = (Defaults::applicationDefaults.SALAMANDER_ROOT_DIRECTORY + "/build/pointShadowVertex.spv");
+    pointShadowPipelineData.vertexShaderBytecodeAbsolutePath = (Defaults::applicationDefaults.SALAMANDER_ROOT_DIRECTORY + "/build/pointShadow" + ((alphaMasked == true) ? "MaskedVertex.spv" : "Vertex.spv"));
     pointShadowPipelineData.geometryShaderBytecodeAbsolutePath = "*NA*";
-    pointShadowPipelineData.fragmentShaderBytecodeAbsolutePath = (Defaults::applicationDefaults.SALAMANDER_ROOT_DIRECTORY + "/build/pointShadowFragment.spv");
+    pointShadowPipelineData.fragmentShaderBytecodeAbsolutePath = (Defaults::applicationDefaults.SALAMANDER_ROOT_DIRECTORY + "/build/pointShadow" + ((alphaMasked == true) ? "MaskedFragment.spv" : "Fragment.spv"));
 
     // uses the same vertex data stride and similar as the cubemap pipeline.
-    pointShadowPipelineData.vertexDataStride = sizeof(ModelHandler::ShadowVertexData);
-    pointShadowPipelineData.fetchAttributeDescriptions = ResourceDescriptor::fetchShadowAttributeDescriptions;
+    pointShadowPipelineData.vertexDataStride = ((alphaMasked == true) ? sizeof(ModelHandler::SceneVertexData) : sizeof(ModelHandler::ShadowVertexData));  // the masked casters are drawn from the scene vertex data, their alpha test needs the texture coordinates.
+    pointShadowPipelineData.fetchAttributeDescriptions = ((alphaMasked == true) ? ResourceDescriptor::fetchMaskedShadowAttributeDescriptions : ResourceDescriptor::fetchShadowAttributeDescriptions);
 
     pointShadowPipelineData.inputAssemblyTopology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
     pointShadowPipelineData.inputAssemblyPrimitiveRestartEnable = VK_FALSE;
@@ -562,15 +864,200 @@ void RendererDetails::createPointShadowPipeline(VkRenderPass renderPass, VkDevic
 
     pointShadowPipelineData.dynamicStatesDynamicStates = {VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR};
 
-    pointShadowPipelineData.pipelineRenderPass = renderPass;
-    VkPushConstantRange pushConstant{};
-    Uniform::populatePushConstant(0, sizeof(Uniform::PointShadowPushConstants), VK_SHADER_STAGE_VERTEX_BIT, pushConstant);
-    pointShadowPipelineData.pushConstant = &pushConstant;
+    pointShadowPipelineData.pipelineRenderPass = renderPass;  // the face view matrices are in the uniform buffer, indexed by view.
+
+    VkPushConstantRange pointShadowPushConstant{};
+    Uniform::populatePushConstant(0, sizeof(uint32_t), VK_SHADER_STAGE_VERTEX_BIT, pointShadowPushConstant);  // the face index offset, the rendered face of a single face render pass.
+    pointShadowPipelineData.pushConstant = &pointShadowPushConstant;
 
     
     pipelineComponents.createMemberPipeline(pointShadowPipelineData);
 }
 
+void RendererDetails::createShadowAtlasPipeline(VkRenderPass renderPass, VkDevice vulkanLogicalDevice, bool alphaMasked, Pipeline::PipelineComponents& pipelineComponents)
+{
+    Pipeline::PipelineData shadowAtlasPipelineData;
+
+    shadowAtlasPipelineData.vulkanLogicalDevice = vulkanLogicalDevice;
+    
+    shadowAtlasPipelineData.vertexShaderBytecodeAbsolutePath = (Defaults::applicationDefaults.SALAMANDER_ROOT_DIRECTORY + "/build/shadowAtlas" + ((alphaMasked == true) ? "MaskedVertex.spv" : "Vertex.spv"));
+    shadowAtlasPipelineData.geometryShaderBytecodeAbsolutePath = "*NA*";
+    shadowAtlasPipelineData.fragmentShaderBytecodeAbsolutePath = (Defaults::applicationDefaults.SALAMANDER_ROOT_DIRECTORY + "/build/shadowAtlas" + ((alphaMasked == true) ? "MaskedFragment.spv" : "Fragment.spv"));
+
+    // uses the same vertex data stride and similar as the point shadow pipeline.
+    shadowAtlasPipelineData.vertexDataStride = ((alphaMasked == true) ? sizeof(ModelHandler::SceneVertexData) : sizeof(ModelHandler::ShadowVertexData));  // the masked casters are drawn from the scene vertex data, their alpha test needs the texture coordinates.
+    shadowAtlasPipelineData.fetchAttributeDescriptions = ((alphaMasked == true) ? ResourceDescriptor::fetchMaskedShadowAttributeDescriptions : ResourceDescriptor::fetchShadowAttributeDescriptions);
+
+    shadowAtlasPipelineData.inputAssemblyTopology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+    shadowAtlasPipelineData.inputAssemblyPrimitiveRestartEnable = VK_FALSE;
+
+    shadowAtlasPipelineData.viewportViewportCount = 1;
+    shadowAtlasPipelineData.viewportScissorCount = 1;
+    
+    shadowAtlasPipelineData.rasterizationCullMode = VK_CULL_MODE_NONE;
+    shadowAtlasPipelineData.rasterizationFrontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+
+    shadowAtlasPipelineData.multisamplingRasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+    shadowAtlasPipelineData.multisamplingMinSampleShading = 1.0f;
+
+    shadowAtlasPipelineData.depthStencilDepthTestEnable = VK_TRUE;
+    shadowAtlasPipelineData.depthStencilDepthWriteEnable = VK_TRUE;
+    shadowAtlasPipelineData.depthStencilDepthCompareOp = VK_COMPARE_OP_LESS_OR_EQUAL;
+
+    shadowAtlasPipelineData.colorBlendColorWriteMask = (VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT);
+    shadowAtlasPipelineData.colorBlendBlendEnable = VK_TRUE;
+
+    shadowAtlasPipelineData.dynamicStatesDynamicStates = {VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR};  // the viewport and scissor select each tile's atlas region.
+
+    shadowAtlasPipelineData.pipelineRenderPass = renderPass;
+
+    VkPushConstantRange shadowAtlasPushConstant{};
+    Uniform::populatePushConstant(0, sizeof(uint32_t), (VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT), shadowAtlasPushConstant);  // the tile index, selecting the tile's matrix and light position.
+    shadowAtlasPipelineData.pushConstant = &shadowAtlasPushConstant;
+
+    
+    pipelineComponents.createMemberPipeline(shadowAtlasPipelineData);
+}
+
+void RendererDetails::Renderer::createMemberRenderGraph(DisplayManager::DisplayDetails& displayDetails)
+{
+    VkImageAspectFlags depthImageAspectMask = (Depth::depthImageFormatHasStencilComponent(displayDetails.depthImageDetails.imageFormat) ? (VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT) : VK_IMAGE_ASPECT_DEPTH_BIT);  // depth/stencil images are always transitioned together.
+    VkImageAspectFlags shadowImageAspectMask = (Depth::depthImageFormatHasStencilComponent(m_directionalShadowOperation.depthTextureDetails.textureImageDetails.imageFormat) ? (VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT) : VK_IMAGE_ASPECT_DEPTH_BIT);
+
+    RenderGraph::ResourceState colorWriteState = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL};
+    RenderGraph::ResourceState depthWriteState = {(VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT), (VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT), VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL};
+    RenderGraph::ResourceState shadowReadState = {VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT, VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL};
+    RenderGraph::ResourceState cullingWriteState = {(VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT), (VK_ACCESS_TRANSFER_WRITE_BIT | VK_ACCESS_SHADER_WRITE_BIT), VK_IMAGE_LAYOUT_UNDEFINED};  // the draw counts are cleared before the culling dispatch.
+    RenderGraph::ResourceState indirectReadState = {VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT, VK_ACCESS_INDIRECT_COMMAND_READ_BIT, VK_IMAGE_LAYOUT_UNDEFINED};
+    RenderGraph::ResourceState cullingReadState = {VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT, VK_IMAGE_LAYOUT_UNDEFINED};
+    RenderGraph::ResourceState depthSampledState = {VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT, VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL};
+    RenderGraph::ResourceState depthPyramidWriteState = {VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, (VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT), VK_IMAGE_LAYOUT_GENERAL};  // each level is reduced from the previous level.
+    RenderGraph::ResourceState depthPyramidReadState = {VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT, VK_IMAGE_LAYOUT_GENERAL};
+    RenderGraph::ResourceState clusterWriteState = {VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT, VK_IMAGE_LAYOUT_UNDEFINED};
+    RenderGraph::ResourceState clusterReadState = {VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT, VK_IMAGE_LAYOUT_UNDEFINED};
+    RenderGraph::ResourceState postReadState = {VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL};  // the anti-aliasing passes sample the scene color and the SMAA images.
+    RenderGraph::ResourceState depthPostReadState = {VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT, VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL};  // the temporal passes reconstruct positions from the depth.
+    RenderGraph::ResourceState postComputeReadState = {VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL};  // the bloom prefilter samples the scene color.
+    RenderGraph::ResourceState bloomWriteState = {VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, (VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT), VK_IMAGE_LAYOUT_GENERAL};  // each level is built from the previous level.
+    RenderGraph::ResourceState bloomReadState = {VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT, VK_IMAGE_LAYOUT_GENERAL};
+    RenderGraph::ResourceState postBufferWriteState = {VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, (VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT), VK_IMAGE_LAYOUT_UNDEFINED};  // the histogram is accumulated and cleared, the exposure adapted in place.
+    RenderGraph::ResourceState exposureReadState = {VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT, VK_IMAGE_LAYOUT_UNDEFINED};
+
+    RenderGraph::ResourceState swapchainInitialState = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, 0, VK_IMAGE_LAYOUT_UNDEFINED};  // the image availible semaphore is waited on in this stage.
+    RenderGraph::ResourceState swapchainFinalState = {VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR};
+    
+    uint32_t swapchainImageResource;
+    m_renderGraph.importImageResource("swapchainImage", VK_NULL_HANDLE, VK_IMAGE_ASPECT_COLOR_BIT, swapchainInitialState, swapchainFinalState, swapchainImageResource);  // updated every frame.
+    uint32_t colorImageResource;
+    m_renderGraph.importImageResource("colorImage", displayDetails.colorImageDetails.image, VK_IMAGE_ASPECT_COLOR_BIT, std::nullopt, std::nullopt, colorImageResource);
+    uint32_t sceneColorImageResource = colorImageResource;  // without msaa the color image is the single-sampled scene color.
+    if (displayDetails.msaaSampleCount != VK_SAMPLE_COUNT_1_BIT) {
+        m_renderGraph.importImageResource("sceneColorImage", displayDetails.sceneColorImageDetails.image, VK_IMAGE_ASPECT_COLOR_BIT, std::nullopt, std::nullopt, sceneColorImageResource);
+    }
+    uint32_t depthImageResource;
+    m_renderGraph.importImageResource("depthImage", displayDetails.depthImageDetails.image, depthImageAspectMask, std::nullopt, std::nullopt, depthImageResource);
+    uint32_t directionalShadowImageResource;
+    m_renderGraph.importImageResource("directionalShadowImage", m_directionalShadowOperation.depthTextureDetails.textureImageDetails.image, shadowImageAspectMask, std::nullopt, std::nullopt, directionalShadowImageResource);
+    uint32_t pointShadowImageResource;
+    m_renderGraph.importImageResource("pointShadowImage", m_pointShadowOperation.depthTextureDetails.textureImageDetails.image, shadowImageAspectMask, std::nullopt, std::nullopt, pointShadowImageResource);
+    uint32_t shadowAtlasImageResource;
+    m_renderGraph.importImageResource("shadowAtlasImage", m_shadowAtlasOperation.depthTextureDetails.textureImageDetails.image, shadowImageAspectMask, std::nullopt, std::nullopt, shadowAtlasImageResource);
+    uint32_t cullingDrawCommandsResource;
+    m_renderGraph.importBufferResource("cullingDrawCommands", m_cullingOperation.drawCommandBuffer, std::nullopt, std::nullopt, cullingDrawCommandsResource);
+    uint32_t cullingDrawCountsResource;
+    m_renderGraph.importBufferResource("cullingDrawCounts", m_cullingOperation.drawCountBuffer, std::nullopt, std::nullopt, cullingDrawCountsResource);
+    uint32_t cullingVisibilityResource;
+    m_renderGraph.importBufferResource("cullingVisibility", m_cullingOperation.visibilityBuffer, std::nullopt, std::nullopt, cullingVisibilityResource);
+    uint32_t depthPyramidImageResource;
+    m_renderGraph.importImageResource("depthPyramidImage", m_depthPyramidOperation.pyramidImageDetails.image, VK_IMAGE_ASPECT_COLOR_BIT, std::nullopt, std::nullopt, depthPyramidImageResource);
+    uint32_t clusterLightsResource;
+    m_renderGraph.importBufferResource("clusterLights", m_lightClusteringOperation.clusterLightBuffer, std::nullopt, std::nullopt, clusterLightsResource);
+    uint32_t bloomImageResource;
+    m_renderGraph.importImageResource("bloomImage", m_postProcessingOperation.bloomImageDetails.image, VK_IMAGE_ASPECT_COLOR_BIT, std::nullopt, std::nullopt, bloomImageResource);
+    uint32_t luminanceHistogramResource;
+    m_renderGraph.importBufferResource("luminanceHistogram", m_postProcessingOperation.histogramBuffer, std::nullopt, std::nullopt, luminanceHistogramResource);
+    uint32_t exposureResource;
+    m_renderGraph.importBufferResource("exposure", m_postProcessingOperation.exposureBuffer, std::nullopt, std::nullopt, exposureResource);
+    bool smaaEnabled = (m_antiAliasingMode == "SMAA");
+    uint32_t smaaEdgesImageResource;
+    uint32_t smaaWeightsImageResource;
+    if (smaaEnabled == true) {
+        m_renderGraph.importImageResource("smaaEdgesImage", m_antiAliasingOperation.edgesImageDetails.image, VK_IMAGE_ASPECT_COLOR_BIT, std::nullopt, std::nullopt, smaaEdgesImageResource);
+        m_renderGraph.importImageResource("smaaWeightsImage", m_antiAliasingOperation.blendingWeightsImageDetails.image, VK_IMAGE_ASPECT_COLOR_BIT, std::nullopt, std::nullopt, smaaWeightsImageResource);
+    }
+    bool temporalAntiAliasingEnabled = (m_antiAliasingMode == "TAA");
+    uint32_t motionVectorsImageResource;
+    uint32_t historyReadImageResource;
+    uint32_t historyWriteImageResource;
+    if (temporalAntiAliasingEnabled == true) {  // the history images are swapped every frame, both are left readable for the next frame.
+        m_renderGraph.importImageResource("motionVectorsImage", m_temporalOperation.motionVectorsImageDetails.image, VK_IMAGE_ASPECT_COLOR_BIT, std::nullopt, std::nullopt, motionVectorsImageResource);
+        m_renderGraph.importImageResource("historyReadImage", m_temporalOperation.historyImageDetails[1 - m_temporalOperation.historyWriteIndex].image, VK_IMAGE_ASPECT_COLOR_BIT, postReadState, postReadState, historyReadImageResource);
+        m_renderGraph.importImageResource("historyWriteImage", m_temporalOperation.historyImageDetails[m_temporalOperation.historyWriteIndex].image, VK_IMAGE_ASPECT_COLOR_BIT, postReadState, postReadState, historyWriteImageResource);
+    }
+    std::vector<RenderGraph::ResourceAccess> gBufferWrites;  // empty with forward rendering.
+    for (size_t i = 0; i < displayDetails.gBufferImageDetails.size(); i += 1) {
+        uint32_t gBufferImageResource;
+        m_renderGraph.importImageResource(("gBufferImage" + std::to_string(i)), displayDetails.gBufferImageDetails[i].image, VK_IMAGE_ASPECT_COLOR_BIT, std::nullopt, std::nullopt, gBufferImageResource);
+        gBufferWrites.push_back({gBufferImageResource, colorWriteState});
+    }
+
+    std::vector<RenderGraph::ResourceAccess> pointShadowReads = {{cullingDrawCommandsResource, indirectReadState}, {cullingDrawCountsResource, indirectReadState}};
+    if (m_pointShadowOperation.layerRenderPass != VK_NULL_HANDLE) {  // single face updates preserve the faces not rendered in a frame.
+        pointShadowReads.push_back({pointShadowImageResource, depthWriteState});
+    }
+    
+    // pass recordings are set every frame in CommandManager::recordGraphicsCommandBufferCommands.
+    m_renderGraph.addPass("culling", {{cullingVisibilityResource, cullingReadState}}, {{cullingDrawCommandsResource, cullingWriteState}, {cullingDrawCountsResource, cullingWriteState}}, nullptr);
+    m_renderGraph.addPass("lightClustering", {}, {{clusterLightsResource, clusterWriteState}}, nullptr);
+    m_renderGraph.addPass("directionalShadow", {{cullingDrawCommandsResource, indirectReadState}, {cullingDrawCountsResource, indirectReadState}}, {{directionalShadowImageResource, depthWriteState}}, nullptr);
+    m_renderGraph.addPass("pointShadow", pointShadowReads, {{pointShadowImageResource, depthWriteState}}, nullptr);
+    m_renderGraph.addPass("shadowAtlas", {}, {{shadowAtlasImageResource, depthWriteState}}, nullptr);  // every tile is re-rendered when the atlas changes.
+    std::vector<RenderGraph::ResourceAccess> shadowReads = {{directionalShadowImageResource, shadowReadState}, {pointShadowImageResource, shadowReadState}, {shadowAtlasImageResource, shadowReadState}, {clusterLightsResource, clusterReadState}};  // the scene shader also reads the cluster light lists.
+    std::vector<RenderGraph::ResourceAccess> mainEarlyReads = {{cullingDrawCommandsResource, indirectReadState}, {cullingDrawCountsResource, indirectReadState}};
+    mainEarlyReads.insert(mainEarlyReads.end(), shadowReads.begin(), shadowReads.end());
+    std::vector<RenderGraph::ResourceAccess> mainLateReads = {{cullingDrawCommandsResource, indirectReadState}, {cullingDrawCountsResource, indirectReadState}, {colorImageResource, colorWriteState}, {depthImageResource, depthWriteState}};  // continues the early main pass.
+    mainLateReads.insert(mainLateReads.end(), shadowReads.begin(), shadowReads.end());
+    mainLateReads.insert(mainLateReads.end(), gBufferWrites.begin(), gBufferWrites.end());  // the late G-buffer draws continue the early G-buffer.
+    std::vector<RenderGraph::ResourceAccess> mainWrites = {{colorImageResource, colorWriteState}, {depthImageResource, depthWriteState}};
+    if (sceneColorImageResource != colorImageResource) {
+        mainWrites.push_back({sceneColorImageResource, colorWriteState});  // the resolve attachment.
+    }
+    mainWrites.insert(mainWrites.end(), gBufferWrites.begin(), gBufferWrites.end());
+    
+    // the early main pass draws the instances visible last frame, the instances disoccluded by its depth are drawn in the late main pass.
+    m_renderGraph.addPass("mainEarly", mainEarlyReads, mainWrites, nullptr);
+    m_renderGraph.addPass("depthPyramid", {{depthImageResource, depthSampledState}}, {{depthPyramidImageResource, depthPyramidWriteState}}, nullptr);
+    m_renderGraph.addPass("lateCulling", {{depthPyramidImageResource, depthPyramidReadState}, {cullingDrawCommandsResource, cullingReadState}, {cullingDrawCountsResource, cullingReadState}, {cullingVisibilityResource, cullingReadState}}, {{cullingDrawCommandsResource, cullingWriteState}, {cullingDrawCountsResource, cullingWriteState}, {cullingVisibilityResource, cullingWriteState}}, nullptr);  // the occluded instance count is copied out in the transfer stage.
+    m_renderGraph.addPass("mainLate", mainLateReads, mainWrites, nullptr);
+
+    // the bloom pyramid is built from the HDR scene color, the prefilter also gathers the luminance histogram the exposure adapts to.
+    m_renderGraph.addPass("postBloom", {{sceneColorImageResource, postComputeReadState}, {luminanceHistogramResource, postBufferWriteState}}, {{bloomImageResource, bloomWriteState}, {luminanceHistogramResource, postBufferWriteState}}, nullptr);
+    m_renderGraph.addPass("postExposure", {{luminanceHistogramResource, postBufferWriteState}, {exposureResource, postBufferWriteState}}, {{luminanceHistogramResource, postBufferWriteState}, {exposureResource, postBufferWriteState}}, nullptr);
+
+    // the single-sampled scene color is filtered into the swapchain image, SMAA first finds its edges and their blending weights.
+    // TAA instead resolves the scene color with the reprojected history, following the motion vectors reconstructed from the depth.
+    // the presentation passes add the bloom and tonemap with the exposure, the history is kept in HDR.
+    if (temporalAntiAliasingEnabled == true) {
+        m_renderGraph.addPass("motionVectors", {{depthImageResource, depthPostReadState}}, {{motionVectorsImageResource, colorWriteState}}, nullptr);
+        m_renderGraph.addPass("temporalResolve", {{sceneColorImageResource, postReadState}, {depthImageResource, depthPostReadState}, {motionVectorsImageResource, postReadState}, {historyReadImageResource, postReadState}, {bloomImageResource, bloomReadState}, {exposureResource, exposureReadState}}, {{swapchainImageResource, colorWriteState}, {historyWriteImageResource, colorWriteState}}, nullptr);
+    } else {
+        std::vector<RenderGraph::ResourceAccess> antiAliasingReads = {{sceneColorImageResource, postReadState}, {bloomImageResource, bloomReadState}, {exposureResource, exposureReadState}};
+        if (smaaEnabled == true) {
+            m_renderGraph.addPass("antiAliasingEdges", {{sceneColorImageResource, postReadState}, {exposureResource, exposureReadState}}, {{smaaEdgesImageResource, colorWriteState}}, nullptr);
+            m_renderGraph.addPass("antiAliasingWeights", {{smaaEdgesImageResource, postReadState}}, {{smaaWeightsImageResource, colorWriteState}}, nullptr);
+            antiAliasingReads.push_back({smaaWeightsImageResource, postReadState});
+        }
+        m_renderGraph.addPass("antiAliasing", antiAliasingReads, {{swapchainImageResource, colorWriteState}}, nullptr);
+    }
+
+    m_renderGraph.setPassSkipped("culling", (m_gpuCullingEnabled == false));  // CPU culled draws are recorded directly.
+    m_renderGraph.setPassSkipped("depthPyramid", (m_occlusionCullingEnabled == false));
+    m_renderGraph.setPassSkipped("lateCulling", (m_occlusionCullingEnabled == false));
+    m_renderGraph.setPassSkipped("mainLate", (m_occlusionCullingEnabled == false));  // the frame is drawn entirely in the early main pass.
+
+    m_renderGraph.compileGraph();
+}
+
 void RendererDetails::Renderer::createMemberSynchronizationObjects()
 {
     m_imageAvailibleSemaphores.resize(Defaults::rendererDefaults.MAX_FRAMES_IN_FLIGHT);
@@ -601,17 +1088,162 @@ void RendererDetails::Renderer::createMemberSynchronizationObjects()
     }
 }
 
+void RendererDetails::Renderer::reportShadowDraws(const std::vector<uint32_t>& directionalShadowCascadeCasterMasks, const std::vector<uint32_t>& pointShadowFaceCasterMasks)
+{
+    std::vector<uint32_t> shadowViewDrawCounts;
+    for (uint32_t casterMask : directionalShadowCascadeCasterMasks) {
+        shadowViewDrawCounts.push_back(static_cast<uint32_t>(std::bitset<32>(casterMask).count()));
+    }
+    for (uint32_t casterMask : pointShadowFaceCasterMasks) {
+        shadowViewDrawCounts.push_back(static_cast<uint32_t>(std::bitset<32>(casterMask).count()));
+    }
+
+    if (shadowViewDrawCounts == m_shadowViewDrawCounts) {
+        return;
+    }
+    m_shadowViewDrawCounts = shadowViewDrawCounts;
+
+    std::cout << "shadow draws per view, directional cascades:";
+    for (size_t i = 0; i < directionalShadowCascadeCasterMasks.size(); i += 1) {
+        std::cout << " " << shadowViewDrawCounts[i];
+    }
+    std::cout << ", point faces:";
+    for (size_t i = directionalShadowCascadeCasterMasks.size(); i < shadowViewDrawCounts.size(); i += 1) {
+        std::cout << " " << shadowViewDrawCounts[i];
+    }
+    std::cout << std::endl;
+}
+
+void RendererDetails::Renderer::reportOccludedInstances(uint32_t occludedInstanceCount)
+{
+    if (occludedInstanceCount == m_occludedInstanceCount) {
+        return;
+    }
+    m_occludedInstanceCount = occludedInstanceCount;
+
+    std::cout << "occluded instances: " << occludedInstanceCount << std::endl;
+}
+
+void RendererDetails::Renderer::recreateMemberSwapchain(DisplayManager::DisplayDetails& displayDetails, VkPhysicalDevice vulkanPhysicalDevice)
+{
+    DeviceHandler::VulkanDevices vulkanDevices{vulkanPhysicalDevice, *m_vulkanLogicalDevice};
+
+    SwapchainHandler::recreateSwapchain(vulkanDevices, m_renderPass, m_antiAliasingOperation.presentationRenderPass, displayDetails);
+    m_mainCamera.swapchainImageExtent = displayDetails.swapchainImageExtent;
+
+    // the depth pyramid follows the recreated depth image.
+    m_depthPyramidOperation.cleanupPyramidImage(*m_vulkanLogicalDevice);
+    m_depthPyramidOperation.generatePyramidImage(displayDetails.depthImageDetails.imageView, displayDetails.swapchainImageExtent, vulkanDevices);
+    m_cullingOperation.populateDepthPyramidDescriptors(m_depthPyramidOperation.pyramidSampler, m_depthPyramidOperation.pyramidImageDetails.imageView, *m_vulkanLogicalDevice);
+    if (m_deferredRenderingEnabled == true) {  // the lighting subpass reads the recreated G-buffer and depth.
+        populateMemberGBufferDescriptors(displayDetails);
+    }
+
+    // the bloom image follows the recreated scene color, and the anti-aliasing passes read both.
+    m_postProcessingOperation.cleanupPostImages(*m_vulkanLogicalDevice);
+    VkImageView sceneColorImageView = ((displayDetails.msaaSampleCount != VK_SAMPLE_COUNT_1_BIT) ? displayDetails.sceneColorImageDetails.imageView : displayDetails.colorImageDetails.imageView);
+    m_postProcessingOperation.generatePostImages(sceneColorImageView, displayDetails.swapchainImageExtent, vulkanDevices);
+    m_antiAliasingOperation.cleanupPostImages(*m_vulkanLogicalDevice);
+    m_antiAliasingOperation.generatePostImages(sceneColorImageView, m_postProcessingOperation.bloomImageDetails.imageView, m_postProcessingOperation.exposureBuffer, displayDetails.swapchainImageExtent, vulkanDevices);
+
+    // the temporal images follow the swapchain extent, the render scale is measured again at the new extent.
+    m_temporalOperation.cleanupTemporalImages(*m_vulkanLogicalDevice);
+    m_temporalOperation.generateTemporalImages(sceneColorImageView, displayDetails.depthImageDetails.imageView, m_postProcessingOperation.bloomImageDetails.imageView, m_postProcessingOperation.exposureBuffer, displayDetails.swapchainImageViews, displayDetails.swapchainImageExtent, displayDetails.graphicsCommandPool, displayDetails.graphicsQueue, vulkanDevices);
+    m_resolutionController.resetRenderScale();
+}
+
+void RendererDetails::Renderer::applyMemberAntiAliasing(DisplayManager::DisplayDetails& displayDetails, VkPhysicalDevice vulkanPhysicalDevice)
+{
+    DeviceHandler::VulkanDevices vulkanDevices{vulkanPhysicalDevice, *m_vulkanLogicalDevice};
+
+    if (Defaults::callbacksVariables.ANTI_ALIASING_CYCLED == true) {
+        size_t antiAliasingModeIndex = (std::find(AntiAliasing::antiAliasingModes.begin(), AntiAliasing::antiAliasingModes.end(), m_antiAliasingMode) - AntiAliasing::antiAliasingModes.begin());
+        m_antiAliasingMode = AntiAliasing::antiAliasingModes[(antiAliasingModeIndex + 1) % AntiAliasing::antiAliasingModes.size()];
+    }
+    bool multisampledComponentsStale = Defaults::callbacksVariables.SAMPLE_SHADING_TOGGLED;  // the minimum sample shading is baked into the pipelines.
+    if (Defaults::callbacksVariables.SAMPLE_SHADING_TOGGLED == true) {
+        m_sampleShadingEnabled = (m_sampleShadingEnabled == false);
+    }
+    bool antiAliasingModeCycled = Defaults::callbacksVariables.ANTI_ALIASING_CYCLED;
+    Defaults::callbacksVariables.ANTI_ALIASING_CYCLED = false;
+    Defaults::callbacksVariables.SAMPLE_SHADING_TOGGLED = false;
+
+    VkSampleCountFlagBits msaaSampleCount;
+    selectMemberSampleCount(vulkanPhysicalDevice, msaaSampleCount);
+    if (antiAliasingModeCycled == true) {  // a mode picked by hand starts at full quality, the governor lowers it again if it's over budget.
+        m_qualityGovernor.resetGovernor(msaaSampleCount);
+    }
+    m_qualityGovernor.fetchMsaaSampleCount(msaaSampleCount);
+    multisampledComponentsStale = ((multisampledComponentsStale == true) || (msaaSampleCount != displayDetails.msaaSampleCount));
+
+
+    vkDeviceWaitIdle(*m_vulkanLogicalDevice);  // the replaced components may still be used by the frames in flight.
+
+    m_antiAliasingOperation.switchAntiAliasingMode(m_antiAliasingMode, *m_vulkanLogicalDevice);
+    m_temporalOperation.resetHistory();  // the history was last resolved in another mode, or not at all.
+    m_resolutionController.resetRenderScale();
+
+    if (multisampledComponentsStale == true) {
+        displayDetails.msaaSampleCount = msaaSampleCount;
+
+        // the pipelines sharing descriptors only have their pipelines and pipeline layouts recreated, the descriptor sets are kept.
+        std::vector<Pipeline::PipelineComponents *> multisampledPipelineComponents = {&m_cubemapPipelineComponents, &m_scenePipelineComponents, &m_sceneMaskedPipelineComponents, &m_sceneNormalsPipelineComponents};
+        if (m_depthPrepassEnabled == true) {
+            multisampledPipelineComponents.push_back(&m_depthPrepassPipelineComponents);
+        }
+        if (m_deferredRenderingEnabled == true) {
+            multisampledPipelineComponents.push_back(&m_deferredLightingPipelineComponents);
+        }
+        for (Pipeline::PipelineComponents *pipelineComponents : multisampledPipelineComponents) {
+            vkDestroyPipeline(*m_vulkanLogicalDevice, pipelineComponents->pipeline, nullptr);
+            vkDestroyPipelineLayout(*m_vulkanLogicalDevice, pipelineComponents->pipelineLayout, nullptr);
+        }
+        vkDestroyRenderPass(*m_vulkanLogicalDevice, m_renderPass, nullptr);
+        vkDestroyRenderPass(*m_vulkanLogicalDevice, m_lateRenderPass, nullptr);
+
+        createMemberRenderPass(RendererDetails::sceneColorImageFormat, msaaSampleCount, vulkanPhysicalDevice);
+        createMemberCubemapPipeline(msaaSampleCount);
+        createMemberScenePipeline(msaaSampleCount, false);
+        createMemberScenePipeline(msaaSampleCount, true);
+        if (m_depthPrepassEnabled == true) {
+            createMemberDepthPrepassPipeline(msaaSampleCount);
+        }
+        if (m_deferredRenderingEnabled == true) {
+            createMemberDeferredLightingPipeline(msaaSampleCount);
+        }
+        createMemberSceneNormalsPipeline(msaaSampleCount);
+
+        recreateMemberSwapchain(displayDetails, vulkanPhysicalDevice);  // the scene images follow the sample count.
+
+        // the depth pyramid's first reduction reads the depth image's samples.
+        m_depthPyramidOperation.cleanupDepthPyramidOperation(*m_vulkanLogicalDevice);
+        m_depthPyramidOperation.generateMemberComponents(msaaSampleCount, vulkanDevices);
+        m_depthPyramidOperation.generatePyramidImage(displayDetails.depthImageDetails.imageView, displayDetails.swapchainImageExtent, vulkanDevices);
+        m_cullingOperation.populateDepthPyramidDescriptors(m_depthPyramidOperation.pyramidSampler, m_depthPyramidOperation.pyramidImageDetails.imageView, *m_vulkanLogicalDevice);
+    }
+
+    // the scene color, SMAA, and temporal passes differ between the modes.
+    m_renderGraph = RenderGraph::Graph{};
+    createMemberRenderGraph(displayDetails);
+
+    std::cout << "anti-aliasing: " << m_antiAliasingMode << "(" << msaaSampleCount << " samples, sample shading " << ((m_sampleShadingEnabled == true) ? "on" : "off") << ")" << std::endl;
+}
+
 void RendererDetails::Renderer::drawFrame(DisplayManager::DisplayDetails& displayDetails, VkPhysicalDevice vulkanPhysicalDevice, VkQueue graphicsQueue, VkQueue presentationQueue)
 {
     vkWaitForFences(*m_vulkanLogicalDevice, 1, &m_inFlightFences[m_currentFrame], VK_TRUE, UINT64_MAX);  // wait for the GPU to finish with the previous frame, UINT64_MAX timeout.
 
+    if (m_occlusionCullingEnabled == true) {  // written by this frame in flight's previous submission.
+        reportOccludedInstances(m_cullingOperation.fetchOccludedInstanceCount(m_currentFrame));
+    }
+    m_resolutionController.updateRenderScale(m_currentFrame, *m_vulkanLogicalDevice);  // measured by this frame in flight's previous submission.
+
 
     uint32_t swapchainImageIndex;  // prefer to use size_t, but want to avoid weird casts to uint32_t.
     VkResult imageAcquisitionResult = vkAcquireNextImageKHR(*m_vulkanLogicalDevice, displayDetails.swapchain, UINT64_MAX, m_imageAvailibleSemaphores[m_currentFrame], VK_NULL_HANDLE, &swapchainImageIndex);  // get the index of an availbile swapchain image.
 
     if (imageAcquisitionResult == VK_ERROR_OUT_OF_DATE_KHR) {
-        SwapchainHandler::recreateSwapchain(DeviceHandler::VulkanDevices{vulkanPhysicalDevice, *m_vulkanLogicalDevice}, m_renderPass, m_directionalShadowOperation, m_pointShadowOperation, displayDetails);
-        m_mainCamera.swapchainImageExtent = displayDetails.swapchainImageExtent;
+        recreateMemberSwapchain(displayDetails, vulkanPhysicalDevice);
         return;
     } else if (imageAcquisitionResult != VK_SUCCESS && imageAcquisitionResult != VK_SUBOPTIMAL_KHR) {
         throwDebugException("Failed to acquire swapchain image.");
@@ -619,47 +1251,170 @@ void RendererDetails::Renderer::drawFrame(DisplayManager::DisplayDetails& displa
     
 
     vkResetFences(*m_vulkanLogicalDevice, 1, &m_inFlightFences[m_currentFrame]);  // reset fences only after successful image acquisition.
+    double cpuFrameStartTime = glfwGetTime();  // the CPU frame time excludes waiting on the fence and the swapchain image.
+    float frameTime = ((m_previousFrameStartTime > 0.0) ? static_cast<float>(cpuFrameStartTime - m_previousFrameStartTime) : 0.0f);  // the first frame keeps the initial exposure.
+    m_previousFrameStartTime = cpuFrameStartTime;
 
 
     vkResetCommandBuffer(displayDetails.graphicsCommandBuffers[m_currentFrame], 0);  // 0 for no additional flags.
 
+    // TAA jitters the projection and renders a region of the scene images scaled by the resolution controller, the resolve upsamples it to the swapchain image.
+    bool temporalAntiAliasingEnabled = (m_antiAliasingMode == "TAA");
+    VkExtent2D renderExtent = displayDetails.swapchainImageExtent;
+    glm::vec2 projectionJitter = glm::vec2(0.0f);
+    if (temporalAntiAliasingEnabled == true) {
+        m_resolutionController.fetchRenderExtent(displayDetails.swapchainImageExtent, renderExtent);
+        TemporalAntiAliasing::fetchProjectionJitter(m_temporalFrameIndex, projectionJitter);
+        m_temporalFrameIndex += 1;
+    }
+
+    Uniform::UniformBuffersUpdatePackage uniformBuffersUpdatePackage{};
+    uniformBuffersUpdatePackage.mainCamera = &m_mainCamera;
+    uniformBuffersUpdatePackage.mainMeshQuaternion = m_mainModel.meshQuaternion;
+    uniformBuffersUpdatePackage.mainMeshBoundsMinimum = m_mainModel.meshBoundsMinimum;
+    uniformBuffersUpdatePackage.mainMeshBoundsMaximum = m_mainModel.meshBoundsMaximum;
+    uniformBuffersUpdatePackage.mainMeshChunks = &m_mainModel.meshChunks;  // the culled draws are always indexed, a mesh without indices has no chunks.
+    uniformBuffersUpdatePackage.maxCullingInstanceCount = m_cullingOperation.maxInstanceCount;
+    uniformBuffersUpdatePackage.maxSceneLightCount = m_lightClusteringOperation.maxLightCount;
+    m_qualityGovernor.fetchSceneLightFraction(uniformBuffersUpdatePackage.sceneLightFraction);
+    m_qualityGovernor.fetchShadowAtlasTileSize(Defaults::rendererDefaults.SHADOW_ATLAS_MAXIMUM_TILE_SIZE, Defaults::rendererDefaults.SHADOW_ATLAS_MINIMUM_TILE_SIZE, uniformBuffersUpdatePackage.shadowAtlasMaximumTileSize);
+    m_qualityGovernor.fetchTextureLodBias(uniformBuffersUpdatePackage.textureLodBias);
+    m_depthPyramidOperation.fetchLevelExtent(0, uniformBuffersUpdatePackage.depthPyramidExtent);
+    uniformBuffersUpdatePackage.depthPyramidLevelCount = m_depthPyramidOperation.levelCount;
+    uniformBuffersUpdatePackage.occlusionCullingEnabled = m_occlusionCullingEnabled;
+    
+    uniformBuffersUpdatePackage.swapchainImageExtent = displayDetails.swapchainImageExtent;
+    uniformBuffersUpdatePackage.renderExtent = renderExtent;
+    uniformBuffersUpdatePackage.projectionJitter = projectionJitter;
+    uniformBuffersUpdatePackage.previousCameraMatrix = m_previousCameraMatrix;
+    uniformBuffersUpdatePackage.previousMainMeshModelMatrix = m_previousMainMeshModelMatrix;
+    uniformBuffersUpdatePackage.glfwWindow = displayDetails.glfwWindow;
+    uniformBuffersUpdatePackage.shadowAtlasAllocator = &m_shadowAtlasAllocator;
+    uniformBuffersUpdatePackage.cpuCullingScene = ((m_gpuCullingEnabled == true) ? nullptr : &m_cpuCullingScene);
+    uniformBuffersUpdatePackage.cpuOcclusionBuffer = ((m_maskedOcclusionEnabled == true) ? &m_occlusionBuffer : nullptr);
+    uniformBuffersUpdatePackage.mainMeshOccluderMesh = &m_mainOccluderMesh;
+
+    uniformBuffersUpdatePackage.mappedSceneUniformBufferMemory = m_scenePipelineComponents.mappedUniformBuffersMemory[m_currentFrame];
+    uniformBuffersUpdatePackage.mappedSceneNormalsUniformBufferMemory = m_sceneNormalsPipelineComponents.mappedUniformBuffersMemory[m_currentFrame];
+    uniformBuffersUpdatePackage.mappedCubemapUniformBufferMemory = m_cubemapPipelineComponents.mappedUniformBuffersMemory[m_currentFrame];
+    uniformBuffersUpdatePackage.mappedDirectionalShadowUniformBufferMemory = m_directionalShadowOperation.pipelineComponents.mappedUniformBuffersMemory[m_currentFrame];
+    uniformBuffersUpdatePackage.mappedPointShadowUniformBufferMemory = m_pointShadowOperation.pipelineComponents.mappedUniformBuffersMemory[m_currentFrame];
+    uniformBuffersUpdatePackage.mappedShadowAtlasUniformBufferMemory = m_shadowAtlasOperation.pipelineComponents.mappedUniformBuffersMemory[m_currentFrame];
+    uniformBuffersUpdatePackage.mappedCullingUniformBufferMemory = m_cullingOperation.pipelineComponents.mappedUniformBuffersMemory[m_currentFrame];
+    uniformBuffersUpdatePackage.mappedCullingInstanceBufferMemory = m_cullingOperation.mappedInstanceBuffersMemory[m_currentFrame];
+    uniformBuffersUpdatePackage.mappedClusteringUniformBufferMemory = m_lightClusteringOperation.pipelineComponents.mappedUniformBuffersMemory[m_currentFrame];
+    uniformBuffersUpdatePackage.mappedSceneLightBufferMemory = m_lightClusteringOperation.mappedLightBuffersMemory[m_currentFrame];
+    uniformBuffersUpdatePackage.mappedTemporalUniformBufferMemory = ((temporalAntiAliasingEnabled == true) ? m_temporalOperation.motionVectorsPipelineComponents.mappedUniformBuffersMemory[m_currentFrame] : nullptr);
+    
+    Uniform::updateFrameUniformBuffers(uniformBuffersUpdatePackage);
+    m_previousCameraMatrix = uniformBuffersUpdatePackage.cameraMatrix;
+    m_previousMainMeshModelMatrix = uniformBuffersUpdatePackage.mainMeshModelMatrix;
+    if (m_maskedOcclusionEnabled == true) {
+        reportOccludedInstances(uniformBuffersUpdatePackage.cpuOccludedInstanceCount);
+    }
+
+    // shadow maps are only re-rendered when the state they depend on(light matrices, caster transforms, culled casters) changes.
+    // the cascades follow the camera, so the directional shadow map is only reused while the camera is still.
+    std::vector<uint32_t> directionalShadowCascadeCasterMasks(std::begin(uniformBuffersUpdatePackage.directionalShadowCascadeCasterMasks), (std::begin(uniformBuffersUpdatePackage.directionalShadowCascadeCasterMasks) + Defaults::rendererDefaults.SHADOW_CASCADE_COUNT));
+    std::vector<uint32_t> pointShadowFaceCasterMasks(std::begin(uniformBuffersUpdatePackage.pointShadowFaceCasterMasks), std::end(uniformBuffersUpdatePackage.pointShadowFaceCasterMasks));
+    uint32_t shadowAtlasTileCount = uniformBuffersUpdatePackage.shadowAtlasState.tileCount;
+    std::vector<uint32_t> shadowAtlasCasterMasks = {std::accumulate(std::begin(uniformBuffersUpdatePackage.shadowAtlasTileCasterMasks), (std::begin(uniformBuffersUpdatePackage.shadowAtlasTileCasterMasks) + shadowAtlasTileCount), 0u, std::bit_or<uint32_t>())};  // the atlas is a single layer.
+    
+    m_directionalShadowOperation.shadowCacheValid(&uniformBuffersUpdatePackage.directionalShadowUniformBufferObject, sizeof(Uniform::DirectionalShadowUniformBufferObject));  // marks every layer stale on change.
+    m_pointShadowOperation.shadowCacheValid(&uniformBuffersUpdatePackage.pointShadowUniformBufferObject, sizeof(Uniform::PointShadowUniformBufferObject));
+    m_shadowAtlasOperation.shadowCacheValid(&uniformBuffersUpdatePackage.shadowAtlasState, sizeof(Uniform::ShadowAtlasState));  // includes the tile layout, which changes with the camera.
+    uint32_t directionalShadowCascadeMask = m_directionalShadowOperation.selectLayerUpdates(Defaults::rendererDefaults.SHADOW_CASCADE_COUNT, 0, directionalShadowCascadeCasterMasks);
+    uint32_t pointShadowFaceBudget;
+    m_qualityGovernor.fetchPointShadowFaceBudget(Defaults::rendererDefaults.POINT_SHADOW_FACE_BUDGET, pointShadowFaceBudget);
+    uint32_t pointShadowFaceMask = m_pointShadowOperation.selectLayerUpdates(pointShadowFaceBudget, uniformBuffersUpdatePackage.pointShadowVisibleFaceMask, pointShadowFaceCasterMasks);
+    m_renderGraph.setPassSkipped("directionalShadow", (directionalShadowCascadeMask == 0));
+    uint32_t shadowAtlasMask = m_shadowAtlasOperation.selectLayerUpdates(1, 0, shadowAtlasCasterMasks);
+    m_renderGraph.setPassSkipped("pointShadow", (pointShadowFaceMask == 0));
+    m_renderGraph.setPassSkipped("shadowAtlas", (shadowAtlasMask == 0));
+
+    reportShadowDraws(directionalShadowCascadeCasterMasks, pointShadowFaceCasterMasks);
+
+    // imported images can change every frame or be recreated with the swapchain(shadow maps are kept).
+    m_renderGraph.updateImportedImage("swapchainImage", displayDetails.swapchainImages[swapchainImageIndex]);
+    m_renderGraph.updateImportedImage("colorImage", displayDetails.colorImageDetails.image);
+    m_renderGraph.updateImportedImage("depthImage", displayDetails.depthImageDetails.image);
+    m_renderGraph.updateImportedImage("depthPyramidImage", m_depthPyramidOperation.pyramidImageDetails.image);
+    m_renderGraph.updateImportedImage("bloomImage", m_postProcessingOperation.bloomImageDetails.image);
+    if (displayDetails.msaaSampleCount != VK_SAMPLE_COUNT_1_BIT) {
+        m_renderGraph.updateImportedImage("sceneColorImage", displayDetails.sceneColorImageDetails.image);
+    }
+    if (m_antiAliasingMode == "SMAA") {
+        m_renderGraph.updateImportedImage("smaaEdgesImage", m_antiAliasingOperation.edgesImageDetails.image);
+        m_renderGraph.updateImportedImage("smaaWeightsImage", m_antiAliasingOperation.blendingWeightsImageDetails.image);
+    }
+    for (size_t i = 0; i < displayDetails.gBufferImageDetails.size(); i += 1) {
+        m_renderGraph.updateImportedImage(("gBufferImage" + std::to_string(i)), displayDetails.gBufferImageDetails[i].image);
+    }
+    if (temporalAntiAliasingEnabled == true) {
+        m_renderGraph.updateImportedImage("motionVectorsImage", m_temporalOperation.motionVectorsImageDetails.image);
+        m_renderGraph.updateImportedImage("historyReadImage", m_temporalOperation.historyImageDetails[1 - m_temporalOperation.historyWriteIndex].image);
+        m_renderGraph.updateImportedImage("historyWriteImage", m_temporalOperation.historyImageDetails[m_temporalOperation.historyWriteIndex].image);
+    }
+
     CommandManager::GraphicsRecordingPackage graphicsRecordingPackage{};
     graphicsRecordingPackage.graphicsCommandBuffer = displayDetails.graphicsCommandBuffers[m_currentFrame];
     graphicsRecordingPackage.renderPass = m_renderPass;
+    graphicsRecordingPackage.lateRenderPass = m_lateRenderPass;
     
     graphicsRecordingPackage.swapchainImageExtent = displayDetails.swapchainImageExtent;
+    graphicsRecordingPackage.renderExtent = renderExtent;
     graphicsRecordingPackage.swapchainIndexFramebuffer = displayDetails.swapchainFramebuffers[swapchainImageIndex];
+    graphicsRecordingPackage.swapchainImageIndex = swapchainImageIndex;
+    graphicsRecordingPackage.sceneFramebuffer = displayDetails.sceneFramebuffer;
     graphicsRecordingPackage.currentFrame = m_currentFrame;
+
+    graphicsRecordingPackage.recordingWorkers = &displayDetails.graphicsRecordingWorkers;
+    graphicsRecordingPackage.renderGraph = &m_renderGraph;
+    graphicsRecordingPackage.directionalShadowCached = (directionalShadowCascadeMask == 0);
+    graphicsRecordingPackage.pointShadowFaceMask = pointShadowFaceMask;
+    graphicsRecordingPackage.shadowAtlasCached = (shadowAtlasMask == 0);
+    graphicsRecordingPackage.shadowAtlasTileCount = shadowAtlasTileCount;
+    std::copy(std::begin(uniformBuffersUpdatePackage.shadowAtlasState.tiles), std::end(uniformBuffersUpdatePackage.shadowAtlasState.tiles), graphicsRecordingPackage.shadowAtlasTiles);
+    std::copy(std::begin(uniformBuffersUpdatePackage.shadowAtlasTileCasterMasks), std::end(uniformBuffersUpdatePackage.shadowAtlasTileCasterMasks), graphicsRecordingPackage.shadowAtlasTileCasterMasks);
     
     graphicsRecordingPackage.cubemapPipelineComponents = m_cubemapPipelineComponents;
     graphicsRecordingPackage.cubemapShaderBufferComponents = m_cubemapModel.shaderBufferComponents;
     graphicsRecordingPackage.scenePipelineComponents = m_scenePipelineComponents;
     graphicsRecordingPackage.sceneShaderBufferComponents = m_mainModel.shaderBufferComponents;
+    graphicsRecordingPackage.sceneMaskedPipeline = m_sceneMaskedPipelineComponents.pipeline;
+    graphicsRecordingPackage.maskedIndiceCount = m_mainModel.maskedIndiceCount;
     graphicsRecordingPackage.sceneNormalsPipelineComponents = m_sceneNormalsPipelineComponents;
     graphicsRecordingPackage.sceneNormalsShaderBufferComponents = m_dummySceneNormalsModel.shaderBufferComponents;
+    graphicsRecordingPackage.depthPrepassPipeline = m_depthPrepassPipelineComponents.pipeline;
+    graphicsRecordingPackage.depthPrepassShaderBufferComponents = m_dummyDirectionalShadowModel.shaderBufferComponents;  // the position-only vertex data.
+    graphicsRecordingPackage.depthPrepassEnabled = m_depthPrepassEnabled;
+    graphicsRecordingPackage.deferredLightingPipeline = m_deferredLightingPipelineComponents.pipeline;
+    graphicsRecordingPackage.deferredRenderingEnabled = m_deferredRenderingEnabled;
     graphicsRecordingPackage.directionalShadowOperation = m_directionalShadowOperation;
     graphicsRecordingPackage.directionalShadowShaderBufferComponents = m_dummyDirectionalShadowModel.shaderBufferComponents;
     graphicsRecordingPackage.pointShadowOperation = m_pointShadowOperation;
     graphicsRecordingPackage.pointShadowShaderBufferComponents = m_dummyPointShadowModel.shaderBufferComponents;
+    graphicsRecordingPackage.shadowAtlasOperation = m_shadowAtlasOperation;
+    graphicsRecordingPackage.shadowAtlasShaderBufferComponents = m_dummyPointShadowModel.shaderBufferComponents;  // the shadow atlas uses the same vertex data.
+    graphicsRecordingPackage.cullingOperation = m_cullingOperation;
+    graphicsRecordingPackage.cullingInstanceCount = uniformBuffersUpdatePackage.cullingInstanceCount;
+    graphicsRecordingPackage.gpuCullingEnabled = m_gpuCullingEnabled;
+    graphicsRecordingPackage.depthPyramidOperation = m_depthPyramidOperation;
+    graphicsRecordingPackage.lightClusteringOperation = m_lightClusteringOperation;
+    graphicsRecordingPackage.occlusionCullingEnabled = m_occlusionCullingEnabled;
+    graphicsRecordingPackage.postProcessingOperation = m_postProcessingOperation;
+    graphicsRecordingPackage.frameTime = frameTime;
+    graphicsRecordingPackage.antiAliasingOperation = m_antiAliasingOperation;
+    graphicsRecordingPackage.smaaEnabled = (m_antiAliasingMode == "SMAA");
+    graphicsRecordingPackage.sceneColorResolved = (displayDetails.msaaSampleCount != VK_SAMPLE_COUNT_1_BIT);
+    graphicsRecordingPackage.temporalOperation = m_temporalOperation;
+    graphicsRecordingPackage.temporalAntiAliasingEnabled = temporalAntiAliasingEnabled;
+    graphicsRecordingPackage.projectionJitter = projectionJitter;
+    graphicsRecordingPackage.resolutionController = &m_resolutionController;
+    std::move(std::begin(uniformBuffersUpdatePackage.cpuCulledDrawCommands), std::end(uniformBuffersUpdatePackage.cpuCulledDrawCommands), graphicsRecordingPackage.cpuCulledDrawCommands);
     
     CommandManager::recordGraphicsCommandBufferCommands(graphicsRecordingPackage);
 
-
-    Uniform::UniformBuffersUpdatePackage uniformBuffersUpdatePackage{};
-    uniformBuffersUpdatePackage.mainCamera = &m_mainCamera;
-    uniformBuffersUpdatePackage.mainMeshQuaternion = m_mainModel.meshQuaternion;
-    
-    uniformBuffersUpdatePackage.swapchainImageExtent = displayDetails.swapchainImageExtent;
-    uniformBuffersUpdatePackage.glfwWindow = displayDetails.glfwWindow;
-
-    uniformBuffersUpdatePackage.mappedSceneUniformBufferMemory = m_scenePipelineComponents.mappedUniformBuffersMemory[m_currentFrame];
-    uniformBuffersUpdatePackage.mappedSceneNormalsUniformBufferMemory = m_sceneNormalsPipelineComponents.mappedUniformBuffersMemory[m_currentFrame];
-    uniformBuffersUpdatePackage.mappedCubemapUniformBufferMemory = m_cubemapPipelineComponents.mappedUniformBuffersMemory[m_currentFrame];
-    uniformBuffersUpdatePackage.mappedDirectionalShadowUniformBufferMemory = m_directionalShadowOperation.pipelineComponents.mappedUniformBuffersMemory[m_currentFrame];
-    uniformBuffersUpdatePackage.mappedPointShadowUniformBufferMemory = m_pointShadowOperation.pipelineComponents.mappedUniformBuffersMemory[m_currentFrame];
-    
-    Uniform::updateFrameUniformBuffers(uniformBuffersUpdatePackage);
-
     
     VkSubmitInfo submitInfo{};
     submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
@@ -684,6 +1439,11 @@ void RendererDetails::Renderer::drawFrame(DisplayManager::DisplayDetails& displa
     if (graphicsQueueSubmitResult != VK_SUCCESS) {
         throwDebugException("Failed to submit graphics command buffer to graphics queue.");
     }
+    m_resolutionController.timestampsWritten[m_currentFrame] = true;
+    m_cpuFrameTime = static_cast<float>((glfwGetTime() - cpuFrameStartTime) * 1000.0);
+    if (temporalAntiAliasingEnabled == true) {
+        m_temporalOperation.advanceHistory();  // the written history image is read by the next frame.
+    }
 
 
     VkPresentInfoKHR presentationInfo{};
@@ -723,9 +1483,51 @@ RendererDetails::Renderer::Renderer(DisplayManager::DisplayDetails& displayDetai
     m_mainCamera.center = glm::vec3(0.0f, 0.0f, 0.0f);
     m_mainCamera.swapchainImageExtent = displayDetails.swapchainImageExtent;
 
-    fetchMaximumUsableSampleCount(vulkanPhysicalDevice, displayDetails.msaaSampleCount);
+    if (std::find(AntiAliasing::antiAliasingModes.begin(), AntiAliasing::antiAliasingModes.end(), Defaults::rendererDefaults.ANTI_ALIASING) == AntiAliasing::antiAliasingModes.end()) {
+        throwDebugException("Unknown anti-aliasing mode \"" + Defaults::rendererDefaults.ANTI_ALIASING + "\".");
+    }
+    m_antiAliasingMode = Defaults::rendererDefaults.ANTI_ALIASING;
+    if ((Defaults::rendererDefaults.MSAA_SAMPLE_SHADING != "ON") && (Defaults::rendererDefaults.MSAA_SAMPLE_SHADING != "OFF")) {
+        throwDebugException("Unknown msaa sample shading mode \"" + Defaults::rendererDefaults.MSAA_SAMPLE_SHADING + "\".");
+    }
+    m_sampleShadingEnabled = (Defaults::rendererDefaults.MSAA_SAMPLE_SHADING == "ON");
+
+    if ((Defaults::rendererDefaults.QUALITY_GOVERNOR != "ON") && (Defaults::rendererDefaults.QUALITY_GOVERNOR != "OFF")) {
+        throwDebugException("Unknown quality governor mode \"" + Defaults::rendererDefaults.QUALITY_GOVERNOR + "\".");
+    }
+
+    // the culling modes decide the split of the main render pass.
+    m_gpuCullingEnabled = ((Defaults::rendererDefaults.CULLING_MODE != "CPU") && DeviceHandler::deviceSupportsGpuCulling(vulkanPhysicalDevice));  // the culled indirect draws need indirect count draws, the instances are culled on the CPU without them.
+
+    if ((Defaults::rendererDefaults.OCCLUSION_CULLING != "HIZ") && (Defaults::rendererDefaults.OCCLUSION_CULLING != "MASKED") && (Defaults::rendererDefaults.OCCLUSION_CULLING != "NONE")) {
+        throwDebugException("Unknown occlusion culling mode \"" + Defaults::rendererDefaults.OCCLUSION_CULLING + "\".");
+    }
+    // each occlusion culling mode only fits its own culling mode, MASKED falls back to HIZ under GPU culling.
+    // HIZ is only frustum culling under CPU culling, the masked occlusion buffer has to be asked for(its only occluder is the main mesh).
+    m_occlusionCullingEnabled = ((m_gpuCullingEnabled == true) && (Defaults::rendererDefaults.OCCLUSION_CULLING != "NONE"));
+    m_maskedOcclusionEnabled = ((m_gpuCullingEnabled == false) && (Defaults::rendererDefaults.OCCLUSION_CULLING == "MASKED"));
+
+    if ((Defaults::rendererDefaults.RENDERING_PATH != "FORWARD") && (Defaults::rendererDefaults.RENDERING_PATH != "DEFERRED") && (Defaults::rendererDefaults.RENDERING_PATH != "VISIBILITY")) {
+        throwDebugException("Unknown rendering path \"" + Defaults::rendererDefaults.RENDERING_PATH + "\".");
+    }
+    // the visibility buffer is drawn and shaded in the deferred subpasses, with its own G-buffer.
+    m_visibilityBufferEnabled = (Defaults::rendererDefaults.RENDERING_PATH == "VISIBILITY");
+    m_deferredRenderingEnabled = ((Defaults::rendererDefaults.RENDERING_PATH == "DEFERRED") || (m_visibilityBufferEnabled == true));
+    if (m_visibilityBufferEnabled == true) {
+        m_gBufferImageFormats = {RendererDetails::visibilityBufferImageFormat};
+    } else if (m_deferredRenderingEnabled == true) {
+        m_gBufferImageFormats.assign(RendererDetails::gBufferImageFormats.begin(), RendererDetails::gBufferImageFormats.end());
+    }
+    if (m_deferredRenderingEnabled == true) {
+        displayDetails.gBufferImageFormats = m_gBufferImageFormats;
+        displayDetails.gBufferTransient = (m_occlusionCullingEnabled == false);  // two-phase occlusion culling splits the main render pass, the G-buffer is then stored between them.
+    }
+    displayDetails.colorImageTransient = (m_occlusionCullingEnabled == false);  // the same for the msaa color image.
+
+    selectMemberSampleCount(vulkanPhysicalDevice, displayDetails.msaaSampleCount);
+    m_qualityGovernor.generateGovernor((Defaults::rendererDefaults.QUALITY_GOVERNOR == "ON"), Defaults::rendererDefaults.TARGET_FRAME_TIME, displayDetails.msaaSampleCount);
     
-    createMemberRenderPass(displayDetails.swapchainImageFormat, displayDetails.msaaSampleCount, vulkanPhysicalDevice);
+    createMemberRenderPass(RendererDetails::sceneColorImageFormat, displayDetails.msaaSampleCount, vulkanPhysicalDevice);
     
 
     VkDescriptorSetLayoutBinding cubemapUniformBufferLayoutBinding{};
@@ -754,10 +1556,56 @@ RendererDetails::Renderer::Renderer(DisplayManager::DisplayDetails& displayDetai
     VkDescriptorSetLayoutBinding scenePointShadowLayoutBinding{};
     ResourceDescriptor::populateDescriptorSetLayoutBinding(4, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_FRAGMENT_BIT, scenePointShadowLayoutBinding);
 
-    std::vector<VkDescriptorSetLayoutBinding> sceneDescriptorSetLayoutBindings = {sceneUniformBufferLayoutBinding, sceneMainModelAlbedoLayoutBinding, sceneMainModelNormalLayoutBinding, sceneDirectionalShadowLayoutBinding, scenePointShadowLayoutBinding};
+    VkDescriptorSetLayoutBinding sceneShadowAtlasLayoutBinding{};
+    ResourceDescriptor::populateDescriptorSetLayoutBinding(5, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_FRAGMENT_BIT, sceneShadowAtlasLayoutBinding);
+
+    // the shadow maps are bound a second time without comparison, used in PCSS blocker searches.
+    VkDescriptorSetLayoutBinding sceneDirectionalShadowDepthLayoutBinding{};
+    ResourceDescriptor::populateDescriptorSetLayoutBinding(6, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_FRAGMENT_BIT, sceneDirectionalShadowDepthLayoutBinding);
+
+    VkDescriptorSetLayoutBinding scenePointShadowDepthLayoutBinding{};
+    ResourceDescriptor::populateDescriptorSetLayoutBinding(7, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_FRAGMENT_BIT, scenePointShadowDepthLayoutBinding);
+
+    VkDescriptorSetLayoutBinding sceneShadowAtlasDepthLayoutBinding{};
+    ResourceDescriptor::populateDescriptorSetLayoutBinding(8, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_FRAGMENT_BIT, sceneShadowAtlasDepthLayoutBinding);
+
+    VkDescriptorSetLayoutBinding sceneCullingInstanceLayoutBinding{};  // also read by the visibility buffer shading, transforming the fetched triangles.
+    ResourceDescriptor::populateDescriptorSetLayoutBinding(9, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, ((m_visibilityBufferEnabled == true) ? (VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT) : VK_SHADER_STAGE_VERTEX_BIT), sceneCullingInstanceLayoutBinding);
+
+    VkDescriptorSetLayoutBinding sceneLightLayoutBinding{};
+    ResourceDescriptor::populateDescriptorSetLayoutBinding(10, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_FRAGMENT_BIT, sceneLightLayoutBinding);
+
+    VkDescriptorSetLayoutBinding sceneClusterLightLayoutBinding{};  // each cluster's light list, written by the light clustering compute pass.
+    ResourceDescriptor::populateDescriptorSetLayoutBinding(11, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_FRAGMENT_BIT, sceneClusterLightLayoutBinding);
+
+    std::vector<VkDescriptorSetLayoutBinding> sceneDescriptorSetLayoutBindings = {sceneUniformBufferLayoutBinding, sceneMainModelAlbedoLayoutBinding, sceneMainModelNormalLayoutBinding, sceneDirectionalShadowLayoutBinding, scenePointShadowLayoutBinding, sceneShadowAtlasLayoutBinding, sceneDirectionalShadowDepthLayoutBinding, scenePointShadowDepthLayoutBinding, sceneShadowAtlasDepthLayoutBinding, sceneCullingInstanceLayoutBinding, sceneLightLayoutBinding, sceneClusterLightLayoutBinding};
+    uint32_t gBufferInputAttachmentCount = ((m_deferredRenderingEnabled == true) ? static_cast<uint32_t>(m_gBufferImageFormats.size() + 1) : 0);  // the G-buffer and depth.
+    for (uint32_t i = 0; i < gBufferInputAttachmentCount; i += 1) {
+        VkDescriptorSetLayoutBinding sceneGBufferLayoutBinding{};  // read by the deferred lighting pipeline.
+        ResourceDescriptor::populateDescriptorSetLayoutBinding((RendererDetails::gBufferInputAttachmentBinding + i), VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT, VK_SHADER_STAGE_FRAGMENT_BIT, sceneGBufferLayoutBinding);
+        sceneDescriptorSetLayoutBindings.push_back(sceneGBufferLayoutBinding);
+    }
+    uint32_t visibilityGeometryBufferCount = ((m_visibilityBufferEnabled == true) ? 2 : 0);  // the scene vertices and indices.
+    for (uint32_t i = 0; i < visibilityGeometryBufferCount; i += 1) {
+        VkDescriptorSetLayoutBinding sceneGeometryLayoutBinding{};  // the visibility buffer shading fetches each pixel's triangle.
+        ResourceDescriptor::populateDescriptorSetLayoutBinding((RendererDetails::visibilityGeometryBinding + i), VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_FRAGMENT_BIT, sceneGeometryLayoutBinding);
+        sceneDescriptorSetLayoutBindings.push_back(sceneGeometryLayoutBinding);
+    }
     ResourceDescriptor::createDescriptorSetLayout(sceneDescriptorSetLayoutBindings, *m_vulkanLogicalDevice, m_scenePipelineComponents.descriptorSetLayout);
     
-    createMemberScenePipeline(displayDetails.msaaSampleCount);
+    if ((Defaults::rendererDefaults.DEPTH_PREPASS != "ON") && (Defaults::rendererDefaults.DEPTH_PREPASS != "OFF")) {
+        throwDebugException("Unknown depth prepass mode \"" + Defaults::rendererDefaults.DEPTH_PREPASS + "\".");
+    }
+    m_depthPrepassEnabled = (Defaults::rendererDefaults.DEPTH_PREPASS == "ON");
+    
+    createMemberScenePipeline(displayDetails.msaaSampleCount, false);
+    createMemberScenePipeline(displayDetails.msaaSampleCount, true);
+    if (m_depthPrepassEnabled == true) {
+        createMemberDepthPrepassPipeline(displayDetails.msaaSampleCount);
+    }
+    if (m_deferredRenderingEnabled == true) {
+        createMemberDeferredLightingPipeline(displayDetails.msaaSampleCount);
+    }
 
     
     VkDescriptorSetLayoutBinding sceneNormalsUniformBufferLayoutBinding{};
@@ -770,35 +1618,118 @@ RendererDetails::Renderer::Renderer(DisplayManager::DisplayDetails& displayDetai
 
     
     VkDescriptorSetLayoutBinding directionalShadowUniformBufferLayoutBinding{};
-    ResourceDescriptor::populateDescriptorSetLayoutBinding(0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, (VK_SHADER_STAGE_VERTEX_BIT), directionalShadowUniformBufferLayoutBinding);
+    ResourceDescriptor::populateDescriptorSetLayoutBinding(0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, (VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT), directionalShadowUniformBufferLayoutBinding);
+
+    VkDescriptorSetLayoutBinding directionalShadowCullingInstanceLayoutBinding{};
+    ResourceDescriptor::populateDescriptorSetLayoutBinding(1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_VERTEX_BIT, directionalShadowCullingInstanceLayoutBinding);
+
+    VkDescriptorSetLayoutBinding directionalShadowAlbedoLayoutBinding{};  // main model albedo texture sampler, read by the masked pipeline's alpha test.
+    ResourceDescriptor::populateDescriptorSetLayoutBinding(2, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_FRAGMENT_BIT, directionalShadowAlbedoLayoutBinding);
     
-    std::vector<VkDescriptorSetLayoutBinding> directionalShadowDescriptorSetLayoutBindings = {directionalShadowUniformBufferLayoutBinding};
+    std::vector<VkDescriptorSetLayoutBinding> directionalShadowDescriptorSetLayoutBindings = {directionalShadowUniformBufferLayoutBinding, directionalShadowCullingInstanceLayoutBinding, directionalShadowAlbedoLayoutBinding};
     ResourceDescriptor::createDescriptorSetLayout(directionalShadowDescriptorSetLayoutBindings, *m_vulkanLogicalDevice, m_directionalShadowOperation.pipelineComponents.descriptorSetLayout);
 
     
     VkDescriptorSetLayoutBinding pointShadowUniformBufferLayoutBinding{};
     ResourceDescriptor::populateDescriptorSetLayoutBinding(0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, (VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT), pointShadowUniformBufferLayoutBinding);
+
+    VkDescriptorSetLayoutBinding pointShadowCullingInstanceLayoutBinding{};
+    ResourceDescriptor::populateDescriptorSetLayoutBinding(1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_VERTEX_BIT, pointShadowCullingInstanceLayoutBinding);
+
+    VkDescriptorSetLayoutBinding pointShadowAlbedoLayoutBinding{};  // main model albedo texture sampler, read by the masked pipelines' alpha test.
+    ResourceDescriptor::populateDescriptorSetLayoutBinding(2, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_FRAGMENT_BIT, pointShadowAlbedoLayoutBinding);
     
-    std::vector<VkDescriptorSetLayoutBinding> pointShadowDescriptorSetLayoutBindings = {pointShadowUniformBufferLayoutBinding};
+    std::vector<VkDescriptorSetLayoutBinding> pointShadowDescriptorSetLayoutBindings = {pointShadowUniformBufferLayoutBinding, pointShadowCullingInstanceLayoutBinding, pointShadowAlbedoLayoutBinding};
     ResourceDescriptor::createDescriptorSetLayout(pointShadowDescriptorSetLayoutBindings, *m_vulkanLogicalDevice, m_pointShadowOperation.pipelineComponents.descriptorSetLayout);
 
     
+    VkDescriptorSetLayoutBinding shadowAtlasUniformBufferLayoutBinding{};
+    ResourceDescriptor::populateDescriptorSetLayoutBinding(0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, (VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT), shadowAtlasUniformBufferLayoutBinding);
+
+    VkDescriptorSetLayoutBinding shadowAtlasAlbedoLayoutBinding{};  // main model albedo texture sampler, read by the masked pipeline's alpha test.
+    ResourceDescriptor::populateDescriptorSetLayoutBinding(1, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_FRAGMENT_BIT, shadowAtlasAlbedoLayoutBinding);
+    
+    std::vector<VkDescriptorSetLayoutBinding> shadowAtlasDescriptorSetLayoutBindings = {shadowAtlasUniformBufferLayoutBinding, shadowAtlasAlbedoLayoutBinding};
+    ResourceDescriptor::createDescriptorSetLayout(shadowAtlasDescriptorSetLayoutBindings, *m_vulkanLogicalDevice, m_shadowAtlasOperation.pipelineComponents.descriptorSetLayout);
+
+    
     CommandManager::createGraphicsCommandPool(graphicsFamilyIndex, *m_vulkanLogicalDevice, displayDetails.graphicsCommandPool);
 
     Image::generateSwapchainImageDetails(displayDetails, temporaryVulkanDevices);
 
-    SwapchainHandler::createSwapchainFramebuffers(displayDetails.swapchainImageViews, displayDetails.swapchainImageExtent, displayDetails.colorImageDetails.imageView, displayDetails.depthImageDetails.imageView, m_renderPass, *m_vulkanLogicalDevice, displayDetails.swapchainFramebuffers);
+    // the bloom and the exposure are computed from the HDR scene color, and applied with the tonemapping in the presentation passes.
+    m_postProcessingOperation.generateMemberComponents(Defaults::rendererDefaults.BLOOM_INTENSITY, Defaults::rendererDefaults.EXPOSURE_ADAPTATION_SPEED, displayDetails.graphicsCommandPool, displayDetails.graphicsQueue, temporaryVulkanDevices);
+    VkImageView sceneColorImageView = ((displayDetails.msaaSampleCount != VK_SAMPLE_COUNT_1_BIT) ? displayDetails.sceneColorImageDetails.imageView : displayDetails.colorImageDetails.imageView);
+    m_postProcessingOperation.generatePostImages(sceneColorImageView, displayDetails.swapchainImageExtent, temporaryVulkanDevices);
+
+    // the swapchain images are only written by the anti-aliasing presentation pass.
+    m_antiAliasingOperation.generateMemberComponents(displayDetails.swapchainImageFormat, m_antiAliasingMode, temporaryVulkanDevices);
+    m_antiAliasingOperation.generatePostImages(sceneColorImageView, m_postProcessingOperation.bloomImageDetails.imageView, m_postProcessingOperation.exposureBuffer, displayDetails.swapchainImageExtent, temporaryVulkanDevices);
+
+    SwapchainHandler::createSceneFramebuffer(displayDetails, m_renderPass, *m_vulkanLogicalDevice, displayDetails.sceneFramebuffer);
+    SwapchainHandler::createSwapchainFramebuffers(displayDetails.swapchainImageViews, displayDetails.swapchainImageExtent, m_antiAliasingOperation.presentationRenderPass, *m_vulkanLogicalDevice, displayDetails.swapchainFramebuffers);
+
+    // TAA writes the swapchain images through its own resolve framebuffers, which also write the history.
+    m_temporalOperation.generateMemberComponents(displayDetails.swapchainImageFormat, temporaryVulkanDevices);
+    m_temporalOperation.generateTemporalImages(sceneColorImageView, displayDetails.depthImageDetails.imageView, m_postProcessingOperation.bloomImageDetails.imageView, m_postProcessingOperation.exposureBuffer, displayDetails.swapchainImageViews, displayDetails.swapchainImageExtent, displayDetails.graphicsCommandPool, displayDetails.graphicsQueue, temporaryVulkanDevices);
+    m_resolutionController.generateMemberComponents(graphicsFamilyIndex, Defaults::rendererDefaults.TARGET_FRAME_TIME, Defaults::rendererDefaults.MIN_RENDER_SCALE, temporaryVulkanDevices);
 
-    m_directionalShadowOperation.generateMemberComponents((displayDetails.swapchainImageExtent.width / 1), (displayDetails.swapchainImageExtent.height / 1), 1, &RendererDetails::createShadowRenderPass, &RendererDetails::createDirectionalShadowPipeline, displayDetails.graphicsCommandPool, displayDetails.graphicsQueue, temporaryVulkanDevices);
+    // shadow map resolutions are independent of the swapchain, and are kept across swapchain recreation.
+    m_directionalShadowOperation.generateMemberComponents(Defaults::rendererDefaults.DIRECTIONAL_SHADOW_RESOLUTION, Defaults::rendererDefaults.DIRECTIONAL_SHADOW_RESOLUTION, Defaults::rendererDefaults.SHADOW_CASCADE_COUNT, &RendererDetails::createDirectionalShadowRenderPass, &RendererDetails::createDirectionalShadowPipeline, nullptr, displayDetails.graphicsCommandPool, displayDetails.graphicsQueue, temporaryVulkanDevices);
 
-    m_pointShadowOperation.generateMemberComponents((displayDetails.swapchainImageExtent.width / 1), (displayDetails.swapchainImageExtent.height / 1), 6, &RendererDetails::createShadowRenderPass, &RendererDetails::createPointShadowPipeline, displayDetails.graphicsCommandPool, displayDetails.graphicsQueue, temporaryVulkanDevices);
+    // stale faces are rendered one by one if not all faces are rendered(time-sliced or faces without casters).
+    m_pointShadowOperation.generateMemberComponents(Defaults::rendererDefaults.POINT_SHADOW_RESOLUTION, Defaults::rendererDefaults.POINT_SHADOW_RESOLUTION, 6, &RendererDetails::createPointShadowRenderPass, &RendererDetails::createPointShadowPipeline, &RendererDetails::createShadowLayerRenderPass, displayDetails.graphicsCommandPool, displayDetails.graphicsQueue, temporaryVulkanDevices);
+
+    // one depth layer shared by every additional shadowed light, each light renders into its own tiles.
+    if ((Defaults::rendererDefaults.SHADOW_ATLAS_TEST_LIGHTS != "ON") && (Defaults::rendererDefaults.SHADOW_ATLAS_TEST_LIGHTS != "OFF")) {
+        throwDebugException("Unknown shadow atlas test lights mode \"" + Defaults::rendererDefaults.SHADOW_ATLAS_TEST_LIGHTS + "\".");
+    }
+    m_shadowAtlasOperation.generateMemberComponents(Defaults::rendererDefaults.SHADOW_ATLAS_RESOLUTION, Defaults::rendererDefaults.SHADOW_ATLAS_RESOLUTION, 1, &RendererDetails::createShadowLayerRenderPass, &RendererDetails::createShadowAtlasPipeline, nullptr, displayDetails.graphicsCommandPool, displayDetails.graphicsQueue, temporaryVulkanDevices);
+
+    // the instance buffers are bound by the scene and shadow pipelines, and are generated before their descriptor sets.
+    // the visibility buffer only has room for the instance indices above its triangle index bits, instances beyond them are dropped.
+    uint32_t maxCullingInstanceCount = Defaults::rendererDefaults.MAX_CULLING_INSTANCE_COUNT;
+    if (m_visibilityBufferEnabled == true) {
+        maxCullingInstanceCount = std::min(maxCullingInstanceCount, (1u << (32 - RendererDetails::visibilityTriangleIndexBits)));
+    }
+    m_cullingOperation.generateMemberComponents(maxCullingInstanceCount, displayDetails.graphicsCommandPool, displayDetails.graphicsQueue, temporaryVulkanDevices);
+    ResourceDescriptor::populateFrameStorageBufferDescriptors(2, m_cullingOperation.instanceBuffers, *m_vulkanLogicalDevice, m_temporalOperation.motionVectorsPipelineComponents.descriptorSets);  // the motion vectors draw the culled instances.
+
+    // the light buffers and cluster light lists are bound by the scene pipeline, and are generated before its descriptor sets.
+    m_lightClusteringOperation.generateMemberComponents(Defaults::rendererDefaults.MAX_SCENE_LIGHT_COUNT, temporaryVulkanDevices);
+
+    // the depth pyramid is always generated, the culling descriptor sets bind it even without occlusion culling.
+    m_depthPyramidOperation.generateMemberComponents(displayDetails.msaaSampleCount, temporaryVulkanDevices);
+    m_depthPyramidOperation.generatePyramidImage(displayDetails.depthImageDetails.imageView, displayDetails.swapchainImageExtent, temporaryVulkanDevices);
+    m_cullingOperation.populateDepthPyramidDescriptors(m_depthPyramidOperation.pyramidSampler, m_depthPyramidOperation.pyramidImageDetails.imageView, *m_vulkanLogicalDevice);
+    m_cpuCullingScene.resetCullingScene();
+    if (m_maskedOcclusionEnabled == true) {  // starts the rasterization threads.
+        m_occlusionBuffer.generateOcclusionBuffer(Defaults::rendererDefaults.MASKED_OCCLUSION_THREAD_COUNT);
+        m_occlusionBuffer.verifyOcclusionBuffer();  // checked on the same threads that rasterize the scene's occluders.
+    }
+    if (Defaults::rendererDefaults.CULLING_BENCHMARK_INSTANCE_COUNT > 0) {
+        BoundingVolumeHierarchy::benchmarkCullingScene(Defaults::rendererDefaults.CULLING_BENCHMARK_INSTANCE_COUNT);
+        MaskedOcclusion::benchmarkOcclusionBuffer(Defaults::rendererDefaults.CULLING_BENCHMARK_INSTANCE_COUNT, Defaults::rendererDefaults.MASKED_OCCLUSION_THREAD_COUNT);
+    }
 
-    m_mainModel.loadModelFromAbsolutePath((Defaults::applicationDefaults.SALAMANDER_ROOT_DIRECTORY + "/assets/models/Avocado/Avocado.gltf"));
+    m_mainModel.loadModelFromAbsolutePath((Defaults::applicationDefaults.SALAMANDER_ROOT_DIRECTORY + "/assets/models/" + Defaults::rendererDefaults.MAIN_MODEL));
+    m_mainModel.subdivideMesh(Defaults::rendererDefaults.MAIN_MODEL_SUBDIVISION_COUNT);
+    if ((m_visibilityBufferEnabled == true) && ((m_mainModel.meshIndices.empty() == true) || ((m_mainModel.meshIndices.size() / 3) > (1u << RendererDetails::visibilityTriangleIndexBits)))) {  // the triangles are fetched through the index buffer.
+        throwDebugException("The main mesh is not indexed, or has more triangles than the visibility buffer can index.");
+    }
+    m_mainModel.splitMeshChunks(Defaults::rendererDefaults.MAIN_MESH_CHUNK_TRIANGLE_COUNT, m_cullingOperation.maxInstanceCount);  // every chunk has a slot in the instance buffer.
     // TODO: add seperate "transfer" queue(see vulkan-tutorial page).
     m_mainModel.populateShaderBufferComponents(m_mainModel.meshVertices, displayDetails.graphicsCommandPool, displayDetails.graphicsQueue, temporaryVulkanDevices);
     Image::populateTextureDetails(m_mainModel.absoluteTextureImagePath, false, displayDetails.graphicsCommandPool, displayDetails.graphicsQueue, temporaryVulkanDevices, m_mainModel.textureDetails);
     Image::populateTextureDetails(m_mainModel.absoluteNormalImagePath, false, displayDetails.graphicsCommandPool, displayDetails.graphicsQueue, temporaryVulkanDevices, m_mainModel.normalTextureDetails);
 
+    // the main mesh occludes with a decimated copy of itself.
+    std::vector<glm::vec3> mainModelPositions(m_mainModel.meshVertices.size());
+    for (size_t i = 0; i < m_mainModel.meshVertices.size(); i += 1) {
+        mainModelPositions[i] = m_mainModel.meshVertices[i].position;
+    }
+    MaskedOcclusion::buildOccluderMesh(mainModelPositions, m_mainModel.meshIndices, Defaults::rendererDefaults.MASKED_OCCLUSION_TRIANGLE_BUDGET, m_mainOccluderMesh);
+
     m_dummySceneNormalsModel.meshVertices = m_mainModel.meshVertices;
     m_dummySceneNormalsModel.meshIndices = m_mainModel.meshIndices;
 
@@ -836,7 +1767,7 @@ RendererDetails::Renderer::Renderer(DisplayManager::DisplayDetails& displayDetai
     Image::populateTextureDetails((Defaults::applicationDefaults.SALAMANDER_ROOT_DIRECTORY + "/assets/skyboxes/field"), true, displayDetails.graphicsCommandPool, displayDetails.graphicsQueue, temporaryVulkanDevices, m_cubemapModel.textureDetails);
 
     Uniform::createUniformBuffers(sizeof(Uniform::SceneUniformBufferObject), temporaryVulkanDevices, m_scenePipelineComponents.uniformBuffers, m_scenePipelineComponents.uniformBuffersMemory, m_scenePipelineComponents.mappedUniformBuffersMemory);
-    ResourceDescriptor::createDescriptorPool(4, *m_vulkanLogicalDevice, m_scenePipelineComponents.descriptorPool);
+    ResourceDescriptor::createDescriptorPool(8, (3 + visibilityGeometryBufferCount), gBufferInputAttachmentCount, *m_vulkanLogicalDevice, m_scenePipelineComponents.descriptorPool);
     ResourceDescriptor::createDescriptorSets(m_scenePipelineComponents.descriptorSetLayout, m_scenePipelineComponents.descriptorPool, *m_vulkanLogicalDevice, m_scenePipelineComponents.descriptorSets);
     
     VkDescriptorImageInfo mainModelAlbedoDescriptorImageInfo{};
@@ -859,12 +1790,57 @@ RendererDetails::Renderer::Renderer(DisplayManager::DisplayDetails& displayDetai
     VkWriteDescriptorSet pointShadowWriteDescriptorSet{};
     ResourceDescriptor::populateWriteDescriptorSet(nullptr, 4, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, &pointShadowDescriptorImageInfo, nullptr, pointShadowWriteDescriptorSet);
 
-    std::vector sceneWriteDescriptorSets = {mainModelAlbedoWriteDescriptorSet, mainModelNormalMapWriteDescriptorSet, directionalShadowWriteDescriptorSet, pointShadowWriteDescriptorSet};
+    VkDescriptorImageInfo shadowAtlasDescriptorImageInfo{};
+    ResourceDescriptor::populateDescriptorImageInfo(m_shadowAtlasOperation.depthTextureDetails.textureSampler, m_shadowAtlasOperation.depthTextureDetails.textureImageDetails.imageView, m_shadowAtlasOperation.depthTextureDetails.textureImageDetails.imageLayout, shadowAtlasDescriptorImageInfo);
+    VkWriteDescriptorSet shadowAtlasWriteDescriptorSet{};
+    ResourceDescriptor::populateWriteDescriptorSet(nullptr, 5, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, &shadowAtlasDescriptorImageInfo, nullptr, shadowAtlasWriteDescriptorSet);
+
+    VkDescriptorImageInfo directionalShadowDepthDescriptorImageInfo{};
+    ResourceDescriptor::populateDescriptorImageInfo(m_directionalShadowOperation.depthSampler, m_directionalShadowOperation.depthTextureDetails.textureImageDetails.imageView, m_directionalShadowOperation.depthTextureDetails.textureImageDetails.imageLayout, directionalShadowDepthDescriptorImageInfo);
+    VkWriteDescriptorSet directionalShadowDepthWriteDescriptorSet{};
+    ResourceDescriptor::populateWriteDescriptorSet(nullptr, 6, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, &directionalShadowDepthDescriptorImageInfo, nullptr, directionalShadowDepthWriteDescriptorSet);
+
+    VkDescriptorImageInfo pointShadowDepthDescriptorImageInfo{};
+    ResourceDescriptor::populateDescriptorImageInfo(m_pointShadowOperation.depthSampler, m_pointShadowOperation.depthTextureDetails.textureImageDetails.imageView, m_pointShadowOperation.depthTextureDetails.textureImageDetails.imageLayout, pointShadowDepthDescriptorImageInfo);
+    VkWriteDescriptorSet pointShadowDepthWriteDescriptorSet{};
+    ResourceDescriptor::populateWriteDescriptorSet(nullptr, 7, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, &pointShadowDepthDescriptorImageInfo, nullptr, pointShadowDepthWriteDescriptorSet);
+
+    VkDescriptorImageInfo shadowAtlasDepthDescriptorImageInfo{};
+    ResourceDescriptor::populateDescriptorImageInfo(m_shadowAtlasOperation.depthSampler, m_shadowAtlasOperation.depthTextureDetails.textureImageDetails.imageView, m_shadowAtlasOperation.depthTextureDetails.textureImageDetails.imageLayout, shadowAtlasDepthDescriptorImageInfo);
+    VkWriteDescriptorSet shadowAtlasDepthWriteDescriptorSet{};
+    ResourceDescriptor::populateWriteDescriptorSet(nullptr, 8, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, &shadowAtlasDepthDescriptorImageInfo, nullptr, shadowAtlasDepthWriteDescriptorSet);
+
+    VkDescriptorBufferInfo clusterLightDescriptorBufferInfo{};
+    ResourceDescriptor::populateDescriptorBufferInfo(m_lightClusteringOperation.clusterLightBuffer, 0, VK_WHOLE_SIZE, clusterLightDescriptorBufferInfo);
+    VkWriteDescriptorSet clusterLightWriteDescriptorSet{};
+    ResourceDescriptor::populateWriteDescriptorSet(nullptr, 11, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, nullptr, &clusterLightDescriptorBufferInfo, clusterLightWriteDescriptorSet);
+
+    std::vector sceneWriteDescriptorSets = {mainModelAlbedoWriteDescriptorSet, mainModelNormalMapWriteDescriptorSet, directionalShadowWriteDescriptorSet, pointShadowWriteDescriptorSet, shadowAtlasWriteDescriptorSet, directionalShadowDepthWriteDescriptorSet, pointShadowDepthWriteDescriptorSet, shadowAtlasDepthWriteDescriptorSet, clusterLightWriteDescriptorSet};
+
+    VkDescriptorBufferInfo sceneVertexDescriptorBufferInfo{};
+    VkDescriptorBufferInfo sceneIndexDescriptorBufferInfo{};
+    if (m_visibilityBufferEnabled == true) {  // the main mesh's vertex and index buffers, the culled draws only draw the main mesh.
+        ResourceDescriptor::populateDescriptorBufferInfo(m_mainModel.shaderBufferComponents.vertexBuffer, 0, VK_WHOLE_SIZE, sceneVertexDescriptorBufferInfo);
+        VkWriteDescriptorSet sceneVertexWriteDescriptorSet{};
+        ResourceDescriptor::populateWriteDescriptorSet(nullptr, RendererDetails::visibilityGeometryBinding, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, nullptr, &sceneVertexDescriptorBufferInfo, sceneVertexWriteDescriptorSet);
+
+        ResourceDescriptor::populateDescriptorBufferInfo(m_mainModel.shaderBufferComponents.indexBuffer, 0, VK_WHOLE_SIZE, sceneIndexDescriptorBufferInfo);
+        VkWriteDescriptorSet sceneIndexWriteDescriptorSet{};
+        ResourceDescriptor::populateWriteDescriptorSet(nullptr, (RendererDetails::visibilityGeometryBinding + 1), VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, nullptr, &sceneIndexDescriptorBufferInfo, sceneIndexWriteDescriptorSet);
+
+        sceneWriteDescriptorSets.push_back(sceneVertexWriteDescriptorSet);
+        sceneWriteDescriptorSets.push_back(sceneIndexWriteDescriptorSet);
+    }
     ResourceDescriptor::populateDescriptorSets(m_scenePipelineComponents.uniformBuffers, sceneWriteDescriptorSets, *m_vulkanLogicalDevice, m_scenePipelineComponents.descriptorSets);
+    ResourceDescriptor::populateFrameStorageBufferDescriptors(9, m_cullingOperation.instanceBuffers, *m_vulkanLogicalDevice, m_scenePipelineComponents.descriptorSets);
+    ResourceDescriptor::populateFrameStorageBufferDescriptors(10, m_lightClusteringOperation.lightBuffers, *m_vulkanLogicalDevice, m_scenePipelineComponents.descriptorSets);
+    if (m_deferredRenderingEnabled == true) {
+        populateMemberGBufferDescriptors(displayDetails);
+    }
     
 
     Uniform::createUniformBuffers(sizeof(Uniform::SceneNormalsUniformBufferObject), temporaryVulkanDevices, m_sceneNormalsPipelineComponents.uniformBuffers, m_sceneNormalsPipelineComponents.uniformBuffersMemory, m_sceneNormalsPipelineComponents.mappedUniformBuffersMemory);
-    ResourceDescriptor::createDescriptorPool(0, *m_vulkanLogicalDevice, m_sceneNormalsPipelineComponents.descriptorPool);
+    ResourceDescriptor::createDescriptorPool(0, 0, 0, *m_vulkanLogicalDevice, m_sceneNormalsPipelineComponents.descriptorPool);
     ResourceDescriptor::createDescriptorSets(m_sceneNormalsPipelineComponents.descriptorSetLayout, m_sceneNormalsPipelineComponents.descriptorPool, *m_vulkanLogicalDevice, m_sceneNormalsPipelineComponents.descriptorSets);
     
     std::vector<VkWriteDescriptorSet> sceneNormalsWriteDescriptorSets;
@@ -872,7 +1848,7 @@ RendererDetails::Renderer::Renderer(DisplayManager::DisplayDetails& displayDetai
     
 
     Uniform::createUniformBuffers(sizeof(Uniform::CubemapUniformBufferObject), temporaryVulkanDevices, m_cubemapPipelineComponents.uniformBuffers, m_cubemapPipelineComponents.uniformBuffersMemory, m_cubemapPipelineComponents.mappedUniformBuffersMemory);
-    ResourceDescriptor::createDescriptorPool(1, *m_vulkanLogicalDevice, m_cubemapPipelineComponents.descriptorPool);
+    ResourceDescriptor::createDescriptorPool(1, 0, 0, *m_vulkanLogicalDevice, m_cubemapPipelineComponents.descriptorPool);
     ResourceDescriptor::createDescriptorSets(m_cubemapPipelineComponents.descriptorSetLayout, m_cubemapPipelineComponents.descriptorPool, *m_vulkanLogicalDevice, m_cubemapPipelineComponents.descriptorSets);
     
     VkDescriptorImageInfo cubemapDescriptorImageInfo{};
@@ -885,22 +1861,44 @@ RendererDetails::Renderer::Renderer(DisplayManager::DisplayDetails& displayDetai
     
 
     Uniform::createUniformBuffers(sizeof(Uniform::DirectionalShadowUniformBufferObject), temporaryVulkanDevices, m_directionalShadowOperation.pipelineComponents.uniformBuffers, m_directionalShadowOperation.pipelineComponents.uniformBuffersMemory, m_directionalShadowOperation.pipelineComponents.mappedUniformBuffersMemory);
-    ResourceDescriptor::createDescriptorPool(0, *m_vulkanLogicalDevice, m_directionalShadowOperation.pipelineComponents.descriptorPool);
+    ResourceDescriptor::createDescriptorPool(1, 1, 0, *m_vulkanLogicalDevice, m_directionalShadowOperation.pipelineComponents.descriptorPool);
     ResourceDescriptor::createDescriptorSets(m_directionalShadowOperation.pipelineComponents.descriptorSetLayout, m_directionalShadowOperation.pipelineComponents.descriptorPool, *m_vulkanLogicalDevice, m_directionalShadowOperation.pipelineComponents.descriptorSets);
 
-    std::vector<VkWriteDescriptorSet> directionalShadowWriteDescriptorSets;
+    VkWriteDescriptorSet directionalShadowAlbedoWriteDescriptorSet{};
+    ResourceDescriptor::populateWriteDescriptorSet(nullptr, 2, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, &mainModelAlbedoDescriptorImageInfo, nullptr, directionalShadowAlbedoWriteDescriptorSet);
+
+    std::vector<VkWriteDescriptorSet> directionalShadowWriteDescriptorSets = {directionalShadowAlbedoWriteDescriptorSet};
     ResourceDescriptor::populateDescriptorSets(m_directionalShadowOperation.pipelineComponents.uniformBuffers, directionalShadowWriteDescriptorSets, *m_vulkanLogicalDevice, m_directionalShadowOperation.pipelineComponents.descriptorSets);
+    ResourceDescriptor::populateFrameStorageBufferDescriptors(1, m_cullingOperation.instanceBuffers, *m_vulkanLogicalDevice, m_directionalShadowOperation.pipelineComponents.descriptorSets);
 
 
     Uniform::createUniformBuffers(sizeof(Uniform::PointShadowUniformBufferObject), temporaryVulkanDevices, m_pointShadowOperation.pipelineComponents.uniformBuffers, m_pointShadowOperation.pipelineComponents.uniformBuffersMemory, m_pointShadowOperation.pipelineComponents.mappedUniformBuffersMemory);
-    ResourceDescriptor::createDescriptorPool(0, *m_vulkanLogicalDevice, m_pointShadowOperation.pipelineComponents.descriptorPool);
+    ResourceDescriptor::createDescriptorPool(1, 1, 0, *m_vulkanLogicalDevice, m_pointShadowOperation.pipelineComponents.descriptorPool);
     ResourceDescriptor::createDescriptorSets(m_pointShadowOperation.pipelineComponents.descriptorSetLayout, m_pointShadowOperation.pipelineComponents.descriptorPool, *m_vulkanLogicalDevice, m_pointShadowOperation.pipelineComponents.descriptorSets);
 
-    std::vector<VkWriteDescriptorSet> pointShadowWriteDescriptorSets;
+    VkWriteDescriptorSet pointShadowAlbedoWriteDescriptorSet{};
+    ResourceDescriptor::populateWriteDescriptorSet(nullptr, 2, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, &mainModelAlbedoDescriptorImageInfo, nullptr, pointShadowAlbedoWriteDescriptorSet);
+
+    std::vector<VkWriteDescriptorSet> pointShadowWriteDescriptorSets = {pointShadowAlbedoWriteDescriptorSet};
     ResourceDescriptor::populateDescriptorSets(m_pointShadowOperation.pipelineComponents.uniformBuffers, pointShadowWriteDescriptorSets, *m_vulkanLogicalDevice, m_pointShadowOperation.pipelineComponents.descriptorSets);
+    ResourceDescriptor::populateFrameStorageBufferDescriptors(1, m_cullingOperation.instanceBuffers, *m_vulkanLogicalDevice, m_pointShadowOperation.pipelineComponents.descriptorSets);
+
+
+    Uniform::createUniformBuffers(sizeof(Uniform::ShadowAtlasUniformBufferObject), temporaryVulkanDevices, m_shadowAtlasOperation.pipelineComponents.uniformBuffers, m_shadowAtlasOperation.pipelineComponents.uniformBuffersMemory, m_shadowAtlasOperation.pipelineComponents.mappedUniformBuffersMemory);
+    ResourceDescriptor::createDescriptorPool(1, 0, 0, *m_vulkanLogicalDevice, m_shadowAtlasOperation.pipelineComponents.descriptorPool);
+    ResourceDescriptor::createDescriptorSets(m_shadowAtlasOperation.pipelineComponents.descriptorSetLayout, m_shadowAtlasOperation.pipelineComponents.descriptorPool, *m_vulkanLogicalDevice, m_shadowAtlasOperation.pipelineComponents.descriptorSets);
+
+    VkWriteDescriptorSet shadowAtlasAlbedoWriteDescriptorSet{};
+    ResourceDescriptor::populateWriteDescriptorSet(nullptr, 1, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, &mainModelAlbedoDescriptorImageInfo, nullptr, shadowAtlasAlbedoWriteDescriptorSet);
+
+    std::vector<VkWriteDescriptorSet> shadowAtlasWriteDescriptorSets = {shadowAtlasAlbedoWriteDescriptorSet};
+    ResourceDescriptor::populateDescriptorSets(m_shadowAtlasOperation.pipelineComponents.uniformBuffers, shadowAtlasWriteDescriptorSets, *m_vulkanLogicalDevice, m_shadowAtlasOperation.pipelineComponents.descriptorSets);
     
 
-    CommandManager::allocateChildCommandBuffers(displayDetails.graphicsCommandPool, Defaults::rendererDefaults.MAX_FRAMES_IN_FLIGHT, *m_vulkanLogicalDevice, displayDetails.graphicsCommandBuffers);
+    createMemberRenderGraph(displayDetails);
+
+    CommandManager::allocateChildCommandBuffers(displayDetails.graphicsCommandPool, Defaults::rendererDefaults.MAX_FRAMES_IN_FLIGHT, VK_COMMAND_BUFFER_LEVEL_PRIMARY, *m_vulkanLogicalDevice, displayDetails.graphicsCommandBuffers);
+    CommandManager::createRecordingWorkers(graphicsFamilyIndex, Defaults::rendererDefaults.COMMAND_RECORDING_THREAD_COUNT, *m_vulkanLogicalDevice, displayDetails.graphicsRecordingWorkers);
 
     createMemberSynchronizationObjects();
 }
@@ -922,11 +1920,32 @@ RendererDetails::Renderer::~Renderer()
 
     m_cubemapPipelineComponents.cleanupPipelineComponents(*m_vulkanLogicalDevice);
     m_scenePipelineComponents.cleanupPipelineComponents(*m_vulkanLogicalDevice);
+    vkDestroyPipeline(*m_vulkanLogicalDevice, m_sceneMaskedPipelineComponents.pipeline, nullptr);  // the scene masked pipeline components share the scene pipeline components' descriptors.
+    vkDestroyPipelineLayout(*m_vulkanLogicalDevice, m_sceneMaskedPipelineComponents.pipelineLayout, nullptr);
     m_sceneNormalsPipelineComponents.cleanupPipelineComponents(*m_vulkanLogicalDevice);
+    if (m_depthPrepassEnabled == true) {  // the depth prepass pipeline components share the scene pipeline components' descriptors.
+        vkDestroyPipeline(*m_vulkanLogicalDevice, m_depthPrepassPipelineComponents.pipeline, nullptr);
+        vkDestroyPipelineLayout(*m_vulkanLogicalDevice, m_depthPrepassPipelineComponents.pipelineLayout, nullptr);
+    }
+    if (m_deferredRenderingEnabled == true) {  // the deferred lighting pipeline components share the scene pipeline components' descriptors.
+        vkDestroyPipeline(*m_vulkanLogicalDevice, m_deferredLightingPipelineComponents.pipeline, nullptr);
+        vkDestroyPipelineLayout(*m_vulkanLogicalDevice, m_deferredLightingPipelineComponents.pipelineLayout, nullptr);
+    }
     
     m_directionalShadowOperation.cleanupOffscreenOperation(*m_vulkanLogicalDevice);
     m_pointShadowOperation.cleanupOffscreenOperation(*m_vulkanLogicalDevice);
+    m_shadowAtlasOperation.cleanupOffscreenOperation(*m_vulkanLogicalDevice);
+
+    m_cullingOperation.cleanupCullingOperation(*m_vulkanLogicalDevice);
+    m_depthPyramidOperation.cleanupDepthPyramidOperation(*m_vulkanLogicalDevice);
+    m_occlusionBuffer.cleanupOcclusionBuffer();
+    m_lightClusteringOperation.cleanupClusteringOperation(*m_vulkanLogicalDevice);
+    m_postProcessingOperation.cleanupPostProcessingOperation(*m_vulkanLogicalDevice);
+    m_antiAliasingOperation.cleanupAntiAliasingOperation(*m_vulkanLogicalDevice);
+    m_temporalOperation.cleanupTemporalOperation(*m_vulkanLogicalDevice);
+    m_resolutionController.cleanupResolutionController(*m_vulkanLogicalDevice);
 
     vkDestroyRenderPass(*m_vulkanLogicalDevice, m_renderPass, nullptr);
+    vkDestroyRenderPass(*m_vulkanLogicalDevice, m_lateRenderPass, nullptr);
 }
 
@@ -7,12 +7,25 @@
 
 #include <core/Renderer/Pipeline.h>
 #include <core/Renderer/Offscreen.h>
+#include <core/Renderer/RenderGraph.h>
+#include <core/Renderer/ShadowAtlas.h>
+#include <core/Renderer/Culling.h>
+#include <core/Renderer/DepthPyramid.h>
+#include <core/Renderer/BoundingVolumeHierarchy.h>
+#include <core/Renderer/MaskedOcclusion.h>
+#include <core/Renderer/LightClustering.h>
+#include <core/Renderer/PostProcessing.h>
+#include <core/Renderer/AntiAliasing.h>
+#include <core/Renderer/TemporalAntiAliasing.h>
+#include <core/Renderer/DynamicResolution.h>
+#include <core/Renderer/PerformanceGovernor.h>
 #include <core/VulkanInstance/DeviceHandler.h>
 #include <core/Shader/Shader.h>
 #include <core/DisplayManager/Camera.h>
 #include <core/Model/ModelHandler.h>
 
 #include <vector>
+#include <array>
 
 
 namespace DisplayManager  // forward declaration.
@@ -22,31 +35,58 @@ namespace DisplayManager  // forward declaration.
 
 namespace RendererDetails
 {
+    const VkFormat sceneColorImageFormat = VK_FORMAT_B10G11R11_UFLOAT_PACK32;  // the HDR scene color, as large as an 8-bit color, tonemapped into the swapchain image by the presentation passes.
+    const std::array<VkFormat, 3> gBufferImageFormats = {VK_FORMAT_R8G8B8A8_UNORM, VK_FORMAT_R16G16_SFLOAT, VK_FORMAT_R8G8_UNORM};  // the deferred G-buffer's albedo, octahedral normal, and [roughness, metalness].
+    const uint32_t gBufferInputAttachmentBinding = 12;  // the scene descriptor set binding of the first G-buffer input attachment, followed by the other G-buffer attachments and depth.
+
+    const VkFormat visibilityBufferImageFormat = VK_FORMAT_R32_UINT;  // the visibility buffer's only G-buffer attachment, each pixel's packed instance and triangle index.
+    const uint32_t visibilityTriangleIndexBits = 23;  // identical to the visibility shaders' constant, the instance index is stored in the remaining high bits.
+    const uint32_t visibilityGeometryBinding = 16;  // the scene descriptor set binding of the scene vertex storage buffer, followed by the scene index storage buffer.
+
     // populate a color attachment description, reference, color attachment resolve description, reference for the scene render pass.
     //
-    // @param swapchainImageFormat the image format of the swapchain, used in populating the color attachment components.
+    // @param colorImageFormat the image format of the scene color, used in populating the color attachment components.
     // @param msaaSampleCount the amount of msaa samples.
     // @param colorAttachmentDescription populated color attachment description.
     // @param colorAttachmentReference populated color attachment reference.
     // @param colorAttachmentResolveDescription populated color attachment resolve description.
     // @param colorAttachmentResolveReference populated color attachment resolve reference.
-    void populateColorAttachmentComponents(VkFormat swapchainImageFormat, VkSampleCountFlagBits msaaSampleCount, VkAttachmentDescription& colorAttachmentDescription, VkAttachmentReference& colorAttachmentReference, VkAttachmentDescription& colorAttachmentResolveDescription, VkAttachmentReference& colorAttachmentResolveReference);
+    void populateColorAttachmentComponents(VkFormat colorImageFormat, VkSampleCountFlagBits msaaSampleCount, VkAttachmentDescription& colorAttachmentDescription, VkAttachmentReference& colorAttachmentReference, VkAttachmentDescription& colorAttachmentResolveDescription, VkAttachmentReference& colorAttachmentResolveReference);
 
     // populate a depth attachment description and reference.
     //
     // @param msaaSampleCount the amount of msaa samples.
     // @param storeOp the store operation to use for the depth attachment.
-    // @param vulkanPhysicalDevice Vulkan physical device to use in depth attachment population.
     // @param attachment see VkAttachmentReference documentation.
+    // @param depthAttachmentFormat the format of the depth attachment.
     // @param depthAttachmentDescription populated depth attachment description.
     // @param depthAttachmentReference populated depth attachment reference.
-    void populateDepthAttachmentComponents(VkSampleCountFlagBits msaaSampleCount, VkAttachmentStoreOp storeOp, uint32_t attachment, VkPhysicalDevice vulkanPhysicalDevice, VkAttachmentDescription& depthAttachmentDescription, VkAttachmentReference& depthAttachmentReference);
+    void populateDepthAttachmentComponents(VkSampleCountFlagBits msaaSampleCount, VkAttachmentStoreOp storeOp, uint32_t attachment, VkFormat depthAttachmentFormat, VkAttachmentDescription& depthAttachmentDescription, VkAttachmentReference& depthAttachmentReference);
 
-    // create a render pass for the a shadow offscreen operation.
+    // create a depth-only render pass for a shadow offscreen operation.
     //
-    // @param vulkanDevices Vulkan physical and logical device to use in the directional shadow render pass creation.
+    // @param viewMask the multiview view mask(a bit for each attachment layer rendered to), 0 disables multiview.
+    // @param vulkanDevices Vulkan physical and logical device to use in the shadow render pass creation.
     // @param renderPass created shadow render pass.
-    void createShadowRenderPass(DeviceHandler::VulkanDevices vulkanDevices, VkRenderPass& renderPass);
+    void createMultiviewShadowRenderPass(uint32_t viewMask, DeviceHandler::VulkanDevices vulkanDevices, VkRenderPass& renderPass);
+
+    // create a render pass rendering every directional shadow cascade at once.
+    //
+    // @param vulkanDevices Vulkan physical and logical device to use in the directional shadow render pass creation.
+    // @param renderPass created directional shadow render pass.
+    void createDirectionalShadowRenderPass(DeviceHandler::VulkanDevices vulkanDevices, VkRenderPass& renderPass);
+
+    // create a render pass rendering all six faces of a point shadow cubemap at once.
+    //
+    // @param vulkanDevices Vulkan physical and logical device to use in the point shadow render pass creation.
+    // @param renderPass created point shadow render pass.
+    void createPointShadowRenderPass(DeviceHandler::VulkanDevices vulkanDevices, VkRenderPass& renderPass);
+
+    // create a render pass rendering a single shadow map layer(ex: one point shadow cubemap face in time-sliced updates).
+    //
+    // @param vulkanDevices Vulkan physical and logical device to use in the shadow layer render pass creation.
+    // @param renderPass created shadow layer render pass.
+    void createShadowLayerRenderPass(DeviceHandler::VulkanDevices vulkanDevices, VkRenderPass& renderPass);
 
     // populate a viewport's create info.
     //
@@ -72,8 +112,9 @@ namespace RendererDetails
     //
     // @param rasterizationSamples see VkPipelineMultisampleStateCreateInfo documentation.
     // @param minSampleShading see VkPipelineMultisampleStateCreateInfo documentation.
+    // @param alphaToCoverageEnable see VkPipelineMultisampleStateCreateInfo documentation.
     // @param multisamplingCreateInfo populated multisampling create info.
-    void populateMultisamplingCreateInfo(VkSampleCountFlagBits rasterizationSamples, float minSampleShading, VkPipelineMultisampleStateCreateInfo& multisamplingCreateInfo);
+    void populateMultisamplingCreateInfo(VkSampleCountFlagBits rasterizationSamples, float minSampleShading, VkBool32 alphaToCoverageEnable, VkPipelineMultisampleStateCreateInfo& multisamplingCreateInfo);
 
     // populate a depth stencil's create info.
     //
@@ -109,15 +150,25 @@ namespace RendererDetails
     //
     // @param renderPass render pass to use in directional shadow pipeline creation.
     // @param vulkanLogicalDevice Vulkan logical device to use in directional shadow pipeline creation.
+    // @param alphaMasked if the pipeline draws the alpha-masked casters, reading the scene vertex data and discarding below the alpha cutoff.
     // @param pipelineComponents reference to the pipeline components to use and create the pipeline in.
-    void createDirectionalShadowPipeline(VkRenderPass renderPass, VkDevice vulkanLogicalDevice, Pipeline::PipelineComponents& pipelineComponents);
+    void createDirectionalShadowPipeline(VkRenderPass renderPass, VkDevice vulkanLogicalDevice, bool alphaMasked, Pipeline::PipelineComponents& pipelineComponents);
 
     // create point shadow pipeline.
     //
     // @param renderPass render pass to use in point shadow pipeline creation.
     // @param vulkanLogicalDevice Vulkan logical device to use in point shadow pipeline creation.
+    // @param alphaMasked if the pipeline draws the alpha-masked casters, reading the scene vertex data and discarding below the alpha cutoff.
     // @param pipelineComponents reference to the pipeline components to use and create the pipeline in.
-    void createPointShadowPipeline(VkRenderPass renderPass, VkDevice vulkanLogicalDevice, Pipeline::PipelineComponents& pipelineComponents);
+    void createPointShadowPipeline(VkRenderPass renderPass, VkDevice vulkanLogicalDevice, bool alphaMasked, Pipeline::PipelineComponents& pipelineComponents);
+
+    // create shadow atlas pipeline.
+    //
+    // @param renderPass render pass to use in shadow atlas pipeline creation.
+    // @param vulkanLogicalDevice Vulkan logical device to use in shadow atlas pipeline creation.
+    // @param alphaMasked if the pipeline draws the alpha-masked casters, reading the scene vertex data and discarding below the alpha cutoff.
+    // @param pipelineComponents reference to the pipeline components to use and create the pipeline in.
+    void createShadowAtlasPipeline(VkRenderPass renderPass, VkDevice vulkanLogicalDevice, bool alphaMasked, Pipeline::PipelineComponents& pipelineComponents);
     
     class Renderer
     {
@@ -126,11 +177,44 @@ namespace RendererDetails
     
         Pipeline::PipelineComponents m_cubemapPipelineComponents;  // the components used in the cubemap's graphics pipeline.    
         Pipeline::PipelineComponents m_scenePipelineComponents;  // the components used in the scene's graphics pipeline.
+        Pipeline::PipelineComponents m_sceneMaskedPipelineComponents;  // the alpha-masked scene pipeline, drawn after the opaque scene geometry, its descriptors are shared with the scene pipeline.
         Pipeline::PipelineComponents m_sceneNormalsPipelineComponents;  // the components used in the scene normals' graphics pipeline.
+        Pipeline::PipelineComponents m_depthPrepassPipelineComponents;  // the position-only depth prepass pipeline, its descriptors are shared with the scene pipeline.
+        bool m_depthPrepassEnabled;  // the scene pipeline only shades fragments equal to the prepass depth.
+        Pipeline::PipelineComponents m_deferredLightingPipelineComponents;  // the fullscreen deferred lighting pipeline, its descriptors are shared with the scene pipeline.
+        bool m_deferredRenderingEnabled;  // the scene pipeline writes the G-buffer, shaded by the lighting subpass of the main render pass(also with the visibility buffer).
+        bool m_visibilityBufferEnabled;  // the G-buffer only holds the visibility buffer, the lighting subpass fetches each pixel's triangle from the scene storage buffers.
+        std::vector<VkFormat> m_gBufferImageFormats;  // empty with forward rendering.
         Offscreen::OffscreenOperation m_directionalShadowOperation;  // the pipeline components and similar used in the directional shadow mapping offscreen operation.
         Offscreen::OffscreenOperation m_pointShadowOperation;  // the pipeline components and similar used in the point shadow mapping offscreen operation.
+        Offscreen::OffscreenOperation m_shadowAtlasOperation;  // the pipeline components and similar used in the shadow atlas offscreen operation, every additional shadowed light renders into its tiles.
+        Culling::CullingOperation m_cullingOperation;  // culls every instance on the GPU into the indirect draw streams of the scene and shadow passes.
+        BoundingVolumeHierarchy::CullingScene m_cpuCullingScene;  // culls every instance on the CPU instead, if GPU culling is disabled or unsupported.
+        bool m_gpuCullingEnabled;
+        DepthPyramid::DepthPyramidOperation m_depthPyramidOperation;  // reduces the early main pass's depth, the scene instances are culled against it before the late main pass.
+        bool m_occlusionCullingEnabled;  // only with GPU culling.
+        MaskedOcclusion::OcclusionBuffer m_occlusionBuffer;  // the main mesh's occluder is rasterized into it on the CPU, the CPU culled scene instances are tested against it.
+        MaskedOcclusion::OccluderMesh m_mainOccluderMesh;
+        bool m_maskedOcclusionEnabled;  // only with CPU culling.
+        ShadowAtlas::QuadtreeAllocator m_shadowAtlasAllocator;  // allocates the shadow atlas tiles every frame.
+        LightClustering::ClusteringOperation m_lightClusteringOperation;  // bins the scene lights into the clusters of the camera frustum, read by the scene pipeline.
+        PostProcessing::PostProcessingOperation m_postProcessingOperation;  // builds the bloom and adapts the exposure from the HDR scene color, applied in the presentation passes.
+        AntiAliasing::AntiAliasingOperation m_antiAliasingOperation;  // filters the single-sampled scene color into the swapchain image.
+        std::string m_antiAliasingMode;  // the current anti-aliasing mode(see AntiAliasing::antiAliasingModes), cycled at runtime.
+        bool m_sampleShadingEnabled;  // the multisampled scene pipelines shade per sample, toggled at runtime.
+        TemporalAntiAliasing::TemporalOperation m_temporalOperation;  // resolves the jittered scene color with its history into the swapchain image, with TAA.
+        DynamicResolution::ResolutionController m_resolutionController;  // scales the rendered region of the scene images to hold the target frame time, only applied with TAA.
+        PerformanceGovernor::QualityGovernor m_qualityGovernor;  // steps the quality knobs down while the frame is over the target frame time, and back up with headroom.
+        float m_cpuFrameTime = 0.0f;  // the CPU time of the previous frame's recording and submission in milliseconds.
+        double m_previousFrameStartTime = 0.0;  // the start of the previous frame's recording in seconds, the exposure adapts over the time between frames.
+        uint32_t m_temporalFrameIndex = 0;  // selects the frame's projection jitter.
+        glm::mat4 m_previousCameraMatrix = glm::mat4(1.0f);  // the previous frame's unjittered projection * view matrix, reprojects the history.
+        glm::mat4 m_previousMainMeshModelMatrix = glm::mat4(1.0f);
+
+        VkRenderPass m_renderPass;  // the main render pass, split around occlusion culling into an early and a late render pass(without occlusion culling only the early render pass is used).
+        VkRenderPass m_lateRenderPass;  // null without occlusion culling, loads the main render pass's attachments and resolves them for the anti-aliasing passes, compatible with the main render pass's framebuffers.
 
-        VkRenderPass m_renderPass;  // we only need a singular render pass.
+        RenderGraph::Graph m_renderGraph;  // the frame's passes and the resources they access, used to record the barriers between passes.
 
         std::vector<VkSemaphore> m_imageAvailibleSemaphores;  // semaphore used to make the GPU wait to continue until the next availible image index in the swapchain has been fetched.
         std::vector<VkSemaphore> m_renderFinishedSemaphores;  // semaphore used to make the GPU wait to continue until the current frame has finished rendering.
@@ -138,6 +222,9 @@ namespace RendererDetails
 
         uint32_t m_currentFrame = 0;  // the current "frame" in context of the "in flight" frames.
 
+        std::vector<uint32_t> m_shadowViewDrawCounts;  // the last reported shadow caster draw count of each shadow view.
+        uint32_t m_occludedInstanceCount = 0;  // the last reported amount of instances culled by occlusion culling.
+
         Camera::ArcballCamera m_mainCamera;  // the scene's main camera.
         ModelHandler::Model m_mainModel;  // the main loaded model.
         ModelHandler::Model m_dummySceneNormalsModel;  // a "dummy" scene normals model used to populate the scene normals shader buffer components.
@@ -146,31 +233,81 @@ namespace RendererDetails
         ModelHandler::Model m_dummyPointShadowModel;  // a "dummy" model used to populate the point shadow shader buffer components.
 
 
-        // create member render pass for all pipelines.
+        // select the amount of msaa samples of the current anti-aliasing mode, clamped to the samples supported by the device and the G-buffer.
+        //
+        // @param vulkanPhysicalDevice Vulkan physical device to use in sample count selection.
+        // @param msaaSampleCount the selected amount of msaa samples.
+        void selectMemberSampleCount(VkPhysicalDevice vulkanPhysicalDevice, VkSampleCountFlagBits& msaaSampleCount);
+
+        // create member render passes for all pipelines, the early(clearing) and late(resolving) main render pass.
         //
-        // @param swapchainImageFormat the swapchain image format to use in member scene render pass creation.
+        // @param colorImageFormat the scene color image format to use in member scene render pass creation.
         // @param msaaSampleCount the amount of msaa samples.
         // @param vulkanPhysicalDevice Vulkan physical device to use in member scene render pass creation.
-        void createMemberRenderPass(VkFormat swapchainImageFormat, VkSampleCountFlagBits msaaSampleCount, VkPhysicalDevice vulkanPhysicalDevice);
+        void createMemberRenderPass(VkFormat colorImageFormat, VkSampleCountFlagBits msaaSampleCount, VkPhysicalDevice vulkanPhysicalDevice);
 
         // create member cubemap pipeline.
         //
         // @param msaaSampleCount the amount of msaa samples.
         void createMemberCubemapPipeline(VkSampleCountFlagBits msaaSampleCount);
     
-        // create member scene pipeline.
+        // create member scene pipeline, or the alpha-masked scene pipeline compatible with the scene pipeline's descriptor sets.
         //
         // @param msaaSampleCount the amount of msaa samples.
-        void createMemberScenePipeline(VkSampleCountFlagBits msaaSampleCount);
+        // @param alphaMasked if the alpha-masked scene pipeline is created, alpha-to-coverage is used under msaa.
+        void createMemberScenePipeline(VkSampleCountFlagBits msaaSampleCount, bool alphaMasked);
 
         // create member scene normals pipeline.
         //
         // @param msaaSampleCount the amount of msaa samples.
         void createMemberSceneNormalsPipeline(VkSampleCountFlagBits msaaSampleCount);
+
+        // create member depth prepass pipeline, compatible with the scene pipeline's descriptor sets.
+        //
+        // @param msaaSampleCount the amount of msaa samples.
+        void createMemberDepthPrepassPipeline(VkSampleCountFlagBits msaaSampleCount);
+        
+        // create member deferred lighting pipeline in the lighting subpass, compatible with the scene pipeline's descriptor sets.
+        //
+        // @param msaaSampleCount the amount of msaa samples.
+        void createMemberDeferredLightingPipeline(VkSampleCountFlagBits msaaSampleCount);
+
+        // point the scene descriptor sets' input attachments at the G-buffer and depth images, after they are (re)created.
+        //
+        // @param displayDetails the display details containing the G-buffer and depth images.
+        void populateMemberGBufferDescriptors(DisplayManager::DisplayDetails& displayDetails);
+        
+        // create and compile the member render graph.
+        //
+        // @param displayDetails the display details containing the swapchain images.
+        void createMemberRenderGraph(DisplayManager::DisplayDetails& displayDetails);
         
+        // recreate the swapchain and every component following the scene images(ex: after a resize, or a sample count change).
+        //
+        // @param displayDetails the display details to recreate the swapchain and scene images of.
+        // @param vulkanPhysicalDevice the Vulkan instance's physical device.
+        void recreateMemberSwapchain(DisplayManager::DisplayDetails& displayDetails, VkPhysicalDevice vulkanPhysicalDevice);
+
+        // apply the anti-aliasing changes requested at runtime(see Callbacks::glfwKeyCallback), recreating the multisampled components if the sample count or sample shading changed.
+        //
+        // @param displayDetails the display details containing the scene images.
+        // @param vulkanPhysicalDevice the Vulkan instance's physical device.
+        void applyMemberAntiAliasing(DisplayManager::DisplayDetails& displayDetails, VkPhysicalDevice vulkanPhysicalDevice);
+
         // create member synchronization objects(semaphores, fences).
         void createMemberSynchronizationObjects();
 
+        // report the shadow caster draws left after culling in each shadow view, only when changed.
+        //
+        // @param directionalShadowCascadeCasterMasks the casters drawn in each directional shadow cascade.
+        // @param pointShadowFaceCasterMasks the casters drawn in each point shadow cubemap face.
+        void reportShadowDraws(const std::vector<uint32_t>& directionalShadowCascadeCasterMasks, const std::vector<uint32_t>& pointShadowFaceCasterMasks);
+
+        // report the amount of instances culled by occlusion culling, only when changed.
+        //
+        // @param occludedInstanceCount the amount of occluded instances.
+        void reportOccludedInstances(uint32_t occludedInstanceCount);
+
         // draw a frame onto the screen using all of the configured render passes, pipelines, etc.
         //
         // @param currentFrame current swapchain frame to draw.
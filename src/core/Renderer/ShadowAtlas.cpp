@@ -0,0 +1,111 @@
+#include <core/Renderer/ShadowAtlas.h>
+#include <utils/MathUtils.h>
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+
+void ShadowAtlas::QuadtreeAllocator::resetAllocator(uint32_t atlasSize, uint32_t minimumTileSize)
+{
+    this->atlasSize = MathUtils::floorPowerOfTwo(atlasSize);
+    this->minimumTileSize = std::min(MathUtils::floorPowerOfTwo(minimumTileSize), this->atlasSize);
+
+    this->nodes.clear();  // keeps the capacity between frames.
+    this->nodes.push_back({{0, 0, this->atlasSize}, ShadowAtlas::NodeState::FREE, 0});
+}
+
+bool ShadowAtlas::QuadtreeAllocator::allocateTile(uint32_t requestedTileSize, ShadowAtlas::AtlasTile& allocatedTile)
+{
+    uint32_t tileSize = std::clamp(MathUtils::floorPowerOfTwo(requestedTileSize), this->minimumTileSize, this->atlasSize);
+    while (tileSize >= this->minimumTileSize) {  // a smaller shadow is preferred over no shadow.
+        if (this->allocateNodeTile(0, tileSize, allocatedTile) == true) {
+            return true;
+        }
+
+        tileSize /= 2;
+    }
+
+    return false;
+}
+
+void ShadowAtlas::QuadtreeAllocator::freeTile(const ShadowAtlas::AtlasTile& allocatedTile)
+{
+    this->freeNodeTile(0, allocatedTile);
+}
+
+bool ShadowAtlas::QuadtreeAllocator::allocateNodeTile(uint32_t nodeIndex, uint32_t tileSize, ShadowAtlas::AtlasTile& allocatedTile)
+{
+    // nodes are referenced by index, splitting grows the node vector.
+    ShadowAtlas::QuadtreeNode node = this->nodes[nodeIndex];
+    if ((node.nodeState == ShadowAtlas::NodeState::ALLOCATED) || (node.nodeTile.tileSize < tileSize)) {
+        return false;
+    }
+
+    if (node.nodeTile.tileSize == tileSize) {
+        if (node.nodeState != ShadowAtlas::NodeState::FREE) {  // a split node of the requested size is partially allocated.
+            return false;
+        }
+
+        this->nodes[nodeIndex].nodeState = ShadowAtlas::NodeState::ALLOCATED;
+        allocatedTile = node.nodeTile;
+        return true;
+    }
+
+    if ((node.nodeState == ShadowAtlas::NodeState::FREE) && (node.firstChildIndex == 0)) {
+        uint32_t childTileSize = (node.nodeTile.tileSize / 2);
+        uint32_t firstChildIndex = static_cast<uint32_t>(this->nodes.size());
+        for (uint32_t i = 0; i < 4; i += 1) {
+            ShadowAtlas::AtlasTile childTile = {(node.nodeTile.offsetX + ((i % 2) * childTileSize)), (node.nodeTile.offsetY + ((i / 2) * childTileSize)), childTileSize};
+            this->nodes.push_back({childTile, ShadowAtlas::NodeState::FREE, 0});
+        }
+
+        this->nodes[nodeIndex].firstChildIndex = firstChildIndex;
+    }
+    this->nodes[nodeIndex].nodeState = ShadowAtlas::NodeState::SPLIT;  // a merged node's children are all free, and are split again in place.
+
+    // children are searched in order, packing tiles into already split nodes before splitting free ones.
+    uint32_t firstChildIndex = this->nodes[nodeIndex].firstChildIndex;
+    for (uint32_t i = 0; i < 4; i += 1) {
+        if (this->allocateNodeTile((firstChildIndex + i), tileSize, allocatedTile) == true) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void ShadowAtlas::QuadtreeAllocator::freeNodeTile(uint32_t nodeIndex, const ShadowAtlas::AtlasTile& allocatedTile)
+{
+    ShadowAtlas::QuadtreeNode& node = this->nodes[nodeIndex];  // freeing never grows the node vector.
+    if (node.nodeTile.tileSize == allocatedTile.tileSize) {
+        if (node.nodeState == ShadowAtlas::NodeState::ALLOCATED) {
+            node.nodeState = ShadowAtlas::NodeState::FREE;
+        }
+        return;
+    }
+    if (node.nodeState != ShadowAtlas::NodeState::SPLIT) {
+        return;
+    }
+
+    // the child quadrant holding the tile, children are ordered row by row.
+    uint32_t childTileSize = (node.nodeTile.tileSize / 2);
+    uint32_t childIndex = (((allocatedTile.offsetX >= (node.nodeTile.offsetX + childTileSize)) ? 1 : 0) + ((allocatedTile.offsetY >= (node.nodeTile.offsetY + childTileSize)) ? 2 : 0));
+    this->freeNodeTile((node.firstChildIndex + childIndex), allocatedTile);
+
+    bool childrenFree = true;
+    for (uint32_t i = 0; i < 4; i += 1) {
+        childrenFree = (childrenFree && (this->nodes[node.firstChildIndex + i].nodeState == ShadowAtlas::NodeState::FREE));
+    }
+    if (childrenFree == true) {
+        node.nodeState = ShadowAtlas::NodeState::FREE;
+    }
+}
+
+uint32_t ShadowAtlas::calculateTileSize(float screenCoverage, float lightImportance, uint32_t maximumTileSize, uint32_t minimumTileSize)
+{
+    float tileWeight = std::clamp((screenCoverage * lightImportance), 0.0f, 1.0f);
+    uint32_t tileSize = static_cast<uint32_t>(tileWeight * static_cast<float>(maximumTileSize));
+
+    return std::clamp(MathUtils::floorPowerOfTwo(tileSize), MathUtils::floorPowerOfTwo(minimumTileSize), MathUtils::floorPowerOfTwo(maximumTileSize));
+}
@@ -0,0 +1,81 @@
+#ifndef SHADOWATLAS_H
+#define SHADOWATLAS_H
+
+
+#include <vector>
+#include <cstdint>
+
+
+namespace ShadowAtlas
+{
+    struct AtlasTile {  // a square region of the shadow atlas, in texels.
+        uint32_t offsetX;
+        uint32_t offsetY;
+        uint32_t tileSize;
+    };
+
+    enum class NodeState {
+        FREE,
+        SPLIT,  // subdivided into four child nodes.
+        ALLOCATED
+    };
+
+    struct QuadtreeNode {
+        ShadowAtlas::AtlasTile nodeTile;
+        ShadowAtlas::NodeState nodeState;
+        uint32_t firstChildIndex;  // the four children are stored consecutively, 0 until the node is first split(merged nodes keep their free children).
+    };
+
+    struct QuadtreeAllocator {  // allocates power of two tiles of a square shadow atlas, rebuilt every frame.
+        uint32_t atlasSize;  // the width and height of the atlas, rounded down to a power of two.
+        uint32_t minimumTileSize;
+
+        std::vector<ShadowAtlas::QuadtreeNode> nodes;  // the root node is at index 0.
+
+
+        // free every allocated tile.
+        //
+        // @param atlasSize the width and height of the atlas.
+        // @param minimumTileSize the smallest tile that can be allocated.
+        void resetAllocator(uint32_t atlasSize, uint32_t minimumTileSize);
+
+        // allocate a tile, halving the requested size until a free tile is found.
+        //
+        // @param requestedTileSize the preferred tile size, rounded down to a power of two.
+        // @param allocatedTile the allocated tile.
+        // @return if a tile no smaller than the minimum tile size was allocated.
+        bool allocateTile(uint32_t requestedTileSize, ShadowAtlas::AtlasTile& allocatedTile);
+
+        // free an allocated tile, merging split nodes whose children are all free again.
+        //
+        // @param allocatedTile a tile allocated by the allocator since its last reset.
+        void freeTile(const ShadowAtlas::AtlasTile& allocatedTile);
+
+        // allocate a tile of an exact size within a node's subtree, splitting free nodes as needed.
+        //
+        // @param nodeIndex the index of the subtree's root node.
+        // @param tileSize the power of two tile size.
+        // @param allocatedTile the allocated tile.
+        // @return if a tile was allocated.
+        bool allocateNodeTile(uint32_t nodeIndex, uint32_t tileSize, ShadowAtlas::AtlasTile& allocatedTile);
+
+        // free an allocated tile within a node's subtree, merging the node if its children are all free again.
+        //
+        // @param nodeIndex the index of the subtree's root node.
+        // @param allocatedTile the allocated tile, within the node's tile.
+        void freeNodeTile(uint32_t nodeIndex, const ShadowAtlas::AtlasTile& allocatedTile);
+    };
+
+
+    // calculate the tile size a light gets from its share of the screen and its importance.
+    //
+    // @param screenCoverage the fraction(0..1) of the screen height the light's range covers.
+    // @param lightImportance the light's importance(ex: intensity), 1.0 keeps the coverage's size.
+    // @param maximumTileSize the largest tile a light can get.
+    // @param minimumTileSize the smallest tile a light can get.
+    // @return the power of two tile size.
+    uint32_t calculateTileSize(float screenCoverage, float lightImportance, uint32_t maximumTileSize, uint32_t minimumTileSize);
+}
+
+
+#endif  // SHADOWATLAS_H
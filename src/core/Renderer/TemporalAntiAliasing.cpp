@@ -0,0 +1,530 @@
+#define GLFW_INCLUDE_VULKAN
+#include <GLFW/glfw3.h>
+
+#include <core/Renderer/TemporalAntiAliasing.h>
+#include <core/Shader/Uniform.h>
+#include <core/Model/ModelHandler.h>
+#include <core/Shader/Image.h>
+#include <core/Shader/ResourceDescriptor.h>
+#include <core/Command/CommandManager.h>
+#include <core/DisplayManager/SwapchainHandler.h>
+#include <core/Logging/ErrorLogger.h>
+#include <core/Defaults/Defaults.h>
+
+#include <string>
+#include <vector>
+#include <array>
+#include <functional>
+
+
+// create a render pass for a fullscreen temporal pass, every written pixel is overwritten.
+//
+// @param attachmentFormats the format of each color attachment.
+// @param vulkanLogicalDevice Vulkan logical device to use in temporal render pass creation.
+// @param renderPass created temporal render pass.
+static void createTemporalRenderPass(const std::vector<VkFormat>& attachmentFormats, VkDevice vulkanLogicalDevice, VkRenderPass& renderPass)
+{
+    std::vector<VkAttachmentDescription> colorAttachmentDescriptions(attachmentFormats.size());
+    std::vector<VkAttachmentReference> colorAttachmentReferences(attachmentFormats.size());
+    for (size_t i = 0; i < attachmentFormats.size(); i += 1) {
+        colorAttachmentDescriptions[i].format = attachmentFormats[i];
+        colorAttachmentDescriptions[i].samples = VK_SAMPLE_COUNT_1_BIT;
+
+        colorAttachmentDescriptions[i].loadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+        colorAttachmentDescriptions[i].storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+        colorAttachmentDescriptions[i].stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+        colorAttachmentDescriptions[i].stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+
+        // layout transitions(ex: to presentation) are recorded by the render graph.
+        colorAttachmentDescriptions[i].initialLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+        colorAttachmentDescriptions[i].finalLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+        colorAttachmentReferences[i].attachment = static_cast<uint32_t>(i);
+        colorAttachmentReferences[i].layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+    }
+
+
+    VkSubpassDescription subpassDescription{};
+    subpassDescription.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+
+    subpassDescription.colorAttachmentCount = static_cast<uint32_t>(colorAttachmentReferences.size());
+    subpassDescription.pColorAttachments = colorAttachmentReferences.data();
+
+
+    VkRenderPassCreateInfo renderPassCreateInfo{};
+    renderPassCreateInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+
+    renderPassCreateInfo.attachmentCount = static_cast<uint32_t>(colorAttachmentDescriptions.size());
+    renderPassCreateInfo.pAttachments = colorAttachmentDescriptions.data();
+
+    renderPassCreateInfo.subpassCount = 1;
+    renderPassCreateInfo.pSubpasses = &subpassDescription;
+
+    renderPassCreateInfo.dependencyCount = 0;  // the dependencies on the previous passes are recorded as barriers by the render graph.
+
+    VkResult renderPassCreationResult = vkCreateRenderPass(vulkanLogicalDevice, &renderPassCreateInfo, nullptr, &renderPass);
+    if (renderPassCreationResult != VK_SUCCESS) {
+        throwDebugException("Failed to create a temporal anti-aliasing render pass.");
+    }
+}
+
+// create a fullscreen temporal pipeline, reading its images through the pipeline components' descriptor set layout.
+//
+// @param fragmentShaderName the name of the fragment shader's bytecode in the build directory.
+// @param colorAttachmentCount the amount of color attachments written by the fragment shader.
+// @param pushConstantSize the size of the fragment shader's push constant, 0 without a push constant.
+// @param renderPass render pass to use in temporal pipeline creation.
+// @param vulkanLogicalDevice Vulkan logical device to use in temporal pipeline creation.
+// @param pipelineComponents reference to the pipeline components to use and create the pipeline in.
+static void createTemporalPipeline(std::string fragmentShaderName, uint32_t colorAttachmentCount, uint32_t pushConstantSize, VkRenderPass renderPass, VkDevice vulkanLogicalDevice, Pipeline::PipelineComponents& pipelineComponents)
+{
+    Pipeline::PipelineData temporalPipelineData;
+
+    temporalPipelineData.vulkanLogicalDevice = vulkanLogicalDevice;
+
+    // the deferred lighting's fullscreen triangle, the fragment shaders derive their texture coordinates from the fragment coordinates.
+    temporalPipelineData.vertexShaderBytecodeAbsolutePath = (Defaults::applicationDefaults.SALAMANDER_ROOT_DIRECTORY + "/build/deferredLightingVertex.spv");
+    temporalPipelineData.geometryShaderBytecodeAbsolutePath = "*NA*";
+    temporalPipelineData.fragmentShaderBytecodeAbsolutePath = (Defaults::applicationDefaults.SALAMANDER_ROOT_DIRECTORY + "/build/" + fragmentShaderName);
+
+    temporalPipelineData.vertexDataStride = 0;
+    temporalPipelineData.fetchAttributeDescriptions = [](std::vector<VkVertexInputAttributeDescription>& attributeDescriptions) { attributeDescriptions.clear(); };
+
+    temporalPipelineData.inputAssemblyTopology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+    temporalPipelineData.inputAssemblyPrimitiveRestartEnable = VK_FALSE;
+
+    temporalPipelineData.viewportViewportCount = 1;
+    temporalPipelineData.viewportScissorCount = 1;
+
+    temporalPipelineData.rasterizationCullMode = VK_CULL_MODE_NONE;
+    temporalPipelineData.rasterizationFrontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+
+    temporalPipelineData.multisamplingRasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+    temporalPipelineData.multisamplingMinSampleShading = 0.0f;
+
+    temporalPipelineData.depthStencilDepthTestEnable = VK_FALSE;
+    temporalPipelineData.depthStencilDepthWriteEnable = VK_FALSE;
+    temporalPipelineData.depthStencilDepthCompareOp = VK_COMPARE_OP_ALWAYS;
+
+    temporalPipelineData.colorBlendColorWriteMask = (VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT);
+    temporalPipelineData.colorBlendBlendEnable = VK_FALSE;
+    temporalPipelineData.colorBlendAttachmentCount = colorAttachmentCount;
+
+    temporalPipelineData.dynamicStatesDynamicStates = {VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR};  // the motion vectors are only written in the rendered region.
+
+    temporalPipelineData.pipelineRenderPass = renderPass;
+
+    VkPushConstantRange temporalPushConstant{};
+    if (pushConstantSize > 0) {
+        Uniform::populatePushConstant(0, pushConstantSize, VK_SHADER_STAGE_FRAGMENT_BIT, temporalPushConstant);
+        temporalPipelineData.pushConstant = &temporalPushConstant;
+    }
+
+
+    pipelineComponents.createMemberPipeline(temporalPipelineData);
+}
+
+// create the motion vectors geometry pipeline, drawing the scene's instances in the motion vectors render pass.
+//
+// the instances are tested against the sampled scene depth in the fragment shader, the render pass has no depth attachment.
+//
+// @param renderPass the motion vectors render pass.
+// @param vulkanLogicalDevice Vulkan logical device to use in pipeline creation.
+// @param pipelineComponents reference to the pipeline components to use and create the pipeline in, with the motion vectors descriptor set layout.
+static void createMotionVectorsGeometryPipeline(VkRenderPass renderPass, VkDevice vulkanLogicalDevice, Pipeline::PipelineComponents& pipelineComponents)
+{
+    Pipeline::PipelineData geometryPipelineData;
+
+    geometryPipelineData.vulkanLogicalDevice = vulkanLogicalDevice;
+
+    geometryPipelineData.vertexShaderBytecodeAbsolutePath = (Defaults::applicationDefaults.SALAMANDER_ROOT_DIRECTORY + "/build/motionVectorsGeometryVertex.spv");
+    geometryPipelineData.geometryShaderBytecodeAbsolutePath = "*NA*";
+    geometryPipelineData.fragmentShaderBytecodeAbsolutePath = (Defaults::applicationDefaults.SALAMANDER_ROOT_DIRECTORY + "/build/motionVectorsGeometryFragment.spv");
+
+    // uses the same position-only vertex data as the depth prepass.
+    geometryPipelineData.vertexDataStride = sizeof(ModelHandler::ShadowVertexData);
+    geometryPipelineData.fetchAttributeDescriptions = ResourceDescriptor::fetchShadowAttributeDescriptions;
+
+    geometryPipelineData.inputAssemblyTopology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+    geometryPipelineData.inputAssemblyPrimitiveRestartEnable = VK_FALSE;
+
+    geometryPipelineData.viewportViewportCount = 1;
+    geometryPipelineData.viewportScissorCount = 1;
+
+    geometryPipelineData.rasterizationCullMode = VK_CULL_MODE_BACK_BIT;  // identical to the scene pipeline.
+    geometryPipelineData.rasterizationFrontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+
+    geometryPipelineData.multisamplingRasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+    geometryPipelineData.multisamplingMinSampleShading = 0.0f;
+
+    geometryPipelineData.depthStencilDepthTestEnable = VK_FALSE;
+    geometryPipelineData.depthStencilDepthWriteEnable = VK_FALSE;
+    geometryPipelineData.depthStencilDepthCompareOp = VK_COMPARE_OP_ALWAYS;
+
+    geometryPipelineData.colorBlendColorWriteMask = (VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT);
+    geometryPipelineData.colorBlendBlendEnable = VK_FALSE;
+    geometryPipelineData.colorBlendAttachmentCount = 1;
+
+    geometryPipelineData.dynamicStatesDynamicStates = {VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR};
+
+    geometryPipelineData.pipelineRenderPass = renderPass;
+
+
+    pipelineComponents.createMemberPipeline(geometryPipelineData);
+}
+
+// calculate an element of a Halton sequence, the radical inverse of the index in the base.
+//
+// @param index the index of the element, starting at 1.
+// @param base the base of the sequence.
+static float calculateHaltonElement(uint32_t index, uint32_t base)
+{
+    float element = 0.0f;
+    float digitWeight = 1.0f;
+    while (index > 0) {
+        digitWeight /= static_cast<float>(base);
+        element += (digitWeight * static_cast<float>(index % base));
+        index /= base;
+    }
+
+    return element;
+}
+
+void TemporalAntiAliasing::fetchProjectionJitter(uint32_t frameIndex, glm::vec2& projectionJitter)
+{
+    uint32_t jitterPhase = ((frameIndex % TemporalAntiAliasing::jitterPhaseCount) + 1);  // the sequence's first element is 0 on both axes.
+    projectionJitter = (glm::vec2(calculateHaltonElement(jitterPhase, 2), calculateHaltonElement(jitterPhase, 3)) - 0.5f);
+}
+
+void TemporalAntiAliasing::TemporalOperation::generateMemberComponents(VkFormat swapchainImageFormat, DeviceHandler::VulkanDevices vulkanDevices)
+{
+    this->historyWriteIndex = 0;
+    this->historyValid = false;
+
+
+    createTemporalRenderPass({TemporalAntiAliasing::motionVectorsImageFormat}, vulkanDevices.logicalDevice, this->motionVectorsRenderPass);
+    createTemporalRenderPass({swapchainImageFormat, TemporalAntiAliasing::historyImageFormat}, vulkanDevices.logicalDevice, this->resolveRenderPass);
+
+
+    VkDescriptorSetLayoutBinding temporalUniformBufferLayoutBinding{};
+    ResourceDescriptor::populateDescriptorSetLayoutBinding(0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, (VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT), temporalUniformBufferLayoutBinding);
+
+    VkDescriptorSetLayoutBinding motionVectorsDepthLayoutBinding{};
+    ResourceDescriptor::populateDescriptorSetLayoutBinding(1, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_FRAGMENT_BIT, motionVectorsDepthLayoutBinding);
+
+    VkDescriptorSetLayoutBinding motionVectorsInstanceLayoutBinding{};
+    ResourceDescriptor::populateDescriptorSetLayoutBinding(2, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_VERTEX_BIT, motionVectorsInstanceLayoutBinding);
+
+    std::vector<VkDescriptorSetLayoutBinding> motionVectorsDescriptorSetLayoutBindings = {temporalUniformBufferLayoutBinding, motionVectorsDepthLayoutBinding, motionVectorsInstanceLayoutBinding};
+    ResourceDescriptor::createDescriptorSetLayout(motionVectorsDescriptorSetLayoutBindings, vulkanDevices.logicalDevice, this->motionVectorsPipelineComponents.descriptorSetLayout);
+
+    createTemporalPipeline("motionVectorsFragment.spv", 1, 0, this->motionVectorsRenderPass, vulkanDevices.logicalDevice, this->motionVectorsPipelineComponents);
+
+    // the instances are drawn after the fullscreen triangle in the same render pass, compatible pipeline layouts keep the bound descriptor set.
+    this->motionVectorsGeometryPipelineComponents.descriptorSetLayout = this->motionVectorsPipelineComponents.descriptorSetLayout;
+    createMotionVectorsGeometryPipeline(this->motionVectorsRenderPass, vulkanDevices.logicalDevice, this->motionVectorsGeometryPipelineComponents);
+
+    // the reprojection matrices change every frame, each frame in flight has its own uniform buffer.
+    Uniform::createUniformBuffers(sizeof(Uniform::TemporalUniformBufferObject), vulkanDevices, this->motionVectorsPipelineComponents.uniformBuffers, this->motionVectorsPipelineComponents.uniformBuffersMemory, this->motionVectorsPipelineComponents.mappedUniformBuffersMemory);
+    ResourceDescriptor::createDescriptorPool(1, 1, 0, vulkanDevices.logicalDevice, this->motionVectorsPipelineComponents.descriptorPool);
+    ResourceDescriptor::createDescriptorSets(this->motionVectorsPipelineComponents.descriptorSetLayout, this->motionVectorsPipelineComponents.descriptorPool, vulkanDevices.logicalDevice, this->motionVectorsPipelineComponents.descriptorSets);
+
+
+    // scene color, motion vectors, depth, history, and bloom, followed by the exposure buffer.
+    std::vector<VkDescriptorSetLayoutBinding> resolveDescriptorSetLayoutBindings(6);
+    for (size_t i = 0; i < (resolveDescriptorSetLayoutBindings.size() - 1); i += 1) {
+        ResourceDescriptor::populateDescriptorSetLayoutBinding(static_cast<uint32_t>(i), VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_FRAGMENT_BIT, resolveDescriptorSetLayoutBindings[i]);
+    }
+    ResourceDescriptor::populateDescriptorSetLayoutBinding(5, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_FRAGMENT_BIT, resolveDescriptorSetLayoutBindings.back());
+    ResourceDescriptor::createDescriptorSetLayout(resolveDescriptorSetLayoutBindings, vulkanDevices.logicalDevice, this->pipelineComponents.descriptorSetLayout);
+
+    createTemporalPipeline("temporalResolveFragment.spv", 2, sizeof(TemporalAntiAliasing::ResolvePushConstant), this->resolveRenderPass, vulkanDevices.logicalDevice, this->pipelineComponents);
+
+
+    VkSamplerCreateInfo samplerCreateInfo{};
+    samplerCreateInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+
+    samplerCreateInfo.minFilter = VK_FILTER_LINEAR;  // the scene color is upsampled and the history is reprojected between texels.
+    samplerCreateInfo.magFilter = VK_FILTER_LINEAR;
+
+    samplerCreateInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerCreateInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerCreateInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+
+    samplerCreateInfo.anisotropyEnable = VK_FALSE;
+    samplerCreateInfo.maxAnisotropy = 1.0f;
+
+    samplerCreateInfo.borderColor = VK_BORDER_COLOR_FLOAT_OPAQUE_BLACK;
+    samplerCreateInfo.unnormalizedCoordinates = VK_FALSE;
+
+    samplerCreateInfo.compareEnable = VK_FALSE;
+    samplerCreateInfo.compareOp = VK_COMPARE_OP_ALWAYS;
+
+    samplerCreateInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+    samplerCreateInfo.mipLodBias = 0.0f;
+    samplerCreateInfo.minLod = 0.0f;
+    samplerCreateInfo.maxLod = 0.0f;
+
+    VkResult linearSamplerCreationResult = vkCreateSampler(vulkanDevices.logicalDevice, &samplerCreateInfo, nullptr, &this->linearSampler);
+    if (linearSamplerCreationResult != VK_SUCCESS) {
+        throwDebugException("Failed to create the temporal anti-aliasing sampler.");
+    }
+    Image::createShadowSampler(VK_FILTER_NEAREST, VK_FALSE, vulkanDevices.logicalDevice, this->depthSampler);  // the depth and motion vectors are only fetched.
+
+
+    // a descriptor set for each history image read, the temporal images are only rewritten while the device is idle.
+    VkDescriptorPoolSize combinedSamplerPoolSize{};
+    ResourceDescriptor::populateDescriptorPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, static_cast<uint32_t>((resolveDescriptorSetLayoutBindings.size() - 1) * 2), combinedSamplerPoolSize);
+    VkDescriptorPoolSize storageBufferPoolSize{};
+    ResourceDescriptor::populateDescriptorPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 2, storageBufferPoolSize);
+    VkDescriptorPoolSize descriptorPoolSizes[] = {combinedSamplerPoolSize, storageBufferPoolSize};
+
+    VkDescriptorPoolCreateInfo descriptorPoolCreateInfo{};
+    descriptorPoolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+
+    descriptorPoolCreateInfo.poolSizeCount = 2;
+    descriptorPoolCreateInfo.pPoolSizes = descriptorPoolSizes;
+
+    descriptorPoolCreateInfo.maxSets = 2;
+
+    VkResult descriptorPoolCreationResult = vkCreateDescriptorPool(vulkanDevices.logicalDevice, &descriptorPoolCreateInfo, nullptr, &this->pipelineComponents.descriptorPool);
+    if (descriptorPoolCreationResult != VK_SUCCESS) {
+        throwDebugException("Failed to create the temporal resolve descriptor pool.");
+    }
+
+    std::array<VkDescriptorSetLayout, 2> resolveDescriptorSetLayouts = {this->pipelineComponents.descriptorSetLayout, this->pipelineComponents.descriptorSetLayout};
+
+    VkDescriptorSetAllocateInfo descriptorSetAllocateInfo{};
+    descriptorSetAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+
+    descriptorSetAllocateInfo.descriptorPool = this->pipelineComponents.descriptorPool;
+
+    descriptorSetAllocateInfo.descriptorSetCount = static_cast<uint32_t>(resolveDescriptorSetLayouts.size());
+    descriptorSetAllocateInfo.pSetLayouts = resolveDescriptorSetLayouts.data();
+
+    this->pipelineComponents.descriptorSets.resize(resolveDescriptorSetLayouts.size());
+    VkResult descriptorSetAllocationResult = vkAllocateDescriptorSets(vulkanDevices.logicalDevice, &descriptorSetAllocateInfo, this->pipelineComponents.descriptorSets.data());
+    if (descriptorSetAllocationResult != VK_SUCCESS) {
+        throwDebugException("Failed to allocate the temporal resolve descriptor sets.");
+    }
+}
+
+void TemporalAntiAliasing::TemporalOperation::generateTemporalImages(VkImageView sceneColorImageView, VkImageView depthImageView, VkImageView bloomImageView, VkBuffer exposureBuffer, const std::vector<VkImageView>& swapchainImageViews, VkExtent2D sceneExtent, VkCommandPool commandPool, VkQueue commandQueue, DeviceHandler::VulkanDevices vulkanDevices)
+{
+    this->sceneExtent = sceneExtent;
+
+    Image::populateImageDetails(sceneExtent.width, sceneExtent.height, 1, 1, VK_SAMPLE_COUNT_1_BIT, TemporalAntiAliasing::motionVectorsImageFormat, VK_IMAGE_TILING_OPTIMAL, (VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT), VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, vulkanDevices, this->motionVectorsImageDetails);
+    Image::createImageView(this->motionVectorsImageDetails.image, TemporalAntiAliasing::motionVectorsImageFormat, 1, 1, VK_IMAGE_ASPECT_COLOR_BIT, vulkanDevices.logicalDevice, this->motionVectorsImageDetails.imageView);
+
+    for (size_t i = 0; i < 2; i += 1) {
+        Image::populateImageDetails(sceneExtent.width, sceneExtent.height, 1, 1, VK_SAMPLE_COUNT_1_BIT, TemporalAntiAliasing::historyImageFormat, VK_IMAGE_TILING_OPTIMAL, (VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT), VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, vulkanDevices, this->historyImageDetails[i]);
+        Image::createImageView(this->historyImageDetails[i].image, TemporalAntiAliasing::historyImageFormat, 1, 1, VK_IMAGE_ASPECT_COLOR_BIT, vulkanDevices.logicalDevice, this->historyImageDetails[i].imageView);
+    }
+
+    // the render graph expects the read history image in a shader read-only layout, even before the first resolve wrote it.
+    VkCommandBuffer disposableCommandBuffer;
+    CommandManager::beginRecordingSingleSubmitCommands(commandPool, vulkanDevices.logicalDevice, disposableCommandBuffer);
+
+    std::array<VkImageMemoryBarrier, 2> historyMemoryBarriers{};
+    for (size_t i = 0; i < historyMemoryBarriers.size(); i += 1) {
+        historyMemoryBarriers[i].sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+
+        historyMemoryBarriers[i].srcAccessMask = 0;
+        historyMemoryBarriers[i].dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+        historyMemoryBarriers[i].oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        historyMemoryBarriers[i].newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+        historyMemoryBarriers[i].srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        historyMemoryBarriers[i].dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+
+        historyMemoryBarriers[i].image = this->historyImageDetails[i].image;
+        historyMemoryBarriers[i].subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        historyMemoryBarriers[i].subresourceRange.baseMipLevel = 0;
+        historyMemoryBarriers[i].subresourceRange.levelCount = 1;
+        historyMemoryBarriers[i].subresourceRange.baseArrayLayer = 0;
+        historyMemoryBarriers[i].subresourceRange.layerCount = 1;
+    }
+    vkCmdPipelineBarrier(disposableCommandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr, static_cast<uint32_t>(historyMemoryBarriers.size()), historyMemoryBarriers.data());
+
+    CommandManager::submitSingleSubmitCommands(disposableCommandBuffer, commandPool, commandQueue, vulkanDevices.logicalDevice);
+
+
+    VkFramebufferCreateInfo motionVectorsFramebufferCreateInfo{};
+    SwapchainHandler::populateFramebufferCreateInfo(this->motionVectorsRenderPass, &this->motionVectorsImageDetails.imageView, 1, sceneExtent.width, sceneExtent.height, motionVectorsFramebufferCreateInfo);
+    VkResult motionVectorsFramebufferCreationResult = vkCreateFramebuffer(vulkanDevices.logicalDevice, &motionVectorsFramebufferCreateInfo, nullptr, &this->motionVectorsFramebuffer);
+    if (motionVectorsFramebufferCreationResult != VK_SUCCESS) {
+        throwDebugException("Failed to create the motion vectors framebuffer.");
+    }
+
+    this->resolveFramebuffers.resize(swapchainImageViews.size() * 2);
+    for (size_t i = 0; i < this->resolveFramebuffers.size(); i += 1) {
+        std::array<VkImageView, 2> resolveAttachmentViews = {swapchainImageViews[i / 2], this->historyImageDetails[i % 2].imageView};
+
+        VkFramebufferCreateInfo resolveFramebufferCreateInfo{};
+        SwapchainHandler::populateFramebufferCreateInfo(this->resolveRenderPass, resolveAttachmentViews.data(), static_cast<uint32_t>(resolveAttachmentViews.size()), sceneExtent.width, sceneExtent.height, resolveFramebufferCreateInfo);
+        VkResult resolveFramebufferCreationResult = vkCreateFramebuffer(vulkanDevices.logicalDevice, &resolveFramebufferCreateInfo, nullptr, &this->resolveFramebuffers[i]);
+        if (resolveFramebufferCreationResult != VK_SUCCESS) {
+            throwDebugException("Failed to create the temporal resolve framebuffers.");
+        }
+    }
+
+
+    VkDescriptorImageInfo depthDescriptorImageInfo{};
+    ResourceDescriptor::populateDescriptorImageInfo(this->depthSampler, depthImageView, VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL, depthDescriptorImageInfo);
+    VkWriteDescriptorSet depthWriteDescriptorSet{};
+    ResourceDescriptor::populateWriteDescriptorSet(nullptr, 1, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, &depthDescriptorImageInfo, nullptr, depthWriteDescriptorSet);
+
+    std::vector<VkWriteDescriptorSet> motionVectorsWriteDescriptorSets = {depthWriteDescriptorSet};
+    ResourceDescriptor::populateDescriptorSets(this->motionVectorsPipelineComponents.uniformBuffers, motionVectorsWriteDescriptorSets, vulkanDevices.logicalDevice, this->motionVectorsPipelineComponents.descriptorSets);
+
+    VkDescriptorBufferInfo exposureDescriptorBufferInfo{};
+    ResourceDescriptor::populateDescriptorBufferInfo(exposureBuffer, 0, VK_WHOLE_SIZE, exposureDescriptorBufferInfo);
+
+    // each descriptor set reads one history image, the other is written in the same frame.
+    for (size_t i = 0; i < 2; i += 1) {
+        std::array<VkDescriptorImageInfo, 5> resolveDescriptorImageInfos{};
+        ResourceDescriptor::populateDescriptorImageInfo(this->linearSampler, sceneColorImageView, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, resolveDescriptorImageInfos[0]);
+        ResourceDescriptor::populateDescriptorImageInfo(this->depthSampler, this->motionVectorsImageDetails.imageView, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, resolveDescriptorImageInfos[1]);
+        ResourceDescriptor::populateDescriptorImageInfo(this->depthSampler, depthImageView, VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL, resolveDescriptorImageInfos[2]);
+        ResourceDescriptor::populateDescriptorImageInfo(this->linearSampler, this->historyImageDetails[i].imageView, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, resolveDescriptorImageInfos[3]);
+        ResourceDescriptor::populateDescriptorImageInfo(this->linearSampler, bloomImageView, VK_IMAGE_LAYOUT_GENERAL, resolveDescriptorImageInfos[4]);  // kept in the general layout by the post-processing passes.
+
+        std::array<VkWriteDescriptorSet, 6> resolveWriteDescriptorSets{};
+        for (size_t j = 0; j < resolveDescriptorImageInfos.size(); j += 1) {
+            ResourceDescriptor::populateWriteDescriptorSet(this->pipelineComponents.descriptorSets[i], static_cast<uint32_t>(j), VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, &resolveDescriptorImageInfos[j], nullptr, resolveWriteDescriptorSets[j]);
+        }
+        ResourceDescriptor::populateWriteDescriptorSet(this->pipelineComponents.descriptorSets[i], 5, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, nullptr, &exposureDescriptorBufferInfo, resolveWriteDescriptorSets.back());
+
+        vkUpdateDescriptorSets(vulkanDevices.logicalDevice, static_cast<uint32_t>(resolveWriteDescriptorSets.size()), resolveWriteDescriptorSets.data(), 0, nullptr);
+    }
+
+    this->resetHistory();  // the recreated history images hold nothing.
+}
+
+// record a fullscreen triangle in a temporal render pass.
+//
+// @param renderPass the temporal render pass.
+// @param framebuffer the framebuffer of the written images.
+// @param pipelineComponents the pipeline components of the temporal pipeline.
+// @param descriptorSet the bound descriptor set.
+// @param renderExtent the written region of the framebuffer.
+// @param pushConstant the fragment shader's push constant, nullptr without a push constant.
+// @param pushConstantSize the size of the push constant.
+// @param recordFollowingDraws records draws after the fullscreen triangle in the same render pass, nullptr without them.
+// @param commandBuffer the command buffer to record in.
+static void recordTemporalCommands(VkRenderPass renderPass, VkFramebuffer framebuffer, const Pipeline::PipelineComponents& pipelineComponents, VkDescriptorSet descriptorSet, VkExtent2D renderExtent, const void *pushConstant, uint32_t pushConstantSize, const std::function<void()>& recordFollowingDraws, VkCommandBuffer commandBuffer)
+{
+    VkRenderPassBeginInfo temporalRenderPassBeginInfo{};
+    temporalRenderPassBeginInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+
+    temporalRenderPassBeginInfo.renderPass = renderPass;
+    temporalRenderPassBeginInfo.framebuffer = framebuffer;
+
+    temporalRenderPassBeginInfo.renderArea.offset = {0, 0};
+    temporalRenderPassBeginInfo.renderArea.extent = renderExtent;
+
+    temporalRenderPassBeginInfo.clearValueCount = 0;  // every pixel in the render area is written.
+
+    vkCmdBeginRenderPass(commandBuffer, &temporalRenderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);  // recorded directly in the primary command buffer.
+
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineComponents.pipeline);
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineComponents.pipelineLayout, 0, 1, &descriptorSet, 0, nullptr);
+
+    if (pushConstant != nullptr) {
+        vkCmdPushConstants(commandBuffer, pipelineComponents.pipelineLayout, VK_SHADER_STAGE_FRAGMENT_BIT, 0, pushConstantSize, pushConstant);
+    }
+
+    VkViewport viewport{};
+    viewport.x = 0.0f;
+    viewport.y = 0.0f;
+    viewport.width = static_cast<float>(renderExtent.width);
+    viewport.height = static_cast<float>(renderExtent.height);
+    viewport.minDepth = 0.0f;
+    viewport.maxDepth = 1.0f;
+    vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+
+    VkRect2D scissor{};
+    scissor.offset = {0, 0};
+    scissor.extent = renderExtent;
+    vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+
+    vkCmdDraw(commandBuffer, 3, 1, 0, 0);  // the fullscreen triangle.
+
+    if (recordFollowingDraws != nullptr) {
+        recordFollowingDraws();
+    }
+
+    vkCmdEndRenderPass(commandBuffer);
+}
+
+void TemporalAntiAliasing::TemporalOperation::recordMotionVectorsCommands(uint32_t currentFrame, VkExtent2D renderExtent, const ModelHandler::ShaderBufferComponents& sceneShaderBufferComponents, const std::function<void(VkCommandBuffer)>& recordSceneDraws, VkCommandBuffer commandBuffer) const
+{
+    // moving instances overwrite the camera motion of their pixels.
+    auto recordGeometryDraws = [&]() {
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, this->motionVectorsGeometryPipelineComponents.pipeline);
+
+        VkDeviceSize offsets[] = {0};
+        vkCmdBindVertexBuffers(commandBuffer, 0, 1, &sceneShaderBufferComponents.vertexBuffer, offsets);
+        vkCmdBindIndexBuffer(commandBuffer, sceneShaderBufferComponents.indexBuffer, 0, VK_INDEX_TYPE_UINT32);
+
+        recordSceneDraws(commandBuffer);
+    };
+
+    recordTemporalCommands(this->motionVectorsRenderPass, this->motionVectorsFramebuffer, this->motionVectorsPipelineComponents, this->motionVectorsPipelineComponents.descriptorSets[currentFrame], renderExtent, nullptr, 0, recordGeometryDraws, commandBuffer);
+}
+
+void TemporalAntiAliasing::TemporalOperation::recordResolveCommands(uint32_t swapchainImageIndex, VkExtent2D renderExtent, glm::vec2 projectionJitter, VkCommandBuffer commandBuffer) const
+{
+    glm::vec2 sceneExtent = glm::vec2(this->sceneExtent.width, this->sceneExtent.height);
+
+    TemporalAntiAliasing::ResolvePushConstant resolvePushConstant{};
+    resolvePushConstant.outputTexelSize = (1.0f / sceneExtent);
+    resolvePushConstant.renderScale = (glm::vec2(renderExtent.width, renderExtent.height) / sceneExtent);
+    resolvePushConstant.sceneJitter = (projectionJitter / sceneExtent);
+    resolvePushConstant.historyValid = ((this->historyValid == true) ? 1u : 0u);
+
+    uint32_t historyReadIndex = (1 - this->historyWriteIndex);
+    VkFramebuffer resolveFramebuffer = this->resolveFramebuffers[(swapchainImageIndex * 2) + this->historyWriteIndex];
+    recordTemporalCommands(this->resolveRenderPass, resolveFramebuffer, this->pipelineComponents, this->pipelineComponents.descriptorSets[historyReadIndex], this->sceneExtent, &resolvePushConstant, sizeof(TemporalAntiAliasing::ResolvePushConstant), nullptr, commandBuffer);
+}
+
+void TemporalAntiAliasing::TemporalOperation::advanceHistory()
+{
+    this->historyWriteIndex = (1 - this->historyWriteIndex);
+    this->historyValid = true;
+}
+
+void TemporalAntiAliasing::TemporalOperation::resetHistory()
+{
+    this->historyValid = false;
+}
+
+void TemporalAntiAliasing::TemporalOperation::cleanupTemporalImages(VkDevice vulkanLogicalDevice)
+{
+    vkDestroyFramebuffer(vulkanLogicalDevice, this->motionVectorsFramebuffer, nullptr);
+    for (VkFramebuffer resolveFramebuffer : this->resolveFramebuffers) {
+        vkDestroyFramebuffer(vulkanLogicalDevice, resolveFramebuffer, nullptr);
+    }
+    this->resolveFramebuffers.clear();
+
+    this->motionVectorsImageDetails.cleanupImageDetails(vulkanLogicalDevice);
+    this->historyImageDetails[0].cleanupImageDetails(vulkanLogicalDevice);
+    this->historyImageDetails[1].cleanupImageDetails(vulkanLogicalDevice);
+}
+
+void TemporalAntiAliasing::TemporalOperation::cleanupTemporalOperation(VkDevice vulkanLogicalDevice)
+{
+    this->cleanupTemporalImages(vulkanLogicalDevice);
+
+    vkDestroySampler(vulkanLogicalDevice, this->linearSampler, nullptr);
+    vkDestroySampler(vulkanLogicalDevice, this->depthSampler, nullptr);
+
+    this->motionVectorsPipelineComponents.cleanupPipelineComponents(vulkanLogicalDevice);  // frees the uniform buffers and the descriptor sets with their pool.
+    vkDestroyPipeline(vulkanLogicalDevice, this->motionVectorsGeometryPipelineComponents.pipeline, nullptr);  // the descriptor set layout is destroyed with the motion vectors pipeline components.
+    vkDestroyPipelineLayout(vulkanLogicalDevice, this->motionVectorsGeometryPipelineComponents.pipelineLayout, nullptr);
+    this->pipelineComponents.cleanupPipelineComponents(vulkanLogicalDevice);
+
+    vkDestroyRenderPass(vulkanLogicalDevice, this->motionVectorsRenderPass, nullptr);
+    vkDestroyRenderPass(vulkanLogicalDevice, this->resolveRenderPass, nullptr);
+}
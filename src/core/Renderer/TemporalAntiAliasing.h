@@ -0,0 +1,118 @@
+#ifndef TEMPORALANTIALIASING_H
+#define TEMPORALANTIALIASING_H
+
+
+#define GLFW_INCLUDE_VULKAN
+#include <GLFW/glfw3.h>
+
+#include <core/Renderer/Pipeline.h>
+#include <core/Shader/Image.h>
+#include <core/Model/ModelHandler.h>
+#include <core/VulkanInstance/DeviceHandler.h>
+
+#include <glm/glm.hpp>
+
+#include <vector>
+#include <functional>
+#include <cstdint>
+
+
+namespace TemporalAntiAliasing
+{
+    const VkFormat motionVectorsImageFormat = VK_FORMAT_R16G16_SFLOAT;  // each pixel's screen space motion since the previous frame, in texture coordinates.
+    const VkFormat historyImageFormat = VK_FORMAT_R16G16B16A16_SFLOAT;  // the resolved HDR color, kept at a higher precision than the scene color to accumulate small contributions.
+    const uint32_t jitterPhaseCount = 8;  // the length of the projection jitter sequence, repeated every this many frames.
+
+    struct ResolvePushConstant {  // identical to the temporal resolve shader's push constant.
+        glm::vec2 outputTexelSize;  // the size of a swapchain texel in texture coordinates.
+        glm::vec2 renderScale;  // the rendered region of the scene images in texture coordinates.
+        glm::vec2 sceneJitter;  // the projection jitter in scene texture coordinates.
+        uint32_t historyValid;  // if the history image holds a previous frame, ignored otherwise.
+    };
+
+    // fetch the sub-pixel projection jitter of a frame, a Halton(2, 3) sequence covering the pixel evenly over the jitter phases.
+    //
+    // @param frameIndex the index of the frame, wrapped into the jitter phases.
+    // @param projectionJitter the fetched jitter in pixels, from -0.5 to 0.5 on each axis.
+    void fetchProjectionJitter(uint32_t frameIndex, glm::vec2& projectionJitter);
+
+    struct TemporalOperation {  // writes per-pixel motion vectors from the depth image and the drawn instances, and resolves the jittered scene color with the reprojected history into the tonemapped swapchain image(upsampling the rendered region).
+        Pipeline::PipelineComponents motionVectorsPipelineComponents;  // a descriptor set(with a temporal uniform buffer) for each frame in flight.
+        Pipeline::PipelineComponents motionVectorsGeometryPipelineComponents;  // draws the instances over the camera motion, with the motion vectors descriptor set layout.
+        Pipeline::PipelineComponents pipelineComponents;  // the resolve pipeline, a descriptor set for each history image read.
+
+        VkRenderPass motionVectorsRenderPass;
+        VkRenderPass resolveRenderPass;  // writes the swapchain image and the written history image, the resolve framebuffers are created with it.
+
+        Image::ImageDetails motionVectorsImageDetails;  // generated with the scene images(see generateTemporalImages).
+        Image::ImageDetails historyImageDetails[2];  // read and written alternately, the written image is read in the next frame.
+        VkFramebuffer motionVectorsFramebuffer;
+        std::vector<VkFramebuffer> resolveFramebuffers;  // one for each swapchain image and written history image, indexed by (swapchain image index * 2 + history write index).
+        VkSampler linearSampler;  // a linear sampler clamped to the edge, used for the scene color and the history.
+        VkSampler depthSampler;  // a nearest sampler, used for the depth image and the motion vectors.
+
+        uint32_t historyWriteIndex;  // the history image written by the current frame.
+        bool historyValid;  // if the read history image holds a resolved frame.
+        VkExtent2D sceneExtent;  // the extent of the scene images, the history images, and the swapchain images.
+
+
+        // generate the member temporal components, the temporal images are generated seperately with the scene images(see generateTemporalImages).
+        //
+        // @param swapchainImageFormat the format of the swapchain images written by the resolve pipeline.
+        // @param vulkanDevices Vulkan physical and logical device to use in member components generation.
+        void generateMemberComponents(VkFormat swapchainImageFormat, DeviceHandler::VulkanDevices vulkanDevices);
+
+        // generate the motion vectors and history images and their framebuffers, and point the descriptor sets at them and the scene images.
+        //
+        // @param sceneColorImageView the view of the single-sampled scene color.
+        // @param depthImageView the view of the depth image, only its depth aspect.
+        // @param bloomImageView the view of the first bloom level(see PostProcessing::PostProcessingOperation).
+        // @param exposureBuffer the adapted exposure buffer(see PostProcessing::ExposureState).
+        // @param swapchainImageViews the views of the swapchain images written by the resolve pipeline.
+        // @param sceneExtent the extent of the scene images.
+        // @param commandPool command pool to use in the history images' initial layout transitions.
+        // @param commandQueue queue to submit the history images' initial layout transitions in.
+        // @param vulkanDevices Vulkan physical and logical device to use in temporal images generation.
+        void generateTemporalImages(VkImageView sceneColorImageView, VkImageView depthImageView, VkImageView bloomImageView, VkBuffer exposureBuffer, const std::vector<VkImageView>& swapchainImageViews, VkExtent2D sceneExtent, VkCommandPool commandPool, VkQueue commandQueue, DeviceHandler::VulkanDevices vulkanDevices);
+
+        // record the motion vectors commands, a fullscreen triangle over the rendered region writing the camera motion, then the instances writing their own motion.
+        //
+        // expects the depth image in a read-only layout and the motion vectors image in the color attachment layout.
+        //
+        // @param currentFrame the current frame in flight, selecting its descriptor set.
+        // @param renderExtent the rendered region of the scene images.
+        // @param sceneShaderBufferComponents the position-only vertex data and indices of the scene.
+        // @param recordSceneDraws records the same instance draws as the scene pass, with the vertex data and the geometry pipeline bound.
+        // @param commandBuffer the command buffer to record in.
+        void recordMotionVectorsCommands(uint32_t currentFrame, VkExtent2D renderExtent, const ModelHandler::ShaderBufferComponents& sceneShaderBufferComponents, const std::function<void(VkCommandBuffer)>& recordSceneDraws, VkCommandBuffer commandBuffer) const;
+
+        // record the resolve commands, a fullscreen triangle writing the swapchain image and the written history image.
+        //
+        // expects the scene color, depth, motion vectors, and read history images in a read-only layout, and the bloom and exposure written.
+        //
+        // @param swapchainImageIndex the index of the written swapchain image.
+        // @param renderExtent the rendered region of the scene images.
+        // @param projectionJitter the frame's projection jitter in pixels.
+        // @param commandBuffer the command buffer to record in.
+        void recordResolveCommands(uint32_t swapchainImageIndex, VkExtent2D renderExtent, glm::vec2 projectionJitter, VkCommandBuffer commandBuffer) const;
+
+        // swap the read and written history images, after the frame's resolve was recorded.
+        void advanceHistory();
+
+        // drop the history, the next resolve only uses the current frame(ex: after the anti-aliasing mode changes).
+        void resetHistory();
+
+        // cleanup the temporal images and framebuffers(ex: before the scene images are recreated).
+        //
+        // @param vulkanLogicalDevice Vulkan logical device to use in temporal images cleanup.
+        void cleanupTemporalImages(VkDevice vulkanLogicalDevice);
+
+        // cleanup the temporal operation.
+        //
+        // @param vulkanLogicalDevice Vulkan logical device to use in temporal operation cleanup.
+        void cleanupTemporalOperation(VkDevice vulkanLogicalDevice);
+    };
+}
+
+
+#endif  // TEMPORALANTIALIASING_H
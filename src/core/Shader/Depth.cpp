@@ -12,18 +12,22 @@
 #include <core/VulkanInstance/DeviceHandler.h>
 #include <core/Command/CommandManager.h>
 #include <core/Logging/ErrorLogger.h>
+#include <core/Defaults/Defaults.h>
 
+#include <vector>
+#include <string>
+#include <utility>
 
-void Depth::populateDepthImageDetails(VkExtent2D swapchainImageExtent, VkSampleCountFlagBits msaaSampleCount, uint32_t layerCount, VkImageUsageFlagBits additionalImageUsage, VkCommandPool commandPool, VkQueue commandQueue, DeviceHandler::VulkanDevices vulkanDevices, Image::ImageDetails& depthImageDetails)
+
+void Depth::populateDepthImageDetails(VkExtent2D swapchainImageExtent, VkSampleCountFlagBits msaaSampleCount, VkFormat depthImageFormat, uint32_t layerCount, VkImageUsageFlags additionalImageUsage, VkCommandPool commandPool, VkQueue commandQueue, DeviceHandler::VulkanDevices vulkanDevices, Image::ImageDetails& depthImageDetails)
 {
-    Depth::selectDepthImageFormat(vulkanDevices.physicalDevice, depthImageDetails.imageFormat);
-    Image::populateImageDetails(swapchainImageExtent.width, swapchainImageExtent.height, 1, layerCount, msaaSampleCount, depthImageDetails.imageFormat, VK_IMAGE_TILING_OPTIMAL, (VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | additionalImageUsage), VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, vulkanDevices, depthImageDetails);
+    Image::populateImageDetails(swapchainImageExtent.width, swapchainImageExtent.height, 1, layerCount, msaaSampleCount, depthImageFormat, VK_IMAGE_TILING_OPTIMAL, (VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | additionalImageUsage), VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, vulkanDevices, depthImageDetails);
 
     
     VkCommandBuffer disposableCommandBuffer;
     CommandManager::beginRecordingSingleSubmitCommands(commandPool, vulkanDevices.logicalDevice, disposableCommandBuffer);
 
-    VkImageLayout targetImageLayout = (additionalImageUsage == VK_IMAGE_USAGE_SAMPLED_BIT ? VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL);
+    VkImageLayout targetImageLayout = ((additionalImageUsage & VK_IMAGE_USAGE_SAMPLED_BIT) != 0 ? VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL);
     
     Image::transitionImageLayout(depthImageDetails.image, depthImageDetails.imageFormat, 1, layerCount, VK_IMAGE_LAYOUT_UNDEFINED, targetImageLayout, disposableCommandBuffer);
     depthImageDetails.imageLayout = targetImageLayout;
@@ -34,7 +38,24 @@ void Depth::populateDepthImageDetails(VkExtent2D swapchainImageExtent, VkSampleC
 void Depth::selectDepthImageFormat(VkPhysicalDevice vulkanPhysicalDevice, VkFormat& depthImageFormat)
 {
     const std::vector<VkFormat> candidateDepthImageFormats = {VK_FORMAT_D32_SFLOAT, VK_FORMAT_D32_SFLOAT_S8_UINT, VK_FORMAT_D24_UNORM_S8_UINT};
-    Image::selectSupportedImageFormat(candidateDepthImageFormats, VK_IMAGE_TILING_OPTIMAL, VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT, vulkanPhysicalDevice, depthImageFormat);
+    Image::selectSupportedImageFormat(candidateDepthImageFormats, VK_IMAGE_TILING_OPTIMAL, (VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT), vulkanPhysicalDevice, depthImageFormat);  // sampled in the depth pyramid reduction.
+}
+
+void Depth::selectShadowImageFormat(VkPhysicalDevice vulkanPhysicalDevice, VkFormat& shadowImageFormat)
+{
+    // shadow maps are sampled, and have no use for a stencil component.
+    std::vector<VkFormat> candidateShadowImageFormats = {VK_FORMAT_D16_UNORM, VK_FORMAT_D32_SFLOAT};
+    if (Defaults::rendererDefaults.SHADOW_DEPTH_FORMAT == "D32") {
+        std::swap(candidateShadowImageFormats[0], candidateShadowImageFormats[1]);
+    } else if (Defaults::rendererDefaults.SHADOW_DEPTH_FORMAT != "D16") {
+        throwDebugException("Unknown shadow depth format \"" + Defaults::rendererDefaults.SHADOW_DEPTH_FORMAT + "\".");
+    }
+
+    VkFormatFeatureFlags shadowImageFormatFeatures = (VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT);
+    if (Defaults::rendererDefaults.SHADOW_FILTER == "LINEAR") {
+        shadowImageFormatFeatures |= VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT;
+    }
+    Image::selectSupportedImageFormat(candidateShadowImageFormats, VK_IMAGE_TILING_OPTIMAL, shadowImageFormatFeatures, vulkanPhysicalDevice, shadowImageFormat);
 }
 
 bool Depth::depthImageFormatHasStencilComponent(VkFormat depthImageFormat)
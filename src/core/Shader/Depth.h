@@ -15,13 +15,14 @@ namespace Depth
     //
     // @param swapchainImageExtent swapchain image extent to use in depth component creation.
     // @param msaaSampleCount the amount of msaa samples.
+    // @param depthImageFormat the format of the depth image(see selectDepthImageFormat and selectShadowImageFormat).
     // @param layerCount the amount of layers in the depth image.
     // @param additionalImageUsage additional image usage to VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
     // @param commandPool command pool to use in command buffer creation.
     // @param commandQueue queue to submit necessary commands on.
     // @param vulkanDevices Vulkan physical and logical device to use in depth component creation.
     // @param depthImageDetails populated depth image details.
-    void populateDepthImageDetails(VkExtent2D swapchainImageExtent, VkSampleCountFlagBits msaaSampleCount, uint32_t layerCount, VkImageUsageFlagBits additionalImageUsage, VkCommandPool commandPool, VkQueue commandQueue, DeviceHandler::VulkanDevices vulkanDevices, Image::ImageDetails& depthImageDetails);
+    void populateDepthImageDetails(VkExtent2D swapchainImageExtent, VkSampleCountFlagBits msaaSampleCount, VkFormat depthImageFormat, uint32_t layerCount, VkImageUsageFlags additionalImageUsage, VkCommandPool commandPool, VkQueue commandQueue, DeviceHandler::VulkanDevices vulkanDevices, Image::ImageDetails& depthImageDetails);
 
     // select a depth image format.
     //
@@ -29,6 +30,12 @@ namespace Depth
     // @param depthImageFormat selected depth image format.
     void selectDepthImageFormat(VkPhysicalDevice vulkanPhysicalDevice, VkFormat& depthImageFormat);
 
+    // select a sampleable shadow map depth image format, preferring the configured shadow depth format.
+    //
+    // @param vulkanPhysicalDevice Vulkan physical device to use in shadow image format selection.
+    // @param shadowImageFormat selected shadow image format.
+    void selectShadowImageFormat(VkPhysicalDevice vulkanPhysicalDevice, VkFormat& shadowImageFormat);
+
     // test the stencil component availibility of a depth image format.
     //
     // @param depthImageFormat tested depth image format.
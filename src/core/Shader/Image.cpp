@@ -7,6 +7,7 @@
 #include <core/Shader/Image.h>
 #include <core/Shader/Depth.h>
 #include <core/DisplayManager/DisplayManager.h>
+#include <core/Renderer/Renderer.h>
 #include <core/VulkanInstance/DeviceHandler.h>
 #include <core/Command/CommandManager.h>
 #include <core/Buffer/Buffer.h>
@@ -30,7 +31,7 @@ void Image::TextureDetails::cleanupTextureDetails(VkDevice vulkanLogicalDevice)
     vkDestroySampler(vulkanLogicalDevice, this->textureSampler, nullptr);
 }
 
-void Image::populateImageDetails(uint32_t width, uint32_t height, uint32_t mipmapLevels, uint32_t layerCount, VkSampleCountFlagBits msaaSampleCount, VkFormat format, VkImageTiling tiling, VkImageUsageFlags usage, VkMemoryPropertyFlags memoryProperties, DeviceHandler::VulkanDevices vulkanDevices, Image::ImageDetails& imageDetails)
+void Image::createImage(uint32_t width, uint32_t height, uint32_t mipmapLevels, uint32_t layerCount, VkSampleCountFlagBits msaaSampleCount, VkFormat format, VkImageTiling tiling, VkImageUsageFlags usage, VkDevice vulkanLogicalDevice, VkImage& image)
 {
     VkImageCreateInfo imageCreateInfo{};
     imageCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
@@ -55,10 +56,15 @@ void Image::populateImageDetails(uint32_t width, uint32_t height, uint32_t mipma
 
     imageCreateInfo.flags = (layerCount == 6 ? VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT : 0);
 
-    VkResult imageCreationResult = vkCreateImage(vulkanDevices.logicalDevice, &imageCreateInfo, nullptr, &imageDetails.image);
+    VkResult imageCreationResult = vkCreateImage(vulkanLogicalDevice, &imageCreateInfo, nullptr, &image);
     if (imageCreationResult != VK_SUCCESS) {
         throwDebugException("Failed to create image.");
     }
+}
+
+void Image::populateImageDetails(uint32_t width, uint32_t height, uint32_t mipmapLevels, uint32_t layerCount, VkSampleCountFlagBits msaaSampleCount, VkFormat format, VkImageTiling tiling, VkImageUsageFlags usage, VkMemoryPropertyFlags memoryProperties, DeviceHandler::VulkanDevices vulkanDevices, Image::ImageDetails& imageDetails)
+{
+    Image::createImage(width, height, mipmapLevels, layerCount, msaaSampleCount, format, tiling, usage, vulkanDevices.logicalDevice, imageDetails.image);
 
 
     VkMemoryRequirements imageMemoryRequirements;
@@ -69,7 +75,13 @@ void Image::populateImageDetails(uint32_t width, uint32_t height, uint32_t mipma
 
     memoryAllocateInfo.allocationSize = imageMemoryRequirements.size;
     uint32_t selectedMemoryTypeIndex;
-    Buffer::locateMemoryType(vulkanDevices.physicalDevice, imageMemoryRequirements.memoryTypeBits, memoryProperties, selectedMemoryTypeIndex);
+    if (Buffer::locateMemoryType(vulkanDevices.physicalDevice, imageMemoryRequirements.memoryTypeBits, memoryProperties, selectedMemoryTypeIndex) == false) {
+        // lazily allocated memory usually only exists on tile-based GPUs, elsewhere transient attachments are backed by regular memory.
+        VkMemoryPropertyFlags fallbackMemoryProperties = (memoryProperties & ~VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT);
+        if (fallbackMemoryProperties == memoryProperties || Buffer::locateMemoryType(vulkanDevices.physicalDevice, imageMemoryRequirements.memoryTypeBits, fallbackMemoryProperties, selectedMemoryTypeIndex) == false) {
+            throwDebugException("Failed to find a suitable image memory type.");
+        }
+    }
     memoryAllocateInfo.memoryTypeIndex = selectedMemoryTypeIndex;
 
     VkResult memoryAllocationResult = vkAllocateMemory(vulkanDevices.logicalDevice, &memoryAllocateInfo, nullptr, &imageDetails.imageMemory);
@@ -81,7 +93,7 @@ void Image::populateImageDetails(uint32_t width, uint32_t height, uint32_t mipma
 
 
     // image itself and image memory are populated in the struct previously in this function.
-    imageDetails.imageLayout = imageCreateInfo.initialLayout;
+    imageDetails.imageLayout = VK_IMAGE_LAYOUT_UNDEFINED;  // see Image::createImage.
     imageDetails.imageWidth = width;
     imageDetails.imageHeight = height;
     imageDetails.imageFormat = format;
@@ -162,11 +174,34 @@ void Image::populateTextureDetails(std::string textureImageFilePath, bool isCube
 
 void Image::generateSwapchainImageDetails(DisplayManager::DisplayDetails& displayDetails, DeviceHandler::VulkanDevices vulkanDevices)
 {
-    Image::populateImageDetails(displayDetails.swapchainImageExtent.width, displayDetails.swapchainImageExtent.height, 1, 1, displayDetails.msaaSampleCount, displayDetails.swapchainImageFormat, VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT | VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, vulkanDevices, displayDetails.colorImageDetails);
+    // without msaa the color image is the scene color itself, sampled by the post-processing and anti-aliasing passes(in HDR, see RendererDetails::sceneColorImageFormat).
+    bool sceneColorResolved = (displayDetails.msaaSampleCount != VK_SAMPLE_COUNT_1_BIT);
+    // with msaa the color image is only resolved, it never leaves the main render pass without the late main render pass.
+    bool colorImageTransient = ((sceneColorResolved == true) && (displayDetails.colorImageTransient == true));
+    VkImageUsageFlags colorImageUsage = (VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | (sceneColorResolved == true ? 0 : VK_IMAGE_USAGE_SAMPLED_BIT) | (colorImageTransient == true ? VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT : 0));
+    VkMemoryPropertyFlags colorImageMemoryProperties = (VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | (colorImageTransient == true ? VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT : 0));
+    Image::populateImageDetails(displayDetails.swapchainImageExtent.width, displayDetails.swapchainImageExtent.height, 1, 1, displayDetails.msaaSampleCount, RendererDetails::sceneColorImageFormat, VK_IMAGE_TILING_OPTIMAL, colorImageUsage, colorImageMemoryProperties, vulkanDevices, displayDetails.colorImageDetails);  // stored between the early and late main render passes, if split.
     Image::createImageView(displayDetails.colorImageDetails.image, displayDetails.colorImageDetails.imageFormat, 1, 1, VK_IMAGE_ASPECT_COLOR_BIT, vulkanDevices.logicalDevice, displayDetails.colorImageDetails.imageView);
 
-    Depth::populateDepthImageDetails(displayDetails.swapchainImageExtent, displayDetails.msaaSampleCount, 1, (VkImageUsageFlagBits)(0), displayDetails.graphicsCommandPool, displayDetails.graphicsQueue, vulkanDevices, displayDetails.depthImageDetails);
+    displayDetails.sceneColorImageDetails = Image::ImageDetails{};  // null handles without msaa, cleaned up all the same.
+    if (sceneColorResolved == true) {  // the resolve attachment of the main render pass.
+        Image::populateImageDetails(displayDetails.swapchainImageExtent.width, displayDetails.swapchainImageExtent.height, 1, 1, VK_SAMPLE_COUNT_1_BIT, RendererDetails::sceneColorImageFormat, VK_IMAGE_TILING_OPTIMAL, (VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT), VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, vulkanDevices, displayDetails.sceneColorImageDetails);
+        Image::createImageView(displayDetails.sceneColorImageDetails.image, displayDetails.sceneColorImageDetails.imageFormat, 1, 1, VK_IMAGE_ASPECT_COLOR_BIT, vulkanDevices.logicalDevice, displayDetails.sceneColorImageDetails.imageView);
+    }
+
+    VkFormat depthImageFormat;
+    Depth::selectDepthImageFormat(vulkanDevices.physicalDevice, depthImageFormat);
+    Depth::populateDepthImageDetails(displayDetails.swapchainImageExtent, displayDetails.msaaSampleCount, depthImageFormat, 1, (VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT), displayDetails.graphicsCommandPool, displayDetails.graphicsQueue, vulkanDevices, displayDetails.depthImageDetails);  // reduced into the depth pyramid, and read by the deferred lighting subpass.
     Image::createImageView(displayDetails.depthImageDetails.image, displayDetails.depthImageDetails.imageFormat, 1, 1, VK_IMAGE_ASPECT_DEPTH_BIT, vulkanDevices.logicalDevice, displayDetails.depthImageDetails.imageView);
+
+    // the deferred G-buffer, only read as input attachments within the main render pass(transient G-buffers never leave tile memory).
+    VkImageUsageFlags gBufferImageUsage = (VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT | (displayDetails.gBufferTransient == true ? VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT : 0));
+    VkMemoryPropertyFlags gBufferMemoryProperties = (VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | (displayDetails.gBufferTransient == true ? VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT : 0));
+    displayDetails.gBufferImageDetails.resize(displayDetails.gBufferImageFormats.size());
+    for (size_t i = 0; i < displayDetails.gBufferImageFormats.size(); i += 1) {
+        Image::populateImageDetails(displayDetails.swapchainImageExtent.width, displayDetails.swapchainImageExtent.height, 1, 1, displayDetails.msaaSampleCount, displayDetails.gBufferImageFormats[i], VK_IMAGE_TILING_OPTIMAL, gBufferImageUsage, gBufferMemoryProperties, vulkanDevices, displayDetails.gBufferImageDetails[i]);
+        Image::createImageView(displayDetails.gBufferImageDetails[i].image, displayDetails.gBufferImageDetails[i].imageFormat, 1, 1, VK_IMAGE_ASPECT_COLOR_BIT, vulkanDevices.logicalDevice, displayDetails.gBufferImageDetails[i].imageView);
+    }
 }
 
 void Image::generateMipmapLevels(Image::ImageDetails& imageDetails, VkCommandPool commandPool, VkQueue commandQueue, DeviceHandler::VulkanDevices vulkanDevices)
@@ -328,6 +363,39 @@ void Image::createTextureSampler(DeviceHandler::VulkanDevices vulkanDevices, uin
     }
 }
 
+void Image::createShadowSampler(VkFilter samplerFilter, VkBool32 compareEnable, VkDevice vulkanLogicalDevice, VkSampler& shadowSampler)
+{
+    VkSamplerCreateInfo samplerCreateInfo{};
+    samplerCreateInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+    
+    samplerCreateInfo.minFilter = samplerFilter;
+    samplerCreateInfo.magFilter = samplerFilter;
+
+    samplerCreateInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_BORDER;
+    samplerCreateInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_BORDER;
+    samplerCreateInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_BORDER;
+
+    samplerCreateInfo.anisotropyEnable = VK_FALSE;  // shadow maps are sampled without perspective distortion.
+    samplerCreateInfo.maxAnisotropy = 1.0f;
+
+    samplerCreateInfo.borderColor = VK_BORDER_COLOR_FLOAT_OPAQUE_WHITE;  // a depth of 1.0 outside of the shadow map.
+    
+    samplerCreateInfo.unnormalizedCoordinates = VK_FALSE;
+    
+    samplerCreateInfo.compareEnable = compareEnable;
+    samplerCreateInfo.compareOp = (compareEnable == VK_TRUE ? VK_COMPARE_OP_LESS_OR_EQUAL : VK_COMPARE_OP_ALWAYS);  // lit if the reference depth is no further than the stored depth.
+
+    samplerCreateInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+    samplerCreateInfo.mipLodBias = 0.0f;
+    samplerCreateInfo.minLod = 0.0f;
+    samplerCreateInfo.maxLod = 1.0f;
+
+    VkResult shadowSamplerCreationResult = vkCreateSampler(vulkanLogicalDevice, &samplerCreateInfo, nullptr, &shadowSampler);
+    if (shadowSamplerCreationResult != VK_SUCCESS) {
+        throwDebugException("Failed to create a shadow sampler.");
+    }
+}
+
 void Image::selectSupportedImageFormat(const std::vector<VkFormat> candidateImageFormats, VkImageTiling imageTiling, VkFormatFeatureFlags imageFormatFeatureFlags, VkPhysicalDevice vulkanPhysicalDevice, VkFormat& imageFormat)
 {
     for (VkFormat candidateImageFormat : candidateImageFormats) {
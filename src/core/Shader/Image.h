@@ -50,6 +50,20 @@ namespace Image
         void cleanupTextureDetails(VkDevice vulkanLogicalDevice);
     };
     
+    // create an image without allocating or binding its memory.
+    //
+    // @param width the image's width.
+    // @param height the image's height.
+    // @param mipmapLevels the amount of mipmap levels.
+    // @param layerCount the amount of image layers.
+    // @param msaaSampleCount the amount of msaa samples.
+    // @param format the image's format.
+    // @param tiling the image's tiling mode.
+    // @param usage the image's Vulkan usage.
+    // @param vulkanLogicalDevice Vulkan logical device to use in image creation.
+    // @param image created image.
+    void createImage(uint32_t width, uint32_t height, uint32_t mipmapLevels, uint32_t layerCount, VkSampleCountFlagBits msaaSampleCount, VkFormat format, VkImageTiling tiling, VkImageUsageFlags usage, VkDevice vulkanLogicalDevice, VkImage& image);
+    
     // populate an image struct.
     //
     // @param width the image's width.
@@ -122,6 +136,16 @@ namespace Image
     // @param textureSampler created texture sampler.
     void createTextureSampler(DeviceHandler::VulkanDevices vulkanDevices, uint32_t mipmapLevels, VkSampler& textureSampler);
 
+    // create a shadow map sampler, clamping outside of the map to the max depth(never in shadow).
+    //
+    // comparison samplers return the lit fraction of the reference depth, a linear filter blends four comparisons(hardware PCF).
+    //
+    // @param samplerFilter the min and mag filter of the sampler.
+    // @param compareEnable if the sampler compares a reference depth against the shadow map instead of returning the stored depth.
+    // @param vulkanLogicalDevice Vulkan logical device to use in shadow sampler creation.
+    // @param shadowSampler created shadow sampler.
+    void createShadowSampler(VkFilter samplerFilter, VkBool32 compareEnable, VkDevice vulkanLogicalDevice, VkSampler& shadowSampler);
+
     // select a supported image format out of the candidate formats conformant to image format flags.
     //
     // @param candidateImageFormats the image formats to select from.
@@ -50,7 +50,10 @@ void ResourceDescriptor::fetchSceneAttributeDescriptions(std::vector<VkVertexInp
     VkVertexInputAttributeDescription UVCoordinatesAttributeDescription{};
     ResourceDescriptor::populateVertexInputAttributeDescription(3, 0, VK_FORMAT_R32G32_SFLOAT, offsetof(ModelHandler::SceneVertexData, UVCoordinates), UVCoordinatesAttributeDescription);
 
-    attributeDescriptions = {positionAttributeDescription, normalAttributeDescription, tangentAttributeDescription, UVCoordinatesAttributeDescription};
+    VkVertexInputAttributeDescription alphaCutoffAttributeDescription{};
+    ResourceDescriptor::populateVertexInputAttributeDescription(4, 0, VK_FORMAT_R32_SFLOAT, offsetof(ModelHandler::SceneVertexData, alphaCutoff), alphaCutoffAttributeDescription);
+
+    attributeDescriptions = {positionAttributeDescription, normalAttributeDescription, tangentAttributeDescription, UVCoordinatesAttributeDescription, alphaCutoffAttributeDescription};
 }
 
 void ResourceDescriptor::fetchSceneNormalsAttributeDescriptions(std::vector<VkVertexInputAttributeDescription>& attributeDescriptions)
@@ -73,6 +76,20 @@ void ResourceDescriptor::fetchShadowAttributeDescriptions(std::vector<VkVertexIn
     attributeDescriptions = {positionAttributeDescription};
 }
 
+void ResourceDescriptor::fetchMaskedShadowAttributeDescriptions(std::vector<VkVertexInputAttributeDescription>& attributeDescriptions)
+{
+    VkVertexInputAttributeDescription positionAttributeDescription{};
+    ResourceDescriptor::populateVertexInputAttributeDescription(0, 0, VK_FORMAT_R32G32B32_SFLOAT, offsetof(ModelHandler::SceneVertexData, position), positionAttributeDescription);
+
+    VkVertexInputAttributeDescription UVCoordinatesAttributeDescription{};
+    ResourceDescriptor::populateVertexInputAttributeDescription(1, 0, VK_FORMAT_R32G32_SFLOAT, offsetof(ModelHandler::SceneVertexData, UVCoordinates), UVCoordinatesAttributeDescription);
+
+    VkVertexInputAttributeDescription alphaCutoffAttributeDescription{};
+    ResourceDescriptor::populateVertexInputAttributeDescription(2, 0, VK_FORMAT_R32_SFLOAT, offsetof(ModelHandler::SceneVertexData, alphaCutoff), alphaCutoffAttributeDescription);
+
+    attributeDescriptions = {positionAttributeDescription, UVCoordinatesAttributeDescription, alphaCutoffAttributeDescription};
+}
+
 void ResourceDescriptor::populateDescriptorSetLayoutBinding(uint32_t binding, VkDescriptorType descriptorType, VkShaderStageFlags stageFlags, VkDescriptorSetLayoutBinding& descriptorSetLayoutBinding)
 {
     descriptorSetLayoutBinding.binding = binding;
@@ -105,9 +122,9 @@ void ResourceDescriptor::populateDescriptorPoolSize(VkDescriptorType type, uint3
     descriptorPoolSize.descriptorCount = descriptorCount;
 }
 
-void ResourceDescriptor::createDescriptorPool(uint32_t combinedSamplerCount, VkDevice vulkanLogicalDevice, VkDescriptorPool& descriptorPool)
+void ResourceDescriptor::createDescriptorPool(uint32_t combinedSamplerCount, uint32_t storageBufferCount, uint32_t inputAttachmentCount, VkDevice vulkanLogicalDevice, VkDescriptorPool& descriptorPool)
 {
-    VkDescriptorPoolSize descriptorPoolSizes[2];
+    VkDescriptorPoolSize descriptorPoolSizes[4];
     uint32_t descriptorPoolSizeCount = -1;
     
     VkDescriptorPoolSize uniformBufferPoolSize{};
@@ -119,8 +136,22 @@ void ResourceDescriptor::createDescriptorPool(uint32_t combinedSamplerCount, VkD
         VkDescriptorPoolSize combinedSamplerPoolSize{};
         ResourceDescriptor::populateDescriptorPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, (Defaults::rendererDefaults.MAX_FRAMES_IN_FLIGHT * combinedSamplerCount), combinedSamplerPoolSize);
 
-        descriptorPoolSizes[1] = combinedSamplerPoolSize;
-        descriptorPoolSizeCount = 2;
+        descriptorPoolSizes[descriptorPoolSizeCount] = combinedSamplerPoolSize;
+        descriptorPoolSizeCount += 1;
+    }
+    if (storageBufferCount > 0) {
+        VkDescriptorPoolSize storageBufferPoolSize{};
+        ResourceDescriptor::populateDescriptorPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, (Defaults::rendererDefaults.MAX_FRAMES_IN_FLIGHT * storageBufferCount), storageBufferPoolSize);
+
+        descriptorPoolSizes[descriptorPoolSizeCount] = storageBufferPoolSize;
+        descriptorPoolSizeCount += 1;
+    }
+    if (inputAttachmentCount > 0) {
+        VkDescriptorPoolSize inputAttachmentPoolSize{};
+        ResourceDescriptor::populateDescriptorPoolSize(VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT, (Defaults::rendererDefaults.MAX_FRAMES_IN_FLIGHT * inputAttachmentCount), inputAttachmentPoolSize);
+
+        descriptorPoolSizes[descriptorPoolSizeCount] = inputAttachmentPoolSize;
+        descriptorPoolSizeCount += 1;
     }
     
     
@@ -214,3 +245,16 @@ void ResourceDescriptor::populateDescriptorSets(std::vector<VkBuffer>& uniformBu
         vkUpdateDescriptorSets(vulkanLogicalDevice, static_cast<uint32_t>(writeDescriptorSets.size()), writeDescriptorSets.data(), 0, nullptr);  // populate/update the descriptor set.
     }
 }
+
+void ResourceDescriptor::populateFrameStorageBufferDescriptors(uint32_t dstBinding, std::vector<VkBuffer>& storageBuffers, VkDevice vulkanLogicalDevice, std::vector<VkDescriptorSet>& descriptorSets)
+{
+    for (size_t i = 0; i < descriptorSets.size(); i += 1) {
+        VkDescriptorBufferInfo descriptorBufferInfo{};
+        ResourceDescriptor::populateDescriptorBufferInfo(storageBuffers[i], 0, VK_WHOLE_SIZE, descriptorBufferInfo);
+
+        VkWriteDescriptorSet storageBufferWriteDescriptorSet{};
+        ResourceDescriptor::populateWriteDescriptorSet(descriptorSets[i], dstBinding, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, nullptr, &descriptorBufferInfo, storageBufferWriteDescriptorSet);
+
+        vkUpdateDescriptorSets(vulkanLogicalDevice, 1, &storageBufferWriteDescriptorSet, 0, nullptr);
+    }
+}
@@ -46,6 +46,11 @@ namespace ResourceDescriptor
     // @param attributeDescriptions fetched attribute descriptions.
     void fetchShadowAttributeDescriptions(std::vector<VkVertexInputAttributeDescription>& attributeDescriptions);
 
+    // fetch the attribute descriptions used for the masked shadow vertex attributes, the position, texture coordinates, and alpha cutoff of the scene vertex data.
+    //
+    // @param attributeDescriptions fetched attribute descriptions.
+    void fetchMaskedShadowAttributeDescriptions(std::vector<VkVertexInputAttributeDescription>& attributeDescriptions);
+
     // populate a descriptor set layout binding.
     //
     // @param binding see VkDescriptorSetLayoutBinding documentation.
@@ -71,9 +76,11 @@ namespace ResourceDescriptor
     // create descriptor pool.
     //
     // @param combinedSamplerCount the amount of combined samplers that will be allocated in the pool.
+    // @param storageBufferCount the amount of storage buffers that will be allocated in the pool.
+    // @param inputAttachmentCount the amount of input attachments that will be allocated in the pool.
     // @param vulkanLogicalDevice Vulkan logical device to use in descriptor pool creation.
     // @param descriptorPool created descriptor pool.
-    void createDescriptorPool(uint32_t combinedSamplerCount, VkDevice vulkanLogicalDevice, VkDescriptorPool& descriptorPool);
+    void createDescriptorPool(uint32_t combinedSamplerCount, uint32_t storageBufferCount, uint32_t inputAttachmentCount, VkDevice vulkanLogicalDevice, VkDescriptorPool& descriptorPool);
 
     // create descriptor sets.
     //
@@ -118,6 +125,14 @@ namespace ResourceDescriptor
     // @param vulkanLogicalDevice Vulkan logical device to use in descriptor sets population.
     // @param descriptorSets populated descriptor sets.
     void populateDescriptorSets(std::vector<VkBuffer>& uniformBuffers, std::vector<VkWriteDescriptorSet>& additionalWriteDescriptorSets, VkDevice vulkanLogicalDevice, std::vector<VkDescriptorSet>& descriptorSets);
+
+    // populate a storage buffer binding of the supplied descriptor sets, each with its own frame's storage buffer.
+    //
+    // @param dstBinding the binding of the storage buffer.
+    // @param storageBuffers storage buffers to populate the descriptor sets with(one for each frame in flight).
+    // @param vulkanLogicalDevice Vulkan logical device to use in descriptor sets population.
+    // @param descriptorSets populated descriptor sets.
+    void populateFrameStorageBufferDescriptors(uint32_t dstBinding, std::vector<VkBuffer>& storageBuffers, VkDevice vulkanLogicalDevice, std::vector<VkDescriptorSet>& descriptorSets);
 }
 
 
@@ -24,8 +24,6 @@ namespace Shader
         Shader fragmentShader;
     };
 
-    extern glm::mat4 shadowTransforms[6];
-    
     
     // create a shader module using the supplied bytecode.
     //
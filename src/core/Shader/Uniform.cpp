@@ -8,15 +8,23 @@
 #include <glm/gtx/quaternion.hpp>
 
 #include <core/Shader/Uniform.h>
+#include <core/Renderer/BoundingVolumeHierarchy.h>
+#include <core/Renderer/MaskedOcclusion.h>
+#include <core/Model/ModelHandler.h>
 #include <core/Shader/Shader.h>
 #include <core/DisplayManager/Camera.h>
 #include <core/Buffer/Buffer.h>
 #include <core/Defaults/Defaults.h>
+#include <core/Logging/ErrorLogger.h>
 
 #include <vector>
+#include <string>
 #include <cstring>
 #include <algorithm>
 #include <math.h>
+#include <cmath>
+#include <iterator>
+#include <utility>
 
 
 void Uniform::createUniformBuffers(VkDeviceSize uniformBufferObjectSize, DeviceHandler::VulkanDevices vulkanDevices, std::vector<VkBuffer>& uniformBuffers, std::vector<VkDeviceMemory>& uniformBuffersMemory, std::vector<void *>& mappedUniformBuffersMemory)
@@ -67,45 +75,122 @@ void Uniform::updateFrameUniformBuffers(Uniform::UniformBuffersUpdatePackage& un
     sceneUniformBufferObject.projectionMatrix = glm::perspective(glm::radians(cameraFOV), aspectRatio, nearPlane, farPlane);
     sceneUniformBufferObject.projectionMatrix[1][1] *= -1;  // compensate for GLM's OpenGL design, invert the y-axis.
 
+    // the shadow cascades, culling, and reprojection follow the unjittered camera.
+    glm::mat4 cameraMatrix = (sceneUniformBufferObject.projectionMatrix * sceneUniformBufferObject.viewMatrix);
+    glm::mat4 inverseCameraMatrix = glm::inverse(cameraMatrix);
+
+    // the sub-pixel jitter is a clip space translation, offsetting every NDC position equally.
+    VkExtent2D renderExtent = uniformBuffersUpdatePackage.renderExtent;
+    glm::vec2 projectionJitter = ((2.0f * uniformBuffersUpdatePackage.projectionJitter) / glm::vec2(renderExtent.width, renderExtent.height));
+    sceneUniformBufferObject.projectionMatrix = (glm::translate(glm::mat4(1.0f), glm::vec3(projectionJitter, 0.0f)) * sceneUniformBufferObject.projectionMatrix);
+
     sceneUniformBufferObject.normalMatrix = glm::mat4(glm::mat3(glm::transpose(glm::inverse(sceneUniformBufferObject.modelMatrix))));
 
-    Uniform::SceneLight directionalLight;
+    Uniform::SceneLight directionalLight{};
     directionalLight.lightID = 0;  // directional light.
+    directionalLight.shadowIndex = Uniform::noShadowIndex;  // shadowed by the cascades.
+    directionalLight.shadowProjection = Uniform::cubeShadowProjection;
     directionalLight.lightProperties = glm::vec4(2.0f, 2.0f, 5.0f, 0.0f);
     directionalLight.lightColor = glm::vec4(1.0f, 1.0f, 1.0f, 0.0f);
 
-    sceneUniformBufferObject.sceneLights[0] = directionalLight;
-
-    Uniform::SceneLight pointLight;
+    Uniform::SceneLight pointLight{};
     pointLight.lightID = 1;  // point light.
+    pointLight.shadowIndex = Uniform::pointShadowCubemapIndex;
+    pointLight.shadowProjection = Uniform::cubeShadowProjection;
     pointLight.lightProperties = glm::vec4(0.0f, 0.0f, -6.0f, 1.0f);
     pointLight.lightColor = glm::vec4(1.0f, 1.0f, 1.0f, 0.55f);
+    pointLight.lightRange = Uniform::calculateLightRange(pointLight.lightColor);
+
+    // additional shadowed test lights, shadowed through the shadow atlas.
+    Uniform::SceneLight spotlight{};
+    spotlight.lightID = 2;  // spotlight.
+    spotlight.shadowIndex = Uniform::noShadowIndex;
+    spotlight.shadowProjection = Uniform::cubeShadowProjection;
+    spotlight.lightProperties = glm::vec4(2.0f, 1.0f, -3.0f, 1.0f);
+    spotlight.lightColor = glm::vec4(1.0f, 0.9f, 0.7f, 0.8f);
+    spotlight.lightDirection = glm::vec4(glm::normalize(glm::vec3(-2.0f, -2.0f, 3.0f)), std::cos(glm::radians(25.0f)));  // pointed at the main mesh.
+    spotlight.lightRange = Uniform::calculateLightRange(spotlight.lightColor);
+
+    Uniform::SceneLight fillPointLight{};
+    fillPointLight.lightID = 1;  // point light.
+    fillPointLight.shadowIndex = Uniform::noShadowIndex;
+    fillPointLight.shadowProjection = Uniform::dualParaboloidShadowProjection;  // a minor light, two views instead of six.
+    fillPointLight.lightProperties = glm::vec4(-3.0f, 1.0f, 2.0f, 1.0f);
+    fillPointLight.lightColor = glm::vec4(0.6f, 0.7f, 1.0f, 0.35f);
+    fillPointLight.lightRange = Uniform::calculateLightRange(fillPointLight.lightColor);
+
+    std::vector<Uniform::SceneLight> sceneLights = {directionalLight, pointLight};
+    if (Defaults::rendererDefaults.SHADOW_ATLAS_TEST_LIGHTS == "ON") {
+        sceneLights.push_back(spotlight);
+        sceneLights.push_back(fillPointLight);
+    }
 
-    sceneUniformBufferObject.sceneLights[1] = pointLight;
+    // dim shadowless point lights scattered on a spiral around the main mesh, only the lights binned into a fragment's cluster are shaded.
+    for (uint32_t i = 0; i < Defaults::rendererDefaults.CLUSTER_TEST_LIGHT_COUNT; i += 1) {
+        float spiralAngle = (static_cast<float>(i) * 2.39996323f);  // the golden angle.
+        float spiralRadius = (2.0f + (0.25f * std::sqrt(static_cast<float>(i))));
 
-    sceneUniformBufferObject.sceneLightCount = 2;
+        Uniform::SceneLight testLight{};
+        testLight.lightID = 1;  // point light.
+        testLight.shadowIndex = Uniform::shadowlessIndex;
+        testLight.shadowProjection = Uniform::cubeShadowProjection;
+        testLight.lightProperties = glm::vec4((std::cos(spiralAngle) * spiralRadius), (-1.0f + static_cast<float>(i % 3)), (std::sin(spiralAngle) * spiralRadius), 1.0f);
+        testLight.lightColor = glm::vec4((0.5f + (0.5f * std::cos(spiralAngle))), (0.5f + (0.5f * std::sin(spiralAngle))), 0.75f, 0.02f);
+        testLight.lightRange = Uniform::calculateLightRange(testLight.lightColor);
 
-    // TODO: light matrices do not need to be updated every frame.
-    // TODO: proper variable names.
-    float sizePerDepth = (atan(glm::radians(cameraFOV / 2.0f) * 2.0f));
-    float distance = glm::length(glm::vec3(0, 0, 0) - uniformBuffersUpdatePackage.mainCamera->eye);
-    float sizeX = (sizePerDepth * distance);
-    float sizeY = (sizePerDepth * distance * aspectRatio);
-    
-    glm::mat4 lightProjectionMatrix = glm::ortho(-sizeX, sizeX, -sizeY, sizeY, 0.0f, (2.0f * distance));
-    lightProjectionMatrix[1][1] *= -1;  // compensate for GLM's OpenGL design, invert the y-axis.
-    
-    glm::mat4 lightViewMatrix = glm::lookAt(glm::vec3(directionalLight.lightProperties), uniformBuffersUpdatePackage.mainCamera->center, uniformBuffersUpdatePackage.mainCamera->up);
-    
-    sceneUniformBufferObject.lightSpaceMatrix = (lightProjectionMatrix * lightViewMatrix);
+        sceneLights.push_back(testLight);
+    }
+    sceneLights.resize(std::min(static_cast<uint32_t>(sceneLights.size()), uniformBuffersUpdatePackage.maxSceneLightCount));
+    if (sceneLights.size() > 1) {  // the governed light cap drops the last lights first, keeping at least a light.
+        sceneLights.resize(std::max(static_cast<uint32_t>(sceneLights.size() * uniformBuffersUpdatePackage.sceneLightFraction), 1u));
+    }
+    sceneUniformBufferObject.sceneLightCount = static_cast<uint32_t>(sceneLights.size());
+
+    glm::vec3 directionalLightDirection = -glm::normalize(glm::vec3(directionalLight.lightProperties));  // the light's properties point towards the light.
+    Uniform::calculateShadowCascades(inverseCameraMatrix, nearPlane, farPlane, directionalLightDirection, sceneUniformBufferObject.cascadeLightSpaceMatrices, sceneUniformBufferObject.cascadeSplitDepths);
+    sceneUniformBufferObject.cascadeCount = Defaults::rendererDefaults.SHADOW_CASCADE_COUNT;
 
     sceneUniformBufferObject.viewingPosition = uniformBuffersUpdatePackage.mainCamera->eye;
     
     sceneUniformBufferObject.ambientLightColor = glm::vec4(1.0f, 1.0f, 1.0f, 0.5f);
 
     sceneUniformBufferObject.farPlane = farPlane;
+    sceneUniformBufferObject.shadowFilterMode = Uniform::selectShadowFilterMode(Defaults::rendererDefaults.SHADOW_FILTER_MODE);
+
+    Uniform::ShadowAtlasState shadowAtlasState{};
+    glm::vec3 cameraPosition = glm::vec3(glm::inverse(sceneUniformBufferObject.viewMatrix)[3]);  // the view matrix includes the camera's zoom and rotation.
+    Uniform::allocateShadowAtlasTiles(cameraPosition, glm::radians(cameraFOV), nearPlane, sceneLights.data(), sceneUniformBufferObject.sceneLightCount, uniformBuffersUpdatePackage.shadowAtlasMaximumTileSize, *uniformBuffersUpdatePackage.shadowAtlasAllocator, shadowAtlasState);
+
+    float shadowAtlasSize = static_cast<float>(uniformBuffersUpdatePackage.shadowAtlasAllocator->atlasSize);
+    for (uint32_t i = 0; i < shadowAtlasState.tileCount; i += 1) {
+        const ShadowAtlas::AtlasTile& tile = shadowAtlasState.tiles[i];
+        
+        sceneUniformBufferObject.shadowAtlasTileMatrices[i] = shadowAtlasState.shadowAtlasUniformBufferObject.tileMatrices[i];
+        sceneUniformBufferObject.shadowAtlasTileRects[i] = (glm::vec4((tile.offsetX + 0.5f), (tile.offsetY + 0.5f), (tile.tileSize - 1.0f), (tile.tileSize - 1.0f)) / shadowAtlasSize);  // inset by half a texel, filtering never reads a neighbouring tile.
+    }
     
+    // the light clustering compute pass bins the lights into clusters with exponential depth slices, the scene shader finds its fragment's cluster with the same slicing.
+    float clusterDepthLogRange = std::log(farPlane / nearPlane);
+    sceneUniformBufferObject.clusterTileSize = glm::vec2((renderExtent.width / static_cast<float>(Uniform::clusterCountX)), (renderExtent.height / static_cast<float>(Uniform::clusterCountY)));
+    sceneUniformBufferObject.clusterDepthScale = (Uniform::clusterCountZ / clusterDepthLogRange);
+    sceneUniformBufferObject.clusterDepthBias = -((Uniform::clusterCountZ * std::log(nearPlane)) / clusterDepthLogRange);
+
+    sceneUniformBufferObject.inverseViewProjectionMatrix = glm::inverse(sceneUniformBufferObject.projectionMatrix * sceneUniformBufferObject.viewMatrix);  // the depth was rendered with the jittered projection.
+    sceneUniformBufferObject.framebufferExtent = glm::vec2(renderExtent.width, renderExtent.height);
+    sceneUniformBufferObject.textureLodBias = uniformBuffersUpdatePackage.textureLodBias;
+
     memcpy(uniformBuffersUpdatePackage.mappedSceneUniformBufferMemory, &sceneUniformBufferObject, sizeof(Uniform::SceneUniformBufferObject));
+    memcpy(uniformBuffersUpdatePackage.mappedSceneLightBufferMemory, sceneLights.data(), (sceneUniformBufferObject.sceneLightCount * sizeof(Uniform::SceneLight)));
+
+    Uniform::ClusteringUniformBufferObject clusteringUniformBufferObject{};
+
+    clusteringUniformBufferObject.inverseProjectionMatrix = glm::inverse(sceneUniformBufferObject.projectionMatrix);
+    clusteringUniformBufferObject.viewMatrix = sceneUniformBufferObject.viewMatrix;
+    clusteringUniformBufferObject.nearPlane = nearPlane;
+    clusteringUniformBufferObject.farPlane = farPlane;
+    clusteringUniformBufferObject.sceneLightCount = sceneUniformBufferObject.sceneLightCount;
+
+    memcpy(uniformBuffersUpdatePackage.mappedClusteringUniformBufferMemory, &clusteringUniformBufferObject, sizeof(Uniform::ClusteringUniformBufferObject));
 
     
     Uniform::SceneNormalsUniformBufferObject sceneNormalsUniformBufferObject{};
@@ -128,26 +213,20 @@ void Uniform::updateFrameUniformBuffers(Uniform::UniformBuffersUpdatePackage& un
     
     Uniform::DirectionalShadowUniformBufferObject directionalShadowUniformBufferObject{};
 
-    directionalShadowUniformBufferObject.lightSpaceMatrix = sceneUniformBufferObject.lightSpaceMatrix;
+    std::copy(std::begin(sceneUniformBufferObject.cascadeLightSpaceMatrices), std::end(sceneUniformBufferObject.cascadeLightSpaceMatrices), std::begin(directionalShadowUniformBufferObject.cascadeLightSpaceMatrices));
     directionalShadowUniformBufferObject.modelMatrix = sceneUniformBufferObject.modelMatrix;
     
     memcpy(uniformBuffersUpdatePackage.mappedDirectionalShadowUniformBufferMemory, &directionalShadowUniformBufferObject, sizeof(Uniform::DirectionalShadowUniformBufferObject));
+    uniformBuffersUpdatePackage.directionalShadowUniformBufferObject = directionalShadowUniformBufferObject;
 
 
     glm::vec3 pointLightPosition = glm::vec3(pointLight.lightProperties);
-    Shader::shadowTransforms[0] = glm::lookAt(pointLightPosition, (pointLightPosition + glm::vec3(1.0f, 0.0f, 0.0f)), glm::vec3(0.0f, -1.0f, 0.0f));  // +X
-    Shader::shadowTransforms[1] = glm::lookAt(pointLightPosition, (pointLightPosition + glm::vec3(-1.0f, 0.0f, 0.0f)), glm::vec3(0.0f, -1.0f, 0.0f));  // -X
-    
-    Shader::shadowTransforms[2] = glm::lookAt(pointLightPosition, (pointLightPosition + glm::vec3(0.0f, 1.0f, 0.0f)), glm::vec3(0.0f, 0.0f, 1.0f));  // Y+
-    Shader::shadowTransforms[3] = glm::lookAt(pointLightPosition, (pointLightPosition + glm::vec3(0.0f, -1.0f, 0.0f)), glm::vec3(0.0f, 0.0f, -1.0f));  // Y-
-    
-    Shader::shadowTransforms[4] = glm::lookAt(pointLightPosition, (pointLightPosition + glm::vec3(0.0f, 0.0f, 1.0f)), glm::vec3(0.0f, -1.0f, 0.0f));  // Z+
-    Shader::shadowTransforms[5] = glm::lookAt(pointLightPosition, (pointLightPosition + glm::vec3(0.0f, 0.0f, -1.0f)), glm::vec3(0.0f, -1.0f, 0.0f));  // Z-
-    
 
     Uniform::PointShadowUniformBufferObject pointShadowUniformBufferObject{};
 
-    pointShadowUniformBufferObject.projectionMatrix = glm::perspective(glm::radians(90.0f), aspectRatio, nearPlane, farPlane);
+    Uniform::calculateCubemapViewMatrices(pointLightPosition, pointShadowUniformBufferObject.viewMatrices);
+    
+    pointShadowUniformBufferObject.projectionMatrix = glm::perspective(glm::radians(90.0f), 1.0f, nearPlane, farPlane);  // cubemap faces are square, independent of the swapchain.
     // pointShadowUniformBufferObject.projectionMatrix[1][1] *= -1;
     pointShadowUniformBufferObject.modelMatrix = sceneUniformBufferObject.modelMatrix;
 
@@ -155,6 +234,444 @@ void Uniform::updateFrameUniformBuffers(Uniform::UniformBuffersUpdatePackage& un
     pointShadowUniformBufferObject.farPlane = farPlane;
 
     memcpy(uniformBuffersUpdatePackage.mappedPointShadowUniformBufferMemory, &pointShadowUniformBufferObject, sizeof(Uniform::PointShadowUniformBufferObject));
+    uniformBuffersUpdatePackage.pointShadowUniformBufferObject = pointShadowUniformBufferObject;
+
+    Uniform::calculateVisibleCubemapFaces(inverseCameraMatrix, pointLightPosition, uniformBuffersUpdatePackage.pointShadowVisibleFaceMask);
+
+
+    shadowAtlasState.shadowAtlasUniformBufferObject.modelMatrix = sceneUniformBufferObject.modelMatrix;
+
+    memcpy(uniformBuffersUpdatePackage.mappedShadowAtlasUniformBufferMemory, &shadowAtlasState.shadowAtlasUniformBufferObject, sizeof(Uniform::ShadowAtlasUniformBufferObject));
+    uniformBuffersUpdatePackage.shadowAtlasState = shadowAtlasState;
+
+
+    // cull the shadow casters in each shadow view, the main mesh is the only caster.
+    glm::vec3 meshBoundsCenter = ((uniformBuffersUpdatePackage.mainMeshBoundsMinimum + uniformBuffersUpdatePackage.mainMeshBoundsMaximum) / 2.0f);
+    float meshBoundsRadius = (glm::length(uniformBuffersUpdatePackage.mainMeshBoundsMaximum - uniformBuffersUpdatePackage.mainMeshBoundsMinimum) / 2.0f);
+    float modelMatrixScale = std::max({glm::length(glm::vec3(sceneUniformBufferObject.modelMatrix[0])), glm::length(glm::vec3(sceneUniformBufferObject.modelMatrix[1])), glm::length(glm::vec3(sceneUniformBufferObject.modelMatrix[2]))});
+    glm::vec4 mainMeshBoundingSphere = glm::vec4(glm::vec3(sceneUniformBufferObject.modelMatrix * glm::vec4(meshBoundsCenter, 1.0f)), (meshBoundsRadius * modelMatrixScale));
+
+    uint32_t directionalShadowCascadeMask;
+    Uniform::cullShadowCaster(mainMeshBoundingSphere, directionalShadowUniformBufferObject.cascadeLightSpaceMatrices, Defaults::rendererDefaults.SHADOW_CASCADE_COUNT, directionalShadowCascadeMask);  // the cascades only cover the camera frustum.
+    for (uint32_t i = 0; i < Uniform::maxShadowCascadeCount; i += 1) {
+        uniformBuffersUpdatePackage.directionalShadowCascadeCasterMasks[i] = (((directionalShadowCascadeMask & (1u << i)) != 0) ? 1u : 0u);
+    }
+
+    glm::mat4 pointShadowFaceMatrices[6];
+    for (size_t i = 0; i < 6; i += 1) {
+        pointShadowFaceMatrices[i] = (pointShadowUniformBufferObject.projectionMatrix * pointShadowUniformBufferObject.viewMatrices[i]);
+    }
+    
+    uint32_t pointShadowFaceMask = 0;
+    if (Uniform::pointShadowReachesFrustum(mainMeshBoundingSphere, pointLightPosition, cameraMatrix) == true) {
+        Uniform::cullShadowCaster(mainMeshBoundingSphere, pointShadowFaceMatrices, 6, pointShadowFaceMask);
+    }
+    for (uint32_t i = 0; i < 6; i += 1) {
+        uniformBuffersUpdatePackage.pointShadowFaceCasterMasks[i] = (((pointShadowFaceMask & (1u << i)) != 0) ? 1u : 0u);
+    }
+
+    for (uint32_t i = 0; i < shadowAtlasState.tileCount; i += 1) {  // tiles are culled one by one, there can be more tiles than mask bits.
+        const Uniform::ShadowAtlasUniformBufferObject& shadowAtlasUniformBufferObject = shadowAtlasState.shadowAtlasUniformBufferObject;
+        
+        uint32_t tileViewMask;
+        if (shadowAtlasUniformBufferObject.tileProjections[i].x == Uniform::dualParaboloidShadowProjection) {
+            tileViewMask = (Uniform::paraboloidCasterVisible(mainMeshBoundingSphere, shadowAtlasUniformBufferObject.tileMatrices[i], shadowAtlasUniformBufferObject.tileLightPositions[i].w) ? 1u : 0u);
+        } else {
+            Uniform::cullShadowCaster(mainMeshBoundingSphere, &shadowAtlasUniformBufferObject.tileMatrices[i], 1, tileViewMask);
+        }
+        uniformBuffersUpdatePackage.shadowAtlasTileCasterMasks[i] = tileViewMask;
+    }
+
+
+    // the culling compute pass culls every instance against each stream's frustums, each of the main mesh's chunks is an instance.
+    // a masked chunk has no opaque indices, its masked draw starts at its own first index.
+    // instances that haven't moved since the previous frame are static and come first, the CPU culling scene only rebuilds its static hierarchy when they change.
+    // dynamic instances follow them, and are refit every frame.
+    bool mainMeshStatic = (sceneUniformBufferObject.modelMatrix == uniformBuffersUpdatePackage.previousMainMeshModelMatrix);
+    std::vector<Uniform::CullingInstance> cullingInstances;
+    for (const ModelHandler::MeshChunk& meshChunk : *uniformBuffersUpdatePackage.mainMeshChunks) {
+        Uniform::CullingInstance chunkInstance{};
+        chunkInstance.modelMatrix = sceneUniformBufferObject.modelMatrix;
+        chunkInstance.normalMatrix = sceneUniformBufferObject.normalMatrix;
+        chunkInstance.boundingSphere = glm::vec4(((meshChunk.boundsMinimum + meshChunk.boundsMaximum) / 2.0f), (glm::length(meshChunk.boundsMaximum - meshChunk.boundsMinimum) / 2.0f));
+        chunkInstance.drawParameters = ((meshChunk.masked == true) ? glm::uvec4(0, meshChunk.firstIndex, 0, meshChunk.indiceCount) : glm::uvec4(meshChunk.indiceCount, meshChunk.firstIndex, 0, 0));
+        chunkInstance.previousModelMatrix = uniformBuffersUpdatePackage.previousMainMeshModelMatrix;
+
+        cullingInstances.push_back(chunkInstance);
+    }
+    uint32_t staticCullingInstanceCount = ((mainMeshStatic == true) ? static_cast<uint32_t>(cullingInstances.size()) : 0);
+
+    uniformBuffersUpdatePackage.cullingInstanceCount = std::min(static_cast<uint32_t>(cullingInstances.size()), uniformBuffersUpdatePackage.maxCullingInstanceCount);
+    memcpy(uniformBuffersUpdatePackage.mappedCullingInstanceBufferMemory, cullingInstances.data(), (uniformBuffersUpdatePackage.cullingInstanceCount * sizeof(Uniform::CullingInstance)));
+
+    Uniform::CullingUniformBufferObject cullingUniformBufferObject{};
+    uint32_t cullingFrustumCount = 0;
+    auto appendStreamFrustums = [&](uint32_t cullingStream, const glm::mat4 viewProjectionMatrices[], uint32_t viewCount) {
+        cullingUniformBufferObject.streamFrustumRanges[cullingStream] = glm::uvec4(cullingFrustumCount, viewCount, 0, 0);
+        for (uint32_t i = 0; i < viewCount; i += 1) {
+            Uniform::extractFrustumPlanes(viewProjectionMatrices[i], &cullingUniformBufferObject.frustumPlanes[cullingFrustumCount * 6]);
+            cullingFrustumCount += 1;
+        }
+    };
+
+    appendStreamFrustums(Uniform::sceneCullingStream, &cameraMatrix, 1);
+    appendStreamFrustums(Uniform::directionalShadowCullingStream, directionalShadowUniformBufferObject.cascadeLightSpaceMatrices, Defaults::rendererDefaults.SHADOW_CASCADE_COUNT);
+    appendStreamFrustums(Uniform::pointShadowCullingStream, pointShadowFaceMatrices, 6);
+
+    cullingUniformBufferObject.cameraMatrix = cameraMatrix;
+    cullingUniformBufferObject.depthPyramidExtent = glm::vec2(uniformBuffersUpdatePackage.depthPyramidExtent.width, uniformBuffersUpdatePackage.depthPyramidExtent.height);
+    cullingUniformBufferObject.depthPyramidRenderScale = (glm::vec2(renderExtent.width, renderExtent.height) / glm::vec2(uniformBuffersUpdatePackage.swapchainImageExtent.width, uniformBuffersUpdatePackage.swapchainImageExtent.height));
+    cullingUniformBufferObject.depthPyramidLevelCount = uniformBuffersUpdatePackage.depthPyramidLevelCount;
+    cullingUniformBufferObject.occlusionCullingEnabled = (uniformBuffersUpdatePackage.occlusionCullingEnabled ? 1u : 0u);
+    cullingUniformBufferObject.instanceCount = uniformBuffersUpdatePackage.cullingInstanceCount;
+    cullingUniformBufferObject.maxInstanceCount = uniformBuffersUpdatePackage.maxCullingInstanceCount;
+
+    memcpy(uniformBuffersUpdatePackage.mappedCullingUniformBufferMemory, &cullingUniformBufferObject, sizeof(Uniform::CullingUniformBufferObject));
+
+    // the motion vectors reproject each pixel into the previous frame with the camera alone, the instances are drawn over them with their own previous transforms.
+    if (uniformBuffersUpdatePackage.mappedTemporalUniformBufferMemory != nullptr) {
+        Uniform::TemporalUniformBufferObject temporalUniformBufferObject{};
+
+        temporalUniformBufferObject.projectionMatrix = sceneUniformBufferObject.projectionMatrix;
+        temporalUniformBufferObject.viewMatrix = sceneUniformBufferObject.viewMatrix;
+        temporalUniformBufferObject.cameraMatrix = cameraMatrix;
+        temporalUniformBufferObject.previousCameraMatrix = uniformBuffersUpdatePackage.previousCameraMatrix;
+        temporalUniformBufferObject.cameraReprojectionMatrix = (uniformBuffersUpdatePackage.previousCameraMatrix * inverseCameraMatrix);
+        temporalUniformBufferObject.projectionJitter = projectionJitter;
+        temporalUniformBufferObject.renderExtent = glm::vec2(renderExtent.width, renderExtent.height);
+
+        memcpy(uniformBuffersUpdatePackage.mappedTemporalUniformBufferMemory, &temporalUniformBufferObject, sizeof(Uniform::TemporalUniformBufferObject));
+    }
+    uniformBuffersUpdatePackage.cameraMatrix = cameraMatrix;
+    uniformBuffersUpdatePackage.mainMeshModelMatrix = sceneUniformBufferObject.modelMatrix;
+
+    if (uniformBuffersUpdatePackage.cpuCullingScene != nullptr) {  // the same streams the culling compute pass writes, culled against the same frustums.
+        BoundingVolumeHierarchy::CullingScene& cpuCullingScene = *uniformBuffersUpdatePackage.cpuCullingScene;
+        cpuCullingScene.updateCullingScene(cullingInstances.data(), uniformBuffersUpdatePackage.cullingInstanceCount, std::min(staticCullingInstanceCount, uniformBuffersUpdatePackage.cullingInstanceCount));  // the chunks of a main mesh that moved are culled as dynamic instances that frame.
+
+        // the occluders are rasterized before any occludee is tested, the whole main mesh is the only occluder and its chunks are the occludees.
+        // a chunk's box is never hidden behind its own triangles, the occlusion buffer is only used once the main mesh is split into several chunks.
+        MaskedOcclusion::OcclusionBuffer *cpuOcclusionBuffer = ((uniformBuffersUpdatePackage.cullingInstanceCount > 1) ? uniformBuffersUpdatePackage.cpuOcclusionBuffer : nullptr);
+        if (cpuOcclusionBuffer != nullptr) {
+            MaskedOcclusion::Occluder mainMeshOccluder = {uniformBuffersUpdatePackage.mainMeshOccluderMesh, sceneUniformBufferObject.modelMatrix};
+            cpuOcclusionBuffer->rasterizeOccluders(&mainMeshOccluder, 1, cameraMatrix);
+        }
+        uniformBuffersUpdatePackage.cpuOccludedInstanceCount = 0;
+
+        std::vector<uint32_t> visibleInstances;
+        for (uint32_t i = 0; i < Uniform::frustumCullingStreamCount; i += 1) {  // the late scene stream stays empty, the CPU occlusion test needs no second phase.
+            glm::uvec4 frustumRange = cullingUniformBufferObject.streamFrustumRanges[i];
+            cpuCullingScene.cullCullingScene(&cullingUniformBufferObject.frustumPlanes[frustumRange.x * 6], frustumRange.y, visibleInstances);
+
+            if ((i == Uniform::sceneCullingStream) && (cpuOcclusionBuffer != nullptr)) {
+                auto occludedInstancesBegin = std::remove_if(visibleInstances.begin(), visibleInstances.end(), [&](uint32_t instanceIndex) {
+                    const BoundingVolumeHierarchy::AxisAlignedBox& instanceBox = cpuCullingScene.instanceBoxes[instanceIndex];
+                    return cpuOcclusionBuffer->testOccludeeBox(instanceBox.minimum, instanceBox.maximum, cameraMatrix);
+                });
+                uniformBuffersUpdatePackage.cpuOccludedInstanceCount = static_cast<uint32_t>(std::distance(occludedInstancesBegin, visibleInstances.end()));
+                visibleInstances.erase(occludedInstancesBegin, visibleInstances.end());
+            }
+
+            std::vector<VkDrawIndexedIndirectCommand>& culledDrawCommands = uniformBuffersUpdatePackage.cpuCulledDrawCommands[i];
+            std::vector<VkDrawIndexedIndirectCommand>& culledMaskedDrawCommands = uniformBuffersUpdatePackage.cpuCulledDrawCommands[i + Uniform::maskedCullingStreamOffset];
+            culledDrawCommands.clear();
+            culledMaskedDrawCommands.clear();
+            for (uint32_t instanceIndex : visibleInstances) {
+                const glm::uvec4& drawParameters = cullingInstances[instanceIndex].drawParameters;
+                if (drawParameters.x > 0) {
+                    culledDrawCommands.push_back({drawParameters.x, 1, drawParameters.y, static_cast<int32_t>(drawParameters.z), instanceIndex});  // the first instance selects the instance data, like the culled indirect draws.
+                }
+                if (drawParameters.w > 0) {
+                    culledMaskedDrawCommands.push_back({drawParameters.w, 1, (drawParameters.y + drawParameters.x), static_cast<int32_t>(drawParameters.z), instanceIndex});
+                }
+            }
+        }
+    }
+}
+
+void Uniform::calculateShadowCascades(glm::mat4 inverseCameraMatrix, float nearPlane, float farPlane, glm::vec3 lightDirection, glm::mat4 cascadeLightSpaceMatrices[], glm::vec4& cascadeSplitDepths)
+{
+    const uint32_t cascadeCount = Defaults::rendererDefaults.SHADOW_CASCADE_COUNT;
+    const float shadowDistance = std::min(Defaults::rendererDefaults.SHADOW_DISTANCE, farPlane);
+    const float shadowResolution = static_cast<float>(Defaults::rendererDefaults.DIRECTIONAL_SHADOW_RESOLUTION);
+    
+    // the camera frustum's near and far corners in world space.
+    glm::vec3 nearFrustumCorners[4];
+    glm::vec3 farFrustumCorners[4];
+    for (size_t i = 0; i < 4; i += 1) {
+        glm::vec2 NDCCorner = glm::vec2(((i & 1) ? 1.0f : -1.0f), ((i & 2) ? 1.0f : -1.0f));
+        
+        glm::vec4 nearFrustumCorner = (inverseCameraMatrix * glm::vec4(NDCCorner, -1.0f, 1.0f));  // the camera projection has a -1..1 depth range.
+        glm::vec4 farFrustumCorner = (inverseCameraMatrix * glm::vec4(NDCCorner, 1.0f, 1.0f));
+        nearFrustumCorners[i] = (glm::vec3(nearFrustumCorner) / nearFrustumCorner.w);
+        farFrustumCorners[i] = (glm::vec3(farFrustumCorner) / farFrustumCorner.w);
+    }
+
+    float previousSplitDepth = nearPlane;
+    for (uint32_t i = 0; i < Uniform::maxShadowCascadeCount; i += 1) {
+        if (i >= cascadeCount) {  // unused cascades are never selected.
+            cascadeLightSpaceMatrices[i] = cascadeLightSpaceMatrices[cascadeCount - 1];
+            cascadeSplitDepths[i] = cascadeSplitDepths[cascadeCount - 1];
+            continue;
+        }
+        
+        // practical split scheme: a blend of logarithmic(even texel density) and linear(even distance) splits.
+        float splitFraction = (static_cast<float>(i + 1) / cascadeCount);
+        float logarithmicSplitDepth = (nearPlane * std::pow((shadowDistance / nearPlane), splitFraction));
+        float linearSplitDepth = (nearPlane + ((shadowDistance - nearPlane) * splitFraction));
+        float splitDepth = ((Defaults::rendererDefaults.SHADOW_CASCADE_SPLIT_LAMBDA * logarithmicSplitDepth) + ((1.0f - Defaults::rendererDefaults.SHADOW_CASCADE_SPLIT_LAMBDA) * linearSplitDepth));
+
+        // the corners of the frustum slice, the frustum edges are linear in view depth.
+        glm::vec3 sliceCorners[8];
+        glm::vec3 sliceCenter = glm::vec3(0.0f);
+        for (size_t j = 0; j < 4; j += 1) {
+            glm::vec3 frustumEdge = (farFrustumCorners[j] - nearFrustumCorners[j]);
+            sliceCorners[j] = (nearFrustumCorners[j] + (frustumEdge * ((previousSplitDepth - nearPlane) / (farPlane - nearPlane))));
+            sliceCorners[j + 4] = (nearFrustumCorners[j] + (frustumEdge * ((splitDepth - nearPlane) / (farPlane - nearPlane))));
+
+            sliceCenter += (sliceCorners[j] + sliceCorners[j + 4]);
+        }
+        sliceCenter /= 8.0f;
+
+        // a bounding sphere keeps the cascade's size constant as the camera rotates.
+        float sliceRadius = 0.0f;
+        for (glm::vec3 sliceCorner : sliceCorners) {
+            sliceRadius = std::max(sliceRadius, glm::length(sliceCorner - sliceCenter));
+        }
+        sliceRadius = (std::ceil(sliceRadius * 16.0f) / 16.0f);
+
+        glm::vec3 lightUp = ((std::abs(lightDirection.y) > 0.99f) ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(0.0f, 1.0f, 0.0f));
+        glm::mat4 lightViewMatrix = glm::lookAt(sliceCenter, (sliceCenter + lightDirection), lightUp);
+        glm::mat4 lightProjectionMatrix = glm::orthoRH_ZO(-sliceRadius, sliceRadius, -sliceRadius, sliceRadius, -(2.0f * sliceRadius), sliceRadius);  // extended towards the light to catch casters outside of the slice.
+
+        // snap the cascade to whole shadow map texels, removing shimmering as the camera moves.
+        glm::vec4 shadowOrigin = ((lightProjectionMatrix * lightViewMatrix) * glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
+        shadowOrigin *= (shadowResolution / 2.0f);
+        glm::vec2 shadowOriginOffset = ((glm::round(glm::vec2(shadowOrigin)) - glm::vec2(shadowOrigin)) * (2.0f / shadowResolution));
+        lightProjectionMatrix[3][0] += shadowOriginOffset.x;
+        lightProjectionMatrix[3][1] += shadowOriginOffset.y;
+
+        cascadeLightSpaceMatrices[i] = (lightProjectionMatrix * lightViewMatrix);
+        cascadeSplitDepths[i] = splitDepth;
+
+        previousSplitDepth = splitDepth;
+    }
+}
+
+uint32_t Uniform::selectShadowFilterMode(const std::string& shadowFilterModeName)
+{
+    if (shadowFilterModeName == "PCF") {
+        return Uniform::pcfShadowFilter;
+    } else if (shadowFilterModeName == "POISSON") {
+        return Uniform::poissonShadowFilter;
+    } else if (shadowFilterModeName == "PCSS") {
+        return Uniform::pcssShadowFilter;
+    }
+
+    throwDebugException("Unknown shadow filter mode \"" + shadowFilterModeName + "\".");
+}
+
+float Uniform::calculateLightRange(glm::vec4 lightColor)
+{
+    // solve the scene shader's attenuation, 1 / (1 + 0.09d + 0.032d^2), for the distance the brightest channel drops to 1/256 at.
+    float peakIntensity = (std::max({lightColor.r, lightColor.g, lightColor.b}) * lightColor.w);
+    float attenuationDenominator = std::max((peakIntensity * 256.0f), 1.0f);
+    float lightRange = ((-0.09f + std::sqrt((0.09f * 0.09f) + (4.0f * 0.032f * (attenuationDenominator - 1.0f)))) / (2.0f * 0.032f));
+
+    return std::max(lightRange, 1.0f);  // keeps the shadow atlas tile far plane beyond the near plane.
+}
+
+void Uniform::allocateShadowAtlasTiles(glm::vec3 cameraPosition, float cameraFOV, float nearPlane, Uniform::SceneLight sceneLights[], uint32_t sceneLightCount, uint32_t maximumTileSize, ShadowAtlas::QuadtreeAllocator& shadowAtlasAllocator, Uniform::ShadowAtlasState& shadowAtlasState)
+{
+    shadowAtlasAllocator.resetAllocator(Defaults::rendererDefaults.SHADOW_ATLAS_RESOLUTION, Defaults::rendererDefaults.SHADOW_ATLAS_MINIMUM_TILE_SIZE);
+    shadowAtlasState.tileCount = 0;
+
+    std::vector<std::pair<uint32_t, uint32_t>> lightTileSizes;  // structured as [scene light index, requested tile size].
+    for (uint32_t i = 0; i < sceneLightCount; i += 1) {
+        if ((sceneLights[i].lightID == 0) || (sceneLights[i].shadowIndex != Uniform::noShadowIndex)) {  // directional lights, lights with a dedicated shadow map, and shadowless lights.
+            continue;
+        }
+
+        // the fraction of the screen height covered by the light's range, the whole screen if the camera is within it.
+        float lightDistance = glm::length(glm::vec3(sceneLights[i].lightProperties) - cameraPosition);
+        float screenCoverage = 1.0f;
+        if (lightDistance > sceneLights[i].lightRange) {
+            screenCoverage = (sceneLights[i].lightRange / (lightDistance * std::tan(cameraFOV / 2.0f)));
+        }
+        float lightImportance = sceneLights[i].lightColor.w;  // brighter lights get sharper shadows.
+
+        lightTileSizes.push_back({i, ShadowAtlas::calculateTileSize(screenCoverage, lightImportance, maximumTileSize, Defaults::rendererDefaults.SHADOW_ATLAS_MINIMUM_TILE_SIZE)});
+    }
+
+    // the largest tiles(the most covering and important lights) are allocated first, the least significant lights are left unshadowed if the atlas fills up.
+    std::stable_sort(lightTileSizes.begin(), lightTileSizes.end(), [](const std::pair<uint32_t, uint32_t>& lightTileSize, const std::pair<uint32_t, uint32_t>& otherLightTileSize) { return lightTileSize.second > otherLightTileSize.second; });
+
+    for (const std::pair<uint32_t, uint32_t>& lightTileSize : lightTileSizes) {
+        Uniform::SceneLight& sceneLight = sceneLights[lightTileSize.first];
+        glm::vec3 lightPosition = glm::vec3(sceneLight.lightProperties);
+
+        std::vector<glm::mat4> tileMatrices;
+        if ((sceneLight.lightID == 1) && (sceneLight.shadowProjection == Uniform::dualParaboloidShadowProjection)) {  // a tile for each hemisphere, projected in the shadow atlas vertex shader.
+            glm::mat4 hemisphereViewMatrices[2];
+            Uniform::calculateParaboloidViewMatrices(lightPosition, hemisphereViewMatrices);
+            
+            tileMatrices.assign(std::begin(hemisphereViewMatrices), std::end(hemisphereViewMatrices));
+        } else if (sceneLight.lightID == 1) {  // a tile for each cubemap face, ordered as +X, -X, +Y, -Y, +Z, -Z.
+            glm::mat4 faceViewMatrices[6];
+            Uniform::calculateCubemapViewMatrices(lightPosition, faceViewMatrices);
+            
+            glm::mat4 faceProjectionMatrix = glm::perspectiveRH_ZO(glm::radians(90.0f), 1.0f, nearPlane, sceneLight.lightRange);
+            for (glm::mat4 faceViewMatrix : faceViewMatrices) {
+                tileMatrices.push_back(faceProjectionMatrix * faceViewMatrix);
+            }
+        } else {  // a single tile covering the spotlight's cone.
+            glm::vec3 spotlightDirection = glm::normalize(glm::vec3(sceneLight.lightDirection));
+            glm::vec3 spotlightUp = ((std::abs(spotlightDirection.y) > 0.99f) ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(0.0f, 1.0f, 0.0f));
+            float spotlightFOV = (2.0f * std::acos(sceneLight.lightDirection.w));
+
+            tileMatrices.push_back(glm::perspectiveRH_ZO(spotlightFOV, 1.0f, nearPlane, sceneLight.lightRange) * glm::lookAt(lightPosition, (lightPosition + spotlightDirection), spotlightUp));
+        }
+
+        uint32_t lightTileCount = static_cast<uint32_t>(tileMatrices.size());
+        if ((shadowAtlasState.tileCount + lightTileCount) > Uniform::maxShadowAtlasTileCount) {
+            continue;
+        }
+
+        std::vector<ShadowAtlas::AtlasTile> lightTiles(lightTileCount);
+        uint32_t allocatedTileCount = 0;
+        while ((allocatedTileCount < lightTileCount) && (shadowAtlasAllocator.allocateTile(lightTileSize.second, lightTiles[allocatedTileCount]) == true)) {
+            allocatedTileCount += 1;
+        }
+        if (allocatedTileCount < lightTileCount) {  // the tiles of a light that only partly fit are freed again.
+            for (uint32_t i = 0; i < allocatedTileCount; i += 1) {
+                shadowAtlasAllocator.freeTile(lightTiles[i]);
+            }
+            continue;
+        }
+
+        sceneLight.shadowIndex = shadowAtlasState.tileCount;
+        for (uint32_t i = 0; i < lightTileCount; i += 1) {
+            uint32_t tileIndex = (shadowAtlasState.tileCount + i);
+            
+            shadowAtlasState.shadowAtlasUniformBufferObject.tileMatrices[tileIndex] = tileMatrices[i];
+            shadowAtlasState.shadowAtlasUniformBufferObject.tileLightPositions[tileIndex] = glm::vec4(lightPosition, sceneLight.lightRange);
+            shadowAtlasState.shadowAtlasUniformBufferObject.tileProjections[tileIndex] = glm::uvec4(((sceneLight.lightID == 1) ? sceneLight.shadowProjection : Uniform::cubeShadowProjection), 0, 0, 0);
+            shadowAtlasState.tiles[tileIndex] = lightTiles[i];
+        }
+        shadowAtlasState.tileCount += lightTileCount;
+    }
+}
+
+void Uniform::calculateParaboloidViewMatrices(glm::vec3 paraboloidPosition, glm::mat4 viewMatrices[2])
+{
+    viewMatrices[0] = glm::lookAt(paraboloidPosition, (paraboloidPosition + glm::vec3(0.0f, 0.0f, -1.0f)), glm::vec3(0.0f, 1.0f, 0.0f));  // -Z
+    viewMatrices[1] = glm::lookAt(paraboloidPosition, (paraboloidPosition + glm::vec3(0.0f, 0.0f, 1.0f)), glm::vec3(0.0f, 1.0f, 0.0f));  // +Z
+}
+
+bool Uniform::paraboloidCasterVisible(glm::vec4 casterBoundingSphere, glm::mat4 viewMatrix, float lightRange)
+{
+    glm::vec3 casterCenterViewSpace = glm::vec3(viewMatrix * glm::vec4(glm::vec3(casterBoundingSphere), 1.0f));  // the view matrix is rigid, the radius is unchanged.
+
+    bool casterBehind = (-casterCenterViewSpace.z < -casterBoundingSphere.w);  // fully behind the hemisphere's base plane.
+    bool casterBeyondRange = ((glm::length(casterCenterViewSpace) - casterBoundingSphere.w) > lightRange);
+    
+    return ((casterBehind == false) && (casterBeyondRange == false));
+}
+
+void Uniform::calculateCubemapViewMatrices(glm::vec3 cubemapPosition, glm::mat4 viewMatrices[6])
+{
+    viewMatrices[0] = glm::lookAt(cubemapPosition, (cubemapPosition + glm::vec3(1.0f, 0.0f, 0.0f)), glm::vec3(0.0f, -1.0f, 0.0f));  // +X
+    viewMatrices[1] = glm::lookAt(cubemapPosition, (cubemapPosition + glm::vec3(-1.0f, 0.0f, 0.0f)), glm::vec3(0.0f, -1.0f, 0.0f));  // -X
+    
+    viewMatrices[2] = glm::lookAt(cubemapPosition, (cubemapPosition + glm::vec3(0.0f, 1.0f, 0.0f)), glm::vec3(0.0f, 0.0f, 1.0f));  // Y+
+    viewMatrices[3] = glm::lookAt(cubemapPosition, (cubemapPosition + glm::vec3(0.0f, -1.0f, 0.0f)), glm::vec3(0.0f, 0.0f, -1.0f));  // Y-
+    
+    viewMatrices[4] = glm::lookAt(cubemapPosition, (cubemapPosition + glm::vec3(0.0f, 0.0f, 1.0f)), glm::vec3(0.0f, -1.0f, 0.0f));  // Z+
+    viewMatrices[5] = glm::lookAt(cubemapPosition, (cubemapPosition + glm::vec3(0.0f, 0.0f, -1.0f)), glm::vec3(0.0f, -1.0f, 0.0f));  // Z-
+}
+
+void Uniform::calculateVisibleCubemapFaces(glm::mat4 inverseCameraMatrix, glm::vec3 cubemapPosition, uint32_t& visibleFaceMask)
+{
+    glm::vec3 frustumCorners[8];
+    for (size_t i = 0; i < 8; i += 1) {
+        glm::vec4 NDCCorner = glm::vec4(((i & 1) ? 1.0f : -1.0f), ((i & 2) ? 1.0f : -1.0f), ((i & 4) ? 1.0f : -1.0f), 1.0f);  // the camera projection has a -1..1 depth range.
+        
+        glm::vec4 frustumCorner = (inverseCameraMatrix * NDCCorner);
+        frustumCorners[i] = ((glm::vec3(frustumCorner) / frustumCorner.w) - cubemapPosition);
+    }
+
+    visibleFaceMask = 0;
+    for (uint32_t i = 0; i < 6; i += 1) {
+        // a face's frustum is the 90 degree pyramid around its axis, bounded by four side planes through the cubemap position.
+        glm::vec3 faceAxis = glm::vec3(0.0f);
+        faceAxis[i / 2] = ((i % 2 == 0) ? 1.0f : -1.0f);
+        glm::vec3 faceTangent = glm::vec3(0.0f);
+        faceTangent[((i / 2) + 1) % 3] = 1.0f;
+        glm::vec3 faceBitangent = glm::vec3(0.0f);
+        faceBitangent[((i / 2) + 2) % 3] = 1.0f;
+
+        glm::vec3 sidePlaneNormals[4] = {(faceAxis - faceTangent), (faceAxis + faceTangent), (faceAxis - faceBitangent), (faceAxis + faceBitangent)};
+
+        bool faceVisible = true;
+        for (glm::vec3 sidePlaneNormal : sidePlaneNormals) {
+            bool cornersOutside = std::all_of(std::begin(frustumCorners), std::end(frustumCorners), [&](glm::vec3 frustumCorner) { return glm::dot(sidePlaneNormal, frustumCorner) < 0.0f; });
+            if (cornersOutside == true) {
+                faceVisible = false;
+                break;
+            }
+        }
+
+        if (faceVisible == true) {
+            visibleFaceMask |= (1u << i);
+        }
+    }
+}
+
+void Uniform::extractFrustumPlanes(glm::mat4 viewProjectionMatrix, glm::vec4 frustumPlanes[6])
+{
+    // the clip space inequalities as planes of the matrix rows(glm matrices are column-major).
+    glm::mat4 transposedMatrix = glm::transpose(viewProjectionMatrix);
+    frustumPlanes[0] = (transposedMatrix[3] + transposedMatrix[0]);  // -w <= x.
+    frustumPlanes[1] = (transposedMatrix[3] - transposedMatrix[0]);  // x <= w.
+    frustumPlanes[2] = (transposedMatrix[3] + transposedMatrix[1]);  // -w <= y.
+    frustumPlanes[3] = (transposedMatrix[3] - transposedMatrix[1]);  // y <= w.
+    frustumPlanes[4] = (transposedMatrix[3] + transposedMatrix[2]);  // -w <= z, the projections have glm's default -1..1 depth range.
+    frustumPlanes[5] = (transposedMatrix[3] - transposedMatrix[2]);  // z <= w.
+
+    for (size_t i = 0; i < 6; i += 1) {
+        frustumPlanes[i] /= glm::length(glm::vec3(frustumPlanes[i]));
+    }
+}
+
+void Uniform::cullShadowCaster(glm::vec4 casterBoundingSphere, const glm::mat4 viewProjectionMatrices[], uint32_t viewCount, uint32_t& visibleViewMask)
+{
+    visibleViewMask = 0;
+    for (uint32_t i = 0; i < viewCount; i += 1) {
+        glm::vec4 frustumPlanes[6];
+        Uniform::extractFrustumPlanes(viewProjectionMatrices[i], frustumPlanes);
+
+        bool casterVisible = std::none_of(std::begin(frustumPlanes), std::end(frustumPlanes), [&](glm::vec4 frustumPlane) { return (glm::dot(glm::vec3(frustumPlane), glm::vec3(casterBoundingSphere)) + frustumPlane.w) < -casterBoundingSphere.w; });
+        if (casterVisible == true) {
+            visibleViewMask |= (1u << i);
+        }
+    }
+}
+
+bool Uniform::pointShadowReachesFrustum(glm::vec4 casterBoundingSphere, glm::vec3 lightPosition, glm::mat4 cameraMatrix)
+{
+    glm::vec4 frustumPlanes[6];
+    Uniform::extractFrustumPlanes(cameraMatrix, frustumPlanes);
+
+    for (glm::vec4 frustumPlane : frustumPlanes) {
+        // the shadow extends away from the light, it stays outside a plane the caster is fully outside of and no closer to than the light.
+        float casterDistance = ((glm::dot(glm::vec3(frustumPlane), glm::vec3(casterBoundingSphere)) + frustumPlane.w) + casterBoundingSphere.w);
+        float lightDistance = (glm::dot(glm::vec3(frustumPlane), lightPosition) + frustumPlane.w);
+        if ((casterDistance < 0.0f) && (casterDistance <= lightDistance)) {
+            return false;
+        }
+    }
+
+    return true;
 }
 
 void Uniform::populatePushConstant(uint32_t offset, VkDeviceSize size, VkShaderStageFlags stageFlags, VkPushConstantRange& pushConstant)
@@ -8,21 +8,76 @@
 #include <glm/glm.hpp>
 
 #include <core/DisplayManager/Camera.h>
+#include <core/Renderer/ShadowAtlas.h>
 #include <core/VulkanInstance/DeviceHandler.h>
 
 #include <vector>
+#include <string>
 
 
+namespace BoundingVolumeHierarchy
+{
+    struct CullingScene;  // includes this header for the culling instances.
+}
+
+namespace ModelHandler  // forward declaration.
+{
+    struct MeshChunk;
+}
+
+namespace MaskedOcclusion  // forward declaration.
+{
+    struct OcclusionBuffer;
+    struct OccluderMesh;
+}
+
 namespace Uniform
 {
-    // TODO: PCF on directional and point lights.
+    const uint32_t maxShadowCascadeCount = 4;  // identical to the cascade array sizes in the scene and directional shadow shaders.
+    const uint32_t maxShadowAtlasTileCount = 48;  // identical to the tile array sizes in the scene and shadow atlas shaders, six tiles for each of the eight additional point lights.
+
+    // identical to the shadow index constants in the scene shader.
+    const uint32_t noShadowIndex = 0xFFFFFFFF;  // the light casts no shadow(ex: it didn't fit in the shadow atlas).
+    const uint32_t pointShadowCubemapIndex = 0xFFFFFFFE;  // the light's shadow is the dedicated point shadow cubemap.
+    const uint32_t shadowlessIndex = 0xFFFFFFFD;  // the light never casts a shadow(ex: a minor clustered light), skipped in shadow atlas allocation.
+
+    // identical to the shadow filter mode constants in the scene shader.
+    const uint32_t pcfShadowFilter = 0;  // a single hardware PCF tap.
+    const uint32_t poissonShadowFilter = 1;  // a per-pixel rotated Poisson disk of hardware PCF taps.
+    const uint32_t pcssShadowFilter = 2;  // a Poisson disk scaled by the penumbra width estimated from a blocker search(percentage-closer soft shadows).
+
+    // identical to the shadow projection constants in the scene and shadow atlas shaders.
+    const uint32_t cubeShadowProjection = 0;  // six 90 degree perspective views, one for each cubemap face.
+    const uint32_t dualParaboloidShadowProjection = 1;  // two hemispherical paraboloid views, cheaper but less accurate(point lights only).
+
+    // identical to the culling constants in the culling shader.
+    const uint32_t cullingStreamCount = 4;  // a compacted draw stream for the scene, the directional shadow, the point shadow, and the late scene.
+    const uint32_t frustumCullingStreamCount = 3;  // the streams culled against frustums, the late scene stream is only written by occlusion culling.
+    const uint32_t sceneCullingStream = 0;  // culled against the camera frustum(and last frame's visibility with occlusion culling).
+    const uint32_t directionalShadowCullingStream = 1;  // culled against every directional shadow cascade, drawn once for all cascades.
+    const uint32_t pointShadowCullingStream = 2;  // culled against every point shadow cubemap face, drawn once for all faces.
+    const uint32_t sceneLateCullingStream = 3;  // the scene instances disoccluded by the depth pyramid test, drawn in the late main pass.
+    const uint32_t maskedCullingStreamOffset = Uniform::cullingStreamCount;  // each stream's alpha-masked draws follow every stream's opaque draws, sharing the stream's draw count.
+    const uint32_t maxCullingFrustumCount = (1 + Uniform::maxShadowCascadeCount + 6);  // the camera, each cascade, and each cubemap face.
+
+    // identical to the cluster constants in the light clustering and scene shaders.
+    const uint32_t clusterCountX = 16;  // the camera frustum is divided into screen space tiles, each tile into exponential depth slices(froxels).
+    const uint32_t clusterCountY = 9;
+    const uint32_t clusterCountZ = 24;
+    const uint32_t clusterCount = (Uniform::clusterCountX * Uniform::clusterCountY * Uniform::clusterCountZ);
+    const uint32_t maxClusterLightCount = 128;  // the capacity of each cluster's light list, bounding the lights a fragment iterates.
+
     // TODO: scene builder.
     // TODO: check correctness of shadow mapping.
     // TODO: fix strange point light intensities.
     struct SceneLight {
-        uint32_t lightID;  // 0: directional, 1: point, 2: spotlight(not implemented, yet).
+        uint32_t lightID;  // 0: directional, 1: point, 2: spotlight.
+        uint32_t shadowIndex;  // the light's first shadow atlas tile(point lights use six or two consecutive tiles), or one of the shadow index constants.
+        float lightRange;  // the distance the light's attenuated intensity becomes negligible at, the far plane of its shadow atlas tiles.
+        uint32_t shadowProjection;  // point lights only, one of the shadow projection constants(dual paraboloid lights are always shadowed through the shadow atlas).
         alignas(16) glm::vec4 lightProperties;  // used as a direction/position distinguished by the light ID.
         glm::vec4 lightColor;  // structured as [R, G, B, light intensity].
+        glm::vec4 lightDirection;  // spotlights only, structured as [the direction the spotlight points in, the cosine of the cutoff angle].
     };
     struct CubemapUniformBufferObject {  // identical to the cubemap shader structs.
         glm::mat4 projectionMatrix;  // identical to scene uniform buffer object projection matrix.
@@ -32,20 +87,30 @@ namespace Uniform
     struct SceneUniformBufferObject {  // identical to the scene shader structs.
         glm::mat4 projectionMatrix;
         glm::mat4 viewMatrix;
-        glm::mat4 modelMatrix;
+        glm::mat4 modelMatrix;  // the main mesh's transform, the scene shaders read each drawn instance's transform from the culling instance buffer.
         glm::mat4 normalMatrix;
-        glm::mat4 lightSpaceMatrix;
+        glm::mat4 cascadeLightSpaceMatrices[Uniform::maxShadowCascadeCount];
+        glm::vec4 cascadeSplitDepths;  // the far view space depth of each cascade.
 
         glm::vec3 viewingPosition;
         
         alignas(16) glm::vec4 ambientLightColor;  // structered as [R, G, B, light intensity].
 
-        // TODO: implement a spotlight light-caster.
-        // TODO: get around shader input/output limit with scene lights.
-        Uniform::SceneLight sceneLights[10];
-        uint32_t sceneLightCount;
+        glm::vec2 clusterTileSize;  // the size of each cluster's screen space tile in pixels.
+        float clusterDepthScale;  // a fragment's depth slice is log(view depth) * scale + bias.
+        float clusterDepthBias;
+        uint32_t sceneLightCount;  // the lights themselves are in the scene light buffer, binned into the cluster light buffer.
 
         uint32_t farPlane;
+        uint32_t cascadeCount;
+        uint32_t shadowFilterMode;  // one of the shadow filter mode constants.
+
+        alignas(16) glm::mat4 shadowAtlasTileMatrices[Uniform::maxShadowAtlasTileCount];  // the view projection matrix of each shadow atlas tile.
+        glm::vec4 shadowAtlasTileRects[Uniform::maxShadowAtlasTileCount];  // structured as [offset, size] in atlas texture coordinates.
+
+        glm::mat4 inverseViewProjectionMatrix;  // reconstructs world space positions from depth in the deferred lighting shader.
+        glm::vec2 framebufferExtent;
+        float textureLodBias;  // the material textures' mip bias, set by the quality governor.
     };
 
     struct SceneNormalsUniformBufferObject {
@@ -56,28 +121,95 @@ namespace Uniform
     };
 
     struct DirectionalShadowUniformBufferObject {
-        glm::mat4 lightSpaceMatrix;
-        glm::mat4 modelMatrix;
+        glm::mat4 cascadeLightSpaceMatrices[Uniform::maxShadowCascadeCount];  // indexed by the multiview view index.
+        glm::mat4 modelMatrix;  // the main mesh's transform, only kept in the shadow cache state(drawn instances read the culling instance buffer).
     };
 
     struct PointShadowUniformBufferObject {
         glm::mat4 projectionMatrix;
-        glm::mat4 modelMatrix;
+        glm::mat4 modelMatrix;  // see DirectionalShadowUniformBufferObject::modelMatrix.
+        glm::mat4 viewMatrices[6];  // a view matrix for each cubemap face, indexed by the multiview view index.
         
         glm::vec3 pointLightPosition;
         uint32_t farPlane;
     };
+    
+    struct ShadowAtlasUniformBufferObject {  // identical to the shadow atlas shader structs.
+        glm::mat4 modelMatrix;
+        glm::mat4 tileMatrices[Uniform::maxShadowAtlasTileCount];  // indexed by the tile index push constant, paraboloid tiles only store the hemisphere's view matrix.
+        glm::vec4 tileLightPositions[Uniform::maxShadowAtlasTileCount];  // structured as [light position, light range].
+        glm::uvec4 tileProjections[Uniform::maxShadowAtlasTileCount];  // structured as [shadow projection, unused, unused, unused], padded to the array stride.
+    };
+
+    struct CullingInstance {  // identical to the culling shader structs, read by the culling compute pass and indexed by the instance index in the culled draws.
+        glm::mat4 modelMatrix;
+        glm::mat4 normalMatrix;
+        glm::vec4 boundingSphere;  // the model space bounding sphere as [center, radius].
+        glm::uvec4 drawParameters;  // structured as [opaque index count, first index, vertex offset, masked index count], the masked indices follow the opaque indices.
+        glm::mat4 previousModelMatrix;  // the instance's model matrix in the previous frame(used in motion vectors).
+    };
+
+    struct CullingUniformBufferObject {  // identical to the culling shader structs.
+        glm::vec4 frustumPlanes[Uniform::maxCullingFrustumCount * 6];  // the planes of every culling frustum, see extractFrustumPlanes.
+        glm::uvec4 streamFrustumRanges[Uniform::frustumCullingStreamCount];  // structured as [first frustum, frustum count, unused, unused], an instance is drawn in a stream if it intersects any of its frustums.
+        glm::mat4 cameraMatrix;  // projects the instance bounds onto the depth pyramid.
+        glm::vec2 depthPyramidExtent;
+        glm::vec2 depthPyramidRenderScale;  // the rendered region of the depth image, see UniformBuffersUpdatePackage::renderExtent.
+        uint32_t depthPyramidLevelCount;
+        uint32_t occlusionCullingEnabled;
+        uint32_t instanceCount;
+        uint32_t maxInstanceCount;  // the capacity of each draw stream.
+    };
+
+    struct ClusteringUniformBufferObject {  // identical to the light clustering shader structs.
+        glm::mat4 inverseProjectionMatrix;  // unprojects each cluster's tile corners.
+        glm::mat4 viewMatrix;  // the lights are binned in view space.
+        float nearPlane;
+        float farPlane;
+        uint32_t sceneLightCount;
+    };
 
-    struct PointShadowPushConstants {
+    struct TemporalUniformBufferObject {  // identical to the motion vectors shader structs.
+        glm::mat4 projectionMatrix;  // the scene's jittered projection and view, the instances are rasterized identically to the scene depth.
         glm::mat4 viewMatrix;
+        glm::mat4 cameraMatrix;  // the current and previous unjittered camera matrices, each instance is projected with both.
+        glm::mat4 previousCameraMatrix;
+        glm::mat4 cameraReprojectionMatrix;  // reprojects static positions(ex: the cubemap's) from the current to the previous clip space.
+        glm::vec2 projectionJitter;  // the current projection's sub-pixel jitter in NDC, removed before reprojecting.
+        glm::vec2 renderExtent;
+    };
+
+    struct ShadowAtlasState {  // everything the shadow atlas depends on(used in shadow cache invalidation).
+        Uniform::ShadowAtlasUniformBufferObject shadowAtlasUniformBufferObject;
+        ShadowAtlas::AtlasTile tiles[Uniform::maxShadowAtlasTileCount];  // the atlas region of each tile, rendered with its own viewport and scissor.
+        uint32_t tileCount;
     };
     
     struct UniformBuffersUpdatePackage {
         Camera::ArcballCamera *mainCamera;  // the scene's main camera.
         glm::quat mainMeshQuaternion;  // the main mesh's provided optional quaternion.
+        glm::vec3 mainMeshBoundsMinimum;  // the main mesh's model space bounds(used in shadow caster culling).
+        glm::vec3 mainMeshBoundsMaximum;
+        const std::vector<ModelHandler::MeshChunk> *mainMeshChunks;  // the main mesh's chunks, each culled as its own instance.
+        uint32_t maxCullingInstanceCount;  // the capacity of the culling instance buffer.
+        uint32_t maxSceneLightCount;  // the capacity of the scene light buffer, lights beyond it are dropped.
+        float sceneLightFraction;  // the fraction of the scene lights kept(used in quality governing), at least a light is kept.
+        uint32_t shadowAtlasMaximumTileSize;  // the largest shadow atlas tile a light gets, lowered by the quality governor.
+        float textureLodBias;  // the material textures' mip bias, raised by the quality governor.
+        VkExtent2D depthPyramidExtent;  // the extent of the depth pyramid's first level(used in occlusion culling).
+        uint32_t depthPyramidLevelCount;
+        bool occlusionCullingEnabled;  // if the culling compute pass tests the scene instances against the depth pyramid.
 
         VkExtent2D swapchainImageExtent;  // Vulkan swapchain image extent.        
+        VkExtent2D renderExtent;  // the rendered region of the scene images, smaller than the swapchain image extent with dynamic resolution.
+        glm::vec2 projectionJitter;  // the sub-pixel offset of the camera projection in pixels(used in temporal anti-aliasing), zero without jitter.
+        glm::mat4 previousCameraMatrix;  // the previous frame's unjittered camera matrix and main mesh transform(used in the instances' motion vectors).
+        glm::mat4 previousMainMeshModelMatrix;
         GLFWwindow *glfwWindow;  // GLFW window to use in frame uniform buffer updating.
+        ShadowAtlas::QuadtreeAllocator *shadowAtlasAllocator;  // reset and allocated from every update.
+        BoundingVolumeHierarchy::CullingScene *cpuCullingScene;  // culls the instances on the CPU if set, the culling compute pass is used otherwise.
+        MaskedOcclusion::OcclusionBuffer *cpuOcclusionBuffer;  // occlusion culls the CPU culled scene instances if set, the main mesh's occluder is rasterized into it first.
+        const MaskedOcclusion::OccluderMesh *mainMeshOccluderMesh;  // the main mesh's occluder proxy(used in CPU occlusion culling).
 
         // uniform buffer at the index of the current frame.
         void *mappedSceneUniformBufferMemory;  // mapped scene uniform buffer memory.
@@ -85,6 +217,28 @@ namespace Uniform
         void *mappedCubemapUniformBufferMemory;  // mapped cubemap uniform buffer memory.
         void *mappedDirectionalShadowUniformBufferMemory;  // mapped directional shadow uniform buffer memory.
         void *mappedPointShadowUniformBufferMemory;  // mapped point shadow uniform buffer memory.
+        void *mappedShadowAtlasUniformBufferMemory;  // mapped shadow atlas uniform buffer memory.
+        void *mappedCullingUniformBufferMemory;  // mapped culling uniform buffer memory.
+        void *mappedCullingInstanceBufferMemory;  // mapped culling instance(storage) buffer memory.
+        void *mappedClusteringUniformBufferMemory;  // mapped light clustering uniform buffer memory.
+        void *mappedSceneLightBufferMemory;  // mapped scene light(storage) buffer memory.
+        void *mappedTemporalUniformBufferMemory;  // mapped temporal uniform buffer memory, nullptr without temporal anti-aliasing.
+
+        // written in the update, everything the shadow maps depend on(used in shadow cache invalidation).
+        Uniform::DirectionalShadowUniformBufferObject directionalShadowUniformBufferObject;
+        Uniform::PointShadowUniformBufferObject pointShadowUniformBufferObject;
+        uint32_t pointShadowVisibleFaceMask;  // the point shadow cubemap faces intersecting the camera frustum(used in time-sliced face updates).
+        Uniform::ShadowAtlasState shadowAtlasState;
+        uint32_t cullingInstanceCount;  // the amount of instances culled by the culling compute pass.
+        std::vector<VkDrawIndexedIndirectCommand> cpuCulledDrawCommands[Uniform::cullingStreamCount * 2];  // the draws of each culling stream followed by its masked draws, only written with a CPU culling scene.
+        uint32_t cpuOccludedInstanceCount;  // the amount of scene instances culled by the CPU occlusion buffer.
+        glm::mat4 cameraMatrix;  // the unjittered camera matrix and main mesh transform, the next frame's previous matrices.
+        glm::mat4 mainMeshModelMatrix;
+
+        // written in the update, the shadow casters(bit 0: the main mesh) left after culling in each shadow view.
+        uint32_t directionalShadowCascadeCasterMasks[Uniform::maxShadowCascadeCount];
+        uint32_t pointShadowFaceCasterMasks[6];
+        uint32_t shadowAtlasTileCasterMasks[Uniform::maxShadowAtlasTileCount];
     };
 
 
@@ -102,6 +256,96 @@ namespace Uniform
     // @param uniformBuffersUpdatePackage the uniform buffers update data to use in this function.
     void updateFrameUniformBuffers(Uniform::UniformBuffersUpdatePackage& uniformBuffersUpdatePackage);
 
+    // fit the directional shadow cascades to slices of the camera frustum, split with a practical linear/logarithmic scheme.
+    //
+    // @param inverseCameraMatrix the inverse of the camera's projection and view matrix.
+    // @param nearPlane the camera's near plane.
+    // @param farPlane the camera's far plane.
+    // @param lightDirection the direction the directional light travels in.
+    // @param cascadeLightSpaceMatrices calculated light space matrix of each cascade.
+    // @param cascadeSplitDepths calculated far view space depth of each cascade.
+    void calculateShadowCascades(glm::mat4 inverseCameraMatrix, float nearPlane, float farPlane, glm::vec3 lightDirection, glm::mat4 cascadeLightSpaceMatrices[], glm::vec4& cascadeSplitDepths);
+
+    // select the shadow filter mode constant of a shadow filtering quality preset.
+    //
+    // @param shadowFilterModeName the quality preset, "PCF", "POISSON", or "PCSS".
+    // @return the shadow filter mode.
+    uint32_t selectShadowFilterMode(const std::string& shadowFilterModeName);
+
+    // calculate the distance a light's attenuated intensity becomes negligible(below 1/256) at.
+    //
+    // @param lightColor the light's color, structured as [R, G, B, light intensity].
+    // @return the light's range.
+    float calculateLightRange(glm::vec4 lightColor);
+
+    // allocate shadow atlas tiles for the shadowed lights without a dedicated shadow map, lights covering more of the screen and more important lights first.
+    //
+    // each spotlight gets one tile, and each point light gets a tile for each cubemap face(or each paraboloid hemisphere).
+    // lights that don't fit in the atlas(or the tile arrays) are left unshadowed.
+    //
+    // @param cameraPosition the world space position of the camera.
+    // @param cameraFOV the camera's vertical field of view in radians.
+    // @param nearPlane the near plane of the tiles.
+    // @param sceneLights the scene's lights, the shadow index of each shadowed light without one is set.
+    // @param sceneLightCount the amount of scene lights.
+    // @param maximumTileSize the largest tile a light gets(lowered by the quality governor).
+    // @param shadowAtlasAllocator the allocator to reset and allocate the tiles from.
+    // @param shadowAtlasState calculated tile matrices, light positions, and atlas regions.
+    void allocateShadowAtlasTiles(glm::vec3 cameraPosition, float cameraFOV, float nearPlane, Uniform::SceneLight sceneLights[], uint32_t sceneLightCount, uint32_t maximumTileSize, ShadowAtlas::QuadtreeAllocator& shadowAtlasAllocator, Uniform::ShadowAtlasState& shadowAtlasState);
+
+    // calculate the view matrix of each dual paraboloid hemisphere around a point, each hemisphere is centered on the view's forward(-Z) axis.
+    //
+    // @param paraboloidPosition the world space position the paraboloids are rendered from(ex: a point light position).
+    // @param viewMatrices calculated view matrices, ordered as -Z, +Z.
+    void calculateParaboloidViewMatrices(glm::vec3 paraboloidPosition, glm::mat4 viewMatrices[2]);
+
+    // find the dual paraboloid hemispheres a shadow caster's bounding sphere intersects.
+    //
+    // @param casterBoundingSphere the world space bounding sphere of the caster as [center, radius].
+    // @param viewMatrix the hemisphere's view matrix.
+    // @param lightRange the light's range, the hemisphere's far distance.
+    // @return if the caster is drawn in the hemisphere.
+    bool paraboloidCasterVisible(glm::vec4 casterBoundingSphere, glm::mat4 viewMatrix, float lightRange);
+
+    // calculate the view matrix of each cubemap face around a point.
+    //
+    // @param cubemapPosition the world space position the cubemap is rendered from(ex: a point light position).
+    // @param viewMatrices calculated view matrices, ordered as +X, -X, +Y, -Y, +Z, -Z.
+    void calculateCubemapViewMatrices(glm::vec3 cubemapPosition, glm::mat4 viewMatrices[6]);
+
+    // find the cubemap faces around a point whose frustums may intersect the camera frustum.
+    //
+    // conservative, a face is only excluded if every camera frustum corner is outside of one of its side planes.
+    //
+    // @param inverseCameraMatrix the inverse of the camera's projection and view matrix.
+    // @param cubemapPosition the world space position the cubemap is rendered from(ex: a point light position).
+    // @param visibleFaceMask calculated mask of the possibly visible faces, ordered as +X, -X, +Y, -Y, +Z, -Z.
+    void calculateVisibleCubemapFaces(glm::mat4 inverseCameraMatrix, glm::vec3 cubemapPosition, uint32_t& visibleFaceMask);
+
+    // extract the planes of a view projection matrix's frustum, in Vulkan clip space(0 <= z <= w).
+    //
+    // @param viewProjectionMatrix the view projection matrix.
+    // @param frustumPlanes extracted left, right, bottom, top, near, and far planes, pointing inwards as [normal, distance].
+    void extractFrustumPlanes(glm::mat4 viewProjectionMatrix, glm::vec4 frustumPlanes[6]);
+
+    // find the shadow views(ex: cascades or cubemap faces) a shadow caster's bounding sphere intersects.
+    //
+    // @param casterBoundingSphere the world space bounding sphere of the caster as [center, radius].
+    // @param viewProjectionMatrices the view projection matrix of each shadow view.
+    // @param viewCount the amount of shadow views.
+    // @param visibleViewMask calculated mask of the shadow views the caster is drawn in.
+    void cullShadowCaster(glm::vec4 casterBoundingSphere, const glm::mat4 viewProjectionMatrices[], uint32_t viewCount, uint32_t& visibleViewMask);
+
+    // test if the shadow a point light casts behind a shadow caster can reach the camera frustum.
+    //
+    // conservative, the shadow is only excluded if it stays outside of one of the camera frustum's planes.
+    //
+    // @param casterBoundingSphere the world space bounding sphere of the caster as [center, radius].
+    // @param lightPosition the world space position of the point light.
+    // @param cameraMatrix the camera's projection and view matrix.
+    // @return if the caster's shadow may be visible.
+    bool pointShadowReachesFrustum(glm::vec4 casterBoundingSphere, glm::vec3 lightPosition, glm::mat4 cameraMatrix);
+
     // populate a push constant struct.
     //
     // @param offset see VkPushConstantRange documentation.
@@ -49,9 +49,22 @@ bool DeviceHandler::deviceSuitable(VkPhysicalDevice physicalDevice, VkSurfaceKHR
     
     bool queueFamiliesSupported = Queue::deviceQueueFamiliesSuitable(physicalDevice, windowSurface, queueFamilyIndices);
 
-    VkPhysicalDeviceFeatures supportedPhysicalDeviceFeatures;
-    vkGetPhysicalDeviceFeatures(physicalDevice, &supportedPhysicalDeviceFeatures);
-    bool allDeviceFeaturesSupported = supportedPhysicalDeviceFeatures.samplerAnisotropy && supportedPhysicalDeviceFeatures.geometryShader && supportedPhysicalDeviceFeatures.vertexPipelineStoresAndAtomics;
+    VkPhysicalDeviceProperties physicalDeviceProperties;
+    vkGetPhysicalDeviceProperties(physicalDevice, &physicalDeviceProperties);
+    if (physicalDeviceProperties.apiVersion < VK_API_VERSION_1_1) {  // vkGetPhysicalDeviceFeatures2 and multiview are Vulkan 1.1, indirect count draws(Vulkan 1.2) are optional(see deviceSupportsGpuCulling).
+        return false;
+    }
+
+    VkPhysicalDeviceMultiviewFeatures supportedMultiviewFeatures{};
+    supportedMultiviewFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MULTIVIEW_FEATURES;
+
+    VkPhysicalDeviceFeatures2 supportedPhysicalDeviceFeatures2{};
+    supportedPhysicalDeviceFeatures2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    supportedPhysicalDeviceFeatures2.pNext = &supportedMultiviewFeatures;
+    vkGetPhysicalDeviceFeatures2(physicalDevice, &supportedPhysicalDeviceFeatures2);
+    
+    VkPhysicalDeviceFeatures& supportedPhysicalDeviceFeatures = supportedPhysicalDeviceFeatures2.features;
+    bool allDeviceFeaturesSupported = supportedPhysicalDeviceFeatures.samplerAnisotropy && supportedPhysicalDeviceFeatures.geometryShader && supportedPhysicalDeviceFeatures.vertexPipelineStoresAndAtomics && supportedMultiviewFeatures.multiview;  // multiview renders the point shadow cubemap in one pass.
     
     return extensionsSupported && swapchainDetailsComplete && queueFamiliesSupported && allDeviceFeaturesSupported;
 }
@@ -72,6 +85,25 @@ bool DeviceHandler::deviceExtensionsSuitable(VkPhysicalDevice physicalDevice)
     return requiredExtensions.empty();  // if all the required extensions were found(removed individually from required extensions list.
 }
 
+bool DeviceHandler::deviceSupportsGpuCulling(VkPhysicalDevice physicalDevice)
+{
+    VkPhysicalDeviceProperties physicalDeviceProperties;
+    vkGetPhysicalDeviceProperties(physicalDevice, &physicalDeviceProperties);
+    if (physicalDeviceProperties.apiVersion < VK_API_VERSION_1_2) {  // the Vulkan 1.2 features can't be queried below Vulkan 1.2.
+        return false;
+    }
+
+    VkPhysicalDeviceVulkan12Features supportedVulkan12Features{};
+    supportedVulkan12Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+
+    VkPhysicalDeviceFeatures2 supportedPhysicalDeviceFeatures2{};
+    supportedPhysicalDeviceFeatures2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    supportedPhysicalDeviceFeatures2.pNext = &supportedVulkan12Features;
+    vkGetPhysicalDeviceFeatures2(physicalDevice, &supportedPhysicalDeviceFeatures2);
+
+    return supportedPhysicalDeviceFeatures2.features.drawIndirectFirstInstance && supportedVulkan12Features.drawIndirectCount;  // culled draws are written by the culling compute pass, CPU culling is used otherwise.
+}
+
 void DeviceHandler::createLogicalDevice(VkPhysicalDevice physicalDevice, Queue::QueueFamilyIndices queueFamilyIndices, VkDevice& createdLogicalDevice)
 {
     std::vector<VkDeviceQueueCreateInfo> queueCreateInfos;
@@ -83,8 +115,21 @@ void DeviceHandler::createLogicalDevice(VkPhysicalDevice physicalDevice, Queue::
     deviceFeatures.sampleRateShading = VK_TRUE;
     deviceFeatures.vertexPipelineStoresAndAtomics = VK_TRUE;
 
+    bool gpuCullingSupported = DeviceHandler::deviceSupportsGpuCulling(physicalDevice);
+    deviceFeatures.drawIndirectFirstInstance = (gpuCullingSupported ? VK_TRUE : VK_FALSE);  // the first instance of a culled draw selects its instance data.
+
+    VkPhysicalDeviceVulkan12Features vulkan12Features{};
+    vulkan12Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+    vulkan12Features.drawIndirectCount = (gpuCullingSupported ? VK_TRUE : VK_FALSE);
+
+    VkPhysicalDeviceMultiviewFeatures multiviewFeatures{};
+    multiviewFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MULTIVIEW_FEATURES;
+    multiviewFeatures.pNext = (gpuCullingSupported ? &vulkan12Features : nullptr);  // only chained on Vulkan 1.2 devices.
+    multiviewFeatures.multiview = VK_TRUE;
+
     VkDeviceCreateInfo logicalCreateInfo{};
     logicalCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+    logicalCreateInfo.pNext = &multiviewFeatures;
     logicalCreateInfo.pQueueCreateInfos = queueCreateInfos.data();
     logicalCreateInfo.queueCreateInfoCount = static_cast<uint32_t>(queueCreateInfos.size());
     logicalCreateInfo.pEnabledFeatures = &deviceFeatures;
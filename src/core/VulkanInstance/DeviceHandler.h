@@ -48,6 +48,12 @@ namespace DeviceHandler
     // @return suitabilty of device.
     bool deviceExtensionsSuitable(VkPhysicalDevice physicalDevice);
 
+    // check if a physical device supports the indirect draws written by the culling compute pass.
+    //
+    // @param physicalDevice physical device to check support of.
+    // @return if indirect count draws(and a non-zero first instance in indirect draws) are supported.
+    bool deviceSupportsGpuCulling(VkPhysicalDevice physicalDevice);
+
     // create a logical device using the specified queue family indices.
     //
     // @param physicalDevice physical device to use in logical device creation.
@@ -0,0 +1,73 @@
+#include <core/Worker/WorkerThread.h>
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+#include <utility>
+
+
+void WorkerThread::PersistentWorker::startWorker()
+{
+    this->stopRequested = false;
+    this->workerThread = std::thread(&WorkerThread::PersistentWorker::runWorker, this);
+}
+
+void WorkerThread::PersistentWorker::submitJob(std::function<void()> submittedJob)
+{
+    {
+        std::lock_guard<std::mutex> jobLock(this->jobMutex);
+        this->job = std::move(submittedJob);
+    }
+    this->jobCondition.notify_all();
+}
+
+void WorkerThread::PersistentWorker::waitForJob()
+{
+    std::unique_lock<std::mutex> jobLock(this->jobMutex);
+    this->jobCondition.wait(jobLock, [this]() { return (this->job == nullptr); });
+
+    if (this->jobException != nullptr) {
+        std::exception_ptr thrownException = this->jobException;
+        this->jobException = nullptr;
+        std::rethrow_exception(thrownException);
+    }
+}
+
+void WorkerThread::PersistentWorker::stopWorker()
+{
+    if (this->workerThread.joinable() == false) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> jobLock(this->jobMutex);
+        this->stopRequested = true;
+    }
+    this->jobCondition.notify_all();
+
+    this->workerThread.join();
+}
+
+void WorkerThread::PersistentWorker::runWorker()
+{
+    std::unique_lock<std::mutex> jobLock(this->jobMutex);
+    while (true) {
+        this->jobCondition.wait(jobLock, [this]() { return ((this->job != nullptr) || (this->stopRequested == true)); });
+        if (this->job == nullptr) {  // stopped while idle.
+            return;
+        }
+
+        jobLock.unlock();  // the job runs unlocked, the waiting thread only checks the job once notified.
+        try {
+            this->job();
+        } catch (...) {
+            this->jobException = std::current_exception();
+        }
+        jobLock.lock();
+
+        this->job = nullptr;
+        this->jobCondition.notify_all();
+    }
+}
\ No newline at end of file
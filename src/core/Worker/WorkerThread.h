@@ -0,0 +1,43 @@
+#ifndef WORKERTHREAD_H
+#define WORKERTHREAD_H
+
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+
+
+namespace WorkerThread
+{
+    struct PersistentWorker {  // a long-lived thread running one submitted job at a time, signalled and waited on every frame instead of being spawned for every frame.
+        std::thread workerThread;
+        std::mutex jobMutex;
+        std::condition_variable jobCondition;  // signals a submitted job to the worker, and the job's completion back to the waiting thread.
+        std::function<void()> job;  // the submitted job, empty once it has completed.
+        std::exception_ptr jobException;  // exceptions can't cross threads, rethrown by the waiting thread.
+        bool stopRequested = false;
+
+
+        // start the worker's thread, idle until a job is submitted.
+        void startWorker();
+
+        // submit a job to the worker, the previous job must have been waited on.
+        //
+        // @param submittedJob the job to run on the worker's thread.
+        void submitJob(std::function<void()> submittedJob);
+
+        // wait for the submitted job to complete, rethrowing any exception it threw.
+        void waitForJob();
+
+        // stop and join the worker's thread, a submitted job is completed first.
+        void stopWorker();
+
+        // the worker's thread, runs every submitted job until the worker is stopped.
+        void runWorker();
+    };
+}
+
+
+#endif  // WORKERTHREAD_H
\ No newline at end of file
@@ -1,8 +1,20 @@
 #include <utils/MathUtils.h>
 
+#include <cstdint>
+
 
 float MathUtils::normalizeValueToRanges(float initialValue, float initialRangeMinimumValue, float initialRangeMaximumValue, float targetRangeMinimumValue, float targetRangeMaximumValue)
 {
     float zeroToOneNormalizedValue = ((initialValue - initialRangeMinimumValue) / (initialRangeMaximumValue - initialRangeMinimumValue));
     return (zeroToOneNormalizedValue * ((targetRangeMaximumValue - targetRangeMinimumValue) + targetRangeMinimumValue));
 }
+
+uint32_t MathUtils::floorPowerOfTwo(uint32_t value)
+{
+    uint32_t powerOfTwo = 1;
+    while (powerOfTwo <= (value / 2)) {
+        powerOfTwo *= 2;
+    }
+
+    return powerOfTwo;
+}
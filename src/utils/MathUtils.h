@@ -2,6 +2,9 @@
 #define MATHUTILS_H
 
 
+#include <cstdint>
+
+
 namespace MathUtils
 {
     // normalize value to targetMinimumValue..targetMaximumValue through the equation shown here(https://stats.stackexchange.com/questions/281162/scale-a-number-between-a-range).
@@ -13,6 +16,12 @@ namespace MathUtils
     // @param targetRangeMaximumValue the highest(maximum) value in the target range.
     // @return normalized value.
     float normalizeValueToRanges(float initialValue, float initialRangeMinimumValue, float initialRangeMaximumValue, float targetRangeMinimumValue, float targetRangeMaximumValue);
+
+    // round a value down to a power of two.
+    //
+    // @param value the value to round.
+    // @return the largest power of two not above the value, 1 if the value is 0.
+    uint32_t floorPowerOfTwo(uint32_t value);
 }
 
 